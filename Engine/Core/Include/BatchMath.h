@@ -0,0 +1,78 @@
+#pragma once
+
+#include "RenderSnapshot.h"
+#include <cstdint>
+
+namespace D3D12Core {
+
+    // Juego de instrucciones de los kernels por lotes. Se elige al arrancar según la CPU (CPUID),
+    // no según los flags del compilador: el mismo binario usa AVX-512 donde lo hay y SSE donde no
+    enum class SimdLevel : uint32_t {
+        Scalar,
+        SSE42,
+        AVX2,
+        AVX512
+    };
+
+    // Nivel activo (por defecto, el mejor que soportan la CPU, el sistema operativo y el binario)
+    SimdLevel GetSimdLevel();
+    SimdLevel GetSupportedSimdLevel();
+    // Fuerza un nivel (benchmarks, depuración). false si la CPU o el binario no lo soportan
+    bool SetSimdLevel(SimdLevel level);
+    const char* GetSimdLevelName(SimdLevel level);
+    // Elementos por iteración del nivel (1 escalar, 4 SSE, 8 AVX2, 16 AVX-512)
+    uint32_t GetSimdLevelWidth(SimdLevel level);
+    // Nivel por nombre ("escalar", "sse4.2", "avx2", "avx512"). false si no lo reconoce
+    bool ParseSimdLevel(const char* name, SimdLevel& level);
+
+    // Operaciones sobre muchos elementos a la vez con el nivel activo. Todos los niveles hacen las
+    // mismas operaciones en el mismo orden (sin FMA): el resultado es idéntico bit a bit al escalar.
+    // Los arrays SoA no necesitan relleno; el resto que no llena un grupo va por el camino escalar
+    namespace BatchMath {
+
+        // output[i] = Transpose(left[indices[i]] * right), o Transpose(left[indices[i]]) si right
+        // es nullptr (las constantes de HLSL van por columnas). Sin indices se lee left[i].
+        // Los strides van en bytes: se puede leer el world de un RenderProxy y escribir el model
+        // de un constant buffer sin copias intermedias. output no puede solapar con left
+        void MultiplyTranspose(const Float4x4* left, uint32_t leftStride, const uint32_t* indices,
+            const Float4x4* right, Float4x4* output, uint32_t outputStride, uint32_t count);
+
+        // Puntos SoA (x, y, z) multiplicados por matrix como vector fila con w = 1
+        void TransformPoints(const float* const input[3], const Float4x4& matrix, float* const output[3], uint32_t count);
+        // Igual con las cuatro columnas: coordenadas de clip (x, y, z, w) con una matriz de proyección
+        void ProjectPoints(const float* const input[3], const Float4x4& matrix, float* const output[4], uint32_t count);
+
+        // AABB SoA (centro y semiextensión) transformadas por matrix: la AABB que contiene a cada
+        // caja transformada, como CullingBounds::SetTransformed
+        void TransformBounds(const float* const centers[3], const float* const extents[3], const Float4x4& matrix,
+            float* const outCenters[3], float* const outExtents[3], uint32_t count);
+        // Igual, con una matriz por caja (matrices[i] para la caja i)
+        void TransformBounds(const float* const centers[3], const float* const extents[3], const Float4x4* matrices,
+            float* const outCenters[3], float* const outExtents[3], uint32_t count);
+
+        // Matriz afín escala * rotación * traslación (vector fila, como XMMatrixAffineTransformation
+        // con origen de giro 0) desde posiciones, cuaterniones unitarios (x, y, z, w) y escalas SoA
+        void ComposeTransforms(const float* const positions[3], const float* const rotations[4],
+            const float* const scales[3], Float4x4* output, uint32_t count);
+
+        // Atributos de vértices AoS a formatos comprimidos y vuelta (strides en bytes). Cada
+        // vértice se procesa como un cuarteto: las codificaciones leen un float más tras los tres
+        // que usan (el último vértice va siempre por el camino escalar, así que basta con que la
+        // entrada sea un array de vértices) y las decodificaciones escriben cuatro (outputStride >= 16).
+        // Redondeo al par más cercano, como las conversiones de SSE
+
+        // snorm16 de clamp((input - bias) * invScale, -1, 1) por componente, con w = 0
+        void EncodeSnorm16(const float* input, uint32_t inputStride, const float bias[3], const float invScale[3],
+            int16_t* output, uint32_t outputStride, uint32_t count);
+        // (input / 32767) * scale + bias por componente, con w = 0: R16G16B16A16_SNORM y el
+        // positionScale/positionBias del vertex shader
+        void DecodeSnorm16(const int16_t* input, uint32_t inputStride, const float scale[3], const float bias[3],
+            float* output, uint32_t outputStride, uint32_t count);
+        // unorm8 de saturate(input) por componente, con alfa 255
+        void EncodeUnorm8(const float* input, uint32_t inputStride, uint8_t* output, uint32_t outputStride, uint32_t count);
+        // input / 255 (r, g, b, a)
+        void DecodeUnorm8(const uint8_t* input, uint32_t inputStride, float* output, uint32_t outputStride, uint32_t count);
+
+    } // namespace BatchMath
+
+} // namespace D3D12Core
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Pool de contextos de grabación (par command list + allocator) por slot de frame
+    // Cada hilo adquiere su propio contexto, graba sin sincronización y al final del frame
+    // los contextos se recogen ordenados por su clave para enviarlos en un solo ExecuteCommandLists.
+    // Es una plantilla independiente del dispositivo: TContext debe exponer
+    //   void Begin(uint32_t order);  uint32_t GetOrder() const;
+    template <typename TContext>
+    class CommandContextPool {
+    public:
+        using Factory = std::function<std::unique_ptr<TContext>()>;
+
+        struct Stats {
+            uint64_t acquired = 0;        // Contextos entregados en total
+            uint64_t created = 0;         // Contextos creados (el resto se reutilizó)
+            uint32_t maxPerFrame = 0;     // Máximo de contextos usados en un frame
+        };
+
+        bool Initialize(uint32_t frameCount, Factory factory) {
+            if (frameCount == 0 || !factory) {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_factory = std::move(factory);
+            m_slots.clear();
+            m_slots.resize(frameCount);
+            m_stats = Stats{};
+            return true;
+        }
+
+        void Shutdown() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_slots.clear();
+            m_factory = nullptr;
+        }
+
+        // Seguro entre hilos. Devuelve un contexto listo para grabar en el slot indicado
+        TContext* Acquire(uint32_t slot, uint32_t order) {
+            TContext* context = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (slot >= m_slots.size()) {
+                    return nullptr;
+                }
+
+                Slot& frameSlot = m_slots[slot];
+                if (frameSlot.free.empty()) {
+                    std::unique_ptr<TContext> created = m_factory();
+                    if (!created) {
+                        return nullptr;
+                    }
+                    frameSlot.free.push_back(std::move(created));
+                    m_stats.created++;
+                }
+
+                frameSlot.used.push_back(std::move(frameSlot.free.back()));
+                frameSlot.free.pop_back();
+                context = frameSlot.used.back().get();
+
+                m_stats.acquired++;
+                uint32_t usedCount = static_cast<uint32_t>(frameSlot.used.size());
+                m_stats.maxPerFrame = (std::max)(m_stats.maxPerFrame, usedCount);
+            }
+
+            // Reset del allocator/list fuera del lock: cada hilo paga su propio coste
+            context->Begin(order);
+            return context;
+        }
+
+        // Llamar solo cuando la GPU ya no usa el slot (tras esperar su fence)
+        void ResetSlot(uint32_t slot) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (slot >= m_slots.size()) {
+                return;
+            }
+
+            Slot& frameSlot = m_slots[slot];
+            for (std::unique_ptr<TContext>& context : frameSlot.used) {
+                frameSlot.free.push_back(std::move(context));
+            }
+            frameSlot.used.clear();
+        }
+
+        // Contextos usados en el slot, ordenados de forma estable por su clave de orden
+        std::vector<TContext*> GatherOrdered(uint32_t slot) {
+            std::vector<TContext*> result;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (slot >= m_slots.size()) {
+                return result;
+            }
+
+            result.reserve(m_slots[slot].used.size());
+            for (std::unique_ptr<TContext>& context : m_slots[slot].used) {
+                result.push_back(context.get());
+            }
+            std::stable_sort(result.begin(), result.end(), [](const TContext* a, const TContext* b) {
+                return a->GetOrder() < b->GetOrder();
+            });
+            return result;
+        }
+
+        uint32_t GetUsedCount(uint32_t slot) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return slot < m_slots.size() ? static_cast<uint32_t>(m_slots[slot].used.size()) : 0;
+        }
+
+        Stats GetStats() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_stats;
+        }
+
+    private:
+        struct Slot {
+            std::vector<std::unique_ptr<TContext>> free;
+            std::vector<std::unique_ptr<TContext>> used;
+        };
+
+        std::mutex m_mutex;
+        std::vector<Slot> m_slots;
+        Factory m_factory;
+        Stats m_stats;
+    };
+
+} // namespace D3D12Core
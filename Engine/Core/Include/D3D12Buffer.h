@@ -1,6 +1,7 @@
 #pragma once
 
 #include "D3D12Core.h"
+#include "D3D12HeapAllocator.h"
 #include <d3d12.h>
 #include <wrl/client.h>
 
@@ -14,23 +15,36 @@ namespace D3D12Core {
         bool Initialize(
             ID3D12Device* device,
             UINT64 size,
-            D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE,
-            D3D12_RESOURCE_STATES initialState = D3D12_RESOURCE_STATE_COMMON
+            D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE
+        );
+
+        // Sub-asigna del heap allocator: rango de un buffer compartido si es pequeño y sin
+        // flags, recurso colocado en caso contrario. GetResource() puede ser compartido:
+        // usar siempre GetOffset() al copiar y GetGPUVirtualAddress() al enlazar. Los datos se
+        // suben con D3D12UploadManager::UploadBuffer (staging con el fence de la cola de copia)
+        bool Initialize(
+            D3D12HeapAllocator* allocator,
+            UINT64 size,
+            D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE
         );
         void Shutdown();
 
         ID3D12Resource* GetResource() const { return m_resource.Get(); }
+        UINT64 GetOffset() const { return m_offset; }
         UINT64 GetSize() const { return m_size; }
+        // Rango de un buffer compartido: el recurso se queda en COMMON (promoción implícita) y
+        // nunca se le hacen transiciones, que cambiarían el estado de los rangos vecinos
+        bool IsSubAllocated() const { return m_range.IsValid(); }
         D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const;
 
-        // Upload data
-        bool UploadData(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, const void* data, UINT64 size);
-
     protected:
         ComPtr<ID3D12Resource> m_resource;
-        ComPtr<ID3D12Resource> m_uploadBuffer;
+        UINT64 m_offset = 0; // Inicio dentro de m_resource (0 salvo en sub-rangos)
         UINT64 m_size = 0;
-        D3D12_RESOURCE_STATES m_currentState;
+
+        D3D12HeapAllocator* m_allocator = nullptr;
+        BufferRange m_range;
+        PlacedAllocation m_placed;
 
     private:
         friend class D3D12ConstantBuffer;
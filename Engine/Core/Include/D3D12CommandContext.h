@@ -0,0 +1,34 @@
+#pragma once
+
+#include "D3D12Core.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+
+namespace D3D12Core {
+
+    // Par command list + allocator propiedad de un único hilo de grabación
+    // Se obtiene de D3D12CommandQueue::AcquireContext y vuelve al pool de su slot de frame
+    class D3D12CommandContext {
+    public:
+        D3D12CommandContext();
+        ~D3D12CommandContext();
+
+        bool Initialize(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type);
+        void Shutdown();
+
+        // Resetea allocator y list; order define la posición en el ExecuteCommandLists final
+        void Begin(uint32_t order);
+        bool Close();
+
+        ID3D12GraphicsCommandList* GetCommandList() const { return m_commandList.Get(); }
+        uint32_t GetOrder() const { return m_order; }
+        bool IsRecording() const { return m_recording; }
+
+    private:
+        ComPtr<ID3D12CommandAllocator> m_allocator;
+        ComPtr<ID3D12GraphicsCommandList> m_commandList;
+        uint32_t m_order = 0;
+        bool m_recording = false;
+    };
+
+} // namespace D3D12Core
@@ -1,16 +1,20 @@
 #pragma once
 
 #include "D3D12Core.h"
+#include "CommandContextPool.h"
+#include "D3D12CommandContext.h"
+#include "FrameScheduler.h"
+#include "GpuTimeline.h"
 #include <d3d12.h>
 #include <wrl/client.h>
 #include <queue>
 
 namespace D3D12Core {
 
-    class D3D12CommandQueue {
+    class D3D12CommandQueue : public IGpuTimeline {
     public:
         D3D12CommandQueue();
-        ~D3D12CommandQueue();
+        ~D3D12CommandQueue() override;
 
         bool Initialize(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT);
         void Shutdown();
@@ -19,26 +23,40 @@ namespace D3D12Core {
         ID3D12CommandAllocator* GetCurrentAllocator() const;
         ID3D12GraphicsCommandList* GetCommandList() const { return m_commandList.Get(); }
 
+        // Grabación multihilo: cada hilo pide su propio contexto del pool del frame actual.
+        // Al ejecutar, la command list principal va primero y luego los contextos por orden
+        D3D12CommandContext* AcquireContext(UINT order);
+        UINT GetActiveContextCount() { return m_contextPool.GetUsedCount(m_frameIndex); }
+
         // Sincronización
-        void ExecuteCommandList();
-        void ResetCommandList();
-        void WaitForGPU();
-        void Flush();
+        void ExecuteCommandList(); // Envía lo grabado desde el último envío (la principal, solo en la primera llamada del frame)
+        void ResetCommandList();   // Espera solo si el allocator del slot sigue en uso por la GPU
+        void EndFrame();           // Registra el fence del frame y avanza al siguiente slot
+        void WaitForIdle();        // Espera el último frame enviado (sin nueva señal)
+        void WaitForGPU();         // Vacía la cola por completo (nueva señal + espera)
+
+        // Fence para sincronización (IGpuTimeline)
+        UINT64 Signal() override;
+        UINT64 GetCompletedValue() const override;
+        void WaitForFenceValue(UINT64 fenceValue) override;
 
-        // Fence para sincronización
-        UINT64 Signal();
-        void WaitForFenceValue(UINT64 fenceValue);
+        UINT GetFrameIndex() const { return m_frameIndex; }
+        const FrameSchedulerStats& GetFrameStats() const { return m_scheduler.GetStats(); }
 
     private:
         ComPtr<ID3D12CommandQueue> m_commandQueue;
         ComPtr<ID3D12CommandAllocator> m_commandAllocators[MAX_FRAMES_IN_FLIGHT];
         ComPtr<ID3D12GraphicsCommandList> m_commandList;
+        bool m_commandListRecording = false;   // Entre ResetCommandList y su envío en ExecuteCommandList
         ComPtr<ID3D12Fence> m_fence;
 
         UINT64 m_fenceValue = 0;
         HANDLE m_fenceEvent = nullptr;
         UINT m_frameIndex = 0;
         D3D12_COMMAND_LIST_TYPE m_type;
+        FrameScheduler m_scheduler;
+        CommandContextPool<D3D12CommandContext> m_contextPool;
+        std::vector<ID3D12CommandList*> m_submitLists;
     };
 
 } // namespace D3D12Core
@@ -16,6 +16,9 @@ namespace D3D12Core {
         XMFLOAT4X4 model;
         XMFLOAT4X4 view;
         XMFLOAT4X4 projection;
+        // Decuantización de la posición de la malla (VertexQuantization, w sin usar)
+        XMFLOAT4 positionScale = { 1.0f, 1.0f, 1.0f, 0.0f };
+        XMFLOAT4 positionBias = { 0.0f, 0.0f, 0.0f, 0.0f };
     };
 
     class D3D12ConstantBuffer {
@@ -23,7 +26,8 @@ namespace D3D12Core {
         D3D12ConstantBuffer();
         ~D3D12ConstantBuffer();
 
-        bool Initialize(ID3D12Device* device, UINT size);
+        // Con allocator, el buffer es un rango de 256 bytes alineado de un upload heap compartido
+        bool Initialize(ID3D12Device* device, UINT size, D3D12HeapAllocator* allocator = nullptr);
         void Shutdown();
 
         void UpdateData(const void* data, UINT size);
@@ -35,6 +39,10 @@ namespace D3D12Core {
         ComPtr<ID3D12Resource> m_resource;
         UINT m_size;
         void* m_mappedData;
+        D3D12_GPU_VIRTUAL_ADDRESS m_gpuAddress = 0;
+
+        D3D12HeapAllocator* m_allocator = nullptr;
+        BufferRange m_range;
     };
 
 } // namespace D3D12Core
@@ -3,6 +3,7 @@
 #include <d3d12.h>
 #include <dxgi1_6.h>
 #include <wrl/client.h>
+#include "RenderGraph.h"
 #include <memory>
 #include <vector>
 #include <string>
@@ -15,12 +16,29 @@ namespace D3D12Core {
     constexpr UINT BACK_BUFFER_COUNT = 3;
     constexpr DXGI_FORMAT BACK_BUFFER_FORMAT = DXGI_FORMAT_R8G8B8A8_UNORM;
     constexpr UINT MAX_FRAMES_IN_FLIGHT = 3;
+    constexpr UINT64 UPLOAD_STAGING_RING_SIZE = 32ull * 1024 * 1024; // Staging acotado para subidas
+    constexpr UINT64 FRAME_DYNAMIC_MEMORY_SIZE = 4ull * 1024 * 1024; // Constantes dinámicas por frame
+    constexpr UINT64 GPU_HEAP_BLOCK_SIZE = 64ull * 1024 * 1024;        // ID3D12Heap para recursos colocados
+    constexpr UINT64 GPU_BUFFER_POOL_BLOCK_SIZE = 16ull * 1024 * 1024; // Buffer compartido para sub-rangos
+    constexpr UINT CPU_DESCRIPTORS_PER_TYPE = 1024;        // RTV/DSV/CBV_SRV_UAV/Sampler no visibles en shaders
+    constexpr UINT BINDLESS_DESCRIPTOR_CAPACITY = 65536;   // Rango bindless persistente (índices en shaders)
+    constexpr UINT TRANSIENT_DESCRIPTORS_PER_FRAME = 4096; // Descriptores temporales por frame en vuelo
+    constexpr UINT ROOT_PARAMETER_BINDLESS_TABLE = 1;      // Tabla bindless (t0, space1) en los root signatures
+    constexpr UINT ROOT_PARAMETER_DRAW_INDEX = 2;          // Pipelines indirect: drawIndex del comando (b1, 1 constante)
+    constexpr UINT ROOT_PARAMETER_INDIRECT_OBJECTS = 3;    // Pipelines indirect: buffer de objetos (SRV raíz t0)
 
     class D3D12Device;
     class D3D12CommandQueue;
+    class D3D12CommandContext;
+    class D3D12UploadManager;
+    class D3D12FrameAllocator;
+    class D3D12HeapAllocator;
+    class D3D12DescriptorManager;
+    class D3D12ResourceStateTracker;
+    struct UploadToken;
     class D3D12SwapChain;
     class D3D12DescriptorHeap;
-    class D3D12HighResRenderTarget;
+    class D3D12RenderGraphBackend;
 
     // Clase principal que gestiona DirectX 12
     class D3D12Core {
@@ -31,14 +49,33 @@ namespace D3D12Core {
         bool Initialize(HWND hwnd, UINT width, UINT height);
         void Shutdown();
 
+        // BeginFrame empieza el grafo del frame (back buffer importado + pase de limpieza);
+        // los pases añadidos hasta EndFrame se compilan y graban en EndFrame
         void BeginFrame();
         void EndFrame();
-        void Present();
+        void Present(UINT syncInterval = 1); // 1: VSync
+
+        RenderGraph* GetRenderGraph() const { return m_renderGraph.get(); }
+        D3D12RenderGraphBackend* GetRenderGraphBackend() const { return m_renderGraphBackend.get(); }
+        RenderGraphResource GetBackBufferResource() const { return m_backBufferResource; }
+
+        // Contexto de grabación para un hilo de trabajo, con el render target, viewport,
+        // scissor y heap de descriptores del frame ya establecidos. Llamar entre BeginFrame y EndFrame
+        D3D12CommandContext* AcquireRecordingContext(UINT order);
+
+        // Declara que el frame actual usa un recurso subido de forma asíncrona.
+        // En EndFrame la cola directa espera (en GPU) solo si la copia no ha terminado
+        void RequireUpload(const UploadToken& token);
 
         // Getters
         D3D12Device* GetDevice() const { return m_device.get(); }
         D3D12CommandQueue* GetCommandQueue() const { return m_commandQueue.get(); }
         D3D12SwapChain* GetSwapChain() const { return m_swapChain.get(); }
+        D3D12UploadManager* GetUploadManager() const { return m_uploadManager.get(); }
+        D3D12FrameAllocator* GetFrameAllocator() const { return m_frameAllocator.get(); }
+        D3D12HeapAllocator* GetHeapAllocator() const { return m_heapAllocator.get(); }
+        D3D12DescriptorManager* GetDescriptorManager() const { return m_descriptorManager.get(); }
+        D3D12ResourceStateTracker* GetStateTracker() const { return m_stateTracker.get(); }
         UINT GetCurrentBackBufferIndex() const { return m_currentBackBufferIndex; }
         UINT GetFrameIndex() const { return m_frameIndex; }
         
@@ -46,7 +83,7 @@ namespace D3D12Core {
         UINT GetWidth() const { return m_width; }
         UINT GetHeight() const { return m_height; }
         
-        // Obtener dimensiones de renderizado de alta calidad
+        // Resolución interna recomendada (para transitorios del grafo a calidad interna)
         UINT GetRenderWidth() const { return m_renderWidth; }
         UINT GetRenderHeight() const { return m_renderHeight; }
 
@@ -54,17 +91,28 @@ namespace D3D12Core {
         void Resize(UINT width, UINT height);
 
     private:
+        void RegisterBackBuffers();
+        void UnregisterBackBuffers();
+
         std::unique_ptr<D3D12Device> m_device;
         std::unique_ptr<D3D12CommandQueue> m_commandQueue;
         std::unique_ptr<D3D12SwapChain> m_swapChain;
-        std::unique_ptr<D3D12HighResRenderTarget> m_highResRenderTarget;
+        std::unique_ptr<D3D12UploadManager> m_uploadManager;
+        std::unique_ptr<D3D12FrameAllocator> m_frameAllocator;
+        std::unique_ptr<D3D12HeapAllocator> m_heapAllocator;
+        std::unique_ptr<D3D12DescriptorManager> m_descriptorManager;
+        std::unique_ptr<D3D12ResourceStateTracker> m_stateTracker; // Estados de la cola directa
+        std::unique_ptr<RenderGraph> m_renderGraph;
+        std::unique_ptr<D3D12RenderGraphBackend> m_renderGraphBackend;
+        RenderGraphResource m_backBufferResource;
+        UINT64 m_frameUploadFence = 0; // Mayor token de subida requerido por el frame actual
 
         UINT m_currentBackBufferIndex = 0;
         UINT m_frameIndex = 0;
         UINT m_width = 0;  // Tamaño del viewport (puede variar)
         UINT m_height = 0; // Tamaño del viewport (puede variar)
-        UINT m_renderWidth = 1920;  // Resolución de renderizado fija (alta calidad)
-        UINT m_renderHeight = 1080; // Resolución de renderizado fija (alta calidad)
+        UINT m_renderWidth = 1920;  // Resolución interna (calculada en Resize)
+        UINT m_renderHeight = 1080; // Resolución interna (calculada en Resize)
         HWND m_hwnd = nullptr;
     };
 
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "D3D12Core.h"
+#include "D3D12DescriptorHeap.h"
+#include "TlsfAllocator.h"
+#include "LinearAllocator.h"
+#include <d3d12.h>
+#include <mutex>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Bloque contiguo de descriptores
+    struct DescriptorHandle {
+        D3D12_CPU_DESCRIPTOR_HANDLE cpu = {};
+        D3D12_GPU_DESCRIPTOR_HANDLE gpu = {}; // Solo en el heap visible en shaders
+        UINT index = 0;     // Posición en su heap; en bindless es el índice que usa el shader
+        UINT count = 0;
+        UINT increment = 0;
+        D3D12_DESCRIPTOR_HEAP_TYPE type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        bool bindless = false;
+        uint32_t allocation = TlsfAllocator::INVALID_HANDLE; // Inválido en transitorios
+
+        bool IsValid() const { return count > 0; }
+        D3D12_CPU_DESCRIPTOR_HANDLE GetCPU(UINT offset) const { return { cpu.ptr + static_cast<SIZE_T>(offset) * increment }; }
+        D3D12_GPU_DESCRIPTOR_HANDLE GetGPU(UINT offset) const { return { gpu.ptr + static_cast<UINT64>(offset) * increment }; }
+    };
+
+    struct DescriptorStats {
+        UINT persistentUsed[D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES] = {};
+        UINT bindlessUsed = 0;
+        UINT64 transientUsed = 0;      // Frame actual
+        UINT64 transientPeak = 0;
+        UINT64 failedAllocations = 0;
+        UINT64 deferredFrees = 0;      // Liberaciones pendientes de que la GPU termine
+    };
+
+    // Gestor central de descriptores
+    //  - Persistentes (RTV, DSV, staging CBV/SRV/UAV, samplers): heaps no visibles con free-list
+    //  - Bindless: rango grande del heap CBV/SRV/UAV visible en shaders; el shader indexa con
+    //    DescriptorHandle::index a través de la tabla ROOT_PARAMETER_BINDLESS_TABLE (t0, space1)
+    //  - Transitorios: resto del heap visible, dividido en una región por frame en vuelo que
+    //    se recupera entera en BeginFrame
+    // Las liberaciones se retrasan hasta que el slot del frame que las pidió se reutiliza
+    class D3D12DescriptorManager {
+    public:
+        D3D12DescriptorManager();
+        ~D3D12DescriptorManager();
+
+        bool Initialize(ID3D12Device* device,
+            UINT cpuDescriptorsPerType = CPU_DESCRIPTORS_PER_TYPE,
+            UINT bindlessCapacity = BINDLESS_DESCRIPTOR_CAPACITY,
+            UINT transientPerFrame = TRANSIENT_DESCRIPTORS_PER_FRAME);
+        void Shutdown();
+
+        // Llamar tras esperar el fence del slot: libera lo pedido en él y recupera su región transitoria
+        void BeginFrame(UINT frameSlot);
+
+        DescriptorHandle AllocatePersistent(D3D12_DESCRIPTOR_HEAP_TYPE type, UINT count = 1);
+        DescriptorHandle AllocateBindless(UINT count = 1);
+        void Free(DescriptorHandle& handle);
+
+        // Válidos solo durante el frame actual. Seguro entre hilos
+        DescriptorHandle AllocateTransient(UINT count);
+        // Copia descriptores no visibles a un bloque transitorio y devuelve su tabla GPU
+        D3D12_GPU_DESCRIPTOR_HANDLE CopyToTransient(const D3D12_CPU_DESCRIPTOR_HANDLE* sources, UINT count);
+
+        // Enlaza el heap visible y la tabla bindless (tras SetGraphicsRootSignature)
+        void BindHeaps(ID3D12GraphicsCommandList* commandList) const;
+        void BindBindlessTable(ID3D12GraphicsCommandList* commandList, UINT rootParameterIndex = ROOT_PARAMETER_BINDLESS_TABLE) const;
+
+        // Capacidad bindless que admite el hardware: con Resource Binding Tier 1 una tabla no pasa
+        // de 128 SRVs y todos deben estar inicializados (Initialize los rellena con SRVs nulos)
+        static D3D12_RESOURCE_BINDING_TIER GetResourceBindingTier(ID3D12Device* device);
+        static UINT GetSupportedBindlessCapacity(ID3D12Device* device, UINT bindlessCapacity = BINDLESS_DESCRIPTOR_CAPACITY);
+        // Rango para los root signatures: SRVs t0.. en space1 cubriendo todo el rango bindless.
+        // DESCRIPTORS_VOLATILE: los huecos sin asignar pueden seguir sin inicializar (Tier 2+)
+        static D3D12_DESCRIPTOR_RANGE1 GetBindlessRange(UINT bindlessCapacity);
+        // Serializa como 1.1, o como 1.0 si el runtime no la admite (misma semántica volátil)
+        static HRESULT SerializeRootSignature(ID3D12Device* device, const D3D12_ROOT_SIGNATURE_DESC1& desc,
+            ID3DBlob** signature, ID3DBlob** error);
+
+        ID3D12DescriptorHeap* GetShaderVisibleHeap() const { return m_shaderVisibleHeap.GetHeap(); }
+        D3D12_GPU_DESCRIPTOR_HANDLE GetBindlessTableStart() const { return m_shaderVisibleHeap.GetGPUHandle(0); }
+        UINT GetBindlessCapacity() const { return m_bindlessCapacity; }
+        DescriptorStats GetStats() const;
+
+    private:
+        ID3D12Device* m_device = nullptr;
+
+        D3D12DescriptorHeap m_cpuHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES];
+        TlsfAllocator m_cpuFreeLists[D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES];
+
+        D3D12DescriptorHeap m_shaderVisibleHeap;
+        TlsfAllocator m_bindlessFreeList;
+        LinearAllocator m_transientRegions[MAX_FRAMES_IN_FLIGHT];
+        UINT m_bindlessCapacity = 0;
+        UINT m_currentSlot = 0;
+
+        std::vector<DescriptorHandle> m_pendingFrees[MAX_FRAMES_IN_FLIGHT];
+        UINT64 m_transientPeak = 0;
+        UINT64 m_failedAllocations = 0;
+        mutable std::mutex m_mutex;
+
+        void ReleaseNow(const DescriptorHandle& handle);
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "D3D12Core.h"
+#include "LinearAllocator.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <cstring>
+
+namespace D3D12Core {
+
+    // Bloque de memoria dinámica válido solo durante el frame en que se asignó
+    struct DynamicAllocation {
+        void* cpuAddress = nullptr;
+        D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;
+        UINT64 size = 0;
+        bool IsValid() const { return cpuAddress != nullptr; }
+    };
+
+    // Asignador lineal por frame para datos dinámicos (constantes por draw, instancias...)
+    // Un único upload heap mapeado se divide en MAX_FRAMES_IN_FLIGHT regiones; cada frame
+    // avanza un puntero en la región de su slot y BeginFrame la recupera entera cuando el
+    // fence de ese slot ya se completó. No crea ningún objeto de API por draw
+    class D3D12FrameAllocator {
+    public:
+        D3D12FrameAllocator();
+        ~D3D12FrameAllocator();
+
+        bool Initialize(ID3D12Device* device, UINT64 bytesPerFrame);
+        void Shutdown();
+
+        // Llamar tras esperar el fence del slot (D3D12CommandQueue::ResetCommandList)
+        void BeginFrame(UINT frameSlot);
+
+        // Seguro entre hilos. Por defecto alineado a 256 bytes (requisito de CBV)
+        DynamicAllocation Allocate(UINT64 size, UINT64 alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+        // Copia un bloque de constantes y devuelve su dirección GPU (0 si no hay espacio)
+        template <typename T>
+        D3D12_GPU_VIRTUAL_ADDRESS AllocateConstants(const T& data) {
+            DynamicAllocation allocation = Allocate(sizeof(T));
+            if (!allocation.IsValid()) {
+                return 0;
+            }
+            memcpy(allocation.cpuAddress, &data, sizeof(T));
+            return allocation.gpuAddress;
+        }
+
+        // Recurso y offset de una dirección de este asignador (ExecuteIndirect los pide así);
+        // false si la dirección no es suya
+        ID3D12Resource* GetResource() const { return m_resource.Get(); }
+        bool GetResourceOffset(D3D12_GPU_VIRTUAL_ADDRESS address, UINT64& offset) const {
+            if (!m_resource || address < m_gpuBase || address >= m_gpuBase + m_bytesPerFrame * MAX_FRAMES_IN_FLIGHT) {
+                return false;
+            }
+            offset = address - m_gpuBase;
+            return true;
+        }
+
+        UINT64 GetBytesPerFrame() const { return m_bytesPerFrame; }
+        UINT64 GetUsedBytes() const { return m_regions[m_currentSlot].GetUsedBytes(); }
+        UINT64 GetAllocationCount() const { return m_regions[m_currentSlot].GetAllocationCount(); }
+        UINT64 GetFailedCount() const { return m_regions[m_currentSlot].GetFailedCount(); }
+
+    private:
+        ComPtr<ID3D12Resource> m_resource;
+        BYTE* m_mappedData = nullptr;
+        D3D12_GPU_VIRTUAL_ADDRESS m_gpuBase = 0;
+        UINT64 m_bytesPerFrame = 0;
+        LinearAllocator m_regions[MAX_FRAMES_IN_FLIGHT];
+        UINT m_currentSlot = 0;
+    };
+
+} // namespace D3D12Core
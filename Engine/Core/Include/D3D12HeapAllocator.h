@@ -0,0 +1,120 @@
+#pragma once
+
+#include "D3D12Core.h"
+#include "TlsfAllocator.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Rango dentro de un buffer compartido (vertex/index/constantes pequeños)
+    struct BufferRange {
+        ID3D12Resource* resource = nullptr;
+        UINT64 offset = 0;
+        UINT64 size = 0;
+        D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;
+        void* cpuAddress = nullptr; // Solo en rangos de upload heap (mapeados)
+        UINT pool = 0;
+        UINT block = 0;
+        uint32_t handle = TlsfAllocator::INVALID_HANDLE;
+        bool IsValid() const { return handle != TlsfAllocator::INVALID_HANDLE; }
+    };
+
+    // Recurso colocado (CreatePlacedResource) dentro de un ID3D12Heap grande
+    struct PlacedAllocation {
+        ComPtr<ID3D12Resource> resource;
+        UINT64 heapOffset = 0;
+        UINT64 size = 0;
+        UINT pool = 0;
+        UINT block = 0;
+        uint32_t handle = TlsfAllocator::INVALID_HANDLE;
+        bool IsValid() const { return handle != TlsfAllocator::INVALID_HANDLE; }
+    };
+
+    // Sub-asignador de memoria de GPU
+    // Reserva pocos bloques grandes y reparte su espacio con TLSF en lugar de un
+    // CreateCommittedResource (heap implícito) por recurso:
+    //  - Buffers pequeños: rangos de un buffer compartido, porque un recurso colocado
+    //    ocupa como mínimo 64 KB (D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT)
+    //  - Buffers grandes o con flags, y texturas: recursos colocados en ID3D12Heap. Los
+    //    RT/DS con MSAA van en heaps propios alineados a 4 MB
+    //    (D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT)
+    // Liberar no espera a la GPU: el llamador debe garantizar que ya no se usa
+    class D3D12HeapAllocator {
+    public:
+        D3D12HeapAllocator();
+        ~D3D12HeapAllocator();
+
+        bool Initialize(ID3D12Device* device,
+            UINT64 heapBlockSize = GPU_HEAP_BLOCK_SIZE,
+            UINT64 bufferBlockSize = GPU_BUFFER_POOL_BLOCK_SIZE);
+        void Shutdown();
+
+        // heapType: DEFAULT (copiar con el upload manager) o UPLOAD (mapeado, cpuAddress válido)
+        // Tamaños por encima de bufferBlockSize / 4 devuelven un rango inválido: usar CreatePlacedResource
+        BufferRange AllocateBuffer(UINT64 size, D3D12_HEAP_TYPE heapType,
+            UINT64 alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+        void FreeBuffer(BufferRange& range);
+
+        bool CreatePlacedResource(
+            const D3D12_RESOURCE_DESC& desc,
+            D3D12_HEAP_TYPE heapType,
+            D3D12_RESOURCE_STATES initialState,
+            const D3D12_CLEAR_VALUE* clearValue,
+            PlacedAllocation& allocation
+        );
+        void FreePlaced(PlacedAllocation& allocation);
+
+        UINT64 GetMaxBufferRangeSize() const { return m_bufferBlockSize / 4; }
+
+        // Uso, bloques y fragmentación por pool
+        std::string BuildReport() const;
+        void LogReport() const;
+
+    private:
+        enum PoolType : UINT {
+            POOL_BUFFER_DEFAULT = 0,
+            POOL_BUFFER_UPLOAD,
+            POOL_PLACED_BUFFERS,
+            POOL_PLACED_TEXTURES,
+            POOL_PLACED_RENDER_TARGETS,
+            POOL_PLACED_MSAA_TARGETS,
+            POOL_PLACED_BUFFERS_UPLOAD,
+            POOL_COUNT
+        };
+
+        struct Block {
+            ComPtr<ID3D12Heap> heap;           // Pools de recursos colocados
+            ComPtr<ID3D12Resource> buffer;     // Pools de buffers compartidos
+            BYTE* mappedData = nullptr;
+            D3D12_GPU_VIRTUAL_ADDRESS gpuBase = 0;
+            TlsfAllocator tlsf;
+        };
+
+        struct Pool {
+            const char* name = "";
+            D3D12_HEAP_TYPE heapType = D3D12_HEAP_TYPE_DEFAULT;
+            D3D12_HEAP_FLAGS heapFlags = D3D12_HEAP_FLAG_NONE;
+            bool sharedBuffer = false;
+            UINT64 blockSize = 0;
+            UINT64 alignment = 0;          // Del heap y granularidad de sus rangos: la máxima que admite
+            std::vector<std::unique_ptr<Block>> blocks; // nullptr = hueco reutilizable
+        };
+
+        bool AllocateFromPool(UINT poolIndex, UINT64 size, UINT64 alignment,
+            UINT& blockIndex, TlsfAllocator::Allocation& allocation);
+        Block* CreateBlock(Pool& pool, UINT64 size);
+        void FreeFromPool(UINT poolIndex, UINT blockIndex, uint32_t handle);
+        static UINT SelectPlacedPool(const D3D12_RESOURCE_DESC& desc, D3D12_HEAP_TYPE heapType);
+
+        ID3D12Device* m_device = nullptr;
+        UINT64 m_bufferBlockSize = 0;
+        Pool m_pools[POOL_COUNT];
+        mutable std::mutex m_mutex;
+    };
+
+} // namespace D3D12Core
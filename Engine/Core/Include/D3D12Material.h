@@ -7,6 +7,7 @@
 #include <DirectXMath.h>
 #include <wrl/client.h>
 #include "Shader.h"
+#include "D3D12HeapAllocator.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -49,7 +50,8 @@ namespace D3D12Core {
             ID3D12Device* device,
             const std::string& materialName,
             const std::string& vertexShaderPath,
-            const std::string& pixelShaderPath
+            const std::string& pixelShaderPath,
+            D3D12HeapAllocator* heapAllocator = nullptr // Sub-asigna el constant buffer si se indica
         );
 
         // Gestión de parámetros
@@ -97,6 +99,8 @@ namespace D3D12Core {
         ComPtr<ID3D12Resource> m_constantBuffer;
         void* m_constantBufferMapped = nullptr;
         UINT m_constantBufferSize = 256; // Tamaño mínimo, ajustar según parámetros
+        D3D12HeapAllocator* m_heapAllocator = nullptr;
+        BufferRange m_constantBufferRange;
         
         // Device reference
         ID3D12Device* m_device = nullptr;
@@ -3,6 +3,9 @@
 #include "D3D12Core.h"
 #include "D3D12Buffer.h"
 #include "D3D12PipelineState.h"
+#include "D3D12UploadManager.h"
+#include "MeshLod.h"
+#include "VertexFormat.h"
 #include <d3d12.h>
 #include <vector>
 
@@ -15,22 +18,55 @@ namespace D3D12Core {
 
         bool Initialize(
             ID3D12Device* device,
-            ID3D12CommandQueue* commandQueue,
+            D3D12UploadManager* uploadManager,
             const std::vector<Vertex>& vertices,
-            const std::vector<UINT>& indices
+            const std::vector<UINT>& indices,
+            D3D12HeapAllocator* heapAllocator = nullptr, // Sub-asigna VB/IB en lugar de recursos propios
+            const VertexFormat& format = VertexFormat()  // Los vértices se codifican a este formato al subirlos
+        );
+        // Con todos los niveles de lods en el mismo index buffer: el LOD solo cambia el rango del draw
+        bool Initialize(
+            ID3D12Device* device,
+            D3D12UploadManager* uploadManager,
+            const std::vector<Vertex>& vertices,
+            const MeshLodChain& lods,
+            D3D12HeapAllocator* heapAllocator = nullptr,
+            const VertexFormat& format = VertexFormat()
         );
         void Shutdown();
 
-        void Draw(ID3D12GraphicsCommandList* commandList);
+        // Solo enlaza vertex/index buffers y topología (draws de ExecuteIndirect)
+        void Bind(ID3D12GraphicsCommandList* commandList);
+        // Solo el stream de posiciones (pases de profundidad y sombras con un input layout de
+        // BuildInputLayout(..., positionOnly = true)): con el formato partido no lee el color
+        void BindPositions(ID3D12GraphicsCommandList* commandList);
+        void Draw(ID3D12GraphicsCommandList* commandList, UINT lod = 0);
+        // Con un pipeline instanciado: instanceView en el slot GetStreamCount() (InstanceData)
+        void DrawInstanced(ID3D12GraphicsCommandList* commandList, const D3D12_VERTEX_BUFFER_VIEW& instanceView,
+            UINT instanceCount, UINT startInstance = 0, UINT lod = 0);
+
+        // Índices del nivel completo
+        UINT GetIndexCount() const { return m_lods.empty() ? 0 : m_lods[0].indexCount; }
+        // Un LOD mayor que los que hay se dibuja con el último
+        UINT GetLodCount() const { return static_cast<UINT>(m_lods.size()); }
+        const MeshLod& GetLod(UINT lod) const { return m_lods[lod < m_lods.size() ? lod : m_lods.size() - 1]; }
+
+        const VertexFormat& GetVertexFormat() const { return m_format; }
+        // Escala y bias de las posiciones: van en positionScale/positionBias de MVPConstantBuffer
+        const VertexQuantization& GetQuantization() const { return m_quantization; }
 
-        UINT GetIndexCount() const { return m_indexCount; }
+        // Token de la subida asíncrona de vertex/index buffers (ver D3D12Core::RequireUpload)
+        const UploadToken& GetUploadToken() const { return m_uploadToken; }
 
     private:
-        std::unique_ptr<D3D12Buffer> m_vertexBuffer;
+        std::unique_ptr<D3D12Buffer> m_vertexBuffers[MAX_VERTEX_STREAMS];
         std::unique_ptr<D3D12Buffer> m_indexBuffer;
-        D3D12_VERTEX_BUFFER_VIEW m_vertexBufferView = {};
+        D3D12_VERTEX_BUFFER_VIEW m_vertexBufferViews[MAX_VERTEX_STREAMS] = {};
+        VertexFormat m_format;
+        VertexQuantization m_quantization;
         D3D12_INDEX_BUFFER_VIEW m_indexBufferView = {};
-        UINT m_indexCount = 0;
+        std::vector<MeshLod> m_lods;
+        UploadToken m_uploadToken;
     };
 
 } // namespace D3D12Core
@@ -1,40 +1,60 @@
 #pragma once
 
 #include "D3D12Core.h"
+#include "RHI.h"
 #include "Shader.h"
+#include "Vertex.h"
 #include <d3d12.h>
 #include <wrl/client.h>
 
 namespace D3D12Core {
 
-    struct Vertex {
-        float position[3];
-        float color[3];
-    };
+    // Input layout de D3D12 de un formato de vértices (BuildVertexElements). Lo comparten los PSO
+    // del engine y los de los materiales para que no se desincronicen
+    UINT BuildInputLayout(const VertexFormat& format, bool instanced, bool positionOnly,
+        D3D12_INPUT_ELEMENT_DESC elements[MAX_VERTEX_ELEMENTS]);
 
     class D3D12PipelineState {
     public:
         D3D12PipelineState();
         ~D3D12PipelineState();
 
+        // instanced: el input layout añade el stream por instancia (InstanceData) en el slot
+        // siguiente a los de vértices (vertexFormat.GetStreamCount())
+        // indirect: IndirectVS; la root signature añade el drawIndex (ROOT_PARAMETER_DRAW_INDEX) y el
+        // buffer de objetos (ROOT_PARAMETER_INDIRECT_OBJECTS) y se crea la firma de ExecuteIndirect
         bool Initialize(
             ID3D12Device* device,
             const Shader& vertexShader,
             const Shader& pixelShader,
-            DXGI_FORMAT rtvFormat
+            DXGI_FORMAT rtvFormat,
+            bool instanced = false,
+            const VertexFormat& vertexFormat = VertexFormat(),
+            bool indirect = false
         );
         void Shutdown();
 
         ID3D12PipelineState* GetPSO() const { return m_pipelineState.Get(); }
         ID3D12RootSignature* GetRootSignature() const { return m_rootSignature.Get(); }
         bool HasConstantBuffer() const { return m_hasConstantBuffer; }
+        bool IsInstanced() const { return m_instanced; }
+        bool IsIndirect() const { return m_indirect; }
+        const VertexFormat& GetVertexFormat() const { return m_vertexFormat; }
+        // Firma de ExecuteIndirect para RHIIndirectDrawCommand (drawIndex raíz + DrawIndexed);
+        // nullptr salvo en pipelines indirect
+        ID3D12CommandSignature* GetDrawIndirectSignature() const { return m_drawIndirectSignature.Get(); }
 
     private:
         ComPtr<ID3D12RootSignature> m_rootSignature;
         ComPtr<ID3D12PipelineState> m_pipelineState;
+        ComPtr<ID3D12CommandSignature> m_drawIndirectSignature;
         bool m_hasConstantBuffer = false;
+        bool m_instanced = false;
+        bool m_indirect = false;
+        VertexFormat m_vertexFormat;
 
         bool CreateRootSignature(ID3D12Device* device, bool useConstantBuffer = true);
+        bool CreateDrawIndirectSignature(ID3D12Device* device);
         bool CreatePipelineState(
             ID3D12Device* device,
             const Shader& vertexShader,
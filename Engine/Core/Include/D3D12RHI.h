@@ -0,0 +1,145 @@
+#pragma once
+
+#include "D3D12Core.h"
+#include "D3D12Buffer.h"
+#include "D3D12PipelineState.h"
+#include "D3D12UploadManager.h"
+#include "RHI.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+
+namespace D3D12Core {
+
+    DXGI_FORMAT ToDXGIFormat(RHIFormat format);
+
+    // Implementación D3D12 de la RHI sobre las clases existentes (D3D12Buffer,
+    // D3D12PipelineState, D3D12CommandQueue...). No añade estado propio salvo lo necesario
+    // para traducir llamadas: el código D3D12 directo y el que usa la RHI pueden convivir
+
+    class D3D12RHIBuffer : public IRHIBuffer {
+    public:
+        D3D12RHIBuffer(const RHIBufferDesc& desc, std::unique_ptr<D3D12Buffer> buffer, const UploadToken& uploadToken)
+            : m_desc(desc), m_buffer(std::move(buffer)), m_uploadToken(uploadToken) {}
+
+        const RHIBufferDesc& GetDesc() const override { return m_desc; }
+        uint64_t GetGpuAddress() const override { return m_buffer->GetGPUVirtualAddress(); }
+
+        D3D12Buffer* GetBuffer() const { return m_buffer.get(); }
+        const UploadToken& GetUploadToken() const { return m_uploadToken; }
+
+    private:
+        RHIBufferDesc m_desc;
+        std::unique_ptr<D3D12Buffer> m_buffer;
+        UploadToken m_uploadToken; // Copia de los datos iniciales por la cola de copia
+    };
+
+    class D3D12RHIPipeline : public IRHIPipeline {
+    public:
+        D3D12RHIPipeline(const RHIPipelineDesc& desc, std::unique_ptr<D3D12PipelineState> pipeline)
+            : m_desc(desc), m_pipeline(std::move(pipeline)) {}
+
+        const RHIPipelineDesc& GetDesc() const override { return m_desc; }
+        D3D12PipelineState* GetPipelineState() const { return m_pipeline.get(); }
+
+    private:
+        RHIPipelineDesc m_desc;
+        std::unique_ptr<D3D12PipelineState> m_pipeline;
+    };
+
+    // Command list D3D12 vista desde la RHI
+    //  - Propia (CreateCommandList): un allocator por frame en vuelo; Begin espera solo si el
+    //    allocator que toca reutilizar sigue en uso por la GPU
+    //  - Envuelta (constructor con lista nativa): la lista del frame de D3D12Core o la de un
+    //    contexto de trabajo. D3D12Core la resetea y la envía, así que Begin/Close no hacen nada
+    class D3D12RHICommandList : public IRHICommandList {
+    public:
+        D3D12RHICommandList(D3D12Core* core, ID3D12GraphicsCommandList* nativeList);
+        explicit D3D12RHICommandList(D3D12Core* core);
+        ~D3D12RHICommandList() override;
+
+        bool Initialize(ID3D12Device* device); // Solo para listas propias
+
+        void Begin() override;
+        void Close() override;
+
+        void SetRenderTarget(uint64_t renderTargetView) override;
+        void ClearRenderTarget(uint64_t renderTargetView, const float color[4]) override;
+        void SetViewport(const RHIViewport& viewport) override;
+        void SetScissor(const RHIRect& rect) override;
+        void SetPipeline(IRHIPipeline* pipeline) override;
+        void SetConstantBuffer(uint32_t rootParameter, uint64_t gpuAddress) override;
+        void SetVertexBuffer(IRHIBuffer* buffer, uint32_t stream = 0) override;
+        void SetIndexBuffer(IRHIBuffer* buffer, RHIFormat format) override;
+        void SetInstanceBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) override;
+        void SetObjectBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) override;
+        void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex, uint32_t startInstance) override;
+        void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override;
+        // argumentAddress debe venir de AllocateConstants (D3D12FrameAllocator)
+        void ExecuteIndirect(uint64_t argumentAddress, uint32_t commandCount) override;
+
+        void* GetNativeCommandList() override { return m_commandList; }
+
+        bool IsOwned() const { return m_owned; }
+        // Mayor subida de la que depende la grabación actual (la cola la espera al enviar)
+        const UploadToken& GetRequiredUpload() const { return m_requiredUpload; }
+        void SetSubmittedFence(uint64_t fenceValue) { m_allocatorFences[m_allocatorIndex] = fenceValue; }
+
+    private:
+        void RequireUpload(IRHIBuffer* buffer);
+
+        D3D12Core* m_core;
+        ID3D12GraphicsCommandList* m_commandList = nullptr;
+        bool m_owned = false;
+        D3D12PipelineState* m_pipelineState = nullptr; // Último SetPipeline (firma de ExecuteIndirect)
+
+        ComPtr<ID3D12GraphicsCommandList> m_ownedList;
+        ComPtr<ID3D12CommandAllocator> m_allocators[MAX_FRAMES_IN_FLIGHT];
+        uint64_t m_allocatorFences[MAX_FRAMES_IN_FLIGHT] = {};
+        UINT m_allocatorIndex = 0;
+        UploadToken m_requiredUpload;
+    };
+
+    // Cola directa de D3D12Core; el fence es el de D3D12CommandQueue
+    class D3D12RHICommandQueue : public IRHICommandQueue {
+    public:
+        explicit D3D12RHICommandQueue(D3D12Core* core) : m_core(core) {}
+
+        void ExecuteCommandList(IRHICommandList* commandList) override;
+
+        uint64_t Signal() override;
+        uint64_t GetCompletedValue() const override;
+        void WaitForFenceValue(uint64_t fenceValue) override;
+
+    private:
+        D3D12Core* m_core;
+    };
+
+    class D3D12RHIDevice : public IRHIDevice {
+    public:
+        D3D12RHIDevice();
+        ~D3D12RHIDevice() override;
+
+        bool Initialize(D3D12Core* core);
+        void Shutdown();
+
+        const char* GetBackendName() const override { return "D3D12"; }
+        IRHICommandQueue* GetQueue() override { return m_queue.get(); }
+
+        // Los datos iniciales se encolan en el lote abierto del upload manager (sin bloquear)
+        std::unique_ptr<IRHIBuffer> CreateBuffer(const RHIBufferDesc& desc, const void* initialData = nullptr) override;
+        // vertexStride debe ser el del stream 0 de vertexFormat e instanceStride 0 o
+        // sizeof(InstanceData): D3D12PipelineState usa los input layouts del engine (BuildInputLayout)
+        std::unique_ptr<IRHIPipeline> CreatePipeline(const RHIPipelineDesc& desc) override;
+        std::unique_ptr<IRHICommandList> CreateCommandList() override;
+        // Memoria dinámica del frame actual de D3D12Core (D3D12FrameAllocator)
+        uint64_t AllocateConstants(const void* data, uint64_t size) override;
+
+        // Vista RHI de una lista que ya gestiona D3D12Core (p. ej. context.commandList en un pase)
+        std::unique_ptr<IRHICommandList> WrapCommandList(ID3D12GraphicsCommandList* nativeList);
+
+    private:
+        D3D12Core* m_core = nullptr;
+        std::unique_ptr<D3D12RHICommandQueue> m_queue;
+    };
+
+} // namespace D3D12Core
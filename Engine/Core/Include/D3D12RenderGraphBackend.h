@@ -0,0 +1,89 @@
+#pragma once
+
+#include "D3D12Core.h"
+#include "D3D12DescriptorManager.h"
+#include "RenderGraph.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <vector>
+
+using Microsoft::WRL::ComPtr;
+
+namespace D3D12Core {
+
+    class D3D12CommandQueue;
+    class D3D12ResourceStateTracker;
+
+    // Backend D3D12 del RenderGraph
+    //  - Los transitorios son recursos colocados en heaps propios del grafo, en el offset que
+    //    decidió el compilador; varios comparten memoria si sus vidas no se cruzan
+    //  - Mientras el grafo compilado no cambie (mismos transitorios, tamaños y offsets) los
+    //    recursos se reutilizan frame a frame; si cambia se recrean tras esperar a la GPU
+    //  - Las barreras de cada pase (aliasing + transiciones) salen en una sola llamada
+    //    ResourceBarrier a través del D3D12ResourceStateTracker
+    class D3D12RenderGraphBackend : public RenderGraphBackend {
+    public:
+        // Categorías de heap (Resource Heap Tier 1: RT/DS y el resto de texturas no se mezclan)
+        enum HeapCategory : uint32_t {
+            HEAP_RT_DS_TEXTURES = 0,
+            HEAP_OTHER_TEXTURES,
+            HEAP_CATEGORY_COUNT
+        };
+
+        D3D12RenderGraphBackend();
+        ~D3D12RenderGraphBackend() override;
+
+        bool Initialize(ID3D12Device* device, D3D12CommandQueue* commandQueue,
+            D3D12DescriptorManager* descriptorManager, D3D12ResourceStateTracker* stateTracker);
+        void Shutdown();
+
+        // Command list en la que se grabará el siguiente Execute
+        void SetCommandList(ID3D12GraphicsCommandList* commandList) { m_commandList = commandList; }
+
+        RenderGraphMemoryRequirements GetMemoryRequirements(const RenderGraphTextureDesc& desc, uint32_t usageMask) override;
+        bool PrepareResources(const RenderGraph& graph) override;
+        void BeginPass(const RenderGraph& graph, const RenderGraph::CompiledPass& pass) override;
+        void EndGraph(const RenderGraph& graph) override;
+        void* GetCommandList() override { return m_commandList; }
+
+        // Acceso desde los pases (válido durante Execute)
+        ID3D12Resource* GetResource(const RenderGraph& graph, RenderGraphResource resource) const;
+        D3D12_CPU_DESCRIPTOR_HANDLE GetRTV(const RenderGraph& graph, RenderGraphResource resource) const;
+        D3D12_CPU_DESCRIPTOR_HANDLE GetDSV(const RenderGraph& graph, RenderGraphResource resource) const;
+        // Índice bindless del SRV de un transitorio leído como ShaderResource (UINT_MAX si no hay)
+        UINT GetShaderResourceIndex(RenderGraphResource resource) const;
+
+        static D3D12_RESOURCE_STATES ToResourceState(RenderGraphUsage usage);
+        UINT64 GetHeapBytes() const;
+
+    private:
+        struct Transient {
+            RenderGraphTextureDesc desc;
+            uint32_t usageMask = 0;
+            uint32_t heapCategory = 0;
+            uint64_t heapOffset = 0;
+            uint64_t size = 0;
+            ComPtr<ID3D12Resource> resource;
+            DescriptorHandle rtv;
+            DescriptorHandle dsv;
+            DescriptorHandle srv;
+        };
+
+        D3D12_RESOURCE_DESC BuildResourceDesc(const RenderGraphTextureDesc& desc, uint32_t usageMask) const;
+        bool Matches(const RenderGraph& graph) const;
+        bool CreateTransient(const RenderGraph::ResourceInfo& info, Transient& transient);
+        void ReleaseTransients();
+        ID3D12Resource* Resolve(const RenderGraph& graph, RenderGraphResource resource) const;
+
+        ID3D12Device* m_device = nullptr;
+        D3D12CommandQueue* m_commandQueue = nullptr;
+        D3D12DescriptorManager* m_descriptorManager = nullptr;
+        D3D12ResourceStateTracker* m_stateTracker = nullptr;
+        ID3D12GraphicsCommandList* m_commandList = nullptr;
+
+        ComPtr<ID3D12Heap> m_heaps[HEAP_CATEGORY_COUNT];
+        UINT64 m_heapSizes[HEAP_CATEGORY_COUNT] = {};
+        std::vector<Transient> m_transients; // Indexado como los recursos del grafo
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "D3D12Core.h"
+#include "ResourceStateTracker.h"
+#include <d3d12.h>
+#include <mutex>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Backend D3D12 del ResourceStateTracker: conoce el estado de cada subrecurso registrado
+    // y traduce el lote de transiciones pendientes a una única llamada ResourceBarrier.
+    // Uso por pase: pedir todas las transiciones que necesita y después Flush una vez
+    class D3D12ResourceStateTracker {
+    public:
+        D3D12ResourceStateTracker();
+
+        void Initialize();
+
+        // subresourceCount = 0: se deduce de la descripción (mips x capas). Los buffers y los
+        // recursos de acceso simultáneo usan promoción/decaimiento implícito
+        void Register(ID3D12Resource* resource, D3D12_RESOURCE_STATES state, UINT subresourceCount = 0);
+        void Unregister(ID3D12Resource* resource);
+        bool IsRegistered(ID3D12Resource* resource) const;
+        D3D12_RESOURCE_STATES GetState(ID3D12Resource* resource, UINT subresource = 0) const;
+
+        void Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES state,
+            UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+        // Split barrier: la transición empieza aquí y termina en el próximo Transition al mismo estado
+        void BeginTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES state,
+            UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+        // Barrera de aliasing entre recursos colocados que comparten memoria (before puede ser
+        // nullptr: cualquiera). Va en el mismo lote, por delante de las transiciones
+        void Alias(ID3D12Resource* before, ID3D12Resource* after);
+
+        // Emite todas las barreras pendientes en una sola llamada (nada si no hay)
+        void Flush(ID3D12GraphicsCommandList* commandList);
+
+        // Llamar tras ExecuteCommandLists de la cola en la que se usaron los recursos
+        void OnExecuted();
+
+        ResourceStateTracker::Stats GetStats() const;
+        void ResetStats();
+
+    private:
+        static uint64_t Key(ID3D12Resource* resource) { return reinterpret_cast<uint64_t>(resource); }
+
+        ResourceStateTracker m_tracker;
+        std::vector<ResourceStateTracker::Barrier> m_batch;
+        std::vector<D3D12_RESOURCE_BARRIER> m_barriers;
+        std::vector<D3D12_RESOURCE_BARRIER> m_aliasing;
+        mutable std::mutex m_mutex;
+    };
+
+} // namespace D3D12Core
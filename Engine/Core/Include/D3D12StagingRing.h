@@ -0,0 +1,47 @@
+#pragma once
+
+#include "D3D12Core.h"
+#include "RingAllocator.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+
+namespace D3D12Core {
+
+    // Sub-asignación dentro del anillo de staging
+    struct StagingAllocation {
+        ID3D12Resource* resource = nullptr;
+        UINT64 offset = 0;
+        void* cpuAddress = nullptr;
+        UINT64 size = 0;
+        bool IsValid() const { return resource != nullptr; }
+    };
+
+    // Anillo de staging persistente: un único upload heap mapeado durante toda su vida
+    // del que sub-asignan todas las subidas. La memoria se recupera cuando se completa
+    // el fence del envío que la usó, así que el staging queda acotado a la capacidad
+    class D3D12StagingRing {
+    public:
+        D3D12StagingRing();
+        ~D3D12StagingRing();
+
+        bool Initialize(ID3D12Device* device, UINT64 capacity);
+        void Shutdown();
+
+        // Inválida si no cabe hasta que la GPU libere espacio (ver GetFenceToFit)
+        StagingAllocation Allocate(UINT64 size, UINT64 alignment = 16);
+
+        void FinishSubmission(UINT64 fenceValue) { m_ring.FinishSubmission(fenceValue); }
+        void Retire(UINT64 completedFenceValue) { m_ring.Retire(completedFenceValue); }
+        UINT64 GetFenceToFit(UINT64 size, UINT64 alignment = 16) const { return m_ring.GetFenceToFit(size, alignment); }
+
+        UINT64 GetCapacity() const { return m_ring.GetCapacity(); }
+        UINT64 GetUsedBytes() const { return m_ring.GetUsedBytes(); }
+        const RingAllocator::Stats& GetStats() const { return m_ring.GetStats(); }
+
+    private:
+        ComPtr<ID3D12Resource> m_resource;
+        BYTE* m_mappedData = nullptr;
+        RingAllocator m_ring;
+    };
+
+} // namespace D3D12Core
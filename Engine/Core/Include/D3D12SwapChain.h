@@ -1,6 +1,7 @@
 #pragma once
 
 #include "D3D12Core.h"
+#include "D3D12DescriptorManager.h"
 #include <d3d12.h>
 #include <dxgi1_6.h>
 #include <wrl/client.h>
@@ -16,6 +17,7 @@ namespace D3D12Core {
             HWND hwnd,
             IDXGIFactory4* factory,
             ID3D12CommandQueue* commandQueue,
+            D3D12DescriptorManager* descriptorManager,
             UINT width,
             UINT height,
             UINT bufferCount = BACK_BUFFER_COUNT
@@ -26,6 +28,7 @@ namespace D3D12Core {
         void Present(UINT syncInterval = 1, UINT flags = 0);
 
         ID3D12Resource* GetCurrentBackBuffer() const;
+        ID3D12Resource* GetBackBuffer(UINT index) const { return index < m_bufferCount ? m_backBuffers[index].Get() : nullptr; }
         UINT GetCurrentBackBufferIndex() const { return m_currentBackBufferIndex; }
         UINT GetBufferCount() const { return m_bufferCount; }
         DXGI_FORMAT GetFormat() const { return m_format; }
@@ -36,17 +39,17 @@ namespace D3D12Core {
     private:
         ComPtr<IDXGISwapChain3> m_swapChain;
         ComPtr<ID3D12Resource> m_backBuffers[BACK_BUFFER_COUNT];
-        ComPtr<ID3D12DescriptorHeap> m_rtvHeap;
+        DescriptorHandle m_rtvs; // Un RTV por back buffer, reutilizados al redimensionar
 
         UINT m_bufferCount = 0;
         UINT m_currentBackBufferIndex = 0;
-        UINT m_rtvDescriptorSize = 0;
         DXGI_FORMAT m_format = BACK_BUFFER_FORMAT;
         UINT m_width = 0;
         UINT m_height = 0;
 
         ID3D12CommandQueue* m_commandQueue = nullptr;
         IDXGIFactory4* m_factory = nullptr;
+        D3D12DescriptorManager* m_descriptorManager = nullptr;
 
         bool CreateSwapChain(HWND hwnd, UINT width, UINT height);
         bool CreateRenderTargetViews(ID3D12Device* device);
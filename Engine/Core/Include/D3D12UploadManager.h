@@ -0,0 +1,123 @@
+#pragma once
+
+#include "D3D12Core.h"
+#include "D3D12StagingRing.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <chrono>
+#include <deque>
+#include <vector>
+
+namespace D3D12Core {
+
+    class D3D12Buffer;
+
+    // Token de finalización de una subida: valor del fence de la cola de copia
+    // que indica cuándo los datos están en el recurso de destino
+    struct UploadToken {
+        UINT64 fenceValue = 0; // 0 = no hay nada pendiente
+        bool IsValid() const { return fenceValue != 0; }
+    };
+
+    // Estadísticas agregadas de subida
+    struct UploadStats {
+        UINT64 uploadCount = 0;        // Subidas individuales encoladas
+        UINT64 bytesQueued = 0;
+        UINT64 bytesCompleted = 0;
+        UINT64 submissions = 0;        // ExecuteCommandLists en la cola de copia
+        UINT64 directQueueWaits = 0;   // Esperas GPU->GPU insertadas en la cola directa
+        UINT64 stagingStalls = 0;      // Esperas en CPU porque el anillo de staging estaba lleno
+        double completedSeconds = 0.0; // Tiempo envío -> completado de todos los lotes
+        double GetMegabytesPerSecond() const {
+            return completedSeconds > 0.0 ? (bytesCompleted / (1024.0 * 1024.0)) / completedSeconds : 0.0;
+        }
+    };
+
+    // Gestor de subidas asíncronas sobre una cola de copia dedicada
+    // Agrupa muchas subidas de buffers/texturas en un solo envío y devuelve tokens
+    // basados en fence en lugar de bloquear. La cola directa solo se sincroniza
+    // (ID3D12CommandQueue::Wait, sin bloquear la CPU) la primera vez que usa el recurso
+    class D3D12UploadManager {
+    public:
+        D3D12UploadManager();
+        ~D3D12UploadManager();
+
+        bool Initialize(ID3D12Device* device, UINT64 stagingCapacity = UPLOAD_STAGING_RING_SIZE);
+        void Shutdown();
+
+        // Encolar subidas en el lote abierto (no se envían hasta Submit)
+        UploadToken UploadBuffer(D3D12Buffer* destination, const void* data, UINT64 size, UINT64 destinationOffset = 0);
+        UploadToken UploadTexture2D(ID3D12Resource* destination, const void* data, UINT rowPitch, UINT subresource = 0);
+
+        // Envía el lote abierto a la cola de copia con un único ExecuteCommandLists
+        UploadToken Submit();
+
+        // Libera memoria de staging y allocators de lotes ya completados
+        void RetireCompleted();
+
+        bool IsComplete(const UploadToken& token) const;
+        void WaitForToken(const UploadToken& token); // Espera en CPU (solo para carga síncrona)
+
+        // Garantiza que la cola indicada no use el recurso antes de que termine la copia.
+        // Solo inserta un Wait si el token no se ha completado ni esperado antes en esa cola
+        void RequireOnQueue(const UploadToken& token, ID3D12CommandQueue* queue);
+
+        // Marcan una fase de carga para informar envíos por carga y MB/s
+        void BeginLoad();
+        void EndLoad();
+
+        const UploadStats& GetStats() const { return m_stats; }
+        ID3D12CommandQueue* GetCopyQueue() const { return m_copyQueue.Get(); }
+        const D3D12StagingRing& GetStagingRing() const { return m_stagingRing; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Batch {
+            ComPtr<ID3D12CommandAllocator> allocator;
+            std::vector<ComPtr<ID3D12Resource>> destinations; // Vivos hasta que termine la copia
+            UINT64 fenceValue = 0;
+            UINT64 bytes = 0;
+            Clock::time_point submitTime;
+        };
+
+        struct QueueWait {
+            ID3D12CommandQueue* queue = nullptr;
+            UINT64 waitedValue = 0;
+        };
+
+        struct LoadReport {
+            UINT64 uploads = 0;
+            UINT64 bytes = 0;
+            UINT64 submissions = 0;
+            UINT64 lastFenceValue = 0;
+            Clock::time_point start;
+            bool active = false;
+            bool pending = false;   // Esperando a que termine el último lote para informar
+        };
+
+        bool OpenBatch();
+        StagingAllocation AllocateStaging(UINT64 size, UINT64 alignment);
+        void ReportLoadIfComplete();
+
+        ID3D12Device* m_device = nullptr;
+        ComPtr<ID3D12CommandQueue> m_copyQueue;
+        ComPtr<ID3D12GraphicsCommandList> m_commandList;
+        ComPtr<ID3D12Fence> m_fence;
+        HANDLE m_fenceEvent = nullptr;
+        D3D12StagingRing m_stagingRing;
+
+        Batch m_openBatch;
+        bool m_batchOpen = false;
+        std::deque<Batch> m_inFlightBatches;
+        std::vector<ComPtr<ID3D12CommandAllocator>> m_freeAllocators;
+
+        UINT64 m_nextFenceValue = 1;      // Valor que señalará el lote abierto
+        UINT64 m_lastSubmittedValue = 0;
+        std::vector<QueueWait> m_queueWaits;
+
+        UploadStats m_stats;
+        LoadReport m_load;
+    };
+
+} // namespace D3D12Core
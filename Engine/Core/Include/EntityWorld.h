@@ -0,0 +1,315 @@
+#pragma once
+
+#include "JobSystem.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Identificador de entidad: posición en la tabla de entidades más una generación que
+    // invalida los handles de entidades ya destruidas
+    struct Entity {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+
+        bool operator==(const Entity& other) const = default;
+    };
+    constexpr Entity INVALID_ENTITY = {};
+
+    using ComponentTypeId = uint32_t;
+    using ComponentMask = uint64_t;
+    constexpr uint32_t MAX_COMPONENT_TYPES = 64;
+    constexpr ComponentTypeId INVALID_COMPONENT_TYPE = UINT32_MAX;
+    constexpr uint32_t ENTITY_CHUNK_SIZE = 16 * 1024;
+
+    // Registro global de tipos de componente (id denso, uno por tipo C++). Los componentes son
+    // datos planos: se copian y mueven entre chunks con memcpy
+    ComponentTypeId RegisterComponentType(uint32_t size, uint32_t alignment);
+    uint32_t GetComponentSize(ComponentTypeId type);
+
+    // const T es el mismo componente que T (consultas de solo lectura)
+    template <typename T>
+    ComponentTypeId GetComponentTypeId() {
+        if constexpr (!std::is_same_v<T, std::remove_cv_t<T>>) {
+            return GetComponentTypeId<std::remove_cv_t<T>>();
+        }
+        else {
+            static_assert(std::is_trivially_copyable_v<T>, "Los componentes deben ser trivialmente copiables");
+            static const ComponentTypeId id = RegisterComponentType(sizeof(T), alignof(T));
+            return id;
+        }
+    }
+
+    // Conjunto de entidades con los mismos componentes. Cada chunk de 16 KB guarda las
+    // entidades y cada componente en su propio array contiguo (SoA, cada uno alineado a línea
+    // de caché). Las filas están compactadas: solo el último chunk puede estar a medias
+    struct EntityArchetype {
+        ComponentMask mask = 0;
+        std::vector<ComponentTypeId> types;
+        uint32_t columnOffsets[MAX_COMPONENT_TYPES] = {}; // Bytes desde el inicio del chunk (entidades en 0)
+        uint32_t chunkCapacity = 0;
+        std::vector<uint8_t*> chunks;
+        std::vector<uint32_t> chunkCounts;
+        uint32_t entityCount = 0;
+        // Arquetipo destino al añadir o quitar cada componente (índice + 1; 0 = sin calcular)
+        uint32_t addEdges[MAX_COMPONENT_TYPES] = {};
+        uint32_t removeEdges[MAX_COMPONENT_TYPES] = {};
+    };
+
+    struct EntityWorldStats {
+        uint64_t created = 0;
+        uint64_t destroyed = 0;
+        uint64_t archetypeMoves = 0;   // Entidades copiadas de un arquetipo a otro (add/remove)
+        uint64_t queries = 0;
+        uint64_t archetypesMatched = 0; // Arquetipos comprobados contra una consulta (solo los nuevos)
+    };
+
+    // Mundo de entidades con almacenamiento por arquetipos. Los cambios estructurales (crear,
+    // destruir, añadir o quitar componentes) mueven filas entre chunks, así que no se permiten
+    // dentro de ForEach: ahí se graban en un EntityCommandBuffer y se aplican después
+    //
+    // ForEach<A, B>(fn) recorre chunk a chunk todas las entidades que tienen al menos A y B:
+    // fn(Entity, A&, B&). ParallelForEach reparte los chunks entre los hilos y añade a fn el
+    // índice de la entidad en el orden de la consulta (denso, de 0 a Count<A, B>() - 1) y el
+    // hilo: fn(index, workerIndex, Entity, A&, B&). El orden es estable mientras no haya
+    // cambios estructurales. Los arquetipos que casan con cada consulta se guardan en caché
+    class EntityWorld {
+    public:
+        EntityWorld();
+        ~EntityWorld();
+
+        EntityWorld(const EntityWorld&) = delete;
+        EntityWorld& operator=(const EntityWorld&) = delete;
+
+        Entity CreateEntity();
+        bool DestroyEntity(Entity entity);
+        bool IsAlive(Entity entity) const;
+        uint32_t GetEntityCount() const { return m_entityCount; }
+        // Destruye todas las entidades; los chunks quedan en la reserva para reutilizarlos
+        void Clear();
+
+        // Añadir un componente que ya existe solo sobrescribe su valor
+        template <typename T>
+        bool AddComponent(Entity entity, const T& value = T()) {
+            return AddComponentData(entity, GetComponentTypeId<T>(), &value);
+        }
+        template <typename T>
+        bool RemoveComponent(Entity entity) {
+            return RemoveComponentData(entity, GetComponentTypeId<T>());
+        }
+        // nullptr si la entidad no vive o no tiene el componente. Válido hasta el siguiente cambio estructural
+        template <typename T>
+        T* GetComponent(Entity entity) {
+            return static_cast<T*>(GetComponentData(entity, GetComponentTypeId<T>()));
+        }
+        template <typename T>
+        bool HasComponent(Entity entity) const {
+            return HasComponentData(entity, GetComponentTypeId<T>());
+        }
+
+        // Acceso sin tipos (command buffers, editor)
+        bool AddComponentData(Entity entity, ComponentTypeId type, const void* data);
+        bool RemoveComponentData(Entity entity, ComponentTypeId type);
+        void* GetComponentData(Entity entity, ComponentTypeId type);
+        bool HasComponentData(Entity entity, ComponentTypeId type) const;
+
+        template <typename... Ts>
+        uint32_t Count() {
+            ComponentMask mask = 0;
+            if (!MakeQueryMask<Ts...>(mask)) {
+                return 0;
+            }
+            uint32_t count = 0;
+            for (uint32_t archetypeIndex : MatchArchetypes(mask)) {
+                count += m_archetypes[archetypeIndex]->entityCount;
+            }
+            return count;
+        }
+
+        template <typename... Ts, typename Function>
+        void ForEach(Function&& function) {
+            ComponentMask mask = 0;
+            if (!MakeQueryMask<Ts...>(mask)) {
+                return;
+            }
+            auto rowFunction = [&](uint32_t, Entity entity, Ts&... components) { function(entity, components...); };
+            m_iterationDepth++;
+            for (uint32_t archetypeIndex : MatchArchetypes(mask)) {
+                const EntityArchetype& archetype = *m_archetypes[archetypeIndex];
+                for (uint32_t chunk = 0; chunk < archetype.chunks.size(); chunk++) {
+                    ForEachRow(archetype.chunkCounts[chunk], reinterpret_cast<const Entity*>(archetype.chunks[chunk]),
+                        rowFunction, GetColumn<Ts>(archetype, chunk)...);
+                }
+            }
+            m_iterationDepth--;
+        }
+
+        // jobs = nullptr: en el hilo que llama, con workerIndex = 0
+        template <typename... Ts, typename Function>
+        void ParallelForEach(JobSystem* jobs, Function&& function) {
+            ComponentMask mask = 0;
+            if (!MakeQueryMask<Ts...>(mask)) {
+                return;
+            }
+            const std::vector<QueryChunk>& queryChunks = GatherChunks(mask);
+            m_iterationDepth++;
+            auto runChunks = [&](uint32_t begin, uint32_t end, uint32_t workerIndex) {
+                for (uint32_t i = begin; i < end; i++) {
+                    const QueryChunk& queryChunk = queryChunks[i];
+                    const EntityArchetype& archetype = *m_archetypes[queryChunk.archetype];
+                    auto rowFunction = [&](uint32_t row, Entity entity, Ts&... components) {
+                        function(queryChunk.firstIndex + row, workerIndex, entity, components...);
+                    };
+                    ForEachRow(archetype.chunkCounts[queryChunk.chunk],
+                        reinterpret_cast<const Entity*>(archetype.chunks[queryChunk.chunk]), rowFunction,
+                        GetColumn<Ts>(archetype, queryChunk.chunk)...);
+                }
+            };
+            const uint32_t chunkCount = static_cast<uint32_t>(queryChunks.size());
+            JobSystem::ParallelFor(jobs, chunkCount, QUERY_CHUNK_BATCH, runChunks);
+            m_iterationDepth--;
+        }
+
+        uint32_t GetArchetypeCount() const { return static_cast<uint32_t>(m_archetypes.size()); }
+        uint32_t GetChunkCount() const { return static_cast<uint32_t>(m_chunkStorage.size() - m_freeChunks.size()); }
+
+        const EntityWorldStats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = EntityWorldStats(); }
+        std::string BuildReport() const;
+
+    private:
+        static constexpr uint32_t NO_ARCHETYPE = UINT32_MAX;
+        static constexpr uint32_t QUERY_CHUNK_BATCH = 4;
+        static constexpr uint32_t COLUMN_ALIGNMENT = 64;
+
+        struct EntityRecord {
+            uint32_t archetype = NO_ARCHETYPE;
+            uint32_t chunk = 0;
+            uint32_t row = 0;
+            uint32_t generation = 0;
+        };
+
+        // Bloque de ENTITY_CHUNK_SIZE bytes alineado a línea de caché
+        struct alignas(COLUMN_ALIGNMENT) ChunkMemory {
+            uint8_t bytes[ENTITY_CHUNK_SIZE];
+        };
+
+        struct QueryCache {
+            ComponentMask mask = 0;
+            uint32_t checkedArchetypes = 0; // Los arquetipos se añaden al final: solo se comprueban los nuevos
+            std::vector<uint32_t> archetypes;
+        };
+
+        struct QueryChunk {
+            uint32_t archetype;
+            uint32_t chunk;
+            uint32_t firstIndex;
+        };
+
+        template <typename... Ts>
+        bool MakeQueryMask(ComponentMask& mask) const {
+            ComponentMask queryMask = 0;
+            bool valid = true;
+            ((valid = AddToMask(queryMask, GetComponentTypeId<Ts>()) && valid), ...);
+            if (!valid) {
+                return false;
+            }
+            mask = queryMask;
+            return true;
+        }
+        bool AddToMask(ComponentMask& mask, ComponentTypeId type) const;
+
+        template <typename T>
+        static T* GetColumn(const EntityArchetype& archetype, uint32_t chunk) {
+            return reinterpret_cast<T*>(archetype.chunks[chunk] + archetype.columnOffsets[GetComponentTypeId<T>()]);
+        }
+
+        template <typename Function, typename... Ts>
+        static void ForEachRow(uint32_t count, const Entity* entities, Function& function, Ts*... columns) {
+            for (uint32_t row = 0; row < count; row++) {
+                function(row, entities[row], columns[row]...);
+            }
+        }
+
+        const std::vector<uint32_t>& MatchArchetypes(ComponentMask mask);
+        const std::vector<QueryChunk>& GatherChunks(ComponentMask mask);
+        uint32_t FindOrCreateArchetype(ComponentMask mask);
+        bool CheckStructuralChange(const char* operation) const;
+        const EntityRecord* FindRecord(Entity entity) const;
+
+        uint8_t* AcquireChunk();
+        // Reserva la última fila del arquetipo (abre un chunk si hace falta)
+        void AllocateRow(EntityArchetype& archetype, uint32_t& chunk, uint32_t& row);
+        // Rellena el hueco con la última fila del arquetipo y actualiza la entidad movida
+        void RemoveRow(EntityArchetype& archetype, uint32_t chunk, uint32_t row);
+        void MoveEntity(EntityRecord& record, uint32_t targetArchetype);
+
+        std::vector<std::unique_ptr<EntityArchetype>> m_archetypes;
+        std::unordered_map<ComponentMask, uint32_t> m_archetypeByMask;
+        std::vector<EntityRecord> m_records;
+        std::vector<uint32_t> m_freeRecords;
+        uint32_t m_entityCount = 0;
+
+        std::vector<std::unique_ptr<ChunkMemory>> m_chunkStorage;
+        std::vector<uint8_t*> m_freeChunks;
+
+        std::vector<QueryCache> m_queryCaches;
+        std::vector<QueryChunk> m_queryChunks;
+        uint32_t m_iterationDepth = 0;
+        EntityWorldStats m_stats;
+    };
+
+    // Cambios estructurales grabados (por ejemplo desde un ForEach) para aplicarlos después en
+    // orden. Las entidades creadas aquí devuelven un handle provisional que solo vale dentro de
+    // este buffer hasta Playback. Con ParallelForEach, un buffer por hilo (workerIndex) evita
+    // sincronizar; se reproducen uno tras otro
+    class EntityCommandBuffer {
+    public:
+        Entity CreateEntity();
+        void DestroyEntity(Entity entity);
+
+        template <typename T>
+        void AddComponent(Entity entity, const T& value = T()) {
+            Record(CommandType::Add, entity, GetComponentTypeId<T>(), &value, sizeof(T));
+        }
+        template <typename T>
+        void RemoveComponent(Entity entity) {
+            Record(CommandType::Remove, entity, GetComponentTypeId<T>(), nullptr, 0);
+        }
+
+        // Aplica los comandos en el orden en que se grabaron y vacía el buffer.
+        // Devuelve cuántos fallaron (entidad muerta, cambio dentro de un ForEach...)
+        uint32_t Playback(EntityWorld& world);
+        void Clear();
+        uint32_t GetCommandCount() const { return static_cast<uint32_t>(m_commands.size()); }
+
+    private:
+        static constexpr uint32_t PENDING_ENTITY = 0x80000000u;
+
+        enum class CommandType : uint8_t {
+            Create,
+            Destroy,
+            Add,
+            Remove
+        };
+
+        struct Command {
+            CommandType type;
+            ComponentTypeId component;
+            Entity entity;
+            uint32_t dataOffset;
+        };
+
+        void Record(CommandType type, Entity entity, ComponentTypeId component, const void* data, uint32_t size);
+
+        std::vector<Command> m_commands;
+        std::vector<uint8_t> m_data;         // Valores de los componentes añadidos
+        std::vector<Entity> m_createdEntities; // Provisional -> real durante Playback
+        uint32_t m_pendingCount = 0;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "GpuTimeline.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace D3D12Core {
+
+    // Cola de comandos + fence simulados en CPU
+    // Un hilo "GPU" consume el trabajo en orden FIFO: cada command list tarda el tiempo
+    // indicado y cada Signal actualiza el valor completado al llegar a la cabeza de la cola.
+    // Permite ejecutar y medir la lógica de frames en vuelo en máquinas sin GPU (Linux/CI)
+    class FakeGpuQueue : public IGpuTimeline {
+    public:
+        FakeGpuQueue();
+        ~FakeGpuQueue() override;
+
+        bool Initialize();
+        void Shutdown();
+
+        // Simula ExecuteCommandLists con un coste de GPU en milisegundos
+        void ExecuteCommandList(double gpuMilliseconds);
+
+        // IGpuTimeline
+        uint64_t Signal() override;
+        uint64_t GetCompletedValue() const override;
+        void WaitForFenceValue(uint64_t fenceValue) override;
+
+        // Pausar la GPU simulada permite probar estados deterministas (slots ocupados)
+        void SetPaused(bool paused);
+
+        // Contadores
+        uint64_t GetExecutedCommandLists() const { return m_executedCommandLists.load(); }
+        uint64_t GetSignalCount() const { return m_signalCount.load(); }
+        uint64_t GetCpuWaitCount() const { return m_cpuWaitCount.load(); }
+        double GetGpuBusyMs() const;
+
+    private:
+        struct QueueItem {
+            double gpuMilliseconds = 0.0;   // Trabajo simulado
+            uint64_t signalValue = 0;       // != 0 si el elemento es una señal
+        };
+
+        void GpuThreadMain();
+
+        std::thread m_gpuThread;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_workAvailable;
+        std::condition_variable m_fenceAdvanced;
+        std::deque<QueueItem> m_pending;
+
+        std::atomic<uint64_t> m_completedValue{ 0 };
+        uint64_t m_nextSignalValue = 0;
+        bool m_running = false;
+        bool m_paused = false;
+
+        std::atomic<uint64_t> m_executedCommandLists{ 0 };
+        std::atomic<uint64_t> m_signalCount{ 0 };
+        std::atomic<uint64_t> m_cpuWaitCount{ 0 };
+        double m_gpuBusyMs = 0.0;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace D3D12Core {
+
+    class IniFile;
+
+    constexpr uint32_t FRAME_PACER_HISTOGRAM_BUCKETS = 42; // [<-5ms] 40 x 250us [>=+5ms]
+
+    struct FramePacerSettings {
+        double targetFps = 60.0;      // 0: sin límite
+        bool latencyAware = true;
+        double safetyMarginMs = 1.0;  // Holgura sobre el coste previsto del frame
+        double spinThresholdMs = 1.5; // Margen inicial de espera activa (luego adaptativo)
+    };
+
+    struct FramePacerStats {
+        uint64_t frames = 0;            // Intervalos medidos
+        uint64_t missedDeadlines = 0;   // Intervalos de más de 1.5 periodos
+        double meanAbsErrorMs = 0.0;
+        double maxAbsErrorMs = 0.0;
+        double meanWaitMs = 0.0;        // Espera media por frame
+        double predictedFrameCostMs = 0.0;
+        double sleepOvershootMs = 0.0;  // Retraso medio de los sleeps del SO
+        uint64_t histogram[FRAME_PACER_HISTOGRAM_BUCKETS] = {};
+    };
+
+    // Ritmo de frames preciso e independiente de la plataforma
+    //  - Espera híbrida: duerme hasta poco antes del instante objetivo y completa con espera
+    //    activa. El margen de espera activa se adapta al retraso medido de los sleeps del SO
+    //    (clock_nanosleep absoluto en POSIX, temporizador de alta resolución en Windows)
+    //  - Cadencia fija: los plazos avanzan un periodo exacto por frame (sin acumular deriva);
+    //    si un frame llega más de medio periodo tarde la cadencia se reancla
+    //  - Latency-aware: la espera se hace al principio del frame y se alarga todo lo que
+    //    permite el coste previsto del frame, de modo que la entrada y la simulación se leen
+    //    lo más tarde posible y el Present cae justo antes de su plazo
+    //  - Histograma del error de ritmo (intervalo real entre Present - periodo objetivo)
+    // Uso por frame: WaitForNextFrame() -> entrada, simulación, render -> [WaitForPresent] -> Present -> MarkPresent()
+    class FramePacer {
+    public:
+        static constexpr uint32_t HISTOGRAM_BUCKETS = FRAME_PACER_HISTOGRAM_BUCKETS;
+        static constexpr int64_t HISTOGRAM_BUCKET_NS = 250000;
+        static constexpr int64_t HISTOGRAM_RANGE_NS = 5000000;
+
+        FramePacer();
+        ~FramePacer();
+
+        void Initialize(const FramePacerSettings& settings);
+        void Shutdown();
+
+        // [Performance] TargetFPS limitado por [Rendering] MaxFPS (0 o ausente: sin límite);
+        // [Rendering] LatencyAwarePacing y PacingMarginMs opcionales
+        static FramePacerSettings LoadSettings(const IniFile& ini, const FramePacerSettings& defaults = FramePacerSettings());
+
+        void SetTargetFps(double fps);
+        double GetTargetFps() const { return m_settings.targetFps; }
+        int64_t GetFramePeriodNs() const { return m_periodNs; }
+
+        // Espera hasta el inicio del frame; devuelve los ms esperados
+        double WaitForNextFrame();
+        // Sin VSync: espera al plazo del Present para que el intervalo entre imágenes sea exacto
+        // aunque el coste del frame varíe (con VSync lo fija el propio Present)
+        void WaitForPresent();
+        // Llamar justo después de Present
+        void MarkPresent();
+
+        // Espera precisa hasta un instante de Now()
+        void WaitUntil(int64_t deadlineNs);
+        // Reloj monotónico en nanosegundos
+        static int64_t Now();
+
+        const FramePacerStats& GetStats() const { return m_stats; }
+        void ResetStats();
+        // Error de ritmo (ms, con signo) por debajo del cual queda el percentil dado [0, 1]
+        double GetErrorPercentileMs(double percentile) const;
+        // Bucket del histograma para un error de ritmo y borde que informan los percentiles:
+        // el superior, salvo en el de desbordamiento (+5 ms, su borde inferior)
+        static uint32_t GetHistogramBucket(int64_t errorNs);
+        static int64_t GetHistogramBucketEdgeNs(uint32_t bucket);
+        std::string BuildReport() const;
+
+    private:
+        void SleepFor(int64_t durationNs);
+        void RecordOvershoot(int64_t overshootNs);
+        int64_t GetSpinThresholdNs() const;
+
+        FramePacerSettings m_settings;
+        int64_t m_periodNs = 0;
+        int64_t m_nextPresent = 0; // Plazo del próximo Present (0: aún sin cadencia)
+        int64_t m_lastPresent = 0;
+        int64_t m_frameStart = 0;
+        int64_t m_workEnd = 0;     // Fin del trabajo del frame (WaitForPresent)
+
+        double m_costPeakNs = 0.0;      // Coste reciente del frame (máximo con decaimiento)
+        double m_overshootMeanNs = 0.0; // Media y varianza móviles del retraso de los sleeps
+        double m_overshootVarNs = 0.0;
+        bool m_hasOvershootSamples = false;
+
+        double m_totalAbsErrorMs = 0.0;
+        double m_totalWaitMs = 0.0;
+        uint64_t m_waits = 0;
+        FramePacerStats m_stats;
+
+        void* m_timer = nullptr; // HANDLE del temporizador de alta resolución (Windows)
+    };
+
+} // namespace D3D12Core
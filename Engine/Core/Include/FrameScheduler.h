@@ -0,0 +1,74 @@
+#pragma once
+
+#include "GpuTimeline.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Contadores de latencia y throughput del pipeline de frames
+    struct FrameSchedulerStats {
+        uint64_t framesSubmitted = 0;
+        uint64_t framesCompleted = 0;
+        uint64_t slotStalls = 0;          // Veces que la CPU esperó a que un slot quedara libre
+        double totalStallMs = 0.0;
+        double maxStallMs = 0.0;
+        double avgGpuLatencyMs = 0.0;     // Envío -> completado (observado en CPU)
+        double maxGpuLatencyMs = 0.0;
+        double framesPerSecond = 0.0;     // Frames completados desde el último ResetStats
+        uint32_t maxFramesInFlight = 0;   // Máximo de frames en vuelo observado
+    };
+
+    // Planificador de frames en vuelo con un fence por slot de allocator
+    // EndFrame registra el valor de fence del slot; BeginFrame solo espera cuando
+    // ese mismo slot se reutiliza, de modo que la CPU puede grabar el frame N+2
+    // mientras la GPU ejecuta el frame N
+    class FrameScheduler {
+    public:
+        FrameScheduler();
+        ~FrameScheduler();
+
+        bool Initialize(IGpuTimeline* timeline, uint32_t frameCount);
+        void Shutdown();
+
+        // Espera (si hace falta) a que el slot actual quede libre y devuelve su índice
+        uint32_t BeginFrame();
+
+        // Señala el fin del frame actual, registra su fence y avanza al siguiente slot
+        uint64_t EndFrame();
+
+        // Espera a que termine todo el trabajo ya enviado (sin emitir una señal nueva)
+        void WaitForIdle();
+
+        uint32_t GetCurrentSlot() const { return m_currentSlot; }
+        uint32_t GetFrameCount() const { return static_cast<uint32_t>(m_slots.size()); }
+        uint64_t GetSlotFenceValue(uint32_t slot) const;
+        uint64_t GetLastSubmittedFenceValue() const { return m_lastSubmittedValue; }
+        uint32_t GetFramesInFlight() const;
+
+        const FrameSchedulerStats& GetStats() const { return m_stats; }
+        void ResetStats();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct FrameSlot {
+            uint64_t fenceValue = 0;      // 0 = slot nunca usado
+            Clock::time_point submitTime;
+            bool retired = true;          // Latencia ya contabilizada
+        };
+
+        void RetireCompleted(uint64_t completedValue);
+
+        IGpuTimeline* m_timeline = nullptr;
+        std::vector<FrameSlot> m_slots;
+        uint32_t m_currentSlot = 0;
+        uint64_t m_lastSubmittedValue = 0;
+
+        FrameSchedulerStats m_stats;
+        double m_totalLatencyMs = 0.0;
+        Clock::time_point m_statsStart;
+    };
+
+} // namespace D3D12Core
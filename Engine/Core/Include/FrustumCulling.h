@@ -0,0 +1,137 @@
+#pragma once
+
+#include "JobSystem.h"
+#include "RenderSnapshot.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Seis planos (izquierda, derecha, abajo, arriba, cerca, lejos) con la normal hacia dentro:
+    // un punto p está dentro si n·p + d >= 0 en todos
+    struct CullingFrustum {
+        float planes[6][4] = {};
+
+        // viewProjection con las convenciones de DirectXMath (vector fila, z de clip en [0, w]),
+        // es decir, view * XMMatrixPerspectiveFovLH
+        static CullingFrustum FromViewProjection(const Float4x4& viewProjection);
+        static CullingFrustum FromCamera(const CameraProxy& camera);
+    };
+
+    // AABB de mundo en SoA (centro y semiextensión por eje en arrays separados) para probar
+    // varias cajas por instrucción. El almacenamiento se rellena hasta un múltiplo del ancho SIMD
+    // para que los kernels puedan leer el último grupo entero
+    class CullingBounds {
+    public:
+        void Resize(uint32_t count);
+        uint32_t GetCount() const { return m_count; }
+
+        void Set(uint32_t index, const float center[3], const float extent[3]);
+        // AABB local (centro y semiextensión) transformada por world: la AABB de mundo que la contiene
+        void SetTransformed(uint32_t index, const float center[3], const float extent[3], const Float4x4& world);
+
+        const float* GetCenters(uint32_t axis) const { return m_centers[axis].data(); }
+        const float* GetExtents(uint32_t axis) const { return m_extents[axis].data(); }
+        // Escritura directa por eje, para quien rellena muchas cajas en un bucle propio
+        float* GetCenters(uint32_t axis) { return m_centers[axis].data(); }
+        float* GetExtents(uint32_t axis) { return m_extents[axis].data(); }
+
+    private:
+        uint32_t m_count = 0;
+        std::vector<float> m_centers[3];
+        std::vector<float> m_extents[3];
+    };
+
+    struct CullingStats {
+        uint64_t frames = 0;
+        uint64_t objects = 0;      // Cajas enviadas al culling
+        uint64_t visible = 0;
+        uint64_t tested = 0;       // Cajas probadas una a una (el BVH acepta o descarta nodos enteros)
+        uint64_t nodes = 0;        // Nodos del BVH visitados
+        uint64_t lastObjects = 0;
+        uint64_t lastVisible = 0;
+    };
+
+    // Culling de un conjunto plano (dinámico: se reescribe cada frame): prueba todas las cajas,
+    // varias por iteración (SSE4.2/AVX2/AVX-512 según la CPU, ver BatchMath.h), y compacta los índices
+    // visibles en orden creciente. Con jobs el array se reparte por bloques entre los hilos
+    class FrustumCuller {
+    public:
+        // Devuelve el número de cajas visibles; sus índices quedan en GetVisibleIndices()
+        uint32_t Cull(const CullingFrustum& frustum, const CullingBounds& bounds, JobSystem* jobs = nullptr);
+        const uint32_t* GetVisibleIndices() const { return m_visible.data(); }
+
+        const CullingStats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = CullingStats(); }
+        std::string BuildReport() const;
+
+        // Cajas por iteración del kernel activo (1 sin SIMD)
+        static uint32_t GetSimdWidth();
+        static const char* GetSimdName();
+
+    private:
+        static constexpr uint32_t BLOCK_SIZE = 16384;
+
+        std::vector<uint32_t> m_visible;
+        std::vector<uint32_t> m_blockVisible; // Visibles de cada bloque antes de compactar
+        CullingStats m_stats;
+    };
+
+    // BVH para conjuntos grandes y estáticos: se construye una vez y cada frame descarta o acepta
+    // subárboles enteros. Los nodos que el frustum contiene por completo aportan todos sus
+    // objetos sin pruebas; solo las hojas que cruzan algún plano se prueban caja a caja, y solo
+    // contra los planos que cruzan. Los índices visibles salen en el orden del BVH
+    class CullingBVH {
+    public:
+        void Build(const CullingBounds& bounds);
+        uint32_t GetNodeCount() const { return static_cast<uint32_t>(m_nodes.size()); }
+
+        uint32_t Cull(const CullingFrustum& frustum, JobSystem* jobs = nullptr);
+        const uint32_t* GetVisibleIndices() const { return m_visible.data(); }
+
+        const CullingStats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = CullingStats(); }
+        std::string BuildReport() const;
+
+    private:
+        static constexpr uint32_t LEAF_SIZE = 64;
+        static constexpr uint32_t TASKS_PER_THREAD = 8;
+
+        // Los objetos de un nodo ocupan [first, first + count) en m_items (orden del BVH)
+        struct Node {
+            float center[3];
+            float extent[3];
+            uint32_t first = 0;
+            uint32_t count = 0;
+            uint32_t rightChild = 0; // 0 = hoja; el hijo izquierdo es siempre el nodo siguiente
+        };
+
+        // Subárbol que recorre un hilo, con los planos que aún cruza
+        struct Task {
+            uint32_t node;
+            uint32_t planeMask;
+        };
+
+        struct BuildItem {
+            float center[3];
+            float extent[3];
+            uint32_t index;
+        };
+
+        uint32_t BuildNode(uint32_t first, uint32_t count, std::vector<BuildItem>& items);
+        uint32_t CullTask(const CullingFrustum& frustum, const Task& task, uint32_t* output, uint64_t& tested, uint64_t& nodes) const;
+
+        std::vector<Node> m_nodes;
+        std::vector<uint32_t> m_itemIndices; // Índice original de cada objeto en orden del BVH
+        CullingBounds m_items;               // Cajas en orden del BVH
+        std::vector<Task> m_tasks;
+        std::vector<uint32_t> m_taskStarts;  // Primer objeto de cada tarea: ahí escribe sus visibles
+        std::vector<uint32_t> m_taskVisible;
+        std::vector<uint64_t> m_taskTested;
+        std::vector<uint64_t> m_taskNodes;
+        std::vector<uint32_t> m_visible;
+        CullingStats m_stats;
+    };
+
+} // namespace D3D12Core
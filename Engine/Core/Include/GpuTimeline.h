@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace D3D12Core {
+
+    // Interfaz mínima de una línea de tiempo de GPU (cola + fence)
+    // Independiente de DirectX 12 para que la planificación de frames en vuelo
+    // funcione igual sobre D3D12CommandQueue o sobre una cola simulada en CPU
+    class IGpuTimeline {
+    public:
+        virtual ~IGpuTimeline() = default;
+
+        // Encola una señal al final del trabajo enviado y devuelve su valor
+        virtual uint64_t Signal() = 0;
+
+        // Último valor de fence completado por la GPU
+        virtual uint64_t GetCompletedValue() const = 0;
+
+        // Bloquea la CPU hasta que la GPU alcance el valor indicado
+        virtual void WaitForFenceValue(uint64_t fenceValue) = 0;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "JobSystem.h"
+#include "MeshLod.h"
+#include "RHI.h"
+#include "RenderSnapshot.h"
+#include "VertexFormat.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Un elemento del buffer de objetos de IndirectVS.hlsl (structured buffer t0 indexado por el
+    // drawIndex de cada comando): model traspuesto y decuantización de su malla. View y projection
+    // van una sola vez en las constantes compartidas (b0)
+    struct IndirectObjectData {
+        Float4x4 model;
+        float positionScale[4];
+        float positionBias[4];
+    };
+    static_assert(sizeof(IndirectObjectData) == 96, "IndirectObjectData debe coincidir con IndirectObject de IndirectVS.hlsl");
+
+    // Rango de índices de una malla dentro de los vertex/index buffers enlazados
+    struct IndirectMeshRange {
+        uint32_t indexCount = 0;
+        uint32_t startIndex = 0;
+        int32_t baseVertex = 0;
+    };
+
+    // Una malla de la tabla (meshId = posición): el rango de cada LOD en los mismos buffers
+    // (MeshLodChain) y la decuantización de sus posiciones. Un proxy con un LOD mayor que los
+    // que tiene usa el último
+    struct IndirectMesh {
+        IndirectMeshRange lods[MAX_MESH_LODS];
+        uint32_t lodCount = 1;
+        VertexQuantization quantization;
+    };
+
+    // Comandos consecutivos de un material: un ExecuteIndirect
+    struct IndirectDrawBucket {
+        uint32_t materialId = 0;
+        uint32_t firstCommand = 0;
+        uint32_t commandCount = 0;
+    };
+
+    struct IndirectDrawBuilderStats {
+        uint64_t frames = 0;
+        uint64_t objects = 0;        // Proxies enviados
+        uint64_t commands = 0;       // Comandos generados
+        uint64_t buckets = 0;        // ExecuteIndirect (uno por material y frame)
+        uint64_t skipped = 0;        // Proxies con una malla que no está en la tabla
+        uint64_t lastCommands = 0;
+        uint64_t lastBuckets = 0;
+    };
+
+    // Genera en CPU los argumentos de ExecuteIndirect de un snapshot: RHIIndirectDrawCommand y
+    // los datos de cada objeto, agrupados por material para enviar un ExecuteIndirect por grupo
+    // en lugar de un SetConstantBuffer + DrawIndexed por objeto. Cada comando solo lleva el
+    // índice de su objeto (4 bytes de root constant en lugar de una CBV de 256 bytes por draw).
+    // No depende de ninguna API gráfica: escribe en la memoria que le pasen (upload heap
+    // mapeado o vectores propios)
+    //
+    // Uso por frame: Prepare agrupa y devuelve el número de comandos; el llamador reserva esa
+    // cantidad de IndirectObjectData y RHIIndirectDrawCommand y WriteObjects y WriteCommands los
+    // rellenan (en cualquier orden). Las dos escrituras se reparten en los hilos de jobs
+    // (nullptr = hilo que llama)
+    class IndirectDrawBuilder {
+    public:
+        // Materiales en orden de primera aparición y objetos en orden de envío dentro de cada uno
+        uint32_t Prepare(const std::vector<RenderProxy>& proxies, const std::vector<IndirectMesh>& meshes);
+        // proxies debe ser el mismo vector que recibió Prepare
+        void WriteObjects(const std::vector<RenderProxy>& proxies, IndirectObjectData* objects, JobSystem* jobs = nullptr) const;
+        // El comando i lee el objeto i (drawIndex = i)
+        void WriteCommands(RHIIndirectDrawCommand* commands, JobSystem* jobs = nullptr) const;
+
+        uint32_t GetCommandCount() const { return static_cast<uint32_t>(m_commandProxies.size()); }
+        const std::vector<IndirectDrawBucket>& GetBuckets() const { return m_buckets; }
+
+        const IndirectDrawBuilderStats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = IndirectDrawBuilderStats(); }
+        std::string BuildReport() const;
+
+    private:
+        static constexpr uint32_t WRITE_BATCH = 1024;
+
+        std::unordered_map<uint32_t, uint32_t> m_bucketIndices; // Material -> bucket
+        std::vector<uint32_t> m_proxyBuckets;                   // Bucket de cada proxy (UINT32_MAX = omitido)
+        std::vector<uint32_t> m_bucketCursors;
+        std::vector<IndirectDrawBucket> m_buckets;
+        std::vector<uint32_t> m_commandProxies;                 // Proxy de cada comando
+        std::vector<IndirectMeshRange> m_commandRanges;         // Malla de cada comando
+        std::vector<VertexQuantization> m_meshQuantizations;    // Copia de la tabla de Prepare
+        IndirectDrawBuilderStats m_stats;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <map>
+#include <string>
+
+namespace D3D12Core {
+
+    // Lector mínimo de archivos .ini (Engine.ini)
+    //  - [Seccion] y clave=valor, sin distinguir mayúsculas en secciones ni claves
+    //  - Líneas que empiezan por # o ; son comentarios
+    //  - Una sección repetida se fusiona con la anterior; la última clave gana
+    class IniFile {
+    public:
+        IniFile();
+
+        bool Load(const std::string& path);
+        bool Parse(const std::string& text);
+        void Clear() { m_sections.clear(); }
+
+        bool HasKey(const std::string& section, const std::string& key) const;
+        std::string GetString(const std::string& section, const std::string& key, const std::string& defaultValue = "") const;
+        int GetInt(const std::string& section, const std::string& key, int defaultValue = 0) const;
+        double GetDouble(const std::string& section, const std::string& key, double defaultValue = 0.0) const;
+        bool GetBool(const std::string& section, const std::string& key, bool defaultValue = false) const;
+
+    private:
+        static std::string ToLower(const std::string& text);
+        const std::string* Find(const std::string& section, const std::string& key) const;
+
+        std::map<std::string, std::map<std::string, std::string>> m_sections;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "MeshLod.h"
+#include "RenderSnapshot.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Datos por instancia del stream de InstancedVS.hlsl (slot 1, un elemento por instancia):
+    // world sin trasponer (el shader reconstruye la matriz por filas) y datos libres que el
+    // shader usa como tinte del color del vértice (rgb; a queda para el usuario)
+    struct InstanceData {
+        Float4x4 world;
+        float customData[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    };
+    static_assert(sizeof(InstanceData) == 80, "InstanceData debe coincidir con el input layout instanciado");
+
+    // Un draw instanciado: instanceCount instancias consecutivas del buffer de instancias
+    struct InstanceBatch {
+        uint32_t meshId = 0;
+        uint32_t lod = 0;
+        uint32_t materialId = 0;
+        uint32_t firstInstance = 0;
+        uint32_t instanceCount = 0;
+    };
+
+    struct InstanceBatcherStats {
+        uint64_t frames = 0;
+        uint64_t objects = 0;        // Proxies enviados
+        uint64_t drawCalls = 0;      // Batches emitidos (un draw instanciado cada uno)
+        uint64_t lastObjects = 0;
+        uint64_t lastDrawCalls = 0;
+
+        uint64_t GetDrawCallsSaved() const { return objects - drawCalls; }
+    };
+
+    // Agrupa los proxies de un snapshot que comparten malla, LOD y material en batches instanciados.
+    // Los batches salen en el orden de la primera aparición de cada (malla, LOD, material) y las
+    // instancias de un batch conservan el orden de envío. Sin depth test eso cambia qué objeto
+    // queda encima cuando dos de batches distintos se solapan, como cualquier agrupación por estado.
+    // Reutiliza su memoria entre frames (sin asignaciones en régimen estable)
+    class InstanceBatcher {
+    public:
+        void Build(const std::vector<RenderProxy>& proxies);
+
+        const std::vector<InstanceBatch>& GetBatches() const { return m_batches; }
+        const std::vector<InstanceData>& GetInstances() const { return m_instances; }
+
+        const InstanceBatcherStats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = InstanceBatcherStats(); }
+        std::string BuildReport() const;
+
+    private:
+        std::unordered_map<uint64_t, uint32_t> m_batchIndices; // (malla, LOD, material) -> batch
+        std::vector<uint32_t> m_proxyBatches;                   // Batch de cada proxy
+        std::vector<uint32_t> m_batchCursors;
+        std::vector<InstanceBatch> m_batches;
+        std::vector<InstanceData> m_instances;
+        InstanceBatcherStats m_stats;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Pool de hilos de trabajo para bucles paralelos del motor
+    // (grabación de comandos, culling, ordenación, transformaciones...)
+    // El hilo que llama a ParallelFor también trabaja, con workerIndex = 0
+    class JobSystem {
+    public:
+        // begin/end: rango de índices del lote; workerIndex: [0, GetThreadCount())
+        using RangeFunction = std::function<void(uint32_t begin, uint32_t end, uint32_t workerIndex)>;
+
+        JobSystem();
+        ~JobSystem();
+
+        // workerCount = 0 -> hardware_concurrency - 1 hilos auxiliares
+        bool Initialize(uint32_t workerCount = 0);
+        void Shutdown();
+
+        // Hilos que pueden ejecutar trabajo (auxiliares + hilo llamador)
+        uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_workers.size()) + 1; }
+
+        // Reparte [0, count) en lotes de batchSize y bloquea hasta completarlos
+        void ParallelFor(uint32_t count, uint32_t batchSize, const RangeFunction& function);
+        // Igual, pero sin JobSystem (jobs == nullptr) los lotes se ejecutan en el hilo que llama
+        static void ParallelFor(JobSystem* jobs, uint32_t count, uint32_t batchSize, const RangeFunction& function);
+
+    private:
+        static void RunInline(uint32_t count, uint32_t batchSize, const RangeFunction& function);
+        void WorkerMain(uint32_t workerIndex);
+        void RunBatches(uint32_t workerIndex);
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_dispatchMutex;     // Serializa llamadas a ParallelFor
+        std::mutex m_mutex;
+        std::condition_variable m_jobAvailable;
+        std::condition_variable m_jobFinished;
+
+        const RangeFunction* m_function = nullptr;
+        uint32_t m_count = 0;
+        uint32_t m_batchSize = 1;
+        std::atomic<uint32_t> m_nextBatch{ 0 };
+        uint32_t m_activeWorkers = 0;
+        uint64_t m_generation = 0;
+        bool m_running = false;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace D3D12Core {
+
+    // Asignador lineal (bump) sobre un rango de bytes, independiente del dispositivo
+    // Allocate es lock-free y puede llamarse desde varios hilos de grabación a la vez;
+    // Reset libera todo el rango de golpe (cuando la GPU ya no lo lee)
+    class LinearAllocator {
+    public:
+        static constexpr uint64_t INVALID_OFFSET = ~0ull;
+
+        LinearAllocator();
+
+        void Initialize(uint64_t baseOffset, uint64_t capacity);
+
+        // Devuelve el offset absoluto o INVALID_OFFSET si el rango está lleno.
+        // alignment debe ser potencia de dos
+        uint64_t Allocate(uint64_t size, uint64_t alignment);
+
+        void Reset();
+
+        uint64_t GetBaseOffset() const { return m_baseOffset; }
+        uint64_t GetCapacity() const { return m_capacity; }
+        uint64_t GetUsedBytes() const;
+        uint64_t GetAllocationCount() const { return m_allocationCount.load(std::memory_order_relaxed); }
+        uint64_t GetFailedCount() const { return m_failedCount.load(std::memory_order_relaxed); }
+
+    private:
+        uint64_t m_baseOffset = 0;
+        uint64_t m_capacity = 0;
+        std::atomic<uint64_t> m_offset{ 0 };       // Relativo a m_baseOffset
+        std::atomic<uint64_t> m_allocationCount{ 0 };
+        std::atomic<uint64_t> m_failedCount{ 0 };
+    };
+
+} // namespace D3D12Core
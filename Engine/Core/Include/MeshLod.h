@@ -0,0 +1,122 @@
+#pragma once
+
+#include "RenderSnapshot.h"
+#include "Vertex.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace D3D12Core {
+
+    constexpr uint32_t MAX_MESH_LODS = 8;
+
+    // Un nivel de detalle: rango del index buffer compartido por todos los niveles y error
+    // geométrico de la simplificación en unidades de la malla (0 en el nivel completo)
+    struct MeshLod {
+        uint32_t startIndex = 0;
+        uint32_t indexCount = 0;
+        float error = 0.0f;
+    };
+
+    struct MeshLodSettings {
+        uint32_t maxLods = 6;          // Incluido el nivel completo (como mucho MAX_MESH_LODS)
+        float reduction = 0.5f;        // Triángulos de cada nivel respecto al anterior
+        uint32_t minTriangles = 16;    // No se generan niveles por debajo
+        float maxError = 0.25f;        // Error máximo relativo al radio de la malla
+        float colorWeight = 1.0f;      // Peso del color (0-1) frente a la posición normalizada a [-1, 1]
+    };
+
+    struct MeshLodBuildStats {
+        uint32_t vertices = 0;
+        uint32_t triangles = 0;        // Del nivel completo
+        uint32_t lockedVertices = 0;   // Costuras de color y aristas no manifold: no se mueven
+        uint32_t borderVertices = 0;   // Solo colapsan a lo largo del borde
+        uint32_t passes = 0;           // Pasadas de colapsos
+        uint32_t collapses = 0;
+        double buildMs = 0.0;
+    };
+
+    // Cadena de LODs de una malla por colapso de aristas con métricas de error cuádricas
+    // (Garland-Heckbert) extendidas al color: cada vértice acumula una cuádrica en 6 dimensiones
+    // (posición y Vertex::color) y un colapso u -> v cuesta el error de la suma en v. Cada
+    // vértice colapsa sobre un vecino existente (half-edge collapse), así que todos los niveles
+    // indexan el mismo vertex buffer y cambiar de nivel solo cambia el rango de índices.
+    //
+    // Los colapsos van por pasadas: se ordenan las aristas por coste y se aplican las más baratas
+    // que no tocan el entorno de otro colapso de la misma pasada, descartando las que dan la
+    // vuelta a algún triángulo. Los vértices de costuras (misma posición con otro color) quedan
+    // fijos y los del borde solo se deslizan por él, con una cuádrica que penaliza alejarse
+    class MeshLodChain {
+    public:
+        bool Build(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+            const MeshLodSettings& settings = MeshLodSettings());
+
+        // Índices de todos los niveles seguidos (nivel 0 = la malla original), listos para un único
+        // index buffer junto al vertex buffer original
+        const std::vector<uint32_t>& GetIndices() const { return m_indices; }
+        uint32_t GetLodCount() const { return static_cast<uint32_t>(m_lods.size()); }
+        const MeshLod* GetLods() const { return m_lods.data(); }
+        const MeshLod& GetLod(uint32_t lod) const { return m_lods[lod]; }
+
+        const MeshLodBuildStats& GetStats() const { return m_stats; }
+        std::string BuildReport() const;
+
+    private:
+        friend class MeshOptimizer;  // Reordena los índices de cada nivel en el sitio
+
+        std::vector<uint32_t> m_indices;
+        std::vector<MeshLod> m_lods;
+        MeshLodBuildStats m_stats;
+    };
+
+    struct LodSelectionSettings {
+        float pixelError = 1.0f;   // Error proyectado máximo en píxeles
+        // Un nivel más simple solo se elige si su error queda por debajo de pixelError * (1 - hysteresis):
+        // cerca del umbral el objeto conserva su nivel en lugar de alternar cada frame
+        float hysteresis = 0.25f;
+    };
+
+    struct LodSelectionStats {
+        uint64_t frames = 0;
+        uint64_t selections = 0;
+        uint64_t switches = 0;         // Cambios de nivel respecto al frame anterior
+        uint64_t triangles = 0;        // Triángulos de los niveles elegidos
+        uint64_t fullTriangles = 0;    // Los que habría con el nivel completo
+        uint64_t lastSelections = 0;
+        uint64_t lastSwitches = 0;
+        uint64_t lastLevels[MAX_MESH_LODS] = {};
+    };
+
+    // Elige el nivel de cada objeto por su error proyectado en pantalla: el error del nivel
+    // (escalado por la matriz de mundo) a la distancia del punto más cercano de su esfera
+    // envolvente. Sube de detalle en cuanto el nivel actual supera el umbral y baja solo con el
+    // margen de la histéresis. El nivel elegido se guarda con el objeto (MeshRendererComponent)
+    // y vuelve como currentLod el frame siguiente
+    //
+    // Uso por frame: BeginFrame, Select por objeto (desde varios hilos a la vez si cada uno pasa
+    // su worker < workerCount) y EndFrame, que suma los contadores de los hilos
+    class LodSelector {
+    public:
+        void SetSettings(const LodSelectionSettings& settings) { m_settings = settings; }
+        const LodSelectionSettings& GetSettings() const { return m_settings; }
+
+        void BeginFrame(const CameraProxy& camera, uint32_t viewportHeight, uint32_t workerCount = 1);
+        // currentLod: el nivel que eligió el frame anterior (0 la primera vez). bounds: AABB de mundo
+        uint32_t Select(const MeshLod* lods, uint32_t lodCount, const Float4x4& world, const float boundsCenter[3],
+            const float boundsExtent[3], uint32_t currentLod, uint32_t worker = 0);
+        void EndFrame();
+
+        const LodSelectionStats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = LodSelectionStats(); }
+        std::string BuildReport() const;
+
+    private:
+        LodSelectionSettings m_settings;
+        float m_cameraPosition[3] = { 0.0f, 0.0f, 0.0f };
+        float m_pixelsPerUnit = 0.0f;  // Píxeles que ocupa una unidad a distancia 1
+        float m_nearDistance = 0.0f;
+        std::vector<LodSelectionStats> m_workerStats;  // Contadores del frame por hilo
+        LodSelectionStats m_stats;
+    };
+
+} // namespace D3D12Core
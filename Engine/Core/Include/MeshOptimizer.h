@@ -0,0 +1,96 @@
+#pragma once
+
+#include "MeshLod.h"
+#include "RHI.h"
+#include "Vertex.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace D3D12Core {
+
+    struct MeshOptimizerSettings {
+        uint32_t cacheSize = 16;          // Vértices de la caché post-transform que se supone (FIFO)
+        bool overdraw = true;             // Reordenar clusters de triángulos para el overdraw
+        // ACMR que se puede perder al partir los clusters: más alto, clusters más pequeños y mejor
+        // orden para el overdraw a cambio de peor caché
+        float overdrawThreshold = 1.05f;
+        bool vertexFetch = true;          // Reordenar el vertex buffer por primer uso
+    };
+
+    // Orden de índices contra una caché FIFO de cacheSize vértices
+    struct VertexCacheStats {
+        uint32_t triangles = 0;
+        uint32_t vertices = 0;            // Vértices distintos usados
+        uint32_t transformed = 0;         // Fallos de caché: vértices que pasan por el vertex shader
+        float acmr = 0.0f;                // Transformados por triángulo (0.5 en una rejilla ideal, 3 sin caché)
+        float atvr = 0.0f;                // Transformados por vértice usado (1 = óptimo)
+    };
+
+    // Lecturas del vertex buffer en líneas de 64 bytes con una caché pequeña
+    struct VertexFetchStats {
+        uint64_t bytesFetched = 0;
+        float overfetch = 0.0f;           // Bytes leídos / bytes de los vértices usados (1 = óptimo)
+    };
+
+    // Píxeles sombreados frente a cubiertos con depth test y backface culling, mirando la malla
+    // desde los seis lados de su AABB
+    struct OverdrawStats {
+        uint64_t covered = 0;
+        uint64_t shaded = 0;
+        float overdraw = 0.0f;            // shaded / covered (1 = cada píxel una vez)
+    };
+
+    struct MeshOptimizerStats {
+        // Del primer rango (el nivel completo de una cadena de LODs)
+        VertexCacheStats cacheBefore;
+        VertexCacheStats cacheAfter;
+        VertexFetchStats fetchBefore;
+        VertexFetchStats fetchAfter;
+        OverdrawStats overdrawBefore;
+        OverdrawStats overdrawAfter;
+        uint32_t cacheSize = 0;
+        uint32_t ranges = 0;
+        uint32_t clusters = 0;            // Clusters ordenados para el overdraw (todos los rangos)
+        uint32_t verticesRemoved = 0;     // Sin usar por ningún índice
+        RHIFormat indexFormat = RHIFormat::R32Uint;
+        double optimizeMs = 0.0;
+    };
+
+    // Optimizador de mallas para importar: reordena los triángulos para la caché post-transform
+    // (Tipsify: avanza en abanico alrededor del vértice más reciente que aún tiene triángulos
+    // pendientes), corta ese orden en clusters donde la caché apenas se resiente y los ordena de
+    // fuera hacia dentro para reducir el overdraw, y por último reordena el vertex buffer por
+    // primer uso para que las lecturas de vértices sean secuenciales. Solo CPU: no toca la GPU
+    //
+    // Los triángulos no cambian (ni su sentido), solo su orden: con depth test el resultado es
+    // el mismo. Sin depth test (el render actual) el orden decide qué cara queda encima
+    class MeshOptimizer {
+    public:
+        // En el sitio. Con ranges, cada rango de índices (p. ej. los LODs de una cadena) se
+        // reordena por separado y todos comparten el remapeo de vértices; sin ranges, el buffer
+        // entero es un rango. Con vertexFetch se eliminan los vértices que no usa ningún índice
+        bool Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, const MeshLod* ranges = nullptr,
+            uint32_t rangeCount = 0, const MeshOptimizerSettings& settings = MeshOptimizerSettings());
+        // Los niveles de la cadena y el vertex buffer que indexan
+        bool Optimize(std::vector<Vertex>& vertices, MeshLodChain& lods,
+            const MeshOptimizerSettings& settings = MeshOptimizerSettings());
+
+        static VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+            uint32_t cacheSize = 16);
+        static VertexFetchStats AnalyzeVertexFetch(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+            uint32_t vertexSize);
+        static OverdrawStats AnalyzeOverdraw(const std::vector<Vertex>& vertices, const uint32_t* indices, uint32_t indexCount);
+
+        // R16Uint si todos los índices caben en 16 bits, si no R32Uint
+        static RHIFormat SelectIndexFormat(uint32_t vertexCount);
+        static void PackIndices16(const uint32_t* indices, uint32_t count, std::vector<uint16_t>& output);
+
+        const MeshOptimizerStats& GetStats() const { return m_stats; }
+        std::string BuildReport() const;
+
+    private:
+        MeshOptimizerStats m_stats;
+    };
+
+} // namespace D3D12Core
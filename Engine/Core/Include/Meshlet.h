@@ -0,0 +1,129 @@
+#pragma once
+
+#include "JobSystem.h"
+#include "RenderSnapshot.h"
+#include "Vertex.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace D3D12Core {
+
+    constexpr uint32_t MESHLET_MAX_VERTICES = 64;
+    constexpr uint32_t MESHLET_MAX_TRIANGLES = 124;
+
+    // Un cluster de triángulos: su rango en el index buffer reordenado de MeshletMesh
+    struct Meshlet {
+        uint32_t startIndex = 0;
+        uint32_t triangleCount = 0;
+        uint32_t vertexCount = 0;      // Vértices distintos que usa (como mucho MESHLET_MAX_VERTICES)
+    };
+
+    // Esfera que contiene el cluster y cono de sus normales (espacio de la malla). Todas las
+    // normales de cara quedan a menos de un ángulo a del eje y coneCutoff = sin(a); 1 si el cono
+    // abre 90 grados o más y el cluster no se puede descartar por estar de espaldas
+    struct MeshletBounds {
+        float center[3] = { 0.0f, 0.0f, 0.0f };
+        float radius = 0.0f;
+        float coneAxis[3] = { 0.0f, 0.0f, 0.0f };
+        float coneCutoff = 1.0f;
+    };
+
+    struct MeshletSettings {
+        uint32_t maxVertices = MESHLET_MAX_VERTICES;    // Como mucho MESHLET_MAX_VERTICES
+        uint32_t maxTriangles = MESHLET_MAX_TRIANGLES;  // Como mucho MESHLET_MAX_TRIANGLES
+        // Peso de la desviación de la normal frente a los vértices nuevos al elegir el siguiente
+        // triángulo: más alto, conos más estrechos (más clusters de espaldas) a cambio de más clusters
+        float coneWeight = 0.5f;
+    };
+
+    struct MeshletBuildStats {
+        uint32_t vertices = 0;
+        uint32_t triangles = 0;
+        uint32_t meshlets = 0;
+        uint32_t meshletVertices = 0;  // Suma de los vértices de cada cluster (los compartidos cuentan varias veces)
+        uint32_t openCones = 0;        // Clusters con el cono de 90 grados o más
+        float averageConeAngle = 0.0f; // Semiángulo medio en grados (sin los abiertos)
+        double buildMs = 0.0;
+    };
+
+    // Clusters de una malla para descartar geometría por debajo del objeto sin mesh shaders. Cada
+    // cluster crece desde el primer triángulo libre añadiendo el triángulo vecino (comparte
+    // vértice con el cluster) que menos vértices nuevos trae y menos se aparta de la normal media,
+    // hasta MESHLET_MAX_VERTICES vértices o MESHLET_MAX_TRIANGLES triángulos; si no quedan vecinos
+    // libres el cluster se cierra. Los índices se reordenan para que cada cluster sea un rango
+    // contiguo: compactar los visibles es copiar rangos. Se construye con los mismos arrays que
+    // recibe D3D12Mesh::Initialize (o el nivel completo de su MeshLodChain)
+    //
+    // Los triángulos delanteros van en sentido horario en pantalla (FrontCounterClockwise = FALSE):
+    // las normales de cara son (b - a) x (c - a) y apuntan hacia la cámara en las caras visibles
+    class MeshletMesh {
+    public:
+        bool Build(const std::vector<Vertex>& vertices, const uint32_t* indices, uint32_t indexCount,
+            const MeshletSettings& settings = MeshletSettings());
+        bool Build(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+            const MeshletSettings& settings = MeshletSettings()) {
+            return Build(vertices, indices.data(), static_cast<uint32_t>(indices.size()), settings);
+        }
+
+        // Los mismos triángulos (y sentido) que la entrada, agrupados por cluster
+        const std::vector<uint32_t>& GetIndices() const { return m_indices; }
+        uint32_t GetMeshletCount() const { return static_cast<uint32_t>(m_meshlets.size()); }
+        const Meshlet* GetMeshlets() const { return m_meshlets.data(); }
+        const MeshletBounds* GetBounds() const { return m_bounds.data(); }
+
+        const MeshletBuildStats& GetStats() const { return m_stats; }
+        std::string BuildReport() const;
+
+    private:
+        std::vector<uint32_t> m_indices;
+        std::vector<Meshlet> m_meshlets;
+        std::vector<MeshletBounds> m_bounds;
+        MeshletBuildStats m_stats;
+    };
+
+    struct MeshletCullingStats {
+        uint64_t frames = 0;           // Llamadas a Cull
+        uint64_t meshlets = 0;
+        uint64_t frustumCulled = 0;    // Esfera fuera de algún plano del frustum
+        uint64_t backfaceCulled = 0;   // Todo el cluster de espaldas a la cámara
+        uint64_t triangles = 0;
+        uint64_t visibleTriangles = 0; // Los que van al index buffer compactado
+        uint64_t lastMeshlets = 0;
+        uint64_t lastFrustumCulled = 0;
+        uint64_t lastBackfaceCulled = 0;
+        double cullMs = 0.0;           // Pruebas y compactación
+    };
+
+    // Culling por cluster en CPU: prueba la esfera de cada cluster contra el frustum y su cono
+    // contra la posición de la cámara, y copia los índices de los que quedan en un index buffer
+    // compactado para un único DrawIndexed. Todo en el espacio de la malla (planos del frustum de
+    // world * viewProjection y la cámara por la inversa de world), así que vale con escalas no
+    // uniformes y espejos. Es conservador: un cluster descartado no tiene ningún triángulo
+    // delantero dentro del frustum. Solo tiene sentido con backface culling en el pipeline; sin
+    // él (el PSO actual) los clusters de espaldas sí se verían
+    class MeshletCuller {
+    public:
+        void SetBackfaceCulling(bool enabled) { m_backface = enabled; }
+
+        // Devuelve el número de índices visibles; quedan en GetIndices() en el orden de los clusters
+        uint32_t Cull(const MeshletMesh& mesh, const Float4x4& world, const CameraProxy& camera, JobSystem* jobs = nullptr);
+        const uint32_t* GetIndices() const { return m_indices.data(); }
+        uint32_t GetIndexCount() const { return m_indexCount; }
+
+        const MeshletCullingStats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = MeshletCullingStats(); }
+        std::string BuildReport() const;
+
+    private:
+        static constexpr uint32_t BLOCK_SIZE = 1024;   // Clusters por lote de los hilos
+
+        bool m_backface = true;
+        std::vector<uint32_t> m_indices;
+        uint32_t m_indexCount = 0;
+        std::vector<uint8_t> m_visible;                // Por cluster: 0 visible, 1 frustum, 2 de espaldas
+        std::vector<uint32_t> m_blockIndices;          // Índices visibles de cada lote, luego su inicio
+        MeshletCullingStats m_stats;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "FakeGpuQueue.h"
+#include "RHI.h"
+#include "RenderGraph.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace D3D12Core {
+
+    // Contadores de la RHI nula (los totales de todas las command lists del dispositivo)
+    struct NullRHIStats {
+        uint64_t buffersCreated = 0;
+        uint64_t bufferBytes = 0;
+        uint64_t pipelinesCreated = 0;
+        uint64_t commandListsCreated = 0;
+        uint64_t commandListsExecuted = 0;
+        uint64_t constantAllocations = 0;
+        uint64_t constantBytes = 0;
+        uint64_t pipelineBinds = 0;
+        uint64_t clears = 0;
+        uint64_t draws = 0;           // Draw + DrawIndexed
+        uint64_t executeIndirects = 0;
+        uint64_t indirectDraws = 0;   // Comandos de ExecuteIndirect (sus argumentos no se leen)
+        uint64_t instances = 0;
+        uint64_t primitives = 0;      // Triángulos enviados (índices o vértices / 3 por instancia)
+        uint64_t validationErrors = 0;
+    };
+
+    class NullRHIDevice;
+
+    class NullRHIBuffer : public IRHIBuffer {
+    public:
+        NullRHIBuffer(const RHIBufferDesc& desc, uint64_t gpuAddress) : m_desc(desc), m_gpuAddress(gpuAddress) {}
+
+        const RHIBufferDesc& GetDesc() const override { return m_desc; }
+        uint64_t GetGpuAddress() const override { return m_gpuAddress; }
+
+    private:
+        RHIBufferDesc m_desc;
+        uint64_t m_gpuAddress;
+    };
+
+    class NullRHIPipeline : public IRHIPipeline {
+    public:
+        explicit NullRHIPipeline(const RHIPipelineDesc& desc) : m_desc(desc) {}
+
+        const RHIPipelineDesc& GetDesc() const override { return m_desc; }
+
+    private:
+        RHIPipelineDesc m_desc;
+    };
+
+    // Command list que no graba nada: comprueba el estado que exigiría la API real
+    // (lista abierta, pipeline, viewport, scissor, render target, buffers y rangos) y cuenta
+    class NullRHICommandList : public IRHICommandList {
+    public:
+        explicit NullRHICommandList(NullRHIDevice* device) : m_device(device) {}
+
+        void Begin() override;
+        void Close() override;
+
+        void SetRenderTarget(uint64_t renderTargetView) override;
+        void ClearRenderTarget(uint64_t renderTargetView, const float color[4]) override;
+        void SetViewport(const RHIViewport& viewport) override;
+        void SetScissor(const RHIRect& rect) override;
+        void SetPipeline(IRHIPipeline* pipeline) override;
+        void SetConstantBuffer(uint32_t rootParameter, uint64_t gpuAddress) override;
+        void SetVertexBuffer(IRHIBuffer* buffer, uint32_t stream = 0) override;
+        void SetIndexBuffer(IRHIBuffer* buffer, RHIFormat format) override;
+        void SetInstanceBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) override;
+        void SetObjectBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) override;
+        void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex, uint32_t startInstance) override;
+        void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override;
+        void ExecuteIndirect(uint64_t argumentAddress, uint32_t commandCount) override;
+
+        void* GetNativeCommandList() override { return nullptr; }
+
+        bool IsOpen() const { return m_open; }
+        // Contadores de la grabación actual (se suman al dispositivo al ejecutarla)
+        const NullRHIStats& GetCounters() const { return m_counters; }
+
+    private:
+        bool CheckOpen(const char* call);
+        // indirect: ExecuteIndirect, el único draw que admite un pipeline indirect (el drawIndex
+        // llega en los argumentos)
+        bool CheckDrawState(const char* call, uint32_t instanceCount, uint32_t startInstance, bool indirect = false);
+
+        NullRHIDevice* m_device;
+        bool m_open = false;
+        uint64_t m_renderTarget = 0;
+        bool m_hasViewport = false;
+        bool m_hasScissor = false;
+        IRHIPipeline* m_pipeline = nullptr;
+        bool m_hasConstants = false;
+        IRHIBuffer* m_vertexBuffers[MAX_VERTEX_STREAMS] = {};
+        IRHIBuffer* m_indexBuffer = nullptr;
+        RHIFormat m_indexFormat = RHIFormat::Unknown;
+        uint64_t m_instanceCapacity = 0; // Instancias del stream enlazado (0 = ninguno)
+        uint64_t m_objectCapacity = 0;   // Objetos del buffer de ExecuteIndirect enlazado (0 = ninguno)
+        NullRHIStats m_counters;
+    };
+
+    // Cola sobre FakeGpuQueue: cada command list ejecutada cuesta el tiempo de GPU simulado
+    // indicado, así que la planificación de frames en vuelo se comporta como con una GPU real
+    class NullRHICommandQueue : public IRHICommandQueue {
+    public:
+        explicit NullRHICommandQueue(NullRHIDevice* device) : m_device(device) {}
+        ~NullRHICommandQueue() override;
+
+        bool Initialize(double gpuMillisecondsPerCommandList);
+        void Shutdown();
+
+        void ExecuteCommandList(IRHICommandList* commandList) override;
+
+        uint64_t Signal() override { return m_gpu.Signal(); }
+        uint64_t GetCompletedValue() const override { return m_gpu.GetCompletedValue(); }
+        void WaitForFenceValue(uint64_t fenceValue) override { m_gpu.WaitForFenceValue(fenceValue); }
+
+        const FakeGpuQueue& GetFakeGpu() const { return m_gpu; }
+
+    private:
+        NullRHIDevice* m_device;
+        FakeGpuQueue m_gpu;
+        double m_gpuMillisecondsPerCommandList = 0.0;
+    };
+
+    // Dispositivo sin GPU para ejecutar el engine headless (Linux/CI): valida el uso de la RHI,
+    // cuenta llamadas y reparte direcciones de GPU ficticias pero únicas
+    class NullRHIDevice : public IRHIDevice {
+    public:
+        NullRHIDevice();
+        ~NullRHIDevice() override;
+
+        // gpuMillisecondsPerCommandList: coste simulado en la cola (0 = GPU infinitamente rápida)
+        bool Initialize(double gpuMillisecondsPerCommandList = 0.0);
+        void Shutdown();
+
+        const char* GetBackendName() const override { return "Null"; }
+        IRHICommandQueue* GetQueue() override { return &m_queue; }
+
+        std::unique_ptr<IRHIBuffer> CreateBuffer(const RHIBufferDesc& desc, const void* initialData = nullptr) override;
+        std::unique_ptr<IRHIPipeline> CreatePipeline(const RHIPipelineDesc& desc) override;
+        std::unique_ptr<IRHICommandList> CreateCommandList() override;
+        uint64_t AllocateConstants(const void* data, uint64_t size) override;
+
+        // Registra un error de validación (mensaje a std::cerr, solo los primeros para no saturar)
+        void ReportError(const std::string& message);
+
+        NullRHIStats GetStats() const;
+        std::string BuildReport() const;
+
+    private:
+        friend class NullRHICommandList;
+        friend class NullRHICommandQueue;
+
+        static constexpr uint64_t GPU_ADDRESS_BASE = 0x100000000ull;
+        static constexpr uint64_t CONSTANT_ALIGNMENT = 256;
+        static constexpr uint64_t MAX_REPORTED_ERRORS = 16;
+
+        NullRHICommandQueue m_queue;
+        mutable std::mutex m_mutex; // Recursos y contadores se pueden tocar desde varios hilos
+        NullRHIStats m_stats;
+        uint64_t m_nextGpuAddress = GPU_ADDRESS_BASE;
+        bool m_initialized = false;
+    };
+
+    // Backend del grafo de render para la RHI nula: tamaños de transitorios estimados
+    // (4 bytes por texel, alineación de 64 KB) y recuento de barreras sin recursos reales.
+    // context.commandList es el IRHICommandList* indicado con SetCommandList
+    class NullRenderGraphBackend : public RenderGraphBackend {
+    public:
+        static constexpr uint64_t PLACEMENT_ALIGNMENT = 64ull * 1024;
+
+        struct Stats {
+            uint64_t graphs = 0;
+            uint64_t passes = 0;
+            uint64_t transitions = 0;
+            uint64_t aliasingBarriers = 0;
+            uint64_t peakHeapBytes = 0;
+        };
+
+        void SetCommandList(IRHICommandList* commandList) { m_commandList = commandList; }
+
+        RenderGraphMemoryRequirements GetMemoryRequirements(const RenderGraphTextureDesc& desc, uint32_t usageMask) override;
+        bool PrepareResources(const RenderGraph& graph) override;
+        void BeginPass(const RenderGraph& graph, const RenderGraph::CompiledPass& pass) override;
+        void EndGraph(const RenderGraph& graph) override;
+        void* GetCommandList() override { return m_commandList; }
+
+        const Stats& GetStats() const { return m_stats; }
+
+    private:
+        IRHICommandList* m_commandList = nullptr;
+        Stats m_stats;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "FrustumCulling.h"
+#include "JobSystem.h"
+#include "RenderSnapshot.h"
+#include "Vertex.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Geometría de un oclusor: solo posiciones (SoA, soldadas por valor exacto) e índices, sin
+    // colores ni buffers de GPU. Se deriva de los mismos arrays que recibe D3D12Mesh::Initialize.
+    // Cada pareja consecutiva de triángulos coplanarios con una arista común que forman un
+    // cuadrilátero convexo se guarda como un quad: las caras de cajas y paredes se rasterizan
+    // enteras, sin el hueco que deja la diagonal con la cobertura conservadora
+    class OcclusionMesh {
+    public:
+        bool Build(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+        uint32_t GetVertexCount() const { return static_cast<uint32_t>(m_positions[0].size()); }
+        const float* GetPositions(uint32_t axis) const { return m_positions[axis].data(); }
+        // 4 índices por primitiva; en los triángulos el último repite el tercero
+        uint32_t GetPrimitiveCount() const { return static_cast<uint32_t>(m_primitives.size() / 4); }
+        const uint32_t* GetPrimitives() const { return m_primitives.data(); }
+        uint32_t GetTriangleCount() const { return m_triangleCount; }
+        // Cerrada (cada arista la comparten dos triángulos en sentidos opuestos): las caras
+        // traseras quedan detrás de las delanteras y se descartan al rasterizar
+        bool IsClosed() const { return m_closed; }
+        const float* GetBoundsCenter() const { return m_boundsCenter; }
+        const float* GetBoundsExtent() const { return m_boundsExtent; }
+
+    private:
+        std::vector<float> m_positions[3];
+        std::vector<uint32_t> m_primitives;
+        uint32_t m_triangleCount = 0;
+        bool m_closed = false;
+        float m_boundsCenter[3] = { 0.0f, 0.0f, 0.0f };
+        float m_boundsExtent[3] = { 0.0f, 0.0f, 0.0f };
+    };
+
+    struct OcclusionStats {
+        uint64_t frames = 0;
+        uint64_t framesReused = 0;     // Mismos oclusores y cámara que el anterior: sin rasterizar
+        uint64_t occluders = 0;        // Oclusores rasterizados
+        uint64_t occludersSkipped = 0; // Ocluidos el frame anterior, fuera de pantalla o demasiado pequeños
+        uint64_t primitives = 0;       // Primitivas de oclusores que llegan al binning
+        uint64_t tested = 0;           // Candidatos probados contra la pirámide
+        uint64_t culled = 0;
+        uint64_t lastTested = 0;
+        uint64_t lastCulled = 0;
+        double rasterMs = 0.0;         // Vértices, setup, raster y pirámide
+        double testMs = 0.0;
+    };
+
+    // Occlusion culling por software. Cada frame rasteriza unos pocos oclusores elegidos en un
+    // depth buffer de baja resolución guardado en bloques de 4x4 píxeles (16 floats seguidos,
+    // una fila del bloque por operación SSE2) y construye encima una pirámide de Z máxima por
+    // bloque. Después prueba la AABB de cada candidato: su rectángulo en pantalla y su z mínima
+    // contra el nivel de la pirámide donde el rectángulo ocupa como mucho 4x4 texels.
+    //
+    // Es conservador: un píxel solo cuenta como cubierto si el oclusor lo tapa entero (aristas
+    // evaluadas en la esquina más desfavorable) y guarda la z más lejana del oclusor dentro del
+    // píxel; las primitivas que cruzan el plano near no se rasterizan y las cajas que lo cruzan
+    // son siempre visibles. Un objeto descartado no tiene ningún píxel visible en el render
+    //
+    // Coherencia temporal: los oclusores que quedaron ocluidos el frame anterior no se
+    // rasterizan (los tapa otro oclusor), y si la cámara y la lista de oclusores no cambian se
+    // reutiliza la pirámide del frame anterior sin rasterizar nada
+    //
+    // Uso por frame: BeginFrame, AddOccluder por cada oclusor, RenderOccluders y Test con los
+    // candidatos que dejó el frustum culling
+    class OcclusionCuller {
+    public:
+        OcclusionCuller();
+        ~OcclusionCuller();
+
+        // Resolución del depth buffer (se redondea a múltiplos de 4)
+        bool Initialize(uint32_t width, uint32_t height);
+        void Shutdown();
+
+        uint32_t GetWidth() const { return m_width; }
+        uint32_t GetHeight() const { return m_height; }
+
+        // objectCount: tamaño del espacio de índices de objeto (el de las cajas de Test)
+        void BeginFrame(const Float4x4& viewProjection, uint32_t objectCount);
+        void BeginFrame(const CameraProxy& camera, uint32_t objectCount);
+        // El oclusor es también el objeto objectIndex: si quedó ocluido el frame anterior no se
+        // rasteriza. mesh debe seguir viva hasta RenderOccluders
+        void AddOccluder(const OcclusionMesh& mesh, const Float4x4& world, uint32_t objectIndex);
+        void RenderOccluders(JobSystem* jobs = nullptr);
+
+        // Prueba bounds[candidates[i]] y devuelve cuántos son visibles; sus índices quedan en
+        // GetVisibleIndices() en el orden de candidates
+        uint32_t Test(const CullingBounds& bounds, const uint32_t* candidates, uint32_t candidateCount, JobSystem* jobs = nullptr);
+        const uint32_t* GetVisibleIndices() const { return m_visible.data(); }
+
+        // Z de la pirámide (nivel 0: máximo de cada bloque de 4x4 píxeles), para depuración
+        uint32_t GetHiZLevelCount() const { return static_cast<uint32_t>(m_hiZ.size()); }
+        float GetHiZ(uint32_t level, uint32_t x, uint32_t y) const;
+
+        const OcclusionStats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = OcclusionStats(); }
+        std::string BuildReport() const;
+
+    private:
+        static constexpr uint32_t BLOCK_SIZE = 4;
+        static constexpr uint32_t TILE_SIZE = 32;  // Píxeles por lado de los tiles del raster
+        static constexpr uint32_t TEST_BATCH = 1024;
+
+        struct Occluder {
+            const OcclusionMesh* mesh;
+            Float4x4 world;
+            uint32_t objectIndex;
+        };
+        struct ActiveOccluder {
+            const OcclusionMesh* mesh;
+            Float4x4 worldViewProjection;
+        };
+        struct SetupPrimitive;
+        struct Chunk;
+        struct HiZLevel {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            std::vector<float> depth;
+        };
+
+        bool SameOccludersAsLastFrame() const;
+        void TransformVertices(JobSystem* jobs);
+        void SetupPrimitives(JobSystem* jobs);
+        void RasterizeTiles(JobSystem* jobs);
+        void RasterizeTile(uint32_t tileX, uint32_t tileY);
+        void BuildHiZ(JobSystem* jobs);
+        bool IsOccluded(const CullingBounds& bounds, uint32_t index) const;
+
+        uint32_t m_width = 0;
+        uint32_t m_height = 0;
+        uint32_t m_blocksX = 0;
+        uint32_t m_blocksY = 0;
+        uint32_t m_tilesX = 0;
+        uint32_t m_tilesY = 0;
+        std::vector<float> m_depth;                  // Bloques de 4x4 en orden de filas de bloques
+        std::vector<HiZLevel> m_hiZ;
+
+        Float4x4 m_viewProjection;
+        std::vector<Occluder> m_occluders;
+        std::vector<Occluder> m_lastOccluders;       // Los que dieron la pirámide actual
+        Float4x4 m_lastViewProjection;
+        bool m_lastOccludersValid = false;
+        bool m_hasOccluders = false;                 // La pirámide tiene algo rasterizado
+        std::vector<uint8_t> m_lastVisible;          // Por índice de objeto: visible en el último Test
+
+        std::vector<ActiveOccluder> m_activeOccluders; // En pantalla y con tamaño suficiente
+        std::vector<uint32_t> m_vertexOffsets;       // Primer vértice de cada oclusor (prefijo)
+        std::vector<uint32_t> m_primitiveOffsets;    // Primera primitiva de cada oclusor (prefijo)
+        std::vector<float> m_vertices[4];            // Vértices SoA: clip space y después pantalla (x, y, z; w < 0 delante de near)
+        std::vector<Chunk> m_chunks;
+        uint32_t m_chunkCount = 0;
+
+        std::vector<uint32_t> m_visible;
+        std::vector<uint32_t> m_batchVisible;        // Visibles de cada lote antes de compactar
+        OcclusionStats m_stats;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "GpuTimeline.h"
+#include "VertexFormat.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace D3D12Core {
+
+    // Capa de abstracción de hardware de render (RHI) mínima
+    // Cubre lo que usa el bucle principal: dispositivo, cola, buffers, pipelines y command lists.
+    // D3D12RHI envuelve las clases D3D12 existentes; NullRHI valida y cuenta las llamadas sin GPU
+    // (ejecución headless en Linux/CI). Las direcciones y vistas son opacas (uint64_t)
+
+    enum class RHIFormat : uint32_t {
+        Unknown = 0,
+        RGBA8Unorm,
+        R16Uint,
+        R32Uint,
+        D32Float,
+        // Atributos de vértices (input layout)
+        RGB32Float,
+        RGBA32Float,
+        RGBA16Snorm
+    };
+
+    inline uint32_t GetFormatSize(RHIFormat format) {
+        switch (format) {
+        case RHIFormat::RGBA8Unorm: return 4;
+        case RHIFormat::R16Uint: return 2;
+        case RHIFormat::R32Uint: return 4;
+        case RHIFormat::D32Float: return 4;
+        case RHIFormat::RGB32Float: return 12;
+        case RHIFormat::RGBA32Float: return 16;
+        case RHIFormat::RGBA16Snorm: return 8;
+        default: return 0;
+        }
+    }
+
+    // Usos de un buffer (combinables)
+    enum RHIBufferUsage : uint32_t {
+        RHI_BUFFER_USAGE_VERTEX = 1u << 0,
+        RHI_BUFFER_USAGE_INDEX = 1u << 1,
+        RHI_BUFFER_USAGE_CONSTANT = 1u << 2,
+        RHI_BUFFER_USAGE_UNORDERED_ACCESS = 1u << 3
+    };
+
+    struct RHIBufferDesc {
+        uint64_t size = 0;
+        uint32_t usage = 0;  // Máscara de RHIBufferUsage
+        uint32_t stride = 0; // Bytes por elemento (vértices/índices); 0 si no aplica
+        const char* debugName = nullptr;
+    };
+
+    struct RHIPipelineDesc {
+        const void* vertexShader = nullptr; // Bytecode del backend (DXBC en D3D12)
+        size_t vertexShaderSize = 0;
+        const void* pixelShader = nullptr;
+        size_t pixelShaderSize = 0;
+        RHIFormat renderTargetFormat = RHIFormat::RGBA8Unorm;
+        uint32_t vertexStride = 0;          // Bytes por vértice del stream 0 (vertexFormat.GetStride(0)); 0 = sin vértices
+        uint32_t instanceStride = 0;        // > 0: stream por instancia tras los de vértices (InstanceData)
+        uint32_t objectStride = 0;          // > 0: pipeline de ExecuteIndirect (IndirectVS), objetos en un structured buffer
+        VertexFormat vertexFormat;          // Input layout de los vértices (BuildVertexElements)
+        bool useConstantBuffer = true;      // Root parameter 0: constantes MVP (b0)
+        const char* debugName = nullptr;
+    };
+
+    struct RHIViewport {
+        float x = 0.0f;
+        float y = 0.0f;
+        float width = 0.0f;
+        float height = 0.0f;
+        float minDepth = 0.0f;
+        float maxDepth = 1.0f;
+    };
+
+    struct RHIRect {
+        int32_t left = 0;
+        int32_t top = 0;
+        int32_t right = 0;
+        int32_t bottom = 0;
+    };
+
+    // Un comando de ExecuteIndirect: índice del objeto del draw (root constant de 32 bits que
+    // IndirectVS usa para leer el buffer de objetos) seguido de D3D12_DRAW_INDEXED_ARGUMENTS
+    struct RHIIndirectDrawCommand {
+        uint32_t drawIndex = 0;
+        uint32_t indexCount = 0;
+        uint32_t instanceCount = 1;
+        uint32_t startIndex = 0;
+        int32_t baseVertex = 0;
+        uint32_t startInstance = 0;
+    };
+    static_assert(sizeof(RHIIndirectDrawCommand) == 24, "RHIIndirectDrawCommand debe coincidir con la firma de comandos");
+
+    class IRHIBuffer {
+    public:
+        virtual ~IRHIBuffer() = default;
+
+        virtual const RHIBufferDesc& GetDesc() const = 0;
+        virtual uint64_t GetGpuAddress() const = 0;
+    };
+
+    class IRHIPipeline {
+    public:
+        virtual ~IRHIPipeline() = default;
+
+        virtual const RHIPipelineDesc& GetDesc() const = 0;
+    };
+
+    // Grabación de comandos de un frame. Se graba entre Begin y Close y se envía con
+    // IRHICommandQueue::ExecuteCommandList
+    class IRHICommandList {
+    public:
+        virtual ~IRHICommandList() = default;
+
+        virtual void Begin() = 0;
+        virtual void Close() = 0;
+
+        virtual void SetRenderTarget(uint64_t renderTargetView) = 0;
+        virtual void ClearRenderTarget(uint64_t renderTargetView, const float color[4]) = 0;
+        virtual void SetViewport(const RHIViewport& viewport) = 0;
+        virtual void SetScissor(const RHIRect& rect) = 0;
+        virtual void SetPipeline(IRHIPipeline* pipeline) = 0;
+        virtual void SetConstantBuffer(uint32_t rootParameter, uint64_t gpuAddress) = 0;
+        // Un stream de vértices del formato del pipeline (0 o, con splitPosition, 1 para el color)
+        virtual void SetVertexBuffer(IRHIBuffer* buffer, uint32_t stream = 0) = 0;
+        virtual void SetIndexBuffer(IRHIBuffer* buffer, RHIFormat format) = 0;
+        // Stream por instancia (slot vertexFormat.GetStreamCount()) desde memoria dinámica (AllocateConstants) o un buffer;
+        // startInstance de los draws indexa este stream
+        virtual void SetInstanceBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) = 0;
+        virtual void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex, uint32_t startInstance) = 0;
+        virtual void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) = 0;
+        // Buffer de objetos del pipeline indirect (objectStride > 0) desde memoria dinámica o un buffer:
+        // cada comando de ExecuteIndirect lee el elemento drawIndex
+        virtual void SetObjectBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) = 0;
+        // commandCount RHIIndirectDrawCommand consecutivos en argumentAddress (memoria dinámica
+        // de AllocateConstants): cada uno fija su drawIndex y hace un DrawIndexed con el resto
+        // del estado. Pipeline indirect con las constantes compartidas (view y projection) y el
+        // buffer de objetos enlazados, que siguen enlazados después
+        virtual void ExecuteIndirect(uint64_t argumentAddress, uint32_t commandCount) = 0;
+
+        // Command list nativa (ID3D12GraphicsCommandList* en D3D12, nullptr en NullRHI)
+        virtual void* GetNativeCommandList() = 0;
+    };
+
+    // Cola de ejecución con su fence (la planificación de frames usa IGpuTimeline)
+    class IRHICommandQueue : public IGpuTimeline {
+    public:
+        virtual void ExecuteCommandList(IRHICommandList* commandList) = 0;
+    };
+
+    class IRHIDevice {
+    public:
+        virtual ~IRHIDevice() = default;
+
+        virtual const char* GetBackendName() const = 0;
+        virtual IRHICommandQueue* GetQueue() = 0;
+
+        // initialData (opcional) se sube antes de que la cola use el buffer
+        virtual std::unique_ptr<IRHIBuffer> CreateBuffer(const RHIBufferDesc& desc, const void* initialData = nullptr) = 0;
+        virtual std::unique_ptr<IRHIPipeline> CreatePipeline(const RHIPipelineDesc& desc) = 0;
+        virtual std::unique_ptr<IRHICommandList> CreateCommandList() = 0;
+
+        // Memoria dinámica del frame actual (constantes, instancias o argumentos): dirección alineada a 256
+        // bytes y válida hasta que la GPU termine el frame
+        virtual uint64_t AllocateConstants(const void* data, uint64_t size) = 0;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "JobSystem.h"
+#include <cstdint>
+#include <vector>
+
+namespace D3D12Core {
+
+    struct RadixSortStats {
+        uint32_t passes = 0;        // Pasadas ejecutadas
+        uint32_t skippedPasses = 0; // Dígitos iguales en todas las claves
+    };
+
+    // Ordenación radix LSD estable de pares (clave de 64 bits, valor de 32 bits) con dígitos de
+    // 8 bits. Cada pasada cuenta un histograma por bloque en paralelo, calcula los prefijos y
+    // reparte cada bloque en orden (estable sin comparaciones). Antes de empezar, un AND/OR de
+    // todas las claves detecta los dígitos constantes (campos que no varían en el frame, como
+    // el pase o la capa) y sus pasadas se saltan
+    //
+    // Reutiliza sus buffers entre llamadas (sin asignaciones en régimen estable)
+    class RadixSorter {
+    public:
+        static constexpr uint32_t DIGIT_BITS = 8;
+        static constexpr uint32_t BUCKETS = 1u << DIGIT_BITS;
+
+        // Ordena keys[0, count) de menor a mayor moviendo values con ellas. jobs: hilos para
+        // histogramas y reparto (nullptr = hilo que llama)
+        RadixSortStats Sort(uint64_t* keys, uint32_t* values, uint32_t count, JobSystem* jobs = nullptr);
+
+    private:
+        // Por debajo de este tamaño por bloque el reparto en hilos no compensa
+        static constexpr uint32_t MIN_BLOCK_SIZE = 16384;
+
+        std::vector<uint64_t> m_scratchKeys;
+        std::vector<uint32_t> m_scratchValues;
+        std::vector<uint32_t> m_histograms;  // BUCKETS contadores por bloque
+        std::vector<uint64_t> m_blockMasks;  // AND y OR de las claves de cada bloque
+    };
+
+} // namespace D3D12Core
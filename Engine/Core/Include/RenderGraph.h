@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace D3D12Core {
+
+    class RenderGraph;
+    class RenderGraphBackend;
+
+    // Identificador de un recurso del grafo (válido hasta el siguiente Reset)
+    struct RenderGraphResource {
+        static constexpr uint32_t INVALID_INDEX = 0xffffffffu;
+        uint32_t index = INVALID_INDEX;
+
+        bool IsValid() const { return index != INVALID_INDEX; }
+        bool operator==(const RenderGraphResource& other) const { return index == other.index; }
+        bool operator!=(const RenderGraphResource& other) const { return index != other.index; }
+    };
+
+    // Uso de un recurso dentro de un pase; el backend lo traduce a su estado (D3D12_RESOURCE_STATES)
+    enum class RenderGraphUsage : uint32_t {
+        Undefined = 0,
+        RenderTarget,
+        DepthWrite,
+        DepthRead,
+        ShaderResource,
+        UnorderedAccess,
+        CopySource,
+        CopyDest,
+        Present,
+        Count
+    };
+
+    inline uint32_t UsageBit(RenderGraphUsage usage) { return 1u << static_cast<uint32_t>(usage); }
+    inline bool IsWriteUsage(RenderGraphUsage usage) {
+        return usage == RenderGraphUsage::RenderTarget || usage == RenderGraphUsage::DepthWrite ||
+            usage == RenderGraphUsage::UnorderedAccess || usage == RenderGraphUsage::CopyDest;
+    }
+
+    // Descripción de una textura 2D del grafo. format es opaco (DXGI_FORMAT en D3D12)
+    struct RenderGraphTextureDesc {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t format = 0;
+        uint32_t mipLevels = 1;
+        float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f }; // Color/profundidad óptimos para limpiar
+    };
+
+    // Lo que el backend necesita reservar para un transitorio (sin crearlo todavía)
+    struct RenderGraphMemoryRequirements {
+        uint64_t size = 0;
+        uint64_t alignment = 1;
+        uint32_t heapCategory = 0; // Solo se solapan transitorios de la misma categoría de heap
+    };
+
+    struct RenderGraphContext {
+        RenderGraph* graph = nullptr;
+        RenderGraphBackend* backend = nullptr;
+        void* commandList = nullptr; // ID3D12GraphicsCommandList* en el backend D3D12
+        uint32_t pass = 0;
+    };
+
+    // Grafo de render de un frame
+    //  - Setup: los pases declaran qué recursos leen y escriben y con qué uso
+    //  - Compile: descarta los pases cuyo resultado nadie consume, calcula la vida de cada
+    //    transitorio, deriva las transiciones entre usos (split barriers cuando hay pases de
+    //    por medio) y solapa en memoria los transitorios cuyas vidas no se cruzan
+    //  - Execute: el backend aplica barreras y el pase graba sus comandos
+    // Compile no toca la GPU: solo pide al backend tamaños y alineaciones, así que el grafo se
+    // puede compilar y comprobar sin dispositivo.
+    // Escribir un recurso no cuenta como leerlo: un pase que mezcla con lo ya escrito
+    // (blending, carga del contenido previo) debe declararlo con ReadWrite
+    class RenderGraph {
+    public:
+        using ExecuteFunction = std::function<void(RenderGraphContext&)>;
+
+        struct Access {
+            RenderGraphResource resource;
+            RenderGraphUsage usage = RenderGraphUsage::Undefined;
+            bool read = false;
+            bool write = false;
+        };
+
+        class PassBuilder {
+        public:
+            PassBuilder(RenderGraph& graph, uint32_t pass) : m_graph(graph), m_pass(pass) {}
+
+            PassBuilder& Read(RenderGraphResource resource, RenderGraphUsage usage = RenderGraphUsage::ShaderResource);
+            PassBuilder& Write(RenderGraphResource resource, RenderGraphUsage usage = RenderGraphUsage::RenderTarget);
+            PassBuilder& ReadWrite(RenderGraphResource resource, RenderGraphUsage usage);
+            // El pase tiene efectos fuera del grafo (readback, consultas): nunca se descarta
+            PassBuilder& SideEffects();
+
+            uint32_t GetIndex() const { return m_pass; }
+
+        private:
+            RenderGraph& m_graph;
+            uint32_t m_pass;
+        };
+
+        struct Transition {
+            RenderGraphResource resource;
+            RenderGraphUsage before = RenderGraphUsage::Undefined;
+            RenderGraphUsage after = RenderGraphUsage::Undefined;
+            bool split = false; // Cierra una transición iniciada antes (BEGIN_ONLY ... END_ONLY)
+        };
+
+        struct AliasingBarrier {
+            RenderGraphResource before; // Inválido: cualquier recurso que ocupase esa memoria
+            RenderGraphResource after;
+        };
+
+        // Pase vivo en orden de ejecución con las barreras que necesita antes de grabarse
+        struct CompiledPass {
+            uint32_t pass = 0;
+            std::vector<AliasingBarrier> aliasing;
+            std::vector<Transition> beginTransitions; // Inicio de split barriers que se cierran más tarde
+            std::vector<Transition> transitions;
+            std::vector<RenderGraphResource> activations; // Transitorios que empiezan a vivir aquí
+        };
+
+        struct ResourceInfo {
+            std::string name;
+            RenderGraphTextureDesc desc;
+            bool imported = false;
+            void* nativeResource = nullptr; // Importados: recurso del backend
+            uint64_t nativeView = 0;        // Importados: vista (RTV/DSV) del backend
+            RenderGraphUsage initialUsage = RenderGraphUsage::Undefined;
+            RenderGraphUsage finalUsage = RenderGraphUsage::Undefined; // Undefined: se deja como esté
+
+            // Resultado de Compile
+            uint32_t usageMask = 0;       // UsageBit de todos los usos vivos
+            uint32_t firstPass = 0;       // Índices en GetCompiledPasses()
+            uint32_t lastPass = 0;
+            bool used = false;
+            bool aliased = false;         // Comparte memoria con otro transitorio
+            RenderGraphMemoryRequirements memory;
+            uint64_t heapOffset = 0;
+        };
+
+        struct Stats {
+            uint32_t passes = 0;
+            uint32_t culledPasses = 0;
+            uint32_t transientResources = 0;
+            uint32_t transitions = 0;
+            uint32_t splitTransitions = 0;
+            uint32_t aliasingBarriers = 0;
+            uint64_t transientBytes = 0; // Suma de los transitorios sin solapar
+            uint64_t heapBytes = 0;      // Memoria real tras el aliasing
+        };
+
+        RenderGraph();
+
+        // Vacía pases y recursos para grabar el siguiente frame (conserva la capacidad)
+        void Reset();
+
+        RenderGraphResource ImportTexture(const std::string& name, const RenderGraphTextureDesc& desc,
+            void* nativeResource, uint64_t nativeView,
+            RenderGraphUsage initialUsage, RenderGraphUsage finalUsage = RenderGraphUsage::Undefined);
+        RenderGraphResource CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc);
+
+        PassBuilder AddPass(const std::string& name, ExecuteFunction execute);
+
+        // Devuelve false si el grafo es inválido (p. ej. un transitorio leído antes de escribirse)
+        bool Compile(RenderGraphBackend& backend);
+        void Execute(RenderGraphBackend& backend);
+
+        bool IsCompiled() const { return m_compiled; }
+        const std::vector<CompiledPass>& GetCompiledPasses() const { return m_compiledPasses; }
+        const std::vector<uint64_t>& GetHeapSizes() const { return m_heapSizes; } // Por categoría
+        const std::vector<Transition>& GetFinalTransitions() const { return m_finalTransitions; }
+        const ResourceInfo& GetResource(RenderGraphResource resource) const { return m_resources[resource.index]; }
+        size_t GetResourceCount() const { return m_resources.size(); }
+        const std::string& GetPassName(uint32_t pass) const { return m_passes[pass].name; }
+        size_t GetPassCount() const { return m_passes.size(); }
+        bool IsPassCulled(uint32_t pass) const { return m_passes[pass].culled; }
+        const Stats& GetStats() const { return m_stats; }
+
+        std::string BuildReport() const;
+
+    private:
+        struct Pass {
+            std::string name;
+            ExecuteFunction execute;
+            std::vector<Access> accesses;
+            bool sideEffects = false;
+            bool culled = false;
+        };
+
+        void AddAccess(uint32_t pass, RenderGraphResource resource, RenderGraphUsage usage, bool read, bool write);
+        void CullPasses();
+        bool ComputeLifetimes();
+        void DeriveTransitions();
+        void AssignMemory(RenderGraphBackend& backend);
+
+        std::vector<Pass> m_passes;
+        std::vector<ResourceInfo> m_resources;
+        std::vector<CompiledPass> m_compiledPasses;
+        std::vector<Transition> m_finalTransitions;
+        std::vector<uint64_t> m_heapSizes;
+        Stats m_stats;
+        bool m_compiled = false;
+        bool m_valid = true; // False si algún pase declaró un acceso imposible
+    };
+
+    // Lo que el grafo necesita de la API gráfica
+    class RenderGraphBackend {
+    public:
+        virtual ~RenderGraphBackend() = default;
+
+        // Tamaño y alineación de un transitorio con los usos dados (máscara de UsageBit)
+        virtual RenderGraphMemoryRequirements GetMemoryRequirements(const RenderGraphTextureDesc& desc, uint32_t usageMask) = 0;
+        // Crea o reutiliza la memoria y los recursos de los transitorios según el grafo compilado
+        virtual bool PrepareResources(const RenderGraph& graph) = 0;
+        // Barreras de aliasing y transiciones del pase, en un solo lote, antes de grabarlo
+        virtual void BeginPass(const RenderGraph& graph, const RenderGraph::CompiledPass& pass) = 0;
+        // Transiciones finales de los recursos importados
+        virtual void EndGraph(const RenderGraph& graph) = 0;
+        virtual void* GetCommandList() = 0;
+    };
+
+} // namespace D3D12Core
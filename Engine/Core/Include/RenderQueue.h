@@ -0,0 +1,83 @@
+#pragma once
+
+#include "JobSystem.h"
+#include "RadixSort.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Clave de orden de 64 bits de un draw: ordenar las claves de menor a mayor da el orden de
+    // envío. Campos de más a menos significativo:
+    //   opaco:        pase(4) capa(4) 0 pipeline(12) material(16) malla(12) profundidad(15)
+    //   transparente: pase(4) capa(4) 1 ~profundidad(24) pipeline(12) material(16) libre(3)
+    // Los opacos se agrupan por estado (menos cambios de PSO/root signature) y, dentro de cada
+    // estado, de delante a atrás; los transparentes van después de los opacos de su capa y de
+    // atrás a delante. Los ids que no caben en su campo se truncan: solo empeora la agrupación,
+    // el draw sigue usando su estado real
+    namespace DrawSortKey {
+
+        constexpr uint32_t PASS_BITS = 4;
+        constexpr uint32_t LAYER_BITS = 4;
+        constexpr uint32_t PIPELINE_BITS = 12;
+        constexpr uint32_t MATERIAL_BITS = 16;
+        constexpr uint32_t MESH_BITS = 12;
+        constexpr uint32_t OPAQUE_DEPTH_BITS = 15;
+        constexpr uint32_t TRANSPARENT_DEPTH_BITS = 24;
+
+        // depth: distancia a la cámara (z de vista, >= 0). Sin depth test los opacos deben
+        // pasar 0 para que el sort (estable) conserve su orden de envío
+        uint64_t Opaque(uint32_t pass, uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth);
+        uint64_t Transparent(uint32_t pass, uint32_t layer, uint32_t pipeline, uint32_t material, float depth);
+
+        uint32_t GetPass(uint64_t key);
+        uint32_t GetLayer(uint64_t key);
+        bool IsTransparent(uint64_t key);
+        uint32_t GetPipeline(uint64_t key);
+        uint32_t GetMaterial(uint64_t key);
+
+    } // namespace DrawSortKey
+
+    struct RenderQueueStats {
+        uint64_t sorts = 0;
+        uint64_t draws = 0;
+        uint64_t radixPasses = 0;
+        uint64_t skippedPasses = 0;     // Dígitos constantes en todo el frame
+        uint64_t pipelineChanges = 0;   // Cambios de pipeline en el orden final
+        uint64_t materialChanges = 0;
+        uint64_t unsortedPipelineChanges = 0; // Los mismos cambios en el orden de envío original
+        uint64_t unsortedMaterialChanges = 0;
+    };
+
+    // Lista de draws de un frame: cada draw entra con su clave y un índice opaco (proxy, comando
+    // ...) que el llamador usa al recorrer la lista ordenada
+    //
+    // Uso por frame: Reset, Add por draw, Sort y recorrer GetDrawIndices en orden. La memoria se
+    // conserva entre frames
+    class RenderQueue {
+    public:
+        void Reset();
+        void Reserve(uint32_t count);
+        void Add(uint64_t key, uint32_t drawIndex);
+        // Orden estable (radix sort; jobs reparte histogramas y reparto, nullptr = hilo que llama)
+        void Sort(JobSystem* jobs = nullptr);
+
+        uint32_t GetCount() const { return static_cast<uint32_t>(m_keys.size()); }
+        const std::vector<uint64_t>& GetKeys() const { return m_keys; }
+        const std::vector<uint32_t>& GetDrawIndices() const { return m_drawIndices; }
+
+        const RenderQueueStats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = RenderQueueStats(); }
+        std::string BuildReport() const;
+
+    private:
+        void CountStateChanges(uint64_t& pipelineChanges, uint64_t& materialChanges) const;
+
+        std::vector<uint64_t> m_keys;
+        std::vector<uint32_t> m_drawIndices;
+        RadixSorter m_sorter;
+        RenderQueueStats m_stats;
+    };
+
+} // namespace D3D12Core
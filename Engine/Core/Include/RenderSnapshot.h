@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Matriz 4x4 de floats con la misma disposición que XMFLOAT4X4 (fila a fila)
+    struct Float4x4 {
+        float m[4][4] = {
+            { 1.0f, 0.0f, 0.0f, 0.0f },
+            { 0.0f, 1.0f, 0.0f, 0.0f },
+            { 0.0f, 0.0f, 1.0f, 0.0f },
+            { 0.0f, 0.0f, 0.0f, 1.0f }
+        };
+    };
+
+    // a * b con vectores fila (como XMMatrixMultiply): primero a, después b
+    inline Float4x4 Multiply(const Float4x4& a, const Float4x4& b) {
+        Float4x4 result;
+        for (int row = 0; row < 4; row++) {
+            for (int column = 0; column < 4; column++) {
+                float sum = 0.0f;
+                for (int k = 0; k < 4; k++) {
+                    sum += a.m[row][k] * b.m[k][column];
+                }
+                result.m[row][column] = sum;
+            }
+        }
+        return result;
+    }
+
+    struct CameraProxy {
+        Float4x4 view;
+        Float4x4 projection;
+        float position[3] = { 0.0f, 0.0f, 0.0f };
+    };
+
+    // Parámetros de un material tal como los ve el render (version cambia al editarse)
+    struct MaterialProxy {
+        uint32_t materialId = 0;
+        uint32_t version = 0;
+        float baseColor[3] = { 1.0f, 1.0f, 1.0f };
+    };
+
+    struct RenderProxy {
+        uint32_t meshId = 0;
+        uint32_t materialId = 0;
+        Float4x4 world;
+        float customData[4] = { 1.0f, 1.0f, 1.0f, 1.0f }; // Datos por instancia (InstanceData)
+        // AABB de mundo para el culling (centro y semiextensión), calculada junto a world por
+        // TransformHierarchy
+        float boundsCenter[3] = { 0.0f, 0.0f, 0.0f };
+        float boundsExtent[3] = { 0.0f, 0.0f, 0.0f };
+        // Oclusor elegido: su malla se rasteriza en el depth buffer de OcclusionCuller
+        bool occluder = false;
+        // Nivel de detalle de la malla (LodSelector): rango de índices dentro de sus buffers
+        uint32_t lod = 0;
+    };
+
+    // Estado completo e inmutable de un frame que el hilo de juego entrega al de render.
+    // Lleva todo lo necesario para dibujar (no deltas): un snapshot descartado no pierde cambios
+    struct RenderSnapshot {
+        uint64_t frameNumber = 0;
+        uint32_t viewportWidth = 0;
+        uint32_t viewportHeight = 0;
+        CameraProxy camera;
+        std::vector<RenderProxy> proxies;
+        std::vector<MaterialProxy> materials;
+
+        // Vacía conservando la capacidad (sin asignaciones en régimen estable)
+        void Clear() {
+            frameNumber = 0;
+            proxies.clear();
+            materials.clear();
+        }
+    };
+
+} // namespace D3D12Core
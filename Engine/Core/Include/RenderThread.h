@@ -0,0 +1,55 @@
+#pragma once
+
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace D3D12Core {
+
+    struct RenderThreadStats {
+        uint64_t published = 0; // Snapshots publicados por el hilo de juego
+        uint64_t rendered = 0;  // Snapshots dibujados por el hilo de render
+        uint64_t dropped = 0;   // Sustituidos por uno más reciente antes de dibujarse
+    };
+
+    // Hilo de render alimentado por snapshots triple-buffer
+    // El hilo de juego rellena BeginSnapshot() y llama a Publish() sin esperar nunca al render;
+    // el hilo de render dibuja siempre el snapshot más reciente y duerme si no hay ninguno nuevo.
+    // Simulación y grabación se solapan y un Present lento solo hace que se salten snapshots.
+    // Todo el uso del dispositivo (Resize incluido) debe hacerse dentro de la función de render
+    class RenderThread {
+    public:
+        using RenderFunction = std::function<void(const RenderSnapshot&)>;
+
+        RenderThread();
+        ~RenderThread();
+
+        bool Start(RenderFunction render);
+        // Termina el snapshot en curso (si lo hay) y espera al hilo
+        void Stop();
+        bool IsRunning() const { return m_thread.joinable(); }
+
+        // Hilo de juego: snapshot vacío a rellenar y su publicación
+        RenderSnapshot& BeginSnapshot();
+        void Publish();
+
+        RenderThreadStats GetStats() const;
+
+    private:
+        void ThreadMain();
+
+        TripleBuffer<RenderSnapshot> m_snapshots;
+        RenderFunction m_render;
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        bool m_stopRequested = false;
+        std::atomic<uint64_t> m_rendered{ 0 };
+    };
+
+} // namespace D3D12Core
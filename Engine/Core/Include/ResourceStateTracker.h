@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Seguimiento de estados de recursos independiente de la API
+    // Los recursos se identifican por una clave opaca y sus estados son máscaras de bits
+    // (D3D12_RESOURCE_STATES en el backend D3D12). Las transiciones se piden de forma
+    // declarativa ("quiero este recurso en este estado") y se acumulan en un lote que se
+    // vacía de una vez por pase:
+    //  - Transiciones redundantes o ya cubiertas por un estado de lectura combinado se eliden
+    //  - Dos transiciones del mismo subrecurso dentro del lote se fusionan (A->B->C = A->C)
+    //  - BeginTransition + Transition generan un split barrier (BEGIN_ONLY / END_ONLY)
+    //  - Los recursos con promoción implícita (buffers) pasan de COMMON a cualquier estado sin
+    //    barrera y vuelven a COMMON al terminar cada ExecuteCommandLists (OnExecuted)
+    // Las transiciones se aplican en orden de petición: pedirlas desde un único hilo/línea de tiempo
+    class ResourceStateTracker {
+    public:
+        static constexpr uint32_t ALL_SUBRESOURCES = 0xffffffffu;
+        static constexpr uint32_t STATE_COMMON = 0;
+
+        enum BarrierFlags : uint32_t {
+            BARRIER_FULL = 0,
+            BARRIER_BEGIN_ONLY = 1,
+            BARRIER_END_ONLY = 2
+        };
+
+        struct Barrier {
+            uint64_t resource = 0;
+            uint32_t subresource = ALL_SUBRESOURCES;
+            uint32_t before = 0;
+            uint32_t after = 0;
+            uint32_t flags = BARRIER_FULL;
+        };
+
+        struct Stats {
+            uint64_t requested = 0;   // Transiciones pedidas (por subrecurso)
+            uint64_t issued = 0;      // Barreras emitidas al vaciar lotes
+            uint64_t elided = 0;      // Pedidas que no necesitaban barrera
+            uint64_t merged = 0;      // Fusionadas con otra del mismo lote
+            uint64_t promoted = 0;    // Resueltas por promoción implícita
+            uint64_t splitBegins = 0; // Split barriers iniciados
+            uint64_t flushes = 0;     // Llamadas ResourceBarrier
+        };
+
+        ResourceStateTracker();
+
+        // writeStateMask: bits de estados de escritura (no combinables con otros estados)
+        void Initialize(uint32_t writeStateMask);
+
+        void RegisterResource(uint64_t resource, uint32_t subresourceCount, uint32_t initialState, bool implicitPromotion);
+        void UnregisterResource(uint64_t resource);
+        bool IsRegistered(uint64_t resource) const { return m_resources.find(resource) != m_resources.end(); }
+        uint32_t GetState(uint64_t resource, uint32_t subresource = 0) const;
+
+        void Transition(uint64_t resource, uint32_t subresource, uint32_t newState);
+        // Inicia la transición sin esperar; el recurso no debe usarse hasta el Transition que la cierra
+        void BeginTransition(uint64_t resource, uint32_t subresource, uint32_t newState);
+
+        // Fin de ExecuteCommandLists: los recursos con promoción implícita decaen a COMMON
+        void OnExecuted();
+
+        bool HasPendingBarriers() const { return !m_pending.empty(); }
+        // Entrega el lote pendiente (una llamada ResourceBarrier) y lo vacía
+        void TakePendingBarriers(std::vector<Barrier>& barriers);
+
+        const Stats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = Stats(); }
+
+    private:
+        static constexpr uint32_t NO_SPLIT = 0xffffffffu;
+
+        struct TrackedResource {
+            std::vector<uint32_t> states;       // Uno por subrecurso
+            std::vector<uint32_t> splitTargets; // Estado destino de un split barrier abierto
+            bool implicitPromotion = false;
+            bool promoted = false;              // Estado actual alcanzado por promoción implícita
+        };
+
+        bool IsReadOnly(uint32_t state) const { return state != STATE_COMMON && (state & m_writeStateMask) == 0; }
+        void TransitionSubresource(uint64_t key, TrackedResource& resource, uint32_t subresource, uint32_t barrierSubresource, uint32_t newState);
+        bool TransitionWhole(uint64_t key, TrackedResource& resource, uint32_t newState);
+        void AddBarrier(uint64_t key, uint32_t subresource, uint32_t before, uint32_t after, uint32_t flags);
+
+        std::unordered_map<uint64_t, TrackedResource> m_resources;
+        std::vector<Barrier> m_pending;
+        uint32_t m_writeStateMask = 0;
+        Stats m_stats;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+namespace D3D12Core {
+
+    // Asignador en anillo sobre un rango de bytes [0, capacity), independiente del dispositivo
+    // Cada asignación queda asociada al valor de fence del envío que la usa; Retire libera
+    // en orden FIFO todo lo que la GPU ya completó. Solo gestiona offsets: el recurso
+    // mapeado lo pone quien lo use (p. ej. D3D12StagingRing)
+    class RingAllocator {
+    public:
+        static constexpr uint64_t INVALID_OFFSET = ~0ull;
+
+        struct Stats {
+            uint64_t allocations = 0;
+            uint64_t failedAllocations = 0;   // Sin espacio hasta que la GPU libere
+            uint64_t wraps = 0;               // Veces que se saltó al inicio del anillo
+            uint64_t bytesWasted = 0;         // Relleno al final del anillo por wrap-around
+            uint64_t peakUsed = 0;
+        };
+
+        RingAllocator();
+
+        void Initialize(uint64_t capacity);
+        void Reset();
+
+        // Devuelve el offset o INVALID_OFFSET si no cabe sin pisar memoria en uso.
+        // alignment debe ser potencia de dos
+        uint64_t Allocate(uint64_t size, uint64_t alignment = 1);
+
+        // Asigna el valor de fence a todas las asignaciones hechas desde la última llamada
+        void FinishSubmission(uint64_t fenceValue);
+
+        // Libera las asignaciones cuyo fence ya se completó
+        void Retire(uint64_t completedFenceValue);
+
+        // Fence que hay que esperar para que quepa size (0 si no hay nada que esperar)
+        uint64_t GetFenceToFit(uint64_t size, uint64_t alignment = 1) const;
+
+        uint64_t GetCapacity() const { return m_capacity; }
+        uint64_t GetUsedBytes() const { return m_used; }
+        bool IsEmpty() const { return m_used == 0; }
+        const Stats& GetStats() const { return m_stats; }
+
+    private:
+        struct Submission {
+            uint64_t fenceValue = 0;
+            uint64_t end = 0;     // m_head al cerrar el envío
+            uint64_t size = 0;    // Bytes (incluido relleno) que libera al retirarse
+        };
+
+        bool Fits(uint64_t size, uint64_t alignment, uint64_t head, uint64_t tail, uint64_t used, uint64_t& offset, uint64_t& padding) const;
+
+        uint64_t m_capacity = 0;
+        uint64_t m_head = 0;           // Siguiente byte libre
+        uint64_t m_tail = 0;           // Primer byte todavía en uso
+        uint64_t m_used = 0;           // Bytes ocupados (incluido relleno)
+        uint64_t m_pendingSize = 0;    // Bytes asignados aún sin fence
+        std::deque<Submission> m_submissions;
+        Stats m_stats;
+    };
+
+} // namespace D3D12Core
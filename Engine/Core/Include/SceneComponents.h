@@ -0,0 +1,24 @@
+#pragma once
+
+#include "TransformHierarchy.h"
+#include <cstdint>
+
+namespace D3D12Core {
+
+    // Componentes de los objetos de escena en el EntityWorld
+
+    // Nodo de la jerarquía que da la matriz y la AABB de mundo del objeto
+    struct TransformComponent {
+        TransformHandle handle = INVALID_TRANSFORM;
+    };
+
+    // Qué se dibuja: se copia tal cual a su RenderProxy
+    struct MeshRendererComponent {
+        uint32_t meshId = 0;
+        uint32_t materialId = 0;
+        float customData[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        bool occluder = false; // Se rasteriza como oclusor en el occlusion culling
+        uint32_t lod = 0;      // Nivel de detalle elegido el último frame (histéresis del LodSelector)
+    };
+
+} // namespace D3D12Core
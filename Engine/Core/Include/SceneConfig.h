@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+namespace D3D12Core {
+
+    // Estructura de configuración
+    struct CubeConfig {
+        float rotationSpeed = 0.015f;
+        float scale = 0.6f;
+        float rotationXMultiplier = 0.7f;
+        float cameraX = 0.0f;
+        float cameraY = 1.0f;
+        float cameraZ = -4.0f;
+        float fov = 0.785398163f; // pi/4 (XM_PIDIV4)
+        float clearColorR = 0.05f;
+        float clearColorG = 0.05f;
+        float clearColorB = 0.1f;
+        bool autoRotate = true;
+    };
+
+    // Lee config.json (editor C#) desde las ubicaciones conocidas; false si no existe
+    bool LoadConfig(CubeConfig& config);
+
+    // Lee "BaseColor": [r, g, b] de current_material.json (Material Editor); false si falta
+    bool LoadMaterialBaseColor(const std::string& path, float baseColor[3]);
+
+} // namespace D3D12Core
@@ -0,0 +1,92 @@
+#pragma once
+
+// Vector de 4 floats con máscaras de comparación: SSE2 o escalar con la misma semántica. Lo usan
+// los rasterizadores por CPU (SoftwareRasterizer, OcclusionCulling) para recorrer 4 píxeles a la vez
+//
+// Va en un namespace anónimo, como SimdKernelBodies.h: cada unidad que lo incluye tiene su copia
+// compilada con sus propios flags
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_FLOAT4_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace D3D12Core {
+
+    namespace {
+
+#if SIMD_FLOAT4_SSE2
+        struct Float4 {
+            __m128 v;
+
+            static Float4 Set(float value) { return { _mm_set1_ps(value) }; }
+            static Float4 Ramp(float first) { return { _mm_setr_ps(first, first + 1.0f, first + 2.0f, first + 3.0f) }; }
+            static Float4 Load(const float* values) { return { _mm_loadu_ps(values) }; }
+            void Store(float* values) const { _mm_storeu_ps(values, v); }
+            // Redondeo al entero más cercano (valores no negativos)
+            void StoreRounded(int32_t* values) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(values), _mm_cvtps_epi32(v)); }
+        };
+        inline Float4 operator+(Float4 a, Float4 b) { return { _mm_add_ps(a.v, b.v) }; }
+        inline Float4 operator-(Float4 a, Float4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+        inline Float4 operator*(Float4 a, Float4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+        inline Float4 operator/(Float4 a, Float4 b) { return { _mm_div_ps(a.v, b.v) }; }
+        inline Float4 operator&(Float4 a, Float4 b) { return { _mm_and_ps(a.v, b.v) }; }
+        inline Float4 operator|(Float4 a, Float4 b) { return { _mm_or_ps(a.v, b.v) }; }
+        inline Float4 CmpGreater(Float4 a, Float4 b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+        inline Float4 CmpGreaterEqual(Float4 a, Float4 b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+        inline Float4 CmpEqual(Float4 a, Float4 b) { return { _mm_cmpeq_ps(a.v, b.v) }; }
+        inline Float4 CmpLess(Float4 a, Float4 b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+        inline Float4 MaskFromBool(bool value) { return { _mm_castsi128_ps(_mm_set1_epi32(value ? -1 : 0)) }; }
+        inline Float4 Min(Float4 a, Float4 b) { return { _mm_min_ps(a.v, b.v) }; }
+        inline Float4 Max(Float4 a, Float4 b) { return { _mm_max_ps(a.v, b.v) }; }
+        inline Float4 Saturate(Float4 a) { return { _mm_min_ps(_mm_max_ps(a.v, _mm_setzero_ps()), _mm_set1_ps(1.0f)) }; }
+        // mask ? a : b por carril
+        inline Float4 Select(Float4 mask, Float4 a, Float4 b) { return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) }; }
+        inline int MoveMask(Float4 mask) { return _mm_movemask_ps(mask.v); }
+#else
+        struct Float4 {
+            float v[4];
+
+            static Float4 Set(float value) { return { { value, value, value, value } }; }
+            static Float4 Ramp(float first) { return { { first, first + 1.0f, first + 2.0f, first + 3.0f } }; }
+            static Float4 Load(const float* values) { return { { values[0], values[1], values[2], values[3] } }; }
+            void Store(float* values) const { for (int i = 0; i < 4; i++) values[i] = v[i]; }
+            void StoreRounded(int32_t* values) const { for (int i = 0; i < 4; i++) values[i] = static_cast<int32_t>(v[i] + 0.5f); }
+        };
+        // Las máscaras escalares usan 1.0f/0.0f por carril
+        template <typename Operation>
+        inline Float4 PerLane(Float4 a, Float4 b, Operation operation) {
+            Float4 result;
+            for (int i = 0; i < 4; i++) result.v[i] = operation(a.v[i], b.v[i]);
+            return result;
+        }
+        inline Float4 operator+(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return x + y; }); }
+        inline Float4 operator-(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return x - y; }); }
+        inline Float4 operator*(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return x * y; }); }
+        inline Float4 operator/(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return x / y; }); }
+        inline Float4 operator&(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return (x != 0.0f && y != 0.0f) ? 1.0f : 0.0f; }); }
+        inline Float4 operator|(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return (x != 0.0f || y != 0.0f) ? 1.0f : 0.0f; }); }
+        inline Float4 CmpGreater(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return x > y ? 1.0f : 0.0f; }); }
+        inline Float4 CmpGreaterEqual(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return x >= y ? 1.0f : 0.0f; }); }
+        inline Float4 CmpEqual(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return x == y ? 1.0f : 0.0f; }); }
+        inline Float4 CmpLess(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return x < y ? 1.0f : 0.0f; }); }
+        inline Float4 MaskFromBool(bool value) { return Float4::Set(value ? 1.0f : 0.0f); }
+        inline Float4 Min(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return std::min(x, y); }); }
+        inline Float4 Max(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return std::max(x, y); }); }
+        inline Float4 Saturate(Float4 a) { return PerLane(a, a, [](float x, float) { return std::min(1.0f, std::max(0.0f, x)); }); }
+        inline Float4 Select(Float4 mask, Float4 a, Float4 b) {
+            Float4 result;
+            for (int i = 0; i < 4; i++) result.v[i] = mask.v[i] != 0.0f ? a.v[i] : b.v[i];
+            return result;
+        }
+        inline int MoveMask(Float4 mask) {
+            return (mask.v[0] != 0.0f ? 1 : 0) | (mask.v[1] != 0.0f ? 2 : 0) | (mask.v[2] != 0.0f ? 4 : 0) | (mask.v[3] != 0.0f ? 8 : 0);
+        }
+#endif
+
+    } // namespace
+
+} // namespace D3D12Core
@@ -0,0 +1,628 @@
+#pragma once
+
+// Cuerpos de los kernels por lotes, genéricos sobre un tipo Lanes que define el ancho y las
+// operaciones del nivel. Solo lo incluyen los SimdKernels*.cpp: cada uno instancia los cuerpos
+// con sus Lanes y los flags de su juego de instrucciones
+//
+// Todo va en un namespace anónimo y sin funciones de la biblioteca estándar: una función inline
+// compartida entre unidades compiladas con -mavx512f y sin él podría acabar enlazada en su
+// versión AVX-512 y ejecutarse en una CPU que no la tiene
+
+#include "SimdKernels.h"
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace D3D12Core {
+
+    namespace {
+
+        constexpr uint32_t KERNEL_PLANE_COUNT = 6;
+
+        uint32_t LowestBit(uint32_t mask) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<uint32_t>(index);
+#else
+            return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+        }
+
+        float AbsScalar(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            bits &= 0x7FFFFFFFu;
+            std::memcpy(&value, &bits, sizeof(bits));
+            return value;
+        }
+
+        // Un elemento por iteración: el nivel escalar y el resto de los demás niveles
+        struct ScalarLanes {
+            using Float = float;
+            static constexpr uint32_t WIDTH = 1;
+            static Float Load(const float* source) { return *source; }
+            static void Store(float* destination, Float value) { *destination = value; }
+            static Float Splat(float value) { return value; }
+            static Float Add(Float a, Float b) { return a + b; }
+            static Float Sub(Float a, Float b) { return a - b; }
+            static Float Mul(Float a, Float b) { return a * b; }
+            static Float Abs(Float value) { return AbsScalar(value); }
+            static uint32_t NonNegative(Float value) { return value >= 0.0f ? 1u : 0u; }
+        };
+
+        // Producto fila a fila (suma de k = 0 a 3 en orden, como los kernels SIMD) traspuesto al escribir
+        void MultiplyTransposeScalar(const Float4x4* left, uint32_t leftStride, const uint32_t* indices,
+            const Float4x4* right, Float4x4* output, uint32_t outputStride, uint32_t begin, uint32_t end) {
+            const char* leftBytes = reinterpret_cast<const char*>(left);
+            char* outputBytes = reinterpret_cast<char*>(output);
+            for (uint32_t i = begin; i < end; i++) {
+                const uint32_t source = indices ? indices[i] : i;
+                const Float4x4& matrix = *reinterpret_cast<const Float4x4*>(leftBytes + static_cast<size_t>(source) * leftStride);
+                Float4x4& destination = *reinterpret_cast<Float4x4*>(outputBytes + static_cast<size_t>(i) * outputStride);
+                for (int row = 0; row < 4; row++) {
+                    for (int column = 0; column < 4; column++) {
+                        destination.m[column][row] = right
+                            ? matrix.m[row][0] * right->m[0][column] + matrix.m[row][1] * right->m[1][column] +
+                              matrix.m[row][2] * right->m[2][column] + matrix.m[row][3] * right->m[3][column]
+                            : matrix.m[row][column];
+                    }
+                }
+            }
+        }
+
+        // Carga y guarda WIDTH matrices consecutivas como 16 vectores (uno por elemento, fila a
+        // fila). Los niveles x86 trasponen de 4 en 4 con Lanes::Transpose4
+        template <typename Lanes>
+        void LoadMatrixElements(const Float4x4* matrices, typename Lanes::Float elements[16]) {
+            constexpr uint32_t QUADS = Lanes::WIDTH / 4;
+            for (uint32_t row = 0; row < 4; row++) {
+                typename Lanes::Float rows[4];
+                for (uint32_t lane = 0; lane < 4; lane++) {
+                    const float* sources[QUADS];
+                    for (uint32_t quad = 0; quad < QUADS; quad++) {
+                        sources[quad] = matrices[quad * 4 + lane].m[row];
+                    }
+                    rows[lane] = Lanes::LoadQuads(sources);
+                }
+                Lanes::Transpose4(rows[0], rows[1], rows[2], rows[3]);
+                for (uint32_t column = 0; column < 4; column++) {
+                    elements[row * 4 + column] = rows[column];
+                }
+            }
+        }
+
+        template <typename Lanes>
+        void StoreMatrixElements(Float4x4* matrices, const typename Lanes::Float elements[16]) {
+            constexpr uint32_t QUADS = Lanes::WIDTH / 4;
+            for (uint32_t row = 0; row < 4; row++) {
+                typename Lanes::Float rows[4] = {
+                    elements[row * 4 + 0], elements[row * 4 + 1], elements[row * 4 + 2], elements[row * 4 + 3]
+                };
+                Lanes::Transpose4(rows[0], rows[1], rows[2], rows[3]);
+                for (uint32_t lane = 0; lane < 4; lane++) {
+                    float* destinations[QUADS];
+                    for (uint32_t quad = 0; quad < QUADS; quad++) {
+                        destinations[quad] = matrices[quad * 4 + lane].m[row];
+                    }
+                    Lanes::StoreQuads(destinations, rows[lane]);
+                }
+            }
+        }
+
+        // Cada cuarteto de carriles lleva una matriz: se multiplican y trasponen WIDTH / 4 a la vez
+        template <typename Lanes>
+        void MultiplyTransposeBody(const Float4x4* left, uint32_t leftStride, const uint32_t* indices,
+            const Float4x4* right, Float4x4* output, uint32_t outputStride, uint32_t count) {
+            using Float = typename Lanes::Float;
+            constexpr uint32_t QUADS = Lanes::WIDTH / 4;
+            const char* leftBytes = reinterpret_cast<const char*>(left);
+            char* outputBytes = reinterpret_cast<char*>(output);
+            Float rightRows[4];
+            if (right) {
+                for (uint32_t row = 0; row < 4; row++) {
+                    rightRows[row] = Lanes::BroadcastQuad(right->m[row]);
+                }
+            }
+
+            const uint32_t vectorEnd = count - count % QUADS;
+            for (uint32_t i = 0; i < vectorEnd; i += QUADS) {
+                const Float4x4* sources[QUADS];
+                Float4x4* destinations[QUADS];
+                for (uint32_t quad = 0; quad < QUADS; quad++) {
+                    const uint32_t source = indices ? indices[i + quad] : i + quad;
+                    sources[quad] = reinterpret_cast<const Float4x4*>(leftBytes + static_cast<size_t>(source) * leftStride);
+                    destinations[quad] = reinterpret_cast<Float4x4*>(outputBytes + static_cast<size_t>(i + quad) * outputStride);
+                }
+                Float rows[4];
+                for (uint32_t row = 0; row < 4; row++) {
+                    const float* rowSources[QUADS];
+                    for (uint32_t quad = 0; quad < QUADS; quad++) {
+                        rowSources[quad] = sources[quad]->m[row];
+                    }
+                    rows[row] = Lanes::LoadQuads(rowSources);
+                }
+                if (right) {
+                    for (uint32_t row = 0; row < 4; row++) {
+                        Float splats[4];
+                        Lanes::SplatQuadElements(rows[row], splats);
+                        rows[row] = Lanes::Add(Lanes::Add(Lanes::Add(
+                            Lanes::Mul(splats[0], rightRows[0]), Lanes::Mul(splats[1], rightRows[1])),
+                            Lanes::Mul(splats[2], rightRows[2])), Lanes::Mul(splats[3], rightRows[3]));
+                    }
+                }
+                Lanes::Transpose4(rows[0], rows[1], rows[2], rows[3]);
+                for (uint32_t row = 0; row < 4; row++) {
+                    float* rowDestinations[QUADS];
+                    for (uint32_t quad = 0; quad < QUADS; quad++) {
+                        rowDestinations[quad] = destinations[quad]->m[row];
+                    }
+                    Lanes::StoreQuads(rowDestinations, rows[row]);
+                }
+            }
+            MultiplyTransposeScalar(left, leftStride, indices, right, output, outputStride, vectorEnd, count);
+        }
+
+        template <typename Lanes>
+        void TransformPointsRange(const float* const input[3], const Float4x4& matrix, float* const output[3],
+            uint32_t begin, uint32_t end) {
+            using Float = typename Lanes::Float;
+            Float m[4][3];
+            for (uint32_t row = 0; row < 4; row++) {
+                for (uint32_t axis = 0; axis < 3; axis++) {
+                    m[row][axis] = Lanes::Splat(matrix.m[row][axis]);
+                }
+            }
+            for (uint32_t i = begin; i + Lanes::WIDTH <= end; i += Lanes::WIDTH) {
+                const Float x = Lanes::Load(input[0] + i);
+                const Float y = Lanes::Load(input[1] + i);
+                const Float z = Lanes::Load(input[2] + i);
+                for (uint32_t axis = 0; axis < 3; axis++) {
+                    Lanes::Store(output[axis] + i, Lanes::Add(Lanes::Add(Lanes::Add(
+                        Lanes::Mul(x, m[0][axis]), Lanes::Mul(y, m[1][axis])), Lanes::Mul(z, m[2][axis])), m[3][axis]));
+                }
+            }
+        }
+
+        template <typename Lanes>
+        void TransformPointsBody(const float* const input[3], const Float4x4& matrix, float* const output[3], uint32_t count) {
+            const uint32_t vectorEnd = count - count % Lanes::WIDTH;
+            TransformPointsRange<Lanes>(input, matrix, output, 0, vectorEnd);
+            TransformPointsRange<ScalarLanes>(input, matrix, output, vectorEnd, count);
+        }
+
+        template <typename Lanes>
+        void ProjectPointsRange(const float* const input[3], const Float4x4& matrix, float* const output[4],
+            uint32_t begin, uint32_t end) {
+            using Float = typename Lanes::Float;
+            Float m[4][4];
+            for (uint32_t row = 0; row < 4; row++) {
+                for (uint32_t column = 0; column < 4; column++) {
+                    m[row][column] = Lanes::Splat(matrix.m[row][column]);
+                }
+            }
+            for (uint32_t i = begin; i + Lanes::WIDTH <= end; i += Lanes::WIDTH) {
+                const Float x = Lanes::Load(input[0] + i);
+                const Float y = Lanes::Load(input[1] + i);
+                const Float z = Lanes::Load(input[2] + i);
+                for (uint32_t column = 0; column < 4; column++) {
+                    Lanes::Store(output[column] + i, Lanes::Add(Lanes::Add(Lanes::Add(
+                        Lanes::Mul(x, m[0][column]), Lanes::Mul(y, m[1][column])), Lanes::Mul(z, m[2][column])), m[3][column]));
+                }
+            }
+        }
+
+        template <typename Lanes>
+        void ProjectPointsBody(const float* const input[3], const Float4x4& matrix, float* const output[4], uint32_t count) {
+            const uint32_t vectorEnd = count - count % Lanes::WIDTH;
+            ProjectPointsRange<Lanes>(input, matrix, output, 0, vectorEnd);
+            ProjectPointsRange<ScalarLanes>(input, matrix, output, vectorEnd, count);
+        }
+
+        // Centro: como un punto. Semiextensión: cada eje de mundo suma |fila| * extensión
+        template <typename Lanes>
+        void TransformBoundsRange(const float* const centers[3], const float* const extents[3], const Float4x4& matrix,
+            float* const outCenters[3], float* const outExtents[3], uint32_t begin, uint32_t end) {
+            using Float = typename Lanes::Float;
+            Float m[4][3];
+            Float absolute[3][3];
+            for (uint32_t row = 0; row < 4; row++) {
+                for (uint32_t axis = 0; axis < 3; axis++) {
+                    m[row][axis] = Lanes::Splat(matrix.m[row][axis]);
+                    if (row < 3) {
+                        absolute[row][axis] = Lanes::Splat(AbsScalar(matrix.m[row][axis]));
+                    }
+                }
+            }
+            for (uint32_t i = begin; i + Lanes::WIDTH <= end; i += Lanes::WIDTH) {
+                const Float cx = Lanes::Load(centers[0] + i);
+                const Float cy = Lanes::Load(centers[1] + i);
+                const Float cz = Lanes::Load(centers[2] + i);
+                const Float ex = Lanes::Load(extents[0] + i);
+                const Float ey = Lanes::Load(extents[1] + i);
+                const Float ez = Lanes::Load(extents[2] + i);
+                for (uint32_t axis = 0; axis < 3; axis++) {
+                    Lanes::Store(outCenters[axis] + i, Lanes::Add(Lanes::Add(Lanes::Add(
+                        Lanes::Mul(cx, m[0][axis]), Lanes::Mul(cy, m[1][axis])), Lanes::Mul(cz, m[2][axis])), m[3][axis]));
+                    Lanes::Store(outExtents[axis] + i, Lanes::Add(Lanes::Add(
+                        Lanes::Mul(ex, absolute[0][axis]), Lanes::Mul(ey, absolute[1][axis])), Lanes::Mul(ez, absolute[2][axis])));
+                }
+            }
+        }
+
+        template <typename Lanes>
+        void TransformBoundsBody(const float* const centers[3], const float* const extents[3], const Float4x4& matrix,
+            float* const outCenters[3], float* const outExtents[3], uint32_t count) {
+            const uint32_t vectorEnd = count - count % Lanes::WIDTH;
+            TransformBoundsRange<Lanes>(centers, extents, matrix, outCenters, outExtents, 0, vectorEnd);
+            TransformBoundsRange<ScalarLanes>(centers, extents, matrix, outCenters, outExtents, vectorEnd, count);
+        }
+
+        void TransformBoundsPerItemScalar(const float* const centers[3], const float* const extents[3],
+            const Float4x4* matrices, float* const outCenters[3], float* const outExtents[3], uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                const Float4x4& matrix = matrices[i];
+                const float cx = centers[0][i], cy = centers[1][i], cz = centers[2][i];
+                const float ex = extents[0][i], ey = extents[1][i], ez = extents[2][i];
+                for (uint32_t axis = 0; axis < 3; axis++) {
+                    outCenters[axis][i] = cx * matrix.m[0][axis] + cy * matrix.m[1][axis] + cz * matrix.m[2][axis] + matrix.m[3][axis];
+                    outExtents[axis][i] = ex * AbsScalar(matrix.m[0][axis]) + ey * AbsScalar(matrix.m[1][axis]) +
+                                          ez * AbsScalar(matrix.m[2][axis]);
+                }
+            }
+        }
+
+        template <typename Lanes>
+        void TransformBoundsPerItemBody(const float* const centers[3], const float* const extents[3],
+            const Float4x4* matrices, float* const outCenters[3], float* const outExtents[3], uint32_t count) {
+            using Float = typename Lanes::Float;
+            const uint32_t vectorEnd = count - count % Lanes::WIDTH;
+            for (uint32_t i = 0; i < vectorEnd; i += Lanes::WIDTH) {
+                Float m[16];
+                LoadMatrixElements<Lanes>(matrices + i, m);
+                const Float cx = Lanes::Load(centers[0] + i);
+                const Float cy = Lanes::Load(centers[1] + i);
+                const Float cz = Lanes::Load(centers[2] + i);
+                const Float ex = Lanes::Load(extents[0] + i);
+                const Float ey = Lanes::Load(extents[1] + i);
+                const Float ez = Lanes::Load(extents[2] + i);
+                for (uint32_t axis = 0; axis < 3; axis++) {
+                    Lanes::Store(outCenters[axis] + i, Lanes::Add(Lanes::Add(Lanes::Add(
+                        Lanes::Mul(cx, m[axis]), Lanes::Mul(cy, m[4 + axis])), Lanes::Mul(cz, m[8 + axis])), m[12 + axis]));
+                    Lanes::Store(outExtents[axis] + i, Lanes::Add(Lanes::Add(
+                        Lanes::Mul(ex, Lanes::Abs(m[axis])), Lanes::Mul(ey, Lanes::Abs(m[4 + axis]))),
+                        Lanes::Mul(ez, Lanes::Abs(m[8 + axis]))));
+                }
+            }
+            TransformBoundsPerItemScalar(centers, extents, matrices, outCenters, outExtents, vectorEnd, count);
+        }
+
+        // Las mismas expresiones que la versión escalar de TransformHierarchy: mismo resultado bit a bit
+        template <typename Lanes>
+        void ComposeElements(const float* const positions[3], const float* const rotations[4], const float* const scales[3],
+            uint32_t i, typename Lanes::Float m[16]) {
+            using Float = typename Lanes::Float;
+            const Float one = Lanes::Splat(1.0f);
+            const Float two = Lanes::Splat(2.0f);
+            const Float zero = Lanes::Splat(0.0f);
+            const Float x = Lanes::Load(rotations[0] + i);
+            const Float y = Lanes::Load(rotations[1] + i);
+            const Float z = Lanes::Load(rotations[2] + i);
+            const Float w = Lanes::Load(rotations[3] + i);
+            const Float scaleX = Lanes::Load(scales[0] + i);
+            const Float scaleY = Lanes::Load(scales[1] + i);
+            const Float scaleZ = Lanes::Load(scales[2] + i);
+            m[0] = Lanes::Mul(Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(Lanes::Mul(y, y), Lanes::Mul(z, z)))), scaleX);
+            m[1] = Lanes::Mul(Lanes::Mul(two, Lanes::Add(Lanes::Mul(x, y), Lanes::Mul(z, w))), scaleX);
+            m[2] = Lanes::Mul(Lanes::Mul(two, Lanes::Sub(Lanes::Mul(x, z), Lanes::Mul(y, w))), scaleX);
+            m[3] = zero;
+            m[4] = Lanes::Mul(Lanes::Mul(two, Lanes::Sub(Lanes::Mul(x, y), Lanes::Mul(z, w))), scaleY);
+            m[5] = Lanes::Mul(Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(Lanes::Mul(x, x), Lanes::Mul(z, z)))), scaleY);
+            m[6] = Lanes::Mul(Lanes::Mul(two, Lanes::Add(Lanes::Mul(y, z), Lanes::Mul(x, w))), scaleY);
+            m[7] = zero;
+            m[8] = Lanes::Mul(Lanes::Mul(two, Lanes::Add(Lanes::Mul(x, z), Lanes::Mul(y, w))), scaleZ);
+            m[9] = Lanes::Mul(Lanes::Mul(two, Lanes::Sub(Lanes::Mul(y, z), Lanes::Mul(x, w))), scaleZ);
+            m[10] = Lanes::Mul(Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(Lanes::Mul(x, x), Lanes::Mul(y, y)))), scaleZ);
+            m[11] = zero;
+            m[12] = Lanes::Load(positions[0] + i);
+            m[13] = Lanes::Load(positions[1] + i);
+            m[14] = Lanes::Load(positions[2] + i);
+            m[15] = one;
+        }
+
+        void ComposeTransformsScalar(const float* const positions[3], const float* const rotations[4],
+            const float* const scales[3], Float4x4* output, uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                float m[16];
+                ComposeElements<ScalarLanes>(positions, rotations, scales, i, m);
+                std::memcpy(output[i].m, m, sizeof(m));
+            }
+        }
+
+        template <typename Lanes>
+        void ComposeTransformsBody(const float* const positions[3], const float* const rotations[4],
+            const float* const scales[3], Float4x4* output, uint32_t count) {
+            const uint32_t vectorEnd = count - count % Lanes::WIDTH;
+            for (uint32_t i = 0; i < vectorEnd; i += Lanes::WIDTH) {
+                typename Lanes::Float m[16];
+                ComposeElements<Lanes>(positions, rotations, scales, i, m);
+                StoreMatrixElements<Lanes>(output + i, m);
+            }
+            ComposeTransformsScalar(positions, rotations, scales, output, vectorEnd, count);
+        }
+
+        // Una caja está fuera de un plano si hasta su esquina más adentrada (centro + |n|·extensión)
+        // queda por detrás. El último grupo se lee entero y se recorta con la máscara
+        template <typename Lanes>
+        uint32_t CullBoundsBody(const float (*planes)[4], uint32_t planeCount, const float* const centers[3],
+            const float* const extents[3], uint32_t begin, uint32_t end, const uint32_t* indexMap, uint32_t* output) {
+            using Float = typename Lanes::Float;
+            Float normalX[KERNEL_PLANE_COUNT], normalY[KERNEL_PLANE_COUNT], normalZ[KERNEL_PLANE_COUNT], offset[KERNEL_PLANE_COUNT];
+            Float absoluteX[KERNEL_PLANE_COUNT], absoluteY[KERNEL_PLANE_COUNT], absoluteZ[KERNEL_PLANE_COUNT];
+            for (uint32_t p = 0; p < planeCount; p++) {
+                normalX[p] = Lanes::Splat(planes[p][0]);
+                normalY[p] = Lanes::Splat(planes[p][1]);
+                normalZ[p] = Lanes::Splat(planes[p][2]);
+                offset[p] = Lanes::Splat(planes[p][3]);
+                absoluteX[p] = Lanes::Splat(AbsScalar(planes[p][0]));
+                absoluteY[p] = Lanes::Splat(AbsScalar(planes[p][1]));
+                absoluteZ[p] = Lanes::Splat(AbsScalar(planes[p][2]));
+            }
+
+            constexpr uint32_t FULL_MASK = static_cast<uint32_t>((uint64_t(1) << Lanes::WIDTH) - 1);
+            uint32_t visible = 0;
+            for (uint32_t i = begin; i < end; i += Lanes::WIDTH) {
+                const Float cx = Lanes::Load(centers[0] + i);
+                const Float cy = Lanes::Load(centers[1] + i);
+                const Float cz = Lanes::Load(centers[2] + i);
+                const Float ex = Lanes::Load(extents[0] + i);
+                const Float ey = Lanes::Load(extents[1] + i);
+                const Float ez = Lanes::Load(extents[2] + i);
+                uint32_t mask = end - i >= Lanes::WIDTH ? FULL_MASK : (1u << (end - i)) - 1;
+                for (uint32_t p = 0; p < planeCount && mask != 0; p++) {
+                    const Float distance = Lanes::Add(Lanes::Add(Lanes::Add(
+                        Lanes::Mul(normalX[p], cx), Lanes::Mul(normalY[p], cy)), Lanes::Mul(normalZ[p], cz)), offset[p]);
+                    const Float radius = Lanes::Add(Lanes::Add(
+                        Lanes::Mul(absoluteX[p], ex), Lanes::Mul(absoluteY[p], ey)), Lanes::Mul(absoluteZ[p], ez));
+                    mask &= Lanes::NonNegative(Lanes::Add(distance, radius));
+                }
+                while (mask != 0) {
+                    const uint32_t lane = LowestBit(mask);
+                    output[visible++] = indexMap ? indexMap[i + lane] : i + lane;
+                    mask &= mask - 1;
+                }
+            }
+            return visible;
+        }
+
+        constexpr float SNORM16_MAX = 32767.0f;
+        constexpr float UNORM8_MAX = 255.0f;
+        // 1.5 * 2^23: sumarlo y restarlo redondea al entero par más cercano (|x| < 2^22), como
+        // las conversiones de float a entero de SSE/AVX con el modo de redondeo por defecto
+        constexpr float ROUND_MAGIC = 12582912.0f;
+
+        // Mismo resultado que minps/maxps (incluido qué operando gana con NaN)
+        float MinScalar(float a, float b) { return a < b ? a : b; }
+        float MaxScalar(float a, float b) { return a > b ? a : b; }
+        int32_t RoundScalar(float value) { return static_cast<int32_t>((value + ROUND_MAGIC) - ROUND_MAGIC); }
+
+        void EncodeSnorm16Scalar(const float* input, uint32_t inputStride, const float bias[3], const float invScale[3],
+            int16_t* output, uint32_t outputStride, uint32_t begin, uint32_t end) {
+            const char* inputBytes = reinterpret_cast<const char*>(input);
+            char* outputBytes = reinterpret_cast<char*>(output);
+            for (uint32_t i = begin; i < end; i++) {
+                const float* source = reinterpret_cast<const float*>(inputBytes + static_cast<size_t>(i) * inputStride);
+                int16_t* destination = reinterpret_cast<int16_t*>(outputBytes + static_cast<size_t>(i) * outputStride);
+                for (uint32_t axis = 0; axis < 3; axis++) {
+                    const float normalized = MaxScalar(MinScalar((source[axis] - bias[axis]) * invScale[axis], 1.0f), -1.0f);
+                    destination[axis] = static_cast<int16_t>(RoundScalar(normalized * SNORM16_MAX));
+                }
+                destination[3] = 0;
+            }
+        }
+
+        void DecodeSnorm16Scalar(const int16_t* input, uint32_t inputStride, const float scale[3], const float bias[3],
+            float* output, uint32_t outputStride, uint32_t begin, uint32_t end) {
+            const char* inputBytes = reinterpret_cast<const char*>(input);
+            char* outputBytes = reinterpret_cast<char*>(output);
+            for (uint32_t i = begin; i < end; i++) {
+                const int16_t* source = reinterpret_cast<const int16_t*>(inputBytes + static_cast<size_t>(i) * inputStride);
+                float* destination = reinterpret_cast<float*>(outputBytes + static_cast<size_t>(i) * outputStride);
+                for (uint32_t axis = 0; axis < 3; axis++) {
+                    destination[axis] = static_cast<float>(source[axis]) * (1.0f / SNORM16_MAX) * scale[axis] + bias[axis];
+                }
+                destination[3] = 0.0f;
+            }
+        }
+
+        void EncodeUnorm8Scalar(const float* input, uint32_t inputStride, uint8_t* output, uint32_t outputStride,
+            uint32_t begin, uint32_t end) {
+            const char* inputBytes = reinterpret_cast<const char*>(input);
+            char* outputBytes = reinterpret_cast<char*>(output);
+            for (uint32_t i = begin; i < end; i++) {
+                const float* source = reinterpret_cast<const float*>(inputBytes + static_cast<size_t>(i) * inputStride);
+                uint8_t* destination = reinterpret_cast<uint8_t*>(outputBytes + static_cast<size_t>(i) * outputStride);
+                for (uint32_t channel = 0; channel < 3; channel++) {
+                    const float saturated = MaxScalar(MinScalar(source[channel], 1.0f), 0.0f);
+                    destination[channel] = static_cast<uint8_t>(RoundScalar(saturated * UNORM8_MAX));
+                }
+                destination[3] = 255;
+            }
+        }
+
+        void DecodeUnorm8Scalar(const uint8_t* input, uint32_t inputStride, float* output, uint32_t outputStride,
+            uint32_t begin, uint32_t end) {
+            char* outputBytes = reinterpret_cast<char*>(output);
+            for (uint32_t i = begin; i < end; i++) {
+                const uint8_t* source = input + static_cast<size_t>(i) * inputStride;
+                float* destination = reinterpret_cast<float*>(outputBytes + static_cast<size_t>(i) * outputStride);
+                for (uint32_t channel = 0; channel < 4; channel++) {
+                    destination[channel] = static_cast<float>(source[channel]) * (1.0f / UNORM8_MAX);
+                }
+            }
+        }
+
+        // Un vértice por cuarteto de carriles. Las codificaciones dejan el último vértice al camino
+        // escalar: su cuarto float puede caer fuera del array
+        template <typename Lanes>
+        void EncodeSnorm16Body(const float* input, uint32_t inputStride, const float bias[3], const float invScale[3],
+            int16_t* output, uint32_t outputStride, uint32_t count) {
+            using Float = typename Lanes::Float;
+            constexpr uint32_t QUADS = Lanes::WIDTH / 4;
+            const float biasQuad[4] = { bias[0], bias[1], bias[2], 0.0f };
+            const float scaleQuad[4] = { invScale[0], invScale[1], invScale[2], 0.0f };
+            const Float biasVector = Lanes::BroadcastQuad(biasQuad);
+            const Float scaleVector = Lanes::BroadcastQuad(scaleQuad);
+            const Float one = Lanes::Splat(1.0f);
+            const Float minusOne = Lanes::Splat(-1.0f);
+            const Float maximum = Lanes::Splat(SNORM16_MAX);
+            const Float zero = Lanes::Splat(0.0f);
+            const char* inputBytes = reinterpret_cast<const char*>(input);
+            char* outputBytes = reinterpret_cast<char*>(output);
+
+            const uint32_t vectorCount = count > 0 ? count - 1 : 0;
+            const uint32_t vectorEnd = vectorCount - vectorCount % QUADS;
+            for (uint32_t i = 0; i < vectorEnd; i += QUADS) {
+                const float* sources[QUADS];
+                int16_t* destinations[QUADS];
+                for (uint32_t quad = 0; quad < QUADS; quad++) {
+                    sources[quad] = reinterpret_cast<const float*>(inputBytes + static_cast<size_t>(i + quad) * inputStride);
+                    destinations[quad] = reinterpret_cast<int16_t*>(outputBytes + static_cast<size_t>(i + quad) * outputStride);
+                }
+                const Float normalized = Lanes::Max(Lanes::Min(
+                    Lanes::Mul(Lanes::Sub(Lanes::LoadQuads(sources), biasVector), scaleVector), one), minusOne);
+                Lanes::StoreSnorm16Quads(destinations, Lanes::SetQuadW(Lanes::Mul(normalized, maximum), zero));
+            }
+            EncodeSnorm16Scalar(input, inputStride, bias, invScale, output, outputStride, vectorEnd, count);
+        }
+
+        template <typename Lanes>
+        void DecodeSnorm16Body(const int16_t* input, uint32_t inputStride, const float scale[3], const float bias[3],
+            float* output, uint32_t outputStride, uint32_t count) {
+            using Float = typename Lanes::Float;
+            constexpr uint32_t QUADS = Lanes::WIDTH / 4;
+            const float scaleQuad[4] = { scale[0], scale[1], scale[2], 0.0f };
+            const float biasQuad[4] = { bias[0], bias[1], bias[2], 0.0f };
+            const Float scaleVector = Lanes::BroadcastQuad(scaleQuad);
+            const Float biasVector = Lanes::BroadcastQuad(biasQuad);
+            const Float inverseMaximum = Lanes::Splat(1.0f / SNORM16_MAX);
+            const char* inputBytes = reinterpret_cast<const char*>(input);
+            char* outputBytes = reinterpret_cast<char*>(output);
+
+            const uint32_t vectorEnd = count - count % QUADS;
+            for (uint32_t i = 0; i < vectorEnd; i += QUADS) {
+                const int16_t* sources[QUADS];
+                float* destinations[QUADS];
+                for (uint32_t quad = 0; quad < QUADS; quad++) {
+                    sources[quad] = reinterpret_cast<const int16_t*>(inputBytes + static_cast<size_t>(i + quad) * inputStride);
+                    destinations[quad] = reinterpret_cast<float*>(outputBytes + static_cast<size_t>(i + quad) * outputStride);
+                }
+                const Float normalized = Lanes::Mul(Lanes::LoadSnorm16Quads(sources), inverseMaximum);
+                Lanes::StoreQuads(destinations, Lanes::Add(Lanes::Mul(normalized, scaleVector), biasVector));
+            }
+            DecodeSnorm16Scalar(input, inputStride, scale, bias, output, outputStride, vectorEnd, count);
+        }
+
+        template <typename Lanes>
+        void EncodeUnorm8Body(const float* input, uint32_t inputStride, uint8_t* output, uint32_t outputStride, uint32_t count) {
+            using Float = typename Lanes::Float;
+            constexpr uint32_t QUADS = Lanes::WIDTH / 4;
+            const Float one = Lanes::Splat(1.0f);
+            const Float zero = Lanes::Splat(0.0f);
+            const Float maximum = Lanes::Splat(UNORM8_MAX);
+            const char* inputBytes = reinterpret_cast<const char*>(input);
+
+            const uint32_t vectorCount = count > 0 ? count - 1 : 0;
+            const uint32_t vectorEnd = vectorCount - vectorCount % QUADS;
+            for (uint32_t i = 0; i < vectorEnd; i += QUADS) {
+                const float* sources[QUADS];
+                uint8_t* destinations[QUADS];
+                for (uint32_t quad = 0; quad < QUADS; quad++) {
+                    sources[quad] = reinterpret_cast<const float*>(inputBytes + static_cast<size_t>(i + quad) * inputStride);
+                    destinations[quad] = output + static_cast<size_t>(i + quad) * outputStride;
+                }
+                const Float color = Lanes::SetQuadW(Lanes::LoadQuads(sources), one);
+                Lanes::StoreUnorm8Quads(destinations, Lanes::Mul(Lanes::Max(Lanes::Min(color, one), zero), maximum));
+            }
+            EncodeUnorm8Scalar(input, inputStride, output, outputStride, vectorEnd, count);
+        }
+
+        template <typename Lanes>
+        void DecodeUnorm8Body(const uint8_t* input, uint32_t inputStride, float* output, uint32_t outputStride, uint32_t count) {
+            using Float = typename Lanes::Float;
+            constexpr uint32_t QUADS = Lanes::WIDTH / 4;
+            const Float inverseMaximum = Lanes::Splat(1.0f / UNORM8_MAX);
+            char* outputBytes = reinterpret_cast<char*>(output);
+
+            const uint32_t vectorEnd = count - count % QUADS;
+            for (uint32_t i = 0; i < vectorEnd; i += QUADS) {
+                const uint8_t* sources[QUADS];
+                float* destinations[QUADS];
+                for (uint32_t quad = 0; quad < QUADS; quad++) {
+                    sources[quad] = input + static_cast<size_t>(i + quad) * inputStride;
+                    destinations[quad] = reinterpret_cast<float*>(outputBytes + static_cast<size_t>(i + quad) * outputStride);
+                }
+                Lanes::StoreQuads(destinations, Lanes::Mul(Lanes::LoadUnorm8Quads(sources), inverseMaximum));
+            }
+            DecodeUnorm8Scalar(input, inputStride, output, outputStride, vectorEnd, count);
+        }
+
+        // Tabla con todos los cuerpos instanciados para Lanes. Las operaciones AoS (matrices y
+        // vértices) trabajan por cuartetos de carriles: el nivel escalar usa directamente sus versiones escalares
+        template <typename Lanes>
+        constexpr SimdKernelTable MakeKernelTable(SimdLevel level) {
+            SimdKernelTable table;
+            table.level = level;
+            table.width = Lanes::WIDTH;
+            if constexpr (Lanes::WIDTH >= 4) {
+                table.multiplyTranspose = MultiplyTransposeBody<Lanes>;
+                table.transformBoundsPerItem = TransformBoundsPerItemBody<Lanes>;
+                table.composeTransforms = ComposeTransformsBody<Lanes>;
+                table.encodeSnorm16 = EncodeSnorm16Body<Lanes>;
+                table.decodeSnorm16 = DecodeSnorm16Body<Lanes>;
+                table.encodeUnorm8 = EncodeUnorm8Body<Lanes>;
+                table.decodeUnorm8 = DecodeUnorm8Body<Lanes>;
+            }
+            else {
+                table.multiplyTranspose = [](const Float4x4* left, uint32_t leftStride, const uint32_t* indices,
+                    const Float4x4* right, Float4x4* output, uint32_t outputStride, uint32_t count) {
+                    MultiplyTransposeScalar(left, leftStride, indices, right, output, outputStride, 0, count);
+                };
+                table.transformBoundsPerItem = [](const float* const centers[3], const float* const extents[3],
+                    const Float4x4* matrices, float* const outCenters[3], float* const outExtents[3], uint32_t count) {
+                    TransformBoundsPerItemScalar(centers, extents, matrices, outCenters, outExtents, 0, count);
+                };
+                table.composeTransforms = [](const float* const positions[3], const float* const rotations[4],
+                    const float* const scales[3], Float4x4* output, uint32_t count) {
+                    ComposeTransformsScalar(positions, rotations, scales, output, 0, count);
+                };
+                table.encodeSnorm16 = [](const float* input, uint32_t inputStride, const float bias[3], const float invScale[3],
+                    int16_t* output, uint32_t outputStride, uint32_t count) {
+                    EncodeSnorm16Scalar(input, inputStride, bias, invScale, output, outputStride, 0, count);
+                };
+                table.decodeSnorm16 = [](const int16_t* input, uint32_t inputStride, const float scale[3], const float bias[3],
+                    float* output, uint32_t outputStride, uint32_t count) {
+                    DecodeSnorm16Scalar(input, inputStride, scale, bias, output, outputStride, 0, count);
+                };
+                table.encodeUnorm8 = [](const float* input, uint32_t inputStride, uint8_t* output, uint32_t outputStride,
+                    uint32_t count) {
+                    EncodeUnorm8Scalar(input, inputStride, output, outputStride, 0, count);
+                };
+                table.decodeUnorm8 = [](const uint8_t* input, uint32_t inputStride, float* output, uint32_t outputStride,
+                    uint32_t count) {
+                    DecodeUnorm8Scalar(input, inputStride, output, outputStride, 0, count);
+                };
+            }
+            table.transformPoints = TransformPointsBody<Lanes>;
+            table.projectPoints = ProjectPointsBody<Lanes>;
+            table.transformBounds = TransformBoundsBody<Lanes>;
+            table.cullBounds = CullBoundsBody<Lanes>;
+            return table;
+        }
+
+    } // namespace
+
+} // namespace D3D12Core
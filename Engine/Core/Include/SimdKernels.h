@@ -0,0 +1,56 @@
+#pragma once
+
+#include "BatchMath.h"
+#include <cstdint>
+
+namespace D3D12Core {
+
+    // Tabla de kernels de un nivel SIMD. Cada nivel vive en su propia unidad de traducción,
+    // compilada con los flags de su juego de instrucciones (ver CMakeLists.txt); el resto del
+    // engine se compila para la base de x64 y solo llama a través de la tabla activa
+    struct SimdKernelTable {
+        SimdLevel level = SimdLevel::Scalar;
+        uint32_t width = 1;
+
+        void (*multiplyTranspose)(const Float4x4* left, uint32_t leftStride, const uint32_t* indices,
+            const Float4x4* right, Float4x4* output, uint32_t outputStride, uint32_t count) = nullptr;
+        void (*transformPoints)(const float* const input[3], const Float4x4& matrix, float* const output[3],
+            uint32_t count) = nullptr;
+        void (*projectPoints)(const float* const input[3], const Float4x4& matrix, float* const output[4],
+            uint32_t count) = nullptr;
+        void (*transformBounds)(const float* const centers[3], const float* const extents[3], const Float4x4& matrix,
+            float* const outCenters[3], float* const outExtents[3], uint32_t count) = nullptr;
+        void (*transformBoundsPerItem)(const float* const centers[3], const float* const extents[3],
+            const Float4x4* matrices, float* const outCenters[3], float* const outExtents[3], uint32_t count) = nullptr;
+        void (*composeTransforms)(const float* const positions[3], const float* const rotations[4],
+            const float* const scales[3], Float4x4* output, uint32_t count) = nullptr;
+
+        // Prueba las cajas SoA [begin, end) contra planeCount planos (normal hacia dentro, d) y
+        // escribe los índices visibles (indexMap[i] o i) en output. Devuelve cuántos escribió.
+        // Lee grupos enteros: el almacenamiento debe estar rellenado como en CullingBounds
+        uint32_t (*cullBounds)(const float (*planes)[4], uint32_t planeCount, const float* const centers[3],
+            const float* const extents[3], uint32_t begin, uint32_t end, const uint32_t* indexMap,
+            uint32_t* output) = nullptr;
+
+        // Atributos de vértices (ver BatchMath::EncodeSnorm16 y compañía)
+        void (*encodeSnorm16)(const float* input, uint32_t inputStride, const float bias[3], const float invScale[3],
+            int16_t* output, uint32_t outputStride, uint32_t count) = nullptr;
+        void (*decodeSnorm16)(const int16_t* input, uint32_t inputStride, const float scale[3], const float bias[3],
+            float* output, uint32_t outputStride, uint32_t count) = nullptr;
+        void (*encodeUnorm8)(const float* input, uint32_t inputStride, uint8_t* output, uint32_t outputStride,
+            uint32_t count) = nullptr;
+        void (*decodeUnorm8)(const uint8_t* input, uint32_t inputStride, float* output, uint32_t outputStride,
+            uint32_t count) = nullptr;
+    };
+
+    // Tablas compiladas en este binario (nullptr si el compilador o la arquitectura no tienen el
+    // nivel). Que exista la tabla no implica que la CPU lo soporte
+    const SimdKernelTable* GetScalarKernels();
+    const SimdKernelTable* GetSse42Kernels();
+    const SimdKernelTable* GetAvx2Kernels();
+    const SimdKernelTable* GetAvx512Kernels();
+
+    // Tabla del nivel activo (ver SetSimdLevel)
+    const SimdKernelTable& GetSimdKernels();
+
+} // namespace D3D12Core
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "RHI.h"
+#include "SoftwareRasterizer.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace D3D12Core {
+
+    // RHI que dibuja de verdad en CPU con SoftwareRasterizer: frames reales en servidores
+    // Linux sin GPU (imágenes de referencia) y una referencia con la que comparar la salida
+    // de la GPU. Solo implementa BasicVS/BasicPS (vértices de cualquier VertexFormat +
+    // MVPConstantBuffer) y sus variantes instanciada InstancedVS e indirecta IndirectVS;
+    // el bytecode de los shaders se ignora. Las direcciones de GPU son punteros de CPU
+
+    class SoftwareRHIDevice;
+    struct IndirectObjectData;
+
+    class SoftwareRHIBuffer : public IRHIBuffer {
+    public:
+        SoftwareRHIBuffer(const RHIBufferDesc& desc, const void* initialData);
+
+        const RHIBufferDesc& GetDesc() const override { return m_desc; }
+        uint64_t GetGpuAddress() const override { return reinterpret_cast<uint64_t>(m_data.data()); }
+
+        const uint8_t* GetData() const { return m_data.data(); }
+
+    private:
+        RHIBufferDesc m_desc;
+        std::vector<uint8_t> m_data;
+    };
+
+    class SoftwareRHIPipeline : public IRHIPipeline {
+    public:
+        explicit SoftwareRHIPipeline(const RHIPipelineDesc& desc) : m_desc(desc) {}
+
+        const RHIPipelineDesc& GetDesc() const override { return m_desc; }
+
+    private:
+        RHIPipelineDesc m_desc;
+    };
+
+    // Graba operaciones ya resueltas (destino, clear o draw con punteros a los datos); el estado
+    // que falte o los rangos fuera de los buffers se informan como errores y el draw se omite
+    class SoftwareRHICommandList : public IRHICommandList {
+    public:
+        enum class OperationType {
+            SetTarget,
+            Clear,
+            Draw,
+            DrawIndirect // drawCall con las constantes compartidas; cada comando aporta su objeto al ejecutarse
+        };
+
+        struct Operation {
+            OperationType type = OperationType::Draw;
+            uint64_t renderTargetView = 0;
+            float color[4] = {};
+            SoftwareDrawCall drawCall;
+            const RHIIndirectDrawCommand* arguments = nullptr;
+            uint32_t commandCount = 0;
+            const IndirectObjectData* objects = nullptr;
+            uint64_t objectCount = 0;     // Objetos del buffer enlazado (validación de los drawIndex)
+            uint64_t indexBufferSize = 0; // Índices del buffer enlazado (validación de los argumentos)
+        };
+
+        explicit SoftwareRHICommandList(SoftwareRHIDevice* device) : m_device(device) {}
+
+        void Begin() override;
+        void Close() override;
+
+        void SetRenderTarget(uint64_t renderTargetView) override;
+        void ClearRenderTarget(uint64_t renderTargetView, const float color[4]) override;
+        void SetViewport(const RHIViewport& viewport) override;
+        void SetScissor(const RHIRect& rect) override;
+        void SetPipeline(IRHIPipeline* pipeline) override;
+        void SetConstantBuffer(uint32_t rootParameter, uint64_t gpuAddress) override;
+        void SetVertexBuffer(IRHIBuffer* buffer, uint32_t stream = 0) override;
+        void SetIndexBuffer(IRHIBuffer* buffer, RHIFormat format) override;
+        void SetInstanceBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) override;
+        void SetObjectBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) override;
+        void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex, uint32_t startInstance) override;
+        void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override;
+        void ExecuteIndirect(uint64_t argumentAddress, uint32_t commandCount) override;
+
+        void* GetNativeCommandList() override { return nullptr; }
+
+        bool IsOpen() const { return m_open; }
+        const std::vector<Operation>& GetOperations() const { return m_operations; }
+
+    private:
+        bool CheckOpen(const char* call);
+        // indirect: ExecuteIndirect, el único draw que admite un pipeline indirect (el drawIndex
+        // llega en los argumentos)
+        bool CheckDrawState(const char* call, uint32_t instanceCount, uint32_t startInstance, bool indirect = false);
+        // Streams del formato del pipeline en m_state (false si falta alguno o su stride no es el del formato)
+        bool ResolveVertexStreams();
+
+        SoftwareRHIDevice* m_device;
+        bool m_open = false;
+        std::vector<Operation> m_operations;
+        uint64_t m_renderTarget = 0;
+        bool m_hasViewport = false;
+        bool m_hasScissor = false;
+        SoftwareDrawCall m_state; // Viewport, scissor, constantes y buffers enlazados
+        IRHIPipeline* m_pipeline = nullptr;
+        const SoftwareRHIBuffer* m_vertexBuffers[MAX_VERTEX_STREAMS] = {};
+        const SoftwareRHIBuffer* m_indexBuffer = nullptr;
+        uint64_t m_instanceCapacity = 0; // Instancias del stream enlazado (0 = ninguno)
+        const IndirectObjectData* m_objects = nullptr;
+        uint64_t m_objectCapacity = 0;   // Objetos del buffer de ExecuteIndirect enlazado (0 = ninguno)
+    };
+
+    // Ejecuta cada command list en el hilo que la envía (el rasterizador reparte el trabajo
+    // en sus hilos), así que al volver de ExecuteCommandList el trabajo ya está completado
+    class SoftwareRHICommandQueue : public IRHICommandQueue {
+    public:
+        explicit SoftwareRHICommandQueue(SoftwareRHIDevice* device) : m_device(device) {}
+
+        void ExecuteCommandList(IRHICommandList* commandList) override;
+
+        uint64_t Signal() override;
+        uint64_t GetCompletedValue() const override { return m_fenceValue.load(); }
+        void WaitForFenceValue(uint64_t fenceValue) override { (void)fenceValue; }
+
+    private:
+        // Lee los argumentos como lo haría la GPU: al ejecutar, no al grabar
+        void ExecuteIndirect(SoftwareRasterizer& rasterizer, const SoftwareRHICommandList::Operation& operation);
+
+        SoftwareRHIDevice* m_device;
+        std::mutex m_executeMutex;
+        // Constantes MVP de cada comando indirecto (compartidas + objeto), vivas hasta el Flush
+        // de la ejecución; deque: las direcciones no cambian al añadir
+        std::deque<SoftwareMVPConstants> m_indirectConstants;
+        std::atomic<uint64_t> m_fenceValue{ 0 };
+    };
+
+    class SoftwareRHIDevice : public IRHIDevice {
+    public:
+        SoftwareRHIDevice();
+        ~SoftwareRHIDevice() override;
+
+        // workerCount: hilos auxiliares del rasterizador (0 = hardware_concurrency - 1)
+        bool Initialize(uint32_t workerCount = 0);
+        void Shutdown();
+
+        const char* GetBackendName() const override { return "Software"; }
+        IRHICommandQueue* GetQueue() override { return &m_queue; }
+
+        std::unique_ptr<IRHIBuffer> CreateBuffer(const RHIBufferDesc& desc, const void* initialData = nullptr) override;
+        // Solo el pipeline BasicVS/BasicPS (o InstancedVS con instanceStride == sizeof(InstanceData)
+        // o IndirectVS con objectStride == sizeof(IndirectObjectData)):
+        // vertexStride == vertexFormat.GetStride(0) y constantes MVP
+        std::unique_ptr<IRHIPipeline> CreatePipeline(const RHIPipelineDesc& desc) override;
+        std::unique_ptr<IRHICommandList> CreateCommandList() override;
+        // Copia en bloques que se reciclan cuando la cola completa la señal siguiente a la
+        // asignación: los datos valen para las listas ejecutadas antes de esa señal
+        uint64_t AllocateConstants(const void* data, uint64_t size) override;
+
+        // Render targets en memoria (los back buffers del swap chain en las demás RHI)
+        uint64_t CreateRenderTarget(uint32_t width, uint32_t height);
+        // No debe haber trabajo en vuelo que use el render target
+        bool ResizeRenderTarget(uint64_t renderTargetView, uint32_t width, uint32_t height);
+        const SoftwareFramebuffer* GetRenderTarget(uint64_t renderTargetView) const;
+
+        void ReportError(const std::string& message);
+        uint64_t GetValidationErrors() const;
+        const SoftwareRasterizer& GetRasterizer() const { return m_rasterizer; }
+        std::string BuildReport() const;
+
+    private:
+        friend class SoftwareRHICommandQueue;
+
+        static constexpr uint64_t CONSTANT_ALIGNMENT = 256;
+        static constexpr uint64_t CONSTANT_BLOCK_SIZE = 64ull * 1024;
+        static constexpr uint64_t MAX_REPORTED_ERRORS = 16;
+
+        struct ConstantBlock {
+            std::unique_ptr<uint8_t[]> storage;
+            uint8_t* data = nullptr;       // Inicio alineado a CONSTANT_ALIGNMENT
+            uint64_t size = 0;
+            uint64_t offset = 0;
+            uint64_t fenceValue = 0;       // Señal que cubre la última asignación
+        };
+
+        SoftwareFramebuffer* FindRenderTarget(uint64_t renderTargetView);
+
+        SoftwareRHICommandQueue m_queue;
+        SoftwareRasterizer m_rasterizer;
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<SoftwareFramebuffer>> m_renderTargets;
+        std::vector<ConstantBlock> m_constantBlocks;
+        size_t m_currentConstantBlock = SIZE_MAX;
+        uint64_t m_commandListsExecuted = 0;
+        uint64_t m_validationErrors = 0;
+        bool m_initialized = false;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "InstanceBatcher.h"
+#include "JobSystem.h"
+#include "RHI.h"
+#include "RenderSnapshot.h"
+#include "Vertex.h"
+#include "VertexFormat.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Render target en memoria: RGBA8 con el mismo orden de bytes que R8G8B8A8_UNORM
+    // (R en el byte bajo de cada uint32_t). depth solo existe si se pide (D32, 1.0 = lejos)
+    struct SoftwareFramebuffer {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint32_t> color;
+        std::vector<float> depth;
+
+        void Resize(uint32_t newWidth, uint32_t newHeight, bool withDepth = false);
+        // Imagen PPM binaria (P6) para comparar contra imágenes de referencia
+        bool WritePPM(const std::string& path) const;
+    };
+
+    // Mismo contenido y disposición que MVPConstantBuffer (matrices traspuestas, como las
+    // lee el cbuffer de BasicVS.hlsl)
+    struct SoftwareMVPConstants {
+        Float4x4 model;
+        Float4x4 view;
+        Float4x4 projection;
+        float positionScale[4] = { 1.0f, 1.0f, 1.0f, 0.0f };
+        float positionBias[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    };
+
+    // Draw del pipeline BasicVS/BasicPS. Los punteros deben seguir vivos hasta Flush
+    //  - indices == nullptr: draw no indexado de vertexCount vértices desde startVertex
+    //  - indices != nullptr: indexCount índices desde startIndex, más baseVertex
+    //  - instances != nullptr: InstancedVS, instanceCount instancias desde startInstance (la
+    //    world de cada instancia sustituye a model y customData.rgb tiñe el color). Sin
+    //    instances el draw se dibuja una vez: BasicVS no lee SV_InstanceID
+    // vertexStreams/vertexBufferSize describen los vertex buffers completos (un stream por
+    // vertexFormat.GetStreamCount()): los índices fuera de rango descartan el triángulo en lugar
+    // de leer fuera del buffer. Las posiciones cuantizadas se decodifican con el positionScale y
+    // positionBias de las constantes, como BasicVS
+    struct SoftwareDrawCall {
+        VertexFormat vertexFormat;
+        const uint8_t* vertexStreams[MAX_VERTEX_STREAMS] = {};
+        uint32_t vertexBufferSize = 0;   // Vértices que caben en todos los streams
+        uint32_t vertexCount = 0;
+        uint32_t startVertex = 0;
+        const void* indices = nullptr;
+        RHIFormat indexFormat = RHIFormat::R32Uint;
+        uint32_t indexCount = 0;
+        uint32_t startIndex = 0;
+        int32_t baseVertex = 0;
+        uint32_t instanceCount = 1;
+        const InstanceData* instances = nullptr;
+        uint32_t startInstance = 0;
+        const SoftwareMVPConstants* constants = nullptr;
+        RHIViewport viewport;
+        RHIRect scissor;
+    };
+
+    struct SoftwareRasterizerStats {
+        uint64_t draws = 0;
+        uint64_t vertices = 0;          // Vértices transformados
+        uint64_t triangles = 0;         // Triángulos enviados
+        uint64_t trianglesClipped = 0;  // Recortados contra near/far o la guard band
+        uint64_t trianglesCulled = 0;   // Fuera del frustum, degenerados o sin píxeles
+        uint64_t trianglesSetup = 0;    // Llegan al binning (tras recorte)
+        uint64_t binEntries = 0;        // Pares triángulo-tile
+        uint64_t pixelsShaded = 0;
+        double vertexMs = 0.0;
+        double setupMs = 0.0;
+        double rasterMs = 0.0;
+    };
+
+    // Rasterizador por software con el pipeline de BasicVS.hlsl/BasicPS.hlsl:
+    // mul(mul(mul(float4(pos, 1), model), view), projection), recorte near/far (DepthClipEnable),
+    // sin culling (CULL_MODE_NONE), color interpolado con corrección de perspectiva y salida
+    // pow(saturate(color), 0.9) con alfa 1. Sin depth test por defecto, como el PSO del engine:
+    // gana el último triángulo enviado
+    //
+    // Funciona por lotes: los draws se acumulan y Flush los ejecuta en tres fases paralelas
+    // (JobSystem): transformación de vértices, setup + binning en tiles de TILE_SIZE píxeles y
+    // rasterización de cada tile en un solo hilo recorriendo sus triángulos en orden de envío,
+    // con funciones de arista evaluadas de 4 en 4 píxeles (SSE2 si está disponible). Las reglas
+    // de relleno top-left y el snapping a 1/256 de píxel hacen que las mallas sean estancas
+    class SoftwareRasterizer {
+    public:
+        static constexpr uint32_t TILE_SIZE = 64;
+        static constexpr uint32_t SUBPIXEL_STEPS = 256;
+
+        SoftwareRasterizer();
+        ~SoftwareRasterizer();
+
+        // workerCount como JobSystem::Initialize (0 = hardware_concurrency - 1)
+        bool Initialize(uint32_t workerCount = 0);
+        void Shutdown();
+
+        // Depth test LESS con escritura (requiere un framebuffer con depth)
+        void SetDepthTest(bool enabled) { m_depthTest = enabled; }
+
+        // Destino de los draws siguientes (ejecuta antes los pendientes del anterior)
+        void SetTarget(SoftwareFramebuffer* target);
+        // Limpia color (y depth a 1.0) de target tras ejecutar los draws pendientes; no cambia
+        // el destino de los draws
+        void Clear(SoftwareFramebuffer* target, const float color[4]);
+        void Draw(const SoftwareDrawCall& drawCall);
+        void Flush();
+
+        const SoftwareRasterizerStats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = SoftwareRasterizerStats(); }
+        std::string BuildReport() const;
+
+    private:
+        // Vértice tras el vertex shader (clip space)
+        struct ClipVertex {
+            float position[4];
+            float color[3];
+        };
+        struct SetupTriangle;
+        struct Chunk;
+
+        void TransformVertices();
+        void SetupTriangles();
+        void RasterizeTiles();
+        void RasterizeTile(uint32_t tileX, uint32_t tileY, uint64_t& pixelsShaded);
+
+        JobSystem m_jobs;
+        bool m_initialized = false;
+        bool m_depthTest = false;
+        SoftwareFramebuffer* m_target = nullptr;
+
+        std::vector<SoftwareDrawCall> m_draws;
+        std::vector<uint32_t> m_drawFirstVertex;     // Primer vértice del buffer que usa cada draw
+        std::vector<uint32_t> m_drawVertexCounts;    // Vértices por instancia
+        std::vector<uint64_t> m_drawVertexOffsets;   // Primer ClipVertex de cada draw (prefijo, instancia a instancia)
+        std::vector<uint64_t> m_drawTriangleOffsets; // Primer triángulo de cada draw (prefijo)
+        std::vector<ClipVertex> m_clipVertices;
+        std::vector<Chunk> m_chunks;                 // Grupos de triángulos en orden de envío
+        uint32_t m_chunkCount = 0;
+        uint32_t m_tilesX = 0;
+        uint32_t m_tilesY = 0;
+        SoftwareRasterizerStats m_stats;
+    };
+
+} // namespace D3D12Core
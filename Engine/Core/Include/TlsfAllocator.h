@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Sub-asignador TLSF (Two-Level Segregated Fit) sobre un rango de offsets [0, capacity)
+    // Independiente del dispositivo: solo gestiona offsets, los metadatos viven fuera de la
+    // memoria gestionada (válido para heaps de GPU). Asignar y liberar son O(1); los bloques
+    // libres contiguos se fusionan al liberar
+    class TlsfAllocator {
+    public:
+        static constexpr uint32_t INVALID_HANDLE = ~0u;
+
+        struct Allocation {
+            uint64_t offset = 0;
+            uint64_t size = 0;
+            uint32_t handle = INVALID_HANDLE;
+            bool IsValid() const { return handle != INVALID_HANDLE; }
+        };
+
+        struct Stats {
+            uint64_t capacity = 0;
+            uint64_t usedBytes = 0;
+            uint64_t freeBytes = 0;
+            uint64_t largestFreeBlock = 0;
+            uint32_t allocationCount = 0;
+            uint32_t freeBlockCount = 0;
+            uint64_t totalAllocations = 0;   // Histórico
+            uint64_t failedAllocations = 0;
+            // 0 = toda la memoria libre es contigua; tiende a 1 cuanto más fragmentada
+            double GetFragmentation() const {
+                return freeBytes > 0 ? 1.0 - static_cast<double>(largestFreeBlock) / static_cast<double>(freeBytes) : 0.0;
+            }
+        };
+
+        TlsfAllocator();
+
+        // minAlignment: granularidad mínima de todos los bloques (potencia de dos)
+        void Initialize(uint64_t capacity, uint64_t minAlignment = 256);
+        void Reset();
+
+        // alignment (potencia de dos) se combina con minAlignment
+        Allocation Allocate(uint64_t size, uint64_t alignment = 0);
+        void Free(uint32_t handle);
+
+        uint64_t GetCapacity() const { return m_capacity; }
+        bool IsEmpty() const { return m_allocationCount == 0; }
+        Stats GetStats() const;
+
+        // Informe legible: uso, bloques libres por tamaño y fragmentación
+        std::string BuildReport() const;
+
+        // Comprueba la coherencia interna (listas físicas/libres, bitmaps). Para fuzzing
+        bool Validate() const;
+
+    private:
+        static constexpr uint32_t SL_BITS = 4;
+        static constexpr uint32_t SL_COUNT = 1u << SL_BITS;
+        static constexpr uint32_t FL_COUNT = 64 - SL_BITS + 1;
+
+        struct Block {
+            uint64_t offset = 0;
+            uint64_t size = 0;
+            uint32_t prevPhysical = INVALID_HANDLE;
+            uint32_t nextPhysical = INVALID_HANDLE;
+            uint32_t prevFree = INVALID_HANDLE;
+            uint32_t nextFree = INVALID_HANDLE;
+            bool free = false;
+            bool inUse = false;   // Nodo válido (no reciclado)
+        };
+
+        static void Mapping(uint64_t size, uint32_t& fl, uint32_t& sl);
+        uint32_t FindSuitable(uint64_t size, uint32_t& fl, uint32_t& sl) const;
+        void InsertFree(uint32_t index);
+        void RemoveFree(uint32_t index);
+        uint32_t NewBlock();
+        void ReleaseBlock(uint32_t index);
+        uint32_t SplitBlock(uint32_t index, uint64_t size); // Devuelve el resto libre
+        void MergeWithNext(uint32_t index);
+
+        uint64_t m_capacity = 0;
+        uint64_t m_minAlignment = 256;
+        uint64_t m_flBitmap = 0;
+        uint32_t m_slBitmap[FL_COUNT] = {};
+        uint32_t m_freeHeads[FL_COUNT][SL_COUNT];
+
+        std::vector<Block> m_blocks;
+        std::vector<uint32_t> m_recycledBlocks;
+        uint32_t m_firstBlock = INVALID_HANDLE;
+
+        uint64_t m_usedBytes = 0;
+        uint32_t m_allocationCount = 0;
+        uint64_t m_totalAllocations = 0;
+        uint64_t m_failedAllocations = 0;
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "FrustumCulling.h"
+#include "JobSystem.h"
+#include "RenderSnapshot.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace D3D12Core {
+
+    // Rotación como cuaternión unitario (x, y, z, w)
+    struct Quaternion {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float w = 1.0f;
+    };
+
+    // Giro de angle radianes alrededor de un eje unitario, con el sentido de XMMatrixRotationAxis
+    Quaternion QuaternionRotationNormal(const float axis[3], float angle);
+    // first seguida de second: equivale a la matriz first * second (como XMQuaternionMultiply)
+    Quaternion QuaternionMultiply(const Quaternion& first, const Quaternion& second);
+
+    using TransformHandle = uint32_t;
+    constexpr TransformHandle INVALID_TRANSFORM = UINT32_MAX;
+
+    struct TransformStats {
+        uint64_t updates = 0;
+        uint64_t skippedUpdates = 0;  // Update sin nada que recalcular (escena estática)
+        uint64_t recomputed = 0;      // Matrices de mundo recalculadas
+        uint64_t reorders = 0;        // Reordenaciones por niveles tras cambios de estructura
+        uint64_t lastRecomputed = 0;
+    };
+
+    // Jerarquía de transformaciones en SoA: posición, rotación y escala locales, matriz de mundo
+    // y AABB de mundo de cada nodo en arrays contiguos, ordenados por profundidad (todos los
+    // padres antes que sus hijos). Los setters solo marcan el nodo; Update recorre los niveles en
+    // orden y recalcula la matriz de un nodo si cambió él o su padre, y en la misma pasada su
+    // AABB de mundo, por tramos de nodos consecutivos con los kernels SIMD de BatchMath. Cada
+    // nivel depende solo del anterior, así que se reparte entre los hilos
+    //
+    // Sin cambios Update no hace nada: la geometría estática no cuesta por frame. Los handles son
+    // estables; el índice interno (el de GetWorldBounds) cambia si Create rompe el orden por
+    // niveles y Update tiene que reordenar
+    class TransformHierarchy {
+    public:
+        // parent: nodo ya creado o INVALID_TRANSFORM (raíz)
+        TransformHandle Create(TransformHandle parent = INVALID_TRANSFORM);
+        void Clear();
+        uint32_t GetCount() const { return static_cast<uint32_t>(m_parents.size()); }
+
+        void SetPosition(TransformHandle handle, float x, float y, float z);
+        void SetRotation(TransformHandle handle, const Quaternion& rotation);
+        void SetScale(TransformHandle handle, float x, float y, float z);
+        // AABB en espacio local (centro y semiextensión); por defecto, un punto en el origen
+        void SetLocalBounds(TransformHandle handle, const float center[3], const float extent[3]);
+
+        // Recalcula las matrices y AABB de mundo pendientes. jobs: hilos por nivel (nullptr = hilo que llama)
+        void Update(JobSystem* jobs = nullptr);
+
+        // Resultados del último Update
+        const Float4x4& GetWorld(TransformHandle handle) const { return m_worlds[m_handleIndices[handle]]; }
+        void GetWorldBounds(TransformHandle handle, float center[3], float extent[3]) const;
+        // AABB de mundo de todos los nodos por índice interno (para FrustumCuller)
+        const CullingBounds& GetWorldBounds() const { return m_worldBounds; }
+        TransformHandle GetHandle(uint32_t index) const { return m_indexHandles[index]; }
+
+        const TransformStats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = TransformStats(); }
+        std::string BuildReport() const;
+
+    private:
+        static constexpr uint32_t UPDATE_BATCH = 1024;
+
+        void MarkDirty(uint32_t index);
+        // Ordenación estable por profundidad (counting sort) de todos los arrays
+        void Reorder();
+        template <typename T>
+        void Permute(std::vector<T>& values, const std::vector<uint32_t>& newIndices);
+
+        // Por índice interno, en orden de niveles
+        std::vector<uint32_t> m_parents;          // Índice interno del padre o UINT32_MAX
+        std::vector<uint32_t> m_depths;
+        std::vector<float> m_positions[3];
+        std::vector<float> m_rotations[4];
+        std::vector<float> m_scales[3];
+        std::vector<float> m_localCenters[3];
+        std::vector<float> m_localExtents[3];
+        std::vector<Float4x4> m_worlds;
+        std::vector<uint8_t> m_localDirty;        // Cambió su TRS o su AABB local
+        std::vector<uint8_t> m_worldChanged;      // Su matriz cambió en el último Update (lo leen los hijos)
+        std::vector<TransformHandle> m_indexHandles;
+        CullingBounds m_worldBounds;
+
+        std::vector<uint32_t> m_handleIndices;    // Handle -> índice interno
+        std::vector<uint32_t> m_levelStarts;      // Primer índice de cada nivel (más el final)
+        std::vector<uint64_t> m_workerRecomputed;
+        uint32_t m_dirtyCount = 0;
+        bool m_orderDirty = false;
+        TransformStats m_stats;
+    };
+
+} // namespace D3D12Core
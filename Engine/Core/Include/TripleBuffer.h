@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace D3D12Core {
+
+    // Triple buffer sin bloqueos entre un productor y un consumidor
+    // El productor rellena su buffer y lo publica; el consumidor toma siempre el último
+    // publicado. Cada uno trabaja sobre un buffer que el otro no toca, así que el consumidor
+    // nunca ve un estado a medio escribir y ninguno espera al otro. Si el productor publica
+    // dos veces antes de que el consumidor lea, la publicación intermedia se descarta.
+    // Los buffers se reutilizan: T conserva su capacidad entre frames
+    template <typename T>
+    class TripleBuffer {
+    public:
+        // Productor: buffer a rellenar (contiene lo que se escribió en él hace tres publicaciones)
+        T& GetWriteBuffer() { return m_slots[m_writeIndex]; }
+
+        // Productor: hace visible el buffer de escritura y recibe otro libre
+        void Publish() {
+            uint32_t previous = m_latest.exchange(m_writeIndex | NEW_DATA, std::memory_order_acq_rel);
+            if (previous & NEW_DATA) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed); // El consumidor no llegó a verlo
+            }
+            m_writeIndex = previous & INDEX_MASK;
+            m_published.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        bool HasNewData() const { return (m_latest.load(std::memory_order_acquire) & NEW_DATA) != 0; }
+
+        // Consumidor: pasa al último buffer publicado si hay uno nuevo (true) o sigue con el actual
+        bool Acquire() {
+            if (!HasNewData()) {
+                return false;
+            }
+            uint32_t previous = m_latest.exchange(m_readIndex, std::memory_order_acq_rel);
+            m_readIndex = previous & INDEX_MASK;
+            return true;
+        }
+
+        const T& GetReadBuffer() const { return m_slots[m_readIndex]; }
+
+        uint64_t GetPublishedCount() const { return m_published.load(std::memory_order_relaxed); }
+        uint64_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr uint32_t INDEX_MASK = 0x3;
+        static constexpr uint32_t NEW_DATA = 0x4;
+
+        T m_slots[3];
+        uint32_t m_writeIndex = 0;           // Solo el productor
+        uint32_t m_readIndex = 1;            // Solo el consumidor
+        std::atomic<uint32_t> m_latest{ 2 }; // Intercambio: índice + bit NEW_DATA
+        std::atomic<uint64_t> m_published{ 0 };
+        std::atomic<uint64_t> m_dropped{ 0 };
+    };
+
+} // namespace D3D12Core
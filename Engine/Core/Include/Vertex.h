@@ -0,0 +1,13 @@
+#pragma once
+
+namespace D3D12Core {
+
+    // Formato de vértice del engine (posición + color), independiente del backend. En GPU se
+    // guarda con un VertexFormat (FullVertexFormat es este mismo layout) y el input layout sale
+    // de BuildVertexElements
+    struct Vertex {
+        float position[3];
+        float color[3];
+    };
+
+} // namespace D3D12Core
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Vertex.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace D3D12Core {
+
+    enum class RHIFormat : uint32_t;  // RHI.h (que incluye este archivo)
+
+    constexpr uint32_t MAX_VERTEX_STREAMS = 2;
+    constexpr uint32_t MAX_VERTEX_ELEMENTS = 7;   // Posición, color y las cinco filas de InstanceData
+
+    enum class VertexPositionFormat : uint32_t {
+        Float3,       // 12 bytes (R32G32B32_FLOAT)
+        Snorm16x4     // 8 bytes (R16G16B16A16_SNORM, w = 0) con escala y bias por malla
+    };
+
+    enum class VertexColorFormat : uint32_t {
+        Float3,       // 12 bytes (R32G32B32_FLOAT)
+        Unorm8x4      // 4 bytes (R8G8B8A8_UNORM, alfa 255)
+    };
+
+    // Formato de los vértices de una malla en memoria de GPU. Entrelazado: posición y color
+    // seguidos en el stream 0. Con splitPosition la posición va sola en el stream 0 y el color en
+    // el 1: los pases de profundidad y sombras enlazan solo el primero y leen 8 bytes por vértice
+    // en lugar de todo el vértice. El stream por instancia (InstanceData) va detrás de los de
+    // vértices (slot GetStreamCount())
+    struct VertexFormat {
+        VertexPositionFormat position = VertexPositionFormat::Float3;
+        VertexColorFormat color = VertexColorFormat::Float3;
+        bool splitPosition = false;
+
+        uint32_t GetPositionSize() const { return position == VertexPositionFormat::Float3 ? 12 : 8; }
+        uint32_t GetColorSize() const { return color == VertexColorFormat::Float3 ? 12 : 4; }
+        uint32_t GetVertexSize() const { return GetPositionSize() + GetColorSize(); }
+        uint32_t GetStreamCount() const { return splitPosition ? 2 : 1; }
+        // Bytes por vértice de un stream (0 si el formato no lo tiene)
+        uint32_t GetStride(uint32_t stream) const;
+        // Offset del color dentro de su stream
+        uint32_t GetColorOffset() const { return splitPosition ? 0 : GetPositionSize(); }
+        bool IsQuantized() const { return position != VertexPositionFormat::Float3 || color != VertexColorFormat::Float3; }
+
+        bool operator==(const VertexFormat& other) const {
+            return position == other.position && color == other.color && splitPosition == other.splitPosition;
+        }
+        bool operator!=(const VertexFormat& other) const { return !(*this == other); }
+    };
+
+    // El formato de Vertex: float3 + float3 entrelazados (24 bytes)
+    inline VertexFormat FullVertexFormat() { return VertexFormat(); }
+    // Posición snorm16 y color RGBA8 (12 bytes), entrelazados o en dos streams
+    inline VertexFormat CompressedVertexFormat(bool splitPosition = false) {
+        VertexFormat format;
+        format.position = VertexPositionFormat::Snorm16x4;
+        format.color = VertexColorFormat::Unorm8x4;
+        format.splitPosition = splitPosition;
+        return format;
+    }
+
+    // "float", "float-split", "compact" o "compact-split". false si no lo reconoce
+    bool ParseVertexFormat(const char* name, VertexFormat& format);
+    std::string GetVertexFormatName(const VertexFormat& format);
+
+    // Un atributo del input layout, con las semánticas de BasicVS.hlsl/InstancedVS.hlsl
+    struct VertexElement {
+        const char* semantic = nullptr;
+        uint32_t semanticIndex = 0;
+        RHIFormat format{};   // Unknown
+        uint32_t slot = 0;
+        uint32_t offset = 0;
+        bool perInstance = false;
+    };
+
+    // Input layout de un formato: POSITION y COLOR y, con instanced, las filas de InstanceData
+    // (INSTANCE_WORLD0-3 e INSTANCE_DATA) en el slot siguiente a los de vértices. positionOnly
+    // deja solo POSITION (pases de profundidad). Devuelve el número de elementos escritos
+    uint32_t BuildVertexElements(const VertexFormat& format, bool instanced, bool positionOnly,
+        VertexElement elements[MAX_VERTEX_ELEMENTS]);
+
+    // Posición local = posición decodificada (en [-1, 1]) * positionScale + positionBias. Es lo
+    // que suma el vertex shader con las constantes del mismo nombre; identidad sin cuantizar
+    struct VertexQuantization {
+        float positionScale[3] = { 1.0f, 1.0f, 1.0f };
+        float positionBias[3] = { 0.0f, 0.0f, 0.0f };
+    };
+
+    // Vértices codificados en un formato, un array de bytes por stream listo para subir
+    struct EncodedVertices {
+        VertexFormat format;
+        VertexQuantization quantization;
+        uint32_t vertexCount = 0;
+        std::vector<uint8_t> streams[MAX_VERTEX_STREAMS];
+
+        uint64_t GetSize() const { return static_cast<uint64_t>(vertexCount) * format.GetVertexSize(); }
+    };
+
+    // Codifica con el nivel SIMD activo (BatchMath). Las posiciones snorm16 cubren el AABB de la
+    // malla: escala = semiextensión y bias = centro de cada eje, así que el error máximo por eje es
+    // semiextensión / 65534. El color se satura a [0, 1]. false si no hay vértices
+    bool EncodeVertices(const Vertex* vertices, uint32_t count, const VertexFormat& format, EncodedVertices& output);
+    // De vuelta a Vertex con la cuantización aplicada (posiciones en unidades de la malla)
+    void DecodeVertices(const EncodedVertices& input, std::vector<Vertex>& output);
+
+} // namespace D3D12Core
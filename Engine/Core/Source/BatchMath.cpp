@@ -0,0 +1,229 @@
+#include "BatchMath.h"
+#include "SimdKernels.h"
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define BATCH_MATH_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace D3D12Core {
+
+    namespace {
+
+#if defined(BATCH_MATH_X86)
+        void Cpuid(uint32_t leaf, uint32_t subleaf, uint32_t registers[4]) {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+            for (int i = 0; i < 4; i++) {
+                registers[i] = static_cast<uint32_t>(info[i]);
+            }
+#else
+            __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+        }
+
+        // Estados de registro que el sistema operativo guarda en los cambios de contexto (XCR0)
+        uint64_t ReadXcr0() {
+#if defined(_MSC_VER)
+            return _xgetbv(0);
+#else
+            uint32_t low, high;
+            __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+            return (static_cast<uint64_t>(high) << 32) | low;
+#endif
+        }
+
+        // La CPU debe tener las instrucciones y el sistema operativo guardar sus registros:
+        // AVX necesita los estados SSE y AVX en XCR0; AVX-512 además los de máscaras y ZMM
+        SimdLevel DetectCpuSimdLevel() {
+            uint32_t registers[4];
+            Cpuid(0, 0, registers);
+            const uint32_t maxLeaf = registers[0];
+            if (maxLeaf < 1) {
+                return SimdLevel::Scalar;
+            }
+            Cpuid(1, 0, registers);
+            const uint32_t features = registers[2];
+            const bool sse42 = (features & (1u << 0)) && (features & (1u << 9)) && (features & (1u << 19)) && (features & (1u << 20));
+            if (!sse42) {
+                return SimdLevel::Scalar;
+            }
+            const bool osxsave = (features & (1u << 27)) != 0;
+            const bool avx = (features & (1u << 28)) != 0;
+            if (!osxsave || !avx || maxLeaf < 7) {
+                return SimdLevel::SSE42;
+            }
+            const uint64_t xcr0 = ReadXcr0();
+            if ((xcr0 & 0x6) != 0x6) {
+                return SimdLevel::SSE42;
+            }
+            Cpuid(7, 0, registers);
+            const uint32_t extendedFeatures = registers[1];
+            if ((extendedFeatures & (1u << 5)) == 0) {
+                return SimdLevel::SSE42;
+            }
+            if ((extendedFeatures & (1u << 16)) == 0 || (xcr0 & 0xE6) != 0xE6) {
+                return SimdLevel::AVX2;
+            }
+            return SimdLevel::AVX512;
+        }
+#else
+        SimdLevel DetectCpuSimdLevel() {
+            return SimdLevel::Scalar;
+        }
+#endif
+
+        // Tabla compilada del nivel o nullptr. Solo se pide para niveles que la CPU soporta
+        const SimdKernelTable* GetCompiledKernels(SimdLevel level) {
+            switch (level) {
+            case SimdLevel::Scalar: return GetScalarKernels();
+            case SimdLevel::SSE42: return GetSse42Kernels();
+            case SimdLevel::AVX2: return GetAvx2Kernels();
+            case SimdLevel::AVX512: return GetAvx512Kernels();
+            }
+            return nullptr;
+        }
+
+        // Mejor nivel que soportan a la vez la CPU y el binario
+        SimdLevel DetectSupportedSimdLevel() {
+            uint32_t level = static_cast<uint32_t>(DetectCpuSimdLevel());
+            while (level > 0 && !GetCompiledKernels(static_cast<SimdLevel>(level))) {
+                level--;
+            }
+            return static_cast<SimdLevel>(level);
+        }
+
+        SimdLevel SupportedSimdLevel() {
+            static const SimdLevel supported = DetectSupportedSimdLevel();
+            return supported;
+        }
+
+        std::atomic<const SimdKernelTable*>& ActiveKernels() {
+            static std::atomic<const SimdKernelTable*> active(GetCompiledKernels(SupportedSimdLevel()));
+            return active;
+        }
+
+    } // namespace
+
+    SimdLevel GetSimdLevel() {
+        return GetSimdKernels().level;
+    }
+
+    SimdLevel GetSupportedSimdLevel() {
+        return SupportedSimdLevel();
+    }
+
+    bool SetSimdLevel(SimdLevel level) {
+        if (static_cast<uint32_t>(level) > static_cast<uint32_t>(SupportedSimdLevel())) {
+            return false;
+        }
+        const SimdKernelTable* kernels = GetCompiledKernels(level);
+        if (!kernels) {
+            return false;
+        }
+        ActiveKernels().store(kernels, std::memory_order_release);
+        return true;
+    }
+
+    const char* GetSimdLevelName(SimdLevel level) {
+        switch (level) {
+        case SimdLevel::Scalar: return "escalar";
+        case SimdLevel::SSE42: return "SSE4.2";
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::AVX512: return "AVX-512";
+        }
+        return "desconocido";
+    }
+
+    uint32_t GetSimdLevelWidth(SimdLevel level) {
+        switch (level) {
+        case SimdLevel::Scalar: return 1;
+        case SimdLevel::SSE42: return 4;
+        case SimdLevel::AVX2: return 8;
+        case SimdLevel::AVX512: return 16;
+        }
+        return 1;
+    }
+
+    bool ParseSimdLevel(const char* name, SimdLevel& level) {
+        const struct {
+            const char* name;
+            SimdLevel level;
+        } names[] = {
+            { "escalar", SimdLevel::Scalar }, { "scalar", SimdLevel::Scalar },
+            { "sse4.2", SimdLevel::SSE42 }, { "sse42", SimdLevel::SSE42 },
+            { "avx2", SimdLevel::AVX2 },
+            { "avx512", SimdLevel::AVX512 }, { "avx-512", SimdLevel::AVX512 }
+        };
+        for (const auto& entry : names) {
+            if (std::strcmp(name, entry.name) == 0) {
+                level = entry.level;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const SimdKernelTable& GetSimdKernels() {
+        return *ActiveKernels().load(std::memory_order_acquire);
+    }
+
+    namespace BatchMath {
+
+        void MultiplyTranspose(const Float4x4* left, uint32_t leftStride, const uint32_t* indices,
+            const Float4x4* right, Float4x4* output, uint32_t outputStride, uint32_t count) {
+            GetSimdKernels().multiplyTranspose(left, leftStride, indices, right, output, outputStride, count);
+        }
+
+        void TransformPoints(const float* const input[3], const Float4x4& matrix, float* const output[3], uint32_t count) {
+            GetSimdKernels().transformPoints(input, matrix, output, count);
+        }
+
+        void ProjectPoints(const float* const input[3], const Float4x4& matrix, float* const output[4], uint32_t count) {
+            GetSimdKernels().projectPoints(input, matrix, output, count);
+        }
+
+        void TransformBounds(const float* const centers[3], const float* const extents[3], const Float4x4& matrix,
+            float* const outCenters[3], float* const outExtents[3], uint32_t count) {
+            GetSimdKernels().transformBounds(centers, extents, matrix, outCenters, outExtents, count);
+        }
+
+        void TransformBounds(const float* const centers[3], const float* const extents[3], const Float4x4* matrices,
+            float* const outCenters[3], float* const outExtents[3], uint32_t count) {
+            GetSimdKernels().transformBoundsPerItem(centers, extents, matrices, outCenters, outExtents, count);
+        }
+
+        void ComposeTransforms(const float* const positions[3], const float* const rotations[4],
+            const float* const scales[3], Float4x4* output, uint32_t count) {
+            GetSimdKernels().composeTransforms(positions, rotations, scales, output, count);
+        }
+
+        void EncodeSnorm16(const float* input, uint32_t inputStride, const float bias[3], const float invScale[3],
+            int16_t* output, uint32_t outputStride, uint32_t count) {
+            GetSimdKernels().encodeSnorm16(input, inputStride, bias, invScale, output, outputStride, count);
+        }
+
+        void DecodeSnorm16(const int16_t* input, uint32_t inputStride, const float scale[3], const float bias[3],
+            float* output, uint32_t outputStride, uint32_t count) {
+            GetSimdKernels().decodeSnorm16(input, inputStride, scale, bias, output, outputStride, count);
+        }
+
+        void EncodeUnorm8(const float* input, uint32_t inputStride, uint8_t* output, uint32_t outputStride, uint32_t count) {
+            GetSimdKernels().encodeUnorm8(input, inputStride, output, outputStride, count);
+        }
+
+        void DecodeUnorm8(const uint8_t* input, uint32_t inputStride, float* output, uint32_t outputStride, uint32_t count) {
+            GetSimdKernels().decodeUnorm8(input, inputStride, output, outputStride, count);
+        }
+
+    } // namespace BatchMath
+
+} // namespace D3D12Core
@@ -0,0 +1,60 @@
+#include "D3D12CommandContext.h"
+#include <iostream>
+
+namespace D3D12Core {
+
+    D3D12CommandContext::D3D12CommandContext() {
+    }
+
+    D3D12CommandContext::~D3D12CommandContext() {
+        Shutdown();
+    }
+
+    bool D3D12CommandContext::Initialize(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type) {
+        HRESULT hr = device->CreateCommandAllocator(type, IID_PPV_ARGS(&m_allocator));
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to create context command allocator" << std::endl;
+            return false;
+        }
+
+        hr = device->CreateCommandList(0, type, m_allocator.Get(), nullptr, IID_PPV_ARGS(&m_commandList));
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to create context command list" << std::endl;
+            return false;
+        }
+
+        // Las command lists se crean abiertas; se cierran hasta el primer Begin
+        m_commandList->Close();
+        m_recording = false;
+
+        return true;
+    }
+
+    void D3D12CommandContext::Shutdown() {
+        m_commandList.Reset();
+        m_allocator.Reset();
+        m_recording = false;
+    }
+
+    void D3D12CommandContext::Begin(uint32_t order) {
+        m_order = order;
+        m_allocator->Reset();
+        m_commandList->Reset(m_allocator.Get(), nullptr);
+        m_recording = true;
+    }
+
+    bool D3D12CommandContext::Close() {
+        if (!m_recording) {
+            return true;
+        }
+
+        m_recording = false;
+        HRESULT hr = m_commandList->Close();
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to close context command list" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+} // namespace D3D12Core
@@ -51,6 +51,7 @@ namespace D3D12Core {
         }
 
         m_commandList->Close();
+        m_commandListRecording = false;
 
         // Crear fence
         hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence));
@@ -66,11 +67,35 @@ namespace D3D12Core {
             return false;
         }
 
+        // Un fence por slot de allocator (frames en vuelo)
+        if (!m_scheduler.Initialize(this, MAX_FRAMES_IN_FLIGHT)) {
+            std::cerr << "Error: Failed to initialize frame scheduler" << std::endl;
+            return false;
+        }
+        m_frameIndex = m_scheduler.GetCurrentSlot();
+
+        // Pool de contextos por slot para grabar desde hilos de trabajo
+        bool poolReady = m_contextPool.Initialize(MAX_FRAMES_IN_FLIGHT, [device, type]() {
+            auto context = std::make_unique<D3D12CommandContext>();
+            if (!context->Initialize(device, type)) {
+                return std::unique_ptr<D3D12CommandContext>();
+            }
+            return context;
+        });
+        if (!poolReady) {
+            std::cerr << "Error: Failed to initialize command context pool" << std::endl;
+            return false;
+        }
+
         return true;
     }
 
     void D3D12CommandQueue::Shutdown() {
-        WaitForGPU();
+        if (m_commandQueue && m_fence) {
+            WaitForGPU();
+        }
+        m_scheduler.Shutdown();
+        m_contextPool.Shutdown();
 
         if (m_fenceEvent) {
             CloseHandle(m_fenceEvent);
@@ -89,21 +114,59 @@ namespace D3D12Core {
         return m_commandAllocators[m_frameIndex].Get();
     }
 
+    D3D12CommandContext* D3D12CommandQueue::AcquireContext(UINT order) {
+        D3D12CommandContext* context = m_contextPool.Acquire(m_frameIndex, order);
+        if (!context) {
+            std::cerr << "Error: Failed to acquire command context" << std::endl;
+        }
+        return context;
+    }
+
     void D3D12CommandQueue::ExecuteCommandList() {
-        HRESULT hr = m_commandList->Close();
-        if (FAILED(hr)) {
-            std::cerr << "Error: Failed to close command list" << std::endl;
-            return;
+        // Command list principal primero, luego los contextos de los hilos en su orden. Se puede
+        // llamar más de una vez por frame: cada lista solo se envía en la primera llamada tras su Reset
+        m_submitLists.clear();
+        if (m_commandListRecording) {
+            m_commandListRecording = false;
+            HRESULT hr = m_commandList->Close();
+            if (SUCCEEDED(hr)) {
+                m_submitLists.push_back(m_commandList.Get());
+            }
+            else {
+                std::cerr << "Error: Failed to close command list" << std::endl;
+            }
+        }
+        for (D3D12CommandContext* context : m_contextPool.GatherOrdered(m_frameIndex)) {
+            if (!context->IsRecording()) {
+                continue; // Ya enviado en una llamada anterior de este frame
+            }
+            if (context->Close()) {
+                m_submitLists.push_back(context->GetCommandList());
+            }
         }
 
-        ID3D12CommandList* commandLists[] = { m_commandList.Get() };
-        m_commandQueue->ExecuteCommandLists(1, commandLists);
+        if (!m_submitLists.empty()) {
+            m_commandQueue->ExecuteCommandLists(static_cast<UINT>(m_submitLists.size()), m_submitLists.data());
+        }
     }
 
     void D3D12CommandQueue::ResetCommandList() {
+        // El allocator solo se puede resetear cuando la GPU terminó el frame que lo usó
+        m_frameIndex = m_scheduler.BeginFrame();
+        m_contextPool.ResetSlot(m_frameIndex);
+
         ID3D12CommandAllocator* allocator = GetCurrentAllocator();
         allocator->Reset();
-        m_commandList->Reset(allocator, nullptr);
+        m_commandListRecording = SUCCEEDED(m_commandList->Reset(allocator, nullptr));
+    }
+
+    void D3D12CommandQueue::EndFrame() {
+        m_scheduler.EndFrame();
+        m_frameIndex = m_scheduler.GetCurrentSlot();
+    }
+
+    void D3D12CommandQueue::WaitForIdle() {
+        m_scheduler.WaitForIdle();
     }
 
     void D3D12CommandQueue::WaitForGPU() {
@@ -111,10 +174,6 @@ namespace D3D12Core {
         WaitForFenceValue(fenceValueToWaitFor);
     }
 
-    void D3D12CommandQueue::Flush() {
-        m_frameIndex = (m_frameIndex + 1) % MAX_FRAMES_IN_FLIGHT;
-    }
-
     UINT64 D3D12CommandQueue::Signal() {
         m_fenceValue++;
         HRESULT hr = m_commandQueue->Signal(m_fence.Get(), m_fenceValue);
@@ -124,6 +183,10 @@ namespace D3D12Core {
         return m_fenceValue;
     }
 
+    UINT64 D3D12CommandQueue::GetCompletedValue() const {
+        return m_fence ? m_fence->GetCompletedValue() : 0;
+    }
+
     void D3D12CommandQueue::WaitForFenceValue(UINT64 fenceValue) {
         if (m_fence->GetCompletedValue() < fenceValue) {
             HRESULT hr = m_fence->SetEventOnCompletion(fenceValue, m_fenceEvent);
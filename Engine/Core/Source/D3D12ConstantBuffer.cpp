@@ -16,12 +16,26 @@ namespace D3D12Core {
         Shutdown();
     }
 
-    bool D3D12ConstantBuffer::Initialize(ID3D12Device* device, UINT size) {
+    bool D3D12ConstantBuffer::Initialize(ID3D12Device* device, UINT size, D3D12HeapAllocator* allocator) {
         m_size = size;
         
         // Alinear a 256 bytes (requerimiento de DirectX 12)
         UINT64 alignedSize = (size + 255) & ~255;
 
+        // Sub-asignar de un upload heap compartido y ya mapeado en lugar de un recurso propio
+        if (allocator) {
+            m_range = allocator->AllocateBuffer(alignedSize, D3D12_HEAP_TYPE_UPLOAD);
+            if (!m_range.IsValid()) {
+                std::cerr << "Error: Failed to sub-allocate constant buffer" << std::endl;
+                return false;
+            }
+            m_allocator = allocator;
+            m_resource = m_range.resource;
+            m_mappedData = m_range.cpuAddress;
+            m_gpuAddress = m_range.gpuAddress;
+            return true;
+        }
+
         // Crear buffer upload heap para constant buffer
         D3D12_HEAP_PROPERTIES heapProps = {};
         heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
@@ -64,15 +78,22 @@ namespace D3D12Core {
 
         // Guardar el resource directamente
         m_resource = uploadBuffer;
+        m_gpuAddress = m_resource->GetGPUVirtualAddress();
 
         return true;
     }
 
     void D3D12ConstantBuffer::Shutdown() {
-        if (m_resource && m_mappedData) {
+        if (m_allocator) {
+            // El rango no es dueño del mapeo: lo mantiene el bloque compartido
+            m_allocator->FreeBuffer(m_range);
+            m_allocator = nullptr;
+        }
+        else if (m_resource && m_mappedData) {
             m_resource->Unmap(0, nullptr);
-            m_mappedData = nullptr;
         }
+        m_mappedData = nullptr;
+        m_gpuAddress = 0;
         m_resource.Reset();
     }
 
@@ -84,16 +105,12 @@ namespace D3D12Core {
 
     void D3D12ConstantBuffer::Bind(ID3D12GraphicsCommandList* commandList, UINT rootParameterIndex) {
         if (m_resource) {
-            D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = m_resource->GetGPUVirtualAddress();
-            commandList->SetGraphicsRootConstantBufferView(rootParameterIndex, gpuAddress);
+            commandList->SetGraphicsRootConstantBufferView(rootParameterIndex, m_gpuAddress);
         }
     }
 
     D3D12_GPU_VIRTUAL_ADDRESS D3D12ConstantBuffer::GetGPUVirtualAddress() const {
-        if (m_resource) {
-            return m_resource->GetGPUVirtualAddress();
-        }
-        return 0;
+        return m_resource ? m_gpuAddress : 0;
     }
 
 } // namespace D3D12Core
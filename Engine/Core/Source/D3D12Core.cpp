@@ -1,11 +1,18 @@
 #include "D3D12Core.h"
 #include "D3D12Device.h"
 #include "D3D12CommandQueue.h"
+#include "D3D12CommandContext.h"
+#include "D3D12UploadManager.h"
+#include "D3D12FrameAllocator.h"
+#include "D3D12HeapAllocator.h"
+#include "D3D12DescriptorManager.h"
+#include "D3D12ResourceStateTracker.h"
 #include "D3D12SwapChain.h"
-#include "D3D12HighResRenderTarget.h"
+#include "D3D12RenderGraphBackend.h"
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <climits>
 
 // Evitar conflictos con macros max/min de Windows
 #ifdef max
@@ -44,12 +51,41 @@ namespace D3D12Core {
             return false;
         }
 
+        // Crear gestor de subidas asíncronas (cola de copia dedicada)
+        m_uploadManager = std::make_unique<D3D12UploadManager>();
+        if (!m_uploadManager->Initialize(m_device->GetDevice())) {
+            std::cerr << "Error: Failed to initialize Upload Manager" << std::endl;
+            return false;
+        }
+
+        // Crear asignador lineal por frame para constantes dinámicas
+        m_frameAllocator = std::make_unique<D3D12FrameAllocator>();
+        if (!m_frameAllocator->Initialize(m_device->GetDevice(), FRAME_DYNAMIC_MEMORY_SIZE)) {
+            std::cerr << "Error: Failed to initialize Frame Allocator" << std::endl;
+            return false;
+        }
+
+        // Crear sub-asignador de memoria de GPU para buffers y recursos colocados
+        m_heapAllocator = std::make_unique<D3D12HeapAllocator>();
+        if (!m_heapAllocator->Initialize(m_device->GetDevice())) {
+            std::cerr << "Error: Failed to initialize Heap Allocator" << std::endl;
+            return false;
+        }
+
+        // Crear gestor central de descriptores (persistentes, bindless y transitorios)
+        m_descriptorManager = std::make_unique<D3D12DescriptorManager>();
+        if (!m_descriptorManager->Initialize(m_device->GetDevice())) {
+            std::cerr << "Error: Failed to initialize Descriptor Manager" << std::endl;
+            return false;
+        }
+
         // Crear swap chain
         m_swapChain = std::make_unique<D3D12SwapChain>();
         if (!m_swapChain->Initialize(
             hwnd,
             m_device->GetFactory(),
             m_commandQueue->GetQueue(),
+            m_descriptorManager.get(),
             width,
             height
         )) {
@@ -57,25 +93,22 @@ namespace D3D12Core {
             return false;
         }
 
-        // Crear render target views
-        ID3D12Device* device = m_device->GetDevice();
-        // Esto se hace internamente en CreateRenderTargetViews
-
-        // Crear render target de alta resolución (1920x1080) para mantener calidad máxima
-        // Nota: Por ahora está inicializado pero no se usa activamente debido a limitaciones de escalado
-        // El sistema renderiza directamente al tamaño del viewport que se ajusta automáticamente
-        m_highResRenderTarget = std::make_unique<D3D12HighResRenderTarget>();
-        if (!m_highResRenderTarget->Initialize(device, m_renderWidth, m_renderHeight)) {
-            std::cerr << "Error: Failed to initialize high-res render target" << std::endl;
-            // No es crítico, continuamos sin él
-            m_highResRenderTarget.reset();
+        // Los back buffers empiezan en PRESENT; sus transiciones las resuelve el state tracker
+        m_stateTracker = std::make_unique<D3D12ResourceStateTracker>();
+        m_stateTracker->Initialize();
+        RegisterBackBuffers();
+
+        // Grafo de render por frame; sus render targets intermedios son transitorios colocados
+        // en heaps propios y solo existen mientras algún pase vivo los usa
+        m_renderGraph = std::make_unique<RenderGraph>();
+        m_renderGraphBackend = std::make_unique<D3D12RenderGraphBackend>();
+        if (!m_renderGraphBackend->Initialize(m_device->GetDevice(), m_commandQueue.get(), m_descriptorManager.get(), m_stateTracker.get())) {
+            std::cerr << "Error: Failed to initialize Render Graph backend" << std::endl;
+            return false;
         }
 
         std::wcout << L"DirectX 12 inicializado correctamente" << std::endl;
         std::wcout << L"Viewport: " << m_width << L"x" << m_height << L" (ajuste automático activo)" << std::endl;
-        if (m_highResRenderTarget) {
-            std::wcout << L"Render target de alta calidad disponible: " << m_renderWidth << L"x" << m_renderHeight << std::endl;
-        }
         auto adapterInfo = m_device->GetAdapterInfo();
         std::wcout << L"Adaptador: " << adapterInfo.Description.c_str() << std::endl;
         std::wcout << L"Memoria de video dedicada: " << (adapterInfo.DedicatedVideoMemory / (1024ULL * 1024ULL * 1024ULL)) << L" GB" << std::endl;
@@ -88,92 +121,183 @@ namespace D3D12Core {
             m_commandQueue->WaitForGPU();
         }
 
-        m_highResRenderTarget.reset();
+        m_frameAllocator.reset();
+        m_uploadManager.reset();
+        m_heapAllocator.reset();
+        m_renderGraphBackend.reset();
+        m_renderGraph.reset();
         m_swapChain.reset();
+        m_stateTracker.reset();
+        m_descriptorManager.reset();
         m_commandQueue.reset();
         m_device.reset();
     }
 
     void D3D12Core::BeginFrame() {
+        // Enviar las subidas encoladas desde el frame anterior y reciclar lotes completados
+        m_uploadManager->Submit();
+        m_uploadManager->RetireCompleted();
+        m_frameUploadFence = 0;
+
         // Reset command list
         m_commandQueue->ResetCommandList();
         ID3D12GraphicsCommandList* commandList = m_commandQueue->GetCommandList();
 
+        // ResetCommandList ya esperó el fence del slot: su memoria dinámica se puede reutilizar
+        m_frameAllocator->BeginFrame(m_commandQueue->GetFrameIndex());
+        m_descriptorManager->BeginFrame(m_commandQueue->GetFrameIndex());
+
+        // Heap visible en shaders (bindless + transitorios) enlazado una vez por lista
+        m_descriptorManager->BindHeaps(commandList);
+
         // Obtener back buffer actual (para uso posterior en EndFrame)
         m_currentBackBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
 
-        // Obtener back buffer actual
-        ID3D12Resource* backBuffer = m_swapChain->GetCurrentBackBuffer();
-        
-        // Transición a render target
-        D3D12_RESOURCE_BARRIER barrier = {};
-        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barrier.Transition.pResource = backBuffer;
-        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
-        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        commandList->ResourceBarrier(1, &barrier);
-
-        // Limpiar render target con color oscuro elegante
-        D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = m_swapChain->GetCurrentRTV();
-        const float clearColor[] = { 0.05f, 0.05f, 0.1f, 1.0f }; // Azul muy oscuro elegante
-        commandList->ClearRenderTargetView(rtvHandle, clearColor, 0, nullptr);
+        // Nuevo grafo: el back buffer entra como recurso importado. Su paso final a PRESENT lo
+        // hace EndFrame, después de las command lists de los hilos de trabajo
+        m_renderGraph->Reset();
+        RenderGraphTextureDesc backBufferDesc;
+        backBufferDesc.width = m_width;
+        backBufferDesc.height = m_height;
+        backBufferDesc.format = BACK_BUFFER_FORMAT;
+        backBufferDesc.clearColor[0] = 0.05f; // Azul muy oscuro elegante
+        backBufferDesc.clearColor[1] = 0.05f;
+        backBufferDesc.clearColor[2] = 0.1f;
+        backBufferDesc.clearColor[3] = 1.0f;
+        m_backBufferResource = m_renderGraph->ImportTexture(
+            "BackBuffer", backBufferDesc,
+            m_swapChain->GetCurrentBackBuffer(), m_swapChain->GetCurrentRTV().ptr,
+            RenderGraphUsage::Present);
+
+        // Limpiar y dejar enlazado el back buffer (los contextos de trabajo dibujan encima)
+        RenderGraphResource backBuffer = m_backBufferResource;
+        m_renderGraph->AddPass("Clear", [this, backBuffer](RenderGraphContext& context) {
+            ID3D12GraphicsCommandList* commandList = static_cast<ID3D12GraphicsCommandList*>(context.commandList);
+            D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = m_renderGraphBackend->GetRTV(*context.graph, backBuffer);
+            commandList->ClearRenderTargetView(rtvHandle, context.graph->GetResource(backBuffer).desc.clearColor, 0, nullptr);
+            commandList->OMSetRenderTargets(1, &rtvHandle, FALSE, nullptr);
+        }).Write(backBuffer, RenderGraphUsage::RenderTarget);
+    }
+
+    D3D12CommandContext* D3D12Core::AcquireRecordingContext(UINT order) {
+        // UINT_MAX queda reservado para el cierre del frame (transición a PRESENT)
+        if (order == UINT_MAX) {
+            order = UINT_MAX - 1;
+        }
+
+        D3D12CommandContext* context = m_commandQueue->AcquireContext(order);
+        if (!context) {
+            return nullptr;
+        }
+
+        ID3D12GraphicsCommandList* commandList = context->GetCommandList();
+        m_descriptorManager->BindHeaps(commandList);
 
-        // Establecer render target
+        D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = m_swapChain->GetCurrentRTV();
         commandList->OMSetRenderTargets(1, &rtvHandle, FALSE, nullptr);
-        
-        // Nota: El render target de alta resolución está temporalmente deshabilitado
-        // porque CopyTextureRegion no puede hacer escalado real cuando los tamaños son diferentes.
-        // Para implementar escalado de alta calidad, se necesita un pixel shader con filtrado bilinear.
-        // Por ahora, renderizamos directamente al tamaño del viewport con máxima calidad posible.
+
+        D3D12_VIEWPORT viewport = { 0.0f, 0.0f, (float)m_width, (float)m_height, 0.0f, 1.0f };
+        D3D12_RECT scissorRect = { 0, 0, (LONG)m_width, (LONG)m_height };
+        commandList->RSSetViewports(1, &viewport);
+        commandList->RSSetScissorRects(1, &scissorRect);
+
+        return context;
+    }
+
+    void D3D12Core::RequireUpload(const UploadToken& token) {
+        if (token.fenceValue > m_frameUploadFence) {
+            m_frameUploadFence = token.fenceValue;
+        }
     }
 
     void D3D12Core::EndFrame() {
         ID3D12GraphicsCommandList* commandList = m_commandQueue->GetCommandList();
         ID3D12Resource* backBuffer = m_swapChain->GetCurrentBackBuffer();
 
+        // Compilar (descartar pases sin consumidor, barreras, aliasing) y grabar el grafo del frame
+        m_renderGraphBackend->SetCommandList(commandList);
+        if (m_renderGraph->Compile(*m_renderGraphBackend)) {
+            m_renderGraph->Execute(*m_renderGraphBackend);
+        }
+        else {
+            std::cerr << "Error: Render graph compilation failed, frame skipped" << std::endl;
+        }
+        m_renderGraph->Reset(); // Los pases capturan estado del frame: no sobrevivir a EndFrame
+
+        // Si hubo grabación en hilos de trabajo, la transición final debe ir después de
+        // sus command lists: se graba en un contexto de cierre con el último orden
+        if (m_commandQueue->GetActiveContextCount() > 0) {
+            D3D12CommandContext* closingContext = m_commandQueue->AcquireContext(UINT_MAX);
+            if (closingContext) {
+                commandList = closingContext->GetCommandList();
+            }
+        }
+
         // Transición del back buffer a PRESENT
-        D3D12_RESOURCE_BARRIER barrier = {};
-        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barrier.Transition.pResource = backBuffer;
-        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
-        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        commandList->ResourceBarrier(1, &barrier);
+        m_stateTracker->Transition(backBuffer, D3D12_RESOURCE_STATE_PRESENT);
+        m_stateTracker->Flush(commandList);
+
+        // Sincronizar con la cola de copia solo si algún recurso usado sigue subiéndose
+        if (m_frameUploadFence != 0) {
+            UploadToken token;
+            token.fenceValue = m_frameUploadFence;
+            m_uploadManager->RequireOnQueue(token, m_commandQueue->GetQueue());
+            m_frameUploadFence = 0;
+        }
 
         // NO cerrar aquí - ExecuteCommandList ya lo hace
         // commandList->Close();
 
         // Ejecutar comandos (esto cierra el command list internamente)
         m_commandQueue->ExecuteCommandList();
+        m_stateTracker->OnExecuted(); // Los buffers promocionados vuelven a COMMON
+
+        // Registrar el fence de este frame; el slot solo se esperará cuando se reutilice
+        m_commandQueue->EndFrame();
     }
 
-    void D3D12Core::Present() {
+    void D3D12Core::Present(UINT syncInterval) {
         if (!m_swapChain) {
             return; // Swap chain no válido
         }
         
         // Present retorna void, el manejo de errores está en D3D12SwapChain::Present()
-        m_swapChain->Present(1, 0); // VSync habilitado
+        m_swapChain->Present(syncInterval, 0);
         
-        m_commandQueue->Flush();
         m_frameIndex++;
     }
 
+    void D3D12Core::RegisterBackBuffers() {
+        for (UINT i = 0; i < m_swapChain->GetBufferCount(); ++i) {
+            if (ID3D12Resource* backBuffer = m_swapChain->GetBackBuffer(i)) {
+                m_stateTracker->Register(backBuffer, D3D12_RESOURCE_STATE_PRESENT);
+            }
+        }
+    }
+
+    void D3D12Core::UnregisterBackBuffers() {
+        for (UINT i = 0; i < m_swapChain->GetBufferCount(); ++i) {
+            if (ID3D12Resource* backBuffer = m_swapChain->GetBackBuffer(i)) {
+                m_stateTracker->Unregister(backBuffer);
+            }
+        }
+    }
+
     void D3D12Core::Resize(UINT width, UINT height) {
         if (m_width == width && m_height == height) {
             return;
         }
 
-        m_commandQueue->WaitForGPU();
+        // El swap chain no puede redimensionarse mientras la GPU use los back buffers
+        m_commandQueue->WaitForIdle();
 
         m_width = width;
         m_height = height;
 
-        // Actualizar el swap chain al nuevo tamaño del viewport
+        // Actualizar el swap chain al nuevo tamaño del viewport (los back buffers se recrean)
+        UnregisterBackBuffers();
         m_swapChain->Resize(width, height);
+        RegisterBackBuffers();
         
         // Sistema de resolución automática mejorado
         // Calcula la mejor resolución dentro del rango 800x600 a 1920x1080
@@ -0,0 +1,297 @@
+#include "D3D12DescriptorManager.h"
+#include <algorithm>
+#include <iostream>
+
+namespace D3D12Core {
+
+    D3D12DescriptorManager::D3D12DescriptorManager() {
+    }
+
+    D3D12DescriptorManager::~D3D12DescriptorManager() {
+        Shutdown();
+    }
+
+    bool D3D12DescriptorManager::Initialize(ID3D12Device* device, UINT cpuDescriptorsPerType, UINT bindlessCapacity, UINT transientPerFrame) {
+        m_device = device;
+
+        // Heaps no visibles: uno por tipo, con free-list de granularidad 1 descriptor
+        for (UINT type = 0; type < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES; ++type) {
+            if (!m_cpuHeaps[type].Initialize(device, static_cast<D3D12_DESCRIPTOR_HEAP_TYPE>(type), cpuDescriptorsPerType, false)) {
+                std::cerr << "Error: Failed to create CPU descriptor heap (type " << type << ")" << std::endl;
+                return false;
+            }
+            m_cpuFreeLists[type].Initialize(cpuDescriptorsPerType, 1);
+        }
+
+        // Heap visible: [0, bindlessCapacity) bindless + una región transitoria por frame en vuelo
+        const bool bindingTier1 = GetResourceBindingTier(device) < D3D12_RESOURCE_BINDING_TIER_2;
+        bindlessCapacity = GetSupportedBindlessCapacity(device, bindlessCapacity);
+        m_bindlessCapacity = bindlessCapacity;
+        UINT shaderVisibleCount = bindlessCapacity + transientPerFrame * MAX_FRAMES_IN_FLIGHT;
+        if (!m_shaderVisibleHeap.Initialize(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, shaderVisibleCount, true)) {
+            std::cerr << "Error: Failed to create shader-visible descriptor heap" << std::endl;
+            return false;
+        }
+        if (bindingTier1) {
+            // Tier 1 exige que todo el rango de la tabla esté inicializado: SRVs nulos de partida
+            D3D12_SHADER_RESOURCE_VIEW_DESC nullSrv = {};
+            nullSrv.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+            nullSrv.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+            nullSrv.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+            nullSrv.Texture2D.MipLevels = 1;
+            for (UINT i = 0; i < bindlessCapacity; ++i) {
+                device->CreateShaderResourceView(nullptr, &nullSrv, m_shaderVisibleHeap.GetCPUHandle(i));
+            }
+        }
+        m_bindlessFreeList.Initialize(bindlessCapacity, 1);
+        for (UINT i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+            m_transientRegions[i].Initialize(bindlessCapacity + i * transientPerFrame, transientPerFrame);
+        }
+        m_currentSlot = 0;
+
+        return true;
+    }
+
+    void D3D12DescriptorManager::Shutdown() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& pending : m_pendingFrees) {
+            pending.clear();
+        }
+        for (UINT type = 0; type < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES; ++type) {
+            m_cpuHeaps[type].Shutdown();
+        }
+        m_shaderVisibleHeap.Shutdown();
+        m_device = nullptr;
+    }
+
+    void D3D12DescriptorManager::BeginFrame(UINT frameSlot) {
+        UINT64 used = m_transientRegions[m_currentSlot].GetUsedBytes();
+        if (used > m_transientPeak) {
+            m_transientPeak = used;
+        }
+
+        m_currentSlot = frameSlot % MAX_FRAMES_IN_FLIGHT;
+        m_transientRegions[m_currentSlot].Reset();
+
+        // El fence de este slot se completó: lo liberado cuando se grabó ya no está en uso
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const DescriptorHandle& handle : m_pendingFrees[m_currentSlot]) {
+            ReleaseNow(handle);
+        }
+        m_pendingFrees[m_currentSlot].clear();
+    }
+
+    DescriptorHandle D3D12DescriptorManager::AllocatePersistent(D3D12_DESCRIPTOR_HEAP_TYPE type, UINT count) {
+        DescriptorHandle handle;
+        if (!m_device || count == 0 || type >= D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES) {
+            return handle;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TlsfAllocator::Allocation allocation = m_cpuFreeLists[type].Allocate(count);
+        if (!allocation.IsValid()) {
+            ++m_failedAllocations;
+            std::cerr << "Error: Out of persistent descriptors (type " << type << ")" << std::endl;
+            return handle;
+        }
+
+        handle.index = static_cast<UINT>(allocation.offset);
+        handle.count = count;
+        handle.increment = m_cpuHeaps[type].GetDescriptorSize();
+        handle.type = type;
+        handle.cpu = m_cpuHeaps[type].GetCPUHandle(handle.index);
+        handle.allocation = allocation.handle;
+        return handle;
+    }
+
+    DescriptorHandle D3D12DescriptorManager::AllocateBindless(UINT count) {
+        DescriptorHandle handle;
+        if (!m_device || count == 0) {
+            return handle;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TlsfAllocator::Allocation allocation = m_bindlessFreeList.Allocate(count);
+        if (!allocation.IsValid()) {
+            ++m_failedAllocations;
+            std::cerr << "Error: Out of bindless descriptors" << std::endl;
+            return handle;
+        }
+
+        handle.index = static_cast<UINT>(allocation.offset);
+        handle.count = count;
+        handle.increment = m_shaderVisibleHeap.GetDescriptorSize();
+        handle.type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        handle.bindless = true;
+        handle.cpu = m_shaderVisibleHeap.GetCPUHandle(handle.index);
+        handle.gpu = m_shaderVisibleHeap.GetGPUHandle(handle.index);
+        handle.allocation = allocation.handle;
+        return handle;
+    }
+
+    void D3D12DescriptorManager::Free(DescriptorHandle& handle) {
+        if (!handle.IsValid() || handle.allocation == TlsfAllocator::INVALID_HANDLE) {
+            handle = DescriptorHandle();
+            return;
+        }
+
+        // Frames grabados antes de esta llamada pueden seguir leyendo el descriptor
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingFrees[m_currentSlot].push_back(handle);
+        handle = DescriptorHandle();
+    }
+
+    void D3D12DescriptorManager::ReleaseNow(const DescriptorHandle& handle) {
+        if (handle.bindless) {
+            m_bindlessFreeList.Free(handle.allocation);
+        }
+        else {
+            m_cpuFreeLists[handle.type].Free(handle.allocation);
+        }
+    }
+
+    DescriptorHandle D3D12DescriptorManager::AllocateTransient(UINT count) {
+        DescriptorHandle handle;
+        if (!m_device || count == 0) {
+            return handle;
+        }
+
+        uint64_t index = m_transientRegions[m_currentSlot].Allocate(count, 1);
+        if (index == LinearAllocator::INVALID_OFFSET) {
+            return handle;
+        }
+
+        handle.index = static_cast<UINT>(index);
+        handle.count = count;
+        handle.increment = m_shaderVisibleHeap.GetDescriptorSize();
+        handle.type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        handle.cpu = m_shaderVisibleHeap.GetCPUHandle(handle.index);
+        handle.gpu = m_shaderVisibleHeap.GetGPUHandle(handle.index);
+        return handle;
+    }
+
+    D3D12_GPU_DESCRIPTOR_HANDLE D3D12DescriptorManager::CopyToTransient(const D3D12_CPU_DESCRIPTOR_HANDLE* sources, UINT count) {
+        DescriptorHandle destination = AllocateTransient(count);
+        if (!destination.IsValid()) {
+            return {};
+        }
+
+        // Descriptores de origen sueltos, destino contiguo: una sola llamada
+        UINT destinationCount = count;
+        std::vector<UINT> sourceCounts(count, 1);
+        m_device->CopyDescriptors(
+            1, &destination.cpu, &destinationCount,
+            count, sources, sourceCounts.data(),
+            D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV
+        );
+        return destination.gpu;
+    }
+
+    void D3D12DescriptorManager::BindHeaps(ID3D12GraphicsCommandList* commandList) const {
+        ID3D12DescriptorHeap* heaps[] = { m_shaderVisibleHeap.GetHeap() };
+        if (commandList && heaps[0]) {
+            commandList->SetDescriptorHeaps(1, heaps);
+        }
+    }
+
+    void D3D12DescriptorManager::BindBindlessTable(ID3D12GraphicsCommandList* commandList, UINT rootParameterIndex) const {
+        if (commandList && m_shaderVisibleHeap.GetHeap()) {
+            commandList->SetGraphicsRootDescriptorTable(rootParameterIndex, GetBindlessTableStart());
+        }
+    }
+
+    D3D12_RESOURCE_BINDING_TIER D3D12DescriptorManager::GetResourceBindingTier(ID3D12Device* device) {
+        // Si la consulta falla se asume el tier más restrictivo
+        D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
+        if (!device || FAILED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options)))) {
+            return D3D12_RESOURCE_BINDING_TIER_1;
+        }
+        return options.ResourceBindingTier;
+    }
+
+    UINT D3D12DescriptorManager::GetSupportedBindlessCapacity(ID3D12Device* device, UINT bindlessCapacity) {
+        if (GetResourceBindingTier(device) >= D3D12_RESOURCE_BINDING_TIER_2) {
+            return bindlessCapacity;
+        }
+        // Tier 1: límite de SRVs por etapa
+        return (std::min)(bindlessCapacity, static_cast<UINT>(D3D12_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT));
+    }
+
+    D3D12_DESCRIPTOR_RANGE1 D3D12DescriptorManager::GetBindlessRange(UINT bindlessCapacity) {
+        D3D12_DESCRIPTOR_RANGE1 range = {};
+        range.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+        range.NumDescriptors = bindlessCapacity;
+        range.BaseShaderRegister = 0;
+        range.RegisterSpace = 1;
+        // Datos volátiles: el render graph escribe y lee transitorios con la tabla ya enlazada
+        range.Flags = D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE | D3D12_DESCRIPTOR_RANGE_FLAG_DATA_VOLATILE;
+        range.OffsetInDescriptorsFromTableStart = 0;
+        return range;
+    }
+
+    HRESULT D3D12DescriptorManager::SerializeRootSignature(ID3D12Device* device, const D3D12_ROOT_SIGNATURE_DESC1& desc,
+        ID3DBlob** signature, ID3DBlob** error) {
+        D3D12_FEATURE_DATA_ROOT_SIGNATURE version = {};
+        version.HighestVersion = D3D_ROOT_SIGNATURE_VERSION_1_1;
+        if (SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_ROOT_SIGNATURE, &version, sizeof(version))) &&
+            version.HighestVersion >= D3D_ROOT_SIGNATURE_VERSION_1_1) {
+            D3D12_VERSIONED_ROOT_SIGNATURE_DESC versioned = {};
+            versioned.Version = D3D_ROOT_SIGNATURE_VERSION_1_1;
+            versioned.Desc_1_1 = desc;
+            return D3D12SerializeVersionedRootSignature(&versioned, signature, error);
+        }
+
+        // 1.0 trata todos los descriptores y datos como volátiles: se descartan los flags
+        std::vector<D3D12_ROOT_PARAMETER> parameters(desc.NumParameters);
+        std::vector<std::vector<D3D12_DESCRIPTOR_RANGE>> ranges(desc.NumParameters);
+        for (UINT i = 0; i < desc.NumParameters; ++i) {
+            const D3D12_ROOT_PARAMETER1& source = desc.pParameters[i];
+            parameters[i].ParameterType = source.ParameterType;
+            parameters[i].ShaderVisibility = source.ShaderVisibility;
+            switch (source.ParameterType) {
+            case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+                for (UINT r = 0; r < source.DescriptorTable.NumDescriptorRanges; ++r) {
+                    const D3D12_DESCRIPTOR_RANGE1& range = source.DescriptorTable.pDescriptorRanges[r];
+                    ranges[i].push_back({ range.RangeType, range.NumDescriptors, range.BaseShaderRegister,
+                        range.RegisterSpace, range.OffsetInDescriptorsFromTableStart });
+                }
+                parameters[i].DescriptorTable.NumDescriptorRanges = static_cast<UINT>(ranges[i].size());
+                parameters[i].DescriptorTable.pDescriptorRanges = ranges[i].data();
+                break;
+            case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+                parameters[i].Constants = source.Constants;
+                break;
+            default:
+                parameters[i].Descriptor.ShaderRegister = source.Descriptor.ShaderRegister;
+                parameters[i].Descriptor.RegisterSpace = source.Descriptor.RegisterSpace;
+                break;
+            }
+        }
+
+        D3D12_ROOT_SIGNATURE_DESC legacy = {};
+        legacy.NumParameters = desc.NumParameters;
+        legacy.pParameters = parameters.empty() ? nullptr : parameters.data();
+        legacy.NumStaticSamplers = desc.NumStaticSamplers;
+        legacy.pStaticSamplers = desc.pStaticSamplers;
+        legacy.Flags = desc.Flags;
+        return D3D12SerializeRootSignature(&legacy, D3D_ROOT_SIGNATURE_VERSION_1, signature, error);
+    }
+
+    DescriptorStats D3D12DescriptorManager::GetStats() const {
+        DescriptorStats stats;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (UINT type = 0; type < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES; ++type) {
+            stats.persistentUsed[type] = static_cast<UINT>(m_cpuFreeLists[type].GetStats().usedBytes);
+        }
+        stats.bindlessUsed = static_cast<UINT>(m_bindlessFreeList.GetStats().usedBytes);
+        stats.transientUsed = m_transientRegions[m_currentSlot].GetUsedBytes();
+        stats.transientPeak = m_transientPeak > stats.transientUsed ? m_transientPeak : stats.transientUsed;
+        stats.failedAllocations = m_failedAllocations;
+        for (UINT i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+            stats.failedAllocations += m_transientRegions[i].GetFailedCount();
+            stats.deferredFrees += m_pendingFrees[i].size();
+        }
+        return stats;
+    }
+
+} // namespace D3D12Core
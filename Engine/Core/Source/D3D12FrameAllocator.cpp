@@ -0,0 +1,98 @@
+#include "D3D12FrameAllocator.h"
+#include <iostream>
+
+namespace D3D12Core {
+
+    D3D12FrameAllocator::D3D12FrameAllocator() {
+    }
+
+    D3D12FrameAllocator::~D3D12FrameAllocator() {
+        Shutdown();
+    }
+
+    bool D3D12FrameAllocator::Initialize(ID3D12Device* device, UINT64 bytesPerFrame) {
+        // Cada región empieza alineada para que sus CBVs queden alineados a 256 bytes
+        const UINT64 alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+        m_bytesPerFrame = (bytesPerFrame + alignment - 1) & ~(alignment - 1);
+
+        D3D12_HEAP_PROPERTIES heapProps = {};
+        heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+        heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+
+        D3D12_RESOURCE_DESC resourceDesc = {};
+        resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        resourceDesc.Width = m_bytesPerFrame * MAX_FRAMES_IN_FLIGHT;
+        resourceDesc.Height = 1;
+        resourceDesc.DepthOrArraySize = 1;
+        resourceDesc.MipLevels = 1;
+        resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
+        resourceDesc.SampleDesc.Count = 1;
+        resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        resourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+        HRESULT hr = device->CreateCommittedResource(
+            &heapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &resourceDesc,
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            nullptr,
+            IID_PPV_ARGS(&m_resource)
+        );
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to create frame allocator heap" << std::endl;
+            return false;
+        }
+
+        D3D12_RANGE readRange = { 0, 0 };
+        void* mappedData = nullptr;
+        hr = m_resource->Map(0, &readRange, &mappedData);
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to map frame allocator heap" << std::endl;
+            return false;
+        }
+        m_mappedData = static_cast<BYTE*>(mappedData);
+        m_gpuBase = m_resource->GetGPUVirtualAddress();
+
+        for (UINT i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+            m_regions[i].Initialize(i * m_bytesPerFrame, m_bytesPerFrame);
+        }
+        m_currentSlot = 0;
+
+        return true;
+    }
+
+    void D3D12FrameAllocator::Shutdown() {
+        if (m_resource && m_mappedData) {
+            m_resource->Unmap(0, nullptr);
+            m_mappedData = nullptr;
+        }
+        m_resource.Reset();
+        m_gpuBase = 0;
+    }
+
+    void D3D12FrameAllocator::BeginFrame(UINT frameSlot) {
+        m_currentSlot = frameSlot % MAX_FRAMES_IN_FLIGHT;
+
+        // El fence de este slot ya se completó: la GPU no lee nada de la región
+        m_regions[m_currentSlot].Reset();
+    }
+
+    DynamicAllocation D3D12FrameAllocator::Allocate(UINT64 size, UINT64 alignment) {
+        DynamicAllocation allocation;
+        if (!m_mappedData || size == 0) {
+            return allocation;
+        }
+
+        UINT64 offset = m_regions[m_currentSlot].Allocate(size, alignment);
+        if (offset == LinearAllocator::INVALID_OFFSET) {
+            return allocation;
+        }
+
+        allocation.cpuAddress = m_mappedData + offset;
+        allocation.gpuAddress = m_gpuBase + offset;
+        allocation.size = size;
+        return allocation;
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,404 @@
+#include "D3D12HeapAllocator.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+
+namespace D3D12Core {
+
+    D3D12HeapAllocator::D3D12HeapAllocator() {
+    }
+
+    D3D12HeapAllocator::~D3D12HeapAllocator() {
+        Shutdown();
+    }
+
+    bool D3D12HeapAllocator::Initialize(ID3D12Device* device, UINT64 heapBlockSize, UINT64 bufferBlockSize) {
+        m_device = device;
+        m_bufferBlockSize = bufferBlockSize;
+
+        // Flags compatibles con Resource Heap Tier 1: cada heap solo admite una categoría
+        Pool& bufferDefault = m_pools[POOL_BUFFER_DEFAULT];
+        bufferDefault.name = "Buffers (default)";
+        bufferDefault.heapType = D3D12_HEAP_TYPE_DEFAULT;
+        bufferDefault.sharedBuffer = true;
+        bufferDefault.blockSize = bufferBlockSize;
+        bufferDefault.alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+
+        Pool& bufferUpload = m_pools[POOL_BUFFER_UPLOAD];
+        bufferUpload.name = "Buffers (upload)";
+        bufferUpload.heapType = D3D12_HEAP_TYPE_UPLOAD;
+        bufferUpload.sharedBuffer = true;
+        bufferUpload.blockSize = bufferBlockSize;
+        bufferUpload.alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+
+        Pool& placedBuffers = m_pools[POOL_PLACED_BUFFERS];
+        placedBuffers.name = "Placed buffers";
+        placedBuffers.heapType = D3D12_HEAP_TYPE_DEFAULT;
+        placedBuffers.heapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+        placedBuffers.blockSize = heapBlockSize;
+        placedBuffers.alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+        Pool& placedTextures = m_pools[POOL_PLACED_TEXTURES];
+        placedTextures.name = "Placed textures";
+        placedTextures.heapType = D3D12_HEAP_TYPE_DEFAULT;
+        placedTextures.heapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+        placedTextures.blockSize = heapBlockSize;
+        placedTextures.alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+        Pool& placedTargets = m_pools[POOL_PLACED_RENDER_TARGETS];
+        placedTargets.name = "Placed RT/DS";
+        placedTargets.heapType = D3D12_HEAP_TYPE_DEFAULT;
+        placedTargets.heapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+        placedTargets.blockSize = heapBlockSize;
+        placedTargets.alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+        // Un heap alineado a 64 KB no puede alojar recursos que piden 4 MB
+        Pool& placedMsaaTargets = m_pools[POOL_PLACED_MSAA_TARGETS];
+        placedMsaaTargets.name = "Placed RT/DS (MSAA)";
+        placedMsaaTargets.heapType = D3D12_HEAP_TYPE_DEFAULT;
+        placedMsaaTargets.heapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+        placedMsaaTargets.blockSize = (heapBlockSize + D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT - 1) &
+            ~static_cast<UINT64>(D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT - 1);
+        placedMsaaTargets.alignment = D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT;
+
+        Pool& placedUpload = m_pools[POOL_PLACED_BUFFERS_UPLOAD];
+        placedUpload.name = "Placed buffers (upload)";
+        placedUpload.heapType = D3D12_HEAP_TYPE_UPLOAD;
+        placedUpload.heapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+        placedUpload.blockSize = heapBlockSize;
+        placedUpload.alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+        return m_device != nullptr;
+    }
+
+    void D3D12HeapAllocator::Shutdown() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Pool& pool : m_pools) {
+            for (auto& block : pool.blocks) {
+                if (block && block->buffer && block->mappedData) {
+                    block->buffer->Unmap(0, nullptr);
+                }
+            }
+            pool.blocks.clear();
+        }
+        m_device = nullptr;
+    }
+
+    D3D12HeapAllocator::Block* D3D12HeapAllocator::CreateBlock(Pool& pool, UINT64 size) {
+        auto block = std::make_unique<Block>();
+
+        D3D12_HEAP_PROPERTIES heapProps = {};
+        heapProps.Type = pool.heapType;
+        heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+
+        if (pool.sharedBuffer) {
+            // Un único buffer por bloque; los sub-rangos comparten su estado. Los buffers admiten
+            // acceso simultáneo entre colas, así que copiar a un rango mientras otro se lee es válido
+            D3D12_RESOURCE_DESC resourceDesc = {};
+            resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+            resourceDesc.Width = size;
+            resourceDesc.Height = 1;
+            resourceDesc.DepthOrArraySize = 1;
+            resourceDesc.MipLevels = 1;
+            resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
+            resourceDesc.SampleDesc.Count = 1;
+            resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+            resourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+            D3D12_RESOURCE_STATES initialState = (pool.heapType == D3D12_HEAP_TYPE_UPLOAD)
+                ? D3D12_RESOURCE_STATE_GENERIC_READ
+                : D3D12_RESOURCE_STATE_COMMON;
+
+            HRESULT hr = m_device->CreateCommittedResource(
+                &heapProps,
+                D3D12_HEAP_FLAG_NONE,
+                &resourceDesc,
+                initialState,
+                nullptr,
+                IID_PPV_ARGS(&block->buffer)
+            );
+            if (FAILED(hr)) {
+                std::cerr << "Error: Failed to create shared buffer block (" << pool.name << ")" << std::endl;
+                return nullptr;
+            }
+
+            if (pool.heapType == D3D12_HEAP_TYPE_UPLOAD) {
+                D3D12_RANGE readRange = { 0, 0 };
+                void* mappedData = nullptr;
+                hr = block->buffer->Map(0, &readRange, &mappedData);
+                if (FAILED(hr)) {
+                    std::cerr << "Error: Failed to map shared buffer block" << std::endl;
+                    return nullptr;
+                }
+                block->mappedData = static_cast<BYTE*>(mappedData);
+            }
+            block->gpuBase = block->buffer->GetGPUVirtualAddress();
+        }
+        else {
+            D3D12_HEAP_DESC heapDesc = {};
+            heapDesc.SizeInBytes = size;
+            heapDesc.Properties = heapProps;
+            heapDesc.Alignment = pool.alignment;
+            heapDesc.Flags = pool.heapFlags;
+
+            HRESULT hr = m_device->CreateHeap(&heapDesc, IID_PPV_ARGS(&block->heap));
+            if (FAILED(hr)) {
+                std::cerr << "Error: Failed to create GPU heap (" << pool.name << ")" << std::endl;
+                return nullptr;
+            }
+        }
+
+        block->tlsf.Initialize(size, pool.alignment);
+
+        // Reutilizar huecos de bloques liberados para que los índices existentes sigan siendo válidos
+        for (auto& slot : pool.blocks) {
+            if (!slot) {
+                slot = std::move(block);
+                return slot.get();
+            }
+        }
+        pool.blocks.push_back(std::move(block));
+        return pool.blocks.back().get();
+    }
+
+    bool D3D12HeapAllocator::AllocateFromPool(UINT poolIndex, UINT64 size, UINT64 alignment,
+        UINT& blockIndex, TlsfAllocator::Allocation& allocation) {
+        Pool& pool = m_pools[poolIndex];
+
+        for (UINT i = 0; i < pool.blocks.size(); ++i) {
+            if (!pool.blocks[i]) {
+                continue;
+            }
+            allocation = pool.blocks[i]->tlsf.Allocate(size, alignment);
+            if (allocation.IsValid()) {
+                blockIndex = i;
+                return true;
+            }
+        }
+
+        // Ningún bloque tiene un hueco suficiente: crear otro (dedicado si el recurso es mayor)
+        UINT64 blockSize = pool.blockSize;
+        if (size + alignment > blockSize) {
+            blockSize = (size + alignment + pool.alignment - 1) & ~(pool.alignment - 1);
+        }
+        Block* block = CreateBlock(pool, blockSize);
+        if (!block) {
+            return false;
+        }
+        allocation = block->tlsf.Allocate(size, alignment);
+        if (!allocation.IsValid()) {
+            return false;
+        }
+        for (UINT i = 0; i < pool.blocks.size(); ++i) {
+            if (pool.blocks[i].get() == block) {
+                blockIndex = i;
+                break;
+            }
+        }
+        return true;
+    }
+
+    void D3D12HeapAllocator::FreeFromPool(UINT poolIndex, UINT blockIndex, uint32_t handle) {
+        Pool& pool = m_pools[poolIndex];
+        if (blockIndex >= pool.blocks.size() || !pool.blocks[blockIndex]) {
+            return;
+        }
+
+        Block& block = *pool.blocks[blockIndex];
+        block.tlsf.Free(handle);
+
+        // Devolver al driver los bloques vacíos, salvo uno por pool para no alternar crear/destruir
+        if (block.tlsf.IsEmpty()) {
+            UINT liveBlocks = 0;
+            for (const auto& other : pool.blocks) {
+                if (other) {
+                    ++liveBlocks;
+                }
+            }
+            if (liveBlocks > 1) {
+                if (block.buffer && block.mappedData) {
+                    block.buffer->Unmap(0, nullptr);
+                }
+                pool.blocks[blockIndex].reset();
+            }
+        }
+    }
+
+    BufferRange D3D12HeapAllocator::AllocateBuffer(UINT64 size, D3D12_HEAP_TYPE heapType, UINT64 alignment) {
+        BufferRange range;
+        if (!m_device || size == 0 || size > GetMaxBufferRangeSize()) {
+            return range;
+        }
+        if (heapType != D3D12_HEAP_TYPE_DEFAULT && heapType != D3D12_HEAP_TYPE_UPLOAD) {
+            return range;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        UINT poolIndex = (heapType == D3D12_HEAP_TYPE_UPLOAD) ? POOL_BUFFER_UPLOAD : POOL_BUFFER_DEFAULT;
+        UINT blockIndex = 0;
+        TlsfAllocator::Allocation allocation;
+        if (!AllocateFromPool(poolIndex, size, alignment, blockIndex, allocation)) {
+            std::cerr << "Error: Failed to sub-allocate buffer range" << std::endl;
+            return range;
+        }
+
+        Block& block = *m_pools[poolIndex].blocks[blockIndex];
+        range.resource = block.buffer.Get();
+        range.offset = allocation.offset;
+        range.size = size;
+        range.gpuAddress = block.gpuBase + allocation.offset;
+        range.cpuAddress = block.mappedData ? block.mappedData + allocation.offset : nullptr;
+        range.pool = poolIndex;
+        range.block = blockIndex;
+        range.handle = allocation.handle;
+        return range;
+    }
+
+    void D3D12HeapAllocator::FreeBuffer(BufferRange& range) {
+        if (!range.IsValid()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        FreeFromPool(range.pool, range.block, range.handle);
+        range = BufferRange();
+    }
+
+    UINT D3D12HeapAllocator::SelectPlacedPool(const D3D12_RESOURCE_DESC& desc, D3D12_HEAP_TYPE heapType) {
+        if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) {
+            return (heapType == D3D12_HEAP_TYPE_UPLOAD) ? POOL_PLACED_BUFFERS_UPLOAD : POOL_PLACED_BUFFERS;
+        }
+        if (desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) {
+            return desc.SampleDesc.Count > 1 ? POOL_PLACED_MSAA_TARGETS : POOL_PLACED_RENDER_TARGETS;
+        }
+        return POOL_PLACED_TEXTURES;
+    }
+
+    bool D3D12HeapAllocator::CreatePlacedResource(
+        const D3D12_RESOURCE_DESC& desc,
+        D3D12_HEAP_TYPE heapType,
+        D3D12_RESOURCE_STATES initialState,
+        const D3D12_CLEAR_VALUE* clearValue,
+        PlacedAllocation& allocation
+    ) {
+        allocation = PlacedAllocation();
+        if (!m_device) {
+            return false;
+        }
+        if (desc.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER && heapType != D3D12_HEAP_TYPE_DEFAULT) {
+            std::cerr << "Error: Placed textures are only supported in the default heap" << std::endl;
+            return false;
+        }
+
+        // Tamaño y alineación reales según el driver (64 KB, o 4 MB para MSAA)
+        D3D12_RESOURCE_ALLOCATION_INFO info = m_device->GetResourceAllocationInfo(0, 1, &desc);
+        if (info.SizeInBytes == UINT64_MAX) {
+            std::cerr << "Error: Invalid resource description for placed resource" << std::endl;
+            return false;
+        }
+
+        UINT poolIndex = SelectPlacedPool(desc, heapType);
+        if (info.Alignment > m_pools[poolIndex].alignment) {
+            std::cerr << "Error: Placed resource alignment (" << info.Alignment << ") exceeds the heap alignment of "
+                      << m_pools[poolIndex].name << std::endl;
+            return false;
+        }
+        UINT blockIndex = 0;
+        TlsfAllocator::Allocation range;
+        ID3D12Heap* heap = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!AllocateFromPool(poolIndex, info.SizeInBytes, info.Alignment, blockIndex, range)) {
+                std::cerr << "Error: Failed to sub-allocate GPU heap" << std::endl;
+                return false;
+            }
+            heap = m_pools[poolIndex].blocks[blockIndex]->heap.Get();
+        }
+
+        // Crear el recurso fuera del lock: el rango ya es exclusivo de esta llamada
+        HRESULT hr = m_device->CreatePlacedResource(
+            heap,
+            range.offset,
+            &desc,
+            initialState,
+            clearValue,
+            IID_PPV_ARGS(&allocation.resource)
+        );
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to create placed resource" << std::endl;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            FreeFromPool(poolIndex, blockIndex, range.handle);
+            return false;
+        }
+
+        allocation.heapOffset = range.offset;
+        allocation.size = range.size;
+        allocation.pool = poolIndex;
+        allocation.block = blockIndex;
+        allocation.handle = range.handle;
+        return true;
+    }
+
+    void D3D12HeapAllocator::FreePlaced(PlacedAllocation& allocation) {
+        if (!allocation.IsValid()) {
+            return;
+        }
+        // El recurso colocado mantiene una referencia al heap: liberarlo antes que el rango
+        allocation.resource.Reset();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        FreeFromPool(allocation.pool, allocation.block, allocation.handle);
+        allocation = PlacedAllocation();
+    }
+
+    std::string D3D12HeapAllocator::BuildReport() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        std::ostringstream report;
+        report << std::fixed << std::setprecision(2);
+        for (const Pool& pool : m_pools) {
+            UINT64 capacity = 0;
+            UINT64 used = 0;
+            UINT64 largestFree = 0;
+            UINT allocations = 0;
+            UINT blocks = 0;
+            for (const auto& block : pool.blocks) {
+                if (!block) {
+                    continue;
+                }
+                TlsfAllocator::Stats stats = block->tlsf.GetStats();
+                capacity += stats.capacity;
+                used += stats.usedBytes;
+                allocations += stats.allocationCount;
+                if (stats.largestFreeBlock > largestFree) {
+                    largestFree = stats.largestFreeBlock;
+                }
+                ++blocks;
+            }
+            if (blocks == 0) {
+                continue;
+            }
+
+            UINT64 freeBytes = capacity - used;
+            double fragmentation = freeBytes > 0 ? 1.0 - static_cast<double>(largestFree) / freeBytes : 0.0;
+            report << "[" << pool.name << "] Bloques: " << blocks
+                << " | Asignaciones: " << allocations
+                << " | Usado: " << used / (1024.0 * 1024.0) << " / " << capacity / (1024.0 * 1024.0) << " MB"
+                << " | Mayor hueco: " << largestFree / (1024.0 * 1024.0) << " MB"
+                << " | Fragmentacion: " << fragmentation * 100.0 << "%\n";
+            for (const auto& block : pool.blocks) {
+                if (block) {
+                    report << "    " << block->tlsf.BuildReport();
+                }
+            }
+        }
+        return report.str();
+    }
+
+    void D3D12HeapAllocator::LogReport() const {
+        std::string report = BuildReport();
+        std::cout << "=== Memoria de GPU (sub-asignador) ===" << std::endl;
+        std::cout << (report.empty() ? "Sin asignaciones\n" : report) << std::flush;
+    }
+
+} // namespace D3D12Core
@@ -1,5 +1,6 @@
 #include "D3D12Material.h"
 #include "D3D12PipelineState.h"
+#include "D3D12DescriptorManager.h"
 #include "Shader.h"
 #include <fstream>
 #include <sstream>
@@ -15,7 +16,10 @@ namespace D3D12Core {
     }
 
     D3D12Material::~D3D12Material() {
-        if (m_constantBufferMapped && m_constantBuffer) {
+        if (m_heapAllocator) {
+            m_heapAllocator->FreeBuffer(m_constantBufferRange);
+        }
+        else if (m_constantBufferMapped && m_constantBuffer) {
             m_constantBuffer->Unmap(0, nullptr);
         }
     }
@@ -24,7 +28,8 @@ namespace D3D12Core {
         ID3D12Device* device,
         const std::string& materialName,
         const std::string& vertexShaderPath,
-        const std::string& pixelShaderPath)
+        const std::string& pixelShaderPath,
+        D3D12HeapAllocator* heapAllocator)
     {
         m_device = device;
         m_materialName = materialName;
@@ -45,7 +50,19 @@ namespace D3D12Core {
             return false;
         }
 
-        // Crear constant buffer para parámetros
+        // Crear constant buffer para parámetros (un rango de un upload heap compartido si hay allocator)
+        if (heapAllocator) {
+            m_constantBufferRange = heapAllocator->AllocateBuffer(m_constantBufferSize, D3D12_HEAP_TYPE_UPLOAD);
+            if (!m_constantBufferRange.IsValid()) {
+                std::cerr << "Error: Failed to sub-allocate material constant buffer" << std::endl;
+                return false;
+            }
+            m_heapAllocator = heapAllocator;
+            m_constantBuffer = m_constantBufferRange.resource;
+            m_constantBufferMapped = m_constantBufferRange.cpuAddress;
+            return true;
+        }
+
         D3D12_HEAP_PROPERTIES heapProps = {};
         heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
         heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
@@ -192,17 +209,26 @@ namespace D3D12Core {
     void D3D12Material::CreateRootSignature() {
         // Crear root signature compatible con el PSO básico
         // Por ahora, usar la misma estructura que el básico para compatibilidad
-        D3D12_ROOT_PARAMETER rootParams[1] = {};
+        D3D12_ROOT_PARAMETER1 rootParams[2] = {};
         
         // Constant buffer para MVP (register b0) - mismo que el básico
         // Nota: Los parámetros del material se pueden agregar después sin romper compatibilidad
         rootParams[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
         rootParams[0].Descriptor.ShaderRegister = 0; // b0 para MVP (igual que el básico)
         rootParams[0].Descriptor.RegisterSpace = 0;
+        rootParams[0].Descriptor.Flags = D3D12_ROOT_DESCRIPTOR_FLAG_DATA_STATIC_WHILE_SET_AT_EXECUTE;
         rootParams[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
 
-        D3D12_ROOT_SIGNATURE_DESC rootSigDesc = {};
-        rootSigDesc.NumParameters = 1;
+        // Tabla bindless (t0, space1): las texturas del material se indexan por entero
+        D3D12_DESCRIPTOR_RANGE1 bindlessRange = D3D12DescriptorManager::GetBindlessRange(
+            D3D12DescriptorManager::GetSupportedBindlessCapacity(m_device));
+        rootParams[ROOT_PARAMETER_BINDLESS_TABLE].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+        rootParams[ROOT_PARAMETER_BINDLESS_TABLE].DescriptorTable.NumDescriptorRanges = 1;
+        rootParams[ROOT_PARAMETER_BINDLESS_TABLE].DescriptorTable.pDescriptorRanges = &bindlessRange;
+        rootParams[ROOT_PARAMETER_BINDLESS_TABLE].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+        D3D12_ROOT_SIGNATURE_DESC1 rootSigDesc = {};
+        rootSigDesc.NumParameters = 2;
         rootSigDesc.pParameters = rootParams;
         rootSigDesc.NumStaticSamplers = 0;
         rootSigDesc.pStaticSamplers = nullptr;
@@ -210,7 +236,7 @@ namespace D3D12Core {
 
         ComPtr<ID3DBlob> signature;
         ComPtr<ID3DBlob> error;
-        HRESULT hr = D3D12SerializeRootSignature(&rootSigDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error);
+        HRESULT hr = D3D12DescriptorManager::SerializeRootSignature(m_device, rootSigDesc, &signature, &error);
 
         if (FAILED(hr)) {
             std::cerr << "Error: Failed to serialize material root signature" << std::endl;
@@ -290,12 +316,9 @@ namespace D3D12Core {
         psoDesc.VS = { vsBytecode.data(), vsBytecode.size() };
         psoDesc.PS = { psBytecode.data(), psBytecode.size() };
         
-        // Input layout (debe coincidir exactamente con el PSO básico)
-        D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
-            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-            { "COLOR", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
-        };
-        psoDesc.InputLayout = { inputLayout, _countof(inputLayout) };
+        // Input layout: el mismo que el PSO básico (BuildInputLayout con el formato de Vertex)
+        D3D12_INPUT_ELEMENT_DESC inputLayout[MAX_VERTEX_ELEMENTS];
+        psoDesc.InputLayout = { inputLayout, BuildInputLayout(VertexFormat(), false, false, inputLayout) };
         
         // Blend state - debe coincidir con el básico
         psoDesc.BlendState.RenderTarget[0].BlendEnable = FALSE;
@@ -1,12 +1,11 @@
 #include "D3D12Mesh.h"
 #include "D3D12Buffer.h"
 #include "D3D12PipelineState.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
 #include <d3d12.h>
-#include <wrl/client.h>
 #include <iostream>
 
-using Microsoft::WRL::ComPtr;
-
 namespace D3D12Core {
 
     D3D12Mesh::D3D12Mesh() {
@@ -18,114 +17,155 @@ namespace D3D12Core {
 
     bool D3D12Mesh::Initialize(
         ID3D12Device* device,
-        ID3D12CommandQueue* commandQueue,
+        D3D12UploadManager* uploadManager,
         const std::vector<Vertex>& vertices,
-        const std::vector<UINT>& indices
+        const std::vector<UINT>& indices,
+        D3D12HeapAllocator* heapAllocator,
+        const VertexFormat& format
     ) {
-        // Crear vertex buffer (los buffers siempre se crean en COMMON, luego se transicionan)
-        UINT64 vertexBufferSize = vertices.size() * sizeof(Vertex);
-        m_vertexBuffer = std::make_unique<D3D12Buffer>();
-        if (!m_vertexBuffer->Initialize(device, vertexBufferSize, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER)) {
+        // Vértices en el formato pedido: un buffer por stream
+        EncodedVertices encoded;
+        if (!EncodeVertices(vertices.data(), static_cast<uint32_t>(vertices.size()), format, encoded)) {
+            std::cerr << "Error: Mesh without vertices in D3D12Mesh::Initialize" << std::endl;
             return false;
         }
+        m_format = format;
+        m_quantization = encoded.quantization;
+
+        // Crear vertex buffers (en COMMON; la cola directa los promociona implícitamente tras la copia)
+        for (uint32_t stream = 0; stream < format.GetStreamCount(); stream++) {
+            UINT64 vertexBufferSize = encoded.streams[stream].size();
+            m_vertexBuffers[stream] = std::make_unique<D3D12Buffer>();
+            bool vertexCreated = heapAllocator
+                ? m_vertexBuffers[stream]->Initialize(heapAllocator, vertexBufferSize)
+                : m_vertexBuffers[stream]->Initialize(device, vertexBufferSize);
+            if (!vertexCreated) {
+                return false;
+            }
+        }
 
-        // Crear index buffer (los buffers siempre se crean en COMMON, luego se transicionan)
-        UINT64 indexBufferSize = indices.size() * sizeof(UINT);
+        // Crear index buffer (en COMMON; la cola directa lo promociona implícitamente tras la copia).
+        // De 16 bits si el vertex buffer cabe: la mitad de memoria y de ancho de banda del input assembler
+        const bool shortIndices = MeshOptimizer::SelectIndexFormat(static_cast<uint32_t>(vertices.size())) == RHIFormat::R16Uint;
+        std::vector<uint16_t> packedIndices;
+        if (shortIndices) {
+            MeshOptimizer::PackIndices16(indices.data(), static_cast<uint32_t>(indices.size()), packedIndices);
+        }
+        const void* indexData = shortIndices ? static_cast<const void*>(packedIndices.data()) : indices.data();
+        UINT64 indexBufferSize = indices.size() * (shortIndices ? sizeof(uint16_t) : sizeof(UINT));
         m_indexBuffer = std::make_unique<D3D12Buffer>();
-        if (!m_indexBuffer->Initialize(device, indexBufferSize, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_INDEX_BUFFER)) {
+        bool indexCreated = heapAllocator
+            ? m_indexBuffer->Initialize(heapAllocator, indexBufferSize)
+            : m_indexBuffer->Initialize(device, indexBufferSize);
+        if (!indexCreated) {
             return false;
         }
 
-        m_indexCount = static_cast<UINT>(indices.size());
-
-        // Crear command list temporal para subir datos
-        ComPtr<ID3D12CommandAllocator> tempAllocator;
-        ComPtr<ID3D12GraphicsCommandList> tempCommandList;
+        m_lods.assign(1, MeshLod());
+        m_lods[0].indexCount = static_cast<UINT>(indices.size());
 
-        HRESULT hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&tempAllocator));
-        if (FAILED(hr)) {
-            std::cerr << "Error: Failed to create temp command allocator" << std::endl;
+        if (!uploadManager) {
+            std::cerr << "Error: Upload manager is null in D3D12Mesh::Initialize" << std::endl;
             return false;
         }
 
-        hr = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, tempAllocator.Get(), nullptr, IID_PPV_ARGS(&tempCommandList));
-        if (FAILED(hr)) {
-            std::cerr << "Error: Failed to create temp command list" << std::endl;
-            return false;
+        // Encolar todas las copias en el lote actual de la cola de copia (sin bloquear)
+        m_uploadToken = uploadManager->UploadBuffer(m_indexBuffer.get(), indexData, indexBufferSize);
+        for (uint32_t stream = 0; stream < format.GetStreamCount() && m_uploadToken.IsValid(); stream++) {
+            UploadToken vertexToken = uploadManager->UploadBuffer(m_vertexBuffers[stream].get(), encoded.streams[stream].data(),
+                encoded.streams[stream].size());
+            if (!vertexToken.IsValid() || vertexToken.fenceValue > m_uploadToken.fenceValue) {
+                m_uploadToken = vertexToken;
+            }
         }
-
-        // Subir datos
-        if (!m_vertexBuffer->UploadData(device, tempCommandList.Get(), vertices.data(), vertexBufferSize)) {
+        if (!m_uploadToken.IsValid()) {
+            std::cerr << "Error: Failed to queue mesh upload" << std::endl;
             return false;
         }
 
-        if (!m_indexBuffer->UploadData(device, tempCommandList.Get(), indices.data(), indexBufferSize)) {
-            return false;
+        // Crear vertex buffer views
+        for (uint32_t stream = 0; stream < format.GetStreamCount(); stream++) {
+            m_vertexBufferViews[stream].BufferLocation = m_vertexBuffers[stream]->GetGPUVirtualAddress();
+            m_vertexBufferViews[stream].SizeInBytes = static_cast<UINT>(encoded.streams[stream].size());
+            m_vertexBufferViews[stream].StrideInBytes = format.GetStride(stream);
         }
 
-        // Cerrar y ejecutar
-        tempCommandList->Close();
-        ID3D12CommandList* commandLists[] = { tempCommandList.Get() };
-        
-        // Obtener la interfaz ID3D12CommandQueue
-        ID3D12CommandQueue* d3dCommandQueue = commandQueue;
-        d3dCommandQueue->ExecuteCommandLists(1, commandLists);
-
-        // Esperar a que termine la copia
-        ComPtr<ID3D12Fence> fence;
-        UINT64 fenceValue = 1;
-        hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence));
-        if (SUCCEEDED(hr)) {
-            ID3D12CommandQueue* d3dCommandQueue = commandQueue;
-            hr = d3dCommandQueue->Signal(fence.Get(), fenceValue);
-            if (SUCCEEDED(hr)) {
-                HANDLE fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
-                if (fenceEvent) {
-                    if (fence->GetCompletedValue() < fenceValue) {
-                        hr = fence->SetEventOnCompletion(fenceValue, fenceEvent);
-                        if (SUCCEEDED(hr)) {
-                            WaitForSingleObject(fenceEvent, INFINITE);
-                        }
-                    }
-                    CloseHandle(fenceEvent);
-                }
-            }
-        }
-
-        // Crear vertex buffer view
-        m_vertexBufferView.BufferLocation = m_vertexBuffer->GetGPUVirtualAddress();
-        m_vertexBufferView.SizeInBytes = static_cast<UINT>(vertexBufferSize);
-        m_vertexBufferView.StrideInBytes = sizeof(Vertex);
-
         // Crear index buffer view
         m_indexBufferView.BufferLocation = m_indexBuffer->GetGPUVirtualAddress();
         m_indexBufferView.SizeInBytes = static_cast<UINT>(indexBufferSize);
-        m_indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+        m_indexBufferView.Format = shortIndices ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
 
         return true;
     }
 
+    bool D3D12Mesh::Initialize(
+        ID3D12Device* device,
+        D3D12UploadManager* uploadManager,
+        const std::vector<Vertex>& vertices,
+        const MeshLodChain& lods,
+        D3D12HeapAllocator* heapAllocator,
+        const VertexFormat& format
+    ) {
+        if (!Initialize(device, uploadManager, vertices, lods.GetIndices(), heapAllocator, format)) {
+            return false;
+        }
+        m_lods.assign(lods.GetLods(), lods.GetLods() + lods.GetLodCount());
+        return true;
+    }
+
     void D3D12Mesh::Shutdown() {
         m_indexBuffer.reset();
-        m_vertexBuffer.reset();
+        for (std::unique_ptr<D3D12Buffer>& vertexBuffer : m_vertexBuffers) {
+            vertexBuffer.reset();
+        }
+        m_lods.clear();
     }
 
-    void D3D12Mesh::Draw(ID3D12GraphicsCommandList* commandList) {
+    void D3D12Mesh::Bind(ID3D12GraphicsCommandList* commandList) {
+        commandList->IASetVertexBuffers(0, m_format.GetStreamCount(), m_vertexBufferViews);
+        commandList->IASetIndexBuffer(&m_indexBufferView);
+        commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    }
+
+    void D3D12Mesh::BindPositions(ID3D12GraphicsCommandList* commandList) {
+        // Entrelazado, el stream 0 lleva también el color: el layout solo de posición lo ignora
+        commandList->IASetVertexBuffers(0, 1, &m_vertexBufferViews[0]);
+        commandList->IASetIndexBuffer(&m_indexBufferView);
+        commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    }
+
+    void D3D12Mesh::Draw(ID3D12GraphicsCommandList* commandList, UINT lod) {
         if (!commandList) {
             std::cerr << "Error: Command list is null in Draw()" << std::endl;
             return;
         }
         
-        if (m_indexCount == 0) {
+        if (GetIndexCount() == 0) {
             std::cerr << "Error: Index count is 0 in Draw()" << std::endl;
             return;
         }
         
-        commandList->IASetVertexBuffers(0, 1, &m_vertexBufferView);
+        Bind(commandList);
+        const MeshLod& range = GetLod(lod);
+        commandList->DrawIndexedInstanced(range.indexCount, 1, range.startIndex, 0, 0);
+    }
+
+    void D3D12Mesh::DrawInstanced(ID3D12GraphicsCommandList* commandList, const D3D12_VERTEX_BUFFER_VIEW& instanceView,
+        UINT instanceCount, UINT startInstance, UINT lod) {
+        if (!commandList || GetIndexCount() == 0 || instanceCount == 0) {
+            std::cerr << "Error: DrawInstanced without command list, indices or instances" << std::endl;
+            return;
+        }
+
+        const UINT streamCount = m_format.GetStreamCount();
+        D3D12_VERTEX_BUFFER_VIEW views[MAX_VERTEX_STREAMS + 1] = {};
+        std::copy(m_vertexBufferViews, m_vertexBufferViews + streamCount, views);
+        views[streamCount] = instanceView;
+        commandList->IASetVertexBuffers(0, streamCount + 1, views);
         commandList->IASetIndexBuffer(&m_indexBufferView);
         commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-        commandList->DrawIndexedInstanced(m_indexCount, 1, 0, 0, 0);
+        const MeshLod& range = GetLod(lod);
+        commandList->DrawIndexedInstanced(range.indexCount, instanceCount, range.startIndex, 0, startInstance);
     }
 
 } // namespace D3D12Core
-
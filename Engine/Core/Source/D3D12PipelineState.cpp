@@ -1,4 +1,6 @@
 #include "D3D12PipelineState.h"
+#include "D3D12DescriptorManager.h"
+#include "D3D12RHI.h"
 #include <d3d12.h>
 #include <d3dcompiler.h>
 #include <d3dcommon.h>
@@ -11,6 +13,24 @@ using Microsoft::WRL::ComPtr;
 
 namespace D3D12Core {
 
+    UINT BuildInputLayout(const VertexFormat& format, bool instanced, bool positionOnly,
+        D3D12_INPUT_ELEMENT_DESC elements[MAX_VERTEX_ELEMENTS]) {
+        VertexElement vertexElements[MAX_VERTEX_ELEMENTS];
+        const uint32_t count = BuildVertexElements(format, instanced, positionOnly, vertexElements);
+        for (uint32_t i = 0; i < count; i++) {
+            const VertexElement& element = vertexElements[i];
+            elements[i].SemanticName = element.semantic;
+            elements[i].SemanticIndex = element.semanticIndex;
+            elements[i].Format = ToDXGIFormat(element.format);
+            elements[i].InputSlot = element.slot;
+            elements[i].AlignedByteOffset = element.offset;
+            elements[i].InputSlotClass = element.perInstance
+                ? D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA : D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
+            elements[i].InstanceDataStepRate = element.perInstance ? 1 : 0;
+        }
+        return count;
+    }
+
     D3D12PipelineState::D3D12PipelineState() {
     }
 
@@ -22,8 +42,14 @@ namespace D3D12Core {
         ID3D12Device* device,
         const Shader& vertexShader,
         const Shader& pixelShader,
-        DXGI_FORMAT rtvFormat
+        DXGI_FORMAT rtvFormat,
+        bool instanced,
+        const VertexFormat& vertexFormat,
+        bool indirect
     ) {
+        m_instanced = instanced;
+        m_indirect = indirect && !instanced;
+        m_vertexFormat = vertexFormat;
         if (!CreateRootSignature(device, true)) {
             return false;
         }
@@ -32,10 +58,16 @@ namespace D3D12Core {
             return false;
         }
 
+        // Opcional: sin firma el engine vuelve a un draw directo por objeto
+        if (m_indirect && !CreateDrawIndirectSignature(device)) {
+            std::cerr << "Warning: ExecuteIndirect no disponible para este pipeline" << std::endl;
+        }
+
         return true;
     }
 
     void D3D12PipelineState::Shutdown() {
+        m_drawIndirectSignature.Reset();
         m_pipelineState.Reset();
         m_rootSignature.Reset();
     }
@@ -43,7 +75,9 @@ namespace D3D12Core {
     bool D3D12PipelineState::CreateRootSignature(ID3D12Device* device, bool useConstantBuffer) {
         m_hasConstantBuffer = useConstantBuffer;
         
-        D3D12_ROOT_PARAMETER rootParameters[1] = {};
+        D3D12_ROOT_PARAMETER1 rootParameters[4] = {};
+        D3D12_DESCRIPTOR_RANGE1 bindlessRange = D3D12DescriptorManager::GetBindlessRange(
+            D3D12DescriptorManager::GetSupportedBindlessCapacity(device));
         UINT numParameters = 0;
 
         if (useConstantBuffer) {
@@ -51,11 +85,36 @@ namespace D3D12Core {
             rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
             rootParameters[0].Descriptor.ShaderRegister = 0;
             rootParameters[0].Descriptor.RegisterSpace = 0;
+            rootParameters[0].Descriptor.Flags = D3D12_ROOT_DESCRIPTOR_FLAG_DATA_STATIC_WHILE_SET_AT_EXECUTE;
             rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
             numParameters = 1;
+
+            // Tabla bindless: texturas y buffers indexados por entero (t0, space1)
+            rootParameters[ROOT_PARAMETER_BINDLESS_TABLE].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+            rootParameters[ROOT_PARAMETER_BINDLESS_TABLE].DescriptorTable.NumDescriptorRanges = 1;
+            rootParameters[ROOT_PARAMETER_BINDLESS_TABLE].DescriptorTable.pDescriptorRanges = &bindlessRange;
+            rootParameters[ROOT_PARAMETER_BINDLESS_TABLE].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+            numParameters = 2;
+
+            if (m_indirect) {
+                // IndirectVS: índice del objeto (b1), lo fija cada comando de ExecuteIndirect
+                rootParameters[ROOT_PARAMETER_DRAW_INDEX].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+                rootParameters[ROOT_PARAMETER_DRAW_INDEX].Constants.ShaderRegister = 1;
+                rootParameters[ROOT_PARAMETER_DRAW_INDEX].Constants.RegisterSpace = 0;
+                rootParameters[ROOT_PARAMETER_DRAW_INDEX].Constants.Num32BitValues = 1;
+                rootParameters[ROOT_PARAMETER_DRAW_INDEX].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+
+                // Buffer de objetos (IndirectObjectData, t0): un SRV raíz para todo el frame
+                rootParameters[ROOT_PARAMETER_INDIRECT_OBJECTS].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+                rootParameters[ROOT_PARAMETER_INDIRECT_OBJECTS].Descriptor.ShaderRegister = 0;
+                rootParameters[ROOT_PARAMETER_INDIRECT_OBJECTS].Descriptor.RegisterSpace = 0;
+                rootParameters[ROOT_PARAMETER_INDIRECT_OBJECTS].Descriptor.Flags = D3D12_ROOT_DESCRIPTOR_FLAG_DATA_STATIC_WHILE_SET_AT_EXECUTE;
+                rootParameters[ROOT_PARAMETER_INDIRECT_OBJECTS].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+                numParameters = 4;
+            }
         }
 
-        D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc = {};
+        D3D12_ROOT_SIGNATURE_DESC1 rootSignatureDesc = {};
         rootSignatureDesc.NumParameters = numParameters;
         rootSignatureDesc.pParameters = numParameters > 0 ? rootParameters : nullptr;
         rootSignatureDesc.NumStaticSamplers = 0;
@@ -64,12 +123,7 @@ namespace D3D12Core {
 
         ComPtr<ID3DBlob> signature;
         ComPtr<ID3DBlob> error;
-        HRESULT hr = D3D12SerializeRootSignature(
-            &rootSignatureDesc,
-            D3D_ROOT_SIGNATURE_VERSION_1,
-            &signature,
-            &error
-        );
+        HRESULT hr = D3D12DescriptorManager::SerializeRootSignature(device, rootSignatureDesc, &signature, &error);
 
         if (FAILED(hr)) {
             std::cerr << "Error: Failed to serialize root signature" << std::endl;
@@ -94,17 +148,39 @@ namespace D3D12Core {
         return true;
     }
 
+    bool D3D12PipelineState::CreateDrawIndirectSignature(ID3D12Device* device) {
+        // Cada comando fija el índice de su objeto y dibuja: SetGraphicsRoot32BitConstant +
+        // DrawIndexedInstanced. Las constantes compartidas y los objetos no cambian entre comandos
+        D3D12_INDIRECT_ARGUMENT_DESC arguments[2] = {};
+        arguments[0].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+        arguments[0].Constant.RootParameterIndex = ROOT_PARAMETER_DRAW_INDEX;
+        arguments[0].Constant.DestOffsetIn32BitValues = 0;
+        arguments[0].Constant.Num32BitValuesToSet = 1;
+        arguments[1].Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+        D3D12_COMMAND_SIGNATURE_DESC signatureDesc = {};
+        signatureDesc.ByteStride = sizeof(RHIIndirectDrawCommand);
+        signatureDesc.NumArgumentDescs = _countof(arguments);
+        signatureDesc.pArgumentDescs = arguments;
+
+        HRESULT hr = device->CreateCommandSignature(&signatureDesc, m_rootSignature.Get(), IID_PPV_ARGS(&m_drawIndirectSignature));
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to create draw indirect command signature" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
     bool D3D12PipelineState::CreatePipelineState(
         ID3D12Device* device,
         const Shader& vertexShader,
         const Shader& pixelShader,
         DXGI_FORMAT rtvFormat
     ) {
-        // Input layout
-        D3D12_INPUT_ELEMENT_DESC inputElementDescs[] = {
-            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-            { "COLOR", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
-        };
+        // Input layout: los streams de vértices del formato y, si es instanciado, InstanceData en
+        // el slot siguiente (world por filas + datos libres, avanzando una vez por instancia)
+        D3D12_INPUT_ELEMENT_DESC inputElementDescs[MAX_VERTEX_ELEMENTS];
+        UINT inputElementCount = BuildInputLayout(m_vertexFormat, m_instanced, false, inputElementDescs);
 
         D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
         psoDesc.pRootSignature = m_rootSignature.Get();
@@ -135,7 +211,7 @@ namespace D3D12Core {
         psoDesc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO;
         psoDesc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_ALWAYS;
         psoDesc.DepthStencilState.StencilEnable = FALSE;
-        psoDesc.InputLayout = { inputElementDescs, _countof(inputElementDescs) };
+        psoDesc.InputLayout = { inputElementDescs, inputElementCount };
         psoDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
         psoDesc.NumRenderTargets = 1;
         psoDesc.RTVFormats[0] = rtvFormat;
@@ -0,0 +1,333 @@
+#include "D3D12RHI.h"
+#include "D3D12CommandQueue.h"
+#include "D3D12Device.h"
+#include "D3D12FrameAllocator.h"
+#include "IndirectDrawBuilder.h"
+#include "InstanceBatcher.h"
+#include "Shader.h"
+#include <cstring>
+#include <iostream>
+
+namespace D3D12Core {
+
+    DXGI_FORMAT ToDXGIFormat(RHIFormat format) {
+        switch (format) {
+        case RHIFormat::RGBA8Unorm: return DXGI_FORMAT_R8G8B8A8_UNORM;
+        case RHIFormat::R16Uint: return DXGI_FORMAT_R16_UINT;
+        case RHIFormat::R32Uint: return DXGI_FORMAT_R32_UINT;
+        case RHIFormat::D32Float: return DXGI_FORMAT_D32_FLOAT;
+        case RHIFormat::RGB32Float: return DXGI_FORMAT_R32G32B32_FLOAT;
+        case RHIFormat::RGBA32Float: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+        case RHIFormat::RGBA16Snorm: return DXGI_FORMAT_R16G16B16A16_SNORM;
+        default: return DXGI_FORMAT_UNKNOWN;
+        }
+    }
+
+    // ---------------------------------------------------------------- Command list
+
+    D3D12RHICommandList::D3D12RHICommandList(D3D12Core* core, ID3D12GraphicsCommandList* nativeList)
+        : m_core(core), m_commandList(nativeList), m_owned(false) {
+    }
+
+    D3D12RHICommandList::D3D12RHICommandList(D3D12Core* core)
+        : m_core(core), m_owned(true) {
+    }
+
+    D3D12RHICommandList::~D3D12RHICommandList() {
+        // Los allocators no se pueden liberar mientras la GPU los use
+        if (m_owned && m_core) {
+            for (uint64_t fenceValue : m_allocatorFences) {
+                if (fenceValue != 0) {
+                    m_core->GetCommandQueue()->WaitForFenceValue(fenceValue);
+                }
+            }
+        }
+    }
+
+    bool D3D12RHICommandList::Initialize(ID3D12Device* device) {
+        if (!m_owned) {
+            return true;
+        }
+
+        for (UINT i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            HRESULT hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&m_allocators[i]));
+            if (FAILED(hr)) {
+                std::cerr << "Error: Failed to create RHI command allocator" << std::endl;
+                return false;
+            }
+        }
+
+        HRESULT hr = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, m_allocators[0].Get(), nullptr,
+            IID_PPV_ARGS(&m_ownedList));
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to create RHI command list" << std::endl;
+            return false;
+        }
+        m_ownedList->Close(); // Se abre en Begin
+        m_commandList = m_ownedList.Get();
+        m_allocatorIndex = MAX_FRAMES_IN_FLIGHT - 1; // El primer Begin usa el allocator 0
+        return true;
+    }
+
+    void D3D12RHICommandList::Begin() {
+        m_requiredUpload = UploadToken();
+        m_pipelineState = nullptr;
+        if (!m_owned) {
+            return;
+        }
+
+        // Siguiente allocator: solo se espera si la GPU aún ejecuta lo grabado con él
+        m_allocatorIndex = (m_allocatorIndex + 1) % MAX_FRAMES_IN_FLIGHT;
+        if (m_allocatorFences[m_allocatorIndex] != 0) {
+            m_core->GetCommandQueue()->WaitForFenceValue(m_allocatorFences[m_allocatorIndex]);
+            m_allocatorFences[m_allocatorIndex] = 0;
+        }
+        m_allocators[m_allocatorIndex]->Reset();
+        m_ownedList->Reset(m_allocators[m_allocatorIndex].Get(), nullptr);
+    }
+
+    void D3D12RHICommandList::Close() {
+        if (m_owned && FAILED(m_ownedList->Close())) {
+            std::cerr << "Error: Failed to close RHI command list" << std::endl;
+        }
+    }
+
+    void D3D12RHICommandList::SetRenderTarget(uint64_t renderTargetView) {
+        D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = { static_cast<SIZE_T>(renderTargetView) };
+        m_commandList->OMSetRenderTargets(1, &rtvHandle, FALSE, nullptr);
+    }
+
+    void D3D12RHICommandList::ClearRenderTarget(uint64_t renderTargetView, const float color[4]) {
+        D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = { static_cast<SIZE_T>(renderTargetView) };
+        m_commandList->ClearRenderTargetView(rtvHandle, color, 0, nullptr);
+    }
+
+    void D3D12RHICommandList::SetViewport(const RHIViewport& viewport) {
+        D3D12_VIEWPORT d3dViewport = { viewport.x, viewport.y, viewport.width, viewport.height, viewport.minDepth, viewport.maxDepth };
+        m_commandList->RSSetViewports(1, &d3dViewport);
+    }
+
+    void D3D12RHICommandList::SetScissor(const RHIRect& rect) {
+        D3D12_RECT d3dRect = { rect.left, rect.top, rect.right, rect.bottom };
+        m_commandList->RSSetScissorRects(1, &d3dRect);
+    }
+
+    void D3D12RHICommandList::SetPipeline(IRHIPipeline* pipeline) {
+        D3D12PipelineState* pso = static_cast<D3D12RHIPipeline*>(pipeline)->GetPipelineState();
+        m_pipelineState = pso;
+        m_commandList->SetPipelineState(pso->GetPSO());
+        m_commandList->SetGraphicsRootSignature(pso->GetRootSignature());
+        m_commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    }
+
+    void D3D12RHICommandList::SetConstantBuffer(uint32_t rootParameter, uint64_t gpuAddress) {
+        m_commandList->SetGraphicsRootConstantBufferView(rootParameter, gpuAddress);
+    }
+
+    void D3D12RHICommandList::RequireUpload(IRHIBuffer* buffer) {
+        const UploadToken& token = static_cast<D3D12RHIBuffer*>(buffer)->GetUploadToken();
+        if (!token.IsValid()) {
+            return;
+        }
+        if (!m_owned) {
+            m_core->RequireUpload(token); // Lo resuelve EndFrame
+        }
+        else if (token.fenceValue > m_requiredUpload.fenceValue) {
+            m_requiredUpload = token;
+        }
+    }
+
+    void D3D12RHICommandList::SetVertexBuffer(IRHIBuffer* buffer, uint32_t stream) {
+        RequireUpload(buffer);
+        D3D12_VERTEX_BUFFER_VIEW view;
+        view.BufferLocation = buffer->GetGpuAddress();
+        view.SizeInBytes = static_cast<UINT>(buffer->GetDesc().size);
+        view.StrideInBytes = buffer->GetDesc().stride;
+        m_commandList->IASetVertexBuffers(stream, 1, &view);
+    }
+
+    void D3D12RHICommandList::SetIndexBuffer(IRHIBuffer* buffer, RHIFormat format) {
+        RequireUpload(buffer);
+        D3D12_INDEX_BUFFER_VIEW view;
+        view.BufferLocation = buffer->GetGpuAddress();
+        view.SizeInBytes = static_cast<UINT>(buffer->GetDesc().size);
+        view.Format = ToDXGIFormat(format);
+        m_commandList->IASetIndexBuffer(&view);
+    }
+
+    void D3D12RHICommandList::SetInstanceBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) {
+        D3D12_VERTEX_BUFFER_VIEW view;
+        view.BufferLocation = gpuAddress;
+        view.SizeInBytes = static_cast<UINT>(size);
+        view.StrideInBytes = stride;
+        // Detrás de los streams de vértices del pipeline enlazado
+        const UINT slot = m_pipelineState ? m_pipelineState->GetVertexFormat().GetStreamCount() : 1;
+        m_commandList->IASetVertexBuffers(slot, 1, &view);
+    }
+
+    void D3D12RHICommandList::SetObjectBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) {
+        // SRV raíz: el tamaño y el stride los fija IndirectObject en IndirectVS.hlsl
+        (void)size;
+        (void)stride;
+        m_commandList->SetGraphicsRootShaderResourceView(ROOT_PARAMETER_INDIRECT_OBJECTS, gpuAddress);
+    }
+
+    void D3D12RHICommandList::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex, uint32_t startInstance) {
+        m_commandList->DrawInstanced(vertexCount, instanceCount, startVertex, startInstance);
+    }
+
+    void D3D12RHICommandList::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) {
+        m_commandList->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+    }
+
+    void D3D12RHICommandList::ExecuteIndirect(uint64_t argumentAddress, uint32_t commandCount) {
+        D3D12FrameAllocator* frameAllocator = m_core->GetFrameAllocator();
+        UINT64 argumentOffset = 0;
+        if (!m_pipelineState || !m_pipelineState->GetDrawIndirectSignature() ||
+            !frameAllocator->GetResourceOffset(argumentAddress, argumentOffset)) {
+            std::cerr << "Error: ExecuteIndirect without an indirect-capable pipeline or with arguments outside frame memory" << std::endl;
+            return;
+        }
+        // El upload heap está en GENERIC_READ, que ya incluye INDIRECT_ARGUMENT
+        m_commandList->ExecuteIndirect(m_pipelineState->GetDrawIndirectSignature(), commandCount,
+            frameAllocator->GetResource(), argumentOffset, nullptr, 0);
+    }
+
+    // ---------------------------------------------------------------- Cola
+
+    void D3D12RHICommandQueue::ExecuteCommandList(IRHICommandList* commandList) {
+        D3D12RHICommandList* d3dList = static_cast<D3D12RHICommandList*>(commandList);
+        if (!d3dList->IsOwned()) {
+            std::cerr << "Error: Frame command lists are submitted by D3D12Core::EndFrame" << std::endl;
+            return;
+        }
+
+        ID3D12CommandQueue* queue = m_core->GetCommandQueue()->GetQueue();
+        m_core->GetUploadManager()->RequireOnQueue(d3dList->GetRequiredUpload(), queue);
+
+        ID3D12CommandList* lists[] = { static_cast<ID3D12GraphicsCommandList*>(d3dList->GetNativeCommandList()) };
+        queue->ExecuteCommandLists(1, lists);
+        d3dList->SetSubmittedFence(Signal());
+    }
+
+    uint64_t D3D12RHICommandQueue::Signal() {
+        return m_core->GetCommandQueue()->Signal();
+    }
+
+    uint64_t D3D12RHICommandQueue::GetCompletedValue() const {
+        return m_core->GetCommandQueue()->GetCompletedValue();
+    }
+
+    void D3D12RHICommandQueue::WaitForFenceValue(uint64_t fenceValue) {
+        m_core->GetCommandQueue()->WaitForFenceValue(fenceValue);
+    }
+
+    // ---------------------------------------------------------------- Dispositivo
+
+    D3D12RHIDevice::D3D12RHIDevice() {
+    }
+
+    D3D12RHIDevice::~D3D12RHIDevice() {
+        Shutdown();
+    }
+
+    bool D3D12RHIDevice::Initialize(D3D12Core* core) {
+        if (!core || !core->GetDevice()) {
+            std::cerr << "Error: D3D12RHIDevice needs an initialized D3D12Core" << std::endl;
+            return false;
+        }
+        m_core = core;
+        m_queue = std::make_unique<D3D12RHICommandQueue>(core);
+        return true;
+    }
+
+    void D3D12RHIDevice::Shutdown() {
+        m_queue.reset();
+        m_core = nullptr;
+    }
+
+    std::unique_ptr<IRHIBuffer> D3D12RHIDevice::CreateBuffer(const RHIBufferDesc& desc, const void* initialData) {
+        if (desc.size == 0) {
+            std::cerr << "Error: CreateBuffer with zero size" << std::endl;
+            return nullptr;
+        }
+
+        D3D12_RESOURCE_FLAGS flags = (desc.usage & RHI_BUFFER_USAGE_UNORDERED_ACCESS)
+            ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE;
+
+        std::unique_ptr<D3D12Buffer> buffer = std::make_unique<D3D12Buffer>();
+        if (!buffer->Initialize(m_core->GetHeapAllocator(), desc.size, flags)) {
+            std::cerr << "Error: Failed to create RHI buffer" << std::endl;
+            return nullptr;
+        }
+
+        UploadToken token;
+        if (initialData) {
+            token = m_core->GetUploadManager()->UploadBuffer(buffer.get(), initialData, desc.size);
+            if (!token.IsValid()) {
+                std::cerr << "Error: Failed to queue RHI buffer upload" << std::endl;
+                return nullptr;
+            }
+        }
+        return std::make_unique<D3D12RHIBuffer>(desc, std::move(buffer), token);
+    }
+
+    std::unique_ptr<IRHIPipeline> D3D12RHIDevice::CreatePipeline(const RHIPipelineDesc& desc) {
+        if (desc.vertexStride == 0 || desc.vertexStride != desc.vertexFormat.GetStride(0)) {
+            std::cerr << "Error: D3D12 pipelines need a vertex stride matching their vertex format (stride "
+                      << desc.vertexFormat.GetStride(0) << ")" << std::endl;
+            return nullptr;
+        }
+        if (desc.instanceStride != 0 && desc.instanceStride != sizeof(InstanceData)) {
+            std::cerr << "Error: D3D12 instanced pipelines use the InstanceData layout (stride " << sizeof(InstanceData) << ")" << std::endl;
+            return nullptr;
+        }
+        if (desc.objectStride != 0 && (desc.objectStride != sizeof(IndirectObjectData) || desc.instanceStride != 0)) {
+            std::cerr << "Error: D3D12 indirect pipelines use the IndirectObjectData layout (stride " << sizeof(IndirectObjectData)
+                      << ") and no instance stream" << std::endl;
+            return nullptr;
+        }
+
+        if (!desc.vertexShader || desc.vertexShaderSize == 0 || !desc.pixelShader || desc.pixelShaderSize == 0) {
+            std::cerr << "Error: CreatePipeline needs vertex and pixel shader bytecode" << std::endl;
+            return nullptr;
+        }
+        Shader vertexShader, pixelShader;
+        vertexShader.LoadFromBytecode(desc.vertexShader, desc.vertexShaderSize);
+        pixelShader.LoadFromBytecode(desc.pixelShader, desc.pixelShaderSize);
+
+        std::unique_ptr<D3D12PipelineState> pipeline = std::make_unique<D3D12PipelineState>();
+        if (!pipeline->Initialize(m_core->GetDevice()->GetDevice(), vertexShader, pixelShader, ToDXGIFormat(desc.renderTargetFormat),
+                desc.instanceStride != 0, desc.vertexFormat, desc.objectStride != 0)) {
+            std::cerr << "Error: Failed to create RHI pipeline" << std::endl;
+            return nullptr;
+        }
+
+        // La root signature decide si hay constantes: reflejarlo en la descripción
+        RHIPipelineDesc finalDesc = desc;
+        finalDesc.useConstantBuffer = pipeline->HasConstantBuffer();
+        return std::make_unique<D3D12RHIPipeline>(finalDesc, std::move(pipeline));
+    }
+
+    std::unique_ptr<IRHICommandList> D3D12RHIDevice::CreateCommandList() {
+        std::unique_ptr<D3D12RHICommandList> commandList = std::make_unique<D3D12RHICommandList>(m_core);
+        if (!commandList->Initialize(m_core->GetDevice()->GetDevice())) {
+            return nullptr;
+        }
+        return commandList;
+    }
+
+    std::unique_ptr<IRHICommandList> D3D12RHIDevice::WrapCommandList(ID3D12GraphicsCommandList* nativeList) {
+        return std::make_unique<D3D12RHICommandList>(m_core, nativeList);
+    }
+
+    uint64_t D3D12RHIDevice::AllocateConstants(const void* data, uint64_t size) {
+        DynamicAllocation allocation = m_core->GetFrameAllocator()->Allocate(size);
+        if (!allocation.IsValid()) {
+            return 0;
+        }
+        memcpy(allocation.cpuAddress, data, size);
+        return allocation.gpuAddress;
+    }
+
+} // namespace D3D12Core
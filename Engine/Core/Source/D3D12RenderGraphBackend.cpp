@@ -0,0 +1,418 @@
+#include "D3D12RenderGraphBackend.h"
+#include "D3D12CommandQueue.h"
+#include "D3D12ResourceStateTracker.h"
+#include <iostream>
+#include <iomanip>
+#include <climits>
+
+namespace D3D12Core {
+
+    namespace {
+
+        constexpr uint32_t DEPTH_USAGES = (1u << static_cast<uint32_t>(RenderGraphUsage::DepthWrite)) |
+            (1u << static_cast<uint32_t>(RenderGraphUsage::DepthRead));
+
+        bool HasUsage(uint32_t usageMask, RenderGraphUsage usage) {
+            return (usageMask & UsageBit(usage)) != 0;
+        }
+
+        // Un depth leído como textura necesita el recurso typeless y un formato de color para el SRV
+        DXGI_FORMAT GetTypelessDepthFormat(DXGI_FORMAT format) {
+            switch (format) {
+            case DXGI_FORMAT_D32_FLOAT: return DXGI_FORMAT_R32_TYPELESS;
+            case DXGI_FORMAT_D24_UNORM_S8_UINT: return DXGI_FORMAT_R24G8_TYPELESS;
+            case DXGI_FORMAT_D16_UNORM: return DXGI_FORMAT_R16_TYPELESS;
+            default: return format;
+            }
+        }
+
+        DXGI_FORMAT GetDepthShaderResourceFormat(DXGI_FORMAT format) {
+            switch (format) {
+            case DXGI_FORMAT_D32_FLOAT: return DXGI_FORMAT_R32_FLOAT;
+            case DXGI_FORMAT_D24_UNORM_S8_UINT: return DXGI_FORMAT_R24_UNORM_X8_TYPELESS;
+            case DXGI_FORMAT_D16_UNORM: return DXGI_FORMAT_R16_UNORM;
+            default: return format;
+            }
+        }
+
+    } // namespace
+
+    D3D12RenderGraphBackend::D3D12RenderGraphBackend() {
+    }
+
+    D3D12RenderGraphBackend::~D3D12RenderGraphBackend() {
+        Shutdown();
+    }
+
+    bool D3D12RenderGraphBackend::Initialize(ID3D12Device* device, D3D12CommandQueue* commandQueue,
+        D3D12DescriptorManager* descriptorManager, D3D12ResourceStateTracker* stateTracker) {
+        if (!device || !commandQueue || !descriptorManager || !stateTracker) {
+            std::cerr << "Error: Render graph backend requires device, queue, descriptor manager and state tracker" << std::endl;
+            return false;
+        }
+
+        m_device = device;
+        m_commandQueue = commandQueue;
+        m_descriptorManager = descriptorManager;
+        m_stateTracker = stateTracker;
+        return true;
+    }
+
+    void D3D12RenderGraphBackend::Shutdown() {
+        ReleaseTransients();
+        for (UINT i = 0; i < HEAP_CATEGORY_COUNT; ++i) {
+            m_heaps[i].Reset();
+            m_heapSizes[i] = 0;
+        }
+        m_commandList = nullptr;
+        m_device = nullptr;
+    }
+
+    D3D12_RESOURCE_STATES D3D12RenderGraphBackend::ToResourceState(RenderGraphUsage usage) {
+        switch (usage) {
+        case RenderGraphUsage::RenderTarget: return D3D12_RESOURCE_STATE_RENDER_TARGET;
+        case RenderGraphUsage::DepthWrite: return D3D12_RESOURCE_STATE_DEPTH_WRITE;
+        case RenderGraphUsage::DepthRead: return D3D12_RESOURCE_STATE_DEPTH_READ;
+        case RenderGraphUsage::ShaderResource: return D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE;
+        case RenderGraphUsage::UnorderedAccess: return D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+        case RenderGraphUsage::CopySource: return D3D12_RESOURCE_STATE_COPY_SOURCE;
+        case RenderGraphUsage::CopyDest: return D3D12_RESOURCE_STATE_COPY_DEST;
+        case RenderGraphUsage::Present: return D3D12_RESOURCE_STATE_PRESENT;
+        default: return D3D12_RESOURCE_STATE_COMMON;
+        }
+    }
+
+    D3D12_RESOURCE_DESC D3D12RenderGraphBackend::BuildResourceDesc(const RenderGraphTextureDesc& desc, uint32_t usageMask) const {
+        D3D12_RESOURCE_DESC resourceDesc = {};
+        resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+        resourceDesc.Width = desc.width;
+        resourceDesc.Height = desc.height;
+        resourceDesc.DepthOrArraySize = 1;
+        resourceDesc.MipLevels = static_cast<UINT16>(desc.mipLevels > 0 ? desc.mipLevels : 1);
+        resourceDesc.Format = static_cast<DXGI_FORMAT>(desc.format);
+        resourceDesc.SampleDesc.Count = 1;
+        resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+        resourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+        if (HasUsage(usageMask, RenderGraphUsage::RenderTarget)) {
+            resourceDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+        }
+        if (usageMask & DEPTH_USAGES) {
+            resourceDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+            if (HasUsage(usageMask, RenderGraphUsage::ShaderResource)) {
+                resourceDesc.Format = GetTypelessDepthFormat(resourceDesc.Format);
+            }
+            else {
+                resourceDesc.Flags |= D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE;
+            }
+        }
+        if (HasUsage(usageMask, RenderGraphUsage::UnorderedAccess)) {
+            resourceDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+        }
+        return resourceDesc;
+    }
+
+    RenderGraphMemoryRequirements D3D12RenderGraphBackend::GetMemoryRequirements(const RenderGraphTextureDesc& desc, uint32_t usageMask) {
+        RenderGraphMemoryRequirements requirements;
+        bool renderTargetOrDepth = HasUsage(usageMask, RenderGraphUsage::RenderTarget) || (usageMask & DEPTH_USAGES) != 0;
+        requirements.heapCategory = renderTargetOrDepth ? HEAP_RT_DS_TEXTURES : HEAP_OTHER_TEXTURES;
+        if (!m_device) {
+            return requirements;
+        }
+
+        D3D12_RESOURCE_DESC resourceDesc = BuildResourceDesc(desc, usageMask);
+        D3D12_RESOURCE_ALLOCATION_INFO info = m_device->GetResourceAllocationInfo(0, 1, &resourceDesc);
+        if (info.SizeInBytes == UINT64_MAX) {
+            std::cerr << "Error: Invalid render graph texture description" << std::endl;
+            return requirements;
+        }
+        requirements.size = info.SizeInBytes;
+        requirements.alignment = info.Alignment;
+        return requirements;
+    }
+
+    bool D3D12RenderGraphBackend::Matches(const RenderGraph& graph) const {
+        const size_t count = graph.GetResourceCount();
+        for (size_t i = 0; i < m_transients.size(); ++i) {
+            // Un transitorio que el grafo ya no usa sigue ocupando memoria: recrear
+            if (m_transients[i].resource && i >= count) {
+                return false;
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            RenderGraphResource handle;
+            handle.index = static_cast<uint32_t>(i);
+            const RenderGraph::ResourceInfo& info = graph.GetResource(handle);
+            bool wanted = !info.imported && info.used;
+            bool existing = i < m_transients.size() && m_transients[i].resource;
+            if (wanted != existing) {
+                return false;
+            }
+            if (!wanted) {
+                continue;
+            }
+
+            const Transient& transient = m_transients[i];
+            if (transient.desc.width != info.desc.width || transient.desc.height != info.desc.height ||
+                transient.desc.format != info.desc.format || transient.desc.mipLevels != info.desc.mipLevels ||
+                transient.usageMask != info.usageMask || transient.heapCategory != info.memory.heapCategory ||
+                transient.heapOffset != info.heapOffset || transient.size != info.memory.size) {
+                return false;
+            }
+            for (int c = 0; c < 4; ++c) {
+                if (transient.desc.clearColor[c] != info.desc.clearColor[c]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool D3D12RenderGraphBackend::PrepareResources(const RenderGraph& graph) {
+        if (!m_device) {
+            return false;
+        }
+        if (Matches(graph)) {
+            return true;
+        }
+
+        // Frames en vuelo pueden seguir usando los transitorios actuales (solo pasa al cambiar el grafo)
+        m_commandQueue->WaitForIdle();
+        ReleaseTransients();
+
+        // Los heaps solo crecen: volver a un grafo anterior no necesita memoria nueva
+        const std::vector<uint64_t>& heapSizes = graph.GetHeapSizes();
+        for (size_t category = 0; category < heapSizes.size() && category < HEAP_CATEGORY_COUNT; ++category) {
+            if (heapSizes[category] <= m_heapSizes[category]) {
+                continue;
+            }
+
+            const UINT64 alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+            D3D12_HEAP_DESC heapDesc = {};
+            heapDesc.SizeInBytes = (heapSizes[category] + alignment - 1) / alignment * alignment;
+            heapDesc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+            heapDesc.Properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+            heapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+            heapDesc.Alignment = alignment;
+            heapDesc.Flags = (category == HEAP_RT_DS_TEXTURES)
+                ? D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES
+                : D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+
+            m_heaps[category].Reset();
+            m_heapSizes[category] = 0;
+            HRESULT hr = m_device->CreateHeap(&heapDesc, IID_PPV_ARGS(&m_heaps[category]));
+            if (FAILED(hr)) {
+                std::cerr << "Error: Failed to create render graph heap. HRESULT: 0x"
+                    << std::hex << hr << std::dec << std::endl;
+                return false;
+            }
+            m_heapSizes[category] = heapDesc.SizeInBytes;
+        }
+
+        m_transients.resize(graph.GetResourceCount());
+        for (size_t i = 0; i < graph.GetResourceCount(); ++i) {
+            RenderGraphResource handle;
+            handle.index = static_cast<uint32_t>(i);
+            const RenderGraph::ResourceInfo& info = graph.GetResource(handle);
+            if (info.imported || !info.used) {
+                continue;
+            }
+            if (!CreateTransient(info, m_transients[i])) {
+                ReleaseTransients();
+                return false;
+            }
+        }
+
+        const RenderGraph::Stats& stats = graph.GetStats();
+        std::cout << std::fixed << std::setprecision(2)
+            << "Render graph: " << stats.transientResources << " transitorios en "
+            << stats.heapBytes / (1024.0 * 1024.0) << " MB (sin aliasing: "
+            << stats.transientBytes / (1024.0 * 1024.0) << " MB)" << std::endl;
+        return true;
+    }
+
+    bool D3D12RenderGraphBackend::CreateTransient(const RenderGraph::ResourceInfo& info, Transient& transient) {
+        const uint32_t category = info.memory.heapCategory;
+        if (category >= HEAP_CATEGORY_COUNT || !m_heaps[category]) {
+            std::cerr << "Error: Missing render graph heap for '" << info.name << "'" << std::endl;
+            return false;
+        }
+
+        const bool renderTarget = HasUsage(info.usageMask, RenderGraphUsage::RenderTarget);
+        const bool depth = (info.usageMask & DEPTH_USAGES) != 0;
+        const DXGI_FORMAT format = static_cast<DXGI_FORMAT>(info.desc.format);
+        D3D12_RESOURCE_DESC resourceDesc = BuildResourceDesc(info.desc, info.usageMask);
+
+        D3D12_CLEAR_VALUE clearValue = {};
+        clearValue.Format = format;
+        if (depth) {
+            clearValue.DepthStencil.Depth = info.desc.clearColor[0];
+            clearValue.DepthStencil.Stencil = 0;
+        }
+        else {
+            for (int c = 0; c < 4; ++c) {
+                clearValue.Color[c] = info.desc.clearColor[c];
+            }
+        }
+
+        D3D12_RESOURCE_STATES initialState = depth ? D3D12_RESOURCE_STATE_DEPTH_WRITE
+            : renderTarget ? D3D12_RESOURCE_STATE_RENDER_TARGET
+            : D3D12_RESOURCE_STATE_COMMON;
+
+        HRESULT hr = m_device->CreatePlacedResource(
+            m_heaps[category].Get(),
+            info.heapOffset,
+            &resourceDesc,
+            initialState,
+            (renderTarget || depth) ? &clearValue : nullptr,
+            IID_PPV_ARGS(&transient.resource)
+        );
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to create render graph texture '" << info.name << "'. HRESULT: 0x"
+                << std::hex << hr << std::dec << std::endl;
+            return false;
+        }
+        std::wstring name(info.name.begin(), info.name.end());
+        transient.resource->SetName(name.c_str());
+
+        m_stateTracker->Register(transient.resource.Get(), initialState);
+
+        if (renderTarget) {
+            transient.rtv = m_descriptorManager->AllocatePersistent(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+            if (transient.rtv.IsValid()) {
+                m_device->CreateRenderTargetView(transient.resource.Get(), nullptr, transient.rtv.cpu);
+            }
+        }
+        if (depth) {
+            transient.dsv = m_descriptorManager->AllocatePersistent(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
+            if (transient.dsv.IsValid()) {
+                D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
+                dsvDesc.Format = format;
+                dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+                m_device->CreateDepthStencilView(transient.resource.Get(), &dsvDesc, transient.dsv.cpu);
+            }
+        }
+        if (HasUsage(info.usageMask, RenderGraphUsage::ShaderResource)) {
+            transient.srv = m_descriptorManager->AllocateBindless();
+            if (transient.srv.IsValid()) {
+                D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+                srvDesc.Format = depth ? GetDepthShaderResourceFormat(format) : format;
+                srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+                srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+                srvDesc.Texture2D.MipLevels = resourceDesc.MipLevels;
+                m_device->CreateShaderResourceView(transient.resource.Get(), &srvDesc, transient.srv.cpu);
+            }
+        }
+
+        transient.desc = info.desc;
+        transient.usageMask = info.usageMask;
+        transient.heapCategory = category;
+        transient.heapOffset = info.heapOffset;
+        transient.size = info.memory.size;
+        return true;
+    }
+
+    void D3D12RenderGraphBackend::ReleaseTransients() {
+        for (Transient& transient : m_transients) {
+            if (transient.resource && m_stateTracker) {
+                m_stateTracker->Unregister(transient.resource.Get());
+            }
+            if (m_descriptorManager) {
+                m_descriptorManager->Free(transient.rtv);
+                m_descriptorManager->Free(transient.dsv);
+                m_descriptorManager->Free(transient.srv);
+            }
+        }
+        m_transients.clear();
+    }
+
+    ID3D12Resource* D3D12RenderGraphBackend::Resolve(const RenderGraph& graph, RenderGraphResource resource) const {
+        if (!resource.IsValid() || resource.index >= graph.GetResourceCount()) {
+            return nullptr;
+        }
+        const RenderGraph::ResourceInfo& info = graph.GetResource(resource);
+        if (info.imported) {
+            return static_cast<ID3D12Resource*>(info.nativeResource);
+        }
+        return resource.index < m_transients.size() ? m_transients[resource.index].resource.Get() : nullptr;
+    }
+
+    void D3D12RenderGraphBackend::BeginPass(const RenderGraph& graph, const RenderGraph::CompiledPass& pass) {
+        // Los importados deben estar registrados en el state tracker (los back buffers lo están)
+        for (const RenderGraph::AliasingBarrier& aliasing : pass.aliasing) {
+            ID3D12Resource* before = aliasing.before.IsValid() ? Resolve(graph, aliasing.before) : nullptr;
+            m_stateTracker->Alias(before, Resolve(graph, aliasing.after));
+        }
+        for (const RenderGraph::Transition& transition : pass.beginTransitions) {
+            m_stateTracker->BeginTransition(Resolve(graph, transition.resource), ToResourceState(transition.after));
+        }
+        for (const RenderGraph::Transition& transition : pass.transitions) {
+            m_stateTracker->Transition(Resolve(graph, transition.resource), ToResourceState(transition.after));
+        }
+        m_stateTracker->Flush(m_commandList);
+
+        // Tras una barrera de aliasing el contenido es indefinido: los RT/DS/UAV se inicializan
+        // con Discard (un pase puede además limpiarlos; las copias ya lo sobrescriben entero)
+        for (RenderGraphResource activation : pass.activations) {
+            if (!graph.GetResource(activation).aliased) {
+                continue;
+            }
+            ID3D12Resource* resource = Resolve(graph, activation);
+            D3D12_RESOURCE_STATES state = m_stateTracker->GetState(resource);
+            if (resource && (state == D3D12_RESOURCE_STATE_RENDER_TARGET || state == D3D12_RESOURCE_STATE_DEPTH_WRITE ||
+                state == D3D12_RESOURCE_STATE_UNORDERED_ACCESS)) {
+                m_commandList->DiscardResource(resource, nullptr);
+            }
+        }
+    }
+
+    void D3D12RenderGraphBackend::EndGraph(const RenderGraph& graph) {
+        for (const RenderGraph::Transition& transition : graph.GetFinalTransitions()) {
+            m_stateTracker->Transition(Resolve(graph, transition.resource), ToResourceState(transition.after));
+        }
+        m_stateTracker->Flush(m_commandList);
+    }
+
+    ID3D12Resource* D3D12RenderGraphBackend::GetResource(const RenderGraph& graph, RenderGraphResource resource) const {
+        return Resolve(graph, resource);
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE D3D12RenderGraphBackend::GetRTV(const RenderGraph& graph, RenderGraphResource resource) const {
+        if (!resource.IsValid() || resource.index >= graph.GetResourceCount()) {
+            return {};
+        }
+        const RenderGraph::ResourceInfo& info = graph.GetResource(resource);
+        if (info.imported) {
+            return { static_cast<SIZE_T>(info.nativeView) };
+        }
+        return resource.index < m_transients.size() ? m_transients[resource.index].rtv.cpu : D3D12_CPU_DESCRIPTOR_HANDLE{};
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE D3D12RenderGraphBackend::GetDSV(const RenderGraph& graph, RenderGraphResource resource) const {
+        if (!resource.IsValid() || resource.index >= graph.GetResourceCount()) {
+            return {};
+        }
+        const RenderGraph::ResourceInfo& info = graph.GetResource(resource);
+        if (info.imported) {
+            return { static_cast<SIZE_T>(info.nativeView) };
+        }
+        return resource.index < m_transients.size() ? m_transients[resource.index].dsv.cpu : D3D12_CPU_DESCRIPTOR_HANDLE{};
+    }
+
+    UINT D3D12RenderGraphBackend::GetShaderResourceIndex(RenderGraphResource resource) const {
+        if (!resource.IsValid() || resource.index >= m_transients.size() || !m_transients[resource.index].srv.IsValid()) {
+            return UINT_MAX;
+        }
+        return m_transients[resource.index].srv.index;
+    }
+
+    UINT64 D3D12RenderGraphBackend::GetHeapBytes() const {
+        UINT64 total = 0;
+        for (UINT i = 0; i < HEAP_CATEGORY_COUNT; ++i) {
+            total += m_heapSizes[i];
+        }
+        return total;
+    }
+
+} // namespace D3D12Core
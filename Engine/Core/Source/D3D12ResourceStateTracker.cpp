@@ -0,0 +1,123 @@
+#include "D3D12ResourceStateTracker.h"
+
+namespace D3D12Core {
+
+    namespace {
+
+        // Estados que escriben en el recurso: no se combinan con otros estados
+        constexpr uint32_t WRITE_STATES =
+            D3D12_RESOURCE_STATE_RENDER_TARGET |
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS |
+            D3D12_RESOURCE_STATE_DEPTH_WRITE |
+            D3D12_RESOURCE_STATE_STREAM_OUT |
+            D3D12_RESOURCE_STATE_COPY_DEST |
+            D3D12_RESOURCE_STATE_RESOLVE_DEST;
+
+    } // namespace
+
+    D3D12ResourceStateTracker::D3D12ResourceStateTracker() {
+    }
+
+    void D3D12ResourceStateTracker::Initialize() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tracker.Initialize(WRITE_STATES);
+    }
+
+    void D3D12ResourceStateTracker::Register(ID3D12Resource* resource, D3D12_RESOURCE_STATES state, UINT subresourceCount) {
+        if (!resource) {
+            return;
+        }
+
+        D3D12_RESOURCE_DESC desc = resource->GetDesc();
+        bool isBuffer = desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER;
+        bool implicitPromotion = isBuffer || (desc.Flags & D3D12_RESOURCE_FLAG_ALLOW_SIMULTANEOUS_ACCESS) != 0;
+
+        if (subresourceCount == 0) {
+            UINT arraySize = (desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) ? 1 : desc.DepthOrArraySize;
+            subresourceCount = isBuffer ? 1 : desc.MipLevels * arraySize;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tracker.RegisterResource(Key(resource), subresourceCount, state, implicitPromotion);
+    }
+
+    void D3D12ResourceStateTracker::Unregister(ID3D12Resource* resource) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tracker.UnregisterResource(Key(resource));
+    }
+
+    bool D3D12ResourceStateTracker::IsRegistered(ID3D12Resource* resource) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_tracker.IsRegistered(Key(resource));
+    }
+
+    D3D12_RESOURCE_STATES D3D12ResourceStateTracker::GetState(ID3D12Resource* resource, UINT subresource) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return static_cast<D3D12_RESOURCE_STATES>(m_tracker.GetState(Key(resource), subresource));
+    }
+
+    void D3D12ResourceStateTracker::Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES state, UINT subresource) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tracker.Transition(Key(resource), subresource, static_cast<uint32_t>(state));
+    }
+
+    void D3D12ResourceStateTracker::BeginTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES state, UINT subresource) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tracker.BeginTransition(Key(resource), subresource, static_cast<uint32_t>(state));
+    }
+
+    void D3D12ResourceStateTracker::Alias(ID3D12Resource* before, ID3D12Resource* after) {
+        D3D12_RESOURCE_BARRIER barrier = {};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+        barrier.Aliasing.pResourceBefore = before;
+        barrier.Aliasing.pResourceAfter = after;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_aliasing.push_back(barrier);
+    }
+
+    void D3D12ResourceStateTracker::Flush(ID3D12GraphicsCommandList* commandList) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!commandList || (!m_tracker.HasPendingBarriers() && m_aliasing.empty())) {
+            return;
+        }
+
+        // Aliasing primero: las transiciones del lote pueden ser del recurso que se activa
+        m_tracker.TakePendingBarriers(m_batch);
+        m_barriers.assign(m_aliasing.begin(), m_aliasing.end());
+        m_aliasing.clear();
+        const size_t first = m_barriers.size();
+        m_barriers.resize(first + m_batch.size());
+        for (size_t i = 0; i < m_batch.size(); ++i) {
+            const ResourceStateTracker::Barrier& source = m_batch[i];
+            D3D12_RESOURCE_BARRIER& barrier = m_barriers[first + i];
+            barrier = {};
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrier.Flags = (source.flags == ResourceStateTracker::BARRIER_BEGIN_ONLY) ? D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY
+                : (source.flags == ResourceStateTracker::BARRIER_END_ONLY) ? D3D12_RESOURCE_BARRIER_FLAG_END_ONLY
+                : D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            barrier.Transition.pResource = reinterpret_cast<ID3D12Resource*>(source.resource);
+            barrier.Transition.Subresource = source.subresource;
+            barrier.Transition.StateBefore = static_cast<D3D12_RESOURCE_STATES>(source.before);
+            barrier.Transition.StateAfter = static_cast<D3D12_RESOURCE_STATES>(source.after);
+        }
+
+        commandList->ResourceBarrier(static_cast<UINT>(m_barriers.size()), m_barriers.data());
+    }
+
+    void D3D12ResourceStateTracker::OnExecuted() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tracker.OnExecuted();
+    }
+
+    ResourceStateTracker::Stats D3D12ResourceStateTracker::GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_tracker.GetStats();
+    }
+
+    void D3D12ResourceStateTracker::ResetStats() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tracker.ResetStats();
+    }
+
+} // namespace D3D12Core
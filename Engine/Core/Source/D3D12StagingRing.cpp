@@ -0,0 +1,84 @@
+#include "D3D12StagingRing.h"
+#include <iostream>
+
+namespace D3D12Core {
+
+    D3D12StagingRing::D3D12StagingRing() {
+    }
+
+    D3D12StagingRing::~D3D12StagingRing() {
+        Shutdown();
+    }
+
+    bool D3D12StagingRing::Initialize(ID3D12Device* device, UINT64 capacity) {
+        D3D12_HEAP_PROPERTIES heapProps = {};
+        heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+        heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+
+        D3D12_RESOURCE_DESC resourceDesc = {};
+        resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        resourceDesc.Width = capacity;
+        resourceDesc.Height = 1;
+        resourceDesc.DepthOrArraySize = 1;
+        resourceDesc.MipLevels = 1;
+        resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
+        resourceDesc.SampleDesc.Count = 1;
+        resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        resourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+        HRESULT hr = device->CreateCommittedResource(
+            &heapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &resourceDesc,
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            nullptr,
+            IID_PPV_ARGS(&m_resource)
+        );
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to create staging ring" << std::endl;
+            return false;
+        }
+
+        // Mapeo persistente: los upload heaps pueden quedar mapeados mientras la GPU lee
+        D3D12_RANGE readRange = { 0, 0 };
+        void* mappedData = nullptr;
+        hr = m_resource->Map(0, &readRange, &mappedData);
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to map staging ring" << std::endl;
+            return false;
+        }
+        m_mappedData = static_cast<BYTE*>(mappedData);
+
+        m_ring.Initialize(capacity);
+        return true;
+    }
+
+    void D3D12StagingRing::Shutdown() {
+        if (m_resource && m_mappedData) {
+            m_resource->Unmap(0, nullptr);
+            m_mappedData = nullptr;
+        }
+        m_resource.Reset();
+        m_ring.Reset();
+    }
+
+    StagingAllocation D3D12StagingRing::Allocate(UINT64 size, UINT64 alignment) {
+        StagingAllocation allocation;
+        if (!m_mappedData) {
+            return allocation;
+        }
+
+        UINT64 offset = m_ring.Allocate(size, alignment);
+        if (offset == RingAllocator::INVALID_OFFSET) {
+            return allocation;
+        }
+
+        allocation.resource = m_resource.Get();
+        allocation.offset = offset;
+        allocation.cpuAddress = m_mappedData + offset;
+        allocation.size = size;
+        return allocation;
+    }
+
+} // namespace D3D12Core
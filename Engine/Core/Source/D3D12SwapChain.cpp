@@ -15,12 +15,14 @@ namespace D3D12Core {
         HWND hwnd,
         IDXGIFactory4* factory,
         ID3D12CommandQueue* commandQueue,
+        D3D12DescriptorManager* descriptorManager,
         UINT width,
         UINT height,
         UINT bufferCount
     ) {
         m_factory = factory;
         m_commandQueue = commandQueue;
+        m_descriptorManager = descriptorManager;
         m_bufferCount = bufferCount;
         m_width = width;
         m_height = height;
@@ -29,6 +31,13 @@ namespace D3D12Core {
             return false;
         }
 
+        // RTVs del gestor central en lugar de un heap propio
+        m_rtvs = m_descriptorManager ? m_descriptorManager->AllocatePersistent(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, m_bufferCount) : DescriptorHandle{};
+        if (!m_rtvs.IsValid()) {
+            std::cerr << "Error: Failed to allocate swap chain RTVs" << std::endl;
+            return false;
+        }
+
         m_currentBackBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
 
         // Crear render target views
@@ -49,7 +58,9 @@ namespace D3D12Core {
         for (UINT i = 0; i < m_bufferCount; ++i) {
             m_backBuffers[i].Reset();
         }
-        m_rtvHeap.Reset();
+        if (m_descriptorManager) {
+            m_descriptorManager->Free(m_rtvs);
+        }
         m_swapChain.Reset();
     }
 
@@ -115,9 +126,7 @@ namespace D3D12Core {
     }
 
     D3D12_CPU_DESCRIPTOR_HANDLE D3D12SwapChain::GetCurrentRTV() const {
-        D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = m_rtvHeap->GetCPUDescriptorHandleForHeapStart();
-        rtvHandle.ptr += m_currentBackBufferIndex * m_rtvDescriptorSize;
-        return rtvHandle;
+        return m_rtvs.GetCPU(m_currentBackBufferIndex);
     }
 
     bool D3D12SwapChain::CreateSwapChain(HWND hwnd, UINT width, UINT height) {
@@ -163,31 +172,15 @@ namespace D3D12Core {
     }
 
     bool D3D12SwapChain::CreateRenderTargetViews(ID3D12Device* device) {
-        // Crear descriptor heap para RTVs
-        D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
-        rtvHeapDesc.NumDescriptors = m_bufferCount;
-        rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-        rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-
-        HRESULT hr = device->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&m_rtvHeap));
-        if (FAILED(hr)) {
-            std::cerr << "Error: Failed to create RTV descriptor heap" << std::endl;
-            return false;
-        }
-
-        m_rtvDescriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
-
-        // Crear RTV para cada back buffer
-        D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = m_rtvHeap->GetCPUDescriptorHandleForHeapStart();
+        // Crear RTV para cada back buffer (la GPU está inactiva al redimensionar: se sobrescriben)
         for (UINT i = 0; i < m_bufferCount; ++i) {
-            hr = m_swapChain->GetBuffer(i, IID_PPV_ARGS(&m_backBuffers[i]));
+            HRESULT hr = m_swapChain->GetBuffer(i, IID_PPV_ARGS(&m_backBuffers[i]));
             if (FAILED(hr)) {
                 std::cerr << "Error: Failed to get back buffer " << i << std::endl;
                 return false;
             }
 
-            device->CreateRenderTargetView(m_backBuffers[i].Get(), nullptr, rtvHandle);
-            rtvHandle.ptr += m_rtvDescriptorSize;
+            device->CreateRenderTargetView(m_backBuffers[i].Get(), nullptr, m_rtvs.GetCPU(i));
         }
 
         return true;
@@ -0,0 +1,406 @@
+#include "D3D12UploadManager.h"
+#include "D3D12Buffer.h"
+#include <iostream>
+#include <cstring>
+
+namespace D3D12Core {
+
+    D3D12UploadManager::D3D12UploadManager() {
+    }
+
+    D3D12UploadManager::~D3D12UploadManager() {
+        Shutdown();
+    }
+
+    bool D3D12UploadManager::Initialize(ID3D12Device* device, UINT64 stagingCapacity) {
+        m_device = device;
+
+        // Staging persistente y acotado: todas las subidas sub-asignan de este anillo
+        if (!m_stagingRing.Initialize(device, stagingCapacity)) {
+            std::cerr << "Error: Failed to initialize upload staging ring" << std::endl;
+            return false;
+        }
+
+        // Cola de copia dedicada: las subidas no compiten con la cola directa
+        D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+        queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+        queueDesc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+        queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+        queueDesc.NodeMask = 0;
+
+        HRESULT hr = device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_copyQueue));
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to create copy queue" << std::endl;
+            return false;
+        }
+
+        ComPtr<ID3D12CommandAllocator> allocator;
+        hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&allocator));
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to create copy command allocator" << std::endl;
+            return false;
+        }
+
+        hr = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, allocator.Get(), nullptr, IID_PPV_ARGS(&m_commandList));
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to create copy command list" << std::endl;
+            return false;
+        }
+        m_commandList->Close();
+        m_freeAllocators.push_back(allocator);
+
+        hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence));
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to create upload fence" << std::endl;
+            return false;
+        }
+
+        m_fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        if (m_fenceEvent == nullptr) {
+            std::cerr << "Error: Failed to create upload fence event" << std::endl;
+            return false;
+        }
+
+        m_nextFenceValue = 1;
+        m_lastSubmittedValue = 0;
+        return true;
+    }
+
+    void D3D12UploadManager::Shutdown() {
+        if (m_copyQueue && m_fence) {
+            if (m_batchOpen) {
+                Submit();
+            }
+            UploadToken lastToken;
+            lastToken.fenceValue = m_lastSubmittedValue;
+            WaitForToken(lastToken);
+            RetireCompleted();
+        }
+
+        if (m_fenceEvent) {
+            CloseHandle(m_fenceEvent);
+            m_fenceEvent = nullptr;
+        }
+
+        m_inFlightBatches.clear();
+        m_freeAllocators.clear();
+        m_openBatch = Batch{};
+        m_batchOpen = false;
+        m_queueWaits.clear();
+        m_commandList.Reset();
+        m_fence.Reset();
+        m_copyQueue.Reset();
+        m_stagingRing.Shutdown();
+        m_device = nullptr;
+    }
+
+    bool D3D12UploadManager::OpenBatch() {
+        if (m_batchOpen) {
+            return true;
+        }
+
+        RetireCompleted();
+
+        ComPtr<ID3D12CommandAllocator> allocator;
+        if (!m_freeAllocators.empty()) {
+            allocator = m_freeAllocators.back();
+            m_freeAllocators.pop_back();
+        } else {
+            HRESULT hr = m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&allocator));
+            if (FAILED(hr)) {
+                std::cerr << "Error: Failed to create copy command allocator" << std::endl;
+                return false;
+            }
+        }
+
+        allocator->Reset();
+        m_commandList->Reset(allocator.Get(), nullptr);
+
+        m_openBatch = Batch{};
+        m_openBatch.allocator = allocator;
+        m_openBatch.fenceValue = m_nextFenceValue;
+        m_batchOpen = true;
+        return true;
+    }
+
+    StagingAllocation D3D12UploadManager::AllocateStaging(UINT64 size, UINT64 alignment) {
+        StagingAllocation allocation = m_stagingRing.Allocate(size, alignment);
+        if (allocation.IsValid()) {
+            return allocation;
+        }
+
+        // Anillo lleno: enviar el lote abierto para que sus bytes tengan fence
+        // y esperar solo hasta que la GPU libere lo necesario
+        if (m_batchOpen) {
+            Submit();
+        }
+
+        UINT64 fenceToWait = m_stagingRing.GetFenceToFit(size, alignment);
+        if (fenceToWait == RingAllocator::INVALID_OFFSET) {
+            std::cerr << "Error: Upload does not fit in staging ring (" << size << " bytes)" << std::endl;
+            return allocation;
+        }
+
+        UploadToken token;
+        token.fenceValue = fenceToWait;
+        WaitForToken(token);
+        RetireCompleted();
+        m_stats.stagingStalls++;
+
+        return m_stagingRing.Allocate(size, alignment);
+    }
+
+    UploadToken D3D12UploadManager::UploadBuffer(D3D12Buffer* destination, const void* data, UINT64 size, UINT64 destinationOffset) {
+        UploadToken token;
+        if (!destination || !destination->GetResource() || !data || size == 0) {
+            return token;
+        }
+        if (destinationOffset + size > destination->GetSize()) {
+            std::cerr << "Error: Upload exceeds destination buffer size" << std::endl;
+            return token;
+        }
+
+        // Subidas mayores que medio anillo se trocean para no vaciarlo de golpe
+        const UINT64 maxChunk = (m_stagingRing.GetCapacity() / 2 > 0) ? m_stagingRing.GetCapacity() / 2 : 1;
+        const BYTE* source = static_cast<const BYTE*>(data);
+        UINT64 copied = 0;
+
+        while (copied < size) {
+            UINT64 chunk = (size - copied < maxChunk) ? size - copied : maxChunk;
+
+            StagingAllocation staging = AllocateStaging(chunk, 16);
+            if (!staging.IsValid() || !OpenBatch()) {
+                return UploadToken{};
+            }
+
+            memcpy(staging.cpuAddress, source + copied, chunk);
+
+            // Los buffers en COMMON se promocionan implícitamente a COPY_DEST en la cola de copia
+            // y vuelven a COMMON al terminar, así que no hace falta ninguna barrera aquí
+            m_commandList->CopyBufferRegion(destination->GetResource(), destination->GetOffset() + destinationOffset + copied, staging.resource, staging.offset, chunk);
+
+            m_openBatch.destinations.push_back(destination->GetResource());
+            m_openBatch.bytes += chunk;
+            copied += chunk;
+            token.fenceValue = m_openBatch.fenceValue;
+        }
+
+        m_stats.uploadCount++;
+        m_stats.bytesQueued += size;
+        if (m_load.active) {
+            m_load.uploads++;
+            m_load.bytes += size;
+        }
+
+        return token;
+    }
+
+    UploadToken D3D12UploadManager::UploadTexture2D(ID3D12Resource* destination, const void* data, UINT rowPitch, UINT subresource) {
+        UploadToken token;
+        if (!destination || !data) {
+            return token;
+        }
+
+        // Las filas del staging deben respetar D3D12_TEXTURE_DATA_PITCH_ALIGNMENT
+        D3D12_RESOURCE_DESC desc = destination->GetDesc();
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint = {};
+        UINT numRows = 0;
+        UINT64 rowSizeInBytes = 0;
+        UINT64 totalBytes = 0;
+        m_device->GetCopyableFootprints(&desc, subresource, 1, 0, &footprint, &numRows, &rowSizeInBytes, &totalBytes);
+
+        StagingAllocation staging = AllocateStaging(totalBytes, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+        if (!staging.IsValid() || !OpenBatch()) {
+            return token;
+        }
+
+        const BYTE* source = static_cast<const BYTE*>(data);
+        BYTE* target = static_cast<BYTE*>(staging.cpuAddress);
+        UINT64 copyBytes = (rowSizeInBytes < rowPitch) ? rowSizeInBytes : rowPitch;
+        for (UINT row = 0; row < numRows * footprint.Footprint.Depth; ++row) {
+            memcpy(target + row * footprint.Footprint.RowPitch, source + row * rowPitch, copyBytes);
+        }
+
+        D3D12_TEXTURE_COPY_LOCATION dst = {};
+        dst.pResource = destination;
+        dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+        dst.SubresourceIndex = subresource;
+
+        D3D12_TEXTURE_COPY_LOCATION src = {};
+        src.pResource = staging.resource;
+        src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        src.PlacedFootprint = footprint;
+        src.PlacedFootprint.Offset = staging.offset;
+
+        m_commandList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+
+        m_openBatch.destinations.push_back(destination);
+        m_openBatch.bytes += totalBytes;
+        m_stats.uploadCount++;
+        m_stats.bytesQueued += totalBytes;
+        if (m_load.active) {
+            m_load.uploads++;
+            m_load.bytes += totalBytes;
+        }
+
+        token.fenceValue = m_openBatch.fenceValue;
+        return token;
+    }
+
+    UploadToken D3D12UploadManager::Submit() {
+        UploadToken token;
+        token.fenceValue = m_lastSubmittedValue;
+        if (!m_batchOpen) {
+            return token;
+        }
+
+        HRESULT hr = m_commandList->Close();
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to close copy command list" << std::endl;
+            return token;
+        }
+
+        ID3D12CommandList* commandLists[] = { m_commandList.Get() };
+        m_copyQueue->ExecuteCommandLists(1, commandLists);
+
+        hr = m_copyQueue->Signal(m_fence.Get(), m_openBatch.fenceValue);
+        if (FAILED(hr)) {
+            std::cerr << "Error: Failed to signal upload fence" << std::endl;
+        }
+
+        m_stagingRing.FinishSubmission(m_openBatch.fenceValue);
+
+        m_openBatch.submitTime = Clock::now();
+        m_lastSubmittedValue = m_openBatch.fenceValue;
+        m_nextFenceValue = m_openBatch.fenceValue + 1;
+        m_inFlightBatches.push_back(std::move(m_openBatch));
+        m_openBatch = Batch{};
+        m_batchOpen = false;
+
+        m_stats.submissions++;
+        if (m_load.active) {
+            m_load.submissions++;
+            m_load.lastFenceValue = m_lastSubmittedValue;
+        }
+
+        token.fenceValue = m_lastSubmittedValue;
+        return token;
+    }
+
+    void D3D12UploadManager::RetireCompleted() {
+        if (!m_fence) {
+            return;
+        }
+
+        UINT64 completed = m_fence->GetCompletedValue();
+        Clock::time_point now = Clock::now();
+
+        while (!m_inFlightBatches.empty() && m_inFlightBatches.front().fenceValue <= completed) {
+            Batch& batch = m_inFlightBatches.front();
+            m_stats.bytesCompleted += batch.bytes;
+            m_stats.completedSeconds += std::chrono::duration<double>(now - batch.submitTime).count();
+            m_freeAllocators.push_back(batch.allocator);
+            m_inFlightBatches.pop_front();
+        }
+        m_stagingRing.Retire(completed);
+
+        ReportLoadIfComplete();
+    }
+
+    bool D3D12UploadManager::IsComplete(const UploadToken& token) const {
+        if (!token.IsValid()) {
+            return true;
+        }
+        return m_fence && m_fence->GetCompletedValue() >= token.fenceValue;
+    }
+
+    void D3D12UploadManager::WaitForToken(const UploadToken& token) {
+        if (!token.IsValid() || !m_fence) {
+            return;
+        }
+        if (token.fenceValue > m_lastSubmittedValue) {
+            Submit();
+        }
+
+        if (m_fence->GetCompletedValue() < token.fenceValue) {
+            HRESULT hr = m_fence->SetEventOnCompletion(token.fenceValue, m_fenceEvent);
+            if (FAILED(hr)) {
+                std::cerr << "Error: Failed to set upload event on completion" << std::endl;
+                return;
+            }
+            WaitForSingleObject(m_fenceEvent, INFINITE);
+        }
+    }
+
+    void D3D12UploadManager::RequireOnQueue(const UploadToken& token, ID3D12CommandQueue* queue) {
+        if (!token.IsValid() || !queue || !m_fence) {
+            return;
+        }
+
+        // El recurso pertenece al lote abierto: enviarlo antes de que alguien espere por él
+        if (token.fenceValue > m_lastSubmittedValue) {
+            Submit();
+        }
+
+        if (m_fence->GetCompletedValue() >= token.fenceValue) {
+            return; // La copia ya terminó: no hace falta sincronizar
+        }
+
+        QueueWait* entry = nullptr;
+        for (QueueWait& wait : m_queueWaits) {
+            if (wait.queue == queue) {
+                entry = &wait;
+                break;
+            }
+        }
+        if (!entry) {
+            m_queueWaits.push_back(QueueWait{ queue, 0 });
+            entry = &m_queueWaits.back();
+        }
+
+        if (entry->waitedValue >= token.fenceValue) {
+            return; // Esa cola ya espera a un valor igual o posterior
+        }
+
+        // Espera GPU->GPU: la CPU no se bloquea
+        queue->Wait(m_fence.Get(), token.fenceValue);
+        entry->waitedValue = token.fenceValue;
+        m_stats.directQueueWaits++;
+    }
+
+    void D3D12UploadManager::BeginLoad() {
+        m_load = LoadReport{};
+        m_load.start = Clock::now();
+        m_load.active = true;
+    }
+
+    void D3D12UploadManager::EndLoad() {
+        if (!m_load.active) {
+            return;
+        }
+
+        Submit();
+        m_load.active = false;
+        m_load.pending = true;
+        ReportLoadIfComplete();
+    }
+
+    void D3D12UploadManager::ReportLoadIfComplete() {
+        if (!m_load.pending || !m_fence) {
+            return;
+        }
+        if (m_fence->GetCompletedValue() < m_load.lastFenceValue) {
+            return; // Se informará cuando el último lote de la carga termine
+        }
+
+        double seconds = std::chrono::duration<double>(Clock::now() - m_load.start).count();
+        double megabytes = m_load.bytes / (1024.0 * 1024.0);
+        double throughput = seconds > 0.0 ? megabytes / seconds : 0.0;
+
+        std::cout << "[Upload] Carga completada: " << m_load.uploads << " subidas, "
+                  << megabytes << " MB en " << m_load.submissions << " envio(s), "
+                  << throughput << " MB/s" << std::endl;
+        m_load.pending = false;
+    }
+
+} // namespace D3D12Core
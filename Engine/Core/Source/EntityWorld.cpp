@@ -0,0 +1,425 @@
+#include "EntityWorld.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+
+namespace D3D12Core {
+
+    namespace {
+
+        struct ComponentTypeInfo {
+            uint32_t size = 0;
+            uint32_t alignment = 0;
+        };
+
+        std::mutex g_componentTypesMutex;
+        ComponentTypeInfo g_componentTypes[MAX_COMPONENT_TYPES];
+        uint32_t g_componentTypeCount = 0;
+
+        uint32_t AlignUp(uint32_t value, uint32_t alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+    } // namespace
+
+    ComponentTypeId RegisterComponentType(uint32_t size, uint32_t alignment) {
+        std::lock_guard<std::mutex> lock(g_componentTypesMutex);
+        if (g_componentTypeCount == MAX_COMPONENT_TYPES) {
+            std::cerr << "Error: Demasiados tipos de componente (maximo " << MAX_COMPONENT_TYPES << ")" << std::endl;
+            return INVALID_COMPONENT_TYPE;
+        }
+        g_componentTypes[g_componentTypeCount] = { size, alignment };
+        return g_componentTypeCount++;
+    }
+
+    uint32_t GetComponentSize(ComponentTypeId type) {
+        return type < MAX_COMPONENT_TYPES ? g_componentTypes[type].size : 0;
+    }
+
+    EntityWorld::EntityWorld() {
+        // Arquetipo 0: entidades sin componentes
+        FindOrCreateArchetype(0);
+    }
+
+    EntityWorld::~EntityWorld() = default;
+
+    bool EntityWorld::AddToMask(ComponentMask& mask, ComponentTypeId type) const {
+        if (type >= MAX_COMPONENT_TYPES) {
+            return false;
+        }
+        const ComponentMask bit = 1ull << type;
+        if (mask & bit) {
+            std::cerr << "Error: Componente repetido en una consulta" << std::endl;
+            return false;
+        }
+        mask |= bit;
+        return true;
+    }
+
+    bool EntityWorld::CheckStructuralChange(const char* operation) const {
+        if (m_iterationDepth > 0) {
+            std::cerr << "Error: " << operation << " dentro de ForEach; usa un EntityCommandBuffer" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    const EntityWorld::EntityRecord* EntityWorld::FindRecord(Entity entity) const {
+        if (entity.index >= m_records.size()) {
+            return nullptr;
+        }
+        const EntityRecord& record = m_records[entity.index];
+        if (record.archetype == NO_ARCHETYPE || record.generation != entity.generation) {
+            return nullptr;
+        }
+        return &record;
+    }
+
+    bool EntityWorld::IsAlive(Entity entity) const {
+        return FindRecord(entity) != nullptr;
+    }
+
+    uint32_t EntityWorld::FindOrCreateArchetype(ComponentMask mask) {
+        auto found = m_archetypeByMask.find(mask);
+        if (found != m_archetypeByMask.end()) {
+            return found->second;
+        }
+
+        auto archetype = std::make_unique<EntityArchetype>();
+        archetype->mask = mask;
+        for (ComponentMask bits = mask; bits != 0; bits &= bits - 1) {
+            archetype->types.push_back(static_cast<ComponentTypeId>(std::countr_zero(bits)));
+        }
+
+        // Filas por chunk: la mayor capacidad con la que las columnas (entidades + componentes,
+        // cada una alineada) caben en ENTITY_CHUNK_SIZE
+        uint32_t rowSize = sizeof(Entity);
+        for (ComponentTypeId type : archetype->types) {
+            rowSize += g_componentTypes[type].size;
+        }
+        uint32_t capacity = ENTITY_CHUNK_SIZE / rowSize;
+        for (; capacity > 0; capacity--) {
+            uint32_t offset = AlignUp(capacity * static_cast<uint32_t>(sizeof(Entity)), COLUMN_ALIGNMENT);
+            bool fits = true;
+            for (ComponentTypeId type : archetype->types) {
+                offset = AlignUp(offset, std::max(COLUMN_ALIGNMENT, g_componentTypes[type].alignment));
+                archetype->columnOffsets[type] = offset;
+                offset += capacity * g_componentTypes[type].size;
+                if (offset > ENTITY_CHUNK_SIZE) {
+                    fits = false;
+                    break;
+                }
+            }
+            if (fits) {
+                break;
+            }
+        }
+        if (capacity == 0) {
+            std::cerr << "Error: Los componentes del arquetipo no caben en un chunk de " << ENTITY_CHUNK_SIZE
+                      << " bytes" << std::endl;
+            capacity = 1; // Se desborda el chunk antes que perder la entidad; no debería ocurrir con datos planos
+        }
+        archetype->chunkCapacity = capacity;
+
+        const uint32_t index = static_cast<uint32_t>(m_archetypes.size());
+        m_archetypes.push_back(std::move(archetype));
+        m_archetypeByMask.emplace(mask, index);
+        return index;
+    }
+
+    uint8_t* EntityWorld::AcquireChunk() {
+        if (!m_freeChunks.empty()) {
+            uint8_t* chunk = m_freeChunks.back();
+            m_freeChunks.pop_back();
+            return chunk;
+        }
+        m_chunkStorage.push_back(std::make_unique<ChunkMemory>());
+        return m_chunkStorage.back()->bytes;
+    }
+
+    void EntityWorld::AllocateRow(EntityArchetype& archetype, uint32_t& chunk, uint32_t& row) {
+        if (archetype.chunks.empty() || archetype.chunkCounts.back() == archetype.chunkCapacity) {
+            archetype.chunks.push_back(AcquireChunk());
+            archetype.chunkCounts.push_back(0);
+        }
+        chunk = static_cast<uint32_t>(archetype.chunks.size() - 1);
+        row = archetype.chunkCounts[chunk]++;
+        archetype.entityCount++;
+    }
+
+    void EntityWorld::RemoveRow(EntityArchetype& archetype, uint32_t chunk, uint32_t row) {
+        const uint32_t lastChunk = static_cast<uint32_t>(archetype.chunks.size() - 1);
+        const uint32_t lastRow = archetype.chunkCounts[lastChunk] - 1;
+        if (chunk != lastChunk || row != lastRow) {
+            uint8_t* destination = archetype.chunks[chunk];
+            const uint8_t* source = archetype.chunks[lastChunk];
+            const Entity moved = reinterpret_cast<const Entity*>(source)[lastRow];
+            reinterpret_cast<Entity*>(destination)[row] = moved;
+            for (ComponentTypeId type : archetype.types) {
+                const uint32_t size = g_componentTypes[type].size;
+                const uint32_t offset = archetype.columnOffsets[type];
+                std::memcpy(destination + offset + row * size, source + offset + lastRow * size, size);
+            }
+            m_records[moved.index].chunk = chunk;
+            m_records[moved.index].row = row;
+        }
+
+        archetype.entityCount--;
+        if (--archetype.chunkCounts[lastChunk] == 0) {
+            m_freeChunks.push_back(archetype.chunks[lastChunk]);
+            archetype.chunks.pop_back();
+            archetype.chunkCounts.pop_back();
+        }
+    }
+
+    void EntityWorld::MoveEntity(EntityRecord& record, uint32_t targetArchetype) {
+        EntityArchetype& source = *m_archetypes[record.archetype];
+        EntityArchetype& target = *m_archetypes[targetArchetype];
+        uint32_t chunk = 0, row = 0;
+        AllocateRow(target, chunk, row);
+
+        // Componentes comunes a los dos arquetipos; los nuevos los escribe quien llama
+        const uint8_t* sourceChunk = source.chunks[record.chunk];
+        uint8_t* targetChunk = target.chunks[chunk];
+        reinterpret_cast<Entity*>(targetChunk)[row] = reinterpret_cast<const Entity*>(sourceChunk)[record.row];
+        for (ComponentTypeId type : target.types) {
+            if (source.mask & (1ull << type)) {
+                const uint32_t size = g_componentTypes[type].size;
+                std::memcpy(targetChunk + target.columnOffsets[type] + row * size,
+                    sourceChunk + source.columnOffsets[type] + record.row * size, size);
+            }
+        }
+
+        RemoveRow(source, record.chunk, record.row);
+        record.archetype = targetArchetype;
+        record.chunk = chunk;
+        record.row = row;
+        m_stats.archetypeMoves++;
+    }
+
+    Entity EntityWorld::CreateEntity() {
+        if (!CheckStructuralChange("CreateEntity")) {
+            return INVALID_ENTITY;
+        }
+        uint32_t index;
+        if (!m_freeRecords.empty()) {
+            index = m_freeRecords.back();
+            m_freeRecords.pop_back();
+        }
+        else {
+            index = static_cast<uint32_t>(m_records.size());
+            m_records.emplace_back();
+        }
+
+        EntityRecord& record = m_records[index];
+        const Entity entity = { index, record.generation };
+        EntityArchetype& archetype = *m_archetypes[0];
+        AllocateRow(archetype, record.chunk, record.row);
+        reinterpret_cast<Entity*>(archetype.chunks[record.chunk])[record.row] = entity;
+        record.archetype = 0;
+        m_entityCount++;
+        m_stats.created++;
+        return entity;
+    }
+
+    bool EntityWorld::DestroyEntity(Entity entity) {
+        if (!CheckStructuralChange("DestroyEntity") || !FindRecord(entity)) {
+            return false;
+        }
+        EntityRecord& record = m_records[entity.index];
+        RemoveRow(*m_archetypes[record.archetype], record.chunk, record.row);
+        record.archetype = NO_ARCHETYPE;
+        record.generation++;
+        m_freeRecords.push_back(entity.index);
+        m_entityCount--;
+        m_stats.destroyed++;
+        return true;
+    }
+
+    void EntityWorld::Clear() {
+        if (!CheckStructuralChange("Clear")) {
+            return;
+        }
+        for (std::unique_ptr<EntityArchetype>& archetype : m_archetypes) {
+            m_freeChunks.insert(m_freeChunks.end(), archetype->chunks.begin(), archetype->chunks.end());
+            archetype->chunks.clear();
+            archetype->chunkCounts.clear();
+            archetype->entityCount = 0;
+        }
+        // Las generaciones se conservan: los handles anteriores siguen siendo inválidos
+        m_freeRecords.clear();
+        for (uint32_t index = static_cast<uint32_t>(m_records.size()); index-- > 0;) {
+            if (m_records[index].archetype != NO_ARCHETYPE) {
+                m_records[index].archetype = NO_ARCHETYPE;
+                m_records[index].generation++;
+            }
+            m_freeRecords.push_back(index);
+        }
+        m_stats.destroyed += m_entityCount;
+        m_entityCount = 0;
+    }
+
+    bool EntityWorld::AddComponentData(Entity entity, ComponentTypeId type, const void* data) {
+        if (type >= MAX_COMPONENT_TYPES || !FindRecord(entity)) {
+            return false;
+        }
+        EntityRecord& record = m_records[entity.index];
+        const uint32_t size = g_componentTypes[type].size;
+        if (!(m_archetypes[record.archetype]->mask & (1ull << type))) {
+            if (!CheckStructuralChange("AddComponent")) {
+                return false;
+            }
+            uint32_t& edge = m_archetypes[record.archetype]->addEdges[type];
+            if (edge == 0) {
+                edge = FindOrCreateArchetype(m_archetypes[record.archetype]->mask | (1ull << type)) + 1;
+            }
+            MoveEntity(record, edge - 1);
+        }
+        const EntityArchetype& archetype = *m_archetypes[record.archetype];
+        std::memcpy(archetype.chunks[record.chunk] + archetype.columnOffsets[type] + record.row * size, data, size);
+        return true;
+    }
+
+    bool EntityWorld::RemoveComponentData(Entity entity, ComponentTypeId type) {
+        if (type >= MAX_COMPONENT_TYPES || !FindRecord(entity)) {
+            return false;
+        }
+        EntityRecord& record = m_records[entity.index];
+        if (!(m_archetypes[record.archetype]->mask & (1ull << type))) {
+            return false;
+        }
+        if (!CheckStructuralChange("RemoveComponent")) {
+            return false;
+        }
+        uint32_t& edge = m_archetypes[record.archetype]->removeEdges[type];
+        if (edge == 0) {
+            edge = FindOrCreateArchetype(m_archetypes[record.archetype]->mask & ~(1ull << type)) + 1;
+        }
+        MoveEntity(record, edge - 1);
+        return true;
+    }
+
+    void* EntityWorld::GetComponentData(Entity entity, ComponentTypeId type) {
+        const EntityRecord* record = FindRecord(entity);
+        if (!record || type >= MAX_COMPONENT_TYPES) {
+            return nullptr;
+        }
+        const EntityArchetype& archetype = *m_archetypes[record->archetype];
+        if (!(archetype.mask & (1ull << type))) {
+            return nullptr;
+        }
+        return archetype.chunks[record->chunk] + archetype.columnOffsets[type] + record->row * g_componentTypes[type].size;
+    }
+
+    bool EntityWorld::HasComponentData(Entity entity, ComponentTypeId type) const {
+        const EntityRecord* record = FindRecord(entity);
+        return record && type < MAX_COMPONENT_TYPES && (m_archetypes[record->archetype]->mask & (1ull << type));
+    }
+
+    const std::vector<uint32_t>& EntityWorld::MatchArchetypes(ComponentMask mask) {
+        m_stats.queries++;
+        auto cache = std::find_if(m_queryCaches.begin(), m_queryCaches.end(),
+            [mask](const QueryCache& query) { return query.mask == mask; });
+        if (cache == m_queryCaches.end()) {
+            m_queryCaches.emplace_back();
+            cache = m_queryCaches.end() - 1;
+            cache->mask = mask;
+        }
+        const uint32_t archetypeCount = static_cast<uint32_t>(m_archetypes.size());
+        for (uint32_t index = cache->checkedArchetypes; index < archetypeCount; index++) {
+            if ((m_archetypes[index]->mask & mask) == mask) {
+                cache->archetypes.push_back(index);
+            }
+        }
+        m_stats.archetypesMatched += archetypeCount - cache->checkedArchetypes;
+        cache->checkedArchetypes = archetypeCount;
+        return cache->archetypes;
+    }
+
+    const std::vector<EntityWorld::QueryChunk>& EntityWorld::GatherChunks(ComponentMask mask) {
+        m_queryChunks.clear();
+        uint32_t firstIndex = 0;
+        for (uint32_t archetypeIndex : MatchArchetypes(mask)) {
+            const EntityArchetype& archetype = *m_archetypes[archetypeIndex];
+            for (uint32_t chunk = 0; chunk < archetype.chunks.size(); chunk++) {
+                m_queryChunks.push_back({ archetypeIndex, chunk, firstIndex });
+                firstIndex += archetype.chunkCounts[chunk];
+            }
+        }
+        return m_queryChunks;
+    }
+
+    std::string EntityWorld::BuildReport() const {
+        std::ostringstream report;
+        report << "Entidades: " << m_entityCount << ", arquetipos: " << m_archetypes.size() << ", chunks: "
+               << GetChunkCount() << " en uso + " << m_freeChunks.size() << " libres ("
+               << (m_chunkStorage.size() * ENTITY_CHUNK_SIZE) / 1024 << " KB)\n";
+        report << "Creadas: " << m_stats.created << ", destruidas: " << m_stats.destroyed
+               << ", movimientos entre arquetipos: " << m_stats.archetypeMoves << "\n";
+        report << "Consultas: " << m_stats.queries << " (" << m_queryCaches.size() << " en cache, "
+               << m_stats.archetypesMatched << " arquetipos comprobados)\n";
+        return report.str();
+    }
+
+    Entity EntityCommandBuffer::CreateEntity() {
+        const Entity entity = { PENDING_ENTITY | m_pendingCount++, 0 };
+        m_commands.push_back({ CommandType::Create, INVALID_COMPONENT_TYPE, entity, 0 });
+        return entity;
+    }
+
+    void EntityCommandBuffer::DestroyEntity(Entity entity) {
+        Record(CommandType::Destroy, entity, INVALID_COMPONENT_TYPE, nullptr, 0);
+    }
+
+    void EntityCommandBuffer::Record(CommandType type, Entity entity, ComponentTypeId component, const void* data, uint32_t size) {
+        const uint32_t dataOffset = static_cast<uint32_t>(m_data.size());
+        if (size > 0) {
+            m_data.resize(m_data.size() + size);
+            std::memcpy(m_data.data() + dataOffset, data, size);
+        }
+        m_commands.push_back({ type, component, entity, dataOffset });
+    }
+
+    uint32_t EntityCommandBuffer::Playback(EntityWorld& world) {
+        m_createdEntities.assign(m_pendingCount, INVALID_ENTITY);
+        uint32_t failed = 0;
+        for (const Command& command : m_commands) {
+            Entity entity = command.entity;
+            if (command.type != CommandType::Create && (entity.index & PENDING_ENTITY) && entity.index != INVALID_ENTITY.index) {
+                entity = m_createdEntities[entity.index & ~PENDING_ENTITY];
+            }
+
+            bool succeeded = false;
+            switch (command.type) {
+            case CommandType::Create:
+                m_createdEntities[command.entity.index & ~PENDING_ENTITY] = world.CreateEntity();
+                succeeded = m_createdEntities[command.entity.index & ~PENDING_ENTITY] != INVALID_ENTITY;
+                break;
+            case CommandType::Destroy:
+                succeeded = world.DestroyEntity(entity);
+                break;
+            case CommandType::Add:
+                succeeded = world.AddComponentData(entity, command.component, m_data.data() + command.dataOffset);
+                break;
+            case CommandType::Remove:
+                succeeded = world.RemoveComponentData(entity, command.component);
+                break;
+            }
+            if (!succeeded) {
+                failed++;
+            }
+        }
+        Clear();
+        return failed;
+    }
+
+    void EntityCommandBuffer::Clear() {
+        m_commands.clear();
+        m_data.clear();
+        m_pendingCount = 0;
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,136 @@
+#include "FakeGpuQueue.h"
+#include <chrono>
+
+namespace D3D12Core {
+
+    FakeGpuQueue::FakeGpuQueue() {
+    }
+
+    FakeGpuQueue::~FakeGpuQueue() {
+        Shutdown();
+    }
+
+    bool FakeGpuQueue::Initialize() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_running) {
+            return true;
+        }
+
+        m_running = true;
+        m_paused = false;
+        m_gpuThread = std::thread(&FakeGpuQueue::GpuThreadMain, this);
+        return true;
+    }
+
+    void FakeGpuQueue::Shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_running) {
+                return;
+            }
+            m_running = false;
+            m_paused = false;
+        }
+        m_workAvailable.notify_all();
+
+        if (m_gpuThread.joinable()) {
+            m_gpuThread.join();
+        }
+
+        // Completar cualquier señal pendiente para no dejar hilos bloqueados
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending.clear();
+            m_completedValue.store(m_nextSignalValue);
+        }
+        m_fenceAdvanced.notify_all();
+    }
+
+    void FakeGpuQueue::ExecuteCommandList(double gpuMilliseconds) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            QueueItem item;
+            item.gpuMilliseconds = gpuMilliseconds;
+            m_pending.push_back(item);
+        }
+        m_workAvailable.notify_one();
+    }
+
+    uint64_t FakeGpuQueue::Signal() {
+        uint64_t value = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            value = ++m_nextSignalValue;
+            QueueItem item;
+            item.signalValue = value;
+            m_pending.push_back(item);
+        }
+        m_signalCount++;
+        m_workAvailable.notify_one();
+        return value;
+    }
+
+    uint64_t FakeGpuQueue::GetCompletedValue() const {
+        return m_completedValue.load();
+    }
+
+    void FakeGpuQueue::WaitForFenceValue(uint64_t fenceValue) {
+        if (m_completedValue.load() >= fenceValue) {
+            return;
+        }
+
+        m_cpuWaitCount++;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_fenceAdvanced.wait(lock, [&]() {
+            return m_completedValue.load() >= fenceValue || !m_running;
+        });
+    }
+
+    void FakeGpuQueue::SetPaused(bool paused) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_paused = paused;
+        }
+        m_workAvailable.notify_all();
+    }
+
+    double FakeGpuQueue::GetGpuBusyMs() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_gpuBusyMs;
+    }
+
+    void FakeGpuQueue::GpuThreadMain() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (true) {
+            m_workAvailable.wait(lock, [&]() {
+                return !m_running || (!m_paused && !m_pending.empty());
+            });
+
+            if (!m_running) {
+                break;
+            }
+
+            QueueItem item = m_pending.front();
+            m_pending.pop_front();
+
+            if (item.signalValue != 0) {
+                m_completedValue.store(item.signalValue);
+                lock.unlock();
+                m_fenceAdvanced.notify_all();
+                lock.lock();
+                continue;
+            }
+
+            // Simular la ejecución fuera del lock para que la CPU siga encolando trabajo
+            lock.unlock();
+            if (item.gpuMilliseconds > 0.0) {
+                std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(item.gpuMilliseconds));
+            }
+            m_executedCommandLists++;
+            lock.lock();
+            m_gpuBusyMs += item.gpuMilliseconds;
+        }
+    }
+
+} // namespace D3D12Core
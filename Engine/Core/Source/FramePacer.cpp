@@ -0,0 +1,350 @@
+#include "FramePacer.h"
+#include "IniFile.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+// Evitar conflictos con macros max/min de Windows
+#ifdef max
+#undef max
+#endif
+#ifdef min
+#undef min
+#endif
+#else
+#include <cerrno>
+#include <time.h>
+#endif
+
+namespace D3D12Core {
+
+    namespace {
+
+        constexpr double NS_PER_MS = 1000000.0;
+        constexpr double COST_PEAK_DECAY = 0.98;      // Por frame: un pico deja de pesar en ~1 s
+        constexpr double OVERSHOOT_ALPHA = 0.05;
+        constexpr int64_t MIN_SPIN_THRESHOLD_NS = 100000;  // 0.1 ms
+        constexpr int64_t MAX_SPIN_THRESHOLD_NS = 4000000;  // 4 ms
+
+    } // namespace
+
+    FramePacer::FramePacer() {
+    }
+
+    FramePacer::~FramePacer() {
+        Shutdown();
+    }
+
+    void FramePacer::Initialize(const FramePacerSettings& settings) {
+        m_settings = settings;
+        SetTargetFps(settings.targetFps);
+        m_nextPresent = 0;
+        m_lastPresent = 0;
+        m_frameStart = 0;
+        m_workEnd = 0;
+        m_costPeakNs = 0.0;
+        m_hasOvershootSamples = false;
+        ResetStats();
+
+#ifdef _WIN32
+        if (!m_timer) {
+            m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        }
+#endif
+    }
+
+    void FramePacer::Shutdown() {
+#ifdef _WIN32
+        if (m_timer) {
+            CloseHandle(static_cast<HANDLE>(m_timer));
+        }
+#endif
+        m_timer = nullptr;
+    }
+
+    FramePacerSettings FramePacer::LoadSettings(const IniFile& ini, const FramePacerSettings& defaults) {
+        FramePacerSettings settings = defaults;
+        double target = ini.GetDouble("Performance", "TargetFPS", defaults.targetFps);
+        double maxFps = ini.GetDouble("Rendering", "MaxFPS", 0.0);
+        if (target <= 0.0 || (maxFps > 0.0 && target > maxFps)) {
+            target = maxFps > 0.0 ? maxFps : 0.0;
+        }
+        settings.targetFps = target;
+        settings.latencyAware = ini.GetBool("Rendering", "LatencyAwarePacing", defaults.latencyAware);
+        settings.safetyMarginMs = ini.GetDouble("Rendering", "PacingMarginMs", defaults.safetyMarginMs);
+        return settings;
+    }
+
+    void FramePacer::SetTargetFps(double fps) {
+        m_settings.targetFps = fps > 0.0 ? fps : 0.0;
+        m_periodNs = fps > 0.0 ? static_cast<int64_t>(1e9 / fps) : 0;
+        m_nextPresent = 0; // Nueva cadencia a partir del siguiente Present
+    }
+
+    int64_t FramePacer::Now() {
+#ifdef _WIN32
+        static const int64_t frequency = [] {
+            LARGE_INTEGER value;
+            QueryPerformanceFrequency(&value);
+            return static_cast<int64_t>(value.QuadPart);
+        }();
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+        // Separar segundos y resto para no desbordar al escalar a ns
+        int64_t seconds = counter.QuadPart / frequency;
+        int64_t remainder = counter.QuadPart % frequency;
+        return seconds * 1000000000ll + remainder * 1000000000ll / frequency;
+#else
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000ll + ts.tv_nsec;
+#endif
+    }
+
+    void FramePacer::SleepFor(int64_t durationNs) {
+        if (durationNs <= 0) {
+            return;
+        }
+#ifdef _WIN32
+        if (m_timer) {
+            LARGE_INTEGER dueTime;
+            dueTime.QuadPart = -(durationNs / 100); // Relativo, en unidades de 100 ns
+            if (SetWaitableTimerEx(static_cast<HANDLE>(m_timer), &dueTime, 0, nullptr, nullptr, nullptr, 0)) {
+                WaitForSingleObject(static_cast<HANDLE>(m_timer), INFINITE);
+                return;
+            }
+        }
+        // Sin temporizador de alta resolución: Sleep solo sirve por milisegundos enteros
+        DWORD milliseconds = static_cast<DWORD>(durationNs / 1000000);
+        if (milliseconds > 0) {
+            Sleep(milliseconds);
+        }
+        else {
+            std::this_thread::yield();
+        }
+#else
+        // Plazo absoluto: una interrupción por señal no alarga la espera total
+        int64_t deadline = Now() + durationNs;
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(deadline / 1000000000ll);
+        ts.tv_nsec = static_cast<long>(deadline % 1000000000ll);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+        }
+#endif
+    }
+
+    void FramePacer::RecordOvershoot(int64_t overshootNs) {
+        double sample = static_cast<double>(std::max<int64_t>(overshootNs, 0));
+        if (!m_hasOvershootSamples) {
+            m_overshootMeanNs = sample;
+            m_overshootVarNs = 0.0;
+            m_hasOvershootSamples = true;
+            return;
+        }
+        double delta = sample - m_overshootMeanNs;
+        m_overshootMeanNs += OVERSHOOT_ALPHA * delta;
+        m_overshootVarNs = (1.0 - OVERSHOOT_ALPHA) * (m_overshootVarNs + OVERSHOOT_ALPHA * delta * delta);
+    }
+
+    int64_t FramePacer::GetSpinThresholdNs() const {
+        if (!m_hasOvershootSamples) {
+            return static_cast<int64_t>(m_settings.spinThresholdMs * NS_PER_MS);
+        }
+        // Media + 2 desviaciones: casi ningún sleep se pasa del plazo
+        int64_t threshold = static_cast<int64_t>(m_overshootMeanNs + 2.0 * std::sqrt(m_overshootVarNs));
+        return std::clamp(threshold, MIN_SPIN_THRESHOLD_NS, MAX_SPIN_THRESHOLD_NS);
+    }
+
+    void FramePacer::WaitUntil(int64_t deadlineNs) {
+        for (;;) {
+            int64_t now = Now();
+            int64_t remaining = deadlineNs - now;
+            if (remaining <= 0) {
+                return;
+            }
+
+            int64_t threshold = GetSpinThresholdNs();
+            if (remaining > threshold) {
+                int64_t request = remaining - threshold;
+                SleepFor(request);
+                RecordOvershoot(Now() - now - request);
+                continue;
+            }
+
+            // Último tramo en espera activa: el SO no despierta con esta precisión
+            while (Now() < deadlineNs) {
+                std::this_thread::yield();
+            }
+            return;
+        }
+    }
+
+    double FramePacer::WaitForNextFrame() {
+        int64_t now = Now();
+        if (m_periodNs == 0 || m_nextPresent == 0) {
+            m_frameStart = now;
+            return 0.0;
+        }
+
+        // Sin latency-aware el frame empieza un periodo antes de su plazo; con latency-aware
+        // empieza lo más tarde posible que aún permite llegar con el coste previsto
+        int64_t start = m_nextPresent - m_periodNs;
+        if (m_settings.latencyAware) {
+            int64_t budget = static_cast<int64_t>(m_costPeakNs + m_settings.safetyMarginMs * NS_PER_MS);
+            start = std::max(start, m_nextPresent - budget);
+        }
+
+        if (start > now) {
+            WaitUntil(start);
+        }
+        m_frameStart = Now();
+
+        double waitedMs = (m_frameStart - now) / NS_PER_MS;
+        m_totalWaitMs += waitedMs;
+        ++m_waits;
+        return waitedMs;
+    }
+
+    void FramePacer::WaitForPresent() {
+        if (m_periodNs == 0 || m_nextPresent == 0) {
+            return;
+        }
+        // El coste del frame termina aquí: la espera no debe adelantar el inicio del siguiente
+        int64_t now = Now();
+        m_workEnd = now;
+        if (m_nextPresent > now) {
+            WaitUntil(m_nextPresent);
+            m_totalWaitMs += (Now() - now) / NS_PER_MS;
+        }
+    }
+
+    void FramePacer::MarkPresent() {
+        int64_t now = Now();
+
+        if (m_frameStart != 0) {
+            double cost = static_cast<double>((m_workEnd != 0 ? m_workEnd : now) - m_frameStart);
+            m_costPeakNs = std::max(cost, m_costPeakNs * COST_PEAK_DECAY);
+            m_stats.predictedFrameCostMs = m_costPeakNs / NS_PER_MS;
+        }
+
+        if (m_lastPresent != 0 && m_periodNs > 0) {
+            int64_t interval = now - m_lastPresent;
+            int64_t error = interval - m_periodNs;
+            double absErrorMs = std::fabs(error / NS_PER_MS);
+
+            ++m_stats.histogram[GetHistogramBucket(error)];
+
+            ++m_stats.frames;
+            if (interval * 2 > m_periodNs * 3) {
+                ++m_stats.missedDeadlines;
+            }
+            m_totalAbsErrorMs += absErrorMs;
+            m_stats.meanAbsErrorMs = m_totalAbsErrorMs / m_stats.frames;
+            m_stats.maxAbsErrorMs = std::max(m_stats.maxAbsErrorMs, absErrorMs);
+        }
+        m_lastPresent = now;
+        m_workEnd = 0;
+        if (m_waits > 0) {
+            m_stats.meanWaitMs = m_totalWaitMs / m_waits;
+        }
+        m_stats.sleepOvershootMs = m_overshootMeanNs / NS_PER_MS;
+
+        if (m_periodNs > 0) {
+            // Cadencia fija; si este Present llegó tarde de más, reanclar en vez de encadenar frames cortos
+            if (m_nextPresent == 0 || m_nextPresent + m_periodNs - now < m_periodNs / 2) {
+                m_nextPresent = now + m_periodNs;
+            }
+            else {
+                m_nextPresent += m_periodNs;
+            }
+        }
+    }
+
+    void FramePacer::ResetStats() {
+        m_stats = FramePacerStats();
+        m_totalAbsErrorMs = 0.0;
+        m_totalWaitMs = 0.0;
+        m_waits = 0;
+    }
+
+    double FramePacer::GetErrorPercentileMs(double percentile) const {
+        if (m_stats.frames == 0) {
+            return 0.0;
+        }
+        uint64_t target = static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 1.0) * m_stats.frames));
+        uint64_t accumulated = 0;
+        for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+            accumulated += m_stats.histogram[i];
+            if (accumulated >= target && accumulated > 0) {
+                return GetHistogramBucketEdgeNs(i) / NS_PER_MS;
+            }
+        }
+        return HISTOGRAM_RANGE_NS / NS_PER_MS;
+    }
+
+    uint32_t FramePacer::GetHistogramBucket(int64_t errorNs) {
+        if (errorNs < -HISTOGRAM_RANGE_NS) {
+            return 0;
+        }
+        if (errorNs >= HISTOGRAM_RANGE_NS) {
+            return HISTOGRAM_BUCKETS - 1;
+        }
+        return 1 + static_cast<uint32_t>((errorNs + HISTOGRAM_RANGE_NS) / HISTOGRAM_BUCKET_NS);
+    }
+
+    int64_t FramePacer::GetHistogramBucketEdgeNs(uint32_t bucket) {
+        // Bucket i en [1, 40]: [-5 + (i - 1) * 0.25, -5 + i * 0.25) ms
+        if (bucket >= HISTOGRAM_BUCKETS - 1) {
+            return HISTOGRAM_RANGE_NS;
+        }
+        return -HISTOGRAM_RANGE_NS + static_cast<int64_t>(bucket) * HISTOGRAM_BUCKET_NS;
+    }
+
+    std::string FramePacer::BuildReport() const {
+        std::ostringstream report;
+        report << std::fixed << std::setprecision(3);
+        report << "Objetivo: " << m_settings.targetFps << " FPS"
+            << " | Frames: " << m_stats.frames
+            << " | Error medio: " << m_stats.meanAbsErrorMs << " ms"
+            << " | Max: " << m_stats.maxAbsErrorMs << " ms"
+            << " | p50: " << GetErrorPercentileMs(0.5) << " ms"
+            << " | p99: " << GetErrorPercentileMs(0.99) << " ms"
+            << " | Plazos perdidos: " << m_stats.missedDeadlines
+            << " | Espera media: " << m_stats.meanWaitMs << " ms"
+            << " | Coste previsto: " << m_stats.predictedFrameCostMs << " ms"
+            << " | Retraso sleep: " << m_stats.sleepOvershootMs << " ms\n";
+
+        report << "Histograma de error:";
+        bool any = false;
+        for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+            if (m_stats.histogram[i] == 0) {
+                continue;
+            }
+            any = true;
+            if (i == 0) {
+                report << " [<" << -HISTOGRAM_RANGE_NS / NS_PER_MS << "]";
+            }
+            else if (i == HISTOGRAM_BUCKETS - 1) {
+                report << " [>=" << HISTOGRAM_RANGE_NS / NS_PER_MS << "]";
+            }
+            else {
+                double low = (-HISTOGRAM_RANGE_NS + static_cast<int64_t>(i - 1) * HISTOGRAM_BUCKET_NS) / NS_PER_MS;
+                report << " [" << low << "," << low + HISTOGRAM_BUCKET_NS / NS_PER_MS << ")";
+            }
+            report << "x" << m_stats.histogram[i];
+        }
+        if (!any) {
+            report << " vacío";
+        }
+        report << "\n";
+        return report.str();
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,146 @@
+#include "FrameScheduler.h"
+#include <iostream>
+
+namespace D3D12Core {
+
+    FrameScheduler::FrameScheduler() {
+    }
+
+    FrameScheduler::~FrameScheduler() {
+        Shutdown();
+    }
+
+    bool FrameScheduler::Initialize(IGpuTimeline* timeline, uint32_t frameCount) {
+        if (!timeline || frameCount == 0) {
+            std::cerr << "Error: Invalid frame scheduler configuration" << std::endl;
+            return false;
+        }
+
+        m_timeline = timeline;
+        m_slots.assign(frameCount, FrameSlot{});
+        m_currentSlot = 0;
+        m_lastSubmittedValue = 0;
+        ResetStats();
+
+        return true;
+    }
+
+    void FrameScheduler::Shutdown() {
+        m_slots.clear();
+        m_timeline = nullptr;
+    }
+
+    uint32_t FrameScheduler::BeginFrame() {
+        if (!m_timeline) {
+            return m_currentSlot;
+        }
+
+        FrameSlot& slot = m_slots[m_currentSlot];
+        uint64_t completed = m_timeline->GetCompletedValue();
+
+        // Solo bloquear si la GPU todavía usa el allocator de este slot
+        if (slot.fenceValue != 0 && completed < slot.fenceValue) {
+            Clock::time_point waitStart = Clock::now();
+            m_timeline->WaitForFenceValue(slot.fenceValue);
+            double stallMs = std::chrono::duration<double, std::milli>(Clock::now() - waitStart).count();
+
+            m_stats.slotStalls++;
+            m_stats.totalStallMs += stallMs;
+            if (stallMs > m_stats.maxStallMs) {
+                m_stats.maxStallMs = stallMs;
+            }
+            completed = m_timeline->GetCompletedValue();
+        }
+
+        RetireCompleted(completed);
+        return m_currentSlot;
+    }
+
+    uint64_t FrameScheduler::EndFrame() {
+        if (!m_timeline) {
+            return 0;
+        }
+
+        uint64_t fenceValue = m_timeline->Signal();
+        FrameSlot& slot = m_slots[m_currentSlot];
+        slot.fenceValue = fenceValue;
+        slot.submitTime = Clock::now();
+        slot.retired = false;
+        m_lastSubmittedValue = fenceValue;
+
+        m_stats.framesSubmitted++;
+        uint32_t inFlight = GetFramesInFlight();
+        if (inFlight > m_stats.maxFramesInFlight) {
+            m_stats.maxFramesInFlight = inFlight;
+        }
+
+        m_currentSlot = (m_currentSlot + 1) % static_cast<uint32_t>(m_slots.size());
+        return fenceValue;
+    }
+
+    void FrameScheduler::WaitForIdle() {
+        if (!m_timeline || m_lastSubmittedValue == 0) {
+            return;
+        }
+
+        if (m_timeline->GetCompletedValue() < m_lastSubmittedValue) {
+            m_timeline->WaitForFenceValue(m_lastSubmittedValue);
+        }
+        RetireCompleted(m_timeline->GetCompletedValue());
+    }
+
+    uint64_t FrameScheduler::GetSlotFenceValue(uint32_t slot) const {
+        return slot < m_slots.size() ? m_slots[slot].fenceValue : 0;
+    }
+
+    uint32_t FrameScheduler::GetFramesInFlight() const {
+        if (!m_timeline) {
+            return 0;
+        }
+
+        uint64_t completed = m_timeline->GetCompletedValue();
+        uint32_t count = 0;
+        for (const FrameSlot& slot : m_slots) {
+            if (slot.fenceValue > completed) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    void FrameScheduler::ResetStats() {
+        m_stats = FrameSchedulerStats{};
+        m_totalLatencyMs = 0.0;
+        m_statsStart = Clock::now();
+    }
+
+    void FrameScheduler::RetireCompleted(uint64_t completedValue) {
+        Clock::time_point now = Clock::now();
+
+        for (FrameSlot& slot : m_slots) {
+            if (slot.retired || slot.fenceValue > completedValue) {
+                continue;
+            }
+
+            // La latencia es una cota superior: se observa al consultar el fence
+            double latencyMs = std::chrono::duration<double, std::milli>(now - slot.submitTime).count();
+            slot.retired = true;
+
+            m_stats.framesCompleted++;
+            m_totalLatencyMs += latencyMs;
+            if (latencyMs > m_stats.maxGpuLatencyMs) {
+                m_stats.maxGpuLatencyMs = latencyMs;
+            }
+        }
+
+        if (m_stats.framesCompleted > 0) {
+            m_stats.avgGpuLatencyMs = m_totalLatencyMs / static_cast<double>(m_stats.framesCompleted);
+        }
+
+        double elapsedSeconds = std::chrono::duration<double>(now - m_statsStart).count();
+        if (elapsedSeconds > 0.0) {
+            m_stats.framesPerSecond = static_cast<double>(m_stats.framesCompleted) / elapsedSeconds;
+        }
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,360 @@
+#include "FrustumCulling.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+namespace D3D12Core {
+
+    namespace {
+
+        constexpr uint32_t PLANE_COUNT = 6;
+        constexpr uint32_t ALL_PLANES = (1u << PLANE_COUNT) - 1;
+
+        // Relleno del almacenamiento SoA: el último grupo de un rango siempre se puede leer entero,
+        // también con el kernel más ancho (AVX-512, 16 cajas)
+        constexpr uint32_t BOUNDS_PADDING = 16;
+
+        // Una caja está fuera de un plano si hasta su esquina más adentrada (centro + radio
+        // proyectado |n|·extensión) queda por detrás
+        float PlaneDistance(const float plane[4], const float center[3]) {
+            return plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3];
+        }
+
+        float PlaneRadius(const float plane[4], const float extent[3]) {
+            return std::fabs(plane[0]) * extent[0] + std::fabs(plane[1]) * extent[1] + std::fabs(plane[2]) * extent[2];
+        }
+
+        // false si la caja queda fuera de algún plano; quita de planeMask los planos que la
+        // contienen entera (lo que haya dentro de ella ya no necesita probarlos)
+        bool ClassifyBox(const CullingFrustum& frustum, const float center[3], const float extent[3], uint32_t& planeMask) {
+            for (uint32_t p = 0; p < PLANE_COUNT; p++) {
+                if ((planeMask & (1u << p)) == 0) {
+                    continue;
+                }
+                float distance = PlaneDistance(frustum.planes[p], center);
+                float radius = PlaneRadius(frustum.planes[p], extent);
+                if (distance + radius < 0.0f) {
+                    return false;
+                }
+                if (distance - radius >= 0.0f) {
+                    planeMask &= ~(1u << p);
+                }
+            }
+            return true;
+        }
+
+        // Prueba las cajas [begin, end) contra los planos de planeMask y escribe los índices
+        // visibles (indexMap[i] o i) en output con el kernel SIMD activo. Devuelve cuántos escribió
+        uint32_t CullRange(const CullingFrustum& frustum, uint32_t planeMask, const CullingBounds& bounds,
+            uint32_t begin, uint32_t end, const uint32_t* indexMap, uint32_t* output) {
+            float planes[PLANE_COUNT][4];
+            uint32_t planeCount = 0;
+            for (uint32_t p = 0; p < PLANE_COUNT; p++) {
+                if ((planeMask & (1u << p)) != 0) {
+                    std::memcpy(planes[planeCount++], frustum.planes[p], sizeof(planes[0]));
+                }
+            }
+            const float* centers[3] = { bounds.GetCenters(0), bounds.GetCenters(1), bounds.GetCenters(2) };
+            const float* extents[3] = { bounds.GetExtents(0), bounds.GetExtents(1), bounds.GetExtents(2) };
+            return GetSimdKernels().cullBounds(planes, planeCount, centers, extents, begin, end, indexMap, output);
+        }
+
+        // Junta las salidas parciales (cada una escrita a partir de su propio inicio) en un solo
+        // rango. Los inicios son crecientes: el destino nunca adelanta al origen
+        uint32_t Compact(uint32_t* output, const uint32_t* starts, const uint32_t* counts, size_t partCount) {
+            uint32_t total = 0;
+            for (size_t part = 0; part < partCount; part++) {
+                if (total != starts[part] && counts[part] > 0) {
+                    std::memmove(output + total, output + starts[part], counts[part] * sizeof(uint32_t));
+                }
+                total += counts[part];
+            }
+            return total;
+        }
+
+    } // namespace
+
+    CullingFrustum CullingFrustum::FromViewProjection(const Float4x4& viewProjection) {
+        // Con vector fila, la coordenada de clip j es p · columna j. Dentro: -w <= x, y <= w, 0 <= z <= w
+        const float (*m)[4] = viewProjection.m;
+        const float signs[PLANE_COUNT] = { 1.0f, -1.0f, 1.0f, -1.0f, 0.0f, -1.0f };
+        const int columns[PLANE_COUNT] = { 0, 0, 1, 1, 2, 2 };
+        CullingFrustum frustum;
+        for (uint32_t p = 0; p < PLANE_COUNT; p++) {
+            float* plane = frustum.planes[p];
+            for (int row = 0; row < 4; row++) {
+                // Plano cercano: z >= 0, solo la columna z
+                plane[row] = p == 4 ? m[row][2] : m[row][3] + signs[p] * m[row][columns[p]];
+            }
+            float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+            if (length > 0.0f) {
+                for (int i = 0; i < 4; i++) {
+                    plane[i] /= length;
+                }
+            }
+        }
+        return frustum;
+    }
+
+    CullingFrustum CullingFrustum::FromCamera(const CameraProxy& camera) {
+        return FromViewProjection(Multiply(camera.view, camera.projection));
+    }
+
+    void CullingBounds::Resize(uint32_t count) {
+        m_count = count;
+        size_t storage = (static_cast<size_t>(count) + BOUNDS_PADDING - 1) / BOUNDS_PADDING * BOUNDS_PADDING + BOUNDS_PADDING;
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            m_centers[axis].resize(storage);
+            m_extents[axis].resize(storage);
+        }
+    }
+
+    void CullingBounds::Set(uint32_t index, const float center[3], const float extent[3]) {
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            m_centers[axis][index] = center[axis];
+            m_extents[axis][index] = extent[axis];
+        }
+    }
+
+    void CullingBounds::SetTransformed(uint32_t index, const float center[3], const float extent[3], const Float4x4& world) {
+        // Vector fila: centro' = centro * world; cada semiextensión de mundo suma |world| por fila
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            m_centers[axis][index] = center[0] * world.m[0][axis] + center[1] * world.m[1][axis] +
+                                     center[2] * world.m[2][axis] + world.m[3][axis];
+            m_extents[axis][index] = extent[0] * std::fabs(world.m[0][axis]) + extent[1] * std::fabs(world.m[1][axis]) +
+                                     extent[2] * std::fabs(world.m[2][axis]);
+        }
+    }
+
+    uint32_t FrustumCuller::Cull(const CullingFrustum& frustum, const CullingBounds& bounds, JobSystem* jobs) {
+        const uint32_t count = bounds.GetCount();
+        if (m_visible.size() < count) {
+            m_visible.resize(count);
+        }
+        const uint32_t blockCount = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        m_blockVisible.resize(blockCount);
+
+        auto cullBlocks = [&](uint32_t blockBegin, uint32_t blockEnd, uint32_t) {
+            for (uint32_t block = blockBegin; block < blockEnd; block++) {
+                uint32_t begin = block * BLOCK_SIZE;
+                uint32_t end = std::min(count, begin + BLOCK_SIZE);
+                m_blockVisible[block] = CullRange(frustum, ALL_PLANES, bounds, begin, end, nullptr, m_visible.data() + begin);
+            }
+        };
+        JobSystem::ParallelFor(jobs, blockCount, 1, cullBlocks);
+
+        uint32_t visible = 0;
+        for (uint32_t block = 0; block < blockCount; block++) {
+            if (visible != block * BLOCK_SIZE && m_blockVisible[block] > 0) {
+                std::memmove(m_visible.data() + visible, m_visible.data() + block * BLOCK_SIZE,
+                    m_blockVisible[block] * sizeof(uint32_t));
+            }
+            visible += m_blockVisible[block];
+        }
+
+        m_stats.frames++;
+        m_stats.objects += count;
+        m_stats.tested += count;
+        m_stats.visible += visible;
+        m_stats.lastObjects = count;
+        m_stats.lastVisible = visible;
+        return visible;
+    }
+
+    uint32_t FrustumCuller::GetSimdWidth() {
+        return GetSimdLevelWidth(GetSimdLevel());
+    }
+
+    const char* FrustumCuller::GetSimdName() {
+        return GetSimdLevelName(GetSimdLevel());
+    }
+
+    std::string FrustumCuller::BuildReport() const {
+        std::ostringstream report;
+        report << "Objetos: " << m_stats.objects << ", visibles: " << m_stats.visible << ", kernel " << GetSimdName()
+               << " (" << GetSimdWidth() << " cajas por iteracion)\n";
+        report << "Ultimo frame: " << m_stats.lastVisible << " de " << m_stats.lastObjects << " visibles\n";
+        return report.str();
+    }
+
+    void CullingBVH::Build(const CullingBounds& bounds) {
+        // Copia contigua de las cajas: las particiones mueven estructuras en lugar de saltar por
+        // índices a los arrays SoA
+        const uint32_t count = bounds.GetCount();
+        std::vector<BuildItem> items(count);
+        for (uint32_t i = 0; i < count; i++) {
+            for (uint32_t axis = 0; axis < 3; axis++) {
+                items[i].center[axis] = bounds.GetCenters(axis)[i];
+                items[i].extent[axis] = bounds.GetExtents(axis)[i];
+            }
+            items[i].index = i;
+        }
+        m_nodes.clear();
+        m_nodes.reserve(count / LEAF_SIZE * 4 + 1);
+        if (count > 0) {
+            BuildNode(0, count, items);
+        }
+
+        // Cajas en el orden de las hojas: cada hoja es un rango contiguo para el kernel
+        m_items.Resize(count);
+        m_itemIndices.resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            m_items.Set(i, items[i].center, items[i].extent);
+            m_itemIndices[i] = items[i].index;
+        }
+    }
+
+    uint32_t CullingBVH::BuildNode(uint32_t first, uint32_t count, std::vector<BuildItem>& items) {
+        float boundsMin[3] = { INFINITY, INFINITY, INFINITY };
+        float boundsMax[3] = { -INFINITY, -INFINITY, -INFINITY };
+        float centroidMin[3] = { INFINITY, INFINITY, INFINITY };
+        float centroidMax[3] = { -INFINITY, -INFINITY, -INFINITY };
+        for (uint32_t i = first; i < first + count; i++) {
+            const BuildItem& item = items[i];
+            for (uint32_t axis = 0; axis < 3; axis++) {
+                boundsMin[axis] = std::min(boundsMin[axis], item.center[axis] - item.extent[axis]);
+                boundsMax[axis] = std::max(boundsMax[axis], item.center[axis] + item.extent[axis]);
+                centroidMin[axis] = std::min(centroidMin[axis], item.center[axis]);
+                centroidMax[axis] = std::max(centroidMax[axis], item.center[axis]);
+            }
+        }
+
+        uint32_t nodeIndex = static_cast<uint32_t>(m_nodes.size());
+        Node node;
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            node.center[axis] = (boundsMin[axis] + boundsMax[axis]) * 0.5f;
+            node.extent[axis] = (boundsMax[axis] - boundsMin[axis]) * 0.5f;
+        }
+        node.first = first;
+        node.count = count;
+        m_nodes.push_back(node);
+        if (count <= LEAF_SIZE) {
+            return nodeIndex;
+        }
+
+        // Mediana en el eje más largo de los centros: árbol equilibrado y construcción O(n log n)
+        uint32_t axis = 0;
+        for (uint32_t candidate = 1; candidate < 3; candidate++) {
+            if (centroidMax[candidate] - centroidMin[candidate] > centroidMax[axis] - centroidMin[axis]) {
+                axis = candidate;
+            }
+        }
+        uint32_t half = count / 2;
+        std::nth_element(items.begin() + first, items.begin() + first + half, items.begin() + first + count,
+            [axis](const BuildItem& a, const BuildItem& b) { return a.center[axis] < b.center[axis]; });
+
+        BuildNode(first, half, items);
+        uint32_t rightChild = BuildNode(first + half, count - half, items);
+        m_nodes[nodeIndex].rightChild = rightChild;
+        return nodeIndex;
+    }
+
+    uint32_t CullingBVH::CullTask(const CullingFrustum& frustum, const Task& task, uint32_t* output,
+        uint64_t& tested, uint64_t& nodes) const {
+        // Profundidad máxima: log2(objetos / LEAF_SIZE) + 1, muy por debajo de la pila
+        Task stack[64];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = task;
+        uint32_t visible = 0;
+        while (stackSize > 0) {
+            Task current = stack[--stackSize];
+            const Node& node = m_nodes[current.node];
+            nodes++;
+            if (!ClassifyBox(frustum, node.center, node.extent, current.planeMask)) {
+                continue;
+            }
+            if (current.planeMask == 0) {
+                std::memcpy(output + visible, m_itemIndices.data() + node.first, node.count * sizeof(uint32_t));
+                visible += node.count;
+            }
+            else if (node.rightChild == 0) {
+                tested += node.count;
+                visible += CullRange(frustum, current.planeMask, m_items, node.first, node.first + node.count,
+                    m_itemIndices.data(), output + visible);
+            }
+            else {
+                // Izquierdo encima: los índices salen en el orden del BVH
+                stack[stackSize++] = { node.rightChild, current.planeMask };
+                stack[stackSize++] = { current.node + 1, current.planeMask };
+            }
+        }
+        return visible;
+    }
+
+    uint32_t CullingBVH::Cull(const CullingFrustum& frustum, JobSystem* jobs) {
+        const uint32_t count = m_items.GetCount();
+        if (m_visible.size() < count) {
+            m_visible.resize(count);
+        }
+
+        // Frontera de tareas: se bajan los nodos grandes que cruzan el frustum hasta tener
+        // suficientes subárboles para repartir; los de fuera se descartan ya aquí
+        m_tasks.clear();
+        uint64_t topNodes = 0;
+        if (count > 0) {
+            uint32_t threadCount = jobs ? jobs->GetThreadCount() : 1;
+            uint32_t splitSize = std::max(LEAF_SIZE, count / (threadCount * TASKS_PER_THREAD));
+            Task stack[64];
+            uint32_t stackSize = 0;
+            stack[stackSize++] = { 0, ALL_PLANES };
+            while (stackSize > 0) {
+                Task current = stack[--stackSize];
+                const Node& node = m_nodes[current.node];
+                uint32_t planeMask = current.planeMask;
+                if (node.count <= splitSize || node.rightChild == 0) {
+                    m_tasks.push_back(current);
+                    continue;
+                }
+                topNodes++;
+                if (!ClassifyBox(frustum, node.center, node.extent, planeMask)) {
+                    continue;
+                }
+                if (planeMask == 0) {
+                    m_tasks.push_back({ current.node, 0 });
+                    continue;
+                }
+                stack[stackSize++] = { node.rightChild, planeMask };
+                stack[stackSize++] = { current.node + 1, planeMask };
+            }
+        }
+
+        const size_t taskCount = m_tasks.size();
+        m_taskVisible.resize(taskCount);
+        m_taskTested.assign(taskCount, 0);
+        m_taskNodes.assign(taskCount, 0);
+        m_taskStarts.resize(taskCount);
+        for (size_t t = 0; t < taskCount; t++) {
+            m_taskStarts[t] = m_nodes[m_tasks[t].node].first;
+        }
+        auto cullTasks = [&](uint32_t begin, uint32_t end, uint32_t) {
+            for (uint32_t t = begin; t < end; t++) {
+                m_taskVisible[t] = CullTask(frustum, m_tasks[t], m_visible.data() + m_taskStarts[t], m_taskTested[t], m_taskNodes[t]);
+            }
+        };
+        JobSystem::ParallelFor(jobs, static_cast<uint32_t>(taskCount), 1, cullTasks);
+        uint32_t visible = Compact(m_visible.data(), m_taskStarts.data(), m_taskVisible.data(), taskCount);
+
+        m_stats.frames++;
+        m_stats.objects += count;
+        m_stats.visible += visible;
+        m_stats.nodes += topNodes;
+        for (size_t t = 0; t < taskCount; t++) {
+            m_stats.tested += m_taskTested[t];
+            m_stats.nodes += m_taskNodes[t];
+        }
+        m_stats.lastObjects = count;
+        m_stats.lastVisible = visible;
+        return visible;
+    }
+
+    std::string CullingBVH::BuildReport() const {
+        std::ostringstream report;
+        report << "Nodos: " << m_nodes.size() << ", objetos: " << m_stats.objects << ", visibles: " << m_stats.visible
+               << ", probados uno a uno: " << m_stats.tested << ", nodos visitados: " << m_stats.nodes << "\n";
+        report << "Ultimo frame: " << m_stats.lastVisible << " de " << m_stats.lastObjects << " visibles\n";
+        return report.str();
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,3198 @@
+// Ejecutable headless: el bucle principal completo (sincronización con el editor, snapshots,
+// hilo de render, grafo de render y ritmo de frames) sobre la RHI nula, sin ventana ni GPU.
+// Sirve para medir el coste de CPU por frame en Linux/CI. --unpaced quita el ritmo y avanza
+// al paso del hilo de render (un frame renderizado por snapshot). --software dibuja los frames
+// de verdad con el rasterizador por software y --capture guarda el último en un PPM.
+// --objects N dibuja una rejilla de N cubos, agrupados en draws instanciados salvo con
+// --no-instancing (un draw por objeto, para comparar) o --indirect (un ExecuteIndirect por
+// material con argumentos generados en los hilos de trabajo). Antes de enviar nada, los objetos
+// fuera del frustum de la cámara se descartan (FrustumCuller). Sin instancing los draws pasan
+// por la RenderQueue (claves de 64 bits y radix sort). --sort-benchmark mide solo ese sort con
+// 100k y 1M claves y termina; --cull-benchmark, igual con el culling de 1M cajas, y
+// --ecs-benchmark con 1M entidades del EntityWorld (iteración, altas/bajas y consultas), y
+// --simd-benchmark con los kernels de BatchMath en cada nivel SIMD de la CPU. --simd fuerza un
+// nivel (por defecto, el mejor disponible). Los objetos de la escena son entidades con
+// TransformComponent y MeshRendererComponent. --occluders pone dos paredes delante de la
+// rejilla marcadas como oclusores: tras el frustum, el OcclusionCuller las rasteriza en su depth
+// buffer de baja resolución y descarta los cubos que tapan (--no-occlusion lo desactiva para
+// comparar). --occlusion-benchmark mide el culling con 1M triángulos de oclusores y termina.
+// Cada malla lleva su cadena de LODs (MeshLodChain) y el hilo de juego elige el nivel de cada
+// objeto por su error en pantalla (LodSelector); --lod-benchmark simplifica una esfera de 1M
+// triángulos y mide la selección con y sin histéresis. Los índices van en 16 bits si el vertex
+// buffer cabe; --optimize-meshes reordena antes el cubo con MeshOptimizer (cambia la imagen:
+// sin depth buffer el orden de los triángulos decide qué cara queda encima) y --mesh-benchmark
+// mide el optimizador con mallas desordenadas y termina. --vertex-format elige cómo se guardan
+// los vértices (float de 24 bytes o compact de 12: posición snorm16 y color RGBA8; -split pone
+// la posición en su propio stream) y --vertex-benchmark mide la codificación en cada nivel SIMD
+// y termina. --meshlet-benchmark parte dos mallas de 1M triángulos en clusters (MeshletMesh) y
+// mide el culling por cluster (frustum y cono de normales) desde varias cámaras y termina.
+// Otras comprobaciones de piezas sueltas, que también terminan (código 1 si algo falla):
+//   --scheduler-test     FrameScheduler sobre FakeGpuQueue: fences por slot y WaitForIdle
+//   --record-benchmark   draws sintéticos grabados con CommandContextPool en 1..K hilos
+//   --staging-test       RingAllocator del staging: wrap-around y retirada por fence
+//   --tlsf-benchmark     TlsfAllocator de los heaps de GPU: fuzzing con Validate() y tiempos
+//   --graph-test         RenderGraph: pases descartados, split barriers, aliasing y errores
+//   --pacer-test         FramePacer: buckets del histograma y error p99 a ritmo fijo
+//   --snapshot-test      RenderThread: snapshots sellados campo a campo y frames crecientes
+//   --indirect-benchmark ExecuteIndirect (drawIndex + objetos) frente a un draw por objeto
+//   DirectX12TestHeadless [--frames N] [--width W] [--height H] [--gpu-ms X] [--unpaced]
+//                         [--software] [--capture archivo.ppm] [--objects N] [--no-instancing]
+//                         [--indirect] [--occluders] [--no-occlusion] [--sort-benchmark]
+//                         [--cull-benchmark] [--ecs-benchmark] [--simd-benchmark]
+//                         [--occlusion-benchmark] [--lod-benchmark] [--optimize-meshes]
+//                         [--mesh-benchmark] [--vertex-benchmark] [--meshlet-benchmark]
+//                         [--scheduler-test] [--record-benchmark] [--staging-test]
+//                         [--tlsf-benchmark] [--graph-test] [--pacer-test] [--snapshot-test]
+//                         [--indirect-benchmark]
+//                         [--vertex-format float|float-split|compact|compact-split]
+//                         [--simd escalar|sse4.2|avx2|avx512]
+
+#include "BatchMath.h"
+#include "CommandContextPool.h"
+#include "EntityWorld.h"
+#include "FakeGpuQueue.h"
+#include "FramePacer.h"
+#include "FrameScheduler.h"
+#include "FrustumCulling.h"
+#include "IndirectDrawBuilder.h"
+#include "IniFile.h"
+#include "InstanceBatcher.h"
+#include "JobSystem.h"
+#include "MeshLod.h"
+#include "Meshlet.h"
+#include "MeshOptimizer.h"
+#include "NullRHI.h"
+#include "OcclusionCulling.h"
+#include "RenderGraph.h"
+#include "RenderQueue.h"
+#include "RenderThread.h"
+#include "RingAllocator.h"
+#include "SceneComponents.h"
+#include "SceneConfig.h"
+#include "SoftwareRHI.h"
+#include "TlsfAllocator.h"
+#include "TransformHierarchy.h"
+#include "Vertex.h"
+#include "VertexFormat.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using D3D12Core::Float4x4;
+
+namespace {
+
+    constexpr uint32_t HEADLESS_FRAMES_IN_FLIGHT = 3;
+    constexpr uint64_t BACK_BUFFER_VIEW_BASE = 0x1000; // RTV ficticias del swap chain nulo
+    constexpr uint32_t CULLING_BATCH = 4096;           // Proxies por lote al copiar sus AABB
+    constexpr uint32_t OCCLUSION_WIDTH = 320;          // Ancho del depth buffer de oclusión (alto según el aspecto)
+    // AABB local del cubo (vértices en [-1, 1]) y ejes de sus giros
+    constexpr float CUBE_CENTER[3] = { 0.0f, 0.0f, 0.0f };
+    constexpr float CUBE_EXTENT[3] = { 1.0f, 1.0f, 1.0f };
+    constexpr float AXIS_X[3] = { 1.0f, 0.0f, 0.0f };
+    constexpr float AXIS_Y[3] = { 0.0f, 1.0f, 0.0f };
+
+    // Mismo contenido que MVPConstantBuffer (sin DirectXMath)
+    struct MVPConstants {
+        Float4x4 model;
+        Float4x4 view;
+        Float4x4 projection;
+        float positionScale[4] = { 1.0f, 1.0f, 1.0f, 0.0f };
+        float positionBias[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    };
+
+    // Matemáticas mínimas con las convenciones de DirectXMath (vector fila, mano izquierda)
+    Float4x4 Transpose(const Float4x4& matrix) {
+        Float4x4 result;
+        for (int row = 0; row < 4; row++) {
+            for (int column = 0; column < 4; column++) {
+                result.m[row][column] = matrix.m[column][row];
+            }
+        }
+        return result;
+    }
+
+    Float4x4 LookAtLH(const float eye[3], const float focus[3], const float up[3]) {
+        float z[3] = { focus[0] - eye[0], focus[1] - eye[1], focus[2] - eye[2] };
+        float zLength = std::sqrt(z[0] * z[0] + z[1] * z[1] + z[2] * z[2]);
+        for (float& v : z) v /= zLength;
+        float x[3] = { up[1] * z[2] - up[2] * z[1], up[2] * z[0] - up[0] * z[2], up[0] * z[1] - up[1] * z[0] };
+        float xLength = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+        for (float& v : x) v /= xLength;
+        float y[3] = { z[1] * x[2] - z[2] * x[1], z[2] * x[0] - z[0] * x[2], z[0] * x[1] - z[1] * x[0] };
+
+        Float4x4 result;
+        for (int i = 0; i < 3; i++) {
+            result.m[i][0] = x[i];
+            result.m[i][1] = y[i];
+            result.m[i][2] = z[i];
+        }
+        result.m[3][0] = -(x[0] * eye[0] + x[1] * eye[1] + x[2] * eye[2]);
+        result.m[3][1] = -(y[0] * eye[0] + y[1] * eye[1] + y[2] * eye[2]);
+        result.m[3][2] = -(z[0] * eye[0] + z[1] * eye[1] + z[2] * eye[2]);
+        return result;
+    }
+
+    Float4x4 PerspectiveFovLH(float fovY, float aspectRatio, float nearZ, float farZ) {
+        Float4x4 result;
+        float height = 1.0f / std::tan(fovY * 0.5f);
+        float range = farZ / (farZ - nearZ);
+        result.m[0][0] = height / aspectRatio;
+        result.m[1][1] = height;
+        result.m[2][2] = range;
+        result.m[2][3] = 1.0f;
+        result.m[3][2] = -range * nearZ;
+        result.m[3][3] = 0.0f;
+        return result;
+    }
+
+    struct TimingSummary {
+        double mean = 0.0;
+        double p50 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    TimingSummary Summarize(std::vector<double> samples) {
+        TimingSummary summary;
+        if (samples.empty()) {
+            return summary;
+        }
+        std::sort(samples.begin(), samples.end());
+        double total = 0.0;
+        for (double sample : samples) {
+            total += sample;
+        }
+        summary.mean = total / samples.size();
+        summary.p50 = samples[samples.size() / 2];
+        summary.p99 = samples[std::min(samples.size() - 1, (samples.size() * 99) / 100)];
+        summary.max = samples.back();
+        return summary;
+    }
+
+    void PrintTiming(const char* label, const TimingSummary& summary) {
+        std::cout << std::fixed << std::setprecision(3) << label << ": media " << summary.mean << " ms, p50 "
+                  << summary.p50 << " ms, p99 " << summary.p99 << " ms, max " << summary.max << " ms" << std::endl;
+    }
+
+    // FrameScheduler sobre FakeGpuQueue con frames de coste aleatorio (0-4 ms de GPU): ningún
+    // slot se reutiliza antes de que su fence se complete y WaitForIdle deja la cola vacía. Antes,
+    // con la GPU pausada, el slot lleno debe bloquear BeginFrame hasta que la GPU avance
+    bool RunSchedulerTest() {
+        constexpr uint32_t FRAME_COUNT = 3;
+        constexpr uint32_t FRAMES = 400;
+        constexpr double PAUSE_MS = 20.0;
+        std::cout << "=== FrameScheduler (" << FRAME_COUNT << " slots, cola simulada) ===" << std::endl;
+
+        D3D12Core::FakeGpuQueue gpu;
+        D3D12Core::FrameScheduler scheduler;
+        if (!gpu.Initialize() || !scheduler.Initialize(&gpu, FRAME_COUNT)) {
+            std::cerr << "Error: Failed to initialize the simulated queue" << std::endl;
+            return false;
+        }
+        bool passed = true;
+        auto check = [&passed](bool condition, const char* message) {
+            if (!condition) {
+                std::cerr << "Error: " << message << std::endl;
+                passed = false;
+            }
+        };
+
+        // Todos los slots en vuelo con la GPU parada; el siguiente BeginFrame espera al primero
+        gpu.SetPaused(true);
+        for (uint32_t i = 0; i < FRAME_COUNT; i++) {
+            scheduler.BeginFrame();
+            gpu.ExecuteCommandList(0.0);
+            scheduler.EndFrame();
+        }
+        check(scheduler.GetFramesInFlight() == FRAME_COUNT, "no estan todos los slots en vuelo con la GPU pausada");
+        std::thread resume([&]() {
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(PAUSE_MS));
+            gpu.SetPaused(false);
+        });
+        int64_t start = D3D12Core::FramePacer::Now();
+        uint32_t slot = scheduler.BeginFrame();
+        double blockedMs = (D3D12Core::FramePacer::Now() - start) / 1000000.0;
+        check(slot == 0 && gpu.GetCompletedValue() >= scheduler.GetSlotFenceValue(0), "BeginFrame devolvio un slot ocupado");
+        resume.join();
+        check(blockedMs >= PAUSE_MS * 0.5 && scheduler.GetStats().slotStalls == 1, "BeginFrame no espero al slot ocupado");
+        gpu.ExecuteCommandList(0.0);
+        scheduler.EndFrame();
+
+        // Frames con coste aleatorio: al reutilizar un slot su frame anterior debe haber terminado
+        std::mt19937 random(FRAMES);
+        std::uniform_real_distribution<double> gpuCost(0.0, 4.0);
+        uint64_t reusedBusy = 0;
+        for (uint32_t frame = 0; frame < FRAMES; frame++) {
+            slot = scheduler.BeginFrame();
+            if (gpu.GetCompletedValue() < scheduler.GetSlotFenceValue(slot)) {
+                reusedBusy++;
+            }
+            gpu.ExecuteCommandList(gpuCost(random));
+            scheduler.EndFrame();
+        }
+        check(reusedBusy == 0, "se reutilizo un slot antes de completar su fence");
+        scheduler.WaitForIdle();
+        const D3D12Core::FrameSchedulerStats& stats = scheduler.GetStats();
+        check(scheduler.GetFramesInFlight() == 0 && gpu.GetCompletedValue() == scheduler.GetLastSubmittedFenceValue(),
+            "WaitForIdle no vacio la cola");
+        check(stats.framesCompleted == stats.framesSubmitted, "WaitForIdle dejo frames sin retirar");
+        check(stats.maxFramesInFlight <= FRAME_COUNT, "mas frames en vuelo que slots");
+
+        std::cout << std::fixed << std::setprecision(3) << stats.framesSubmitted << " frames, bloqueo con la GPU pausada "
+                  << blockedMs << " ms, " << stats.slotStalls << " esperas de slot (max " << stats.maxStallMs
+                  << " ms), latencia media " << stats.avgGpuLatencyMs << " ms, hasta " << stats.maxFramesInFlight
+                  << " en vuelo" << (passed ? "" : " -- FALLO") << std::endl;
+        scheduler.Shutdown();
+        gpu.Shutdown();
+        return passed;
+    }
+
+    // RingAllocator del anillo de staging: un caso fijo de wrap-around (el relleno del final no se
+    // reutiliza hasta retirar) y 100k asignaciones aleatorias contra una copia de lo que sigue en
+    // uso: ninguna se solapa con bytes de un envío sin completar, las que no caben se resuelven
+    // esperando el fence de GetFenceToFit y lo que no tiene fence nunca se retira
+    bool RunStagingTest() {
+        std::cout << "=== Anillo de staging ===" << std::endl;
+        bool passed = true;
+        auto check = [&passed](bool condition, const char* message) {
+            if (!condition) {
+                std::cerr << "Error: " << message << std::endl;
+                passed = false;
+            }
+        };
+        using D3D12Core::RingAllocator;
+
+        RingAllocator ring;
+        ring.Initialize(1024);
+        check(ring.Allocate(400) == 0, "la primera asignacion no empieza en 0");
+        ring.FinishSubmission(1);
+        check(ring.Allocate(400) == 400, "la segunda asignacion no sigue a la primera");
+        ring.FinishSubmission(2);
+        check(ring.Allocate(400) == RingAllocator::INVALID_OFFSET, "asigno sobre bytes en uso");
+        check(ring.GetFenceToFit(400) == 1, "GetFenceToFit no pide el primer envio");
+        ring.Retire(1);
+        check(ring.Allocate(400) == 0, "no dio la vuelta al inicio del anillo");
+        check(ring.GetStats().wraps == 1 && ring.GetStats().bytesWasted == 224, "relleno del wrap-around incorrecto");
+        check(ring.GetUsedBytes() == 400 + 224 + 400, "el relleno no cuenta como memoria en uso");
+        ring.Retire(2);
+        check(ring.GetUsedBytes() == 224 + 400, "el envio 2 no libero sus bytes");
+        ring.Retire(100);
+        check(ring.GetUsedBytes() == 224 + 400, "retiro una asignacion sin fence");
+        ring.FinishSubmission(3);
+        ring.Retire(3);
+        check(ring.IsEmpty(), "el anillo no queda vacio al completar todos los envios");
+
+        // Aleatorio: envíos de 1-8 asignaciones y una GPU que completa a saltos
+        struct Live {
+            uint64_t offset;
+            uint64_t size;
+            uint64_t fenceValue; // 0 mientras el envío sigue abierto
+        };
+        constexpr uint64_t CAPACITY = 64 * 1024;
+        constexpr uint32_t ALLOCATIONS = 100000;
+        ring.Initialize(CAPACITY);
+        std::vector<Live> live;
+        std::mt19937 random(ALLOCATIONS);
+        uint64_t nextFence = 1;
+        uint64_t completed = 0;
+        uint32_t waits = 0;
+        uint32_t pending = 0;
+        int64_t start = D3D12Core::FramePacer::Now();
+        for (uint32_t i = 0; i < ALLOCATIONS && passed; i++) {
+            const uint64_t size = 1 + random() % (random() % 8 == 0 ? CAPACITY / 4 : 4096);
+            const uint64_t alignment = 1ull << (random() % 9);
+            uint64_t offset = ring.Allocate(size, alignment);
+            if (offset == RingAllocator::INVALID_OFFSET) {
+                // Como D3D12UploadManager: cerrar el envío abierto y esperar solo lo necesario
+                if (pending > 0) {
+                    for (Live& allocation : live) {
+                        allocation.fenceValue = allocation.fenceValue == 0 ? nextFence : allocation.fenceValue;
+                    }
+                    ring.FinishSubmission(nextFence++);
+                    pending = 0;
+                }
+                const uint64_t fenceToWait = ring.GetFenceToFit(size, alignment);
+                check(fenceToWait != RingAllocator::INVALID_OFFSET && fenceToWait > completed, "GetFenceToFit sin fence util");
+                completed = std::max(completed, fenceToWait);
+                ring.Retire(completed);
+                waits++;
+                offset = ring.Allocate(size, alignment);
+                check(offset != RingAllocator::INVALID_OFFSET, "no cabe tras esperar el fence de GetFenceToFit");
+            }
+            if (!passed) {
+                break;
+            }
+            live.erase(std::remove_if(live.begin(), live.end(), [completed](const Live& allocation) {
+                return allocation.fenceValue != 0 && allocation.fenceValue <= completed;
+            }), live.end());
+            check(offset % alignment == 0 && offset + size <= CAPACITY, "asignacion desalineada o fuera del anillo");
+            for (const Live& allocation : live) {
+                if (offset < allocation.offset + allocation.size && allocation.offset < offset + size) {
+                    check(false, "asignacion solapada con bytes en uso");
+                    break;
+                }
+            }
+            live.push_back({ offset, size, 0 });
+            pending++;
+
+            if (random() % 4 == 0) {
+                for (Live& allocation : live) {
+                    allocation.fenceValue = allocation.fenceValue == 0 ? nextFence : allocation.fenceValue;
+                }
+                ring.FinishSubmission(nextFence++);
+                pending = 0;
+            }
+            if (random() % 3 == 0 && completed + 1 < nextFence) {
+                completed += 1 + random() % (nextFence - completed - 1);
+                ring.Retire(completed);
+            }
+        }
+        double elapsedMs = (D3D12Core::FramePacer::Now() - start) / 1000000.0;
+        ring.FinishSubmission(nextFence);
+        ring.Retire(nextFence);
+        check(ring.IsEmpty(), "el anillo no queda vacio al completar todos los envios");
+
+        const RingAllocator::Stats& stats = ring.GetStats();
+        std::cout << std::fixed << std::setprecision(3) << stats.allocations << " asignaciones en " << elapsedMs << " ms, "
+                  << stats.wraps << " vueltas, " << waits << " esperas de fence, pico " << stats.peakUsed << " de "
+                  << CAPACITY << " bytes" << (passed ? "" : " -- FALLO") << std::endl;
+        return passed;
+    }
+
+    // TlsfAllocator del sub-asignador de heaps de GPU. Fuzzing: 200k altas y bajas aleatorias en
+    // un bloque de 256 MB (de 256 bytes a 4 MB, alineaciones de 256 bytes a 4 MB) con Validate()
+    // cada 1000 operaciones y una copia de los rangos vivos para detectar solapes. Benchmark: 1M
+    // operaciones en régimen estable (~8k asignaciones vivas) sin validar
+    bool RunTlsfBenchmark() {
+        constexpr uint64_t CAPACITY = 256ull * 1024 * 1024;
+        constexpr uint64_t GRANULARITY = 256;
+        constexpr uint32_t FUZZ_OPERATIONS = 200000;
+        constexpr uint32_t BENCHMARK_OPERATIONS = 1000000;
+        std::cout << "=== TLSF (bloque de " << CAPACITY / (1024 * 1024) << " MB) ===" << std::endl;
+
+        D3D12Core::TlsfAllocator tlsf;
+        tlsf.Initialize(CAPACITY, GRANULARITY);
+        std::mt19937 random(FUZZ_OPERATIONS);
+        // Tamaños repartidos por órdenes de magnitud, como mezclas reales de buffers y texturas
+        auto randomSize = [&random]() {
+            const uint32_t bits = 8 + random() % 14;
+            return (1ull << bits) + random() % (1ull << bits);
+        };
+        std::vector<D3D12Core::TlsfAllocator::Allocation> live;
+        std::map<uint64_t, uint64_t> ranges; // offset -> fin de los rangos vivos
+        bool passed = true;
+        uint32_t failures = 0;
+        uint32_t validations = 0;
+        for (uint32_t operation = 0; operation < FUZZ_OPERATIONS && passed; operation++) {
+            // Más altas que bajas hasta que el bloque se llena; luego se equilibran solas
+            if (!live.empty() && random() % 100 < 45) {
+                const size_t victim = random() % live.size();
+                ranges.erase(live[victim].offset);
+                tlsf.Free(live[victim].handle);
+                live[victim] = live.back();
+                live.pop_back();
+            }
+            else {
+                const uint64_t size = randomSize();
+                const uint64_t alignment = 1ull << (8 + random() % 15);
+                D3D12Core::TlsfAllocator::Allocation allocation = tlsf.Allocate(size, alignment);
+                if (!allocation.IsValid()) {
+                    failures++;
+                }
+                else {
+                    const uint64_t end = allocation.offset + allocation.size;
+                    auto next = ranges.lower_bound(allocation.offset);
+                    const bool overlapsNext = next != ranges.end() && next->first < end;
+                    const bool overlapsPrevious = next != ranges.begin() && std::prev(next)->second > allocation.offset;
+                    if (allocation.offset % alignment != 0 || allocation.size < size || end > CAPACITY || overlapsNext || overlapsPrevious) {
+                        std::cerr << "Error: Asignacion TLSF invalida en la operacion " << operation << " (offset "
+                                  << allocation.offset << ", " << allocation.size << " bytes)" << std::endl;
+                        passed = false;
+                    }
+                    ranges[allocation.offset] = end;
+                    live.push_back(allocation);
+                }
+            }
+            if (operation % 1000 == 0) {
+                validations++;
+                if (!tlsf.Validate() || tlsf.GetStats().allocationCount != live.size()) {
+                    std::cerr << "Error: TLSF incoherente en la operacion " << operation << std::endl;
+                    passed = false;
+                }
+            }
+        }
+        const double fragmentation = tlsf.GetStats().GetFragmentation();
+        const size_t peakLive = live.size();
+        for (const D3D12Core::TlsfAllocator::Allocation& allocation : live) {
+            tlsf.Free(allocation.handle);
+        }
+        live.clear();
+        // Vacío, todo el bloque debe volver a ser un único hueco
+        D3D12Core::TlsfAllocator::Stats emptyStats = tlsf.GetStats();
+        if (!tlsf.Validate() || !tlsf.IsEmpty() || emptyStats.largestFreeBlock != CAPACITY) {
+            std::cerr << "Error: TLSF no fusiona los huecos al vaciarse" << std::endl;
+            passed = false;
+        }
+        std::cout << std::fixed << std::setprecision(1) << "Fuzzing: " << FUZZ_OPERATIONS << " operaciones, " << validations
+                  << " validaciones, " << failures << " altas sin hueco, " << peakLive << " vivas al final (fragmentacion "
+                  << fragmentation * 100.0 << "%)" << (passed ? "" : " -- FALLO") << std::endl;
+
+        // Régimen estable: cada operación libera una asignación al azar y crea otra
+        std::vector<uint64_t> sizes(BENCHMARK_OPERATIONS);
+        for (uint64_t& size : sizes) {
+            size = 256 + random() % (64 * 1024);
+        }
+        for (uint32_t i = 0; i < 8192; i++) {
+            live.push_back(tlsf.Allocate(sizes[i]));
+        }
+        std::vector<uint32_t> victims(BENCHMARK_OPERATIONS);
+        for (uint32_t& victim : victims) {
+            victim = random() % live.size();
+        }
+        int64_t start = D3D12Core::FramePacer::Now();
+        for (uint32_t operation = 0; operation < BENCHMARK_OPERATIONS; operation++) {
+            D3D12Core::TlsfAllocator::Allocation& slot = live[victims[operation]];
+            tlsf.Free(slot.handle);
+            slot = tlsf.Allocate(sizes[operation]);
+        }
+        const double nanoseconds = static_cast<double>(D3D12Core::FramePacer::Now() - start) / BENCHMARK_OPERATIONS;
+        passed = passed && tlsf.Validate();
+        std::cout << std::setprecision(1) << "Benchmark: " << BENCHMARK_OPERATIONS << " pares Free + Allocate con "
+                  << live.size() << " vivas, " << nanoseconds << " ns por par, fragmentacion "
+                  << tlsf.GetStats().GetFragmentation() * 100.0 << "%" << std::endl;
+        return passed;
+    }
+
+    // RenderGraph sobre NullRenderGraphBackend con un frame fijo: un pase cuyo resultado nadie
+    // lee se descarta, el shadow map escrito al principio y leído al final se transiciona con una
+    // split barrier, Lighting y Bloom (vidas disjuntas, mismo tamaño) comparten offset con su
+    // barrera de aliasing, y un grafo que lee un transitorio sin escribirlo no compila
+    bool RunGraphTest() {
+        using D3D12Core::RenderGraph;
+        using D3D12Core::RenderGraphUsage;
+        std::cout << "=== RenderGraph (backend nulo) ===" << std::endl;
+
+        bool passed = true;
+        auto check = [&passed](bool condition, const char* message) {
+            if (!condition) {
+                std::cerr << "Error: " << message << std::endl;
+                passed = false;
+            }
+        };
+
+        D3D12Core::RenderGraphTextureDesc screenDesc;
+        screenDesc.width = 1024;
+        screenDesc.height = 1024;
+        D3D12Core::RenderGraphTextureDesc shadowDesc;
+        shadowDesc.width = 2048;
+        shadowDesc.height = 2048;
+
+        RenderGraph graph;
+        D3D12Core::NullRenderGraphBackend backend;
+        std::vector<std::string> executed;
+        auto record = [&executed](const char* name) {
+            return [&executed, name](D3D12Core::RenderGraphContext&) { executed.push_back(name); };
+        };
+        D3D12Core::RenderGraphResource backBuffer = graph.ImportTexture("BackBuffer", screenDesc, nullptr, 0,
+            RenderGraphUsage::Present, RenderGraphUsage::Present);
+        D3D12Core::RenderGraphResource shadowMap = graph.CreateTexture("ShadowMap", shadowDesc);
+        D3D12Core::RenderGraphResource lighting = graph.CreateTexture("Lighting", screenDesc);
+        D3D12Core::RenderGraphResource debug = graph.CreateTexture("Debug", screenDesc);
+        D3D12Core::RenderGraphResource bloom = graph.CreateTexture("Bloom", screenDesc);
+
+        graph.AddPass("Shadow", record("Shadow")).Write(shadowMap, RenderGraphUsage::DepthWrite);
+        graph.AddPass("Lighting", record("Lighting")).Write(lighting);
+        const uint32_t debugPass = graph.AddPass("Debug", record("Debug")).Read(lighting).Write(debug).GetIndex();
+        graph.AddPass("Tonemap", record("Tonemap")).Read(lighting).Write(backBuffer);
+        graph.AddPass("Bloom", record("Bloom")).Write(bloom);
+        graph.AddPass("Composite", record("Composite")).Read(shadowMap).Read(bloom)
+            .ReadWrite(backBuffer, RenderGraphUsage::RenderTarget);
+
+        const bool compiled = graph.Compile(backend);
+        check(compiled, "el grafo valido no compila");
+        if (compiled) {
+            const RenderGraph::Stats& stats = graph.GetStats();
+            const std::vector<RenderGraph::CompiledPass>& passes = graph.GetCompiledPasses();
+            check(graph.IsPassCulled(debugPass) && stats.culledPasses == 1 && passes.size() == 5 &&
+                !graph.GetResource(debug).used, "el pase Debug (nadie lee su salida) no se descarto");
+
+            // Shadow (0) -> Composite (4): empieza tras Shadow y se cierra en Composite
+            bool splitBegins = false;
+            for (const RenderGraph::Transition& transition : passes[1].beginTransitions) {
+                splitBegins = splitBegins || (transition.resource == shadowMap &&
+                    transition.before == RenderGraphUsage::DepthWrite && transition.after == RenderGraphUsage::ShaderResource);
+            }
+            bool splitEnds = false;
+            for (const RenderGraph::Transition& transition : passes[4].transitions) {
+                splitEnds = splitEnds || (transition.resource == shadowMap && transition.split);
+            }
+            check(splitBegins && splitEnds && stats.splitTransitions == 1, "la transicion del shadow map no es una split barrier");
+
+            const RenderGraph::ResourceInfo& lightingInfo = graph.GetResource(lighting);
+            const RenderGraph::ResourceInfo& bloomInfo = graph.GetResource(bloom);
+            const RenderGraph::ResourceInfo& shadowInfo = graph.GetResource(shadowMap);
+            check(lightingInfo.lastPass < bloomInfo.firstPass && lightingInfo.heapOffset == bloomInfo.heapOffset &&
+                lightingInfo.aliased && bloomInfo.aliased && !shadowInfo.aliased, "Lighting y Bloom no comparten memoria");
+            bool aliasingBarrier = false;
+            for (const RenderGraph::AliasingBarrier& barrier : passes[bloomInfo.firstPass].aliasing) {
+                aliasingBarrier = aliasingBarrier || (barrier.before == lighting && barrier.after == bloom);
+            }
+            check(aliasingBarrier && stats.aliasingBarriers == 2, "falta la barrera de aliasing Lighting -> Bloom");
+            check(stats.heapBytes + bloomInfo.memory.size == stats.transientBytes, "el heap no ahorra lo que ocupa Bloom");
+
+            graph.Execute(backend);
+            const std::vector<std::string> expected = { "Shadow", "Lighting", "Tonemap", "Bloom", "Composite" };
+            check(executed == expected, "los pases no se ejecutaron en orden o se ejecuto el descartado");
+            check(graph.GetFinalTransitions().size() == 1 && graph.GetFinalTransitions()[0].after == RenderGraphUsage::Present,
+                "el back buffer no vuelve a Present");
+            std::cout << graph.BuildReport();
+        }
+
+        // Lectura de un transitorio que ningún pase escribe: Compile debe rechazarlo
+        std::cout << "Grafo invalido (se espera un error):" << std::endl;
+        graph.Reset();
+        D3D12Core::RenderGraphResource never = graph.CreateTexture("NeverWritten", screenDesc);
+        backBuffer = graph.ImportTexture("BackBuffer", screenDesc, nullptr, 0, RenderGraphUsage::Present, RenderGraphUsage::Present);
+        graph.AddPass("Composite", record("Composite")).Read(never).Write(backBuffer);
+        check(!graph.Compile(backend), "se compilo un grafo que lee un transitorio antes de escribirlo");
+
+        std::cout << (passed ? "Grafo correcto" : "Grafo -- FALLO") << std::endl;
+        return passed;
+    }
+
+    // FramePacer: los buckets del histograma en los bordes de ±5 ms y de cada tramo de 250 us (y
+    // que el borde que informan los percentiles acota los errores de su bucket), y después 400
+    // frames a 100 FPS con un coste de CPU aleatorio de 1 a 6 ms cuyo p1 y p99 de error de ritmo
+    // deben quedar dentro de ±2 ms. El ritmo se repite hasta 3 veces: una máquina compartida puede
+    // desalojar el proceso en una pasada, pero un fallo del pacer las estropea todas
+    bool RunPacerTest() {
+        using D3D12Core::FramePacer;
+        constexpr double TARGET_FPS = 100.0;
+        constexpr uint32_t FRAMES = 400;
+        constexpr uint32_t ATTEMPTS = 3;
+        constexpr double MAX_P99_ERROR_MS = 2.0;
+        std::cout << "=== FramePacer (" << TARGET_FPS << " FPS, " << FRAMES << " frames) ===" << std::endl;
+
+        bool passed = true;
+        auto check = [&passed](bool condition, const char* message) {
+            if (!condition) {
+                std::cerr << "Error: " << message << std::endl;
+                passed = false;
+            }
+        };
+
+        const int64_t range = FramePacer::HISTOGRAM_RANGE_NS;
+        const int64_t bucketNs = FramePacer::HISTOGRAM_BUCKET_NS;
+        const uint32_t overflow = FramePacer::HISTOGRAM_BUCKETS - 1;
+        check(FramePacer::GetHistogramBucket(-range - 1) == 0 && FramePacer::GetHistogramBucket(-range) == 1 &&
+            FramePacer::GetHistogramBucket(range - 1) == overflow - 1 && FramePacer::GetHistogramBucket(range) == overflow,
+            "buckets del histograma mal en los bordes de +-5 ms");
+        check(FramePacer::GetHistogramBucket(-1) == overflow / 2 && FramePacer::GetHistogramBucket(0) == overflow / 2 + 1,
+            "el error cero no abre el bucket central");
+        for (uint32_t bucket = 1; bucket < overflow; bucket++) {
+            // Primer y último nanosegundo del tramo: mismo bucket, y el borde informado lo acota por arriba
+            const int64_t low = FramePacer::GetHistogramBucketEdgeNs(bucket - 1);
+            const int64_t high = FramePacer::GetHistogramBucketEdgeNs(bucket);
+            if (high - low != bucketNs || FramePacer::GetHistogramBucket(low) != bucket ||
+                FramePacer::GetHistogramBucket(high - 1) != bucket || FramePacer::GetHistogramBucket(high) != bucket + 1) {
+                std::cerr << "Error: Bucket " << bucket << " del histograma no cubre [" << low << ", " << high << ") ns" << std::endl;
+                passed = false;
+            }
+        }
+        check(FramePacer::GetHistogramBucketEdgeNs(0) == -range && FramePacer::GetHistogramBucketEdgeNs(overflow) == range,
+            "bordes de los buckets de desbordamiento");
+
+        D3D12Core::FramePacerSettings settings;
+        settings.targetFps = TARGET_FPS;
+        std::mt19937 random(FRAMES);
+        std::uniform_real_distribution<double> workMs(1.0, 6.0);
+        bool paced = false;
+        for (uint32_t attempt = 1; attempt <= ATTEMPTS && !paced; attempt++) {
+            FramePacer pacer;
+            pacer.Initialize(settings);
+            for (uint32_t frame = 0; frame < FRAMES; frame++) {
+                pacer.WaitForNextFrame();
+                // Trabajo sintético en espera activa, como un frame de CPU
+                const int64_t workEnd = FramePacer::Now() + static_cast<int64_t>(workMs(random) * 1000000.0);
+                while (FramePacer::Now() < workEnd) {
+                }
+                pacer.WaitForPresent();
+                pacer.MarkPresent();
+            }
+            const D3D12Core::FramePacerStats& stats = pacer.GetStats();
+            uint64_t histogramFrames = 0;
+            for (uint64_t count : stats.histogram) {
+                histogramFrames += count;
+            }
+            check(stats.frames == FRAMES - 1 && histogramFrames == stats.frames, "el histograma no cuenta todos los intervalos");
+            // p1 es un borde superior: el tramo bajo del error queda a menos de un bucket por debajo
+            const double p1 = pacer.GetErrorPercentileMs(0.01);
+            const double p99 = pacer.GetErrorPercentileMs(0.99);
+            paced = p99 <= MAX_P99_ERROR_MS && p1 >= -MAX_P99_ERROR_MS + bucketNs / 1000000.0;
+            std::cout << "Pasada " << attempt << ": " << pacer.BuildReport();
+            pacer.Shutdown();
+        }
+        check(paced, "el error de ritmo p1/p99 se sale de +-2 ms en todas las pasadas");
+        std::cout << (passed ? "Ritmo correcto" : "Ritmo -- FALLO") << std::endl;
+        return passed;
+    }
+
+    // Valor de cada campo de un snapshot de --snapshot-test: depende del frame y del campo, y es
+    // exacto en float (menor que 2^24)
+    float SnapshotStamp(uint64_t frame, uint32_t field) {
+        return static_cast<float>((frame * 7919 + field) % 16777213);
+    }
+
+    // Recorre todos los campos de un snapshot con el valor que les toca según su frameNumber:
+    // field(campo, esperado) los escribe en el productor y los compara en el render
+    template <typename Snapshot, typename Field>
+    void ForEachSnapshotField(Snapshot& snapshot, Field&& field) {
+        const uint64_t frame = snapshot.frameNumber;
+        uint32_t index = 0;
+        auto stamp = [frame, &index]() { return SnapshotStamp(frame, index++); };
+        auto matrix = [&](auto& value) {
+            for (auto& row : value.m) {
+                for (auto& element : row) {
+                    field(element, stamp());
+                }
+            }
+        };
+        field(snapshot.viewportWidth, static_cast<uint32_t>(frame * 3));
+        field(snapshot.viewportHeight, static_cast<uint32_t>(frame * 5));
+        matrix(snapshot.camera.view);
+        matrix(snapshot.camera.projection);
+        for (auto& coordinate : snapshot.camera.position) {
+            field(coordinate, stamp());
+        }
+        uint32_t position = 0;
+        for (auto& proxy : snapshot.proxies) {
+            field(proxy.meshId, static_cast<uint32_t>(frame + position));
+            field(proxy.materialId, static_cast<uint32_t>(frame ^ position));
+            matrix(proxy.world);
+            for (auto& value : proxy.customData) {
+                field(value, stamp());
+            }
+            for (uint32_t axis = 0; axis < 3; axis++) {
+                field(proxy.boundsCenter[axis], stamp());
+                field(proxy.boundsExtent[axis], stamp());
+            }
+            field(proxy.occluder, ((frame + position) & 1) != 0);
+            field(proxy.lod, static_cast<uint32_t>((frame + position) % 4));
+            position++;
+        }
+        position = 0;
+        for (auto& material : snapshot.materials) {
+            field(material.materialId, static_cast<uint32_t>(frame + position));
+            field(material.version, static_cast<uint32_t>(frame * 3 + position));
+            for (auto& channel : material.baseColor) {
+                field(channel, stamp());
+            }
+            position++;
+        }
+    }
+
+    // RenderThread alimentado a toda velocidad: el hilo de juego sella cada campo de 20k snapshots
+    // (con tamaños que cambian por frame) y el de render comprueba cada uno antes de grabarlo en la
+    // RHI nula. Un snapshot a medio escribir o un frame que retrocede es un fallo
+    bool RunSnapshotTest() {
+        constexpr uint64_t SNAPSHOTS = 20000;
+        constexpr uint32_t MAX_PROXIES = 200;
+        constexpr uint32_t MAX_MATERIALS = 16;
+        std::cout << "=== RenderThread (" << SNAPSHOTS << " snapshots sellados) ===" << std::endl;
+
+        D3D12Core::NullRHIDevice device;
+        D3D12Core::FrameScheduler scheduler;
+        if (!device.Initialize() || !scheduler.Initialize(device.GetQueue(), HEADLESS_FRAMES_IN_FLIGHT)) {
+            std::cerr << "Error: Failed to initialize the snapshot test device" << std::endl;
+            return false;
+        }
+        D3D12Core::RHIBufferDesc vertexDesc;
+        vertexDesc.size = 8 * sizeof(D3D12Core::Vertex);
+        vertexDesc.usage = D3D12Core::RHI_BUFFER_USAGE_VERTEX;
+        vertexDesc.stride = sizeof(D3D12Core::Vertex);
+        D3D12Core::RHIBufferDesc indexDesc;
+        indexDesc.size = 36 * sizeof(uint32_t);
+        indexDesc.usage = D3D12Core::RHI_BUFFER_USAGE_INDEX;
+        indexDesc.stride = sizeof(uint32_t);
+        D3D12Core::RHIPipelineDesc pipelineDesc;
+        pipelineDesc.vertexStride = sizeof(D3D12Core::Vertex);
+        std::unique_ptr<D3D12Core::IRHIBuffer> vertexBuffer = device.CreateBuffer(vertexDesc);
+        std::unique_ptr<D3D12Core::IRHIBuffer> indexBuffer = device.CreateBuffer(indexDesc);
+        std::unique_ptr<D3D12Core::IRHIPipeline> pipeline = device.CreatePipeline(pipelineDesc);
+        std::unique_ptr<D3D12Core::IRHICommandList> commandList = device.CreateCommandList();
+
+        // Solo los toca el hilo de render; se leen tras Stop (join)
+        uint64_t lastFrame = 0;
+        uint64_t corrupted = 0;
+        uint64_t outOfOrder = 0;
+        uint64_t expectedDraws = 0;
+        std::atomic<uint64_t> renderedFrame{ 0 };
+        D3D12Core::RenderThread renderThread;
+        renderThread.Start([&](const D3D12Core::RenderSnapshot& snapshot) {
+            bool intact = snapshot.proxies.size() == 1 + snapshot.frameNumber % MAX_PROXIES &&
+                snapshot.materials.size() == 1 + snapshot.frameNumber % MAX_MATERIALS;
+            if (intact) {
+                ForEachSnapshotField(snapshot, [&intact](const auto& value, auto expected) {
+                    intact = intact && value == expected;
+                });
+            }
+            corrupted += intact ? 0 : 1;
+            outOfOrder += snapshot.frameNumber > lastFrame ? 0 : 1;
+            lastFrame = snapshot.frameNumber;
+
+            uint32_t slot = scheduler.BeginFrame();
+            commandList->Begin();
+            D3D12Core::RHIViewport viewport;
+            viewport.width = static_cast<float>(snapshot.viewportWidth);
+            viewport.height = static_cast<float>(snapshot.viewportHeight);
+            D3D12Core::RHIRect scissor;
+            scissor.right = static_cast<int32_t>(snapshot.viewportWidth);
+            scissor.bottom = static_cast<int32_t>(snapshot.viewportHeight);
+            commandList->SetRenderTarget(BACK_BUFFER_VIEW_BASE + slot);
+            commandList->SetViewport(viewport);
+            commandList->SetScissor(scissor);
+            commandList->SetPipeline(pipeline.get());
+            commandList->SetVertexBuffer(vertexBuffer.get());
+            commandList->SetIndexBuffer(indexBuffer.get(), D3D12Core::RHIFormat::R32Uint);
+            for (const D3D12Core::RenderProxy& proxy : snapshot.proxies) {
+                commandList->SetConstantBuffer(0, device.AllocateConstants(&proxy.world, sizeof(proxy.world)));
+                commandList->DrawIndexed(36, 1, 0, 0, 0);
+            }
+            commandList->Close();
+            device.GetQueue()->ExecuteCommandList(commandList.get());
+            scheduler.EndFrame();
+            expectedDraws += snapshot.proxies.size();
+            renderedFrame.store(snapshot.frameNumber, std::memory_order_release);
+        });
+
+        for (uint64_t frame = 1; frame <= SNAPSHOTS; frame++) {
+            D3D12Core::RenderSnapshot& snapshot = renderThread.BeginSnapshot();
+            snapshot.frameNumber = frame;
+            snapshot.proxies.resize(1 + frame % MAX_PROXIES);
+            snapshot.materials.resize(1 + frame % MAX_MATERIALS);
+            ForEachSnapshotField(snapshot, [](auto& value, auto expected) { value = expected; });
+            renderThread.Publish();
+        }
+        // El último publicado siempre se dibuja: Stop descartaría uno pendiente
+        const int64_t deadline = D3D12Core::FramePacer::Now() + 5000000000ll;
+        while (renderedFrame.load(std::memory_order_acquire) != SNAPSHOTS && D3D12Core::FramePacer::Now() < deadline) {
+            std::this_thread::yield();
+        }
+        renderThread.Stop();
+        scheduler.WaitForIdle();
+
+        const D3D12Core::RenderThreadStats stats = renderThread.GetStats();
+        bool passed = true;
+        auto check = [&passed](bool condition, const char* message) {
+            if (!condition) {
+                std::cerr << "Error: " << message << std::endl;
+                passed = false;
+            }
+        };
+        check(corrupted == 0, "el hilo de render recibio snapshots con campos que no son de su frame");
+        check(outOfOrder == 0, "los frames del hilo de render no son crecientes");
+        check(lastFrame == SNAPSHOTS, "el ultimo snapshot publicado no llego a dibujarse");
+        check(stats.published == SNAPSHOTS && stats.rendered + stats.dropped == stats.published,
+            "publicados, dibujados y descartados no cuadran");
+        check(device.GetStats().draws == expectedDraws && device.GetStats().validationErrors == 0,
+            "la RHI nula no recibio los draws de los snapshots dibujados");
+        std::cout << stats.published << " publicados, " << stats.rendered << " dibujados, " << stats.dropped
+                  << " descartados, " << corrupted << " corruptos, " << outOfOrder << " fuera de orden"
+                  << (passed ? "" : " -- FALLO") << std::endl;
+        scheduler.Shutdown();
+        device.Shutdown();
+        return passed;
+    }
+
+    // Contexto de grabación del pool sobre una command list de la RHI nula
+    struct RecordingContext {
+        std::unique_ptr<D3D12Core::IRHICommandList> list;
+        uint32_t order = 0;
+
+        void Begin(uint32_t newOrder) {
+            order = newOrder;
+            list->Begin();
+        }
+        uint32_t GetOrder() const { return order; }
+    };
+
+    // Draws sintéticos (constantes por draw + DrawIndexed) grabados en contextos del
+    // CommandContextPool, un contexto por lote de 1024 draws, con 1..K hilos del JobSystem. Cada
+    // frame recoge los contextos por orden y los envía; la RHI nula valida todo lo grabado
+    bool RunRecordBenchmark() {
+        constexpr uint32_t DRAWS_PER_CONTEXT = 1024;
+        constexpr uint32_t CONSTANT_STRIDE = 256;
+        constexpr int FRAMES = 20;
+        const uint32_t maxThreads = std::max(4u, std::thread::hardware_concurrency());
+        std::cout << "=== Grabacion multihilo (" << DRAWS_PER_CONTEXT << " draws por contexto, hilos de hardware: "
+                  << std::thread::hardware_concurrency() << ") ===" << std::endl;
+        static_assert(sizeof(MVPConstants) <= CONSTANT_STRIDE, "MVPConstants debe caber en una CBV de 256 bytes");
+
+        D3D12Core::NullRHIDevice device;
+        if (!device.Initialize()) {
+            return false;
+        }
+        D3D12Core::RHIBufferDesc vertexDesc;
+        vertexDesc.size = 8 * sizeof(D3D12Core::Vertex);
+        vertexDesc.usage = D3D12Core::RHI_BUFFER_USAGE_VERTEX;
+        vertexDesc.stride = sizeof(D3D12Core::Vertex);
+        D3D12Core::RHIBufferDesc indexDesc;
+        indexDesc.size = 36 * sizeof(uint32_t);
+        indexDesc.usage = D3D12Core::RHI_BUFFER_USAGE_INDEX;
+        indexDesc.stride = sizeof(uint32_t);
+        D3D12Core::RHIPipelineDesc pipelineDesc;
+        pipelineDesc.vertexStride = sizeof(D3D12Core::Vertex);
+        std::unique_ptr<D3D12Core::IRHIBuffer> vertexBuffer = device.CreateBuffer(vertexDesc);
+        std::unique_ptr<D3D12Core::IRHIBuffer> indexBuffer = device.CreateBuffer(indexDesc);
+        std::unique_ptr<D3D12Core::IRHIPipeline> pipeline = device.CreatePipeline(pipelineDesc);
+        D3D12Core::FrameScheduler scheduler;
+        if (!vertexBuffer || !indexBuffer || !pipeline || !scheduler.Initialize(device.GetQueue(), HEADLESS_FRAMES_IN_FLIGHT)) {
+            std::cerr << "Error: Failed to create recording benchmark resources" << std::endl;
+            return false;
+        }
+        D3D12Core::RHIViewport viewport;
+        viewport.width = 1280.0f;
+        viewport.height = 720.0f;
+        D3D12Core::RHIRect scissor;
+        scissor.right = 1280;
+        scissor.bottom = 720;
+        D3D12Core::CameraProxy camera;
+        float eye[3] = { 0.0f, 0.0f, -5.0f };
+        float focus[3] = { 0.0f, 0.0f, 0.0f };
+        float up[3] = { 0.0f, 1.0f, 0.0f };
+        camera.view = LookAtLH(eye, focus, up);
+        camera.projection = PerspectiveFovLH(1.0472f, 16.0f / 9.0f, 0.1f, 100.0f);
+
+        bool passed = true;
+        for (uint32_t drawCount : { 10000u, 100000u }) {
+            const uint32_t contextCount = (drawCount + DRAWS_PER_CONTEXT - 1) / DRAWS_PER_CONTEXT;
+            double singleThreadMs = 0.0;
+            for (uint32_t threads = 1; threads <= maxThreads; threads *= 2) {
+                D3D12Core::CommandContextPool<RecordingContext> pool;
+                pool.Initialize(HEADLESS_FRAMES_IN_FLIGHT, [&device]() {
+                    std::unique_ptr<RecordingContext> context = std::make_unique<RecordingContext>();
+                    context->list = device.CreateCommandList();
+                    return context;
+                });
+                D3D12Core::JobSystem jobs;
+                if (threads > 1 && !jobs.Initialize(threads - 1)) {
+                    std::cerr << "Error: Failed to initialize recording workers" << std::endl;
+                    return false;
+                }
+                // Constantes de cada lote preparadas en la memoria de su hilo y subidas de una vez
+                std::vector<std::vector<uint8_t>> staging(threads, std::vector<uint8_t>(DRAWS_PER_CONTEXT * CONSTANT_STRIDE));
+                auto recordBatch = [&](uint32_t slot, uint32_t begin, uint32_t end, uint32_t worker) {
+                    RecordingContext* context = pool.Acquire(slot, begin / DRAWS_PER_CONTEXT);
+                    if (!context) {
+                        return;
+                    }
+                    D3D12Core::IRHICommandList* list = context->list.get();
+                    list->SetRenderTarget(BACK_BUFFER_VIEW_BASE + slot);
+                    list->SetViewport(viewport);
+                    list->SetScissor(scissor);
+                    list->SetPipeline(pipeline.get());
+                    list->SetVertexBuffer(vertexBuffer.get());
+                    list->SetIndexBuffer(indexBuffer.get(), D3D12Core::RHIFormat::R32Uint);
+                    MVPConstants constants;
+                    constants.view = Transpose(camera.view);
+                    constants.projection = Transpose(camera.projection);
+                    uint8_t* data = staging[worker].data();
+                    for (uint32_t draw = begin; draw < end; draw++) {
+                        Float4x4 model;
+                        model.m[3][0] = static_cast<float>(draw % 100) - 50.0f;
+                        model.m[3][1] = static_cast<float>(draw / 100 % 100) - 50.0f;
+                        constants.model = Transpose(model);
+                        std::memcpy(data + (draw - begin) * CONSTANT_STRIDE, &constants, sizeof(constants));
+                    }
+                    uint64_t address = device.AllocateConstants(data, static_cast<uint64_t>(end - begin) * CONSTANT_STRIDE);
+                    for (uint32_t draw = begin; draw < end; draw++) {
+                        list->SetConstantBuffer(0, address + (draw - begin) * CONSTANT_STRIDE);
+                        list->DrawIndexed(36, 1, 0, 0, 0);
+                    }
+                    list->Close();
+                };
+
+                const uint64_t drawsBefore = device.GetStats().draws;
+                std::vector<double> frameMs;
+                bool ordered = true;
+                for (int frame = 0; frame <= FRAMES; frame++) {
+                    uint32_t slot = scheduler.BeginFrame();
+                    pool.ResetSlot(slot);
+                    int64_t start = D3D12Core::FramePacer::Now();
+                    if (threads > 1) {
+                        jobs.ParallelFor(drawCount, DRAWS_PER_CONTEXT, [&](uint32_t begin, uint32_t end, uint32_t worker) {
+                            recordBatch(slot, begin, end, worker);
+                        });
+                    }
+                    else {
+                        for (uint32_t begin = 0; begin < drawCount; begin += DRAWS_PER_CONTEXT) {
+                            recordBatch(slot, begin, std::min(drawCount, begin + DRAWS_PER_CONTEXT), 0);
+                        }
+                    }
+                    // Mismo orden de envío con cualquier reparto entre hilos
+                    std::vector<RecordingContext*> contexts = pool.GatherOrdered(slot);
+                    ordered = ordered && contexts.size() == contextCount;
+                    for (uint32_t i = 0; i < contexts.size(); i++) {
+                        ordered = ordered && contexts[i]->GetOrder() == i;
+                        device.GetQueue()->ExecuteCommandList(contexts[i]->list.get());
+                    }
+                    scheduler.EndFrame();
+                    if (frame > 0) { // El primero crea los contextos
+                        frameMs.push_back((D3D12Core::FramePacer::Now() - start) / 1000000.0);
+                    }
+                }
+                scheduler.WaitForIdle();
+                jobs.Shutdown();
+
+                const uint64_t recorded = device.GetStats().draws - drawsBefore;
+                const bool matches = ordered && recorded == static_cast<uint64_t>(drawCount) * (FRAMES + 1);
+                passed = passed && matches;
+                TimingSummary summary = Summarize(frameMs);
+                if (threads == 1) {
+                    singleThreadMs = summary.mean;
+                }
+                std::cout << std::fixed << std::setprecision(3) << drawCount << " draws, " << threads << (threads == 1 ? " hilo" : " hilos") << ": media "
+                          << summary.mean << " ms, p99 " << summary.p99 << " ms, x" << std::setprecision(2)
+                          << (summary.mean > 0.0 ? singleThreadMs / summary.mean : 0.0) << " frente a un hilo, "
+                          << pool.GetStats().created << " contextos creados" << (matches ? "" : " -- GRABACION INCORRECTA")
+                          << std::endl;
+            }
+        }
+        const uint64_t validationErrors = device.GetStats().validationErrors;
+        scheduler.Shutdown();
+        device.Shutdown();
+        return passed && validationErrors == 0;
+    }
+
+    // Claves de una escena sintética (16 pipelines, 256 materiales, 1024 mallas y un 10% de
+    // transparentes) ordenadas con la RenderQueue y con std::stable_sort como referencia
+    bool RunSortBenchmark() {
+        D3D12Core::JobSystem jobs;
+        if (!jobs.Initialize()) {
+            std::cerr << "Error: Failed to initialize sort workers" << std::endl;
+            return false;
+        }
+        std::cout << "=== Sort de draws (" << jobs.GetThreadCount() << " hilos) ===" << std::endl;
+
+        constexpr int REPETITIONS = 5;
+        bool matches = true;
+        for (uint32_t count : { 100000u, 1000000u }) {
+            std::mt19937 random(count);
+            std::uniform_real_distribution<float> depths(0.1f, 1000.0f);
+            std::vector<std::pair<uint64_t, uint32_t>> reference(count);
+            for (uint32_t i = 0; i < count; i++) {
+                uint64_t key = random() % 10 == 0
+                    ? D3D12Core::DrawSortKey::Transparent(0, 1, random() % 16, random() % 256, depths(random))
+                    : D3D12Core::DrawSortKey::Opaque(0, 0, random() % 16, random() % 256, random() % 1024, depths(random));
+                reference[i] = { key, i };
+            }
+
+            D3D12Core::RenderQueue queue;
+            queue.Reserve(count);
+            double radixMs = 0.0;
+            double serialMs = 0.0;
+            for (int repetition = 0; repetition <= REPETITIONS; repetition++) {
+                for (bool parallel : { true, false }) {
+                    queue.Reset();
+                    for (const auto& entry : reference) {
+                        queue.Add(entry.first, entry.second);
+                    }
+                    int64_t start = D3D12Core::FramePacer::Now();
+                    queue.Sort(parallel ? &jobs : nullptr);
+                    double milliseconds = (D3D12Core::FramePacer::Now() - start) / 1000000.0;
+                    if (repetition > 0) { // La primera solo reserva memoria
+                        (parallel ? radixMs : serialMs) += milliseconds / REPETITIONS;
+                    }
+                }
+            }
+
+            int64_t start = D3D12Core::FramePacer::Now();
+            std::stable_sort(reference.begin(), reference.end(),
+                [](const std::pair<uint64_t, uint32_t>& a, const std::pair<uint64_t, uint32_t>& b) { return a.first < b.first; });
+            double stableSortMs = (D3D12Core::FramePacer::Now() - start) / 1000000.0;
+
+            bool sameOrder = true;
+            for (uint32_t i = 0; i < count && sameOrder; i++) {
+                sameOrder = queue.GetKeys()[i] == reference[i].first && queue.GetDrawIndices()[i] == reference[i].second;
+            }
+            matches = matches && sameOrder;
+            std::cout << std::fixed << std::setprecision(3) << count << " claves: radix " << radixMs << " ms ("
+                      << serialMs << " ms en un hilo), std::stable_sort " << stableSortMs << " ms"
+                      << (sameOrder ? "" : " -- ORDEN DISTINTO") << std::endl;
+        }
+        jobs.Shutdown();
+        return matches;
+    }
+
+    // 1M cajas repartidas en un cubo de 2000 unidades alrededor de la cámara, con el frustum de
+    // la escena (60 grados, 0.1-500): culling plano (se reescribe cada frame) y con BVH (estático)
+    bool RunCullingBenchmark() {
+        D3D12Core::JobSystem jobs;
+        if (!jobs.Initialize()) {
+            std::cerr << "Error: Failed to initialize culling workers" << std::endl;
+            return false;
+        }
+        std::cout << "=== Frustum culling (" << jobs.GetThreadCount() << " hilos, kernel "
+                  << D3D12Core::FrustumCuller::GetSimdName() << ") ===" << std::endl;
+
+        constexpr uint32_t OBJECT_COUNT = 1000000;
+        constexpr int REPETITIONS = 10;
+        D3D12Core::CullingBounds bounds;
+        bounds.Resize(OBJECT_COUNT);
+        std::mt19937 random(OBJECT_COUNT);
+        std::uniform_real_distribution<float> positions(-1000.0f, 1000.0f);
+        std::uniform_real_distribution<float> sizes(0.1f, 2.0f);
+        for (uint32_t i = 0; i < OBJECT_COUNT; i++) {
+            float center[3] = { positions(random), positions(random), positions(random) };
+            float extent[3] = { sizes(random), sizes(random), sizes(random) };
+            bounds.Set(i, center, extent);
+        }
+        D3D12Core::CameraProxy camera;
+        float eye[3] = { 0.0f, 0.0f, 0.0f };
+        float focus[3] = { 0.3f, 0.1f, 1.0f };
+        float up[3] = { 0.0f, 1.0f, 0.0f };
+        camera.view = LookAtLH(eye, focus, up);
+        camera.projection = PerspectiveFovLH(1.0472f, 16.0f / 9.0f, 0.1f, 500.0f);
+        D3D12Core::CullingFrustum frustum = D3D12Core::CullingFrustum::FromCamera(camera);
+
+        D3D12Core::FrustumCuller culler;
+        D3D12Core::CullingBVH bvh;
+        int64_t start = D3D12Core::FramePacer::Now();
+        bvh.Build(bounds);
+        double buildMs = (D3D12Core::FramePacer::Now() - start) / 1000000.0;
+
+        // Mejor de varias repeticiones (la primera solo reserva memoria)
+        auto measure = [](const std::function<uint32_t()>& cull, uint32_t& visible) {
+            double best = 0.0;
+            for (int repetition = 0; repetition <= REPETITIONS; repetition++) {
+                int64_t begin = D3D12Core::FramePacer::Now();
+                visible = cull();
+                double milliseconds = (D3D12Core::FramePacer::Now() - begin) / 1000000.0;
+                if (repetition == 1 || (repetition > 1 && milliseconds < best)) {
+                    best = milliseconds;
+                }
+            }
+            return best;
+        };
+        uint32_t flatVisible = 0;
+        uint32_t bvhVisible = 0;
+        double flatSerialMs = measure([&]() { return culler.Cull(frustum, bounds); }, flatVisible);
+        double flatMs = measure([&]() { return culler.Cull(frustum, bounds, &jobs); }, flatVisible);
+        double bvhSerialMs = measure([&]() { return bvh.Cull(frustum); }, bvhVisible);
+        double bvhMs = measure([&]() { return bvh.Cull(frustum, &jobs); }, bvhVisible);
+
+        // Los dos caminos deben encontrar los mismos objetos (el BVH en otro orden)
+        std::vector<uint32_t> flatIndices(culler.GetVisibleIndices(), culler.GetVisibleIndices() + flatVisible);
+        std::vector<uint32_t> bvhIndices(bvh.GetVisibleIndices(), bvh.GetVisibleIndices() + bvhVisible);
+        std::sort(bvhIndices.begin(), bvhIndices.end());
+        bool matches = flatIndices == bvhIndices;
+
+        std::cout << std::fixed << std::setprecision(3) << OBJECT_COUNT << " cajas, " << flatVisible << " visibles" << std::endl;
+        std::cout << "Plano: " << flatMs << " ms (" << flatSerialMs << " ms en un hilo)" << std::endl;
+        std::cout << "BVH: " << bvhMs << " ms (" << bvhSerialMs << " ms en un hilo), " << bvh.GetNodeCount()
+                  << " nodos construidos en " << buildMs << " ms" << (matches ? "" : " -- VISIBLES DISTINTOS") << std::endl;
+        jobs.Shutdown();
+        return matches;
+    }
+
+    // Componentes del benchmark de entidades: los dos que se recorren, un bloque frío que la
+    // iteración no toca y etiquetas para repartir las entidades entre muchos arquetipos
+    struct BenchPosition {
+        float x, y, z;
+    };
+    struct BenchVelocity {
+        float x, y, z;
+    };
+    struct BenchPayload {
+        float data[16];
+    };
+    template <uint32_t N>
+    struct BenchTag {
+        uint32_t value;
+    };
+
+    // 1M entidades: iteración de dos componentes (frente a un array de structs con los mismos
+    // datos), altas y bajas de un componente con command buffers y consultas sobre 256 arquetipos
+    bool RunEntityBenchmark() {
+        D3D12Core::JobSystem jobs;
+        if (!jobs.Initialize()) {
+            std::cerr << "Error: Failed to initialize entity workers" << std::endl;
+            return false;
+        }
+        std::cout << "=== Entidades (" << jobs.GetThreadCount() << " hilos, chunks de "
+                  << D3D12Core::ENTITY_CHUNK_SIZE / 1024 << " KB) ===" << std::endl;
+
+        constexpr uint32_t ENTITY_COUNT = 1000000;
+        constexpr uint32_t TAG_COUNT = 8;
+        constexpr int REPETITIONS = 5;
+        auto measure = [](const std::function<void()>& work) {
+            double best = 0.0;
+            for (int repetition = 0; repetition <= REPETITIONS; repetition++) {
+                int64_t begin = D3D12Core::FramePacer::Now();
+                work();
+                double milliseconds = (D3D12Core::FramePacer::Now() - begin) / 1000000.0;
+                if (repetition == 1 || (repetition > 1 && milliseconds < best)) {
+                    best = milliseconds;
+                }
+            }
+            return best;
+        };
+
+        // Iteración: p += v en las dos representaciones
+        struct ObjectAoS {
+            BenchPosition position;
+            BenchVelocity velocity;
+            BenchPayload payload;
+        };
+        std::vector<ObjectAoS> objects(ENTITY_COUNT);
+        D3D12Core::EntityWorld world;
+        for (uint32_t i = 0; i < ENTITY_COUNT; i++) {
+            objects[i].position = { 0.0f, 0.0f, 0.0f };
+            objects[i].velocity = { 1.0f, static_cast<float>(i % 7), 0.5f };
+            D3D12Core::Entity entity = world.CreateEntity();
+            world.AddComponent(entity, objects[i].position);
+            world.AddComponent(entity, objects[i].velocity);
+            world.AddComponent(entity, BenchPayload());
+        }
+        double aosMs = measure([&]() {
+            for (ObjectAoS& object : objects) {
+                object.position.x += object.velocity.x;
+                object.position.y += object.velocity.y;
+                object.position.z += object.velocity.z;
+            }
+        });
+        auto integrate = [](BenchPosition& position, const BenchVelocity& velocity) {
+            position.x += velocity.x;
+            position.y += velocity.y;
+            position.z += velocity.z;
+        };
+        double serialMs = measure([&]() {
+            world.ForEach<BenchPosition, const BenchVelocity>(
+                [&](D3D12Core::Entity, BenchPosition& position, const BenchVelocity& velocity) { integrate(position, velocity); });
+        });
+        double parallelMs = measure([&]() {
+            world.ParallelForEach<BenchPosition, const BenchVelocity>(&jobs,
+                [&](uint32_t, uint32_t, D3D12Core::Entity, BenchPosition& position, const BenchVelocity& velocity) {
+                    integrate(position, velocity);
+                });
+        });
+        // Las tres pasadas suman lo mismo: (1 + 2 * REPETITIONS) * v por entidad
+        double aosSum = 0.0;
+        double ecsSum = 0.0;
+        for (const ObjectAoS& object : objects) {
+            aosSum += object.position.y;
+        }
+        world.ForEach<const BenchPosition>([&](D3D12Core::Entity, const BenchPosition& position) { ecsSum += position.y; });
+        bool passed = std::fabs(2.0 * aosSum - ecsSum) <= 1e-6 * ecsSum;
+        std::cout << std::fixed << std::setprecision(3) << "Iteracion (" << ENTITY_COUNT << " entidades): ForEach "
+                  << serialMs << " ms, ParallelForEach " << parallelMs << " ms, array de structs " << aosMs << " ms"
+                  << (passed ? "" : " -- RESULTADOS DISTINTOS") << std::endl;
+
+        // Altas y bajas: etiqueta añadida y quitada a todas las entidades desde ParallelForEach
+        std::vector<D3D12Core::EntityCommandBuffer> commandBuffers(jobs.GetThreadCount());
+        auto playback = [&]() {
+            uint32_t failed = 0;
+            for (D3D12Core::EntityCommandBuffer& commands : commandBuffers) {
+                failed += commands.Playback(world);
+            }
+            return failed;
+        };
+        uint32_t churnFailures = 0;
+        double recordMs = 0.0;
+        double addMs = 0.0;
+        double removeMs = 0.0;
+        for (int repetition = 0; repetition < REPETITIONS; repetition++) {
+            int64_t begin = D3D12Core::FramePacer::Now();
+            world.ParallelForEach<const BenchPosition>(&jobs, [&](uint32_t, uint32_t workerIndex, D3D12Core::Entity entity, const BenchPosition&) {
+                commandBuffers[workerIndex].AddComponent(entity, BenchTag<0>{ 1 });
+            });
+            int64_t recorded = D3D12Core::FramePacer::Now();
+            churnFailures += playback();
+            int64_t added = D3D12Core::FramePacer::Now();
+            world.ParallelForEach<const BenchTag<0>>(&jobs, [&](uint32_t, uint32_t workerIndex, D3D12Core::Entity entity, const BenchTag<0>&) {
+                commandBuffers[workerIndex].RemoveComponent<BenchTag<0>>(entity);
+            });
+            churnFailures += playback();
+            int64_t removed = D3D12Core::FramePacer::Now();
+            recordMs += (recorded - begin) / 1000000.0 / REPETITIONS;
+            addMs += (added - recorded) / 1000000.0 / REPETITIONS;
+            removeMs += (removed - added) / 1000000.0 / REPETITIONS;
+        }
+        passed = passed && churnFailures == 0 && world.Count<BenchTag<0>>() == 0 && world.Count<BenchPosition>() == ENTITY_COUNT;
+        std::cout << "Altas/bajas de un componente: grabar " << recordMs << " ms, aplicar add " << addMs << " ms ("
+                  << addMs * 1000000.0 / ENTITY_COUNT << " ns/entidad), remove " << removeMs << " ms"
+                  << (churnFailures == 0 ? "" : " -- COMANDOS FALLIDOS") << std::endl;
+
+        // Consultas: etiquetas según los bits del índice (256 combinaciones). La primera consulta
+        // compara todos los arquetipos; las siguientes salen de la caché
+        world.Clear();
+        const D3D12Core::ComponentTypeId tagTypes[TAG_COUNT] = {
+            D3D12Core::GetComponentTypeId<BenchTag<0>>(), D3D12Core::GetComponentTypeId<BenchTag<1>>(),
+            D3D12Core::GetComponentTypeId<BenchTag<2>>(), D3D12Core::GetComponentTypeId<BenchTag<3>>(),
+            D3D12Core::GetComponentTypeId<BenchTag<4>>(), D3D12Core::GetComponentTypeId<BenchTag<5>>(),
+            D3D12Core::GetComponentTypeId<BenchTag<6>>(), D3D12Core::GetComponentTypeId<BenchTag<7>>()
+        };
+        uint32_t expected = 0;
+        uint64_t expectedTagSum = 0;
+        for (uint32_t i = 0; i < ENTITY_COUNT; i++) {
+            D3D12Core::Entity entity = world.CreateEntity();
+            world.AddComponent(entity, BenchPosition{ 0.0f, 0.0f, 0.0f });
+            const uint32_t tags = i % (1u << TAG_COUNT);
+            for (uint32_t tag = 0; tag < TAG_COUNT; tag++) {
+                if (tags & (1u << tag)) {
+                    world.AddComponentData(entity, tagTypes[tag], &i);
+                }
+            }
+            if ((tags & 0x24) == 0x24) { // BenchTag<2> y BenchTag<5>
+                expected++;
+                expectedTagSum += 2ull * i;
+            }
+        }
+        uint32_t matched = 0;
+        int64_t begin = D3D12Core::FramePacer::Now();
+        matched = world.Count<BenchPosition, BenchTag<2>, BenchTag<5>>();
+        double firstQueryUs = (D3D12Core::FramePacer::Now() - begin) / 1000.0;
+        double cachedQueryUs = measure([&]() { matched = world.Count<BenchPosition, BenchTag<2>, BenchTag<5>>(); }) * 1000.0;
+        uint32_t iterated = 0;
+        uint64_t tagSum = 0;
+        double queryIterationMs = measure([&]() {
+            iterated = 0;
+            tagSum = 0;
+            world.ForEach<const BenchTag<2>, const BenchTag<5>>(
+                [&](D3D12Core::Entity, const BenchTag<2>& first, const BenchTag<5>& second) {
+                    iterated++;
+                    tagSum += first.value + second.value;
+                });
+        });
+        passed = passed && matched == expected && iterated == expected && tagSum == expectedTagSum;
+        std::cout << "Consulta de 3 componentes sobre " << world.GetArchetypeCount() << " arquetipos: primera "
+                  << firstQueryUs << " us, en cache " << cachedQueryUs << " us, recorrer " << matched
+                  << " entidades " << queryIterationMs << " ms" << (passed ? "" : " -- CONSULTA INCORRECTA") << std::endl;
+        std::cout << world.BuildReport();
+        jobs.Shutdown();
+        return passed;
+    }
+
+    // Kernels por lotes de BatchMath con cada nivel SIMD que soporta la CPU, en un hilo y sobre
+    // 1M elementos: tiempo, aceleración frente al escalar y resultado comparado bit a bit con él
+    bool RunSimdBenchmark() {
+        const D3D12Core::SimdLevel supported = D3D12Core::GetSupportedSimdLevel();
+        std::cout << "=== Kernels SIMD (CPU: " << D3D12Core::GetSimdLevelName(supported) << ", un hilo) ===" << std::endl;
+
+        constexpr uint32_t ITEM_COUNT = 1000000;
+        constexpr int REPETITIONS = 5;
+        std::mt19937 random(ITEM_COUNT);
+        std::uniform_real_distribution<float> values(-2.0f, 2.0f);
+        std::vector<float> soa[16];
+        for (std::vector<float>& array : soa) {
+            array.resize(ITEM_COUNT);
+            for (float& value : array) {
+                value = values(random);
+            }
+        }
+        std::vector<D3D12Core::Float4x4> matrices(ITEM_COUNT);
+        for (D3D12Core::Float4x4& matrix : matrices) {
+            for (auto& row : matrix.m) {
+                for (float& value : row) {
+                    value = values(random);
+                }
+            }
+        }
+        std::vector<uint32_t> order(ITEM_COUNT);
+        for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+            order[i] = i;
+        }
+        std::shuffle(order.begin(), order.end(), random);
+        D3D12Core::CameraProxy camera;
+        float eye[3] = { 0.0f, 0.0f, -4.0f };
+        float focus[3] = { 0.3f, 0.1f, 0.0f };
+        float up[3] = { 0.0f, 1.0f, 0.0f };
+        camera.view = LookAtLH(eye, focus, up);
+        camera.projection = PerspectiveFovLH(1.0472f, 16.0f / 9.0f, 0.1f, 500.0f);
+        const D3D12Core::CullingFrustum frustum = D3D12Core::CullingFrustum::FromCamera(camera);
+
+        const float* points[3] = { soa[0].data(), soa[1].data(), soa[2].data() };
+        const float* extents[3] = { soa[3].data(), soa[4].data(), soa[5].data() };
+        const float* rotations[4] = { soa[6].data(), soa[7].data(), soa[8].data(), soa[9].data() };
+        const float* scales[3] = { soa[10].data(), soa[11].data(), soa[12].data() };
+        std::vector<D3D12Core::Float4x4> outputMatrices(ITEM_COUNT);
+        std::vector<float> outputs[6];
+        for (std::vector<float>& array : outputs) {
+            array.resize(ITEM_COUNT);
+        }
+        float* outputPoints[3] = { outputs[0].data(), outputs[1].data(), outputs[2].data() };
+        float* outputExtents[3] = { outputs[3].data(), outputs[4].data(), outputs[5].data() };
+        D3D12Core::CullingBounds bounds;
+        bounds.Resize(ITEM_COUNT);
+        for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+            const float center[3] = { soa[0][i] * 20.0f, soa[1][i] * 20.0f, soa[2][i] * 20.0f };
+            const float extent[3] = { std::fabs(soa[3][i]), std::fabs(soa[4][i]), std::fabs(soa[5][i]) };
+            bounds.Set(i, center, extent);
+        }
+        D3D12Core::FrustumCuller culler;
+        D3D12Core::TransformHierarchy hierarchy;
+        std::vector<D3D12Core::TransformHandle> nodes(ITEM_COUNT);
+        for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+            nodes[i] = hierarchy.Create(i < 1000 ? D3D12Core::INVALID_TRANSFORM : nodes[i % 1000]);
+            const float center[3] = { soa[13][i], soa[14][i], soa[15][i] };
+            const float extent[3] = { std::fabs(soa[3][i]), std::fabs(soa[4][i]), std::fabs(soa[5][i]) };
+            hierarchy.SetPosition(nodes[i], soa[0][i], soa[1][i], soa[2][i]);
+            hierarchy.SetLocalBounds(nodes[i], center, extent);
+        }
+        hierarchy.Update();
+
+        // Cada operación escribe su salida en bytes: la del escalar es la referencia
+        struct Operation {
+            const char* name;
+            std::function<void()> run;
+            std::function<std::vector<uint8_t>()> result;
+            double scalarMs = 0.0;
+            std::vector<uint8_t> reference = {};
+        };
+        auto bytesOf = [](const void* data, size_t size) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            return std::vector<uint8_t>(bytes, bytes + size);
+        };
+        auto matrixBytes = [&]() { return bytesOf(outputMatrices.data(), ITEM_COUNT * sizeof(D3D12Core::Float4x4)); };
+        auto soaBytes = [&](uint32_t arrays) {
+            std::vector<uint8_t> bytes;
+            for (uint32_t a = 0; a < arrays; a++) {
+                std::vector<uint8_t> array = bytesOf(outputs[a].data(), ITEM_COUNT * sizeof(float));
+                bytes.insert(bytes.end(), array.begin(), array.end());
+            }
+            return bytes;
+        };
+        uint32_t visible = 0;
+        Operation operations[] = {
+            { "Trasponer (indices)", [&]() {
+                D3D12Core::BatchMath::MultiplyTranspose(matrices.data(), sizeof(D3D12Core::Float4x4), order.data(), nullptr,
+                    outputMatrices.data(), sizeof(D3D12Core::Float4x4), ITEM_COUNT);
+            }, matrixBytes },
+            { "Multiplicar y trasponer", [&]() {
+                D3D12Core::BatchMath::MultiplyTranspose(matrices.data(), sizeof(D3D12Core::Float4x4), nullptr, &camera.view,
+                    outputMatrices.data(), sizeof(D3D12Core::Float4x4), ITEM_COUNT);
+            }, matrixBytes },
+            { "Transformar puntos", [&]() {
+                D3D12Core::BatchMath::TransformPoints(points, camera.view, outputPoints, ITEM_COUNT);
+            }, [&]() { return soaBytes(3); } },
+            { "Proyectar puntos", [&]() {
+                float* outputClip[4] = { outputs[0].data(), outputs[1].data(), outputs[2].data(), outputs[3].data() };
+                D3D12Core::BatchMath::ProjectPoints(points, camera.projection, outputClip, ITEM_COUNT);
+            }, [&]() { return soaBytes(4); } },
+            { "Transformar AABB", [&]() {
+                D3D12Core::BatchMath::TransformBounds(points, extents, matrices.data(), outputPoints, outputExtents, ITEM_COUNT);
+            }, [&]() { return soaBytes(6); } },
+            { "Cuaternion a matriz", [&]() {
+                D3D12Core::BatchMath::ComposeTransforms(points, rotations, scales, outputMatrices.data(), ITEM_COUNT);
+            }, matrixBytes },
+            { "Frustum culling", [&]() { visible = culler.Cull(frustum, bounds); },
+              [&]() { return bytesOf(culler.GetVisibleIndices(), visible * sizeof(uint32_t)); } },
+            { "TransformHierarchy::Update", [&]() {
+                // Girar las 1000 raíces obliga a recalcular todos los nodos
+                const float axis[3] = { 0.0f, 1.0f, 0.0f };
+                for (uint32_t i = 0; i < 1000; i++) {
+                    hierarchy.SetRotation(nodes[i], D3D12Core::QuaternionRotationNormal(axis, 0.001f * i));
+                }
+                hierarchy.Update();
+            }, [&]() {
+                std::vector<uint8_t> bytes;
+                for (uint32_t i = 0; i < ITEM_COUNT; i += 997) {
+                    std::vector<uint8_t> world = bytesOf(&hierarchy.GetWorld(nodes[i]), sizeof(D3D12Core::Float4x4));
+                    bytes.insert(bytes.end(), world.begin(), world.end());
+                }
+                return bytes;
+            } }
+        };
+
+        bool identical = true;
+        for (uint32_t level = 0; level <= static_cast<uint32_t>(supported); level++) {
+            const D3D12Core::SimdLevel simdLevel = static_cast<D3D12Core::SimdLevel>(level);
+            if (!D3D12Core::SetSimdLevel(simdLevel)) {
+                continue;
+            }
+            std::cout << D3D12Core::GetSimdLevelName(simdLevel) << " (" << D3D12Core::GetSimdLevelWidth(simdLevel)
+                      << " carriles):" << std::endl;
+            for (Operation& operation : operations) {
+                double best = 0.0;
+                for (int repetition = 0; repetition <= REPETITIONS; repetition++) {
+                    int64_t begin = D3D12Core::FramePacer::Now();
+                    operation.run();
+                    double milliseconds = (D3D12Core::FramePacer::Now() - begin) / 1000000.0;
+                    if (repetition == 1 || (repetition > 1 && milliseconds < best)) {
+                        best = milliseconds;
+                    }
+                }
+                std::vector<uint8_t> result = operation.result();
+                bool same = true;
+                if (simdLevel == D3D12Core::SimdLevel::Scalar) {
+                    operation.scalarMs = best;
+                    operation.reference = std::move(result);
+                }
+                else {
+                    same = result == operation.reference;
+                }
+                identical = identical && same;
+                std::cout << std::fixed << std::setprecision(3) << "  " << operation.name << ": " << best << " ms ("
+                          << std::setprecision(2) << operation.scalarMs / best << "x)" << (same ? "" : " -- RESULTADO DISTINTO")
+                          << std::endl;
+            }
+        }
+        D3D12Core::SetSimdLevel(supported);
+        return identical;
+    }
+
+    // Caja [-1, 1]^3 con cada cara dividida en divisions x divisions quads (dos triángulos cada uno)
+    void BuildTessellatedBox(uint32_t divisions, std::vector<D3D12Core::Vertex>& vertices, std::vector<uint32_t>& indices) {
+        // Normal, eje u y eje v de cada cara (u x v = normal hacia fuera: sentido horario visto de fuera)
+        const float faces[6][3][3] = {
+            { { 0, 0, -1 }, { 1, 0, 0 }, { 0, 1, 0 } }, { { 0, 0, 1 }, { -1, 0, 0 }, { 0, 1, 0 } },
+            { { -1, 0, 0 }, { 0, 0, -1 }, { 0, 1, 0 } }, { { 1, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 } },
+            { { 0, 1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } }, { { 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, -1 } }
+        };
+        vertices.clear();
+        indices.clear();
+        for (const auto& face : faces) {
+            const uint32_t base = static_cast<uint32_t>(vertices.size());
+            for (uint32_t j = 0; j <= divisions; j++) {
+                for (uint32_t i = 0; i <= divisions; i++) {
+                    float u = 2.0f * i / divisions - 1.0f;
+                    float v = 2.0f * j / divisions - 1.0f;
+                    D3D12Core::Vertex vertex = {};
+                    for (int axis = 0; axis < 3; axis++) {
+                        vertex.position[axis] = face[0][axis] + u * face[1][axis] + v * face[2][axis];
+                    }
+                    vertices.push_back(vertex);
+                }
+            }
+            for (uint32_t j = 0; j < divisions; j++) {
+                for (uint32_t i = 0; i < divisions; i++) {
+                    uint32_t corner = base + j * (divisions + 1) + i;
+                    uint32_t above = corner + divisions + 1;
+                    indices.insert(indices.end(), { corner, above, above + 1, above + 1, corner + 1, corner });
+                }
+            }
+        }
+    }
+
+    // Un draw por objeto (CBV de 256 bytes + DrawIndexed) frente a ExecuteIndirect (drawIndex raíz
+    // + objetos en un structured buffer) con 1k, 10k y 100k objetos de 4 materiales sobre la RHI
+    // nula: CPU por frame de preparar y grabar cada camino y bytes subidos por draw. Antes, los dos
+    // caminos dibujan 1k cubos con la RHI software y las imágenes deben ser idénticas
+    bool RunIndirectBenchmark() {
+        constexpr int FRAMES = 20;
+        constexpr uint32_t MATERIALS = 4;
+        constexpr uint32_t GRID_COLUMNS = 40;
+        constexpr uint32_t CHECK_WIDTH = 320;
+        constexpr uint32_t CHECK_HEIGHT = 180;
+        std::cout << "=== ExecuteIndirect frente a un draw por objeto ===" << std::endl;
+
+        std::vector<D3D12Core::Vertex> boxVertices;
+        std::vector<uint32_t> boxIndices;
+        BuildTessellatedBox(1, boxVertices, boxIndices);
+        for (D3D12Core::Vertex& vertex : boxVertices) {
+            for (int axis = 0; axis < 3; axis++) {
+                vertex.color[axis] = vertex.position[axis] * 0.4f + 0.5f;
+            }
+        }
+        std::vector<D3D12Core::IndirectMesh> meshes(1);
+        meshes[0].lods[0].indexCount = static_cast<uint32_t>(boxIndices.size());
+
+        // Rejilla de cubos girados en el plano z = 0, materiales intercalados en orden de envío
+        D3D12Core::CameraProxy camera;
+        float eye[3] = { 0.0f, 0.0f, -80.0f };
+        float focus[3] = { 0.0f, 0.0f, 0.0f };
+        float up[3] = { 0.0f, 1.0f, 0.0f };
+        camera.view = LookAtLH(eye, focus, up);
+        camera.projection = PerspectiveFovLH(1.0472f, 16.0f / 9.0f, 0.1f, 200.0f);
+        auto buildProxies = [&](uint32_t count) {
+            std::vector<D3D12Core::RenderProxy> proxies(count);
+            const uint32_t rows = (count + GRID_COLUMNS - 1) / GRID_COLUMNS;
+            for (uint32_t i = 0; i < count; i++) {
+                float angle = 0.37f * i;
+                Float4x4 world;
+                world.m[0][0] = std::cos(angle);
+                world.m[0][2] = -std::sin(angle);
+                world.m[2][0] = std::sin(angle);
+                world.m[2][2] = std::cos(angle);
+                world.m[3][0] = (static_cast<float>(i % GRID_COLUMNS) - GRID_COLUMNS * 0.5f) * 3.0f;
+                world.m[3][1] = (static_cast<float>(i / GRID_COLUMNS) - rows * 0.5f) * 3.0f;
+                proxies[i].world = world;
+                proxies[i].materialId = i % MATERIALS;
+            }
+            return proxies;
+        };
+
+        bool passed = true;
+        auto check = [&passed](bool condition, const char* message) {
+            if (!condition) {
+                std::cerr << "Error: " << message << std::endl;
+                passed = false;
+            }
+        };
+
+        // Preparación y grabación de cada camino; los dos dejan el frame listo para enviar
+        // (el directo como el camino por objeto del bucle principal: RenderQueue por material)
+        D3D12Core::RenderQueue renderQueue;
+        D3D12Core::IndirectDrawBuilder builder;
+        std::vector<D3D12Core::Float4x4> drawModels;
+        std::vector<D3D12Core::IndirectObjectData> objects;
+        std::vector<D3D12Core::RHIIndirectDrawCommand> commands;
+        auto recordDirect = [&](D3D12Core::IRHIDevice& device, D3D12Core::IRHICommandList* list, D3D12Core::IRHIPipeline* pipeline,
+            const std::vector<D3D12Core::RenderProxy>& proxies) {
+            MVPConstants constants;
+            constants.view = Transpose(camera.view);
+            constants.projection = Transpose(camera.projection);
+            renderQueue.Reset();
+            for (uint32_t i = 0; i < proxies.size(); i++) {
+                renderQueue.Add(D3D12Core::DrawSortKey::Opaque(0, 0, 0, proxies[i].materialId, proxies[i].meshId, 0.0f), i);
+            }
+            renderQueue.Sort();
+            const std::vector<uint32_t>& drawIndices = renderQueue.GetDrawIndices();
+            drawModels.resize(drawIndices.size());
+            D3D12Core::BatchMath::MultiplyTranspose(&proxies.data()->world, sizeof(D3D12Core::RenderProxy), drawIndices.data(),
+                nullptr, drawModels.data(), sizeof(D3D12Core::Float4x4), static_cast<uint32_t>(drawIndices.size()));
+            list->SetPipeline(pipeline);
+            for (const D3D12Core::Float4x4& model : drawModels) {
+                constants.model = model;
+                list->SetConstantBuffer(0, device.AllocateConstants(&constants, sizeof(constants)));
+                list->DrawIndexed(meshes[0].lods[0].indexCount, 1, 0, 0, 0);
+            }
+        };
+        auto recordIndirect = [&](D3D12Core::IRHIDevice& device, D3D12Core::IRHICommandList* list, D3D12Core::IRHIPipeline* pipeline,
+            const std::vector<D3D12Core::RenderProxy>& proxies) {
+            MVPConstants constants;
+            constants.view = Transpose(camera.view);
+            constants.projection = Transpose(camera.projection);
+            uint32_t commandCount = builder.Prepare(proxies, meshes);
+            objects.resize(commandCount);
+            commands.resize(commandCount);
+            builder.WriteObjects(proxies, objects.data());
+            builder.WriteCommands(commands.data());
+            uint64_t objectBytes = commandCount * sizeof(D3D12Core::IndirectObjectData);
+            uint64_t argumentAddress = device.AllocateConstants(commands.data(), commandCount * sizeof(D3D12Core::RHIIndirectDrawCommand));
+            list->SetPipeline(pipeline);
+            list->SetConstantBuffer(0, device.AllocateConstants(&constants, sizeof(constants)));
+            list->SetObjectBuffer(device.AllocateConstants(objects.data(), objectBytes), objectBytes, sizeof(D3D12Core::IndirectObjectData));
+            for (const D3D12Core::IndirectDrawBucket& bucket : builder.GetBuckets()) {
+                list->ExecuteIndirect(argumentAddress + bucket.firstCommand * sizeof(D3D12Core::RHIIndirectDrawCommand), bucket.commandCount);
+            }
+        };
+
+        D3D12Core::RHIBufferDesc vertexDesc;
+        vertexDesc.size = boxVertices.size() * sizeof(D3D12Core::Vertex);
+        vertexDesc.usage = D3D12Core::RHI_BUFFER_USAGE_VERTEX;
+        vertexDesc.stride = sizeof(D3D12Core::Vertex);
+        D3D12Core::RHIBufferDesc indexDesc;
+        indexDesc.size = boxIndices.size() * sizeof(uint32_t);
+        indexDesc.usage = D3D12Core::RHI_BUFFER_USAGE_INDEX;
+        indexDesc.stride = sizeof(uint32_t);
+        D3D12Core::RHIPipelineDesc pipelineDesc;
+        pipelineDesc.vertexStride = sizeof(D3D12Core::Vertex);
+        D3D12Core::RHIPipelineDesc indirectPipelineDesc = pipelineDesc;
+        indirectPipelineDesc.objectStride = sizeof(D3D12Core::IndirectObjectData);
+
+        // Misma imagen por los dos caminos: cada comando lee el objeto de su drawIndex
+        {
+            D3D12Core::SoftwareRHIDevice device;
+            if (!device.Initialize()) {
+                return false;
+            }
+            std::unique_ptr<D3D12Core::IRHIBuffer> vertexBuffer = device.CreateBuffer(vertexDesc, boxVertices.data());
+            std::unique_ptr<D3D12Core::IRHIBuffer> indexBuffer = device.CreateBuffer(indexDesc, boxIndices.data());
+            std::unique_ptr<D3D12Core::IRHIPipeline> pipeline = device.CreatePipeline(pipelineDesc);
+            std::unique_ptr<D3D12Core::IRHIPipeline> indirectPipeline = device.CreatePipeline(indirectPipelineDesc);
+            std::unique_ptr<D3D12Core::IRHICommandList> list = device.CreateCommandList();
+            if (!vertexBuffer || !indexBuffer || !pipeline || !indirectPipeline || !list) {
+                std::cerr << "Error: Failed to create indirect benchmark resources" << std::endl;
+                return false;
+            }
+            const std::vector<D3D12Core::RenderProxy> proxies = buildProxies(1000);
+            const float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+            D3D12Core::RHIViewport viewport;
+            viewport.width = static_cast<float>(CHECK_WIDTH);
+            viewport.height = static_cast<float>(CHECK_HEIGHT);
+            D3D12Core::RHIRect scissor;
+            scissor.right = static_cast<int32_t>(CHECK_WIDTH);
+            scissor.bottom = static_cast<int32_t>(CHECK_HEIGHT);
+            uint64_t targets[2];
+            for (uint32_t path = 0; path < 2; path++) {
+                targets[path] = device.CreateRenderTarget(CHECK_WIDTH, CHECK_HEIGHT);
+                list->Begin();
+                list->ClearRenderTarget(targets[path], clearColor);
+                list->SetRenderTarget(targets[path]);
+                list->SetViewport(viewport);
+                list->SetScissor(scissor);
+                list->SetVertexBuffer(vertexBuffer.get());
+                list->SetIndexBuffer(indexBuffer.get(), D3D12Core::RHIFormat::R32Uint);
+                if (path == 0) {
+                    recordDirect(device, list.get(), pipeline.get(), proxies);
+                }
+                else {
+                    recordIndirect(device, list.get(), indirectPipeline.get(), proxies);
+                }
+                list->Close();
+                device.GetQueue()->ExecuteCommandList(list.get());
+                device.GetQueue()->Signal();
+            }
+            const D3D12Core::SoftwareFramebuffer* direct = device.GetRenderTarget(targets[0]);
+            const D3D12Core::SoftwareFramebuffer* indirect = device.GetRenderTarget(targets[1]);
+            if (!direct || !indirect) {
+                std::cerr << "Error: Failed to create indirect benchmark render targets" << std::endl;
+                return false;
+            }
+            check(direct->color == indirect->color, "ExecuteIndirect no da la misma imagen que un draw por objeto");
+            size_t covered = 0;
+            for (uint32_t pixel : direct->color) {
+                covered += pixel != direct->color.front() ? 1 : 0;
+            }
+            check(covered > direct->color.size() / 10, "la imagen de comprobacion apenas tiene cubos");
+            check(builder.GetBuckets().size() == MATERIALS, "un ExecuteIndirect por material");
+            check(device.GetValidationErrors() == 0, "errores de validacion en la RHI software");
+            std::cout << "Imagen de 1000 cubos (" << CHECK_WIDTH << "x" << CHECK_HEIGHT << ", " << covered
+                      << " pixeles cubiertos): " << (passed ? "identica" : "DISTINTA") << " por los dos caminos" << std::endl;
+            device.Shutdown();
+        }
+
+        D3D12Core::NullRHIDevice device;
+        if (!device.Initialize()) {
+            return false;
+        }
+        std::unique_ptr<D3D12Core::IRHIBuffer> vertexBuffer = device.CreateBuffer(vertexDesc);
+        std::unique_ptr<D3D12Core::IRHIBuffer> indexBuffer = device.CreateBuffer(indexDesc);
+        std::unique_ptr<D3D12Core::IRHIPipeline> pipeline = device.CreatePipeline(pipelineDesc);
+        std::unique_ptr<D3D12Core::IRHIPipeline> indirectPipeline = device.CreatePipeline(indirectPipelineDesc);
+        std::unique_ptr<D3D12Core::IRHICommandList> list = device.CreateCommandList();
+        D3D12Core::FrameScheduler scheduler;
+        if (!vertexBuffer || !indexBuffer || !pipeline || !indirectPipeline || !list ||
+            !scheduler.Initialize(device.GetQueue(), HEADLESS_FRAMES_IN_FLIGHT)) {
+            std::cerr << "Error: Failed to create indirect benchmark resources" << std::endl;
+            return false;
+        }
+        D3D12Core::RHIViewport viewport;
+        viewport.width = 1280.0f;
+        viewport.height = 720.0f;
+        D3D12Core::RHIRect scissor;
+        scissor.right = 1280;
+        scissor.bottom = 720;
+
+        for (uint32_t drawCount : { 1000u, 10000u, 100000u }) {
+            const std::vector<D3D12Core::RenderProxy> proxies = buildProxies(drawCount);
+            double directMs = 0.0;
+            for (uint32_t path = 0; path < 2; path++) {
+                const D3D12Core::NullRHIStats before = device.GetStats();
+                std::vector<double> frameMs;
+                for (int frame = 0; frame <= FRAMES; frame++) {
+                    uint32_t slot = scheduler.BeginFrame();
+                    int64_t start = D3D12Core::FramePacer::Now();
+                    list->Begin();
+                    list->SetRenderTarget(BACK_BUFFER_VIEW_BASE + slot);
+                    list->SetViewport(viewport);
+                    list->SetScissor(scissor);
+                    list->SetVertexBuffer(vertexBuffer.get());
+                    list->SetIndexBuffer(indexBuffer.get(), D3D12Core::RHIFormat::R32Uint);
+                    if (path == 0) {
+                        recordDirect(device, list.get(), pipeline.get(), proxies);
+                    }
+                    else {
+                        recordIndirect(device, list.get(), indirectPipeline.get(), proxies);
+                    }
+                    list->Close();
+                    device.GetQueue()->ExecuteCommandList(list.get());
+                    scheduler.EndFrame();
+                    if (frame > 0) { // El primero dimensiona los vectores
+                        frameMs.push_back((D3D12Core::FramePacer::Now() - start) / 1000000.0);
+                    }
+                }
+                scheduler.WaitForIdle();
+
+                const D3D12Core::NullRHIStats stats = device.GetStats();
+                const uint64_t expected = static_cast<uint64_t>(drawCount) * (FRAMES + 1);
+                const uint64_t draws = path == 0 ? stats.draws - before.draws : stats.indirectDraws - before.indirectDraws;
+                const double bytesPerDraw = static_cast<double>(stats.constantBytes - before.constantBytes) / expected;
+                check(draws == expected, path == 0 ? "draws directos perdidos" : "draws indirectos perdidos");
+                check(path == 0 || stats.executeIndirects - before.executeIndirects == static_cast<uint64_t>(MATERIALS) * (FRAMES + 1),
+                    "un ExecuteIndirect por material y frame");
+                TimingSummary summary = Summarize(frameMs);
+                if (path == 0) {
+                    directMs = summary.mean;
+                }
+                std::cout << std::fixed << std::setprecision(3) << drawCount << (path == 0 ? " draws directos" : " draws indirectos")
+                          << ": media " << summary.mean << " ms, p99 " << summary.p99 << " ms, " << std::setprecision(1)
+                          << bytesPerDraw << " bytes subidos por draw";
+                if (path == 1) {
+                    std::cout << std::setprecision(2) << ", x" << (summary.mean > 0.0 ? directMs / summary.mean : 0.0)
+                              << " frente a un draw por objeto";
+                    check(bytesPerDraw < sizeof(D3D12Core::IndirectObjectData) + sizeof(D3D12Core::RHIIndirectDrawCommand) + 1.0,
+                        "ExecuteIndirect sube mas que un objeto y un comando por draw");
+                }
+                std::cout << std::endl;
+            }
+        }
+        std::cout << "Por comando: " << sizeof(D3D12Core::RHIIndirectDrawCommand) << " bytes de argumentos (4 de drawIndex) + "
+                  << sizeof(D3D12Core::IndirectObjectData) << " de objeto, frente a una CBV de 256 bytes por draw" << std::endl;
+        check(device.GetStats().validationErrors == 0, "errores de validacion en la RHI nula");
+        scheduler.Shutdown();
+        device.Shutdown();
+        return passed;
+    }
+
+    bool RunOcclusionBenchmark() {
+        D3D12Core::JobSystem jobs;
+        if (!jobs.Initialize()) {
+            std::cerr << "Error: Failed to initialize occlusion workers" << std::endl;
+            return false;
+        }
+        // Ciudad de 32x32 edificios (cajas de 972 triángulos: ~1M triángulos de oclusores) con
+        // 100k objetos pequeños por las calles, vista desde el suelo
+        constexpr uint32_t CITY_SIDE = 32;
+        constexpr uint32_t BUILDING_COUNT = CITY_SIDE * CITY_SIDE;
+        constexpr uint32_t PROP_COUNT = 100000;
+        constexpr float BLOCK = 10.0f;
+        constexpr int REPETITIONS = 10;
+        constexpr uint32_t WALK_FRAMES = 60;
+        std::vector<D3D12Core::Vertex> boxVertices;
+        std::vector<uint32_t> boxIndices;
+        BuildTessellatedBox(9, boxVertices, boxIndices);
+        D3D12Core::OcclusionMesh building;
+        if (!building.Build(boxVertices, boxIndices)) {
+            return false;
+        }
+
+        std::mt19937 random(BUILDING_COUNT);
+        std::uniform_real_distribution<float> heights(4.0f, 20.0f);
+        std::uniform_real_distribution<float> street(0.0f, CITY_SIDE * BLOCK);
+        std::uniform_real_distribution<float> sizes(0.25f, 1.0f);
+        std::vector<D3D12Core::Float4x4> buildingWorlds(BUILDING_COUNT);
+        D3D12Core::CullingBounds bounds;
+        bounds.Resize(BUILDING_COUNT + PROP_COUNT);
+        for (uint32_t i = 0; i < BUILDING_COUNT; i++) {
+            const float height = heights(random);
+            const float center[3] = { (i % CITY_SIDE + 0.5f) * BLOCK, height, (i / CITY_SIDE + 0.5f) * BLOCK };
+            const float extent[3] = { BLOCK * 0.35f, height, BLOCK * 0.35f };
+            D3D12Core::Float4x4& world = buildingWorlds[i];
+            for (int axis = 0; axis < 3; axis++) {
+                world.m[axis][axis] = extent[axis];
+                world.m[3][axis] = center[axis];
+            }
+            bounds.Set(i, center, extent);
+        }
+        for (uint32_t i = 0; i < PROP_COUNT; i++) {
+            const float size = sizes(random);
+            const float center[3] = { street(random), size, street(random) };
+            const float extent[3] = { size, size, size };
+            bounds.Set(BUILDING_COUNT + i, center, extent);
+        }
+        std::vector<uint32_t> candidates(bounds.GetCount());
+        for (uint32_t i = 0; i < bounds.GetCount(); i++) {
+            candidates[i] = i;
+        }
+
+        // Cámara a la altura de una persona mirando a lo largo de una calle
+        auto cameraAt = [](float distance) {
+            D3D12Core::CameraProxy camera;
+            float eye[3] = { 3.2f * BLOCK + 5.0f, 1.7f, distance };
+            float focus[3] = { 3.2f * BLOCK + 25.0f, 1.5f, distance + 100.0f };
+            float up[3] = { 0.0f, 1.0f, 0.0f };
+            camera.view = LookAtLH(eye, focus, up);
+            camera.projection = PerspectiveFovLH(1.0472f, 16.0f / 9.0f, 0.1f, 1000.0f);
+            return camera;
+        };
+
+        D3D12Core::OcclusionCuller culler;
+        if (!culler.Initialize(OCCLUSION_WIDTH, OCCLUSION_WIDTH * 9 / 16)) {
+            return false;
+        }
+        std::cout << "=== Occlusion culling (" << jobs.GetThreadCount() << " hilos, depth buffer " << culler.GetWidth() << "x"
+                  << culler.GetHeight() << ") ===" << std::endl;
+
+        // Un frame completo sin coherencia temporal: todos los oclusores se rasterizan (los
+        // índices de objeto quedan fuera del rango que recuerda el culler) y la cámara se mueve
+        // un poco en cada repetición para que no se reutilice la pirámide
+        uint32_t visible = 0;
+        auto measure = [&](D3D12Core::JobSystem* frameJobs, double& rasterMs, double& testMs) {
+            rasterMs = testMs = 0.0;
+            for (int repetition = 0; repetition <= REPETITIONS; repetition++) {
+                culler.BeginFrame(cameraAt(repetition * 0.01f), 0);
+                for (uint32_t i = 0; i < BUILDING_COUNT; i++) {
+                    culler.AddOccluder(building, buildingWorlds[i], UINT32_MAX);
+                }
+                int64_t begin = D3D12Core::FramePacer::Now();
+                culler.RenderOccluders(frameJobs);
+                int64_t rendered = D3D12Core::FramePacer::Now();
+                visible = culler.Test(bounds, candidates.data(), bounds.GetCount(), frameJobs);
+                int64_t tested = D3D12Core::FramePacer::Now();
+                double raster = (rendered - begin) / 1000000.0;
+                double test = (tested - rendered) / 1000000.0;
+                if (repetition == 1 || (repetition > 1 && raster + test < rasterMs + testMs)) {
+                    rasterMs = raster;
+                    testMs = test;
+                }
+            }
+        };
+        double serialRasterMs, serialTestMs, rasterMs, testMs;
+        measure(nullptr, serialRasterMs, serialTestMs);
+        measure(&jobs, rasterMs, testMs);
+        const uint64_t primitivesPerFrame = culler.GetStats().primitives / culler.GetStats().frames;
+
+        std::cout << std::fixed << std::setprecision(3) << BUILDING_COUNT << " oclusores, "
+                  << BUILDING_COUNT * building.GetTriangleCount() << " triangulos (" << BUILDING_COUNT * building.GetPrimitiveCount()
+                  << " primitivas, " << primitivesPerFrame << " de cara y en pantalla)" << std::endl;
+        std::cout << bounds.GetCount() << " objetos probados, " << bounds.GetCount() - visible << " ocluidos ("
+                  << std::setprecision(1) << 100.0 * (bounds.GetCount() - visible) / bounds.GetCount() << "%)" << std::endl;
+        std::cout << std::setprecision(3) << "Oclusores: " << rasterMs << " ms (" << serialRasterMs << " ms en un hilo), pruebas: "
+                  << testMs << " ms (" << serialTestMs << " ms en un hilo)" << std::endl;
+
+        // Paseo por la calle con coherencia temporal: los edificios que quedaron ocluidos no se
+        // rasterizan en el frame siguiente
+        culler.ResetStats();
+        for (uint32_t frame = 0; frame < WALK_FRAMES; frame++) {
+            culler.BeginFrame(cameraAt(frame * 0.5f), bounds.GetCount());
+            for (uint32_t i = 0; i < BUILDING_COUNT; i++) {
+                culler.AddOccluder(building, buildingWorlds[i], i);
+            }
+            culler.RenderOccluders(&jobs);
+            culler.Test(bounds, candidates.data(), bounds.GetCount(), &jobs);
+        }
+        std::cout << "Paseo de " << WALK_FRAMES << " frames con coherencia temporal:" << std::endl;
+        std::cout << culler.BuildReport();
+        jobs.Shutdown();
+        return true;
+    }
+
+    // Esfera de rings x segments quads con el radio ondulado (relieve a varias escalas) y el
+    // color según la altura: geometría y color que simplificar sin costuras ni bordes
+    void BuildBumpySphere(uint32_t rings, uint32_t segments, std::vector<D3D12Core::Vertex>& vertices, std::vector<uint32_t>& indices) {
+        vertices.clear();
+        indices.clear();
+        auto addVertex = [&](float theta, float phi) {
+            const float bump = 0.06f * std::sin(7.0f * theta) * std::cos(5.0f * phi) +
+                               0.02f * std::sin(23.0f * theta + 1.0f) * std::sin(19.0f * phi) +
+                               0.005f * std::cos(61.0f * theta) * std::sin(53.0f * phi + 2.0f);
+            const float radius = 1.0f + bump;
+            D3D12Core::Vertex vertex = {};
+            vertex.position[0] = radius * std::sin(theta) * std::cos(phi);
+            vertex.position[1] = radius * std::cos(theta);
+            vertex.position[2] = radius * std::sin(theta) * std::sin(phi);
+            const float height = std::clamp(bump * 8.0f + 0.5f, 0.0f, 1.0f);
+            vertex.color[0] = 0.2f + 0.6f * height;
+            vertex.color[1] = 0.6f - 0.3f * height;
+            vertex.color[2] = 0.3f + 0.2f * (1.0f - height);
+            vertices.push_back(vertex);
+        };
+        const float pi = 3.14159265f;
+        addVertex(0.0f, 0.0f);
+        for (uint32_t ring = 1; ring < rings; ring++) {
+            for (uint32_t segment = 0; segment < segments; segment++) {
+                addVertex(pi * ring / rings, 2.0f * pi * segment / segments);
+            }
+        }
+        addVertex(pi, 0.0f);
+        // Vértice del anillo ring (1..rings-1) y segmento (con vuelta) en el buffer
+        auto ringVertex = [&](uint32_t ring, uint32_t segment) { return 1 + (ring - 1) * segments + segment % segments; };
+        const uint32_t south = static_cast<uint32_t>(vertices.size() - 1);
+        for (uint32_t segment = 0; segment < segments; segment++) {
+            indices.insert(indices.end(), { 0, ringVertex(1, segment + 1), ringVertex(1, segment) });
+            for (uint32_t ring = 1; ring + 1 < rings; ring++) {
+                uint32_t a = ringVertex(ring, segment), b = ringVertex(ring, segment + 1);
+                uint32_t c = ringVertex(ring + 1, segment), d = ringVertex(ring + 1, segment + 1);
+                indices.insert(indices.end(), { a, b, d, d, c, a });
+            }
+            indices.insert(indices.end(), { south, ringVertex(rings - 1, segment), ringVertex(rings - 1, segment + 1) });
+        }
+    }
+
+    bool RunLodBenchmark() {
+        D3D12Core::JobSystem jobs;
+        if (!jobs.Initialize()) {
+            std::cerr << "Error: Failed to initialize LOD workers" << std::endl;
+            return false;
+        }
+        std::cout << "=== LOD (" << jobs.GetThreadCount() << " hilos) ===" << std::endl;
+        std::vector<D3D12Core::Vertex> vertices;
+        std::vector<uint32_t> indices;
+        BuildBumpySphere(500, 1000, vertices, indices);
+        D3D12Core::MeshLodChain chain;
+        if (!chain.Build(vertices, indices)) {
+            return false;
+        }
+        std::cout << "Esfera de " << indices.size() / 3 << " triangulos:" << std::endl;
+        std::cout << chain.BuildReport();
+
+        // 20k objetos repartidos entre 1.5 y 40 unidades delante de una cámara que avanza despacio
+        // y tiembla unos centímetros cada frame: muchos quedan cerca de un umbral de cambio. El
+        // primer frame (todos desde el nivel 0) no cuenta
+        constexpr uint32_t OBJECT_COUNT = 20000;
+        constexpr uint32_t FRAMES = 240;
+        constexpr uint32_t VIEWPORT_HEIGHT = 1080;
+        std::mt19937 random(OBJECT_COUNT);
+        std::uniform_real_distribution<float> lateral(-15.0f, 15.0f);
+        std::uniform_real_distribution<float> depth(1.5f, 40.0f);
+        std::uniform_real_distribution<float> scales(0.5f, 2.0f);
+        std::vector<D3D12Core::Float4x4> worlds(OBJECT_COUNT);
+        std::vector<float> boundsCenters(OBJECT_COUNT * 3);
+        std::vector<float> boundsExtents(OBJECT_COUNT * 3);
+        for (uint32_t i = 0; i < OBJECT_COUNT; i++) {
+            const float scale = scales(random);
+            const float z = depth(random);
+            const float position[3] = { lateral(random) * z / 15.0f, lateral(random) * z / 30.0f, z };
+            for (int axis = 0; axis < 3; axis++) {
+                worlds[i].m[axis][axis] = scale;
+                worlds[i].m[3][axis] = position[axis];
+                boundsCenters[i * 3 + axis] = position[axis];
+                boundsExtents[i * 3 + axis] = 1.07f * scale; // Radio máximo de la esfera con relieve
+            }
+        }
+
+        auto run = [&](float hysteresis, double& selectMs) {
+            D3D12Core::LodSelector selector;
+            D3D12Core::LodSelectionSettings settings;
+            settings.hysteresis = hysteresis;
+            selector.SetSettings(settings);
+            std::vector<uint32_t> levels(OBJECT_COUNT, 0);
+            selectMs = 0.0;
+            for (uint32_t frame = 0; frame <= FRAMES; frame++) {
+                D3D12Core::CameraProxy camera;
+                float eye[3] = { 0.0f, 0.0f, -2.0f + 1.0f * frame / FRAMES + 0.05f * std::sin(frame * 2.4f) };
+                float focus[3] = { 0.0f, 0.0f, eye[2] + 100.0f };
+                float up[3] = { 0.0f, 1.0f, 0.0f };
+                camera.view = LookAtLH(eye, focus, up);
+                camera.projection = PerspectiveFovLH(1.0472f, 16.0f / 9.0f, 0.1f, 1000.0f);
+                std::memcpy(camera.position, eye, sizeof(eye));
+                int64_t begin = D3D12Core::FramePacer::Now();
+                selector.BeginFrame(camera, VIEWPORT_HEIGHT, jobs.GetThreadCount());
+                jobs.ParallelFor(OBJECT_COUNT, 1024, [&](uint32_t first, uint32_t end, uint32_t worker) {
+                    for (uint32_t i = first; i < end; i++) {
+                        levels[i] = selector.Select(chain.GetLods(), chain.GetLodCount(), worlds[i], &boundsCenters[i * 3],
+                            &boundsExtents[i * 3], levels[i], worker);
+                    }
+                });
+                selector.EndFrame();
+                if (frame == 0) {
+                    selector.ResetStats();
+                    continue;
+                }
+                selectMs += (D3D12Core::FramePacer::Now() - begin) / 1000000.0;
+            }
+            selectMs /= FRAMES;
+            return selector;
+        };
+        double withMs, withoutMs;
+        D3D12Core::LodSelector withHysteresis = run(0.25f, withMs);
+        D3D12Core::LodSelector withoutHysteresis = run(0.0f, withoutMs);
+        std::cout << std::fixed << std::setprecision(3) << OBJECT_COUNT << " objetos, " << FRAMES
+                  << " frames con la camara oscilando:" << std::endl;
+        std::cout << "Con histeresis (" << withMs << " ms por frame):" << std::endl;
+        std::cout << withHysteresis.BuildReport();
+        std::cout << "Sin histeresis (" << withoutMs << " ms por frame):" << std::endl;
+        std::cout << withoutHysteresis.BuildReport();
+        jobs.Shutdown();
+        return true;
+    }
+
+    // Mismos triángulos (por contenido de sus vértices y con el mismo sentido) en cualquier orden
+    bool SameTriangles(const std::vector<D3D12Core::Vertex>& beforeVertices, const uint32_t* beforeIndices,
+        const std::vector<D3D12Core::Vertex>& afterVertices, const uint32_t* afterIndices, uint32_t indexCount) {
+        using Triangle = std::array<D3D12Core::Vertex, 3>;
+        auto less = [](const D3D12Core::Vertex& a, const D3D12Core::Vertex& b) { return std::memcmp(&a, &b, sizeof(a)) < 0; };
+        auto collect = [&](const std::vector<D3D12Core::Vertex>& vertices, const uint32_t* indices) {
+            std::vector<Triangle> triangles(indexCount / 3);
+            for (uint32_t t = 0; t < indexCount / 3; t++) {
+                // Rotación que empieza por el menor vértice: conserva el sentido
+                uint32_t first = 0;
+                for (uint32_t corner = 1; corner < 3; corner++) {
+                    if (less(vertices[indices[t * 3 + corner]], vertices[indices[t * 3 + first]])) {
+                        first = corner;
+                    }
+                }
+                for (uint32_t corner = 0; corner < 3; corner++) {
+                    triangles[t][corner] = vertices[indices[t * 3 + (first + corner) % 3]];
+                }
+            }
+            std::sort(triangles.begin(), triangles.end(), [](const Triangle& a, const Triangle& b) {
+                return std::memcmp(a.data(), b.data(), sizeof(Triangle)) < 0;
+            });
+            return triangles;
+        };
+        std::vector<Triangle> before = collect(beforeVertices, beforeIndices);
+        std::vector<Triangle> after = collect(afterVertices, afterIndices);
+        return std::memcmp(before.data(), after.data(), before.size() * sizeof(Triangle)) == 0;
+    }
+
+    // Triángulos en orden aleatorio y vertex buffer barajado: como llegan de un exportador que
+    // no optimiza
+    void ShuffleMesh(std::mt19937& random, std::vector<D3D12Core::Vertex>& vertices, std::vector<uint32_t>& indices) {
+        std::vector<uint32_t> triangles(indices.size() / 3);
+        std::iota(triangles.begin(), triangles.end(), 0u);
+        std::shuffle(triangles.begin(), triangles.end(), random);
+        std::vector<uint32_t> remap(vertices.size());
+        std::iota(remap.begin(), remap.end(), 0u);
+        std::shuffle(remap.begin(), remap.end(), random);
+        std::vector<D3D12Core::Vertex> shuffledVertices(vertices.size());
+        for (size_t vertex = 0; vertex < vertices.size(); vertex++) {
+            shuffledVertices[remap[vertex]] = vertices[vertex];
+        }
+        std::vector<uint32_t> shuffledIndices(indices.size());
+        for (size_t t = 0; t < triangles.size(); t++) {
+            for (uint32_t corner = 0; corner < 3; corner++) {
+                shuffledIndices[t * 3 + corner] = remap[indices[triangles[t] * 3 + corner]];
+            }
+        }
+        vertices.swap(shuffledVertices);
+        indices.swap(shuffledIndices);
+    }
+
+    bool RunMeshBenchmark() {
+        std::cout << "=== Optimizacion de mallas (un hilo) ===" << std::endl;
+        std::mt19937 random(2024);
+        auto optimize = [&](const char* name, std::vector<D3D12Core::Vertex>& vertices, std::vector<uint32_t>& indices) {
+            ShuffleMesh(random, vertices, indices);
+            const std::vector<D3D12Core::Vertex> originalVertices = vertices;
+            const std::vector<uint32_t> originalIndices = indices;
+            D3D12Core::MeshOptimizer optimizer;
+            if (!optimizer.Optimize(vertices, indices)) {
+                return false;
+            }
+            const bool same = SameTriangles(originalVertices, originalIndices.data(), vertices, indices.data(),
+                static_cast<uint32_t>(indices.size()));
+            std::cout << name << ", " << indices.size() / 3 << " triangulos y " << vertices.size() << " vertices desordenados:"
+                      << (same ? "" : " -- TRIANGULOS DISTINTOS") << std::endl;
+            std::cout << optimizer.BuildReport();
+            return same;
+        };
+
+        // Esfera de 1M triángulos: caché y lecturas de vértices
+        std::vector<D3D12Core::Vertex> sphereVertices;
+        std::vector<uint32_t> sphereIndices;
+        BuildBumpySphere(500, 1000, sphereVertices, sphereIndices);
+        std::vector<D3D12Core::Vertex> lodVertices = sphereVertices;
+        std::vector<uint32_t> lodIndices = sphereIndices;
+        bool passed = optimize("Esfera", sphereVertices, sphereIndices);
+
+        // 300 cajas solapadas en una sola malla (60k vértices: índices de 16 bits): overdraw
+        std::vector<D3D12Core::Vertex> boxVertices;
+        std::vector<uint32_t> boxIndices;
+        BuildTessellatedBox(4, boxVertices, boxIndices);
+        std::uniform_real_distribution<float> positions(-6.0f, 6.0f);
+        std::uniform_real_distribution<float> sizes(0.5f, 3.0f);
+        std::vector<D3D12Core::Vertex> blockVertices;
+        std::vector<uint32_t> blockIndices;
+        for (uint32_t box = 0; box < 300; box++) {
+            const float center[3] = { positions(random), positions(random), positions(random) };
+            const float extent[3] = { sizes(random), sizes(random), sizes(random) };
+            const uint32_t base = static_cast<uint32_t>(blockVertices.size());
+            for (D3D12Core::Vertex vertex : boxVertices) {
+                for (int axis = 0; axis < 3; axis++) {
+                    vertex.position[axis] = center[axis] + vertex.position[axis] * extent[axis];
+                    vertex.color[axis] = 0.3f + 0.05f * (box % 14);
+                }
+                blockVertices.push_back(vertex);
+            }
+            for (uint32_t index : boxIndices) {
+                blockIndices.push_back(base + index);
+            }
+        }
+        passed = optimize("Bloque de cajas", blockVertices, blockIndices) && passed;
+
+        // Cadena de LODs de la esfera: cada nivel por separado sobre el mismo vertex buffer
+        D3D12Core::MeshLodChain chain;
+        if (!chain.Build(lodVertices, lodIndices)) {
+            return false;
+        }
+        std::vector<std::vector<uint32_t>> levels(chain.GetLodCount());
+        const std::vector<D3D12Core::Vertex> chainVertices = lodVertices;
+        for (uint32_t lod = 0; lod < chain.GetLodCount(); lod++) {
+            const D3D12Core::MeshLod& range = chain.GetLod(lod);
+            levels[lod].assign(chain.GetIndices().begin() + range.startIndex, chain.GetIndices().begin() + range.startIndex + range.indexCount);
+        }
+        D3D12Core::MeshOptimizer optimizer;
+        if (!optimizer.Optimize(lodVertices, chain)) {
+            return false;
+        }
+        std::cout << "Cadena de " << chain.GetLodCount() << " LODs de la esfera:" << std::endl;
+        std::cout << optimizer.BuildReport();
+        for (uint32_t lod = 0; lod < chain.GetLodCount(); lod++) {
+            const D3D12Core::MeshLod& range = chain.GetLod(lod);
+            const uint32_t* indices = chain.GetIndices().data() + range.startIndex;
+            const bool same = SameTriangles(chainVertices, levels[lod].data(), lodVertices, indices, range.indexCount);
+            D3D12Core::VertexCacheStats before = D3D12Core::MeshOptimizer::AnalyzeVertexCache(levels[lod].data(), range.indexCount,
+                static_cast<uint32_t>(chainVertices.size()));
+            D3D12Core::VertexCacheStats after = D3D12Core::MeshOptimizer::AnalyzeVertexCache(indices, range.indexCount,
+                static_cast<uint32_t>(lodVertices.size()));
+            std::cout << std::fixed << std::setprecision(3) << "  LOD " << lod << ": ACMR " << before.acmr << " -> " << after.acmr
+                      << ", ATVR " << before.atvr << " -> " << after.atvr << (same ? "" : " -- TRIANGULOS DISTINTOS") << std::endl;
+            passed = passed && same;
+        }
+        return passed;
+    }
+
+    bool RunVertexBenchmark() {
+        const D3D12Core::SimdLevel supported = D3D12Core::GetSupportedSimdLevel();
+        std::cout << "=== Formatos de vertices (CPU: " << D3D12Core::GetSimdLevelName(supported) << ", un hilo) ===" << std::endl;
+        constexpr int REPETITIONS = 5;
+        std::vector<D3D12Core::Vertex> vertices;
+        std::vector<uint32_t> indices;
+        BuildBumpySphere(500, 1000, vertices, indices);
+        const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+
+        // Memoria de la malla completa y de lo que lee un pase de profundidad (solo posiciones)
+        const D3D12Core::VertexFormat formats[] = {
+            D3D12Core::FullVertexFormat(), D3D12Core::CompressedVertexFormat(), D3D12Core::CompressedVertexFormat(true)
+        };
+        const double fullBytes = static_cast<double>(vertexCount) * D3D12Core::FullVertexFormat().GetVertexSize();
+        std::cout << vertexCount << " vertices (esfera de " << indices.size() / 3 << " triangulos):" << std::endl;
+        for (const D3D12Core::VertexFormat& format : formats) {
+            const double bytes = static_cast<double>(vertexCount) * format.GetVertexSize();
+            const double depthBytes = static_cast<double>(vertexCount) * format.GetStride(0);
+            std::cout << std::fixed << std::setprecision(2) << "  " << D3D12Core::GetVertexFormatName(format) << ": "
+                      << format.GetVertexSize() << " B/vertice, " << bytes / (1024.0 * 1024.0) << " MB ("
+                      << fullBytes / bytes << "x menos); pase de profundidad " << depthBytes / (1024.0 * 1024.0) << " MB ("
+                      << fullBytes / depthBytes << "x menos)" << std::endl;
+        }
+
+        // Ida y vuelta en cada nivel SIMD: bytes idénticos al escalar y error dentro de la cuantización
+        const D3D12Core::VertexFormat format = D3D12Core::CompressedVertexFormat(true);
+        D3D12Core::EncodedVertices reference;
+        std::vector<D3D12Core::Vertex> referenceDecoded;
+        double scalarEncodeMs = 0.0;
+        double scalarDecodeMs = 0.0;
+        bool passed = true;
+        for (uint32_t level = 0; level <= static_cast<uint32_t>(supported); level++) {
+            const D3D12Core::SimdLevel simdLevel = static_cast<D3D12Core::SimdLevel>(level);
+            if (!D3D12Core::SetSimdLevel(simdLevel)) {
+                continue;
+            }
+            D3D12Core::EncodedVertices encoded;
+            std::vector<D3D12Core::Vertex> decoded;
+            double encodeMs = 0.0;
+            double decodeMs = 0.0;
+            for (int repetition = 0; repetition <= REPETITIONS; repetition++) {
+                int64_t begin = D3D12Core::FramePacer::Now();
+                if (!D3D12Core::EncodeVertices(vertices.data(), vertexCount, format, encoded)) {
+                    return false;
+                }
+                int64_t middle = D3D12Core::FramePacer::Now();
+                D3D12Core::DecodeVertices(encoded, decoded);
+                int64_t end = D3D12Core::FramePacer::Now();
+                const double encodeTime = (middle - begin) / 1000000.0;
+                const double decodeTime = (end - middle) / 1000000.0;
+                if (repetition == 1 || (repetition > 1 && encodeTime < encodeMs)) {
+                    encodeMs = encodeTime;
+                }
+                if (repetition == 1 || (repetition > 1 && decodeTime < decodeMs)) {
+                    decodeMs = decodeTime;
+                }
+            }
+
+            // Error máximo en unidades de la cuantización: media unidad por eje más el redondeo de los floats
+            float positionError = 0.0f;
+            float colorError = 0.0f;
+            for (uint32_t i = 0; i < vertexCount; i++) {
+                for (uint32_t axis = 0; axis < 3; axis++) {
+                    positionError = std::max(positionError, std::fabs(decoded[i].position[axis] - vertices[i].position[axis]) /
+                        (encoded.quantization.positionScale[axis] / 32767.0f));
+                    colorError = std::max(colorError, std::fabs(decoded[i].color[axis] - vertices[i].color[axis]) * 255.0f);
+                }
+            }
+            bool same = true;
+            if (simdLevel == D3D12Core::SimdLevel::Scalar) {
+                scalarEncodeMs = encodeMs;
+                scalarDecodeMs = decodeMs;
+                reference = encoded;
+                referenceDecoded = decoded;
+            }
+            else {
+                same = encoded.streams[0] == reference.streams[0] && encoded.streams[1] == reference.streams[1] &&
+                       std::memcmp(decoded.data(), referenceDecoded.data(), vertexCount * sizeof(D3D12Core::Vertex)) == 0;
+            }
+            const bool accurate = positionError <= 0.51f && colorError <= 0.51f;
+            passed = passed && same && accurate;
+            std::cout << std::fixed << std::setprecision(3) << D3D12Core::GetSimdLevelName(simdLevel) << ": codificar "
+                      << encodeMs << " ms (" << std::setprecision(2) << scalarEncodeMs / encodeMs << "x), decodificar "
+                      << std::setprecision(3) << decodeMs << " ms (" << std::setprecision(2) << scalarDecodeMs / decodeMs
+                      << "x), error max " << std::setprecision(3) << positionError << " (posicion) y " << colorError
+                      << " (color) unidades" << (same ? "" : " -- RESULTADO DISTINTO")
+                      << (accurate ? "" : " -- ERROR FUERA DE RANGO") << std::endl;
+        }
+        D3D12Core::SetSimdLevel(supported);
+        return passed;
+    }
+
+    // Clusters de una malla grande: construcción, mismos triángulos que la entrada y, desde varias
+    // cámaras, cuántos clusters se descartan y que ningún triángulo delantero dentro del frustum
+    // se pierde (comprobado triángulo a triángulo con el área en pantalla)
+    bool RunMeshletBenchmark() {
+        D3D12Core::JobSystem jobs;
+        if (!jobs.Initialize()) {
+            std::cerr << "Error: Failed to initialize meshlet workers" << std::endl;
+            return false;
+        }
+        std::cout << "=== Meshlets (" << jobs.GetThreadCount() << " hilos) ===" << std::endl;
+        constexpr uint32_t ORBIT_VIEWS = 16;
+        constexpr int REPETITIONS = 5;
+
+        auto run = [&](const char* name, const std::vector<D3D12Core::Vertex>& vertices, const std::vector<uint32_t>& indices) {
+            D3D12Core::MeshletMesh mesh;
+            if (!mesh.Build(vertices, indices)) {
+                return false;
+            }
+            std::cout << name << ":" << std::endl;
+            std::cout << mesh.BuildReport();
+
+            // Mismos triángulos, con sus esquinas en el mismo orden, y límites de cada cluster
+            auto sortedTriangles = [](const std::vector<uint32_t>& source) {
+                std::vector<std::array<uint32_t, 3>> triangles(source.size() / 3);
+                for (size_t t = 0; t < triangles.size(); t++) {
+                    triangles[t] = { source[t * 3], source[t * 3 + 1], source[t * 3 + 2] };
+                }
+                std::sort(triangles.begin(), triangles.end());
+                return triangles;
+            };
+            bool passed = sortedTriangles(indices) == sortedTriangles(mesh.GetIndices());
+            for (uint32_t i = 0; i < mesh.GetMeshletCount(); i++) {
+                const D3D12Core::Meshlet& meshlet = mesh.GetMeshlets()[i];
+                passed = passed && meshlet.vertexCount <= D3D12Core::MESHLET_MAX_VERTICES &&
+                         meshlet.triangleCount <= D3D12Core::MESHLET_MAX_TRIANGLES;
+            }
+            if (!passed) {
+                std::cout << "  -- TRIANGULOS O LIMITES DISTINTOS" << std::endl;
+            }
+
+            // Cámaras en órbita (toda la malla en pantalla) y de cerca (buena parte fuera del frustum),
+            // con la malla sin transformar y con escala no uniforme, giro y espejo en x
+            D3D12Core::Float4x4 worlds[2];
+            const float angle = 0.6f;
+            worlds[1].m[0][0] = -1.5f * std::cos(angle);
+            worlds[1].m[0][2] = -1.5f * std::sin(angle);
+            worlds[1].m[2][0] = -0.75f * std::sin(angle);
+            worlds[1].m[2][2] = 0.75f * std::cos(angle);
+            worlds[1].m[3][1] = 0.25f;
+            const char* worldNames[2] = { "identidad", "escala no uniforme y espejo" };
+            for (uint32_t w = 0; w < 2; w++) {
+                for (float distance : { 3.5f, 1.4f }) {
+                    D3D12Core::MeshletCuller serialCuller;
+                    D3D12Core::MeshletCuller parallelCuller;
+                    double serialMs = 0.0;
+                    double parallelMs = 0.0;
+                    uint64_t wronglyCulled = 0;
+                    for (uint32_t view = 0; view < ORBIT_VIEWS; view++) {
+                        const float yaw = 6.2831853f * view / ORBIT_VIEWS;
+                        const float pitch = 0.4f * std::sin(yaw * 2.0f);
+                        D3D12Core::CameraProxy camera;
+                        float eye[3] = { distance * std::cos(pitch) * std::sin(yaw), distance * std::sin(pitch),
+                            -distance * std::cos(pitch) * std::cos(yaw) };
+                        float focus[3] = { 0.0f, 0.0f, 0.0f };
+                        float up[3] = { 0.0f, 1.0f, 0.0f };
+                        camera.view = LookAtLH(eye, focus, up);
+                        camera.projection = PerspectiveFovLH(1.0472f, 16.0f / 9.0f, 0.1f, 100.0f);
+                        std::memcpy(camera.position, eye, sizeof(eye));
+
+                        for (int repetition = 0; repetition <= REPETITIONS; repetition++) {
+                            int64_t begin = D3D12Core::FramePacer::Now();
+                            serialCuller.Cull(mesh, worlds[w], camera);
+                            int64_t middle = D3D12Core::FramePacer::Now();
+                            parallelCuller.Cull(mesh, worlds[w], camera, &jobs);
+                            int64_t end = D3D12Core::FramePacer::Now();
+                            if (repetition > 0) {
+                                serialMs += (middle - begin) / 1000000.0;
+                                parallelMs += (end - middle) / 1000000.0;
+                            }
+                        }
+                        passed = passed && serialCuller.GetIndexCount() == parallelCuller.GetIndexCount() &&
+                                 std::equal(serialCuller.GetIndices(), serialCuller.GetIndices() + serialCuller.GetIndexCount(),
+                                     parallelCuller.GetIndices());
+
+                        // Cada triángulo que falta en el index buffer compactado debe quedar fuera de un
+                        // plano del clip o de espaldas en pantalla (sentido antihorario, y hacia arriba)
+                        const D3D12Core::Float4x4 worldViewProjection = Multiply(worlds[w], Multiply(camera.view, camera.projection));
+                        std::vector<uint8_t> kept(indices.size() / 3, 0);
+                        std::vector<uint32_t> keptIndices(serialCuller.GetIndices(), serialCuller.GetIndices() + serialCuller.GetIndexCount());
+                        std::vector<std::array<uint32_t, 3>> keptTriangles(keptIndices.size() / 3);
+                        for (size_t t = 0; t < keptTriangles.size(); t++) {
+                            keptTriangles[t] = { keptIndices[t * 3], keptIndices[t * 3 + 1], keptIndices[t * 3 + 2] };
+                        }
+                        std::sort(keptTriangles.begin(), keptTriangles.end());
+                        for (size_t t = 0; t < indices.size() / 3; t++) {
+                            const std::array<uint32_t, 3> triangle = { indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2] };
+                            if (std::binary_search(keptTriangles.begin(), keptTriangles.end(), triangle)) {
+                                continue;
+                            }
+                            float clip[3][4];
+                            for (int corner = 0; corner < 3; corner++) {
+                                const float* p = vertices[triangle[corner]].position;
+                                for (int column = 0; column < 4; column++) {
+                                    clip[corner][column] = p[0] * worldViewProjection.m[0][column] + p[1] * worldViewProjection.m[1][column] +
+                                        p[2] * worldViewProjection.m[2][column] + worldViewProjection.m[3][column];
+                                }
+                            }
+                            bool outside = false;
+                            for (int plane = 0; plane < 6 && !outside; plane++) {
+                                const int axis = plane / 2;
+                                outside = true;
+                                for (int corner = 0; corner < 3 && outside; corner++) {
+                                    const float* c = clip[corner];
+                                    const bool inside = axis == 2 ? (plane == 4 ? c[2] >= 0.0f : c[2] <= c[3])
+                                                                  : (plane % 2 == 0 ? c[axis] >= -c[3] : c[axis] <= c[3]);
+                                    outside = !inside;
+                                }
+                            }
+                            if (outside) {
+                                continue;
+                            }
+                            if (clip[0][3] > 0.0f && clip[1][3] > 0.0f && clip[2][3] > 0.0f) {
+                                float x[3], y[3];
+                                for (int corner = 0; corner < 3; corner++) {
+                                    x[corner] = clip[corner][0] / clip[corner][3];
+                                    y[corner] = clip[corner][1] / clip[corner][3];
+                                }
+                                const float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+                                if (area >= 0.0f) {
+                                    continue;
+                                }
+                            }
+                            wronglyCulled++;
+                        }
+                    }
+                    passed = passed && wronglyCulled == 0;
+                    const D3D12Core::MeshletCullingStats& stats = serialCuller.GetStats();
+                    const double meshlets = static_cast<double>(std::max<uint64_t>(stats.meshlets, 1));
+                    std::cout << std::fixed << std::setprecision(1) << "  " << worldNames[w] << ", camara a " << distance
+                              << ": fuera del frustum " << 100.0 * stats.frustumCulled / meshlets << "%, de espaldas "
+                              << 100.0 * stats.backfaceCulled / meshlets << "%, triangulos "
+                              << 100.0 * stats.visibleTriangles / std::max<uint64_t>(stats.triangles, 1) << "%; "
+                              << std::setprecision(3) << serialMs / (ORBIT_VIEWS * REPETITIONS) << " ms (1 hilo), "
+                              << parallelMs / (ORBIT_VIEWS * REPETITIONS) << " ms (" << jobs.GetThreadCount() << " hilos)"
+                              << (wronglyCulled == 0 ? "" : " -- TRIANGULOS VISIBLES DESCARTADOS") << std::endl;
+                }
+            }
+            return passed;
+        };
+
+        std::vector<D3D12Core::Vertex> vertices;
+        std::vector<uint32_t> indices;
+        BuildBumpySphere(500, 1000, vertices, indices);
+        bool passed = run("Esfera", vertices, indices);
+        // Caja con caras de 289x289 quads: 1M triángulos planos (conos estrechos)
+        BuildTessellatedBox(289, vertices, indices);
+        passed = run("Caja teselada", vertices, indices) && passed;
+        return passed;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint64_t frameLimit = 600;
+    uint32_t width = 1280;
+    uint32_t height = 720;
+    double gpuMilliseconds = 0.0;
+    bool paced = true;
+    bool software = false;
+    std::string capturePath;
+    uint32_t objectCount = 1;
+    bool instancing = true;
+    bool indirect = false;
+    bool sortBenchmark = false;
+    bool cullBenchmark = false;
+    bool entityBenchmark = false;
+    bool simdBenchmark = false;
+    bool occlusionBenchmark = false;
+    bool lodBenchmark = false;
+    bool meshBenchmark = false;
+    bool vertexBenchmark = false;
+    bool meshletBenchmark = false;
+    bool indirectBenchmark = false;
+    bool snapshotTest = false;
+    bool pacerTest = false;
+    bool graphTest = false;
+    bool tlsfBenchmark = false;
+    bool stagingTest = false;
+    bool recordBenchmark = false;
+    bool schedulerTest = false;
+    bool optimizeMeshes = false;
+    D3D12Core::VertexFormat vertexFormat;
+    bool occluders = false;
+    bool occlusion = true;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--frames" && hasValue) {
+            frameLimit = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (argument == "--width" && hasValue) {
+            width = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--height" && hasValue) {
+            height = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--gpu-ms" && hasValue) {
+            gpuMilliseconds = std::strtod(argv[++i], nullptr);
+        }
+        else if (argument == "--unpaced") {
+            paced = false;
+        }
+        else if (argument == "--software") {
+            software = true;
+        }
+        else if (argument == "--capture" && hasValue) {
+            capturePath = argv[++i];
+        }
+        else if (argument == "--objects" && hasValue) {
+            objectCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--no-instancing") {
+            instancing = false;
+        }
+        else if (argument == "--indirect") {
+            indirect = true;
+        }
+        else if (argument == "--occluders") {
+            occluders = true;
+        }
+        else if (argument == "--no-occlusion") {
+            occlusion = false;
+        }
+        else if (argument == "--sort-benchmark") {
+            sortBenchmark = true;
+        }
+        else if (argument == "--cull-benchmark") {
+            cullBenchmark = true;
+        }
+        else if (argument == "--ecs-benchmark") {
+            entityBenchmark = true;
+        }
+        else if (argument == "--simd-benchmark") {
+            simdBenchmark = true;
+        }
+        else if (argument == "--occlusion-benchmark") {
+            occlusionBenchmark = true;
+        }
+        else if (argument == "--lod-benchmark") {
+            lodBenchmark = true;
+        }
+        else if (argument == "--mesh-benchmark") {
+            meshBenchmark = true;
+        }
+        else if (argument == "--vertex-benchmark") {
+            vertexBenchmark = true;
+        }
+        else if (argument == "--meshlet-benchmark") {
+            meshletBenchmark = true;
+        }
+        else if (argument == "--scheduler-test") {
+            schedulerTest = true;
+        }
+        else if (argument == "--record-benchmark") {
+            recordBenchmark = true;
+        }
+        else if (argument == "--staging-test") {
+            stagingTest = true;
+        }
+        else if (argument == "--tlsf-benchmark") {
+            tlsfBenchmark = true;
+        }
+        else if (argument == "--graph-test") {
+            graphTest = true;
+        }
+        else if (argument == "--pacer-test") {
+            pacerTest = true;
+        }
+        else if (argument == "--snapshot-test") {
+            snapshotTest = true;
+        }
+        else if (argument == "--indirect-benchmark") {
+            indirectBenchmark = true;
+        }
+        else if (argument == "--optimize-meshes") {
+            optimizeMeshes = true;
+        }
+        else if (argument == "--vertex-format" && hasValue) {
+            if (!D3D12Core::ParseVertexFormat(argv[++i], vertexFormat)) {
+                std::cerr << "Error: Formato de vertices desconocido: " << argv[i] << std::endl;
+                return 2;
+            }
+        }
+        else if (argument == "--simd" && hasValue) {
+            D3D12Core::SimdLevel level;
+            if (!D3D12Core::ParseSimdLevel(argv[++i], level) || !D3D12Core::SetSimdLevel(level)) {
+                std::cerr << "Error: Nivel SIMD no soportado: " << argv[i] << " (CPU: "
+                          << D3D12Core::GetSimdLevelName(D3D12Core::GetSupportedSimdLevel()) << ")" << std::endl;
+                return 2;
+            }
+        }
+        else {
+            std::cerr << "Uso: " << argv[0] << " [--frames N] [--width W] [--height H] [--gpu-ms X] [--unpaced]"
+                      << " [--software] [--capture archivo.ppm] [--objects N] [--no-instancing]"
+                      << " [--indirect] [--occluders] [--no-occlusion] [--sort-benchmark] [--cull-benchmark]"
+                      << " [--ecs-benchmark] [--simd-benchmark] [--occlusion-benchmark] [--lod-benchmark]"
+                      << " [--optimize-meshes] [--mesh-benchmark] [--vertex-benchmark] [--meshlet-benchmark]"
+                      << " [--scheduler-test] [--record-benchmark] [--staging-test] [--tlsf-benchmark]"
+                      << " [--graph-test] [--pacer-test] [--snapshot-test] [--indirect-benchmark]"
+                      << " [--vertex-format float|float-split|compact|compact-split] [--simd escalar|sse4.2|avx2|avx512]"
+                      << std::endl;
+            return 2;
+        }
+    }
+    if (sortBenchmark || cullBenchmark || entityBenchmark || simdBenchmark || occlusionBenchmark || lodBenchmark ||
+        meshBenchmark || vertexBenchmark || meshletBenchmark || schedulerTest || recordBenchmark || stagingTest ||
+        tlsfBenchmark || graphTest || pacerTest || snapshotTest || indirectBenchmark) {
+        bool passed = (!sortBenchmark || RunSortBenchmark()) && (!cullBenchmark || RunCullingBenchmark()) &&
+                      (!entityBenchmark || RunEntityBenchmark()) && (!simdBenchmark || RunSimdBenchmark()) &&
+                      (!occlusionBenchmark || RunOcclusionBenchmark()) && (!lodBenchmark || RunLodBenchmark()) &&
+                      (!meshBenchmark || RunMeshBenchmark()) && (!vertexBenchmark || RunVertexBenchmark()) &&
+                      (!meshletBenchmark || RunMeshletBenchmark()) && (!schedulerTest || RunSchedulerTest()) &&
+                      (!recordBenchmark || RunRecordBenchmark()) && (!stagingTest || RunStagingTest()) &&
+                      (!tlsfBenchmark || RunTlsfBenchmark()) && (!graphTest || RunGraphTest()) &&
+                      (!pacerTest || RunPacerTest()) && (!snapshotTest || RunSnapshotTest()) &&
+                      (!indirectBenchmark || RunIndirectBenchmark());
+        return passed ? 0 : 1;
+    }
+    if (width == 0 || height == 0) {
+        std::cerr << "Error: Dimensiones inválidas (" << width << "x" << height << ")" << std::endl;
+        return 2;
+    }
+    if (objectCount == 0) {
+        std::cerr << "Error: --objects necesita al menos un objeto" << std::endl;
+        return 2;
+    }
+    if (!capturePath.empty() && !software) {
+        std::cerr << "Error: --capture necesita --software (la RHI nula no produce imagen)" << std::endl;
+        return 2;
+    }
+
+    // RHI nula (solo validación) o por software (frames reales en CPU)
+    D3D12Core::NullRHIDevice nullDevice;
+    D3D12Core::SoftwareRHIDevice softwareDevice;
+    D3D12Core::IRHIDevice& device = software ? static_cast<D3D12Core::IRHIDevice&>(softwareDevice) : nullDevice;
+    if (software ? !softwareDevice.Initialize() : !nullDevice.Initialize(gpuMilliseconds)) {
+        return 1;
+    }
+    std::cout << "=== Iniciando engine headless (RHI " << device.GetBackendName() << ") ===" << std::endl;
+    D3D12Core::IRHICommandQueue* queue = device.GetQueue();
+
+    // Back buffers: vistas ficticias en la RHI nula, render targets en memoria en la software
+    uint64_t backBufferViews[HEADLESS_FRAMES_IN_FLIGHT];
+    for (uint32_t i = 0; i < HEADLESS_FRAMES_IN_FLIGHT; i++) {
+        backBufferViews[i] = software ? softwareDevice.CreateRenderTarget(width, height) : BACK_BUFFER_VIEW_BASE + i;
+    }
+    uint32_t lastFrameSlot = 0;
+
+    D3D12Core::FrameScheduler scheduler;
+    if (!scheduler.Initialize(queue, HEADLESS_FRAMES_IN_FLIGHT)) {
+        std::cerr << "Error: Failed to initialize frame scheduler" << std::endl;
+        return 1;
+    }
+
+    // Misma geometría que el cubo del ejecutable de Windows
+    std::vector<D3D12Core::Vertex> cubeVertices = {
+        {{-1.0f, -1.0f,  1.0f}, {1.0f, 0.2f, 0.2f}},
+        {{ 1.0f, -1.0f,  1.0f}, {0.2f, 1.0f, 0.2f}},
+        {{ 1.0f,  1.0f,  1.0f}, {0.2f, 0.2f, 1.0f}},
+        {{-1.0f,  1.0f,  1.0f}, {1.0f, 1.0f, 0.2f}},
+        {{ 1.0f, -1.0f, -1.0f}, {1.0f, 0.2f, 1.0f}},
+        {{-1.0f, -1.0f, -1.0f}, {0.2f, 1.0f, 1.0f}},
+        {{-1.0f,  1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}},
+        {{ 1.0f,  1.0f, -1.0f}, {0.8f, 0.8f, 0.8f}}
+    };
+    std::vector<uint32_t> cubeIndices = {
+        0, 1, 2,  2, 3, 0,
+        4, 5, 6,  6, 7, 4,
+        5, 0, 3,  3, 6, 5,
+        1, 4, 7,  7, 2, 1,
+        3, 2, 7,  7, 6, 3,
+        5, 4, 1,  1, 0, 5
+    };
+
+    // Proxy de oclusión de cada malla (por meshId) desde la misma geometría que los buffers
+    std::vector<D3D12Core::OcclusionMesh> occlusionMeshes(1);
+    if (!occlusionMeshes[0].Build(cubeVertices, cubeIndices)) {
+        return 1;
+    }
+    // Cadena de LODs de cada malla (por meshId): un único index buffer con todos los niveles,
+    // de 16 bits si el vertex buffer cabe
+    std::vector<D3D12Core::MeshLodChain> meshLods(1);
+    if (!meshLods[0].Build(cubeVertices, cubeIndices)) {
+        return 1;
+    }
+    D3D12Core::MeshOptimizer meshOptimizer;
+    if (optimizeMeshes && !meshOptimizer.Optimize(cubeVertices, meshLods[0])) {
+        return 1;
+    }
+    const std::vector<uint32_t>& cubeLodIndices = meshLods[0].GetIndices();
+    const D3D12Core::RHIFormat indexFormat = D3D12Core::MeshOptimizer::SelectIndexFormat(static_cast<uint32_t>(cubeVertices.size()));
+    std::vector<uint16_t> cubeShortIndices;
+    if (indexFormat == D3D12Core::RHIFormat::R16Uint) {
+        D3D12Core::MeshOptimizer::PackIndices16(cubeLodIndices.data(), static_cast<uint32_t>(cubeLodIndices.size()), cubeShortIndices);
+    }
+
+    // Vértices en el formato de --vertex-format: un buffer por stream
+    D3D12Core::EncodedVertices cubeEncoded;
+    if (!D3D12Core::EncodeVertices(cubeVertices.data(), static_cast<uint32_t>(cubeVertices.size()), vertexFormat, cubeEncoded)) {
+        return 1;
+    }
+    std::unique_ptr<D3D12Core::IRHIBuffer> vertexBuffers[D3D12Core::MAX_VERTEX_STREAMS];
+    for (uint32_t stream = 0; stream < vertexFormat.GetStreamCount(); stream++) {
+        D3D12Core::RHIBufferDesc vertexDesc;
+        vertexDesc.size = cubeEncoded.streams[stream].size();
+        vertexDesc.usage = D3D12Core::RHI_BUFFER_USAGE_VERTEX;
+        vertexDesc.stride = vertexFormat.GetStride(stream);
+        vertexDesc.debugName = stream == 0 ? "CubeVertices" : "CubeColors";
+        vertexBuffers[stream] = device.CreateBuffer(vertexDesc, cubeEncoded.streams[stream].data());
+        if (!vertexBuffers[stream]) {
+            std::cerr << "Error: Failed to create headless resources" << std::endl;
+            return 1;
+        }
+    }
+    D3D12Core::RHIBufferDesc indexDesc;
+    indexDesc.size = cubeLodIndices.size() * D3D12Core::GetFormatSize(indexFormat);
+    indexDesc.usage = D3D12Core::RHI_BUFFER_USAGE_INDEX;
+    indexDesc.stride = D3D12Core::GetFormatSize(indexFormat);
+    indexDesc.debugName = "CubeIndices";
+    std::unique_ptr<D3D12Core::IRHIBuffer> indexBuffer = device.CreateBuffer(indexDesc,
+        indexFormat == D3D12Core::RHIFormat::R16Uint ? static_cast<const void*>(cubeShortIndices.data()) : cubeLodIndices.data());
+
+    D3D12Core::RHIPipelineDesc pipelineDesc;
+    pipelineDesc.vertexStride = vertexFormat.GetStride(0);
+    pipelineDesc.vertexFormat = vertexFormat;
+    pipelineDesc.debugName = "Basic";
+    std::unique_ptr<D3D12Core::IRHIPipeline> pipeline = device.CreatePipeline(pipelineDesc);
+    // Variante de InstancedVS: misma geometría más el stream de InstanceData detrás de los de vértices
+    D3D12Core::RHIPipelineDesc instancedPipelineDesc = pipelineDesc;
+    instancedPipelineDesc.instanceStride = sizeof(D3D12Core::InstanceData);
+    instancedPipelineDesc.debugName = "Instanced";
+    std::unique_ptr<D3D12Core::IRHIPipeline> instancedPipeline = device.CreatePipeline(instancedPipelineDesc);
+    // Variante de IndirectVS para ExecuteIndirect: la misma geometría con los objetos en un structured buffer
+    D3D12Core::RHIPipelineDesc indirectPipelineDesc = pipelineDesc;
+    indirectPipelineDesc.objectStride = sizeof(D3D12Core::IndirectObjectData);
+    indirectPipelineDesc.debugName = "Indirect";
+    std::unique_ptr<D3D12Core::IRHIPipeline> indirectPipeline = device.CreatePipeline(indirectPipelineDesc);
+    std::unique_ptr<D3D12Core::IRHICommandList> commandList = device.CreateCommandList();
+    if (!indexBuffer || !pipeline || !instancedPipeline || !indirectPipeline || !commandList) {
+        std::cerr << "Error: Failed to create headless resources" << std::endl;
+        return 1;
+    }
+
+    // Ritmo de frames igual que en Windows; sin Present real siempre se espera al plazo
+    D3D12Core::IniFile engineIni;
+    if (!engineIni.Load("Engine.ini") && !engineIni.Load("Engine/Config/Engine.ini")) {
+        std::cerr << "Warning: Engine.ini no encontrado, usando ritmo por defecto" << std::endl;
+    }
+    D3D12Core::FramePacer framePacer;
+    framePacer.Initialize(D3D12Core::FramePacer::LoadSettings(engineIni));
+    if (paced) {
+        std::cout << "Frame pacing: " << framePacer.GetTargetFps() << " FPS" << std::endl;
+    }
+    else {
+        std::cout << "Frame pacing: desactivado (--unpaced)" << std::endl;
+    }
+
+    // Hilo de render: grafo del frame (limpieza + escena) grabado en la RHI nula
+    D3D12Core::RenderGraph renderGraph;
+    D3D12Core::NullRenderGraphBackend graphBackend;
+    D3D12Core::InstanceBatcher instanceBatcher;
+    D3D12Core::RenderQueue renderQueue;
+    uint64_t perObjectDraws = 0;
+    // Culling: AABB de mundo de los proxies y los visibles del frame (reutilizados entre frames)
+    D3D12Core::CullingBounds cullingBounds;
+    D3D12Core::FrustumCuller frustumCuller;
+    std::vector<D3D12Core::RenderProxy> visibleProxies;
+    // Occlusion culling de los visibles del frustum (depth buffer al tamaño del render)
+    D3D12Core::OcclusionCuller occlusionCuller;
+    // Models traspuestos en el orden de dibujo (un draw por objeto)
+    std::vector<D3D12Core::Float4x4> drawModels;
+    // Hilos de trabajo del render: culling, argumentos indirectos y sort de la RenderQueue
+    D3D12Core::JobSystem renderJobs;
+    // Argumentos indirectos: tabla de mallas con sus LODs (solo el cubo) y memoria reutilizada entre frames
+    D3D12Core::IndirectDrawBuilder indirectBuilder;
+    std::vector<D3D12Core::IndirectMesh> indirectMeshes(meshLods.size());
+    for (size_t mesh = 0; mesh < meshLods.size(); mesh++) {
+        indirectMeshes[mesh].lodCount = meshLods[mesh].GetLodCount();
+        indirectMeshes[mesh].quantization = cubeEncoded.quantization;
+        for (uint32_t lod = 0; lod < meshLods[mesh].GetLodCount(); lod++) {
+            indirectMeshes[mesh].lods[lod].startIndex = meshLods[mesh].GetLod(lod).startIndex;
+            indirectMeshes[mesh].lods[lod].indexCount = meshLods[mesh].GetLod(lod).indexCount;
+        }
+    }
+    std::vector<D3D12Core::IndirectObjectData> indirectObjects;
+    std::vector<D3D12Core::RHIIndirectDrawCommand> indirectCommands;
+    if (!renderJobs.Initialize()) {
+        std::cerr << "Error: Failed to initialize render workers" << std::endl;
+        return 1;
+    }
+    std::vector<double> renderCpuMs;
+    renderCpuMs.reserve(static_cast<size_t>(std::min<uint64_t>(frameLimit, 1u << 20)));
+    uint64_t graphFailures = 0;
+    uint64_t resizes = 0;
+    uint64_t materialUpdates = 0;
+    uint32_t renderWidth = 0;
+    uint32_t renderHeight = 0;
+    uint32_t appliedMaterialVersion = 0;
+
+    D3D12Core::RenderThread renderThread;
+    renderThread.Start([&](const D3D12Core::RenderSnapshot& snapshot) {
+        if (snapshot.viewportWidth == 0 || snapshot.viewportHeight == 0) {
+            return;
+        }
+        // El slot solo se espera si la GPU (simulada) sigue con el frame que lo usó
+        uint32_t frameSlot = scheduler.BeginFrame();
+        int64_t start = D3D12Core::FramePacer::Now();
+
+        if (snapshot.viewportWidth != renderWidth || snapshot.viewportHeight != renderHeight) {
+            scheduler.WaitForIdle(); // Como D3D12Core::Resize: los back buffers no pueden estar en uso
+            renderWidth = snapshot.viewportWidth;
+            renderHeight = snapshot.viewportHeight;
+            resizes++;
+            if (software) {
+                for (uint64_t view : backBufferViews) {
+                    softwareDevice.ResizeRenderTarget(view, renderWidth, renderHeight);
+                }
+            }
+            occlusionCuller.Initialize(OCCLUSION_WIDTH, std::max<uint32_t>(1, OCCLUSION_WIDTH * renderHeight / renderWidth));
+        }
+        for (const D3D12Core::MaterialProxy& materialProxy : snapshot.materials) {
+            if (materialProxy.version != appliedMaterialVersion) {
+                appliedMaterialVersion = materialProxy.version;
+                materialUpdates++;
+            }
+        }
+
+        commandList->Begin();
+        renderGraph.Reset();
+
+        D3D12Core::RenderGraphTextureDesc backBufferDesc;
+        backBufferDesc.width = renderWidth;
+        backBufferDesc.height = renderHeight;
+        backBufferDesc.clearColor[0] = 0.05f;
+        backBufferDesc.clearColor[1] = 0.05f;
+        backBufferDesc.clearColor[2] = 0.1f;
+        backBufferDesc.clearColor[3] = 1.0f;
+        D3D12Core::RenderGraphResource backBuffer = renderGraph.ImportTexture(
+            "BackBuffer", backBufferDesc, nullptr, backBufferViews[frameSlot],
+            D3D12Core::RenderGraphUsage::Present, D3D12Core::RenderGraphUsage::Present);
+
+        renderGraph.AddPass("Clear", [backBuffer](D3D12Core::RenderGraphContext& context) {
+            D3D12Core::IRHICommandList* list = static_cast<D3D12Core::IRHICommandList*>(context.commandList);
+            const D3D12Core::RenderGraph::ResourceInfo& info = context.graph->GetResource(backBuffer);
+            list->ClearRenderTarget(info.nativeView, info.desc.clearColor);
+            list->SetRenderTarget(info.nativeView);
+        }).Write(backBuffer, D3D12Core::RenderGraphUsage::RenderTarget);
+
+        renderGraph.AddPass("Scene", [&](D3D12Core::RenderGraphContext& context) {
+            D3D12Core::IRHICommandList* list = static_cast<D3D12Core::IRHICommandList*>(context.commandList);
+
+            D3D12Core::RHIViewport viewport;
+            viewport.width = static_cast<float>(renderWidth);
+            viewport.height = static_cast<float>(renderHeight);
+            D3D12Core::RHIRect scissor;
+            scissor.right = static_cast<int32_t>(renderWidth);
+            scissor.bottom = static_cast<int32_t>(renderHeight);
+            list->SetViewport(viewport);
+            list->SetScissor(scissor);
+            for (uint32_t stream = 0; stream < vertexFormat.GetStreamCount(); stream++) {
+                list->SetVertexBuffer(vertexBuffers[stream].get(), stream);
+            }
+            list->SetIndexBuffer(indexBuffer.get(), indexFormat);
+
+            // Culling: AABB de mundo de cada proxy (calculadas con su world en el hilo de juego)
+            // contra el frustum de la cámara; los caminos de envío solo ven los visibles
+            const uint32_t proxyCount = static_cast<uint32_t>(snapshot.proxies.size());
+            cullingBounds.Resize(proxyCount);
+            renderJobs.ParallelFor(proxyCount, CULLING_BATCH, [&](uint32_t begin, uint32_t end, uint32_t) {
+                for (uint32_t i = begin; i < end; i++) {
+                    cullingBounds.Set(i, snapshot.proxies[i].boundsCenter, snapshot.proxies[i].boundsExtent);
+                }
+            });
+            uint32_t visibleCount = frustumCuller.Cull(D3D12Core::CullingFrustum::FromCamera(snapshot.camera),
+                cullingBounds, &renderJobs);
+            const uint32_t* visibleIndices = frustumCuller.GetVisibleIndices();
+            if (occlusion) {
+                // Los oclusores visibles se rasterizan y el resto de candidatos se prueba contra
+                // la pirámide antes de grabar nada
+                occlusionCuller.BeginFrame(snapshot.camera, proxyCount);
+                for (uint32_t i = 0; i < visibleCount; i++) {
+                    const D3D12Core::RenderProxy& proxy = snapshot.proxies[visibleIndices[i]];
+                    if (proxy.occluder && proxy.meshId < occlusionMeshes.size()) {
+                        occlusionCuller.AddOccluder(occlusionMeshes[proxy.meshId], proxy.world, visibleIndices[i]);
+                    }
+                }
+                occlusionCuller.RenderOccluders(&renderJobs);
+                visibleCount = occlusionCuller.Test(cullingBounds, visibleIndices, visibleCount, &renderJobs);
+                visibleIndices = occlusionCuller.GetVisibleIndices();
+            }
+            visibleProxies.resize(visibleCount);
+            for (uint32_t i = 0; i < visibleCount; i++) {
+                visibleProxies[i] = snapshot.proxies[visibleIndices[i]];
+            }
+
+            MVPConstants constants;
+            constants.view = Transpose(snapshot.camera.view);
+            constants.projection = Transpose(snapshot.camera.projection);
+            std::copy(std::begin(cubeEncoded.quantization.positionScale), std::end(cubeEncoded.quantization.positionScale),
+                constants.positionScale);
+            std::copy(std::begin(cubeEncoded.quantization.positionBias), std::end(cubeEncoded.quantization.positionBias),
+                constants.positionBias);
+
+            if (indirect) {
+                // Objetos y argumentos del frame; view y projection en las constantes compartidas
+                uint32_t commandCount = indirectBuilder.Prepare(visibleProxies, indirectMeshes);
+                if (commandCount == 0) {
+                    return;
+                }
+                indirectObjects.resize(commandCount);
+                indirectCommands.resize(commandCount);
+                indirectBuilder.WriteObjects(visibleProxies, indirectObjects.data(), &renderJobs);
+                indirectBuilder.WriteCommands(indirectCommands.data(), &renderJobs);
+                uint64_t objectBytes = commandCount * sizeof(D3D12Core::IndirectObjectData);
+                uint64_t argumentAddress = device.AllocateConstants(indirectCommands.data(),
+                    commandCount * sizeof(D3D12Core::RHIIndirectDrawCommand));
+                list->SetPipeline(indirectPipeline.get());
+                list->SetConstantBuffer(0, device.AllocateConstants(&constants, sizeof(constants)));
+                list->SetObjectBuffer(device.AllocateConstants(indirectObjects.data(), objectBytes), objectBytes,
+                    sizeof(D3D12Core::IndirectObjectData));
+                for (const D3D12Core::IndirectDrawBucket& bucket : indirectBuilder.GetBuckets()) {
+                    list->ExecuteIndirect(argumentAddress + bucket.firstCommand * sizeof(D3D12Core::RHIIndirectDrawCommand),
+                        bucket.commandCount);
+                }
+                return;
+            }
+
+            if (instancing) {
+                // Un draw por (malla, LOD, material); todas las instancias del frame en una asignación
+                instanceBatcher.Build(visibleProxies);
+                const std::vector<D3D12Core::InstanceData>& instances = instanceBatcher.GetInstances();
+                if (instances.empty()) {
+                    return;
+                }
+                uint64_t instanceBytes = instances.size() * sizeof(D3D12Core::InstanceData);
+                list->SetPipeline(instancedPipeline.get());
+                list->SetConstantBuffer(0, device.AllocateConstants(&constants, sizeof(constants)));
+                list->SetInstanceBuffer(device.AllocateConstants(instances.data(), instanceBytes), instanceBytes,
+                    sizeof(D3D12Core::InstanceData));
+                for (const D3D12Core::InstanceBatch& batch : instanceBatcher.GetBatches()) {
+                    const D3D12Core::MeshLod& lod = meshLods[batch.meshId].GetLod(batch.lod);
+                    list->DrawIndexed(lod.indexCount, batch.instanceCount, lod.startIndex, 0, batch.firstInstance);
+                }
+                return;
+            }
+
+            // Un draw por objeto en el orden de la RenderQueue. Sin depth buffer la profundidad de
+            // los opacos va a 0: el sort es estable y conserva el orden de envío dentro de cada estado
+            renderQueue.Reset();
+            for (uint32_t i = 0; i < visibleCount; i++) {
+                const D3D12Core::RenderProxy& proxy = visibleProxies[i];
+                renderQueue.Add(D3D12Core::DrawSortKey::Opaque(0, 0, 0, proxy.materialId, proxy.meshId, 0.0f), i);
+            }
+            renderQueue.Sort(&renderJobs);
+            list->SetPipeline(pipeline.get());
+            const std::vector<uint32_t>& drawIndices = renderQueue.GetDrawIndices();
+            drawModels.resize(drawIndices.size());
+            D3D12Core::BatchMath::MultiplyTranspose(&visibleProxies.data()->world, sizeof(D3D12Core::RenderProxy),
+                drawIndices.data(), nullptr, drawModels.data(), sizeof(D3D12Core::Float4x4), static_cast<uint32_t>(drawIndices.size()));
+            for (size_t draw = 0; draw < drawModels.size(); draw++) {
+                const D3D12Core::RenderProxy& proxy = visibleProxies[drawIndices[draw]];
+                const D3D12Core::MeshLod& lod = meshLods[proxy.meshId].GetLod(proxy.lod);
+                constants.model = drawModels[draw];
+                list->SetConstantBuffer(0, device.AllocateConstants(&constants, sizeof(constants)));
+                list->DrawIndexed(lod.indexCount, 1, lod.startIndex, 0, 0);
+                perObjectDraws++;
+            }
+        }).ReadWrite(backBuffer, D3D12Core::RenderGraphUsage::RenderTarget);
+
+        graphBackend.SetCommandList(commandList.get());
+        if (renderGraph.Compile(graphBackend)) {
+            renderGraph.Execute(graphBackend);
+        }
+        else {
+            graphFailures++;
+        }
+        renderGraph.Reset();
+
+        commandList->Close();
+        queue->ExecuteCommandList(commandList.get());
+        scheduler.EndFrame();
+        lastFrameSlot = frameSlot;
+
+        renderCpuMs.push_back((D3D12Core::FramePacer::Now() - start) / 1000000.0);
+    });
+
+    // Bucle principal: mismo trabajo por frame que WinMain salvo el bombeo de mensajes
+    std::filesystem::file_time_type lastConfigWriteTime;
+    bool configFileExists = false;
+    std::filesystem::file_time_type lastMaterialWriteTime;
+    D3D12Core::CubeConfig config;
+    D3D12Core::LoadConfig(config);
+    D3D12Core::MaterialProxy materialParams;
+    float rotationAngle = 0.0f;
+
+    // Una entidad por objeto: el cubo original o una rejilla centrada en el plano z = 0 con cada
+    // cubo girando en su celda y un tinte por posición. Giro y escala solo se escriben cuando
+    // cambian: sin autoRotate el update de transformaciones no cuesta nada
+    D3D12Core::JobSystem updateJobs;
+    if (!updateJobs.Initialize()) {
+        std::cerr << "Error: Failed to initialize update workers" << std::endl;
+        return 1;
+    }
+    D3D12Core::EntityWorld scene;
+    D3D12Core::TransformHierarchy transforms;
+    D3D12Core::LodSelector lodSelector;
+    const uint32_t gridSide = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(objectCount))));
+    const float gridCell = 3.0f / gridSide;
+    for (uint32_t i = 0; i < objectCount; i++) {
+        D3D12Core::TransformComponent transform;
+        transform.handle = transforms.Create();
+        transforms.SetLocalBounds(transform.handle, CUBE_CENTER, CUBE_EXTENT);
+        D3D12Core::MeshRendererComponent renderer;
+        renderer.materialId = materialParams.materialId;
+        if (objectCount > 1) {
+            uint32_t column = i % gridSide;
+            uint32_t row = i / gridSide;
+            transforms.SetPosition(transform.handle, (column + 0.5f) * gridCell - 1.5f, 1.5f - (row + 0.5f) * gridCell, 0.0f);
+            renderer.customData[0] = 0.4f + 0.6f * column / gridSide;
+            renderer.customData[1] = 0.4f + 0.6f * row / gridSide;
+            renderer.customData[2] = 1.0f - 0.6f * column / gridSide;
+        }
+        D3D12Core::Entity object = scene.CreateEntity();
+        scene.AddComponent(object, transform);
+        scene.AddComponent(object, renderer);
+    }
+    if (occluders) {
+        // Dos paredes (cubos aplanados) entre la cámara y la rejilla: una tapa la mitad
+        // izquierda y otra el cuarto inferior derecho. Se crean después de la rejilla para
+        // dibujarse encima: sin depth buffer gana el último draw
+        const float walls[2][6] = {
+            { -0.8f, 0.0f, -0.5f, 0.75f, 1.6f, 0.05f },
+            { 0.8f, -0.8f, -0.5f, 0.75f, 0.75f, 0.05f }
+        };
+        for (const float* wall : walls) {
+            D3D12Core::TransformComponent transform;
+            transform.handle = transforms.Create();
+            transforms.SetLocalBounds(transform.handle, CUBE_CENTER, CUBE_EXTENT);
+            transforms.SetPosition(transform.handle, wall[0], wall[1], wall[2]);
+            transforms.SetScale(transform.handle, wall[3], wall[4], wall[5]);
+            D3D12Core::MeshRendererComponent renderer;
+            renderer.materialId = materialParams.materialId;
+            renderer.customData[0] = renderer.customData[1] = 0.45f;
+            renderer.customData[2] = 0.5f;
+            renderer.occluder = true;
+            D3D12Core::Entity object = scene.CreateEntity();
+            scene.AddComponent(object, transform);
+            scene.AddComponent(object, renderer);
+        }
+    }
+    D3D12Core::Quaternion appliedRotation;
+    float appliedScale = -1.0f;
+    std::vector<double> updateCpuMs;
+    updateCpuMs.reserve(renderCpuMs.capacity());
+    int64_t runStart = D3D12Core::FramePacer::Now();
+
+    std::cout << "=== Iniciando loop headless: " << frameLimit << " frames a " << width << "x" << height << " ===" << std::endl;
+    for (uint64_t frameNumber = 1; frameNumber <= frameLimit; frameNumber++) {
+        if (paced) {
+            framePacer.WaitForNextFrame();
+        }
+        int64_t start = D3D12Core::FramePacer::Now();
+
+        // Configuración desde el editor solo si el archivo cambió
+        std::string configPath = "Engine/Binaries/Win64/config.json";
+        std::error_code error;
+        if (std::filesystem::exists(configPath, error)) {
+            auto writeTime = std::filesystem::last_write_time(configPath, error);
+            if (!configFileExists || writeTime != lastConfigWriteTime) {
+                D3D12Core::LoadConfig(config);
+                lastConfigWriteTime = writeTime;
+                configFileExists = true;
+            }
+        }
+        else if (frameNumber % 60 == 0) {
+            D3D12Core::LoadConfig(config);
+        }
+
+        std::string materialPath = "Engine/Binaries/Win64/current_material.json";
+        if (std::filesystem::exists(materialPath, error)) {
+            auto writeTime = std::filesystem::last_write_time(materialPath, error);
+            if (writeTime != lastMaterialWriteTime) {
+                if (D3D12Core::LoadMaterialBaseColor(materialPath, materialParams.baseColor)) {
+                    materialParams.version++;
+                }
+                lastMaterialWriteTime = writeTime;
+            }
+        }
+
+        if (config.autoRotate) {
+            rotationAngle += config.rotationSpeed;
+        }
+        if (rotationAngle > 6.283185307f) {
+            rotationAngle -= 6.283185307f;
+        }
+
+        // Escala y giro del cubo original (scale * rotationX * rotationY); en la rejilla, a escala de la celda
+        float objectScale = objectCount == 1 ? config.scale : std::min(config.scale, gridCell * 0.35f);
+        D3D12Core::Quaternion rotation = D3D12Core::QuaternionMultiply(
+            D3D12Core::QuaternionRotationNormal(AXIS_X, rotationAngle * config.rotationXMultiplier),
+            D3D12Core::QuaternionRotationNormal(AXIS_Y, rotationAngle));
+        if (objectScale != appliedScale || std::memcmp(&rotation, &appliedRotation, sizeof(rotation)) != 0) {
+            scene.ForEach<const D3D12Core::TransformComponent, const D3D12Core::MeshRendererComponent>([&](D3D12Core::Entity,
+                const D3D12Core::TransformComponent& transform, const D3D12Core::MeshRendererComponent& renderer) {
+                if (renderer.occluder) {
+                    return; // Las paredes no giran
+                }
+                transforms.SetRotation(transform.handle, rotation);
+                transforms.SetScale(transform.handle, objectScale, objectScale, objectScale);
+            });
+            appliedRotation = rotation;
+            appliedScale = objectScale;
+        }
+        transforms.Update(&updateJobs);
+
+        float eye[3] = { config.cameraX, config.cameraY, config.cameraZ };
+        float focus[3] = { 0.0f, 0.0f, 0.0f };
+        float up[3] = { 0.0f, 1.0f, 0.0f };
+
+        D3D12Core::RenderSnapshot& snapshot = renderThread.BeginSnapshot();
+        snapshot.frameNumber = frameNumber;
+        snapshot.viewportWidth = width;
+        snapshot.viewportHeight = height;
+        snapshot.camera.view = LookAtLH(eye, focus, up);
+        snapshot.camera.projection = PerspectiveFovLH(config.fov, static_cast<float>(width) / height, 0.1f, 100.0f);
+        std::memcpy(snapshot.camera.position, eye, sizeof(eye));
+        snapshot.materials.push_back(materialParams);
+        // Un proxy por entidad dibujable, en el orden de la consulta, con el LOD elegido por su
+        // error en pantalla (el del frame anterior queda en el componente para la histéresis)
+        snapshot.proxies.resize(scene.Count<const D3D12Core::TransformComponent, const D3D12Core::MeshRendererComponent>());
+        lodSelector.BeginFrame(snapshot.camera, height, updateJobs.GetThreadCount());
+        scene.ParallelForEach<const D3D12Core::TransformComponent, D3D12Core::MeshRendererComponent>(&updateJobs,
+            [&](uint32_t index, uint32_t workerIndex, D3D12Core::Entity, const D3D12Core::TransformComponent& transform,
+                D3D12Core::MeshRendererComponent& renderer) {
+                D3D12Core::RenderProxy& proxy = snapshot.proxies[index];
+                proxy.meshId = renderer.meshId;
+                proxy.materialId = renderer.materialId;
+                std::memcpy(proxy.customData, renderer.customData, sizeof(proxy.customData));
+                proxy.world = transforms.GetWorld(transform.handle);
+                transforms.GetWorldBounds(transform.handle, proxy.boundsCenter, proxy.boundsExtent);
+                proxy.occluder = renderer.occluder;
+                const D3D12Core::MeshLodChain& lods = meshLods[renderer.meshId];
+                renderer.lod = lodSelector.Select(lods.GetLods(), lods.GetLodCount(), proxy.world, proxy.boundsCenter,
+                    proxy.boundsExtent, renderer.lod, workerIndex);
+                proxy.lod = renderer.lod;
+            });
+        lodSelector.EndFrame();
+        renderThread.Publish();
+
+        updateCpuMs.push_back((D3D12Core::FramePacer::Now() - start) / 1000000.0);
+
+        if (paced) {
+            framePacer.WaitForPresent();
+            framePacer.MarkPresent();
+        }
+        else {
+            // Sin ritmo, el render se saltaría casi todos los snapshots: se avanza al paso del
+            // hilo de render para medir el coste de ambos hilos en cada frame
+            while (renderThread.GetStats().rendered < frameNumber) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    renderThread.Stop();
+    scheduler.WaitForIdle();
+    double elapsedSeconds = (D3D12Core::FramePacer::Now() - runStart) / 1000000000.0;
+
+    D3D12Core::RenderThreadStats renderStats = renderThread.GetStats();
+    const D3D12Core::NullRenderGraphBackend::Stats& graphStats = graphBackend.GetStats();
+    uint64_t validationErrors = software ? softwareDevice.GetValidationErrors() : nullDevice.GetStats().validationErrors;
+
+    bool captureFailed = false;
+    if (!capturePath.empty()) {
+        const D3D12Core::SoftwareFramebuffer* frame = softwareDevice.GetRenderTarget(backBufferViews[lastFrameSlot]);
+        captureFailed = !frame || !frame->WritePPM(capturePath);
+        if (!captureFailed) {
+            std::cout << "Captura: " << capturePath << std::endl;
+        }
+    }
+
+    std::cout << "=== Coste de CPU por frame ===" << std::endl;
+    PrintTiming("Update", Summarize(updateCpuMs));
+    PrintTiming("Render", Summarize(renderCpuMs));
+    std::cout << std::setprecision(1) << "Tiempo total: " << elapsedSeconds << " s ("
+              << (elapsedSeconds > 0.0 ? frameLimit / elapsedSeconds : 0.0) << " frames/s de update)" << std::endl;
+    std::cout << "=== Render thread ===" << std::endl;
+    std::cout << "Snapshots: " << renderStats.published << " publicados, " << renderStats.rendered
+              << " renderizados, " << renderStats.dropped << " descartados" << std::endl;
+    std::cout << "Resizes: " << resizes << ", cambios de material: " << materialUpdates << std::endl;
+    std::cout << "=== Entidades ===" << std::endl;
+    std::cout << scene.BuildReport();
+    std::cout << "=== Transformaciones ===" << std::endl;
+    std::cout << transforms.BuildReport();
+    std::cout << "=== Frustum culling ===" << std::endl;
+    std::cout << frustumCuller.BuildReport();
+    if (optimizeMeshes) {
+        std::cout << "=== Optimizacion de mallas ===" << std::endl;
+        std::cout << meshOptimizer.BuildReport();
+    }
+    std::cout << "=== Formato de vertices ===" << std::endl;
+    std::cout << D3D12Core::GetVertexFormatName(vertexFormat) << ": " << vertexFormat.GetVertexSize() << " bytes por vertice ("
+              << D3D12Core::FullVertexFormat().GetVertexSize() << " en float), " << cubeEncoded.GetSize() << " bytes" << std::endl;
+    std::cout << "=== LOD ===" << std::endl;
+    std::cout << meshLods[0].BuildReport();
+    std::cout << lodSelector.BuildReport();
+    std::cout << "=== Occlusion culling ===" << std::endl;
+    if (occlusion) {
+        std::cout << occlusionCuller.BuildReport();
+    }
+    else {
+        std::cout << "Desactivado (--no-occlusion)" << std::endl;
+    }
+    std::cout << "=== Instancing ===" << std::endl;
+    if (indirect) {
+        std::cout << "Sustituido por ExecuteIndirect (--indirect):" << std::endl;
+        std::cout << indirectBuilder.BuildReport();
+    }
+    else if (instancing) {
+        std::cout << instanceBatcher.BuildReport();
+    }
+    else {
+        std::cout << "Desactivado (--no-instancing): " << perObjectDraws << " draws, uno por objeto" << std::endl;
+        std::cout << "=== Render queue ===" << std::endl;
+        std::cout << renderQueue.BuildReport();
+    }
+    std::cout << "=== Render graph ===" << std::endl;
+    std::cout << "Grafos: " << graphStats.graphs << ", pases: " << graphStats.passes << ", transiciones: "
+              << graphStats.transitions << ", errores de compilacion: " << graphFailures << std::endl;
+    if (software) {
+        std::cout << "=== RHI software ===" << std::endl;
+        std::cout << softwareDevice.BuildReport();
+    }
+    else {
+        std::cout << "=== RHI nula ===" << std::endl;
+        std::cout << nullDevice.BuildReport();
+    }
+    if (paced) {
+        std::cout << "=== Frame pacing ===" << std::endl;
+        std::cout << framePacer.BuildReport();
+    }
+
+    scheduler.Shutdown();
+    commandList.reset();
+    instancedPipeline.reset();
+    pipeline.reset();
+    indexBuffer.reset();
+    for (std::unique_ptr<D3D12Core::IRHIBuffer>& vertexBuffer : vertexBuffers) {
+        vertexBuffer.reset();
+    }
+    softwareDevice.Shutdown();
+    nullDevice.Shutdown();
+
+    // Fallo si el uso de la RHI o del grafo no sería válido con una API real
+    return (validationErrors == 0 && graphFailures == 0 && !captureFailed) ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+#include "IndirectDrawBuilder.h"
+#include "BatchMath.h"
+#include <algorithm>
+#include <sstream>
+
+namespace D3D12Core {
+
+    uint32_t IndirectDrawBuilder::Prepare(const std::vector<RenderProxy>& proxies, const std::vector<IndirectMesh>& meshes) {
+        m_bucketIndices.clear();
+        m_buckets.clear();
+        m_proxyBuckets.resize(proxies.size());
+
+        // Primera pasada: bucket de cada proxy y tamaño de cada bucket. Los objetos de un mismo
+        // material suelen llegar seguidos: solo se consulta el mapa cuando el material cambia
+        uint64_t skipped = 0;
+        uint32_t lastMaterial = 0;
+        uint32_t lastBucket = UINT32_MAX;
+        for (size_t i = 0; i < proxies.size(); i++) {
+            const RenderProxy& proxy = proxies[i];
+            if (proxy.meshId >= meshes.size() || meshes[proxy.meshId].lodCount == 0 || meshes[proxy.meshId].lods[0].indexCount == 0) {
+                m_proxyBuckets[i] = UINT32_MAX;
+                skipped++;
+                continue;
+            }
+            if (lastBucket == UINT32_MAX || proxy.materialId != lastMaterial) {
+                auto inserted = m_bucketIndices.emplace(proxy.materialId, static_cast<uint32_t>(m_buckets.size()));
+                if (inserted.second) {
+                    IndirectDrawBucket bucket;
+                    bucket.materialId = proxy.materialId;
+                    m_buckets.push_back(bucket);
+                }
+                lastMaterial = proxy.materialId;
+                lastBucket = inserted.first->second;
+            }
+            m_buckets[lastBucket].commandCount++;
+            m_proxyBuckets[i] = lastBucket;
+        }
+
+        // Segunda pasada: cada bucket ocupa un rango contiguo de comandos
+        m_bucketCursors.resize(m_buckets.size());
+        uint32_t commandCount = 0;
+        for (size_t b = 0; b < m_buckets.size(); b++) {
+            m_buckets[b].firstCommand = commandCount;
+            m_bucketCursors[b] = commandCount;
+            commandCount += m_buckets[b].commandCount;
+        }
+        m_commandProxies.resize(commandCount);
+        m_commandRanges.resize(commandCount);
+        m_meshQuantizations.resize(meshes.size());
+        for (size_t m = 0; m < meshes.size(); m++) {
+            m_meshQuantizations[m] = meshes[m].quantization;
+        }
+        for (size_t i = 0; i < proxies.size(); i++) {
+            if (m_proxyBuckets[i] == UINT32_MAX) {
+                continue;
+            }
+            uint32_t command = m_bucketCursors[m_proxyBuckets[i]]++;
+            m_commandProxies[command] = static_cast<uint32_t>(i);
+            const IndirectMesh& mesh = meshes[proxies[i].meshId];
+            m_commandRanges[command] = mesh.lods[std::min(proxies[i].lod, mesh.lodCount - 1)];
+        }
+
+        m_stats.frames++;
+        m_stats.objects += proxies.size();
+        m_stats.commands += commandCount;
+        m_stats.buckets += m_buckets.size();
+        m_stats.skipped += skipped;
+        m_stats.lastCommands = commandCount;
+        m_stats.lastBuckets = m_buckets.size();
+        return commandCount;
+    }
+
+    void IndirectDrawBuilder::WriteObjects(const std::vector<RenderProxy>& proxies, IndirectObjectData* objects, JobSystem* jobs) const {
+        JobSystem::ParallelFor(jobs, GetCommandCount(), WRITE_BATCH, [&](uint32_t begin, uint32_t end, uint32_t) {
+            // Models traspuestos en lote, leídos de los proxies y escritos directamente en los objetos
+            BatchMath::MultiplyTranspose(&proxies.data()->world, sizeof(RenderProxy), m_commandProxies.data() + begin,
+                nullptr, &objects[begin].model, sizeof(IndirectObjectData), end - begin);
+            for (uint32_t i = begin; i < end; i++) {
+                IndirectObjectData& destination = objects[i];
+                const VertexQuantization& quantization = m_meshQuantizations[proxies[m_commandProxies[i]].meshId];
+                for (int axis = 0; axis < 3; axis++) {
+                    destination.positionScale[axis] = quantization.positionScale[axis];
+                    destination.positionBias[axis] = quantization.positionBias[axis];
+                }
+                destination.positionScale[3] = 0.0f;
+                destination.positionBias[3] = 0.0f;
+            }
+        });
+    }
+
+    void IndirectDrawBuilder::WriteCommands(RHIIndirectDrawCommand* commands, JobSystem* jobs) const {
+        JobSystem::ParallelFor(jobs, GetCommandCount(), WRITE_BATCH, [&](uint32_t begin, uint32_t end, uint32_t) {
+            for (uint32_t i = begin; i < end; i++) {
+                const IndirectMeshRange& range = m_commandRanges[i];
+                RHIIndirectDrawCommand& command = commands[i];
+                command.drawIndex = i;
+                command.indexCount = range.indexCount;
+                command.instanceCount = 1;
+                command.startIndex = range.startIndex;
+                command.baseVertex = range.baseVertex;
+                command.startInstance = 0;
+            }
+        });
+    }
+
+    std::string IndirectDrawBuilder::BuildReport() const {
+        std::ostringstream report;
+        report << "Objetos: " << m_stats.objects << ", comandos indirectos: " << m_stats.commands << " en "
+               << m_stats.buckets << " ExecuteIndirect (omitidos " << m_stats.skipped << ")\n";
+        report << "Ultimo frame: " << m_stats.lastCommands << " comandos -> " << m_stats.lastBuckets << " ExecuteIndirect\n";
+        return report.str();
+    }
+
+} // namespace D3D12Core
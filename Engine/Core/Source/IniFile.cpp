@@ -0,0 +1,131 @@
+#include "IniFile.h"
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace D3D12Core {
+
+    namespace {
+
+        std::string Trim(const std::string& text) {
+            size_t first = 0;
+            while (first < text.size() && std::isspace(static_cast<unsigned char>(text[first]))) {
+                ++first;
+            }
+            size_t last = text.size();
+            while (last > first && std::isspace(static_cast<unsigned char>(text[last - 1]))) {
+                --last;
+            }
+            return text.substr(first, last - first);
+        }
+
+    } // namespace
+
+    IniFile::IniFile() {
+    }
+
+    std::string IniFile::ToLower(const std::string& text) {
+        std::string lower = text;
+        for (char& c : lower) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return lower;
+    }
+
+    bool IniFile::Load(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return Parse(buffer.str());
+    }
+
+    bool IniFile::Parse(const std::string& text) {
+        std::istringstream stream(text);
+        std::string line;
+        std::string section;
+        while (std::getline(stream, line)) {
+            line = Trim(line);
+            if (line.empty() || line[0] == '#' || line[0] == ';') {
+                continue;
+            }
+
+            if (line[0] == '[') {
+                size_t close = line.find(']');
+                if (close == std::string::npos) {
+                    return false;
+                }
+                section = ToLower(Trim(line.substr(1, close - 1)));
+                m_sections[section];
+                continue;
+            }
+
+            size_t equals = line.find('=');
+            if (equals == std::string::npos) {
+                continue; // Línea sin clave: se ignora como hace el editor
+            }
+            std::string key = ToLower(Trim(line.substr(0, equals)));
+            if (!key.empty()) {
+                m_sections[section][key] = Trim(line.substr(equals + 1));
+            }
+        }
+        return true;
+    }
+
+    const std::string* IniFile::Find(const std::string& section, const std::string& key) const {
+        auto sectionIt = m_sections.find(ToLower(section));
+        if (sectionIt == m_sections.end()) {
+            return nullptr;
+        }
+        auto keyIt = sectionIt->second.find(ToLower(key));
+        return keyIt != sectionIt->second.end() ? &keyIt->second : nullptr;
+    }
+
+    bool IniFile::HasKey(const std::string& section, const std::string& key) const {
+        return Find(section, key) != nullptr;
+    }
+
+    std::string IniFile::GetString(const std::string& section, const std::string& key, const std::string& defaultValue) const {
+        const std::string* value = Find(section, key);
+        return value ? *value : defaultValue;
+    }
+
+    int IniFile::GetInt(const std::string& section, const std::string& key, int defaultValue) const {
+        const std::string* value = Find(section, key);
+        if (!value || value->empty()) {
+            return defaultValue;
+        }
+        char* end = nullptr;
+        long parsed = std::strtol(value->c_str(), &end, 10);
+        return (end && *end == '\0') ? static_cast<int>(parsed) : defaultValue;
+    }
+
+    double IniFile::GetDouble(const std::string& section, const std::string& key, double defaultValue) const {
+        const std::string* value = Find(section, key);
+        if (!value || value->empty()) {
+            return defaultValue;
+        }
+        char* end = nullptr;
+        double parsed = std::strtod(value->c_str(), &end);
+        return (end && *end == '\0') ? parsed : defaultValue;
+    }
+
+    bool IniFile::GetBool(const std::string& section, const std::string& key, bool defaultValue) const {
+        const std::string* value = Find(section, key);
+        if (!value) {
+            return defaultValue;
+        }
+        std::string lower = ToLower(*value);
+        if (lower == "true" || lower == "1" || lower == "yes" || lower == "on") {
+            return true;
+        }
+        if (lower == "false" || lower == "0" || lower == "no" || lower == "off") {
+            return false;
+        }
+        return defaultValue;
+    }
+
+} // namespace D3D12Core
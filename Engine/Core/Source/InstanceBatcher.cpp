@@ -0,0 +1,64 @@
+#include "InstanceBatcher.h"
+#include <sstream>
+
+namespace D3D12Core {
+
+    void InstanceBatcher::Build(const std::vector<RenderProxy>& proxies) {
+        m_batchIndices.clear();
+        m_batches.clear();
+        m_proxyBatches.resize(proxies.size());
+        m_instances.resize(proxies.size());
+
+        // Primera pasada: batch de cada proxy y tamaño de cada batch
+        for (size_t i = 0; i < proxies.size(); i++) {
+            const RenderProxy& proxy = proxies[i];
+            uint64_t key = ((static_cast<uint64_t>(proxy.meshId) * MAX_MESH_LODS + proxy.lod) << 32) | proxy.materialId;
+            auto inserted = m_batchIndices.emplace(key, static_cast<uint32_t>(m_batches.size()));
+            if (inserted.second) {
+                InstanceBatch batch;
+                batch.meshId = proxy.meshId;
+                batch.lod = proxy.lod;
+                batch.materialId = proxy.materialId;
+                m_batches.push_back(batch);
+            }
+            uint32_t batchIndex = inserted.first->second;
+            m_batches[batchIndex].instanceCount++;
+            m_proxyBatches[i] = batchIndex;
+        }
+
+        // Segunda pasada: cada batch ocupa un rango contiguo del buffer de instancias
+        m_batchCursors.resize(m_batches.size());
+        uint32_t firstInstance = 0;
+        for (size_t b = 0; b < m_batches.size(); b++) {
+            m_batches[b].firstInstance = firstInstance;
+            m_batchCursors[b] = firstInstance;
+            firstInstance += m_batches[b].instanceCount;
+        }
+        for (size_t i = 0; i < proxies.size(); i++) {
+            InstanceData& instance = m_instances[m_batchCursors[m_proxyBatches[i]]++];
+            instance.world = proxies[i].world;
+            for (int k = 0; k < 4; k++) {
+                instance.customData[k] = proxies[i].customData[k];
+            }
+        }
+
+        m_stats.frames++;
+        m_stats.objects += proxies.size();
+        m_stats.drawCalls += m_batches.size();
+        m_stats.lastObjects = proxies.size();
+        m_stats.lastDrawCalls = m_batches.size();
+    }
+
+    std::string InstanceBatcher::BuildReport() const {
+        std::ostringstream report;
+        double reduction = m_stats.objects > 0
+            ? 100.0 * static_cast<double>(m_stats.GetDrawCallsSaved()) / static_cast<double>(m_stats.objects) : 0.0;
+        report.setf(std::ios::fixed);
+        report.precision(1);
+        report << "Objetos: " << m_stats.objects << ", draws instanciados: " << m_stats.drawCalls << " (ahorrados "
+               << m_stats.GetDrawCallsSaved() << ", " << reduction << "% menos draws)\n";
+        report << "Ultimo frame: " << m_stats.lastObjects << " objetos -> " << m_stats.lastDrawCalls << " draws\n";
+        return report.str();
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,136 @@
+#include "JobSystem.h"
+
+namespace D3D12Core {
+
+    JobSystem::JobSystem() {
+    }
+
+    JobSystem::~JobSystem() {
+        Shutdown();
+    }
+
+    bool JobSystem::Initialize(uint32_t workerCount) {
+        if (m_running) {
+            return true;
+        }
+
+        if (workerCount == 0) {
+            uint32_t hardwareThreads = std::thread::hardware_concurrency();
+            workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+        }
+
+        m_running = true;
+        m_workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i) {
+            m_workers.emplace_back(&JobSystem::WorkerMain, this, i + 1);
+        }
+
+        return true;
+    }
+
+    void JobSystem::Shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_running) {
+                return;
+            }
+            m_running = false;
+        }
+        m_jobAvailable.notify_all();
+
+        for (std::thread& worker : m_workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        m_workers.clear();
+    }
+
+    void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const RangeFunction& function) {
+        if (count == 0) {
+            return;
+        }
+        if (batchSize == 0) {
+            batchSize = 1;
+        }
+
+        // Sin hilos auxiliares (o trabajo de un solo lote) no compensa despertar a nadie
+        if (m_workers.empty() || count <= batchSize) {
+            RunInline(count, batchSize, function);
+            return;
+        }
+
+        std::lock_guard<std::mutex> dispatchLock(m_dispatchMutex);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_function = &function;
+            m_count = count;
+            m_batchSize = batchSize;
+            m_nextBatch.store(0);
+            m_activeWorkers = static_cast<uint32_t>(m_workers.size());
+            m_generation++;
+        }
+        m_jobAvailable.notify_all();
+
+        RunBatches(0);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_jobFinished.wait(lock, [&]() { return m_activeWorkers == 0; });
+        m_function = nullptr;
+    }
+
+    void JobSystem::ParallelFor(JobSystem* jobs, uint32_t count, uint32_t batchSize, const RangeFunction& function) {
+        if (jobs) {
+            jobs->ParallelFor(count, batchSize, function);
+        }
+        else if (count > 0) {
+            RunInline(count, batchSize > 0 ? batchSize : 1, function);
+        }
+    }
+
+    void JobSystem::RunInline(uint32_t count, uint32_t batchSize, const RangeFunction& function) {
+        for (uint32_t begin = 0; begin < count; begin += batchSize) {
+            uint32_t end = (begin + batchSize < count) ? begin + batchSize : count;
+            function(begin, end, 0);
+        }
+    }
+
+    void JobSystem::WorkerMain(uint32_t workerIndex) {
+        uint64_t seenGeneration = 0;
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_jobAvailable.wait(lock, [&]() { return !m_running || m_generation != seenGeneration; });
+                if (!m_running) {
+                    return;
+                }
+                seenGeneration = m_generation;
+            }
+
+            RunBatches(workerIndex);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_activeWorkers--;
+            }
+            m_jobFinished.notify_one();
+        }
+    }
+
+    void JobSystem::RunBatches(uint32_t workerIndex) {
+        const uint32_t batchCount = (m_count + m_batchSize - 1) / m_batchSize;
+
+        while (true) {
+            uint32_t batch = m_nextBatch.fetch_add(1);
+            if (batch >= batchCount) {
+                break;
+            }
+
+            uint32_t begin = batch * m_batchSize;
+            uint32_t end = (begin + m_batchSize < m_count) ? begin + m_batchSize : m_count;
+            (*m_function)(begin, end, workerIndex);
+        }
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,48 @@
+#include "LinearAllocator.h"
+
+namespace D3D12Core {
+
+    LinearAllocator::LinearAllocator() {
+    }
+
+    void LinearAllocator::Initialize(uint64_t baseOffset, uint64_t capacity) {
+        m_baseOffset = baseOffset;
+        m_capacity = capacity;
+        Reset();
+    }
+
+    uint64_t LinearAllocator::Allocate(uint64_t size, uint64_t alignment) {
+        if (alignment == 0) {
+            alignment = 1;
+        }
+
+        // La alineación se calcula sobre el offset absoluto (p. ej. 256 bytes para CBVs)
+        uint64_t current = m_offset.load(std::memory_order_relaxed);
+        while (true) {
+            uint64_t absolute = m_baseOffset + current;
+            uint64_t aligned = (absolute + alignment - 1) & ~(alignment - 1);
+            uint64_t next = (aligned - m_baseOffset) + size;
+
+            if (next > m_capacity) {
+                m_failedCount.fetch_add(1, std::memory_order_relaxed);
+                return INVALID_OFFSET;
+            }
+
+            if (m_offset.compare_exchange_weak(current, next, std::memory_order_relaxed)) {
+                m_allocationCount.fetch_add(1, std::memory_order_relaxed);
+                return aligned;
+            }
+        }
+    }
+
+    void LinearAllocator::Reset() {
+        m_offset.store(0, std::memory_order_relaxed);
+        m_allocationCount.store(0, std::memory_order_relaxed);
+        m_failedCount.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t LinearAllocator::GetUsedBytes() const {
+        return m_offset.load(std::memory_order_relaxed);
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,675 @@
+#include "MeshLod.h"
+#include "FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+namespace D3D12Core {
+
+    namespace {
+
+        // Posición (normalizada a [-1, 1]) y color (por el peso del color) de cada vértice
+        constexpr uint32_t ATTRIBUTES = 6;
+        constexpr uint32_t QUADRIC_TERMS = ATTRIBUTES * (ATTRIBUTES + 1) / 2;
+        // Peso de los planos que sujetan el borde frente a los de las caras (por longitud al cuadrado)
+        constexpr float BORDER_WEIGHT = 10.0f;
+        // Coseno mínimo entre la normal de un triángulo antes y después de un colapso
+        constexpr float FLIP_COSINE = 0.25f;
+        // Un nivel que no baja de este porcentaje del anterior no se guarda y cierra la cadena
+        constexpr float MIN_LEVEL_REDUCTION = 0.9f;
+        // Aristas ordenadas por pasada, en múltiplos de los triángulos que faltan por quitar
+        constexpr uint32_t CANDIDATES_PER_TRIANGLE = 2;
+        constexpr uint32_t MIN_CANDIDATES = 1024;
+
+        // Cuádrica en 6 dimensiones: x^T A x + 2 b^T x + c, con A simétrica guardada por filas
+        // desde la diagonal y los términos de fuera de ella ya multiplicados por 2
+        struct Quadric {
+            float a[QUADRIC_TERMS] = {};
+            float b[ATTRIBUTES] = {};
+            float c = 0.0f;
+        };
+
+        // Cuádrica solo de posición (distancia a los planos de las caras): da el error geométrico
+        struct PlaneQuadric {
+            float a[6] = {};  // xx, xy, xz, yy, yz, zz
+            float b[3] = {};
+            float c = 0.0f;
+            float weight = 0.0f;
+        };
+
+        void Add(Quadric& target, const Quadric& source) {
+            for (uint32_t i = 0; i < QUADRIC_TERMS; i++) target.a[i] += source.a[i];
+            for (uint32_t i = 0; i < ATTRIBUTES; i++) target.b[i] += source.b[i];
+            target.c += source.c;
+        }
+
+        void Add(PlaneQuadric& target, const PlaneQuadric& source) {
+            for (uint32_t i = 0; i < 6; i++) target.a[i] += source.a[i];
+            for (uint32_t i = 0; i < 3; i++) target.b[i] += source.b[i];
+            target.c += source.c;
+            target.weight += source.weight;
+        }
+
+        float Evaluate(const Quadric& quadric, const float* v) {
+            float result = quadric.c;
+            uint32_t term = 0;
+            for (uint32_t i = 0; i < ATTRIBUTES; i++) {
+                float row = quadric.a[term++] * v[i];
+                for (uint32_t j = i + 1; j < ATTRIBUTES; j++) {
+                    row += quadric.a[term++] * v[j];
+                }
+                result += v[i] * (row + 2.0f * quadric.b[i]);
+            }
+            return result;
+        }
+
+        float Evaluate(const PlaneQuadric& quadric, const float* v) {
+            const float* a = quadric.a;
+            return v[0] * (a[0] * v[0] + 2.0f * (a[1] * v[1] + a[2] * v[2] + quadric.b[0])) +
+                v[1] * (a[3] * v[1] + 2.0f * (a[4] * v[2] + quadric.b[1])) +
+                v[2] * (a[5] * v[2] + 2.0f * quadric.b[2]) + quadric.c;
+        }
+
+        // Plano n·x + d = 0 (n unitaria) con peso, en la parte de posición de la cuádrica
+        void AddPlane(Quadric& quadric, const float n[3], float d, float weight) {
+            const uint32_t diagonal[3] = { 0, ATTRIBUTES, 2 * ATTRIBUTES - 1 };
+            for (uint32_t i = 0; i < 3; i++) {
+                for (uint32_t j = i; j < 3; j++) {
+                    quadric.a[diagonal[i] + j - i] += (i == j ? 1.0f : 2.0f) * weight * n[i] * n[j];
+                }
+                quadric.b[i] += weight * d * n[i];
+            }
+            quadric.c += weight * d * d;
+        }
+
+        // area: lo que aporta al peso con el que se normaliza el error (0 en los planos del borde)
+        void AddPlane(PlaneQuadric& plane, const float n[3], float d, float weight, float area) {
+            const float terms[6] = { n[0] * n[0], n[0] * n[1], n[0] * n[2], n[1] * n[1], n[1] * n[2], n[2] * n[2] };
+            for (uint32_t i = 0; i < 6; i++) plane.a[i] += weight * terms[i];
+            for (uint32_t i = 0; i < 3; i++) plane.b[i] += weight * d * n[i];
+            plane.c += weight * d * d;
+            plane.weight += area;
+        }
+
+        // Cuádrica de la distancia al plano del triángulo en el espacio de posición y color:
+        // A = I - e1 e1^T - e2 e2^T con e1, e2 una base ortonormal del triángulo
+        void AddTriangle(Quadric& quadric, const float* p0, const float* p1, const float* p2, float weight) {
+            float e1[ATTRIBUTES], e2[ATTRIBUTES];
+            float length1 = 0.0f;
+            for (uint32_t i = 0; i < ATTRIBUTES; i++) {
+                e1[i] = p1[i] - p0[i];
+                length1 += e1[i] * e1[i];
+            }
+            if (length1 <= 0.0f) {
+                return;
+            }
+            length1 = 1.0f / std::sqrt(length1);
+            float along = 0.0f;
+            for (uint32_t i = 0; i < ATTRIBUTES; i++) {
+                e1[i] *= length1;
+                along += (p2[i] - p0[i]) * e1[i];
+            }
+            float length2 = 0.0f;
+            for (uint32_t i = 0; i < ATTRIBUTES; i++) {
+                e2[i] = p2[i] - p0[i] - along * e1[i];
+                length2 += e2[i] * e2[i];
+            }
+            if (length2 <= 0.0f) {
+                return;
+            }
+            length2 = 1.0f / std::sqrt(length2);
+            float p0e1 = 0.0f, p0e2 = 0.0f, p0p0 = 0.0f;
+            for (uint32_t i = 0; i < ATTRIBUTES; i++) {
+                e2[i] *= length2;
+                p0e1 += p0[i] * e1[i];
+                p0e2 += p0[i] * e2[i];
+                p0p0 += p0[i] * p0[i];
+            }
+            uint32_t term = 0;
+            for (uint32_t i = 0; i < ATTRIBUTES; i++) {
+                for (uint32_t j = i; j < ATTRIBUTES; j++) {
+                    quadric.a[term++] += i == j ? weight * (1.0f - e1[i] * e1[i] - e2[i] * e2[i]) :
+                        -2.0f * weight * (e1[i] * e1[j] + e2[i] * e2[j]);
+                }
+                quadric.b[i] += weight * (p0e1 * e1[i] + p0e2 * e2[i] - p0[i]);
+            }
+            quadric.c += weight * (p0p0 - p0e1 * p0e1 - p0e2 * p0e2);
+        }
+
+        void Cross(const float a[3], const float b[3], float result[3]) {
+            result[0] = a[1] * b[2] - a[2] * b[1];
+            result[1] = a[2] * b[0] - a[0] * b[2];
+            result[2] = a[0] * b[1] - a[1] * b[0];
+        }
+
+        float Dot(const float a[3], const float b[3]) {
+            return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        }
+
+        struct Collapse {
+            uint32_t from;
+            uint32_t to;
+            float cost;
+            float error;   // Error geométrico (RMS de la distancia a los planos), normalizado
+        };
+
+        // Estado de la simplificación de una malla: triángulos actuales, atributos y cuádricas
+        class Simplifier {
+        public:
+            Simplifier(const std::vector<float>& attributes, std::vector<Quadric>& quadrics, std::vector<PlaneQuadric>& planes,
+                const std::vector<uint8_t>& locked, const std::vector<uint8_t>& border)
+                : m_attributes(attributes), m_quadrics(quadrics), m_planes(planes), m_locked(locked), m_border(border) {
+                const size_t vertexCount = locked.size();
+                m_touched.resize(vertexCount);
+                m_remap.resize(vertexCount);
+                std::iota(m_remap.begin(), m_remap.end(), 0u);
+                m_offsets.resize(vertexCount + 1);
+                m_selfCost.resize(vertexCount);
+                m_selfDistance.resize(vertexCount);
+            }
+
+            // Colapsa hasta dejar como mucho targetTriangles o quedarse sin colapsos válidos con
+            // error geométrico <= errorLimit. Devuelve el error máximo de los colapsos aplicados
+            float SimplifyTo(std::vector<uint32_t>& indices, uint32_t targetTriangles, float errorLimit, uint32_t& passes,
+                uint32_t& collapses) {
+                float maxError = 0.0f;
+                while (indices.size() / 3 > targetTriangles) {
+                    passes++;
+                    uint32_t applied = Pass(indices, targetTriangles, errorLimit, maxError);
+                    if (applied == 0) {
+                        break;
+                    }
+                    collapses += applied;
+                }
+                return maxError;
+            }
+
+        private:
+            const float* Position(uint32_t vertex) const { return &m_attributes[vertex * ATTRIBUTES]; }
+
+            // Triángulos de u que también usan v (2 en una arista interior, 1 en el borde)
+            uint32_t SharedTriangles(const std::vector<uint32_t>& indices, uint32_t u, uint32_t v) const {
+                uint32_t shared = 0;
+                for (uint32_t k = m_offsets[u]; k < m_offsets[u + 1]; k++) {
+                    const uint32_t* triangle = &indices[m_triangles[k] * 3];
+                    shared += (triangle[0] == v || triangle[1] == v || triangle[2] == v) ? 1 : 0;
+                }
+                return shared;
+            }
+
+            bool CanCollapse(const std::vector<uint32_t>& indices, uint32_t from, uint32_t to) const {
+                if (m_locked[from]) {
+                    return false;
+                }
+                return !m_border[from] || SharedTriangles(indices, from, to) == 1;
+            }
+
+            // Las cuádricas se suman: el coste en v es el de la cuádrica de u en v más el de la de v
+            // en su propia posición, que se calcula una vez por pasada
+            Collapse Evaluate(uint32_t from, uint32_t to) const {
+                const float* target = Position(to);
+                Collapse collapse;
+                collapse.from = from;
+                collapse.to = to;
+                collapse.cost = std::max(0.0f, D3D12Core::Evaluate(m_quadrics[from], target) + m_selfCost[to]);
+                float weight = m_planes[from].weight + m_planes[to].weight;
+                float distance = std::max(0.0f, D3D12Core::Evaluate(m_planes[from], target) + m_selfDistance[to]);
+                collapse.error = weight > 0.0f ? std::sqrt(distance / weight) : 0.0f;
+                return collapse;
+            }
+
+            // Algún triángulo de from (que no desaparece) gira demasiado o usa un vértice que ya
+            // se movió en esta pasada
+            bool Rejected(const std::vector<uint32_t>& indices, uint32_t from, uint32_t to) const {
+                const float* target = Position(to);
+                const float* source = Position(from);
+                for (uint32_t k = m_offsets[from]; k < m_offsets[from + 1]; k++) {
+                    const uint32_t* triangle = &indices[m_triangles[k] * 3];
+                    if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+                        continue;
+                    }
+                    uint32_t corner = triangle[0] == from ? 0 : (triangle[1] == from ? 1 : 2);
+                    uint32_t b = triangle[(corner + 1) % 3];
+                    uint32_t c = triangle[(corner + 2) % 3];
+                    if (m_remap[b] != b || m_remap[c] != c) {
+                        return true;
+                    }
+                    const float* pb = Position(b);
+                    const float* pc = Position(c);
+                    float before[2][3], after[2][3];
+                    for (int i = 0; i < 3; i++) {
+                        before[0][i] = pb[i] - source[i];
+                        before[1][i] = pc[i] - source[i];
+                        after[0][i] = pb[i] - target[i];
+                        after[1][i] = pc[i] - target[i];
+                    }
+                    float normalBefore[3], normalAfter[3];
+                    Cross(before[0], before[1], normalBefore);
+                    Cross(after[0], after[1], normalAfter);
+                    float cosine = Dot(normalBefore, normalAfter);
+                    if (cosine <= FLIP_COSINE * std::sqrt(Dot(normalBefore, normalBefore) * Dot(normalAfter, normalAfter))) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void BuildAdjacency(const std::vector<uint32_t>& indices) {
+                std::fill(m_offsets.begin(), m_offsets.end(), 0u);
+                for (uint32_t index : indices) {
+                    m_offsets[index + 1]++;
+                }
+                for (size_t v = 1; v < m_offsets.size(); v++) {
+                    m_offsets[v] += m_offsets[v - 1];
+                }
+                m_triangles.resize(indices.size());
+                m_cursors.assign(m_offsets.begin(), m_offsets.end() - 1);
+                for (uint32_t i = 0; i < indices.size(); i++) {
+                    m_triangles[m_cursors[indices[i]]++] = i / 3;
+                }
+            }
+
+            uint32_t Pass(std::vector<uint32_t>& indices, uint32_t targetTriangles, float errorLimit, float& maxError) {
+                BuildAdjacency(indices);
+                for (size_t v = 0; v < m_selfCost.size(); v++) {
+                    if (m_offsets[v + 1] > m_offsets[v]) {
+                        m_selfCost[v] = D3D12Core::Evaluate(m_quadrics[v], Position(static_cast<uint32_t>(v)));
+                        m_selfDistance[v] = D3D12Core::Evaluate(m_planes[v], Position(static_cast<uint32_t>(v)));
+                    }
+                }
+                const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+                // Cada arista una vez (desde el triángulo donde va de menor a mayor, o desde el
+                // único que la tiene si es de borde) con su sentido de colapso más barato
+                m_candidates.clear();
+                for (uint32_t t = 0; t < triangleCount; t++) {
+                    for (uint32_t e = 0; e < 3; e++) {
+                        uint32_t a = indices[t * 3 + e];
+                        uint32_t b = indices[t * 3 + (e + 1) % 3];
+                        if (a > b && (!m_border[a] || SharedTriangles(indices, a, b) != 1)) {
+                            continue;
+                        }
+                        bool forward = CanCollapse(indices, a, b);
+                        bool backward = CanCollapse(indices, b, a);
+                        if (!forward && !backward) {
+                            continue;
+                        }
+                        Collapse collapse = forward ? Evaluate(a, b) : Evaluate(b, a);
+                        if (forward && backward) {
+                            Collapse reverse = Evaluate(b, a);
+                            if (reverse.cost < collapse.cost) {
+                                collapse = reverse;
+                            }
+                        }
+                        m_candidates.push_back(collapse);
+                    }
+                }
+                if (m_candidates.empty()) {
+                    return 0;
+                }
+                const uint32_t toRemove = triangleCount - targetTriangles;
+                const size_t sorted = std::min(m_candidates.size(), static_cast<size_t>(std::max(MIN_CANDIDATES, toRemove * CANDIDATES_PER_TRIANGLE)));
+                auto byCost = [](const Collapse& left, const Collapse& right) { return left.cost < right.cost; };
+                std::nth_element(m_candidates.begin(), m_candidates.begin() + (sorted - 1), m_candidates.end(), byCost);
+                std::sort(m_candidates.begin(), m_candidates.begin() + sorted, byCost);
+
+                // Los más baratos primero; cada colapso bloquea su entorno hasta la pasada siguiente
+                std::fill(m_touched.begin(), m_touched.end(), static_cast<uint8_t>(0));
+                uint32_t removed = 0;
+                uint32_t applied = 0;
+                for (size_t i = 0; i < sorted && removed < toRemove; i++) {
+                    const Collapse& collapse = m_candidates[i];
+                    if (m_touched[collapse.from] || m_touched[collapse.to] || collapse.error > errorLimit ||
+                        Rejected(indices, collapse.from, collapse.to)) {
+                        continue;
+                    }
+                    removed += SharedTriangles(indices, collapse.from, collapse.to);
+                    m_remap[collapse.from] = collapse.to;
+                    Add(m_quadrics[collapse.to], m_quadrics[collapse.from]);
+                    Add(m_planes[collapse.to], m_planes[collapse.from]);
+                    for (uint32_t k = m_offsets[collapse.from]; k < m_offsets[collapse.from + 1]; k++) {
+                        const uint32_t* triangle = &indices[m_triangles[k] * 3];
+                        m_touched[triangle[0]] = m_touched[triangle[1]] = m_touched[triangle[2]] = 1;
+                    }
+                    m_touched[collapse.to] = 1;
+                    maxError = std::max(maxError, collapse.error);
+                    applied++;
+                }
+                if (applied == 0) {
+                    return 0;
+                }
+
+                // Aplicar: los triángulos que pierden un vértice desaparecen, el resto conserva su orden
+                size_t write = 0;
+                for (size_t read = 0; read < indices.size(); read += 3) {
+                    uint32_t a = m_remap[indices[read]];
+                    uint32_t b = m_remap[indices[read + 1]];
+                    uint32_t c = m_remap[indices[read + 2]];
+                    if (a == b || b == c || c == a) {
+                        continue;
+                    }
+                    indices[write++] = a;
+                    indices[write++] = b;
+                    indices[write++] = c;
+                }
+                indices.resize(write);
+                std::iota(m_remap.begin(), m_remap.end(), 0u);
+                return applied;
+            }
+
+            const std::vector<float>& m_attributes;
+            std::vector<Quadric>& m_quadrics;
+            std::vector<PlaneQuadric>& m_planes;
+            const std::vector<uint8_t>& m_locked;
+            const std::vector<uint8_t>& m_border;
+            std::vector<uint8_t> m_touched;
+            std::vector<uint32_t> m_remap;
+            std::vector<uint32_t> m_offsets;    // Triángulos de cada vértice (CSR)
+            std::vector<uint32_t> m_cursors;
+            std::vector<uint32_t> m_triangles;
+            std::vector<Collapse> m_candidates;
+            std::vector<float> m_selfCost;      // Cuádrica de cada vértice en su posición
+            std::vector<float> m_selfDistance;
+        };
+
+    } // namespace
+
+    bool MeshLodChain::Build(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const MeshLodSettings& settings) {
+        m_indices.clear();
+        m_lods.clear();
+        m_stats = MeshLodBuildStats();
+        if (vertices.empty() || indices.empty() || indices.size() % 3 != 0) {
+            std::cerr << "Error: MeshLodChain::Build necesita vertices y triangulos completos" << std::endl;
+            return false;
+        }
+        const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+        for (uint32_t index : indices) {
+            if (index >= vertexCount) {
+                std::cerr << "Error: MeshLodChain::Build con un indice fuera del vertex buffer" << std::endl;
+                return false;
+            }
+        }
+        int64_t start = FramePacer::Now();
+
+        // Posición normalizada a [-1, 1] (el error no depende de la escala de la malla) y color
+        float minimum[3], maximum[3];
+        for (int axis = 0; axis < 3; axis++) {
+            minimum[axis] = maximum[axis] = vertices[0].position[axis];
+        }
+        for (const Vertex& vertex : vertices) {
+            for (int axis = 0; axis < 3; axis++) {
+                minimum[axis] = std::min(minimum[axis], vertex.position[axis]);
+                maximum[axis] = std::max(maximum[axis], vertex.position[axis]);
+            }
+        }
+        float center[3];
+        float scale = 0.0f;
+        for (int axis = 0; axis < 3; axis++) {
+            center[axis] = 0.5f * (minimum[axis] + maximum[axis]);
+            scale = std::max(scale, 0.5f * (maximum[axis] - minimum[axis]));
+        }
+        if (scale <= 0.0f) {
+            scale = 1.0f;
+        }
+        std::vector<float> attributes(static_cast<size_t>(vertexCount) * ATTRIBUTES);
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            for (int axis = 0; axis < 3; axis++) {
+                attributes[v * ATTRIBUTES + axis] = (vertices[v].position[axis] - center[axis]) / scale;
+                attributes[v * ATTRIBUTES + 3 + axis] = vertices[v].color[axis] * settings.colorWeight;
+            }
+        }
+
+        // Triángulos de trabajo sin los degenerados
+        std::vector<uint32_t> current;
+        current.reserve(indices.size());
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            if (indices[i] != indices[i + 1] && indices[i + 1] != indices[i + 2] && indices[i + 2] != indices[i]) {
+                current.insert(current.end(), { indices[i], indices[i + 1], indices[i + 2] });
+            }
+        }
+        const uint32_t triangleCount = static_cast<uint32_t>(current.size() / 3);
+
+        // Costuras: vértices usados con la misma posición que otro (distinto color) quedan fijos
+        std::vector<uint8_t> locked(vertexCount, 0);
+        std::vector<uint8_t> border(vertexCount, 0);
+        std::vector<uint8_t> used(vertexCount, 0);
+        for (uint32_t index : current) {
+            used[index] = 1;
+        }
+        std::vector<uint32_t> order;
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            if (used[v]) {
+                order.push_back(v);
+            }
+        }
+        auto samePosition = [&](uint32_t a, uint32_t b) {
+            return std::equal(vertices[a].position, vertices[a].position + 3, vertices[b].position);
+        };
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return std::lexicographical_compare(vertices[a].position, vertices[a].position + 3, vertices[b].position, vertices[b].position + 3);
+        });
+        for (size_t i = 1; i < order.size(); i++) {
+            if (samePosition(order[i - 1], order[i])) {
+                locked[order[i - 1]] = locked[order[i]] = 1;
+            }
+        }
+
+        // Aristas por clave (menor, mayor): una sola vez es borde; más de dos, no manifold (fija)
+        struct EdgeUse {
+            uint64_t key;
+            uint32_t triangle;
+        };
+        std::vector<EdgeUse> edges(current.size());
+        for (uint32_t t = 0; t < triangleCount; t++) {
+            for (uint32_t e = 0; e < 3; e++) {
+                uint32_t a = current[t * 3 + e];
+                uint32_t b = current[t * 3 + (e + 1) % 3];
+                edges[t * 3 + e] = { (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b), t };
+            }
+        }
+        std::sort(edges.begin(), edges.end(), [](const EdgeUse& a, const EdgeUse& b) { return a.key < b.key; });
+
+        // Cuádricas: cada triángulo pesa por su área (en el espacio normalizado)
+        std::vector<Quadric> quadrics(vertexCount);
+        std::vector<PlaneQuadric> planes(vertexCount);
+        auto triangleNormal = [&](uint32_t t, float normal[3]) {
+            const float* p0 = &attributes[current[t * 3] * ATTRIBUTES];
+            const float* p1 = &attributes[current[t * 3 + 1] * ATTRIBUTES];
+            const float* p2 = &attributes[current[t * 3 + 2] * ATTRIBUTES];
+            float u[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+            float v[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+            Cross(u, v, normal);
+            float length = std::sqrt(Dot(normal, normal));
+            if (length > 0.0f) {
+                for (int i = 0; i < 3; i++) normal[i] /= length;
+            }
+            return 0.5f * length;
+        };
+        for (uint32_t t = 0; t < triangleCount; t++) {
+            float normal[3];
+            float area = triangleNormal(t, normal);
+            if (area <= 0.0f) {
+                continue;
+            }
+            const float* p[3];
+            for (int k = 0; k < 3; k++) {
+                p[k] = &attributes[current[t * 3 + k] * ATTRIBUTES];
+            }
+            Quadric face;
+            AddTriangle(face, p[0], p[1], p[2], area);
+            PlaneQuadric plane;
+            AddPlane(plane, normal, -Dot(normal, p[0]), area, area);
+            for (int k = 0; k < 3; k++) {
+                Add(quadrics[current[t * 3 + k]], face);
+                Add(planes[current[t * 3 + k]], plane);
+            }
+        }
+        for (size_t first = 0; first < edges.size();) {
+            size_t last = first + 1;
+            while (last < edges.size() && edges[last].key == edges[first].key) {
+                last++;
+            }
+            uint32_t a = static_cast<uint32_t>(edges[first].key >> 32);
+            uint32_t b = static_cast<uint32_t>(edges[first].key & 0xFFFFFFFFu);
+            if (last - first > 2) {
+                locked[a] = locked[b] = 1;
+            }
+            else if (last - first == 1) {
+                // Plano perpendicular a la cara por la arista del borde
+                border[a] = border[b] = 1;
+                float normal[3];
+                triangleNormal(edges[first].triangle, normal);
+                const float* pa = &attributes[a * ATTRIBUTES];
+                const float* pb = &attributes[b * ATTRIBUTES];
+                float edge[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+                float lengthSquared = Dot(edge, edge);
+                float side[3];
+                Cross(edge, normal, side);
+                float sideLength = std::sqrt(Dot(side, side));
+                if (sideLength > 0.0f) {
+                    for (int i = 0; i < 3; i++) side[i] /= sideLength;
+                    float weight = BORDER_WEIGHT * lengthSquared;
+                    for (uint32_t vertex : { a, b }) {
+                        AddPlane(quadrics[vertex], side, -Dot(side, pa), weight);
+                        AddPlane(planes[vertex], side, -Dot(side, pa), weight, 0.0f);
+                    }
+                }
+            }
+            first = last;
+        }
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            m_stats.lockedVertices += locked[v];
+            m_stats.borderVertices += (border[v] && !locked[v]) ? 1 : 0;
+        }
+
+        // Nivel 0: la malla tal cual; cada nivel parte del anterior
+        m_indices = indices;
+        m_lods.push_back({ 0, static_cast<uint32_t>(indices.size()), 0.0f });
+        const uint32_t maxLods = std::min(std::max(settings.maxLods, 1u), MAX_MESH_LODS);
+        const float errorLimit = settings.maxError;
+        Simplifier simplifier(attributes, quadrics, planes, locked, border);
+        float chainError = 0.0f;
+        uint32_t previousTriangles = triangleCount;
+        while (m_lods.size() < maxLods && previousTriangles > settings.minTriangles) {
+            uint32_t target = std::max(settings.minTriangles, static_cast<uint32_t>(previousTriangles * settings.reduction));
+            float error = simplifier.SimplifyTo(current, target, errorLimit, m_stats.passes, m_stats.collapses);
+            uint32_t remaining = static_cast<uint32_t>(current.size() / 3);
+            if (remaining > previousTriangles * MIN_LEVEL_REDUCTION) {
+                break;
+            }
+            chainError = std::max(chainError, error);
+            m_lods.push_back({ static_cast<uint32_t>(m_indices.size()), static_cast<uint32_t>(current.size()), chainError * scale });
+            m_indices.insert(m_indices.end(), current.begin(), current.end());
+            previousTriangles = remaining;
+        }
+
+        m_stats.vertices = vertexCount;
+        m_stats.triangles = static_cast<uint32_t>(indices.size() / 3);
+        m_stats.buildMs = (FramePacer::Now() - start) / 1000000.0;
+        return true;
+    }
+
+    std::string MeshLodChain::BuildReport() const {
+        std::ostringstream report;
+        report.setf(std::ios::fixed);
+        report.precision(4);
+        report << "Vertices: " << m_stats.vertices << " (" << m_stats.lockedVertices << " fijos, " << m_stats.borderVertices
+               << " de borde), niveles: " << m_lods.size() << "\n";
+        for (size_t lod = 0; lod < m_lods.size(); lod++) {
+            report << "  LOD " << lod << ": " << m_lods[lod].indexCount / 3 << " triangulos, error " << m_lods[lod].error << "\n";
+        }
+        report.precision(3);
+        report << "Pasadas: " << m_stats.passes << ", colapsos: " << m_stats.collapses << ", " << m_stats.buildMs << " ms\n";
+        return report.str();
+    }
+
+    void LodSelector::BeginFrame(const CameraProxy& camera, uint32_t viewportHeight, uint32_t workerCount) {
+        for (int axis = 0; axis < 3; axis++) {
+            m_cameraPosition[axis] = camera.position[axis];
+        }
+        // Proyección perspectiva LH: m[1][1] = cot(fovY / 2), near = -m[3][2] / m[2][2]
+        m_pixelsPerUnit = 0.5f * static_cast<float>(viewportHeight) * camera.projection.m[1][1];
+        m_nearDistance = camera.projection.m[2][2] != 0.0f ? -camera.projection.m[3][2] / camera.projection.m[2][2] : 0.0f;
+        m_nearDistance = std::max(m_nearDistance, 1e-3f);
+        m_workerStats.assign(std::max(workerCount, 1u), LodSelectionStats());
+    }
+
+    uint32_t LodSelector::Select(const MeshLod* lods, uint32_t lodCount, const Float4x4& world, const float boundsCenter[3],
+        const float boundsExtent[3], uint32_t currentLod, uint32_t worker) {
+        if (lodCount == 0 || worker >= m_workerStats.size()) {
+            return 0;
+        }
+        // Escala máxima de la matriz de mundo (longitud de sus filas) y distancia al punto más
+        // cercano de la esfera que envuelve la AABB
+        float scaleSquared = 0.0f;
+        for (int row = 0; row < 3; row++) {
+            scaleSquared = std::max(scaleSquared, world.m[row][0] * world.m[row][0] + world.m[row][1] * world.m[row][1] +
+                world.m[row][2] * world.m[row][2]);
+        }
+        float offset[3], radiusSquared = 0.0f;
+        for (int axis = 0; axis < 3; axis++) {
+            offset[axis] = boundsCenter[axis] - m_cameraPosition[axis];
+            radiusSquared += boundsExtent[axis] * boundsExtent[axis];
+        }
+        float distance = std::max(std::sqrt(Dot(offset, offset)) - std::sqrt(radiusSquared), m_nearDistance);
+        const float pixelsPerError = m_pixelsPerUnit * std::sqrt(scaleSquared) / distance;
+
+        uint32_t lod = std::min(currentLod, lodCount - 1);
+        while (lod > 0 && lods[lod].error * pixelsPerError > m_settings.pixelError) {
+            lod--;
+        }
+        const float coarserLimit = m_settings.pixelError * (1.0f - m_settings.hysteresis);
+        while (lod + 1 < lodCount && lods[lod + 1].error * pixelsPerError <= coarserLimit) {
+            lod++;
+        }
+
+        LodSelectionStats& stats = m_workerStats[worker];
+        stats.selections++;
+        stats.switches += lod != currentLod ? 1 : 0;
+        stats.triangles += lods[lod].indexCount / 3;
+        stats.fullTriangles += lods[0].indexCount / 3;
+        stats.lastLevels[lod]++;
+        return lod;
+    }
+
+    void LodSelector::EndFrame() {
+        m_stats.frames++;
+        m_stats.lastSelections = 0;
+        m_stats.lastSwitches = 0;
+        std::fill(std::begin(m_stats.lastLevels), std::end(m_stats.lastLevels), 0ull);
+        for (const LodSelectionStats& stats : m_workerStats) {
+            m_stats.selections += stats.selections;
+            m_stats.switches += stats.switches;
+            m_stats.triangles += stats.triangles;
+            m_stats.fullTriangles += stats.fullTriangles;
+            m_stats.lastSelections += stats.selections;
+            m_stats.lastSwitches += stats.switches;
+            for (uint32_t lod = 0; lod < MAX_MESH_LODS; lod++) {
+                m_stats.lastLevels[lod] += stats.lastLevels[lod];
+            }
+        }
+    }
+
+    std::string LodSelector::BuildReport() const {
+        std::ostringstream report;
+        report.setf(std::ios::fixed);
+        report.precision(1);
+        double perFrame = m_stats.frames > 0 ? static_cast<double>(m_stats.switches) / static_cast<double>(m_stats.frames) : 0.0;
+        double kept = m_stats.fullTriangles > 0 ? 100.0 * static_cast<double>(m_stats.triangles) / static_cast<double>(m_stats.fullTriangles) : 0.0;
+        report << "Umbral: " << m_settings.pixelError << " px, histeresis " << 100.0 * m_settings.hysteresis << "%\n";
+        report << "Selecciones: " << m_stats.selections << ", cambios de nivel: " << m_stats.switches << " (" << perFrame
+               << " por frame)\n";
+        report << "Triangulos: " << m_stats.triangles << " de " << m_stats.fullTriangles << " (" << kept << "%)\n";
+        report << "Ultimo frame por nivel:";
+        for (uint32_t lod = 0; lod < MAX_MESH_LODS; lod++) {
+            if (m_stats.lastLevels[lod] > 0) {
+                report << " " << lod << ": " << m_stats.lastLevels[lod];
+            }
+        }
+        report << "\n";
+        return report.str();
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,463 @@
+#include "MeshOptimizer.h"
+#include "FramePacer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+namespace D3D12Core {
+
+    namespace {
+
+        constexpr uint32_t FETCH_LINE_SIZE = 64;        // Bytes por línea de la caché de vértices
+        constexpr uint32_t FETCH_CACHE_LINES = 64;      // 4 KB con reemplazo FIFO
+        constexpr uint32_t OVERDRAW_RESOLUTION = 256;   // Píxeles por lado de cada vista del análisis
+
+        // Triángulos de cada vértice (CSR): los de v en triangles[offsets[v], offsets[v + 1])
+        struct TriangleAdjacency {
+            std::vector<uint32_t> offsets;
+            std::vector<uint32_t> triangles;
+
+            void Build(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount) {
+                offsets.assign(vertexCount + 1, 0);
+                for (uint32_t i = 0; i < indexCount; i++) {
+                    offsets[indices[i] + 1]++;
+                }
+                std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+                triangles.resize(indexCount);
+                std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+                for (uint32_t i = 0; i < indexCount; i++) {
+                    triangles[cursor[indices[i]]++] = i / 3;
+                }
+            }
+        };
+
+        // Caché FIFO por marcas de tiempo: un vértice sigue dentro mientras hayan entrado como
+        // mucho cacheSize vértices después de él. Devuelve los fallos del triángulo
+        uint32_t UpdateCache(const uint32_t* triangle, uint32_t cacheSize, std::vector<uint32_t>& cacheTime, uint32_t& time) {
+            uint32_t misses = 0;
+            for (int corner = 0; corner < 3; corner++) {
+                const uint32_t vertex = triangle[corner];
+                if (time - cacheTime[vertex] > cacheSize) {
+                    cacheTime[vertex] = time++;
+                    misses++;
+                }
+            }
+            return misses;
+        }
+
+        // Tipsify (Sander, Nehab y Barczak, 2007): emite todos los triángulos pendientes del
+        // vértice de abanico y salta al vecino recién emitido que seguirá en caché después de
+        // emitir los suyos, el más antiguo de ellos. Sin candidato vuelve al último vértice
+        // emitido con triángulos pendientes (pila de callejones) o al siguiente en orden
+        void OptimizeVertexCache(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount, uint32_t cacheSize,
+            uint32_t* output) {
+            TriangleAdjacency adjacency;
+            adjacency.Build(indices, indexCount, vertexCount);
+            std::vector<uint32_t> live(vertexCount);
+            for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+                live[vertex] = adjacency.offsets[vertex + 1] - adjacency.offsets[vertex];
+            }
+            std::vector<uint32_t> cacheTime(vertexCount, 0);
+            std::vector<uint8_t> emitted(indexCount / 3, 0);
+            std::vector<uint32_t> deadEnd;
+            deadEnd.reserve(indexCount);
+            std::vector<uint32_t> candidates;
+            uint32_t time = cacheSize + 1;
+            uint32_t cursor = 0;
+            uint32_t written = 0;
+
+            auto skipDeadEnd = [&]() {
+                while (!deadEnd.empty()) {
+                    const uint32_t vertex = deadEnd.back();
+                    deadEnd.pop_back();
+                    if (live[vertex] > 0) {
+                        return vertex;
+                    }
+                }
+                for (; cursor < vertexCount; cursor++) {
+                    if (live[cursor] > 0) {
+                        return cursor;
+                    }
+                }
+                return UINT32_MAX;
+            };
+
+            uint32_t fan = skipDeadEnd();
+            while (fan != UINT32_MAX) {
+                candidates.clear();
+                for (uint32_t k = adjacency.offsets[fan]; k < adjacency.offsets[fan + 1]; k++) {
+                    const uint32_t triangle = adjacency.triangles[k];
+                    if (emitted[triangle]) {
+                        continue;
+                    }
+                    emitted[triangle] = 1;
+                    for (int corner = 0; corner < 3; corner++) {
+                        const uint32_t vertex = indices[triangle * 3 + corner];
+                        output[written++] = vertex;
+                        deadEnd.push_back(vertex);
+                        candidates.push_back(vertex);
+                        live[vertex]--;
+                        if (time - cacheTime[vertex] > cacheSize) {
+                            cacheTime[vertex] = time++;
+                        }
+                    }
+                }
+                // Prioridad: edad en caché si sus triángulos pendientes (hasta 2 vértices nuevos
+                // cada uno) no lo van a expulsar; si no, 0
+                uint32_t next = UINT32_MAX;
+                int64_t bestPriority = -1;
+                for (uint32_t vertex : candidates) {
+                    if (live[vertex] == 0) {
+                        continue;
+                    }
+                    const uint32_t age = time - cacheTime[vertex];
+                    const int64_t priority = age + 2 * live[vertex] <= cacheSize ? age : 0;
+                    if (priority > bestPriority) {
+                        bestPriority = priority;
+                        next = vertex;
+                    }
+                }
+                fan = next != UINT32_MAX ? next : skipDeadEnd();
+            }
+        }
+
+        // Corta el orden de la caché en clusters y los ordena de fuera hacia dentro (Tipsify,
+        // sección de overdraw). Cortes duros donde un triángulo falla sus tres vértices (el
+        // orden salta a otra zona) y, dentro de cada uno, cortes blandos en cuanto el ACMR
+        // desde el último corte baja de threshold veces el del cluster duro. Cada cluster se
+        // puntúa con el producto de su normal media por la posición de su centroide respecto al
+        // de la malla: los que miran hacia fuera desde lejos del centro tapan a los demás y van antes
+        uint32_t OptimizeOverdraw(const std::vector<Vertex>& vertices, const uint32_t* indices, uint32_t indexCount,
+            uint32_t cacheSize, float threshold, uint32_t* output) {
+            const uint32_t triangleCount = indexCount / 3;
+            const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+            std::vector<uint32_t> cacheTime(vertexCount, 0);
+            uint32_t time = cacheSize + 1;
+
+            std::vector<uint32_t> hard;
+            for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+                if (UpdateCache(indices + triangle * 3, cacheSize, cacheTime, time) == 3 || triangle == 0) {
+                    hard.push_back(triangle);
+                }
+            }
+            std::vector<uint32_t> clusters;
+            for (size_t h = 0; h < hard.size(); h++) {
+                const uint32_t start = hard[h];
+                const uint32_t end = h + 1 < hard.size() ? hard[h + 1] : triangleCount;
+                time += cacheSize + 1; // Caché vacía
+                uint32_t clusterMisses = 0;
+                for (uint32_t triangle = start; triangle < end; triangle++) {
+                    clusterMisses += UpdateCache(indices + triangle * 3, cacheSize, cacheTime, time);
+                }
+                const float target = threshold * clusterMisses / static_cast<float>(end - start);
+                clusters.push_back(start);
+                time += cacheSize + 1;
+                uint32_t misses = 0;
+                uint32_t triangles = 0;
+                for (uint32_t triangle = start; triangle < end; triangle++) {
+                    misses += UpdateCache(indices + triangle * 3, cacheSize, cacheTime, time);
+                    triangles++;
+                    if (misses <= target * triangles) {
+                        clusters.push_back(triangle + 1);
+                        time += cacheSize + 1;
+                        misses = triangles = 0;
+                    }
+                }
+                if (clusters.back() == end) {
+                    clusters.pop_back(); // El último corte blando cae en el siguiente duro
+                }
+            }
+
+            // Centroide de la malla (por índice) y, por cluster, centroide y normal ponderados por área
+            double meshCentroid[3] = { 0.0, 0.0, 0.0 };
+            for (uint32_t i = 0; i < indexCount; i++) {
+                for (int axis = 0; axis < 3; axis++) {
+                    meshCentroid[axis] += vertices[indices[i]].position[axis];
+                }
+            }
+            for (double& value : meshCentroid) {
+                value /= std::max(indexCount, 1u);
+            }
+            const uint32_t clusterCount = static_cast<uint32_t>(clusters.size());
+            std::vector<float> scores(clusterCount);
+            for (uint32_t c = 0; c < clusterCount; c++) {
+                const uint32_t start = clusters[c];
+                const uint32_t end = c + 1 < clusterCount ? clusters[c + 1] : triangleCount;
+                double centroid[3] = { 0.0, 0.0, 0.0 };
+                double normal[3] = { 0.0, 0.0, 0.0 };
+                double area = 0.0;
+                for (uint32_t triangle = start; triangle < end; triangle++) {
+                    const float* p0 = vertices[indices[triangle * 3 + 0]].position;
+                    const float* p1 = vertices[indices[triangle * 3 + 1]].position;
+                    const float* p2 = vertices[indices[triangle * 3 + 2]].position;
+                    const double e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+                    const double e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+                    const double n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+                    const double triangleArea = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                    for (int axis = 0; axis < 3; axis++) {
+                        centroid[axis] += triangleArea * (p0[axis] + p1[axis] + p2[axis]) / 3.0;
+                        normal[axis] += n[axis];
+                    }
+                    area += triangleArea;
+                }
+                const double normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+                double score = 0.0;
+                if (area > 0.0 && normalLength > 0.0) {
+                    for (int axis = 0; axis < 3; axis++) {
+                        score += (centroid[axis] / area - meshCentroid[axis]) * normal[axis] / normalLength;
+                    }
+                }
+                scores[c] = static_cast<float>(score);
+            }
+            std::vector<uint32_t> order(clusterCount);
+            std::iota(order.begin(), order.end(), 0u);
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return scores[a] > scores[b]; });
+            uint32_t written = 0;
+            for (uint32_t c : order) {
+                const uint32_t start = clusters[c] * 3;
+                const uint32_t end = c + 1 < clusterCount ? clusters[c + 1] * 3 : indexCount;
+                std::copy(indices + start, indices + end, output + written);
+                written += end - start;
+            }
+            return clusterCount;
+        }
+
+    } // namespace
+
+    bool MeshOptimizer::Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, const MeshLod* ranges,
+        uint32_t rangeCount, const MeshOptimizerSettings& settings) {
+        MeshLod whole;
+        whole.indexCount = static_cast<uint32_t>(indices.size());
+        if (!ranges || rangeCount == 0) {
+            ranges = &whole;
+            rangeCount = 1;
+        }
+        if (vertices.empty() || indices.empty() || indices.size() % 3 != 0 || settings.cacheSize < 3) {
+            std::cerr << "Error: MeshOptimizer::Optimize necesita vertices, triangulos completos y una cache de 3 o mas" << std::endl;
+            return false;
+        }
+        const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+        for (uint32_t index : indices) {
+            if (index >= vertexCount) {
+                std::cerr << "Error: MeshOptimizer::Optimize con un indice fuera del vertex buffer" << std::endl;
+                return false;
+            }
+        }
+        for (uint32_t r = 0; r < rangeCount; r++) {
+            if (ranges[r].indexCount % 3 != 0 || static_cast<uint64_t>(ranges[r].startIndex) + ranges[r].indexCount > indices.size()) {
+                std::cerr << "Error: MeshOptimizer::Optimize con un rango fuera del index buffer" << std::endl;
+                return false;
+            }
+        }
+
+        m_stats = MeshOptimizerStats();
+        m_stats.cacheSize = settings.cacheSize;
+        m_stats.ranges = rangeCount;
+        const MeshLod first = ranges[0];
+        m_stats.cacheBefore = AnalyzeVertexCache(indices.data() + first.startIndex, first.indexCount, vertexCount, settings.cacheSize);
+        m_stats.fetchBefore = AnalyzeVertexFetch(indices.data() + first.startIndex, first.indexCount, vertexCount, sizeof(Vertex));
+        m_stats.overdrawBefore = AnalyzeOverdraw(vertices, indices.data() + first.startIndex, first.indexCount);
+
+        const int64_t start = FramePacer::Now();
+        std::vector<uint32_t> cacheOrder;
+        for (uint32_t r = 0; r < rangeCount; r++) {
+            uint32_t* rangeIndices = indices.data() + ranges[r].startIndex;
+            const uint32_t count = ranges[r].indexCount;
+            if (count == 0) {
+                continue;
+            }
+            cacheOrder.resize(count);
+            OptimizeVertexCache(rangeIndices, count, vertexCount, settings.cacheSize, cacheOrder.data());
+            if (settings.overdraw) {
+                m_stats.clusters += OptimizeOverdraw(vertices, cacheOrder.data(), count, settings.cacheSize,
+                    settings.overdrawThreshold, rangeIndices);
+            }
+            else {
+                std::copy(cacheOrder.begin(), cacheOrder.end(), rangeIndices);
+            }
+        }
+        if (settings.vertexFetch) {
+            // Orden de primer uso en el index buffer (el primer rango manda); los no usados desaparecen
+            std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+            uint32_t used = 0;
+            for (uint32_t& index : indices) {
+                if (remap[index] == UINT32_MAX) {
+                    remap[index] = used++;
+                }
+                index = remap[index];
+            }
+            std::vector<Vertex> remapped(used);
+            for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+                if (remap[vertex] != UINT32_MAX) {
+                    remapped[remap[vertex]] = vertices[vertex];
+                }
+            }
+            vertices.swap(remapped);
+            m_stats.verticesRemoved = vertexCount - used;
+        }
+        m_stats.optimizeMs = (FramePacer::Now() - start) / 1000000.0;
+
+        const uint32_t newVertexCount = static_cast<uint32_t>(vertices.size());
+        m_stats.cacheAfter = AnalyzeVertexCache(indices.data() + first.startIndex, first.indexCount, newVertexCount, settings.cacheSize);
+        m_stats.fetchAfter = AnalyzeVertexFetch(indices.data() + first.startIndex, first.indexCount, newVertexCount, sizeof(Vertex));
+        m_stats.overdrawAfter = AnalyzeOverdraw(vertices, indices.data() + first.startIndex, first.indexCount);
+        m_stats.indexFormat = SelectIndexFormat(newVertexCount);
+        return true;
+    }
+
+    bool MeshOptimizer::Optimize(std::vector<Vertex>& vertices, MeshLodChain& lods, const MeshOptimizerSettings& settings) {
+        return Optimize(vertices, lods.m_indices, lods.m_lods.data(), lods.GetLodCount(), settings);
+    }
+
+    VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+        uint32_t cacheSize) {
+        VertexCacheStats stats;
+        stats.triangles = indexCount / 3;
+        std::vector<uint32_t> cacheTime(vertexCount, 0);
+        std::vector<uint8_t> used(vertexCount, 0);
+        uint32_t time = cacheSize + 1;
+        for (uint32_t triangle = 0; triangle < stats.triangles; triangle++) {
+            stats.transformed += UpdateCache(indices + triangle * 3, cacheSize, cacheTime, time);
+        }
+        for (uint32_t i = 0; i < stats.triangles * 3; i++) {
+            stats.vertices += used[indices[i]] ? 0 : 1;
+            used[indices[i]] = 1;
+        }
+        stats.acmr = stats.triangles > 0 ? static_cast<float>(stats.transformed) / stats.triangles : 0.0f;
+        stats.atvr = stats.vertices > 0 ? static_cast<float>(stats.transformed) / stats.vertices : 0.0f;
+        return stats;
+    }
+
+    VertexFetchStats MeshOptimizer::AnalyzeVertexFetch(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+        uint32_t vertexSize) {
+        VertexFetchStats stats;
+        const uint64_t lineCount = (static_cast<uint64_t>(vertexCount) * vertexSize + FETCH_LINE_SIZE - 1) / FETCH_LINE_SIZE;
+        std::vector<uint32_t> lineTime(lineCount, 0);
+        std::vector<uint8_t> used(vertexCount, 0);
+        uint32_t time = FETCH_CACHE_LINES + 1;
+        uint32_t usedVertices = 0;
+        for (uint32_t i = 0; i < indexCount; i++) {
+            const uint32_t vertex = indices[i];
+            usedVertices += used[vertex] ? 0 : 1;
+            used[vertex] = 1;
+            const uint64_t address = static_cast<uint64_t>(vertex) * vertexSize;
+            for (uint64_t line = address / FETCH_LINE_SIZE; line <= (address + vertexSize - 1) / FETCH_LINE_SIZE; line++) {
+                if (time - lineTime[line] > FETCH_CACHE_LINES) {
+                    lineTime[line] = time++;
+                    stats.bytesFetched += FETCH_LINE_SIZE;
+                }
+            }
+        }
+        stats.overfetch = usedVertices > 0 ? static_cast<float>(stats.bytesFetched) / (static_cast<float>(usedVertices) * vertexSize) : 0.0f;
+        return stats;
+    }
+
+    OverdrawStats MeshOptimizer::AnalyzeOverdraw(const std::vector<Vertex>& vertices, const uint32_t* indices, uint32_t indexCount) {
+        OverdrawStats stats;
+        if (indexCount < 3) {
+            return stats;
+        }
+        float minimum[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float maximum[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (uint32_t i = 0; i < indexCount; i++) {
+            for (int axis = 0; axis < 3; axis++) {
+                minimum[axis] = std::min(minimum[axis], vertices[indices[i]].position[axis]);
+                maximum[axis] = std::max(maximum[axis], vertices[indices[i]].position[axis]);
+            }
+        }
+        const float extent = std::max({ maximum[0] - minimum[0], maximum[1] - minimum[1], maximum[2] - minimum[2], 1e-20f });
+        const float scale = (OVERDRAW_RESOLUTION - 1) / extent;
+
+        // Vista ortográfica por cada eje y sentido: depth test LESS y solo las caras que miran a la cámara
+        std::vector<float> depth(OVERDRAW_RESOLUTION * OVERDRAW_RESOLUTION);
+        for (int axis = 0; axis < 3; axis++) {
+            const int u = (axis + 1) % 3;
+            const int v = (axis + 2) % 3;
+            for (float side : { 1.0f, -1.0f }) {
+                std::fill(depth.begin(), depth.end(), FLT_MAX);
+                for (uint32_t triangle = 0; triangle < indexCount / 3; triangle++) {
+                    float x[3], y[3], z[3];
+                    for (int corner = 0; corner < 3; corner++) {
+                        const float* position = vertices[indices[triangle * 3 + corner]].position;
+                        x[corner] = (position[u] - minimum[u]) * scale;
+                        y[corner] = (position[v] - minimum[v]) * scale;
+                        z[corner] = side * position[axis];
+                    }
+                    // Componente de la normal (e1 x e2) en el eje de la vista: la cara mira a la
+                    // cámara si apunta contra la dirección de visión (side)
+                    const float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+                    if (area * side >= 0.0f) {
+                        continue;
+                    }
+                    if (area > 0.0f) {
+                        std::swap(x[1], x[2]);
+                        std::swap(y[1], y[2]);
+                        std::swap(z[1], z[2]);
+                    }
+                    const float invArea = 1.0f / std::fabs(area);
+                    const int minX = std::max(0, static_cast<int>(std::ceil(std::min({ x[0], x[1], x[2] }) - 0.5f)));
+                    const int maxX = std::min(static_cast<int>(OVERDRAW_RESOLUTION) - 1,
+                        static_cast<int>(std::floor(std::max({ x[0], x[1], x[2] }) - 0.5f)));
+                    const int minY = std::max(0, static_cast<int>(std::ceil(std::min({ y[0], y[1], y[2] }) - 0.5f)));
+                    const int maxY = std::min(static_cast<int>(OVERDRAW_RESOLUTION) - 1,
+                        static_cast<int>(std::floor(std::max({ y[0], y[1], y[2] }) - 0.5f)));
+                    for (int py = minY; py <= maxY; py++) {
+                        for (int px = minX; px <= maxX; px++) {
+                            const float cx = px + 0.5f;
+                            const float cy = py + 0.5f;
+                            // Tras el cambio de orden el triángulo va en sentido horario en (x, y):
+                            // las tres funciones de arista son negativas o cero dentro
+                            const float w0 = (x[2] - x[1]) * (cy - y[1]) - (y[2] - y[1]) * (cx - x[1]);
+                            const float w1 = (x[0] - x[2]) * (cy - y[2]) - (y[0] - y[2]) * (cx - x[2]);
+                            const float w2 = (x[1] - x[0]) * (cy - y[0]) - (y[1] - y[0]) * (cx - x[0]);
+                            if (w0 > 0.0f || w1 > 0.0f || w2 > 0.0f) {
+                                continue;
+                            }
+                            const float pixelDepth = (w0 * z[0] + w1 * z[1] + w2 * z[2]) * -invArea;
+                            float& stored = depth[py * OVERDRAW_RESOLUTION + px];
+                            if (pixelDepth < stored) {
+                                stored = pixelDepth;
+                                stats.shaded++;
+                            }
+                        }
+                    }
+                }
+                for (float value : depth) {
+                    stats.covered += value != FLT_MAX ? 1 : 0;
+                }
+            }
+        }
+        stats.overdraw = stats.covered > 0 ? static_cast<float>(stats.shaded) / stats.covered : 0.0f;
+        return stats;
+    }
+
+    RHIFormat MeshOptimizer::SelectIndexFormat(uint32_t vertexCount) {
+        return vertexCount <= 65536 ? RHIFormat::R16Uint : RHIFormat::R32Uint;
+    }
+
+    void MeshOptimizer::PackIndices16(const uint32_t* indices, uint32_t count, std::vector<uint16_t>& output) {
+        output.resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            output[i] = static_cast<uint16_t>(indices[i]);
+        }
+    }
+
+    std::string MeshOptimizer::BuildReport() const {
+        std::ostringstream report;
+        report.setf(std::ios::fixed);
+        report.precision(3);
+        report << "ACMR: " << m_stats.cacheBefore.acmr << " -> " << m_stats.cacheAfter.acmr << ", ATVR: " << m_stats.cacheBefore.atvr
+               << " -> " << m_stats.cacheAfter.atvr << " (cache FIFO de " << m_stats.cacheSize << " vertices, "
+               << m_stats.cacheAfter.triangles << " triangulos)\n";
+        report << "Overdraw: " << m_stats.overdrawBefore.overdraw << " -> " << m_stats.overdrawAfter.overdraw << " (" << m_stats.clusters
+               << " clusters en " << m_stats.ranges << " rangos)\n";
+        report << "Overfetch: " << m_stats.fetchBefore.overfetch << " -> " << m_stats.fetchAfter.overfetch << " ("
+               << m_stats.verticesRemoved << " vertices sin usar eliminados)\n";
+        report << "Indices de " << GetFormatSize(m_stats.indexFormat) * 8 << " bits, " << m_stats.optimizeMs << " ms\n";
+        return report.str();
+    }
+
+} // namespace D3D12Core
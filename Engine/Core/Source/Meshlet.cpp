@@ -0,0 +1,386 @@
+#include "Meshlet.h"
+#include "FramePacer.h"
+#include "FrustumCulling.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+namespace D3D12Core {
+
+    namespace {
+
+        constexpr uint8_t MESHLET_VISIBLE = 0;
+        constexpr uint8_t MESHLET_OUTSIDE = 1;
+        constexpr uint8_t MESHLET_BACKFACING = 2;
+        constexpr float RADIANS_TO_DEGREES = 57.2957795f;
+
+        float Dot(const float a[3], const float b[3]) {
+            return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        }
+
+        // Normal de cara unitaria y su área (el doble), con la orientación de MeshletMesh
+        struct TriangleNormal {
+            float normal[3];
+            float area;
+        };
+
+    } // namespace
+
+    bool MeshletMesh::Build(const std::vector<Vertex>& vertices, const uint32_t* indices, uint32_t indexCount,
+        const MeshletSettings& settings) {
+        m_indices.clear();
+        m_meshlets.clear();
+        m_bounds.clear();
+        m_stats = MeshletBuildStats();
+        if (vertices.empty() || !indices || indexCount == 0 || indexCount % 3 != 0) {
+            std::cerr << "Error: MeshletMesh::Build necesita vertices y triangulos completos" << std::endl;
+            return false;
+        }
+        if (settings.maxVertices < 3 || settings.maxVertices > MESHLET_MAX_VERTICES || settings.maxTriangles == 0 ||
+            settings.maxTriangles > MESHLET_MAX_TRIANGLES) {
+            std::cerr << "Error: MeshletMesh::Build con limites fuera de rango (3-" << MESHLET_MAX_VERTICES << " vertices, 1-"
+                      << MESHLET_MAX_TRIANGLES << " triangulos)" << std::endl;
+            return false;
+        }
+        const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+        for (uint32_t i = 0; i < indexCount; i++) {
+            if (indices[i] >= vertexCount) {
+                std::cerr << "Error: MeshletMesh::Build con un indice fuera del vertex buffer" << std::endl;
+                return false;
+            }
+        }
+        int64_t start = FramePacer::Now();
+        const uint32_t triangleCount = indexCount / 3;
+
+        std::vector<TriangleNormal> normals(triangleCount);
+        for (uint32_t t = 0; t < triangleCount; t++) {
+            const float* a = vertices[indices[t * 3]].position;
+            const float* b = vertices[indices[t * 3 + 1]].position;
+            const float* c = vertices[indices[t * 3 + 2]].position;
+            const float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+            const float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+            // (b - a) x (c - a): hacia fuera en los triángulos en sentido horario vistos de frente
+            float* normal = normals[t].normal;
+            normal[0] = ab[1] * ac[2] - ab[2] * ac[1];
+            normal[1] = ab[2] * ac[0] - ab[0] * ac[2];
+            normal[2] = ab[0] * ac[1] - ab[1] * ac[0];
+            normals[t].area = std::sqrt(Dot(normal, normal));
+            const float inverse = normals[t].area > 0.0f ? 1.0f / normals[t].area : 0.0f;
+            for (int axis = 0; axis < 3; axis++) {
+                normal[axis] *= inverse;
+            }
+        }
+
+        // Triángulos de cada vértice (CSR)
+        std::vector<uint32_t> adjacencyStart(vertexCount + 1, 0);
+        for (uint32_t i = 0; i < indexCount; i++) {
+            adjacencyStart[indices[i] + 1]++;
+        }
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            adjacencyStart[v + 1] += adjacencyStart[v];
+        }
+        std::vector<uint32_t> adjacency(indexCount);
+        std::vector<uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+        for (uint32_t i = 0; i < indexCount; i++) {
+            adjacency[fill[indices[i]]++] = i / 3;
+        }
+
+        // Marcas con el número del cluster en curso: vértices que ya tiene y triángulos candidatos
+        constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> vertexMeshlet(vertexCount, NONE);
+        std::vector<uint32_t> candidateMeshlet(triangleCount, NONE);
+        std::vector<uint8_t> used(triangleCount, 0);
+        std::vector<uint32_t> candidates;
+        std::vector<uint32_t> meshletTriangles;
+        m_indices.reserve(indexCount);
+        uint32_t cursor = 0;
+        double coneAngles = 0.0;
+
+        while (true) {
+            while (cursor < triangleCount && used[cursor]) {
+                cursor++;
+            }
+            if (cursor == triangleCount) {
+                break;
+            }
+            const uint32_t id = static_cast<uint32_t>(m_meshlets.size());
+            Meshlet meshlet;
+            meshlet.startIndex = static_cast<uint32_t>(m_indices.size());
+            float axis[3] = { 0.0f, 0.0f, 0.0f };
+            candidates.clear();
+            meshletTriangles.clear();
+
+            auto addTriangle = [&](uint32_t triangle) {
+                used[triangle] = 1;
+                meshletTriangles.push_back(triangle);
+                for (uint32_t corner = 0; corner < 3; corner++) {
+                    const uint32_t vertex = indices[triangle * 3 + corner];
+                    m_indices.push_back(vertex);
+                    if (vertexMeshlet[vertex] == id) {
+                        continue;
+                    }
+                    vertexMeshlet[vertex] = id;
+                    meshlet.vertexCount++;
+                    for (uint32_t a = adjacencyStart[vertex]; a < adjacencyStart[vertex + 1]; a++) {
+                        const uint32_t neighbour = adjacency[a];
+                        if (!used[neighbour] && candidateMeshlet[neighbour] != id) {
+                            candidateMeshlet[neighbour] = id;
+                            candidates.push_back(neighbour);
+                        }
+                    }
+                }
+                for (int k = 0; k < 3; k++) {
+                    axis[k] += normals[triangle].normal[k] * normals[triangle].area;
+                }
+                meshlet.triangleCount++;
+            };
+
+            addTriangle(cursor);
+            while (meshlet.triangleCount < settings.maxTriangles) {
+                const float axisLength = std::sqrt(Dot(axis, axis));
+                const float inverseLength = axisLength > 0.0f ? 1.0f / axisLength : 0.0f;
+                const float direction[3] = { axis[0] * inverseLength, axis[1] * inverseLength, axis[2] * inverseLength };
+                uint32_t best = NONE;
+                float bestScore = std::numeric_limits<float>::max();
+                size_t kept = 0;
+                for (size_t c = 0; c < candidates.size(); c++) {
+                    const uint32_t triangle = candidates[c];
+                    if (used[triangle]) {
+                        continue;
+                    }
+                    candidates[kept++] = triangle;
+                    uint32_t newVertices = 0;
+                    for (uint32_t corner = 0; corner < 3; corner++) {
+                        newVertices += vertexMeshlet[indices[triangle * 3 + corner]] != id ? 1 : 0;
+                    }
+                    if (meshlet.vertexCount + newVertices > settings.maxVertices) {
+                        continue;
+                    }
+                    const float score = static_cast<float>(newVertices) +
+                        settings.coneWeight * (1.0f - Dot(normals[triangle].normal, direction));
+                    if (score < bestScore) {
+                        bestScore = score;
+                        best = triangle;
+                    }
+                }
+                candidates.resize(kept);
+                if (best == NONE) {
+                    break;
+                }
+                addTriangle(best);
+            }
+
+            // Esfera: centro de la AABB y distancia al vértice más lejano
+            const uint32_t* meshletIndices = m_indices.data() + meshlet.startIndex;
+            const uint32_t meshletIndexCount = meshlet.triangleCount * 3;
+            float minimum[3], maximum[3];
+            for (int k = 0; k < 3; k++) {
+                minimum[k] = maximum[k] = vertices[meshletIndices[0]].position[k];
+            }
+            for (uint32_t i = 1; i < meshletIndexCount; i++) {
+                const float* position = vertices[meshletIndices[i]].position;
+                for (int k = 0; k < 3; k++) {
+                    minimum[k] = std::min(minimum[k], position[k]);
+                    maximum[k] = std::max(maximum[k], position[k]);
+                }
+            }
+            MeshletBounds bounds;
+            for (int k = 0; k < 3; k++) {
+                bounds.center[k] = (minimum[k] + maximum[k]) * 0.5f;
+            }
+            float radiusSquared = 0.0f;
+            for (uint32_t i = 0; i < meshletIndexCount; i++) {
+                const float* position = vertices[meshletIndices[i]].position;
+                const float offset[3] = { position[0] - bounds.center[0], position[1] - bounds.center[1], position[2] - bounds.center[2] };
+                radiusSquared = std::max(radiusSquared, Dot(offset, offset));
+            }
+            bounds.radius = std::sqrt(radiusSquared);
+
+            // Cono: eje = suma de normales por área; el ángulo lo marca la normal más apartada.
+            // Los triángulos degenerados no se ven desde ningún lado y no cuentan
+            const float axisLength = std::sqrt(Dot(axis, axis));
+            if (axisLength > 0.0f) {
+                for (int k = 0; k < 3; k++) {
+                    bounds.coneAxis[k] = axis[k] / axisLength;
+                }
+                float minimumDot = 1.0f;
+                for (uint32_t triangle : meshletTriangles) {
+                    if (normals[triangle].area > 0.0f) {
+                        minimumDot = std::min(minimumDot, Dot(normals[triangle].normal, bounds.coneAxis));
+                    }
+                }
+                if (minimumDot > 0.0f) {
+                    bounds.coneCutoff = std::sqrt(std::max(0.0f, 1.0f - minimumDot * minimumDot));
+                }
+            }
+            if (bounds.coneCutoff < 1.0f) {
+                coneAngles += std::asin(bounds.coneCutoff) * RADIANS_TO_DEGREES;
+            }
+            else {
+                m_stats.openCones++;
+            }
+            m_stats.meshletVertices += meshlet.vertexCount;
+            m_meshlets.push_back(meshlet);
+            m_bounds.push_back(bounds);
+        }
+
+        m_stats.vertices = vertexCount;
+        m_stats.triangles = triangleCount;
+        m_stats.meshlets = static_cast<uint32_t>(m_meshlets.size());
+        const uint32_t closedCones = m_stats.meshlets - m_stats.openCones;
+        m_stats.averageConeAngle = closedCones > 0 ? static_cast<float>(coneAngles / closedCones) : 0.0f;
+        m_stats.buildMs = (FramePacer::Now() - start) / 1000000.0;
+        return true;
+    }
+
+    std::string MeshletMesh::BuildReport() const {
+        std::ostringstream report;
+        report.setf(std::ios::fixed);
+        report.precision(1);
+        const double meshlets = std::max(m_stats.meshlets, 1u);
+        report << "Clusters: " << m_stats.meshlets << " de " << m_stats.triangles << " triangulos y " << m_stats.vertices
+               << " vertices (" << m_stats.triangles / meshlets << " triangulos y " << m_stats.meshletVertices / meshlets
+               << " vertices de media)\n";
+        report << "Conos: semiangulo medio " << m_stats.averageConeAngle << " grados, " << m_stats.openCones
+               << " abiertos (90 grados o mas)\n";
+        report.precision(3);
+        report << "Construccion: " << m_stats.buildMs << " ms\n";
+        return report.str();
+    }
+
+    uint32_t MeshletCuller::Cull(const MeshletMesh& mesh, const Float4x4& world, const CameraProxy& camera, JobSystem* jobs) {
+        int64_t start = FramePacer::Now();
+        const uint32_t meshletCount = mesh.GetMeshletCount();
+        const Meshlet* meshlets = mesh.GetMeshlets();
+        const MeshletBounds* allBounds = mesh.GetBounds();
+        const uint32_t* meshIndices = mesh.GetIndices().data();
+
+        // Planos del frustum en el espacio de la malla: los de world * view * projection
+        const CullingFrustum frustum = CullingFrustum::FromViewProjection(Multiply(world, Multiply(camera.view, camera.projection)));
+
+        // Cámara en el espacio de la malla: (posición - traslación) por la inversa de la parte 3x3
+        // (vector fila). El signo del cono no cambia con la transformación salvo con un espejo
+        // (determinante negativo), que da la vuelta al sentido de los triángulos en pantalla
+        const float (*m)[4] = world.m;
+        const float cofactors[3][3] = {
+            { m[1][1] * m[2][2] - m[1][2] * m[2][1], m[0][2] * m[2][1] - m[0][1] * m[2][2], m[0][1] * m[1][2] - m[0][2] * m[1][1] },
+            { m[1][2] * m[2][0] - m[1][0] * m[2][2], m[0][0] * m[2][2] - m[0][2] * m[2][0], m[0][2] * m[1][0] - m[0][0] * m[1][2] },
+            { m[1][0] * m[2][1] - m[1][1] * m[2][0], m[0][1] * m[2][0] - m[0][0] * m[2][1], m[0][0] * m[1][1] - m[0][1] * m[1][0] }
+        };
+        const float determinant = m[0][0] * cofactors[0][0] + m[0][1] * cofactors[1][0] + m[0][2] * cofactors[2][0];
+        const bool backface = m_backface && determinant != 0.0f;
+        const float side = determinant < 0.0f ? -1.0f : 1.0f;
+        float localCamera[3] = { 0.0f, 0.0f, 0.0f };
+        if (backface) {
+            const float offset[3] = { camera.position[0] - m[3][0], camera.position[1] - m[3][1], camera.position[2] - m[3][2] };
+            for (int column = 0; column < 3; column++) {
+                localCamera[column] = (offset[0] * cofactors[0][column] + offset[1] * cofactors[1][column] +
+                    offset[2] * cofactors[2][column]) / determinant;
+            }
+        }
+
+        // Primera pasada: estado de cada cluster e índices visibles de cada lote
+        const uint32_t blockCount = (meshletCount + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        m_visible.resize(meshletCount);
+        m_blockIndices.assign(blockCount + 1, 0);
+        auto test = [&](uint32_t begin, uint32_t end, uint32_t) {
+            uint32_t visibleIndices = 0;
+            for (uint32_t i = begin; i < end; i++) {
+                const MeshletBounds& bounds = allBounds[i];
+                uint8_t state = MESHLET_VISIBLE;
+                for (const float* plane : frustum.planes) {
+                    if (plane[0] * bounds.center[0] + plane[1] * bounds.center[1] + plane[2] * bounds.center[2] + plane[3] < -bounds.radius) {
+                        state = MESHLET_OUTSIDE;
+                        break;
+                    }
+                }
+                // De espaldas si, para todo punto p de la esfera y toda normal n del cono,
+                // (p - cámara)·n >= 0: basta con que el eje se aparte de la dirección al centro
+                // menos de 90 grados menos el semiángulo y el radio visto desde la cámara
+                if (state == MESHLET_VISIBLE && backface && bounds.coneCutoff < 1.0f) {
+                    const float offset[3] = { bounds.center[0] - localCamera[0], bounds.center[1] - localCamera[1],
+                        bounds.center[2] - localCamera[2] };
+                    const float distance = std::sqrt(Dot(offset, offset));
+                    if (side * Dot(offset, bounds.coneAxis) - bounds.radius >= bounds.coneCutoff * (distance + bounds.radius)) {
+                        state = MESHLET_BACKFACING;
+                    }
+                }
+                m_visible[i] = state;
+                visibleIndices += state == MESHLET_VISIBLE ? meshlets[i].triangleCount * 3 : 0;
+            }
+            m_blockIndices[begin / BLOCK_SIZE] = visibleIndices;
+        };
+        JobSystem::ParallelFor(jobs, meshletCount, BLOCK_SIZE, test);
+
+        // Inicio de cada lote en el index buffer compactado
+        uint32_t total = 0;
+        for (uint32_t block = 0; block <= blockCount; block++) {
+            const uint32_t count = m_blockIndices[block];
+            m_blockIndices[block] = total;
+            total += count;
+        }
+        if (m_indices.size() < total) {
+            m_indices.resize(total);
+        }
+        m_indexCount = total;
+
+        // Segunda pasada: copia de los rangos visibles (los clusters seguidos son un solo rango)
+        auto compact = [&](uint32_t begin, uint32_t end, uint32_t) {
+            uint32_t* output = m_indices.data() + m_blockIndices[begin / BLOCK_SIZE];
+            uint32_t i = begin;
+            while (i < end) {
+                if (m_visible[i] != MESHLET_VISIBLE) {
+                    i++;
+                    continue;
+                }
+                const uint32_t first = meshlets[i].startIndex;
+                uint32_t count = 0;
+                for (; i < end && m_visible[i] == MESHLET_VISIBLE; i++) {
+                    count += meshlets[i].triangleCount * 3;
+                }
+                std::memcpy(output, meshIndices + first, count * sizeof(uint32_t));
+                output += count;
+            }
+        };
+        JobSystem::ParallelFor(jobs, meshletCount, BLOCK_SIZE, compact);
+
+        uint64_t outside = 0;
+        uint64_t backfacing = 0;
+        for (uint32_t i = 0; i < meshletCount; i++) {
+            outside += m_visible[i] == MESHLET_OUTSIDE ? 1 : 0;
+            backfacing += m_visible[i] == MESHLET_BACKFACING ? 1 : 0;
+        }
+        m_stats.frames++;
+        m_stats.meshlets += meshletCount;
+        m_stats.frustumCulled += outside;
+        m_stats.backfaceCulled += backfacing;
+        m_stats.triangles += mesh.GetIndices().size() / 3;
+        m_stats.visibleTriangles += total / 3;
+        m_stats.lastMeshlets = meshletCount;
+        m_stats.lastFrustumCulled = outside;
+        m_stats.lastBackfaceCulled = backfacing;
+        m_stats.cullMs += (FramePacer::Now() - start) / 1000000.0;
+        return total;
+    }
+
+    std::string MeshletCuller::BuildReport() const {
+        std::ostringstream report;
+        report.setf(std::ios::fixed);
+        report.precision(1);
+        auto percent = [](uint64_t part, uint64_t whole) {
+            return whole > 0 ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+        };
+        report << "Clusters: " << m_stats.meshlets << ", fuera del frustum " << percent(m_stats.frustumCulled, m_stats.meshlets)
+               << "%, de espaldas " << percent(m_stats.backfaceCulled, m_stats.meshlets) << "%"
+               << (m_backface ? "" : " (desactivado)") << "\n";
+        report << "Triangulos: " << m_stats.visibleTriangles << " de " << m_stats.triangles << " ("
+               << percent(m_stats.visibleTriangles, m_stats.triangles) << "%)\n";
+        report.precision(3);
+        report << "Culling y compactacion: " << (m_stats.frames > 0 ? m_stats.cullMs / m_stats.frames : 0.0) << " ms por llamada\n";
+        return report.str();
+    }
+
+} // namespace D3D12Core
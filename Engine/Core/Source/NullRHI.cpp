@@ -0,0 +1,534 @@
+#include "NullRHI.h"
+#include "IndirectDrawBuilder.h"
+#include "InstanceBatcher.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+namespace D3D12Core {
+
+    // ---------------------------------------------------------------- Command list
+
+    void NullRHICommandList::Begin() {
+        if (m_open) {
+            m_device->ReportError("Begin on a command list that is already open");
+            m_counters.validationErrors++;
+        }
+
+        // Como Reset en D3D12: la lista empieza sin estado enlazado
+        m_open = true;
+        m_renderTarget = 0;
+        m_hasViewport = false;
+        m_hasScissor = false;
+        m_pipeline = nullptr;
+        m_hasConstants = false;
+        std::fill(std::begin(m_vertexBuffers), std::end(m_vertexBuffers), nullptr);
+        m_indexBuffer = nullptr;
+        m_indexFormat = RHIFormat::Unknown;
+        m_instanceCapacity = 0;
+        m_objectCapacity = 0;
+        m_counters = NullRHIStats();
+    }
+
+    void NullRHICommandList::Close() {
+        if (CheckOpen("Close")) {
+            m_open = false;
+        }
+    }
+
+    bool NullRHICommandList::CheckOpen(const char* call) {
+        if (m_open) {
+            return true;
+        }
+        m_device->ReportError(std::string(call) + " on a closed command list");
+        m_counters.validationErrors++;
+        return false;
+    }
+
+    void NullRHICommandList::SetRenderTarget(uint64_t renderTargetView) {
+        if (!CheckOpen("SetRenderTarget")) {
+            return;
+        }
+        if (renderTargetView == 0) {
+            m_device->ReportError("SetRenderTarget with a null view");
+            m_counters.validationErrors++;
+        }
+        m_renderTarget = renderTargetView;
+    }
+
+    void NullRHICommandList::ClearRenderTarget(uint64_t renderTargetView, const float color[4]) {
+        if (!CheckOpen("ClearRenderTarget")) {
+            return;
+        }
+        if (renderTargetView == 0 || !color) {
+            m_device->ReportError("ClearRenderTarget with a null view or color");
+            m_counters.validationErrors++;
+            return;
+        }
+        m_counters.clears++;
+    }
+
+    void NullRHICommandList::SetViewport(const RHIViewport& viewport) {
+        if (!CheckOpen("SetViewport")) {
+            return;
+        }
+        if (viewport.width <= 0.0f || viewport.height <= 0.0f || viewport.minDepth > viewport.maxDepth) {
+            m_device->ReportError("SetViewport with an empty viewport or inverted depth range");
+            m_counters.validationErrors++;
+            return;
+        }
+        m_hasViewport = true;
+    }
+
+    void NullRHICommandList::SetScissor(const RHIRect& rect) {
+        if (!CheckOpen("SetScissor")) {
+            return;
+        }
+        if (rect.right <= rect.left || rect.bottom <= rect.top) {
+            m_device->ReportError("SetScissor with an empty rectangle");
+            m_counters.validationErrors++;
+            return;
+        }
+        m_hasScissor = true;
+    }
+
+    void NullRHICommandList::SetPipeline(IRHIPipeline* pipeline) {
+        if (!CheckOpen("SetPipeline")) {
+            return;
+        }
+        if (!pipeline) {
+            m_device->ReportError("SetPipeline with a null pipeline");
+            m_counters.validationErrors++;
+            return;
+        }
+        // Cambiar de pipeline (root signature) invalida las constantes y el buffer de objetos enlazados
+        if (pipeline != m_pipeline) {
+            m_hasConstants = false;
+            m_objectCapacity = 0;
+        }
+        m_pipeline = pipeline;
+        m_counters.pipelineBinds++;
+    }
+
+    void NullRHICommandList::SetConstantBuffer(uint32_t rootParameter, uint64_t gpuAddress) {
+        if (!CheckOpen("SetConstantBuffer")) {
+            return;
+        }
+        if (!m_pipeline) {
+            m_device->ReportError("SetConstantBuffer before SetPipeline");
+            m_counters.validationErrors++;
+            return;
+        }
+        if (!m_pipeline->GetDesc().useConstantBuffer || rootParameter != 0) {
+            m_device->ReportError("SetConstantBuffer on a root parameter the pipeline does not declare");
+            m_counters.validationErrors++;
+            return;
+        }
+        if (gpuAddress == 0 || (gpuAddress % NullRHIDevice::CONSTANT_ALIGNMENT) != 0) {
+            m_device->ReportError("SetConstantBuffer with a null or misaligned address");
+            m_counters.validationErrors++;
+            return;
+        }
+        m_hasConstants = true;
+    }
+
+    void NullRHICommandList::SetVertexBuffer(IRHIBuffer* buffer, uint32_t stream) {
+        if (!CheckOpen("SetVertexBuffer")) {
+            return;
+        }
+        if (!buffer || !(buffer->GetDesc().usage & RHI_BUFFER_USAGE_VERTEX) || stream >= MAX_VERTEX_STREAMS) {
+            m_device->ReportError("SetVertexBuffer with a buffer created without RHI_BUFFER_USAGE_VERTEX or an invalid stream");
+            m_counters.validationErrors++;
+            return;
+        }
+        m_vertexBuffers[stream] = buffer;
+    }
+
+    void NullRHICommandList::SetIndexBuffer(IRHIBuffer* buffer, RHIFormat format) {
+        if (!CheckOpen("SetIndexBuffer")) {
+            return;
+        }
+        if (!buffer || !(buffer->GetDesc().usage & RHI_BUFFER_USAGE_INDEX)) {
+            m_device->ReportError("SetIndexBuffer with a buffer created without RHI_BUFFER_USAGE_INDEX");
+            m_counters.validationErrors++;
+            return;
+        }
+        if (format != RHIFormat::R16Uint && format != RHIFormat::R32Uint) {
+            m_device->ReportError("SetIndexBuffer with a format other than R16Uint/R32Uint");
+            m_counters.validationErrors++;
+            return;
+        }
+        m_indexBuffer = buffer;
+        m_indexFormat = format;
+    }
+
+    void NullRHICommandList::SetInstanceBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) {
+        if (!CheckOpen("SetInstanceBuffer")) {
+            return;
+        }
+        if (!m_pipeline || m_pipeline->GetDesc().instanceStride == 0) {
+            m_device->ReportError("SetInstanceBuffer without an instanced pipeline");
+            m_counters.validationErrors++;
+            return;
+        }
+        if (stride != m_pipeline->GetDesc().instanceStride || gpuAddress == 0 || size < stride) {
+            m_device->ReportError("SetInstanceBuffer with a null address, an empty range or a stride the pipeline does not declare");
+            m_counters.validationErrors++;
+            return;
+        }
+        m_instanceCapacity = size / stride;
+    }
+
+    void NullRHICommandList::SetObjectBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) {
+        if (!CheckOpen("SetObjectBuffer")) {
+            return;
+        }
+        if (!m_pipeline || m_pipeline->GetDesc().objectStride == 0) {
+            m_device->ReportError("SetObjectBuffer without an indirect pipeline");
+            m_counters.validationErrors++;
+            return;
+        }
+        if (stride != m_pipeline->GetDesc().objectStride || gpuAddress == 0 || size < stride) {
+            m_device->ReportError("SetObjectBuffer with a null address, an empty range or a stride the pipeline does not declare");
+            m_counters.validationErrors++;
+            return;
+        }
+        m_objectCapacity = size / stride;
+    }
+
+    bool NullRHICommandList::CheckDrawState(const char* call, uint32_t instanceCount, uint32_t startInstance, bool indirect) {
+        if (!CheckOpen(call)) {
+            return false;
+        }
+
+        const char* missing = nullptr;
+        if (!m_pipeline) {
+            missing = "pipeline";
+        }
+        else if (m_renderTarget == 0) {
+            missing = "render target";
+        }
+        else if (!m_hasViewport) {
+            missing = "viewport";
+        }
+        else if (!m_hasScissor) {
+            missing = "scissor rectangle";
+        }
+        else if (m_pipeline->GetDesc().useConstantBuffer && !m_hasConstants) {
+            missing = "constant buffer";
+        }
+        else if (m_pipeline->GetDesc().vertexStride > 0 &&
+                 (!m_vertexBuffers[0] || (m_pipeline->GetDesc().vertexFormat.splitPosition && !m_vertexBuffers[1]))) {
+            missing = "vertex buffer";
+        }
+        else if (m_pipeline->GetDesc().instanceStride > 0 && m_instanceCapacity == 0) {
+            missing = "instance buffer";
+        }
+        else if (m_pipeline->GetDesc().objectStride > 0 && m_objectCapacity == 0) {
+            missing = "object buffer";
+        }
+
+        if (missing) {
+            m_device->ReportError(std::string(call) + " without a bound " + missing);
+            m_counters.validationErrors++;
+            return false;
+        }
+        if ((m_pipeline->GetDesc().objectStride > 0) != indirect) {
+            m_device->ReportError(std::string(call) + (indirect ? " needs an indirect pipeline" : " on an indirect pipeline (its draw index only comes from ExecuteIndirect)"));
+            m_counters.validationErrors++;
+            return false;
+        }
+        if (instanceCount == 0) {
+            m_device->ReportError(std::string(call) + " with zero instances");
+            m_counters.validationErrors++;
+            return false;
+        }
+        if (m_pipeline->GetDesc().instanceStride > 0 && static_cast<uint64_t>(startInstance) + instanceCount > m_instanceCapacity) {
+            m_device->ReportError(std::string(call) + " reads past the end of the instance buffer");
+            m_counters.validationErrors++;
+            return false;
+        }
+        return true;
+    }
+
+    void NullRHICommandList::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex, uint32_t startInstance) {
+        if (!CheckDrawState("Draw", instanceCount, startInstance)) {
+            return;
+        }
+
+        const VertexFormat& format = m_pipeline->GetDesc().vertexFormat;
+        for (uint32_t stream = 0; m_pipeline->GetDesc().vertexStride > 0 && stream < format.GetStreamCount(); stream++) {
+            uint64_t end = (static_cast<uint64_t>(startVertex) + vertexCount) * format.GetStride(stream);
+            if (end > m_vertexBuffers[stream]->GetDesc().size) {
+                m_device->ReportError("Draw reads past the end of the vertex buffer");
+                m_counters.validationErrors++;
+                return;
+            }
+        }
+
+        m_counters.draws++;
+        m_counters.instances += instanceCount;
+        m_counters.primitives += static_cast<uint64_t>(vertexCount / 3) * instanceCount;
+    }
+
+    void NullRHICommandList::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) {
+        if (!CheckDrawState("DrawIndexed", instanceCount, startInstance)) {
+            return;
+        }
+        if (!m_indexBuffer) {
+            m_device->ReportError("DrawIndexed without a bound index buffer");
+            m_counters.validationErrors++;
+            return;
+        }
+
+        uint64_t indexBytes = (static_cast<uint64_t>(startIndex) + indexCount) * GetFormatSize(m_indexFormat);
+        if (indexBytes > m_indexBuffer->GetDesc().size) {
+            m_device->ReportError("DrawIndexed reads past the end of the index buffer");
+            m_counters.validationErrors++;
+            return;
+        }
+        if (baseVertex < 0) {
+            m_device->ReportError("DrawIndexed with a negative base vertex");
+            m_counters.validationErrors++;
+            return;
+        }
+
+        m_counters.draws++;
+        m_counters.instances += instanceCount;
+        m_counters.primitives += static_cast<uint64_t>(indexCount / 3) * instanceCount;
+    }
+
+    void NullRHICommandList::ExecuteIndirect(uint64_t argumentAddress, uint32_t commandCount) {
+        if (!CheckDrawState("ExecuteIndirect", 1, 0, true)) {
+            return;
+        }
+        if (!m_indexBuffer) {
+            m_device->ReportError("ExecuteIndirect without a bound index buffer");
+            m_counters.validationErrors++;
+            return;
+        }
+        if (!m_pipeline->GetDesc().useConstantBuffer || m_pipeline->GetDesc().instanceStride > 0) {
+            m_device->ReportError("ExecuteIndirect needs a pipeline with shared constants and no instance stream");
+            m_counters.validationErrors++;
+            return;
+        }
+        if (argumentAddress == 0 || (argumentAddress % alignof(RHIIndirectDrawCommand)) != 0 || commandCount == 0) {
+            m_device->ReportError("ExecuteIndirect with a null or misaligned argument address or no commands");
+            m_counters.validationErrors++;
+            return;
+        }
+
+        // La firma de comandos solo cambia el drawIndex: constantes y objetos siguen enlazados
+        m_counters.executeIndirects++;
+        m_counters.indirectDraws += commandCount;
+    }
+
+    // ---------------------------------------------------------------- Cola
+
+    NullRHICommandQueue::~NullRHICommandQueue() {
+        Shutdown();
+    }
+
+    bool NullRHICommandQueue::Initialize(double gpuMillisecondsPerCommandList) {
+        m_gpuMillisecondsPerCommandList = std::max(0.0, gpuMillisecondsPerCommandList);
+        return m_gpu.Initialize();
+    }
+
+    void NullRHICommandQueue::Shutdown() {
+        m_gpu.Shutdown();
+    }
+
+    void NullRHICommandQueue::ExecuteCommandList(IRHICommandList* commandList) {
+        NullRHICommandList* nullList = dynamic_cast<NullRHICommandList*>(commandList);
+        if (!nullList) {
+            m_device->ReportError("ExecuteCommandList with a null or foreign command list");
+            return;
+        }
+        if (nullList->IsOpen()) {
+            m_device->ReportError("ExecuteCommandList with a command list that was not closed");
+            return;
+        }
+
+        m_gpu.ExecuteCommandList(m_gpuMillisecondsPerCommandList);
+
+        const NullRHIStats& counters = nullList->GetCounters();
+        std::lock_guard<std::mutex> lock(m_device->m_mutex);
+        NullRHIStats& stats = m_device->m_stats;
+        stats.commandListsExecuted++;
+        stats.pipelineBinds += counters.pipelineBinds;
+        stats.clears += counters.clears;
+        stats.draws += counters.draws;
+        stats.executeIndirects += counters.executeIndirects;
+        stats.indirectDraws += counters.indirectDraws;
+        stats.instances += counters.instances;
+        stats.primitives += counters.primitives;
+    }
+
+    // ---------------------------------------------------------------- Dispositivo
+
+    NullRHIDevice::NullRHIDevice() : m_queue(this) {
+    }
+
+    NullRHIDevice::~NullRHIDevice() {
+        Shutdown();
+    }
+
+    bool NullRHIDevice::Initialize(double gpuMillisecondsPerCommandList) {
+        if (m_initialized) {
+            return true;
+        }
+        if (!m_queue.Initialize(gpuMillisecondsPerCommandList)) {
+            std::cerr << "Error: Failed to initialize null RHI queue" << std::endl;
+            return false;
+        }
+        m_initialized = true;
+        return true;
+    }
+
+    void NullRHIDevice::Shutdown() {
+        if (!m_initialized) {
+            return;
+        }
+        m_queue.Shutdown();
+        m_initialized = false;
+    }
+
+    std::unique_ptr<IRHIBuffer> NullRHIDevice::CreateBuffer(const RHIBufferDesc& desc, const void* initialData) {
+        (void)initialData;
+        if (desc.size == 0 || desc.usage == 0) {
+            ReportError("CreateBuffer with zero size or no usage");
+            return nullptr;
+        }
+        if ((desc.usage & (RHI_BUFFER_USAGE_VERTEX | RHI_BUFFER_USAGE_INDEX)) && desc.stride == 0) {
+            ReportError("CreateBuffer: vertex/index buffers need a stride");
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uint64_t address = m_nextGpuAddress;
+        m_nextGpuAddress += (desc.size + CONSTANT_ALIGNMENT - 1) & ~(CONSTANT_ALIGNMENT - 1);
+        m_stats.buffersCreated++;
+        m_stats.bufferBytes += desc.size;
+        return std::make_unique<NullRHIBuffer>(desc, address);
+    }
+
+    std::unique_ptr<IRHIPipeline> NullRHIDevice::CreatePipeline(const RHIPipelineDesc& desc) {
+        // Sin compilador de shaders el bytecode es opcional, pero si se da debe tener tamaño
+        if ((desc.vertexShader && desc.vertexShaderSize == 0) || (desc.pixelShader && desc.pixelShaderSize == 0)) {
+            ReportError("CreatePipeline with empty shader bytecode");
+            return nullptr;
+        }
+        if (desc.renderTargetFormat == RHIFormat::Unknown || desc.renderTargetFormat == RHIFormat::D32Float) {
+            ReportError("CreatePipeline with an invalid render target format");
+            return nullptr;
+        }
+        if (desc.instanceStride != 0 && desc.instanceStride != sizeof(InstanceData)) {
+            ReportError("CreatePipeline with an instance stride other than sizeof(InstanceData)");
+            return nullptr;
+        }
+        if (desc.objectStride != 0 && (desc.objectStride != sizeof(IndirectObjectData) || desc.instanceStride != 0 || !desc.useConstantBuffer)) {
+            ReportError("CreatePipeline with an object stride other than sizeof(IndirectObjectData), an instance stream or no constants");
+            return nullptr;
+        }
+        if (desc.vertexStride != 0 && desc.vertexStride != desc.vertexFormat.GetStride(0)) {
+            ReportError("CreatePipeline with a vertex stride that does not match the vertex format");
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.pipelinesCreated++;
+        return std::make_unique<NullRHIPipeline>(desc);
+    }
+
+    std::unique_ptr<IRHICommandList> NullRHIDevice::CreateCommandList() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.commandListsCreated++;
+        return std::make_unique<NullRHICommandList>(this);
+    }
+
+    uint64_t NullRHIDevice::AllocateConstants(const void* data, uint64_t size) {
+        if (!data || size == 0) {
+            ReportError("AllocateConstants with no data");
+            return 0;
+        }
+
+        // Direcciones únicas y alineadas como las de D3D12FrameAllocator (nunca se leen)
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uint64_t address = m_nextGpuAddress;
+        m_nextGpuAddress += (size + CONSTANT_ALIGNMENT - 1) & ~(CONSTANT_ALIGNMENT - 1);
+        m_stats.constantAllocations++;
+        m_stats.constantBytes += size;
+        return address;
+    }
+
+    void NullRHIDevice::ReportError(const std::string& message) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stats.validationErrors < MAX_REPORTED_ERRORS) {
+            std::cerr << "Error: NullRHI: " << message << std::endl;
+        }
+        m_stats.validationErrors++;
+    }
+
+    NullRHIStats NullRHIDevice::GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    std::string NullRHIDevice::BuildReport() const {
+        NullRHIStats stats = GetStats();
+        std::ostringstream report;
+        report << "Buffers: " << stats.buffersCreated << " (" << stats.bufferBytes << " bytes), pipelines: "
+               << stats.pipelinesCreated << ", command lists: " << stats.commandListsCreated << "\n";
+        report << "Command lists ejecutadas: " << stats.commandListsExecuted
+               << ", constantes: " << stats.constantAllocations << " (" << stats.constantBytes << " bytes)\n";
+        report << "Draws: " << stats.draws << ", instancias: " << stats.instances << ", triangulos: " << stats.primitives
+               << ", cambios de pipeline: " << stats.pipelineBinds << ", clears: " << stats.clears << "\n";
+        report << "ExecuteIndirect: " << stats.executeIndirects << " (" << stats.indirectDraws << " draws indirectos)\n";
+        report << "Errores de validacion: " << stats.validationErrors << "\n";
+        return report.str();
+    }
+
+    // ---------------------------------------------------------------- Backend del grafo
+
+    RenderGraphMemoryRequirements NullRenderGraphBackend::GetMemoryRequirements(const RenderGraphTextureDesc& desc, uint32_t usageMask) {
+        uint64_t size = 0;
+        uint32_t width = desc.width;
+        uint32_t height = desc.height;
+        for (uint32_t mip = 0; mip < std::max(desc.mipLevels, 1u); mip++) {
+            size += static_cast<uint64_t>(width) * height * 4;
+            width = std::max(width / 2, 1u);
+            height = std::max(height / 2, 1u);
+        }
+
+        RenderGraphMemoryRequirements requirements;
+        requirements.alignment = PLACEMENT_ALIGNMENT;
+        requirements.size = (size + PLACEMENT_ALIGNMENT - 1) & ~(PLACEMENT_ALIGNMENT - 1);
+        // Misma separación que el backend D3D12: RT/DS y el resto en heaps distintos
+        uint32_t renderTargetMask = UsageBit(RenderGraphUsage::RenderTarget) |
+            UsageBit(RenderGraphUsage::DepthWrite) | UsageBit(RenderGraphUsage::DepthRead);
+        requirements.heapCategory = (usageMask & renderTargetMask) ? 0 : 1;
+        return requirements;
+    }
+
+    bool NullRenderGraphBackend::PrepareResources(const RenderGraph& graph) {
+        uint64_t heapBytes = 0;
+        for (uint64_t size : graph.GetHeapSizes()) {
+            heapBytes += size;
+        }
+        m_stats.peakHeapBytes = std::max(m_stats.peakHeapBytes, heapBytes);
+        m_stats.graphs++;
+        return true;
+    }
+
+    void NullRenderGraphBackend::BeginPass(const RenderGraph& graph, const RenderGraph::CompiledPass& pass) {
+        (void)graph;
+        m_stats.passes++;
+        m_stats.aliasingBarriers += pass.aliasing.size();
+        m_stats.transitions += pass.beginTransitions.size() + pass.transitions.size();
+    }
+
+    void NullRenderGraphBackend::EndGraph(const RenderGraph& graph) {
+        m_stats.transitions += graph.GetFinalTransitions().size();
+    }
+
+} // namespace D3D12Core
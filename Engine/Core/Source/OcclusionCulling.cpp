@@ -0,0 +1,884 @@
+#include "OcclusionCulling.h"
+#include "BatchMath.h"
+#include "FramePacer.h"
+#include "SimdFloat4.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+namespace D3D12Core {
+
+    namespace {
+
+        // Primitivas por chunk de setup y vértices por lote de transformación (como el
+        // rasterizador de la RHI software)
+        constexpr uint32_t MIN_PRIMITIVES_PER_CHUNK = 1024;
+        constexpr uint32_t CHUNKS_PER_THREAD = 4;
+        constexpr uint32_t VERTEX_BATCH = 4096;
+        // Margen en píxeles del depth buffer con el que un píxel debe quedar dentro de todas las
+        // aristas, y en z hacia el fondo: absorbe el redondeo de la proyección y el snapping
+        // del rasterizador a resolución completa
+        constexpr float COVERAGE_MARGIN = 1.0f / 64.0f;
+        constexpr float DEPTH_MARGIN = 1e-6f;
+        // Oclusores que ocupan menos píxeles del depth buffer no se rasterizan: tapan poco y
+        // cuestan lo mismo en vértices y setup
+        constexpr float MIN_OCCLUDER_AREA = 16.0f;
+        // |n1 x n2| / (|n1| |n2|) máximo para fusionar dos triángulos en un quad
+        constexpr float COPLANAR_TOLERANCE = 1e-5f;
+
+        // Mínimo y máximo de los 4 carriles
+        float HorizontalMin(Float4 value) {
+            float lanes[4];
+            value.Store(lanes);
+            return std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+        }
+
+        float HorizontalMax(Float4 value) {
+            float lanes[4];
+            value.Store(lanes);
+            return std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+        }
+
+        enum class BoxProjection {
+            Outside,     // Todas las esquinas fuera de un mismo plano del frustum
+            CrossesNear, // Alguna esquina delante del plano near: la proyección no está acotada
+            Projected
+        };
+
+        // Proyecta las 8 esquinas de una caja (centro y semiextensión) multiplicadas por matrix,
+        // 4 por operación (-z y +z). Con Projected deja su rectángulo en píxeles (minX, minY,
+        // maxX, maxY) y su z mínima
+        BoxProjection ProjectBox(const float center[3], const float extent[3], const Float4x4& matrix, float width, float height,
+            float rect[4], float& minZ) {
+            static const float signX[4] = { -1.0f, 1.0f, -1.0f, 1.0f };
+            static const float signY[4] = { -1.0f, -1.0f, 1.0f, 1.0f };
+            Float4 clip[2][4];
+            for (int column = 0; column < 4; column++) {
+                const float clipCenter = center[0] * matrix.m[0][column] + center[1] * matrix.m[1][column] +
+                    center[2] * matrix.m[2][column] + matrix.m[3][column];
+                const Float4 planar = Float4::Set(clipCenter) + Float4::Load(signX) * Float4::Set(extent[0] * matrix.m[0][column]) +
+                    Float4::Load(signY) * Float4::Set(extent[1] * matrix.m[1][column]);
+                const Float4 depthAxis = Float4::Set(extent[2] * matrix.m[2][column]);
+                clip[0][column] = planar - depthAxis;
+                clip[1][column] = planar + depthAxis;
+            }
+
+            // Planos (x >= -w, x <= w, y >= -w, y <= w, z >= 0, z <= w): bit a 1 si la esquina
+            // queda fuera; la caja está fuera si las 8 esquinas lo están del mismo
+            const Float4 zero = Float4::Set(0.0f);
+            int outside[6] = { 0xF, 0xF, 0xF, 0xF, 0xF, 0xF };
+            int nearCorners = 0;
+            for (const Float4* corners : clip) {
+                const Float4 negativeW = zero - corners[3];
+                outside[0] &= MoveMask(CmpLess(corners[0], negativeW));
+                outside[1] &= MoveMask(CmpLess(corners[3], corners[0]));
+                outside[2] &= MoveMask(CmpLess(corners[1], negativeW));
+                outside[3] &= MoveMask(CmpLess(corners[3], corners[1]));
+                const int behindNear = MoveMask(CmpLess(corners[2], zero) | CmpLess(corners[3], zero));
+                outside[4] &= behindNear;
+                outside[5] &= MoveMask(CmpLess(corners[3], corners[2]));
+                nearCorners |= behindNear;
+            }
+            for (int plane : outside) {
+                if (plane == 0xF) {
+                    return BoxProjection::Outside;
+                }
+            }
+            if (nearCorners != 0) {
+                return BoxProjection::CrossesNear;
+            }
+
+            const Float4 half = Float4::Set(0.5f);
+            Float4 minimum[3];
+            Float4 maximum[2];
+            for (int group = 0; group < 2; group++) {
+                const Float4* corners = clip[group];
+                const Float4 invW = Float4::Set(1.0f) / corners[3];
+                const Float4 x = (corners[0] * invW * half + half) * Float4::Set(width);
+                const Float4 y = (half - corners[1] * invW * half) * Float4::Set(height);
+                const Float4 z = corners[2] * invW;
+                minimum[0] = group == 0 ? x : Min(minimum[0], x);
+                minimum[1] = group == 0 ? y : Min(minimum[1], y);
+                minimum[2] = group == 0 ? z : Min(minimum[2], z);
+                maximum[0] = group == 0 ? x : Max(maximum[0], x);
+                maximum[1] = group == 0 ? y : Max(maximum[1], y);
+            }
+            rect[0] = HorizontalMin(minimum[0]);
+            rect[1] = HorizontalMin(minimum[1]);
+            rect[2] = HorizontalMax(maximum[0]);
+            rect[3] = HorizontalMax(maximum[1]);
+            minZ = HorizontalMin(minimum[2]);
+            return BoxProjection::Projected;
+        }
+
+        struct Vector3 {
+            float x, y, z;
+        };
+
+        Vector3 operator-(const Vector3& a, const Vector3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+
+        Vector3 Cross(const Vector3& a, const Vector3& b) {
+            return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+        }
+
+        float Dot(const Vector3& a, const Vector3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+    } // namespace
+
+    bool OcclusionMesh::Build(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+        for (std::vector<float>& axis : m_positions) {
+            axis.clear();
+        }
+        m_primitives.clear();
+        m_triangleCount = 0;
+        m_closed = false;
+        if (vertices.empty() || indices.size() < 3 || indices.size() % 3 != 0) {
+            std::cerr << "Error: OcclusionMesh necesita vertices y una lista de triangulos" << std::endl;
+            return false;
+        }
+        const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+        for (uint32_t index : indices) {
+            if (index >= vertexCount) {
+                std::cerr << "Error: OcclusionMesh con un indice fuera del vertex buffer (" << index << ")" << std::endl;
+                return false;
+            }
+        }
+
+        // Soldadura por posición exacta: los vértices que solo se distinguen por el color pasan a
+        // ser uno, y las aristas compartidas se reconocen por índice
+        std::vector<uint32_t> order(vertexCount);
+        std::iota(order.begin(), order.end(), 0u);
+        auto lessPosition = [&](uint32_t a, uint32_t b) {
+            const float* pa = vertices[a].position;
+            const float* pb = vertices[b].position;
+            return std::lexicographical_compare(pa, pa + 3, pb, pb + 3);
+        };
+        std::sort(order.begin(), order.end(), lessPosition);
+        std::vector<uint32_t> remap(vertexCount);
+        std::vector<Vector3> positions;
+        for (uint32_t i = 0; i < vertexCount; i++) {
+            if (i == 0 || lessPosition(order[i - 1], order[i])) {
+                const float* position = vertices[order[i]].position;
+                positions.push_back({ position[0], position[1], position[2] });
+            }
+            remap[order[i]] = static_cast<uint32_t>(positions.size() - 1);
+        }
+
+        // Triángulos sin los degenerados
+        std::vector<uint32_t> triangles;
+        triangles.reserve(indices.size());
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            uint32_t a = remap[indices[i]];
+            uint32_t b = remap[indices[i + 1]];
+            uint32_t c = remap[indices[i + 2]];
+            Vector3 normal = Cross(positions[b] - positions[a], positions[c] - positions[a]);
+            if (a == b || b == c || a == c || Dot(normal, normal) == 0.0f) {
+                continue;
+            }
+            triangles.push_back(a);
+            triangles.push_back(b);
+            triangles.push_back(c);
+        }
+        m_triangleCount = static_cast<uint32_t>(triangles.size() / 3);
+        if (m_triangleCount == 0) {
+            std::cerr << "Error: OcclusionMesh sin triangulos con area" << std::endl;
+            return false;
+        }
+
+        // Cerrada si cada arista dirigida aparece una vez y su opuesta también
+        std::vector<uint64_t> edges;
+        edges.reserve(triangles.size());
+        for (size_t i = 0; i < triangles.size(); i += 3) {
+            for (uint32_t e = 0; e < 3; e++) {
+                uint64_t from = triangles[i + e];
+                uint64_t to = triangles[i + (e + 1) % 3];
+                edges.push_back((from << 32) | to);
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        m_closed = std::adjacent_find(edges.begin(), edges.end()) == edges.end();
+        for (size_t i = 0; m_closed && i < edges.size(); i++) {
+            uint64_t opposite = (edges[i] << 32) | (edges[i] >> 32);
+            m_closed = std::binary_search(edges.begin(), edges.end(), opposite);
+        }
+
+        // Quads: dos triángulos seguidos (p, q, r) y (q, p, s) que comparten la arista p-q en
+        // sentidos opuestos, en el mismo plano y que juntos forman el cuadrilátero convexo q r p s
+        auto tryMerge = [&](const uint32_t* first, const uint32_t* second, uint32_t quad[4]) {
+            for (uint32_t e = 0; e < 3; e++) {
+                uint32_t p = first[e];
+                uint32_t q = first[(e + 1) % 3];
+                uint32_t r = first[(e + 2) % 3];
+                for (uint32_t f = 0; f < 3; f++) {
+                    if (second[f] != q || second[(f + 1) % 3] != p) {
+                        continue;
+                    }
+                    uint32_t s = second[(f + 2) % 3];
+                    if (s == r) {
+                        return false;
+                    }
+                    Vector3 normal = Cross(positions[q] - positions[p], positions[r] - positions[p]);
+                    Vector3 otherNormal = Cross(positions[p] - positions[q], positions[s] - positions[q]);
+                    Vector3 deviation = Cross(normal, otherNormal);
+                    float scale = std::sqrt(Dot(normal, normal) * Dot(otherNormal, otherNormal));
+                    if (Dot(normal, otherNormal) <= 0.0f || std::sqrt(Dot(deviation, deviation)) > COPLANAR_TOLERANCE * scale) {
+                        return false;
+                    }
+                    quad[0] = q;
+                    quad[1] = r;
+                    quad[2] = p;
+                    quad[3] = s;
+                    for (uint32_t k = 0; k < 4; k++) {
+                        const Vector3& a = positions[quad[k]];
+                        const Vector3& b = positions[quad[(k + 1) % 4]];
+                        const Vector3& c = positions[quad[(k + 2) % 4]];
+                        if (Dot(Cross(b - a, c - b), normal) <= 0.0f) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+            }
+            return false;
+        };
+        m_primitives.reserve(triangles.size() / 3 * 4);
+        for (size_t i = 0; i < triangles.size();) {
+            uint32_t quad[4];
+            if (i + 3 < triangles.size() && tryMerge(&triangles[i], &triangles[i + 3], quad)) {
+                m_primitives.insert(m_primitives.end(), quad, quad + 4);
+                i += 6;
+            }
+            else {
+                m_primitives.insert(m_primitives.end(), { triangles[i], triangles[i + 1], triangles[i + 2], triangles[i + 2] });
+                i += 3;
+            }
+        }
+
+        float boundsMin[3] = { INFINITY, INFINITY, INFINITY };
+        float boundsMax[3] = { -INFINITY, -INFINITY, -INFINITY };
+        for (std::vector<float>& axis : m_positions) {
+            axis.reserve(positions.size());
+        }
+        for (const Vector3& position : positions) {
+            const float values[3] = { position.x, position.y, position.z };
+            for (uint32_t axis = 0; axis < 3; axis++) {
+                m_positions[axis].push_back(values[axis]);
+                boundsMin[axis] = std::min(boundsMin[axis], values[axis]);
+                boundsMax[axis] = std::max(boundsMax[axis], values[axis]);
+            }
+        }
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            m_boundsCenter[axis] = (boundsMin[axis] + boundsMax[axis]) * 0.5f;
+            m_boundsExtent[axis] = (boundsMax[axis] - boundsMin[axis]) * 0.5f;
+        }
+        return true;
+    }
+
+    // Primitiva en pantalla. Aristas E = A*(x - originX) + B*(y - originY) + C normalizadas
+    // (|A| + |B| = 1) y ya desplazadas media diagonal: E >= 0 en el centro de un píxel significa
+    // que el píxel entero está dentro. depth da la z más lejana de la primitiva dentro del píxel
+    struct OcclusionCuller::SetupPrimitive {
+        float edgeA[4];
+        float edgeB[4];
+        float edgeC[4];
+        float depth[3];                 // Valor en el origen, d/dx, d/dy
+        float originX, originY;
+        int32_t minX, minY, maxX, maxY; // Píxeles que puede cubrir enteros (inclusivo)
+    };
+
+    // Setup de un rango contiguo de primitivas: cada tile guarda índices a primitives
+    struct OcclusionCuller::Chunk {
+        std::vector<SetupPrimitive> primitives;
+        std::vector<std::vector<uint32_t>> bins;
+    };
+
+    OcclusionCuller::OcclusionCuller() = default;
+    OcclusionCuller::~OcclusionCuller() = default;
+
+    bool OcclusionCuller::Initialize(uint32_t width, uint32_t height) {
+        if (width == 0 || height == 0) {
+            std::cerr << "Error: Depth buffer de oclusion vacio (" << width << "x" << height << ")" << std::endl;
+            return false;
+        }
+        m_width = (width + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+        m_height = (height + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+        m_blocksX = m_width / BLOCK_SIZE;
+        m_blocksY = m_height / BLOCK_SIZE;
+        m_tilesX = (m_width + TILE_SIZE - 1) / TILE_SIZE;
+        m_tilesY = (m_height + TILE_SIZE - 1) / TILE_SIZE;
+        m_depth.assign(static_cast<size_t>(m_width) * m_height, 1.0f);
+
+        // Nivel 0: un texel por bloque; cada nivel siguiente, la mitad redondeando hacia arriba
+        m_hiZ.clear();
+        uint32_t levelWidth = m_blocksX;
+        uint32_t levelHeight = m_blocksY;
+        while (true) {
+            HiZLevel level;
+            level.width = levelWidth;
+            level.height = levelHeight;
+            level.depth.assign(static_cast<size_t>(levelWidth) * levelHeight, 1.0f);
+            m_hiZ.push_back(std::move(level));
+            if (levelWidth == 1 && levelHeight == 1) {
+                break;
+            }
+            levelWidth = (levelWidth + 1) / 2;
+            levelHeight = (levelHeight + 1) / 2;
+        }
+        m_hasOccluders = false;
+        m_lastOccludersValid = false;
+        m_lastVisible.clear();
+        return true;
+    }
+
+    void OcclusionCuller::Shutdown() {
+        m_depth.clear();
+        m_hiZ.clear();
+        m_occluders.clear();
+        m_lastOccluders.clear();
+        m_activeOccluders.clear();
+        m_chunks.clear();
+        m_chunkCount = 0;
+        m_hasOccluders = false;
+        m_lastOccludersValid = false;
+        m_width = m_height = 0;
+    }
+
+    void OcclusionCuller::BeginFrame(const Float4x4& viewProjection, uint32_t objectCount) {
+        m_viewProjection = viewProjection;
+        m_occluders.clear();
+        // Los objetos nuevos empiezan visibles
+        m_lastVisible.resize(objectCount, 1);
+    }
+
+    void OcclusionCuller::BeginFrame(const CameraProxy& camera, uint32_t objectCount) {
+        BeginFrame(Multiply(camera.view, camera.projection), objectCount);
+    }
+
+    void OcclusionCuller::AddOccluder(const OcclusionMesh& mesh, const Float4x4& world, uint32_t objectIndex) {
+        if (objectIndex < m_lastVisible.size() && !m_lastVisible[objectIndex]) {
+            m_stats.occludersSkipped++;
+            return;
+        }
+        m_occluders.push_back({ &mesh, world, objectIndex });
+    }
+
+    bool OcclusionCuller::SameOccludersAsLastFrame() const {
+        if (!m_lastOccludersValid || m_occluders.size() != m_lastOccluders.size() ||
+            std::memcmp(&m_viewProjection, &m_lastViewProjection, sizeof(Float4x4)) != 0) {
+            return false;
+        }
+        for (size_t i = 0; i < m_occluders.size(); i++) {
+            if (m_occluders[i].mesh != m_lastOccluders[i].mesh ||
+                std::memcmp(&m_occluders[i].world, &m_lastOccluders[i].world, sizeof(Float4x4)) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void OcclusionCuller::RenderOccluders(JobSystem* jobs) {
+        if (m_depth.empty()) {
+            std::cerr << "Error: OcclusionCuller::RenderOccluders sin Initialize" << std::endl;
+            return;
+        }
+        int64_t start = FramePacer::Now();
+        m_stats.frames++;
+        if (SameOccludersAsLastFrame()) {
+            m_stats.framesReused++;
+            m_stats.rasterMs += (FramePacer::Now() - start) / 1000000.0;
+            return;
+        }
+        m_lastOccluders = m_occluders;
+        m_lastViewProjection = m_viewProjection;
+        m_lastOccludersValid = true;
+
+        // Fuera los oclusores que no se ven o que ocupan muy poco en pantalla
+        const float width = static_cast<float>(m_width);
+        const float height = static_cast<float>(m_height);
+        m_activeOccluders.clear();
+        for (const Occluder& occluder : m_occluders) {
+            ActiveOccluder active;
+            active.mesh = occluder.mesh;
+            active.worldViewProjection = Multiply(occluder.world, m_viewProjection);
+            float rect[4];
+            float minZ;
+            BoxProjection projection = ProjectBox(occluder.mesh->GetBoundsCenter(), occluder.mesh->GetBoundsExtent(),
+                active.worldViewProjection, width, height, rect, minZ);
+            if (projection == BoxProjection::Outside) {
+                m_stats.occludersSkipped++;
+                continue;
+            }
+            if (projection == BoxProjection::Projected) {
+                float visibleWidth = std::min(rect[2], width) - std::max(rect[0], 0.0f);
+                float visibleHeight = std::min(rect[3], height) - std::max(rect[1], 0.0f);
+                if (visibleWidth <= 0.0f || visibleHeight <= 0.0f || visibleWidth * visibleHeight < MIN_OCCLUDER_AREA) {
+                    m_stats.occludersSkipped++;
+                    continue;
+                }
+            }
+            m_activeOccluders.push_back(active);
+        }
+        m_stats.occluders += m_activeOccluders.size();
+
+        std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+        m_hasOccluders = !m_activeOccluders.empty();
+        if (m_hasOccluders) {
+            TransformVertices(jobs);
+            SetupPrimitives(jobs);
+            RasterizeTiles(jobs);
+            BuildHiZ(jobs);
+        }
+        m_stats.rasterMs += (FramePacer::Now() - start) / 1000000.0;
+    }
+
+    void OcclusionCuller::TransformVertices(JobSystem* jobs) {
+        const uint32_t occluderCount = static_cast<uint32_t>(m_activeOccluders.size());
+        m_vertexOffsets.resize(occluderCount + 1);
+        m_primitiveOffsets.resize(occluderCount + 1);
+        m_vertexOffsets[0] = 0;
+        m_primitiveOffsets[0] = 0;
+        for (uint32_t i = 0; i < occluderCount; i++) {
+            m_vertexOffsets[i + 1] = m_vertexOffsets[i] + m_activeOccluders[i].mesh->GetVertexCount();
+            m_primitiveOffsets[i + 1] = m_primitiveOffsets[i] + m_activeOccluders[i].mesh->GetPrimitiveCount();
+        }
+        const uint32_t vertexTotal = m_vertexOffsets.back();
+        for (std::vector<float>& column : m_vertices) {
+            column.resize(vertexTotal);
+        }
+
+        // Lotes de vértices consecutivos aunque crucen de un oclusor al siguiente
+        const float width = static_cast<float>(m_width);
+        const float height = static_cast<float>(m_height);
+        JobSystem::ParallelFor(jobs, vertexTotal, VERTEX_BATCH, [&](uint32_t begin, uint32_t end, uint32_t) {
+            uint32_t occluder = static_cast<uint32_t>(std::upper_bound(m_vertexOffsets.begin(), m_vertexOffsets.end(), begin) -
+                m_vertexOffsets.begin()) - 1;
+            uint32_t current = begin;
+            while (current < end) {
+                while (m_vertexOffsets[occluder + 1] <= current) {
+                    occluder++;
+                }
+                const ActiveOccluder& active = m_activeOccluders[occluder];
+                const uint32_t local = current - m_vertexOffsets[occluder];
+                const uint32_t segmentEnd = std::min(end, m_vertexOffsets[occluder + 1]);
+                const float* input[3] = { active.mesh->GetPositions(0) + local, active.mesh->GetPositions(1) + local,
+                    active.mesh->GetPositions(2) + local };
+                float* output[4] = { m_vertices[0].data() + current, m_vertices[1].data() + current,
+                    m_vertices[2].data() + current, m_vertices[3].data() + current };
+                BatchMath::ProjectPoints(input, active.worldViewProjection, output, segmentEnd - current);
+                current = segmentEnd;
+            }
+
+            // A pantalla (y hacia abajo) una sola vez por vértice; los que quedan delante del
+            // plano near se marcan con w = -1
+            float* x = m_vertices[0].data();
+            float* y = m_vertices[1].data();
+            float* z = m_vertices[2].data();
+            float* w = m_vertices[3].data();
+            for (uint32_t i = begin; i < end; i++) {
+                if (z[i] < 0.0f || w[i] <= 0.0f) {
+                    w[i] = -1.0f;
+                    continue;
+                }
+                const float invW = 1.0f / w[i];
+                x[i] = (x[i] * invW * 0.5f + 0.5f) * width;
+                y[i] = (0.5f - y[i] * invW * 0.5f) * height;
+                z[i] *= invW;
+            }
+        });
+    }
+
+    void OcclusionCuller::SetupPrimitives(JobSystem* jobs) {
+        const uint32_t primitiveTotal = m_primitiveOffsets.back();
+        const uint32_t tileCount = m_tilesX * m_tilesY;
+        const uint32_t threadCount = jobs ? jobs->GetThreadCount() : 1;
+        const uint32_t primitivesPerChunk = std::max(MIN_PRIMITIVES_PER_CHUNK, primitiveTotal / (threadCount * CHUNKS_PER_THREAD) + 1);
+        m_chunkCount = (primitiveTotal + primitivesPerChunk - 1) / primitivesPerChunk;
+        if (m_chunks.size() < m_chunkCount) {
+            m_chunks.resize(m_chunkCount);
+        }
+        for (uint32_t c = 0; c < m_chunkCount; c++) {
+            m_chunks[c].primitives.clear();
+            m_chunks[c].bins.resize(tileCount);
+            for (std::vector<uint32_t>& bin : m_chunks[c].bins) {
+                bin.clear();
+            }
+        }
+
+        const float width = static_cast<float>(m_width);
+        const float height = static_cast<float>(m_height);
+        JobSystem::ParallelFor(jobs, m_chunkCount, 1, [&](uint32_t chunkBegin, uint32_t chunkEnd, uint32_t) {
+            for (uint32_t chunkIndex = chunkBegin; chunkIndex < chunkEnd; chunkIndex++) {
+                Chunk& chunk = m_chunks[chunkIndex];
+                const uint32_t first = chunkIndex * primitivesPerChunk;
+                const uint32_t last = std::min(primitiveTotal, first + primitivesPerChunk);
+                uint32_t occluder = static_cast<uint32_t>(std::upper_bound(m_primitiveOffsets.begin(), m_primitiveOffsets.end(),
+                    first) - m_primitiveOffsets.begin()) - 1;
+
+                for (uint32_t primitive = first; primitive < last; primitive++) {
+                    while (m_primitiveOffsets[occluder + 1] <= primitive) {
+                        occluder++;
+                    }
+                    const OcclusionMesh& mesh = *m_activeOccluders[occluder].mesh;
+                    const uint32_t* indices = mesh.GetPrimitives() + (primitive - m_primitiveOffsets[occluder]) * 4;
+                    const uint32_t vertexCount = indices[3] == indices[2] ? 3 : 4;
+
+                    // Las que cruzan near no se rasterizan: su parte recortada no taparía nada en el render
+                    uint32_t vertices[4];
+                    bool crossesNear = false;
+                    for (uint32_t k = 0; k < vertexCount; k++) {
+                        vertices[k] = m_vertexOffsets[occluder] + indices[k];
+                        crossesNear |= m_vertices[3][vertices[k]] < 0.0f;
+                    }
+                    if (crossesNear) {
+                        continue;
+                    }
+
+                    // Descarte rápido en float de las que quedan fuera de pantalla o no llegan a
+                    // cubrir un píxel entero y, en mallas cerradas, de las traseras claras (con
+                    // margen para el redondeo); el resto se decide abajo en double
+                    float fastX[4], fastY[4];
+                    for (uint32_t k = 0; k < vertexCount; k++) {
+                        fastX[k] = m_vertices[0][vertices[k]];
+                        fastY[k] = m_vertices[1][vertices[k]];
+                    }
+                    const float fastMinX = *std::min_element(fastX, fastX + vertexCount);
+                    const float fastMaxX = *std::max_element(fastX, fastX + vertexCount);
+                    const float fastMinY = *std::min_element(fastY, fastY + vertexCount);
+                    const float fastMaxY = *std::max_element(fastY, fastY + vertexCount);
+                    if (fastMaxX < 1.0f || fastMaxY < 1.0f || fastMinX > width - 1.0f || fastMinY > height - 1.0f ||
+                        fastMaxX - fastMinX < 0.999f || fastMaxY - fastMinY < 0.999f) {
+                        continue;
+                    }
+                    if (mesh.IsClosed()) {
+                        float fastArea = 0.0f;
+                        float magnitude = 0.0f;
+                        for (uint32_t k = 0; k < vertexCount; k++) {
+                            uint32_t next = (k + 1) % vertexCount;
+                            fastArea += fastX[k] * fastY[next] - fastX[next] * fastY[k];
+                            magnitude += std::fabs(fastX[k] * fastY[next]) + std::fabs(fastX[next] * fastY[k]);
+                        }
+                        if (fastArea < -1e-5f * magnitude) {
+                            continue;
+                        }
+                    }
+
+                    double x[4], y[4], z[4];
+                    for (uint32_t k = 0; k < vertexCount; k++) {
+                        x[k] = fastX[k];
+                        y[k] = fastY[k];
+                        z[k] = m_vertices[2][vertices[k]];
+                    }
+
+                    // Área con signo (positiva en sentido horario en pantalla, la cara delantera
+                    // del PSO). De una malla cerrada solo se rasterizan las delanteras
+                    double area = 0.0;
+                    for (uint32_t k = 0; k < vertexCount; k++) {
+                        uint32_t next = (k + 1) % vertexCount;
+                        area += x[k] * y[next] - x[next] * y[k];
+                    }
+                    if (area == 0.0 || (area < 0.0 && mesh.IsClosed())) {
+                        continue;
+                    }
+                    if (area < 0.0) {
+                        std::reverse(x, x + vertexCount);
+                        std::reverse(y, y + vertexCount);
+                        std::reverse(z, z + vertexCount);
+                    }
+
+                    // Píxeles que pueden quedar dentro enteros: [i, i + 1] dentro del rectángulo
+                    double minX = *std::min_element(x, x + vertexCount);
+                    double maxX = *std::max_element(x, x + vertexCount);
+                    double minY = *std::min_element(y, y + vertexCount);
+                    double maxY = *std::max_element(y, y + vertexCount);
+                    int32_t pixelMinX = static_cast<int32_t>(std::clamp(std::ceil(minX), 0.0, static_cast<double>(width)));
+                    int32_t pixelMinY = static_cast<int32_t>(std::clamp(std::ceil(minY), 0.0, static_cast<double>(height)));
+                    int32_t pixelMaxX = static_cast<int32_t>(std::clamp(std::floor(maxX), 0.0, static_cast<double>(width))) - 1;
+                    int32_t pixelMaxY = static_cast<int32_t>(std::clamp(std::floor(maxY), 0.0, static_cast<double>(height))) - 1;
+                    if (pixelMinX > pixelMaxX || pixelMinY > pixelMaxY) {
+                        continue;
+                    }
+
+                    SetupPrimitive setup;
+                    setup.minX = pixelMinX;
+                    setup.minY = pixelMinY;
+                    setup.maxX = pixelMaxX;
+                    setup.maxY = pixelMaxY;
+                    const double originX = pixelMinX + 0.5;
+                    const double originY = pixelMinY + 0.5;
+                    setup.originX = static_cast<float>(originX);
+                    setup.originY = static_cast<float>(originY);
+                    for (uint32_t edge = 0; edge < 4; edge++) {
+                        if (edge >= vertexCount) {
+                            // Los triángulos dejan la cuarta arista siempre dentro
+                            setup.edgeA[edge] = 0.0f;
+                            setup.edgeB[edge] = 0.0f;
+                            setup.edgeC[edge] = 0.0f;
+                            continue;
+                        }
+                        uint32_t next = (edge + 1) % vertexCount;
+                        double a = y[edge] - y[next];
+                        double b = x[next] - x[edge];
+                        double norm = std::fabs(a) + std::fabs(b);
+                        double c = a * (originX - x[edge]) + b * (originY - y[edge]);
+                        setup.edgeA[edge] = static_cast<float>(a / norm);
+                        setup.edgeB[edge] = static_cast<float>(b / norm);
+                        setup.edgeC[edge] = static_cast<float>(c / norm - 0.5 - COVERAGE_MARGIN);
+                    }
+
+                    // Plano de z desde el triángulo de más área del polígono; en un quad casi
+                    // plano, lo que el cuarto vértice quede por detrás se suma al plano entero
+                    uint32_t second = 1;
+                    uint32_t third = 2;
+                    if (vertexCount == 4) {
+                        double areaFirst = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+                        double areaSecond = (x[2] - x[0]) * (y[3] - y[0]) - (x[3] - x[0]) * (y[2] - y[0]);
+                        if (areaSecond > areaFirst) {
+                            second = 2;
+                            third = 3;
+                        }
+                    }
+                    double determinant = (x[second] - x[0]) * (y[third] - y[0]) - (x[third] - x[0]) * (y[second] - y[0]);
+                    if (determinant <= 0.0) {
+                        continue;
+                    }
+                    double dzdx = ((z[second] - z[0]) * (y[third] - y[0]) - (z[third] - z[0]) * (y[second] - y[0])) / determinant;
+                    double dzdy = ((z[third] - z[0]) * (x[second] - x[0]) - (z[second] - z[0]) * (x[third] - x[0])) / determinant;
+                    double deviation = 0.0;
+                    for (uint32_t k = 0; k < vertexCount; k++) {
+                        deviation = std::max(deviation, z[k] - (z[0] + dzdx * (x[k] - x[0]) + dzdy * (y[k] - y[0])));
+                    }
+                    setup.depth[0] = static_cast<float>(z[0] + dzdx * (originX - x[0]) + dzdy * (originY - y[0]) + deviation +
+                        0.5 * (std::fabs(dzdx) + std::fabs(dzdy))) + DEPTH_MARGIN;
+                    setup.depth[1] = static_cast<float>(dzdx);
+                    setup.depth[2] = static_cast<float>(dzdy);
+
+                    const uint32_t index = static_cast<uint32_t>(chunk.primitives.size());
+                    chunk.primitives.push_back(setup);
+                    for (uint32_t tileY = pixelMinY / TILE_SIZE; tileY <= pixelMaxY / TILE_SIZE; tileY++) {
+                        for (uint32_t tileX = pixelMinX / TILE_SIZE; tileX <= pixelMaxX / TILE_SIZE; tileX++) {
+                            chunk.bins[tileY * m_tilesX + tileX].push_back(index);
+                        }
+                    }
+                }
+            }
+        });
+
+        for (uint32_t c = 0; c < m_chunkCount; c++) {
+            m_stats.primitives += m_chunks[c].primitives.size();
+        }
+    }
+
+    void OcclusionCuller::RasterizeTiles(JobSystem* jobs) {
+        // La escritura es un mínimo: el orden entre primitivas no importa y cada tile es de un hilo
+        JobSystem::ParallelFor(jobs, m_tilesX * m_tilesY, 1, [this](uint32_t begin, uint32_t end, uint32_t) {
+            for (uint32_t tile = begin; tile < end; tile++) {
+                RasterizeTile(tile % m_tilesX, tile / m_tilesX);
+            }
+        });
+    }
+
+    void OcclusionCuller::RasterizeTile(uint32_t tileX, uint32_t tileY) {
+        const uint32_t tile = tileY * m_tilesX + tileX;
+        const int32_t tileMinX = static_cast<int32_t>(tileX * TILE_SIZE);
+        const int32_t tileMinY = static_cast<int32_t>(tileY * TILE_SIZE);
+        const int32_t tileMaxX = std::min<int32_t>(tileMinX + TILE_SIZE, m_width) - 1;
+        const int32_t tileMaxY = std::min<int32_t>(tileMinY + TILE_SIZE, m_height) - 1;
+        float* depthBuffer = m_depth.data();
+
+        for (uint32_t c = 0; c < m_chunkCount; c++) {
+            const Chunk& chunk = m_chunks[c];
+            for (uint32_t index : chunk.bins[tile]) {
+                const SetupPrimitive& primitive = chunk.primitives[index];
+                const int32_t minY = std::max(primitive.minY, tileMinY);
+                const int32_t maxY = std::min(primitive.maxY, tileMaxY);
+                // Bloques enteros: los carriles fuera del polígono fallan alguna arista
+                const int32_t firstBlock = std::max(primitive.minX, tileMinX) / static_cast<int32_t>(BLOCK_SIZE);
+                const int32_t lastBlock = std::min(primitive.maxX, tileMaxX) / static_cast<int32_t>(BLOCK_SIZE);
+                Float4 edgeA[4];
+                for (uint32_t edge = 0; edge < 4; edge++) {
+                    edgeA[edge] = Float4::Set(primitive.edgeA[edge]);
+                }
+                const Float4 depthDx = Float4::Set(primitive.depth[1]);
+                const Float4 zero = Float4::Set(0.0f);
+
+                for (int32_t y = minY; y <= maxY; y++) {
+                    const float dy = static_cast<float>(y) + 0.5f - primitive.originY;
+                    Float4 edgeRow[4];
+                    for (uint32_t edge = 0; edge < 4; edge++) {
+                        edgeRow[edge] = Float4::Set(primitive.edgeB[edge] * dy + primitive.edgeC[edge]);
+                    }
+                    const Float4 depthRow = Float4::Set(primitive.depth[0] + primitive.depth[2] * dy);
+                    float* row = depthBuffer + (static_cast<size_t>(y / BLOCK_SIZE) * m_blocksX) * BLOCK_SIZE * BLOCK_SIZE +
+                        (y % BLOCK_SIZE) * BLOCK_SIZE;
+
+                    for (int32_t block = firstBlock; block <= lastBlock; block++) {
+                        const Float4 dx = Float4::Ramp(static_cast<float>(block * BLOCK_SIZE) + 0.5f - primitive.originX);
+                        Float4 mask = CmpGreaterEqual(edgeA[0] * dx + edgeRow[0], zero);
+                        for (uint32_t edge = 1; edge < 4; edge++) {
+                            mask = mask & CmpGreaterEqual(edgeA[edge] * dx + edgeRow[edge], zero);
+                        }
+                        if (MoveMask(mask) == 0) {
+                            continue;
+                        }
+                        float* pixels = row + static_cast<size_t>(block) * BLOCK_SIZE * BLOCK_SIZE;
+                        const Float4 stored = Float4::Load(pixels);
+                        Min(stored, Select(mask, depthRow + depthDx * dx, stored)).Store(pixels);
+                    }
+                }
+            }
+        }
+    }
+
+    void OcclusionCuller::BuildHiZ(JobSystem* jobs) {
+        // Nivel 0: máximo de cada bloque (4 filas de 4 píxeles)
+        HiZLevel& base = m_hiZ[0];
+        JobSystem::ParallelFor(jobs, m_blocksY, 8, [&](uint32_t begin, uint32_t end, uint32_t) {
+            for (uint32_t blockY = begin; blockY < end; blockY++) {
+                for (uint32_t blockX = 0; blockX < m_blocksX; blockX++) {
+                    const float* pixels = m_depth.data() + (static_cast<size_t>(blockY) * m_blocksX + blockX) * BLOCK_SIZE * BLOCK_SIZE;
+                    Float4 maximum = Max(Max(Float4::Load(pixels), Float4::Load(pixels + 4)),
+                        Max(Float4::Load(pixels + 8), Float4::Load(pixels + 12)));
+                    float lanes[4];
+                    maximum.Store(lanes);
+                    base.depth[static_cast<size_t>(blockY) * base.width + blockX] =
+                        std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+                }
+            }
+        });
+
+        // Resto: máximo de 2x2 texels del nivel anterior (1 o 2 en el borde de tamaños impares)
+        for (size_t level = 1; level < m_hiZ.size(); level++) {
+            const HiZLevel& source = m_hiZ[level - 1];
+            HiZLevel& target = m_hiZ[level];
+            for (uint32_t y = 0; y < target.height; y++) {
+                const uint32_t y0 = y * 2;
+                const uint32_t y1 = std::min(y0 + 1, source.height - 1);
+                for (uint32_t x = 0; x < target.width; x++) {
+                    const uint32_t x0 = x * 2;
+                    const uint32_t x1 = std::min(x0 + 1, source.width - 1);
+                    target.depth[static_cast<size_t>(y) * target.width + x] = std::max(
+                        std::max(source.depth[static_cast<size_t>(y0) * source.width + x0], source.depth[static_cast<size_t>(y0) * source.width + x1]),
+                        std::max(source.depth[static_cast<size_t>(y1) * source.width + x0], source.depth[static_cast<size_t>(y1) * source.width + x1]));
+                }
+            }
+        }
+    }
+
+    float OcclusionCuller::GetHiZ(uint32_t level, uint32_t x, uint32_t y) const {
+        if (level >= m_hiZ.size() || x >= m_hiZ[level].width || y >= m_hiZ[level].height) {
+            return 1.0f;
+        }
+        return m_hiZ[level].depth[static_cast<size_t>(y) * m_hiZ[level].width + x];
+    }
+
+    bool OcclusionCuller::IsOccluded(const CullingBounds& bounds, uint32_t index) const {
+        const float center[3] = { bounds.GetCenters(0)[index], bounds.GetCenters(1)[index], bounds.GetCenters(2)[index] };
+        const float extent[3] = { bounds.GetExtents(0)[index], bounds.GetExtents(1)[index], bounds.GetExtents(2)[index] };
+        float rect[4];
+        float minZ;
+        // Lo que queda fuera del frustum lo decide el frustum culling
+        if (ProjectBox(center, extent, m_viewProjection, static_cast<float>(m_width), static_cast<float>(m_height), rect, minZ) !=
+            BoxProjection::Projected) {
+            return false;
+        }
+        // Píxeles que toca el rectángulo, en bloques
+        const uint32_t blockMinX = static_cast<uint32_t>(std::max(0.0f, rect[0])) / BLOCK_SIZE;
+        const uint32_t blockMinY = static_cast<uint32_t>(std::max(0.0f, rect[1])) / BLOCK_SIZE;
+        const uint32_t blockMaxX = static_cast<uint32_t>(std::min(static_cast<float>(m_width - 1), rect[2])) / BLOCK_SIZE;
+        const uint32_t blockMaxY = static_cast<uint32_t>(std::min(static_cast<float>(m_height - 1), rect[3])) / BLOCK_SIZE;
+
+        // Nivel donde el rectángulo ocupa como mucho 4x4 texels (el último es 1x1)
+        uint32_t level = 0;
+        while (level + 1 < m_hiZ.size() && ((blockMaxX >> level) - (blockMinX >> level) >= 4 ||
+            (blockMaxY >> level) - (blockMinY >> level) >= 4)) {
+            level++;
+        }
+        const HiZLevel& hiZ = m_hiZ[level];
+        for (uint32_t y = blockMinY >> level; y <= blockMaxY >> level; y++) {
+            for (uint32_t x = blockMinX >> level; x <= blockMaxX >> level; x++) {
+                if (hiZ.depth[static_cast<size_t>(y) * hiZ.width + x] >= minZ) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    uint32_t OcclusionCuller::Test(const CullingBounds& bounds, const uint32_t* candidates, uint32_t candidateCount, JobSystem* jobs) {
+        int64_t start = FramePacer::Now();
+        if (m_visible.size() < candidateCount) {
+            m_visible.resize(candidateCount);
+        }
+        if (m_lastVisible.size() < bounds.GetCount()) {
+            m_lastVisible.resize(bounds.GetCount(), 1);
+        }
+
+        uint32_t visible = 0;
+        if (!m_hasOccluders) {
+            // Pirámide vacía: todo visible sin proyectar nada
+            std::memcpy(m_visible.data(), candidates, candidateCount * sizeof(uint32_t));
+            for (uint32_t i = 0; i < candidateCount; i++) {
+                m_lastVisible[candidates[i]] = 1;
+            }
+            visible = candidateCount;
+        }
+        else {
+            const uint32_t batchCount = (candidateCount + TEST_BATCH - 1) / TEST_BATCH;
+            m_batchVisible.resize(batchCount);
+            JobSystem::ParallelFor(jobs, batchCount, 1, [&](uint32_t batchBegin, uint32_t batchEnd, uint32_t) {
+                for (uint32_t batch = batchBegin; batch < batchEnd; batch++) {
+                    const uint32_t begin = batch * TEST_BATCH;
+                    const uint32_t end = std::min(candidateCount, begin + TEST_BATCH);
+                    uint32_t* output = m_visible.data() + begin;
+                    uint32_t count = 0;
+                    for (uint32_t i = begin; i < end; i++) {
+                        const uint32_t index = candidates[i];
+                        const bool occluded = IsOccluded(bounds, index);
+                        m_lastVisible[index] = occluded ? 0 : 1;
+                        if (!occluded) {
+                            output[count++] = index;
+                        }
+                    }
+                    m_batchVisible[batch] = count;
+                }
+            });
+            for (uint32_t batch = 0; batch < batchCount; batch++) {
+                if (visible != batch * TEST_BATCH && m_batchVisible[batch] > 0) {
+                    std::memmove(m_visible.data() + visible, m_visible.data() + batch * TEST_BATCH,
+                        m_batchVisible[batch] * sizeof(uint32_t));
+                }
+                visible += m_batchVisible[batch];
+            }
+        }
+
+        m_stats.tested += candidateCount;
+        m_stats.culled += candidateCount - visible;
+        m_stats.lastTested = candidateCount;
+        m_stats.lastCulled = candidateCount - visible;
+        m_stats.testMs += (FramePacer::Now() - start) / 1000000.0;
+        return visible;
+    }
+
+    std::string OcclusionCuller::BuildReport() const {
+        std::ostringstream report;
+        report.setf(std::ios::fixed);
+        report.precision(1);
+        auto percent = [](uint64_t part, uint64_t total) { return total > 0 ? 100.0 * part / total : 0.0; };
+        report << "Depth buffer " << m_width << "x" << m_height << " (" << m_hiZ.size() << " niveles de HiZ), frames: "
+               << m_stats.frames << ", reutilizados: " << m_stats.framesReused << "\n";
+        report << "Oclusores: " << m_stats.occluders << " rasterizados, " << m_stats.occludersSkipped
+               << " descartados; primitivas: " << m_stats.primitives << "\n";
+        report << "Objetos probados: " << m_stats.tested << ", ocluidos: " << m_stats.culled << " ("
+               << percent(m_stats.culled, m_stats.tested) << "%)\n";
+        report << "Ultimo frame: " << m_stats.lastCulled << " de " << m_stats.lastTested << " ocluidos ("
+               << percent(m_stats.lastCulled, m_stats.lastTested) << "%)\n";
+        report.precision(3);
+        const double frames = m_stats.frames > 0 ? static_cast<double>(m_stats.frames) : 1.0;
+        report << "Tiempo por frame: oclusores " << m_stats.rasterMs / frames << " ms, pruebas " << m_stats.testMs / frames << " ms\n";
+        return report.str();
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,111 @@
+#include "RadixSort.h"
+#include <algorithm>
+#include <cstring>
+
+namespace D3D12Core {
+
+    RadixSortStats RadixSorter::Sort(uint64_t* keys, uint32_t* values, uint32_t count, JobSystem* jobs) {
+        RadixSortStats stats;
+        if (count < 2) {
+            return stats;
+        }
+
+        const uint32_t threadCount = jobs ? jobs->GetThreadCount() : 1;
+        const uint32_t blockCount = std::max(1u, std::min(threadCount, count / MIN_BLOCK_SIZE));
+        const uint32_t blockSize = (count + blockCount - 1) / blockCount;
+        auto forEachBlock = [&](const JobSystem::RangeFunction& function) {
+            JobSystem::ParallelFor(jobs, blockCount, 1, function);
+        };
+
+        if (m_scratchKeys.size() < count) {
+            m_scratchKeys.resize(count);
+            m_scratchValues.resize(count);
+        }
+        m_histograms.resize(static_cast<size_t>(blockCount) * BUCKETS);
+        m_blockMasks.resize(static_cast<size_t>(blockCount) * 2);
+
+        // Bits que cambian entre claves: un dígito sin bits variables no reordena nada
+        forEachBlock([&](uint32_t blockBegin, uint32_t blockEnd, uint32_t) {
+            for (uint32_t block = blockBegin; block < blockEnd; block++) {
+                uint32_t begin = block * blockSize;
+                uint32_t end = std::min(count, begin + blockSize);
+                uint64_t andMask = ~0ull;
+                uint64_t orMask = 0;
+                for (uint32_t i = begin; i < end; i++) {
+                    andMask &= keys[i];
+                    orMask |= keys[i];
+                }
+                m_blockMasks[block * 2] = andMask;
+                m_blockMasks[block * 2 + 1] = orMask;
+            }
+        });
+        uint64_t andMask = ~0ull;
+        uint64_t orMask = 0;
+        for (uint32_t block = 0; block < blockCount; block++) {
+            andMask &= m_blockMasks[block * 2];
+            orMask |= m_blockMasks[block * 2 + 1];
+        }
+        const uint64_t varyingBits = andMask ^ orMask;
+
+        uint64_t* sourceKeys = keys;
+        uint32_t* sourceValues = values;
+        uint64_t* destinationKeys = m_scratchKeys.data();
+        uint32_t* destinationValues = m_scratchValues.data();
+        for (uint32_t shift = 0; shift < 64; shift += DIGIT_BITS) {
+            if (((varyingBits >> shift) & (BUCKETS - 1)) == 0) {
+                stats.skippedPasses++;
+                continue;
+            }
+            stats.passes++;
+
+            forEachBlock([&](uint32_t blockBegin, uint32_t blockEnd, uint32_t) {
+                for (uint32_t block = blockBegin; block < blockEnd; block++) {
+                    uint32_t* histogram = &m_histograms[static_cast<size_t>(block) * BUCKETS];
+                    std::fill(histogram, histogram + BUCKETS, 0u);
+                    uint32_t begin = block * blockSize;
+                    uint32_t end = std::min(count, begin + blockSize);
+                    for (uint32_t i = begin; i < end; i++) {
+                        histogram[(sourceKeys[i] >> shift) & (BUCKETS - 1)]++;
+                    }
+                }
+            });
+
+            // Inicio de cada (dígito, bloque): dígitos en orden y, dentro de cada uno, bloques en
+            // orden de entrada, así el reparto conserva el orden de las claves iguales
+            uint32_t offset = 0;
+            for (uint32_t digit = 0; digit < BUCKETS; digit++) {
+                for (uint32_t block = 0; block < blockCount; block++) {
+                    uint32_t& slot = m_histograms[static_cast<size_t>(block) * BUCKETS + digit];
+                    uint32_t digitCount = slot;
+                    slot = offset;
+                    offset += digitCount;
+                }
+            }
+
+            forEachBlock([&](uint32_t blockBegin, uint32_t blockEnd, uint32_t) {
+                for (uint32_t block = blockBegin; block < blockEnd; block++) {
+                    uint32_t* cursors = &m_histograms[static_cast<size_t>(block) * BUCKETS];
+                    uint32_t begin = block * blockSize;
+                    uint32_t end = std::min(count, begin + blockSize);
+                    for (uint32_t i = begin; i < end; i++) {
+                        uint64_t key = sourceKeys[i];
+                        uint32_t position = cursors[(key >> shift) & (BUCKETS - 1)]++;
+                        destinationKeys[position] = key;
+                        destinationValues[position] = sourceValues[i];
+                    }
+                }
+            });
+
+            std::swap(sourceKeys, destinationKeys);
+            std::swap(sourceValues, destinationValues);
+        }
+
+        // Con un número impar de pasadas el resultado quedó en los buffers internos
+        if (sourceKeys != keys) {
+            std::memcpy(keys, sourceKeys, static_cast<size_t>(count) * sizeof(uint64_t));
+            std::memcpy(values, sourceValues, static_cast<size_t>(count) * sizeof(uint32_t));
+        }
+        return stats;
+    }
+
+} // namespace D3D12Core
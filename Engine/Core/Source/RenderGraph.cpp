@@ -0,0 +1,428 @@
+#include "RenderGraph.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace D3D12Core {
+
+    namespace {
+
+        uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+            return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+        }
+
+        const char* UsageName(RenderGraphUsage usage) {
+            switch (usage) {
+            case RenderGraphUsage::RenderTarget: return "RenderTarget";
+            case RenderGraphUsage::DepthWrite: return "DepthWrite";
+            case RenderGraphUsage::DepthRead: return "DepthRead";
+            case RenderGraphUsage::ShaderResource: return "ShaderResource";
+            case RenderGraphUsage::UnorderedAccess: return "UnorderedAccess";
+            case RenderGraphUsage::CopySource: return "CopySource";
+            case RenderGraphUsage::CopyDest: return "CopyDest";
+            case RenderGraphUsage::Present: return "Present";
+            default: return "Undefined";
+            }
+        }
+
+    } // namespace
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::Read(RenderGraphResource resource, RenderGraphUsage usage) {
+        m_graph.AddAccess(m_pass, resource, usage, true, false);
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::Write(RenderGraphResource resource, RenderGraphUsage usage) {
+        m_graph.AddAccess(m_pass, resource, usage, false, true);
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::ReadWrite(RenderGraphResource resource, RenderGraphUsage usage) {
+        m_graph.AddAccess(m_pass, resource, usage, true, true);
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::SideEffects() {
+        m_graph.m_passes[m_pass].sideEffects = true;
+        return *this;
+    }
+
+    RenderGraph::RenderGraph() {
+    }
+
+    void RenderGraph::Reset() {
+        m_passes.clear();
+        m_resources.clear();
+        m_compiledPasses.clear();
+        m_finalTransitions.clear();
+        m_heapSizes.clear();
+        m_stats = Stats();
+        m_compiled = false;
+        m_valid = true;
+    }
+
+    RenderGraphResource RenderGraph::ImportTexture(const std::string& name, const RenderGraphTextureDesc& desc,
+        void* nativeResource, uint64_t nativeView, RenderGraphUsage initialUsage, RenderGraphUsage finalUsage) {
+        ResourceInfo info;
+        info.name = name;
+        info.desc = desc;
+        info.imported = true;
+        info.nativeResource = nativeResource;
+        info.nativeView = nativeView;
+        info.initialUsage = initialUsage;
+        info.finalUsage = finalUsage;
+        m_resources.push_back(info);
+        m_compiled = false;
+
+        RenderGraphResource handle;
+        handle.index = static_cast<uint32_t>(m_resources.size() - 1);
+        return handle;
+    }
+
+    RenderGraphResource RenderGraph::CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc) {
+        ResourceInfo info;
+        info.name = name;
+        info.desc = desc;
+        m_resources.push_back(info);
+        m_compiled = false;
+
+        RenderGraphResource handle;
+        handle.index = static_cast<uint32_t>(m_resources.size() - 1);
+        return handle;
+    }
+
+    RenderGraph::PassBuilder RenderGraph::AddPass(const std::string& name, ExecuteFunction execute) {
+        Pass pass;
+        pass.name = name;
+        pass.execute = std::move(execute);
+        m_passes.push_back(std::move(pass));
+        m_compiled = false;
+        return PassBuilder(*this, static_cast<uint32_t>(m_passes.size() - 1));
+    }
+
+    void RenderGraph::AddAccess(uint32_t pass, RenderGraphResource resource, RenderGraphUsage usage, bool read, bool write) {
+        if (!resource.IsValid() || resource.index >= m_resources.size() || usage == RenderGraphUsage::Undefined) {
+            std::cerr << "Error: Render graph pass '" << m_passes[pass].name << "' uses an invalid resource" << std::endl;
+            m_valid = false;
+            return;
+        }
+
+        // Un recurso tiene un único uso por pase: las transiciones se resuelven entre pases
+        for (Access& access : m_passes[pass].accesses) {
+            if (access.resource != resource) {
+                continue;
+            }
+            if (access.usage != usage) {
+                std::cerr << "Error: Render graph pass '" << m_passes[pass].name << "' uses '"
+                    << m_resources[resource.index].name << "' as both " << UsageName(access.usage)
+                    << " and " << UsageName(usage) << std::endl;
+                m_valid = false;
+                return;
+            }
+            access.read = access.read || read;
+            access.write = access.write || write;
+            return;
+        }
+
+        Access access;
+        access.resource = resource;
+        access.usage = usage;
+        access.read = read;
+        access.write = write;
+        m_passes[pass].accesses.push_back(access);
+    }
+
+    bool RenderGraph::Compile(RenderGraphBackend& backend) {
+        m_compiledPasses.clear();
+        m_finalTransitions.clear();
+        m_heapSizes.clear();
+        m_stats = Stats();
+        m_compiled = false;
+        if (!m_valid) {
+            return false;
+        }
+
+        CullPasses();
+        if (!ComputeLifetimes()) {
+            return false;
+        }
+        DeriveTransitions();
+        AssignMemory(backend);
+
+        m_stats.passes = static_cast<uint32_t>(m_passes.size());
+        m_stats.culledPasses = static_cast<uint32_t>(m_passes.size() - m_compiledPasses.size());
+        m_compiled = true;
+        return true;
+    }
+
+    void RenderGraph::CullPasses() {
+        // Recorrido inverso: un pase vive si tiene efectos externos o escribe algo que un pase
+        // vivo posterior lee. Los importados siempre se consideran leídos (salen del grafo)
+        std::vector<bool> needed(m_resources.size(), false);
+        for (size_t i = 0; i < m_resources.size(); ++i) {
+            needed[i] = m_resources[i].imported;
+        }
+
+        for (size_t p = m_passes.size(); p-- > 0;) {
+            Pass& pass = m_passes[p];
+            bool live = pass.sideEffects;
+            for (const Access& access : pass.accesses) {
+                if (access.write && needed[access.resource.index]) {
+                    live = true;
+                    break;
+                }
+            }
+
+            pass.culled = !live;
+            if (!live) {
+                continue;
+            }
+            for (const Access& access : pass.accesses) {
+                if (access.read) {
+                    needed[access.resource.index] = true;
+                }
+            }
+        }
+    }
+
+    bool RenderGraph::ComputeLifetimes() {
+        for (ResourceInfo& resource : m_resources) {
+            resource.usageMask = 0;
+            resource.used = false;
+            resource.aliased = false;
+            resource.heapOffset = 0;
+            resource.memory = RenderGraphMemoryRequirements();
+        }
+
+        for (uint32_t p = 0; p < m_passes.size(); ++p) {
+            const Pass& pass = m_passes[p];
+            if (pass.culled) {
+                continue;
+            }
+
+            const uint32_t compiledIndex = static_cast<uint32_t>(m_compiledPasses.size());
+            CompiledPass compiled;
+            compiled.pass = p;
+
+            for (const Access& access : pass.accesses) {
+                ResourceInfo& resource = m_resources[access.resource.index];
+                if (!resource.used) {
+                    if (!resource.imported && !access.write) {
+                        std::cerr << "Error: Render graph pass '" << pass.name << "' reads transient '"
+                            << resource.name << "' before any pass writes it" << std::endl;
+                        return false;
+                    }
+                    resource.used = true;
+                    resource.firstPass = compiledIndex;
+                    if (!resource.imported) {
+                        compiled.activations.push_back(access.resource);
+                    }
+                }
+                resource.lastPass = compiledIndex;
+                resource.usageMask |= UsageBit(access.usage);
+            }
+
+            m_compiledPasses.push_back(std::move(compiled));
+        }
+        return true;
+    }
+
+    void RenderGraph::DeriveTransitions() {
+        const uint32_t NOT_USED = 0xffffffffu;
+        std::vector<RenderGraphUsage> current(m_resources.size());
+        std::vector<uint32_t> lastUse(m_resources.size(), NOT_USED);
+        for (size_t i = 0; i < m_resources.size(); ++i) {
+            current[i] = m_resources[i].initialUsage;
+        }
+
+        for (uint32_t c = 0; c < m_compiledPasses.size(); ++c) {
+            for (const Access& access : m_passes[m_compiledPasses[c].pass].accesses) {
+                const uint32_t index = access.resource.index;
+                if (current[index] != access.usage) {
+                    Transition transition;
+                    transition.resource = access.resource;
+                    transition.before = current[index];
+                    transition.after = access.usage;
+
+                    // Con pases intermedios que no lo tocan, la transición empieza justo después
+                    // del último uso y se solapa con ellos (split barrier)
+                    if (lastUse[index] != NOT_USED && c > lastUse[index] + 1) {
+                        m_compiledPasses[lastUse[index] + 1].beginTransitions.push_back(transition);
+                        transition.split = true;
+                        ++m_stats.splitTransitions;
+                    }
+
+                    m_compiledPasses[c].transitions.push_back(transition);
+                    ++m_stats.transitions;
+                    current[index] = access.usage;
+                }
+                lastUse[index] = c;
+            }
+        }
+
+        for (size_t i = 0; i < m_resources.size(); ++i) {
+            const ResourceInfo& resource = m_resources[i];
+            if (!resource.imported || resource.finalUsage == RenderGraphUsage::Undefined || current[i] == resource.finalUsage) {
+                continue;
+            }
+            Transition transition;
+            transition.resource.index = static_cast<uint32_t>(i);
+            transition.before = current[i];
+            transition.after = resource.finalUsage;
+            m_finalTransitions.push_back(transition);
+            ++m_stats.transitions;
+        }
+    }
+
+    void RenderGraph::AssignMemory(RenderGraphBackend& backend) {
+        std::vector<uint32_t> transients;
+        for (uint32_t i = 0; i < m_resources.size(); ++i) {
+            ResourceInfo& resource = m_resources[i];
+            if (resource.imported || !resource.used) {
+                continue;
+            }
+            resource.memory = backend.GetMemoryRequirements(resource.desc, resource.usageMask);
+            m_stats.transientBytes += resource.memory.size;
+            ++m_stats.transientResources;
+            transients.push_back(i);
+        }
+
+        // Los grandes primero: los pequeños rellenan los huecos que dejan
+        std::stable_sort(transients.begin(), transients.end(), [this](uint32_t a, uint32_t b) {
+            const ResourceInfo& ra = m_resources[a];
+            const ResourceInfo& rb = m_resources[b];
+            if (ra.memory.size != rb.memory.size) {
+                return ra.memory.size > rb.memory.size;
+            }
+            return ra.firstPass < rb.firstPass;
+        });
+
+        auto lifetimesOverlap = [](const ResourceInfo& a, const ResourceInfo& b) {
+            return a.firstPass <= b.lastPass && b.firstPass <= a.lastPass;
+        };
+        auto memoryOverlaps = [](const ResourceInfo& a, const ResourceInfo& b) {
+            return a.memory.heapCategory == b.memory.heapCategory &&
+                a.heapOffset < b.heapOffset + b.memory.size && b.heapOffset < a.heapOffset + a.memory.size;
+        };
+
+        // Primer hueco (en orden de offset) libre durante toda la vida del recurso
+        std::vector<uint32_t> placed;
+        std::vector<std::pair<uint64_t, uint64_t>> busy;
+        for (uint32_t index : transients) {
+            ResourceInfo& resource = m_resources[index];
+            const uint32_t category = resource.memory.heapCategory;
+            if (m_heapSizes.size() <= category) {
+                m_heapSizes.resize(category + 1, 0);
+            }
+
+            busy.clear();
+            for (uint32_t other : placed) {
+                const ResourceInfo& placedResource = m_resources[other];
+                if (placedResource.memory.heapCategory == category && lifetimesOverlap(resource, placedResource)) {
+                    busy.emplace_back(placedResource.heapOffset, placedResource.heapOffset + placedResource.memory.size);
+                }
+            }
+            std::sort(busy.begin(), busy.end());
+
+            uint64_t offset = 0;
+            for (const auto& range : busy) {
+                if (range.second <= offset) {
+                    continue;
+                }
+                if (range.first >= offset + resource.memory.size) {
+                    break;
+                }
+                offset = AlignUp(range.second, resource.memory.alignment);
+            }
+
+            resource.heapOffset = offset;
+            m_heapSizes[category] = std::max(m_heapSizes[category], offset + resource.memory.size);
+            placed.push_back(index);
+        }
+
+        // Barrera de aliasing al activar un transitorio que comparte memoria con otro; el anterior
+        // solo se nombra si es único (si no, cualquiera: lo que quedase del frame previo incluido)
+        for (uint32_t index : transients) {
+            ResourceInfo& resource = m_resources[index];
+            RenderGraphResource previous;
+            uint32_t previousCount = 0;
+            for (uint32_t other : transients) {
+                const ResourceInfo& otherResource = m_resources[other];
+                if (other == index || !memoryOverlaps(resource, otherResource)) {
+                    continue;
+                }
+                resource.aliased = true;
+                if (otherResource.lastPass < resource.firstPass) {
+                    previous.index = other;
+                    ++previousCount;
+                }
+            }
+            if (!resource.aliased) {
+                continue;
+            }
+
+            AliasingBarrier barrier;
+            barrier.before = (previousCount == 1) ? previous : RenderGraphResource();
+            barrier.after.index = index;
+            m_compiledPasses[resource.firstPass].aliasing.push_back(barrier);
+            ++m_stats.aliasingBarriers;
+        }
+
+        for (uint64_t heapSize : m_heapSizes) {
+            m_stats.heapBytes += heapSize;
+        }
+    }
+
+    void RenderGraph::Execute(RenderGraphBackend& backend) {
+        if (!m_compiled) {
+            return;
+        }
+        if (!backend.PrepareResources(*this)) {
+            std::cerr << "Error: Failed to prepare render graph resources" << std::endl;
+            return;
+        }
+
+        RenderGraphContext context;
+        context.graph = this;
+        context.backend = &backend;
+        context.commandList = backend.GetCommandList();
+
+        for (const CompiledPass& compiled : m_compiledPasses) {
+            backend.BeginPass(*this, compiled);
+            const Pass& pass = m_passes[compiled.pass];
+            if (pass.execute) {
+                context.pass = compiled.pass;
+                pass.execute(context);
+            }
+        }
+
+        backend.EndGraph(*this);
+    }
+
+    std::string RenderGraph::BuildReport() const {
+        std::ostringstream report;
+        report << std::fixed << std::setprecision(2);
+        report << "Pases: " << m_stats.passes << " (descartados: " << m_stats.culledPasses << ")"
+            << " | Transiciones: " << m_stats.transitions << " (split: " << m_stats.splitTransitions << ")"
+            << " | Aliasing: " << m_stats.aliasingBarriers
+            << " | Transitorios: " << m_stats.transientResources
+            << " | Memoria: " << m_stats.heapBytes / (1024.0 * 1024.0) << " MB"
+            << " de " << m_stats.transientBytes / (1024.0 * 1024.0) << " MB sin solapar\n";
+
+        for (uint32_t p = 0; p < m_passes.size(); ++p) {
+            report << "  " << (m_passes[p].culled ? "[descartado] " : "") << m_passes[p].name << "\n";
+        }
+        for (const ResourceInfo& resource : m_resources) {
+            if (resource.imported || !resource.used) {
+                continue;
+            }
+            report << "  " << resource.name << ": " << resource.memory.size / 1024.0 << " KB"
+                << " @ " << resource.heapOffset << " (heap " << resource.memory.heapCategory << ")"
+                << " pases [" << resource.firstPass << ", " << resource.lastPass << "]"
+                << (resource.aliased ? " solapado" : "") << "\n";
+        }
+        return report.str();
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,146 @@
+#include "RenderQueue.h"
+#include <cstring>
+#include <sstream>
+
+namespace D3D12Core {
+
+    namespace {
+
+        constexpr uint32_t PASS_SHIFT = 60;
+        constexpr uint32_t LAYER_SHIFT = 56;
+        constexpr uint32_t TRANSPARENT_SHIFT = 55;
+        // Opacos
+        constexpr uint32_t OPAQUE_PIPELINE_SHIFT = 43;
+        constexpr uint32_t OPAQUE_MATERIAL_SHIFT = 27;
+        constexpr uint32_t OPAQUE_MESH_SHIFT = 15;
+        // Transparentes
+        constexpr uint32_t TRANSPARENT_DEPTH_SHIFT = 31;
+        constexpr uint32_t TRANSPARENT_PIPELINE_SHIFT = 19;
+        constexpr uint32_t TRANSPARENT_MATERIAL_SHIFT = 3;
+
+        uint64_t Field(uint32_t value, uint32_t bits, uint32_t shift) {
+            return (static_cast<uint64_t>(value) & ((1ull << bits) - 1)) << shift;
+        }
+
+        uint32_t Extract(uint64_t key, uint32_t bits, uint32_t shift) {
+            return static_cast<uint32_t>((key >> shift) & ((1ull << bits) - 1));
+        }
+
+        // Los bits de un float positivo crecen con su valor: los bits altos (exponente y el
+        // principio de la mantisa) son una profundidad cuantizada con precisión relativa
+        // constante, sin necesidad de conocer el plano lejano
+        uint32_t QuantizeDepth(float depth, uint32_t bits) {
+            if (!(depth > 0.0f)) {
+                return 0; // Negativos (detrás de la cámara) y NaN
+            }
+            uint32_t floatBits;
+            std::memcpy(&floatBits, &depth, sizeof(floatBits));
+            return floatBits >> (31 - bits);
+        }
+
+    } // namespace
+
+    namespace DrawSortKey {
+
+        uint64_t Opaque(uint32_t pass, uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth) {
+            return Field(pass, PASS_BITS, PASS_SHIFT) |
+                   Field(layer, LAYER_BITS, LAYER_SHIFT) |
+                   Field(pipeline, PIPELINE_BITS, OPAQUE_PIPELINE_SHIFT) |
+                   Field(material, MATERIAL_BITS, OPAQUE_MATERIAL_SHIFT) |
+                   Field(mesh, MESH_BITS, OPAQUE_MESH_SHIFT) |
+                   QuantizeDepth(depth, OPAQUE_DEPTH_BITS);
+        }
+
+        uint64_t Transparent(uint32_t pass, uint32_t layer, uint32_t pipeline, uint32_t material, float depth) {
+            // Invertida: los más lejanos tienen la clave menor y se dibujan primero
+            uint32_t farFirst = ((1u << TRANSPARENT_DEPTH_BITS) - 1) - QuantizeDepth(depth, TRANSPARENT_DEPTH_BITS);
+            return Field(pass, PASS_BITS, PASS_SHIFT) |
+                   Field(layer, LAYER_BITS, LAYER_SHIFT) |
+                   (1ull << TRANSPARENT_SHIFT) |
+                   Field(farFirst, TRANSPARENT_DEPTH_BITS, TRANSPARENT_DEPTH_SHIFT) |
+                   Field(pipeline, PIPELINE_BITS, TRANSPARENT_PIPELINE_SHIFT) |
+                   Field(material, MATERIAL_BITS, TRANSPARENT_MATERIAL_SHIFT);
+        }
+
+        uint32_t GetPass(uint64_t key) {
+            return Extract(key, PASS_BITS, PASS_SHIFT);
+        }
+
+        uint32_t GetLayer(uint64_t key) {
+            return Extract(key, LAYER_BITS, LAYER_SHIFT);
+        }
+
+        bool IsTransparent(uint64_t key) {
+            return ((key >> TRANSPARENT_SHIFT) & 1) != 0;
+        }
+
+        uint32_t GetPipeline(uint64_t key) {
+            return Extract(key, PIPELINE_BITS, IsTransparent(key) ? TRANSPARENT_PIPELINE_SHIFT : OPAQUE_PIPELINE_SHIFT);
+        }
+
+        uint32_t GetMaterial(uint64_t key) {
+            return Extract(key, MATERIAL_BITS, IsTransparent(key) ? TRANSPARENT_MATERIAL_SHIFT : OPAQUE_MATERIAL_SHIFT);
+        }
+
+    } // namespace DrawSortKey
+
+    void RenderQueue::Reset() {
+        m_keys.clear();
+        m_drawIndices.clear();
+    }
+
+    void RenderQueue::Reserve(uint32_t count) {
+        m_keys.reserve(count);
+        m_drawIndices.reserve(count);
+    }
+
+    void RenderQueue::Add(uint64_t key, uint32_t drawIndex) {
+        m_keys.push_back(key);
+        m_drawIndices.push_back(drawIndex);
+    }
+
+    void RenderQueue::Sort(JobSystem* jobs) {
+        uint64_t pipelineChanges = 0;
+        uint64_t materialChanges = 0;
+        CountStateChanges(pipelineChanges, materialChanges);
+        m_stats.unsortedPipelineChanges += pipelineChanges;
+        m_stats.unsortedMaterialChanges += materialChanges;
+
+        RadixSortStats sortStats = m_sorter.Sort(m_keys.data(), m_drawIndices.data(), GetCount(), jobs);
+
+        CountStateChanges(pipelineChanges, materialChanges);
+        m_stats.pipelineChanges += pipelineChanges;
+        m_stats.materialChanges += materialChanges;
+        m_stats.sorts++;
+        m_stats.draws += m_keys.size();
+        m_stats.radixPasses += sortStats.passes;
+        m_stats.skippedPasses += sortStats.skippedPasses;
+    }
+
+    void RenderQueue::CountStateChanges(uint64_t& pipelineChanges, uint64_t& materialChanges) const {
+        // El primer draw siempre fija pipeline y material
+        pipelineChanges = 0;
+        materialChanges = 0;
+        for (size_t i = 0; i < m_keys.size(); i++) {
+            uint32_t pipeline = DrawSortKey::GetPipeline(m_keys[i]);
+            uint32_t material = DrawSortKey::GetMaterial(m_keys[i]);
+            if (i == 0 || pipeline != DrawSortKey::GetPipeline(m_keys[i - 1])) {
+                pipelineChanges++;
+            }
+            if (i == 0 || material != DrawSortKey::GetMaterial(m_keys[i - 1]) ||
+                pipeline != DrawSortKey::GetPipeline(m_keys[i - 1])) {
+                materialChanges++;
+            }
+        }
+    }
+
+    std::string RenderQueue::BuildReport() const {
+        std::ostringstream report;
+        report << "Ordenaciones: " << m_stats.sorts << ", draws: " << m_stats.draws << ", pasadas radix: "
+               << m_stats.radixPasses << " (saltadas " << m_stats.skippedPasses << ")\n";
+        report << "Cambios de pipeline: " << m_stats.pipelineChanges << " (sin ordenar " << m_stats.unsortedPipelineChanges
+               << "), de material: " << m_stats.materialChanges << " (sin ordenar " << m_stats.unsortedMaterialChanges << ")\n";
+        return report.str();
+    }
+
+} // namespace D3D12Core
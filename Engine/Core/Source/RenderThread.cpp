@@ -0,0 +1,90 @@
+#include "RenderThread.h"
+#include <exception>
+#include <iostream>
+
+namespace D3D12Core {
+
+    RenderThread::RenderThread() {
+    }
+
+    RenderThread::~RenderThread() {
+        Stop();
+    }
+
+    bool RenderThread::Start(RenderFunction render) {
+        if (IsRunning() || !render) {
+            return false;
+        }
+
+        m_render = std::move(render);
+        m_stopRequested = false;
+        m_thread = std::thread(&RenderThread::ThreadMain, this);
+        return true;
+    }
+
+    void RenderThread::Stop() {
+        if (!IsRunning()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopRequested = true;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+    }
+
+    RenderSnapshot& RenderThread::BeginSnapshot() {
+        RenderSnapshot& snapshot = m_snapshots.GetWriteBuffer();
+        snapshot.Clear();
+        return snapshot;
+    }
+
+    void RenderThread::Publish() {
+        m_snapshots.Publish();
+
+        // Pasar por el mutex evita perder el aviso si el hilo de render está a punto de dormir
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+        }
+        m_wake.notify_one();
+    }
+
+    void RenderThread::ThreadMain() {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_stopRequested || m_snapshots.HasNewData(); });
+                if (m_stopRequested) {
+                    break;
+                }
+            }
+
+            if (!m_snapshots.Acquire()) {
+                continue;
+            }
+
+            // Un error en un frame no debe matar el hilo: el siguiente snapshot lo reintenta
+            try {
+                m_render(m_snapshots.GetReadBuffer());
+            }
+            catch (const std::exception& ex) {
+                std::cerr << "Error en hilo de render: " << ex.what() << std::endl;
+            }
+            catch (...) {
+                std::cerr << "Error desconocido en hilo de render" << std::endl;
+            }
+            m_rendered.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    RenderThreadStats RenderThread::GetStats() const {
+        RenderThreadStats stats;
+        stats.published = m_snapshots.GetPublishedCount();
+        stats.dropped = m_snapshots.GetDroppedCount();
+        stats.rendered = m_rendered.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+} // namespace D3D12Core
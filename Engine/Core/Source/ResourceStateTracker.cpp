@@ -0,0 +1,245 @@
+#include "ResourceStateTracker.h"
+
+namespace D3D12Core {
+
+    ResourceStateTracker::ResourceStateTracker() {
+    }
+
+    void ResourceStateTracker::Initialize(uint32_t writeStateMask) {
+        m_writeStateMask = writeStateMask;
+        m_resources.clear();
+        m_pending.clear();
+        m_stats = Stats();
+    }
+
+    void ResourceStateTracker::RegisterResource(uint64_t resource, uint32_t subresourceCount, uint32_t initialState, bool implicitPromotion) {
+        TrackedResource& tracked = m_resources[resource];
+        uint32_t count = subresourceCount > 0 ? subresourceCount : 1;
+        tracked.states.assign(count, initialState);
+        tracked.splitTargets.assign(count, NO_SPLIT);
+        tracked.implicitPromotion = implicitPromotion;
+        tracked.promoted = false;
+    }
+
+    void ResourceStateTracker::UnregisterResource(uint64_t resource) {
+        m_resources.erase(resource);
+
+        // Una barrera pendiente sobre un recurso destruido no debe llegar a la API
+        for (size_t i = 0; i < m_pending.size();) {
+            if (m_pending[i].resource == resource) {
+                m_pending.erase(m_pending.begin() + i);
+            }
+            else {
+                ++i;
+            }
+        }
+    }
+
+    uint32_t ResourceStateTracker::GetState(uint64_t resource, uint32_t subresource) const {
+        auto it = m_resources.find(resource);
+        if (it == m_resources.end()) {
+            return STATE_COMMON;
+        }
+        const std::vector<uint32_t>& states = it->second.states;
+        return subresource < states.size() ? states[subresource] : states[0];
+    }
+
+    void ResourceStateTracker::AddBarrier(uint64_t key, uint32_t subresource, uint32_t before, uint32_t after, uint32_t flags) {
+        // Fusionar con una barrera completa del mismo subrecurso aún no enviada: A->B + B->C = A->C
+        if (flags == BARRIER_FULL) {
+            for (size_t i = m_pending.size(); i-- > 0;) {
+                Barrier& pending = m_pending[i];
+                if (pending.resource != key) {
+                    continue;
+                }
+                if (pending.subresource != subresource) {
+                    if (pending.subresource == ALL_SUBRESOURCES || subresource == ALL_SUBRESOURCES) {
+                        break; // Solapa con el subrecurso pedido: no reordenar por delante
+                    }
+                    continue;
+                }
+                if (pending.flags == BARRIER_FULL && pending.after == before) {
+                    pending.after = after;
+                    ++m_stats.merged;
+                    if (pending.before == pending.after) {
+                        m_pending.erase(m_pending.begin() + i);
+                        ++m_stats.elided;
+                    }
+                    return;
+                }
+                break; // Una barrera distinta del mismo subrecurso fija el orden: no fusionar más atrás
+            }
+        }
+
+        Barrier barrier;
+        barrier.resource = key;
+        barrier.subresource = subresource;
+        barrier.before = before;
+        barrier.after = after;
+        barrier.flags = flags;
+        m_pending.push_back(barrier);
+    }
+
+    void ResourceStateTracker::TransitionSubresource(uint64_t key, TrackedResource& resource, uint32_t subresource, uint32_t barrierSubresource, uint32_t newState) {
+        ++m_stats.requested;
+        uint32_t& state = resource.states[subresource];
+        uint32_t& splitTarget = resource.splitTargets[subresource];
+
+        // Cerrar un split barrier abierto
+        if (splitTarget != NO_SPLIT) {
+            AddBarrier(key, barrierSubresource, state, splitTarget, BARRIER_END_ONLY);
+            state = splitTarget;
+            splitTarget = NO_SPLIT;
+            resource.promoted = false;
+            if (state == newState) {
+                return;
+            }
+        }
+
+        if (state == newState) {
+            ++m_stats.elided;
+            return;
+        }
+
+        // Ya en un estado de lectura combinado que incluye el pedido
+        if (IsReadOnly(state) && IsReadOnly(newState) && (state & newState) == newState) {
+            ++m_stats.elided;
+            return;
+        }
+
+        // Promoción implícita: COMMON -> cualquier estado, o lecturas promocionadas que se combinan
+        if (resource.implicitPromotion) {
+            if (state == STATE_COMMON) {
+                state = newState;
+                resource.promoted = true;
+                ++m_stats.promoted;
+                return;
+            }
+            if (resource.promoted && IsReadOnly(state) && IsReadOnly(newState)) {
+                state |= newState;
+                ++m_stats.promoted;
+                return;
+            }
+        }
+
+        AddBarrier(key, barrierSubresource, state, newState, BARRIER_FULL);
+        state = newState;
+        resource.promoted = false;
+    }
+
+    bool ResourceStateTracker::TransitionWhole(uint64_t key, TrackedResource& resource, uint32_t newState) {
+        // Una sola barrera ALL_SUBRESOURCES si todos los subrecursos están en el mismo estado
+        const uint32_t first = resource.states[0];
+        const uint32_t firstSplit = resource.splitTargets[0];
+        for (size_t i = 1; i < resource.states.size(); ++i) {
+            if (resource.states[i] != first || resource.splitTargets[i] != firstSplit) {
+                return false;
+            }
+        }
+
+        const uint32_t count = static_cast<uint32_t>(resource.states.size());
+        m_stats.requested += count - 1;
+
+        // Reutilizar la lógica por subrecurso sobre el primero y replicar el resultado
+        uint64_t elidedBefore = m_stats.elided;
+        TransitionSubresource(key, resource, 0, ALL_SUBRESOURCES, newState);
+        if (m_stats.elided != elidedBefore) {
+            m_stats.elided += count - 1;
+        }
+        for (size_t i = 1; i < resource.states.size(); ++i) {
+            resource.states[i] = resource.states[0];
+            resource.splitTargets[i] = resource.splitTargets[0];
+        }
+        return true;
+    }
+
+    void ResourceStateTracker::Transition(uint64_t resource, uint32_t subresource, uint32_t newState) {
+        auto it = m_resources.find(resource);
+        if (it == m_resources.end()) {
+            return;
+        }
+        TrackedResource& tracked = it->second;
+
+        // Con un solo subrecurso todas las barreras usan ALL_SUBRESOURCES (y se pueden fusionar)
+        const bool single = tracked.states.size() == 1;
+        if (subresource != ALL_SUBRESOURCES) {
+            if (subresource < tracked.states.size()) {
+                TransitionSubresource(resource, tracked, subresource, single ? ALL_SUBRESOURCES : subresource, newState);
+            }
+            return;
+        }
+
+        if (single) {
+            TransitionSubresource(resource, tracked, 0, ALL_SUBRESOURCES, newState);
+        }
+        else if (!TransitionWhole(resource, tracked, newState)) {
+            // Estados mezclados: una barrera por subrecurso que lo necesite
+            for (uint32_t i = 0; i < tracked.states.size(); ++i) {
+                TransitionSubresource(resource, tracked, i, i, newState);
+            }
+        }
+    }
+
+    void ResourceStateTracker::BeginTransition(uint64_t resource, uint32_t subresource, uint32_t newState) {
+        auto it = m_resources.find(resource);
+        if (it == m_resources.end()) {
+            return;
+        }
+        TrackedResource& tracked = it->second;
+        if (tracked.states.size() == 1) {
+            subresource = ALL_SUBRESOURCES;
+        }
+
+        uint32_t first = (subresource == ALL_SUBRESOURCES) ? 0 : subresource;
+        uint32_t last = (subresource == ALL_SUBRESOURCES) ? static_cast<uint32_t>(tracked.states.size()) : subresource + 1;
+        if (last > tracked.states.size()) {
+            return;
+        }
+
+        // Solo tiene sentido si de verdad hace falta una barrera explícita
+        for (uint32_t i = first; i < last; ++i) {
+            uint32_t state = tracked.states[i];
+            if (tracked.splitTargets[i] != NO_SPLIT || state == newState ||
+                (tracked.implicitPromotion && state == STATE_COMMON) ||
+                (IsReadOnly(state) && IsReadOnly(newState) && (state & newState) == newState)) {
+                return;
+            }
+        }
+        for (uint32_t i = first + 1; i < last; ++i) {
+            if (tracked.states[i] != tracked.states[first]) {
+                return; // Estados mezclados: se resolverá con barreras completas
+            }
+        }
+
+        AddBarrier(resource, subresource, tracked.states[first], newState, BARRIER_BEGIN_ONLY);
+        for (uint32_t i = first; i < last; ++i) {
+            tracked.splitTargets[i] = newState;
+        }
+        ++m_stats.splitBegins;
+    }
+
+    void ResourceStateTracker::OnExecuted() {
+        for (auto& entry : m_resources) {
+            TrackedResource& tracked = entry.second;
+            if (!tracked.implicitPromotion) {
+                continue;
+            }
+            for (size_t i = 0; i < tracked.states.size(); ++i) {
+                if (tracked.splitTargets[i] == NO_SPLIT) {
+                    tracked.states[i] = STATE_COMMON;
+                }
+            }
+            tracked.promoted = false;
+        }
+    }
+
+    void ResourceStateTracker::TakePendingBarriers(std::vector<Barrier>& barriers) {
+        barriers.clear();
+        barriers.swap(m_pending);
+        if (!barriers.empty()) {
+            m_stats.issued += barriers.size();
+            ++m_stats.flushes;
+        }
+    }
+
+} // namespace D3D12Core
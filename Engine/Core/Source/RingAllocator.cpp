@@ -0,0 +1,155 @@
+#include "RingAllocator.h"
+
+namespace D3D12Core {
+
+    namespace {
+        uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    RingAllocator::RingAllocator() {
+    }
+
+    void RingAllocator::Initialize(uint64_t capacity) {
+        m_capacity = capacity;
+        Reset();
+        m_stats = Stats{};
+    }
+
+    void RingAllocator::Reset() {
+        m_head = 0;
+        m_tail = 0;
+        m_used = 0;
+        m_pendingSize = 0;
+        m_submissions.clear();
+    }
+
+    bool RingAllocator::Fits(uint64_t size, uint64_t alignment, uint64_t head, uint64_t tail, uint64_t used, uint64_t& offset, uint64_t& padding) const {
+        if (size > m_capacity || used >= m_capacity) {
+            return false;
+        }
+
+        if (used == 0) {
+            // Anillo vacío: siempre se reinicia al principio
+            offset = 0;
+            padding = 0;
+            return true;
+        }
+
+        uint64_t aligned = AlignUp(head, alignment);
+        if (head >= tail) {
+            // Libre: [head, capacity) y [0, tail)
+            if (aligned + size <= m_capacity) {
+                offset = aligned;
+                padding = aligned - head;
+                return true;
+            }
+            if (size <= tail) {
+                offset = 0;
+                padding = m_capacity - head; // El final del anillo se pierde hasta el wrap
+                return true;
+            }
+            return false;
+        }
+
+        // Libre: [head, tail)
+        if (aligned + size <= tail) {
+            offset = aligned;
+            padding = aligned - head;
+            return true;
+        }
+        return false;
+    }
+
+    uint64_t RingAllocator::Allocate(uint64_t size, uint64_t alignment) {
+        if (alignment == 0) {
+            alignment = 1;
+        }
+
+        uint64_t offset = 0;
+        uint64_t padding = 0;
+        if (!Fits(size, alignment, m_head, m_tail, m_used, offset, padding)) {
+            m_stats.failedAllocations++;
+            return INVALID_OFFSET;
+        }
+
+        if (m_used == 0) {
+            m_head = 0;
+            m_tail = 0;
+        }
+
+        if (offset == 0 && m_used != 0) {
+            m_stats.wraps++;
+            m_stats.bytesWasted += padding;
+        }
+
+        m_head = offset + size;
+        if (m_head == m_capacity) {
+            m_head = 0;
+        }
+
+        m_used += padding + size;
+        m_pendingSize += padding + size;
+        m_stats.allocations++;
+        if (m_used > m_stats.peakUsed) {
+            m_stats.peakUsed = m_used;
+        }
+
+        return offset;
+    }
+
+    void RingAllocator::FinishSubmission(uint64_t fenceValue) {
+        if (m_pendingSize == 0) {
+            return;
+        }
+
+        Submission submission;
+        submission.fenceValue = fenceValue;
+        submission.end = m_head;
+        submission.size = m_pendingSize;
+        m_submissions.push_back(submission);
+        m_pendingSize = 0;
+    }
+
+    void RingAllocator::Retire(uint64_t completedFenceValue) {
+        while (!m_submissions.empty() && m_submissions.front().fenceValue <= completedFenceValue) {
+            const Submission& submission = m_submissions.front();
+            m_tail = submission.end;
+            m_used -= submission.size;
+            m_submissions.pop_front();
+        }
+
+        if (m_used == 0) {
+            m_head = 0;
+            m_tail = 0;
+        }
+    }
+
+    uint64_t RingAllocator::GetFenceToFit(uint64_t size, uint64_t alignment) const {
+        if (alignment == 0) {
+            alignment = 1;
+        }
+
+        uint64_t offset = 0;
+        uint64_t padding = 0;
+        if (Fits(size, alignment, m_head, m_tail, m_used, offset, padding)) {
+            return 0;
+        }
+
+        // Simular la retirada en orden hasta que quepa
+        uint64_t tail = m_tail;
+        uint64_t used = m_used;
+        for (const Submission& submission : m_submissions) {
+            tail = submission.end;
+            used -= submission.size;
+            uint64_t head = (used == 0) ? 0 : m_head;
+            if (Fits(size, alignment, head, (used == 0) ? 0 : tail, used, offset, padding)) {
+                return submission.fenceValue;
+            }
+        }
+
+        return INVALID_OFFSET; // No cabe ni vaciando los envíos (asignaciones sin fence o tamaño excesivo)
+    }
+
+} // namespace D3D12Core
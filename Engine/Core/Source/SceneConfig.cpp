@@ -0,0 +1,145 @@
+#include "SceneConfig.h"
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace D3D12Core {
+
+    // Función simple para leer config.json (parsing básico sin librerías externas)
+    bool LoadConfig(CubeConfig& config) {
+        // Buscar config.json en múltiples ubicaciones
+        std::ifstream file;
+        std::string configPaths[] = {
+            "Engine/Binaries/Win64/config.json",
+            "x64/Debug/config.json",
+            "config.json"
+        };
+
+        bool fileOpened = false;
+        for (const auto& path : configPaths) {
+            file.open(path);
+            if (file.is_open()) {
+                fileOpened = true;
+                break;
+            }
+        }
+
+        if (!fileOpened || !file.is_open()) {
+            return false; // Archivo no existe, usar valores por defecto
+        }
+
+        std::string line;
+        while (std::getline(file, line)) {
+            // Buscar valores en formato simple: "rotationSpeed": 0.02,
+            if (line.find("\"rotationSpeed\"") != std::string::npos) {
+                size_t colon = line.find(':');
+                if (colon != std::string::npos) {
+                    std::string value = line.substr(colon + 1);
+                    // Eliminar espacios y comas
+                    value.erase(0, value.find_first_not_of(" \t,"));
+                    value.erase(value.find_last_not_of(" \t,") + 1);
+                    config.rotationSpeed = std::stof(value);
+                }
+            }
+            else if (line.find("\"scale\"") != std::string::npos) {
+                size_t colon = line.find(':');
+                if (colon != std::string::npos) {
+                    std::string value = line.substr(colon + 1);
+                    value.erase(0, value.find_first_not_of(" \t,"));
+                    value.erase(value.find_last_not_of(" \t,") + 1);
+                    config.scale = std::stof(value);
+                }
+            }
+            else if (line.find("\"rotationXMultiplier\"") != std::string::npos) {
+                size_t colon = line.find(':');
+                if (colon != std::string::npos) {
+                    std::string value = line.substr(colon + 1);
+                    value.erase(0, value.find_first_not_of(" \t,"));
+                    value.erase(value.find_last_not_of(" \t,") + 1);
+                    config.rotationXMultiplier = std::stof(value);
+                }
+            }
+            else if (line.find("\"cameraX\"") != std::string::npos) {
+                size_t colon = line.find(':');
+                if (colon != std::string::npos) {
+                    std::string value = line.substr(colon + 1);
+                    value.erase(0, value.find_first_not_of(" \t,"));
+                    value.erase(value.find_last_not_of(" \t,") + 1);
+                    config.cameraX = std::stof(value);
+                }
+            }
+            else if (line.find("\"cameraY\"") != std::string::npos) {
+                size_t colon = line.find(':');
+                if (colon != std::string::npos) {
+                    std::string value = line.substr(colon + 1);
+                    value.erase(0, value.find_first_not_of(" \t,"));
+                    value.erase(value.find_last_not_of(" \t,") + 1);
+                    config.cameraY = std::stof(value);
+                }
+            }
+            else if (line.find("\"cameraZ\"") != std::string::npos) {
+                size_t colon = line.find(':');
+                if (colon != std::string::npos) {
+                    std::string value = line.substr(colon + 1);
+                    value.erase(0, value.find_first_not_of(" \t,"));
+                    value.erase(value.find_last_not_of(" \t,") + 1);
+                    config.cameraZ = std::stof(value);
+                }
+            }
+            else if (line.find("\"fov\"") != std::string::npos) {
+                size_t colon = line.find(':');
+                if (colon != std::string::npos) {
+                    std::string value = line.substr(colon + 1);
+                    value.erase(0, value.find_first_not_of(" \t,"));
+                    value.erase(value.find_last_not_of(" \t,") + 1);
+                    config.fov = std::stof(value);
+                }
+            }
+            else if (line.find("\"autoRotate\"") != std::string::npos) {
+                size_t colon = line.find(':');
+                if (colon != std::string::npos) {
+                    std::string value = line.substr(colon + 1);
+                    value.erase(0, value.find_first_not_of(" \t,"));
+                    value.erase(value.find_last_not_of(" \t,") + 1);
+                    config.autoRotate = (value.find("true") != std::string::npos);
+                }
+            }
+        }
+
+        file.close();
+        return true;
+    }
+
+    bool LoadMaterialBaseColor(const std::string& path, float baseColor[3]) {
+        std::ifstream matFile(path);
+        if (!matFile.is_open()) {
+            return false;
+        }
+        std::string json((std::istreambuf_iterator<char>(matFile)),
+                         std::istreambuf_iterator<char>());
+        matFile.close();
+
+        size_t start = json.find("\"BaseColor\"");
+        if (start == std::string::npos) {
+            return false;
+        }
+        size_t valueStart = json.find('[', start);
+        size_t valueEnd = json.find(']', valueStart);
+        if (valueStart == std::string::npos || valueEnd == std::string::npos) {
+            return false;
+        }
+
+        std::string values = json.substr(valueStart + 1, valueEnd - valueStart - 1);
+        std::istringstream valueStream(values);
+        float r, g, b;
+        char comma;
+        if (!(valueStream >> r >> comma >> g >> comma >> b)) {
+            return false;
+        }
+        baseColor[0] = r;
+        baseColor[1] = g;
+        baseColor[2] = b;
+        return true;
+    }
+
+} // namespace D3D12Core
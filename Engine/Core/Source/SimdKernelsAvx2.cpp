@@ -0,0 +1,101 @@
+// Compilado con -mavx2 o /arch:AVX2 (ver CMakeLists.txt). Sin FMA: el resultado coincide con el
+// de los demás niveles
+#include "SimdKernelBodies.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace D3D12Core {
+
+#if defined(__AVX2__)
+    namespace {
+
+        struct Avx2Lanes {
+            using Float = __m256;
+            static constexpr uint32_t WIDTH = 8;
+            static Float Load(const float* source) { return _mm256_loadu_ps(source); }
+            static void Store(float* destination, Float value) { _mm256_storeu_ps(destination, value); }
+            static Float Splat(float value) { return _mm256_set1_ps(value); }
+            static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+            static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+            static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+            static Float Abs(Float value) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value); }
+            static Float Min(Float a, Float b) { return _mm256_min_ps(a, b); }
+            static Float Max(Float a, Float b) { return _mm256_max_ps(a, b); }
+            static uint32_t NonNegative(Float value) {
+                return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(value, _mm256_setzero_ps(), _CMP_GE_OQ)));
+            }
+
+            // Dos cuartetos por vector (mitades de 128 bits); las operaciones no cruzan mitades
+            static Float LoadQuads(const float* const sources[2]) {
+                return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(sources[0])), _mm_loadu_ps(sources[1]), 1);
+            }
+            static void StoreQuads(float* const destinations[2], Float value) {
+                _mm_storeu_ps(destinations[0], _mm256_castps256_ps128(value));
+                _mm_storeu_ps(destinations[1], _mm256_extractf128_ps(value, 1));
+            }
+            static Float BroadcastQuad(const float* source) { return _mm256_broadcast_ps(reinterpret_cast<const __m128*>(source)); }
+            static void SplatQuadElements(Float value, Float splats[4]) {
+                splats[0] = _mm256_permute_ps(value, _MM_SHUFFLE(0, 0, 0, 0));
+                splats[1] = _mm256_permute_ps(value, _MM_SHUFFLE(1, 1, 1, 1));
+                splats[2] = _mm256_permute_ps(value, _MM_SHUFFLE(2, 2, 2, 2));
+                splats[3] = _mm256_permute_ps(value, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+            // _MM_TRANSPOSE4_PS dentro de cada mitad
+            static void Transpose4(Float& row0, Float& row1, Float& row2, Float& row3) {
+                const Float low01 = _mm256_unpacklo_ps(row0, row1);
+                const Float low23 = _mm256_unpacklo_ps(row2, row3);
+                const Float high01 = _mm256_unpackhi_ps(row0, row1);
+                const Float high23 = _mm256_unpackhi_ps(row2, row3);
+                row0 = _mm256_shuffle_ps(low01, low23, _MM_SHUFFLE(1, 0, 1, 0));
+                row1 = _mm256_shuffle_ps(low01, low23, _MM_SHUFFLE(3, 2, 3, 2));
+                row2 = _mm256_shuffle_ps(high01, high23, _MM_SHUFFLE(1, 0, 1, 0));
+                row3 = _mm256_shuffle_ps(high01, high23, _MM_SHUFFLE(3, 2, 3, 2));
+            }
+            static Float SetQuadW(Float value, Float w) { return _mm256_blend_ps(value, w, 0x88); }
+
+            // Atributos de vértices: un cuarteto de enteros por vértice (valores ya recortados)
+            static void StoreSnorm16Quads(int16_t* const destinations[2], Float value) {
+                const __m256i integers = _mm256_cvtps_epi32(value);
+                const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(integers), _mm256_extracti128_si256(integers, 1));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destinations[0]), words);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destinations[1]), _mm_unpackhi_epi64(words, words));
+            }
+            static Float LoadSnorm16Quads(const int16_t* const sources[2]) {
+                const __m128i words = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(sources[0])),
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(sources[1])));
+                return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(words));
+            }
+            static void StoreUnorm8Quads(uint8_t* const destinations[2], Float value) {
+                const __m256i integers = _mm256_cvtps_epi32(value);
+                const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(integers), _mm256_extracti128_si256(integers, 1));
+                const __m128i bytes = _mm_packus_epi16(words, words);
+                const int32_t first = _mm_cvtsi128_si32(bytes);
+                const int32_t second = _mm_extract_epi32(bytes, 1);
+                std::memcpy(destinations[0], &first, sizeof(first));
+                std::memcpy(destinations[1], &second, sizeof(second));
+            }
+            static Float LoadUnorm8Quads(const uint8_t* const sources[2]) {
+                int32_t first, second;
+                std::memcpy(&first, sources[0], sizeof(first));
+                std::memcpy(&second, sources[1], sizeof(second));
+                return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_insert_epi32(_mm_cvtsi32_si128(first), second, 1)));
+            }
+        };
+
+        // Tabla constante: no se ejecuta código del nivel hasta llamar a un kernel
+        constexpr SimdKernelTable AVX2_KERNELS = MakeKernelTable<Avx2Lanes>(SimdLevel::AVX2);
+
+    } // namespace
+
+    const SimdKernelTable* GetAvx2Kernels() {
+        return &AVX2_KERNELS;
+    }
+#else
+    const SimdKernelTable* GetAvx2Kernels() {
+        return nullptr;
+    }
+#endif
+
+} // namespace D3D12Core
@@ -0,0 +1,111 @@
+// Compilado con -mavx512f o /arch:AVX512 (ver CMakeLists.txt). Solo AVX-512F, que tienen todas las
+// CPU con AVX-512, y -ffp-contract=off: AVX-512F incluye FMA y el compilador fusionaría mul + add
+#include "SimdKernelBodies.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace D3D12Core {
+
+#if defined(__AVX512F__)
+    namespace {
+
+        struct Avx512Lanes {
+            using Float = __m512;
+            static constexpr uint32_t WIDTH = 16;
+            static Float Load(const float* source) { return _mm512_loadu_ps(source); }
+            static void Store(float* destination, Float value) { _mm512_storeu_ps(destination, value); }
+            static Float Splat(float value) { return _mm512_set1_ps(value); }
+            static Float Add(Float a, Float b) { return _mm512_add_ps(a, b); }
+            static Float Sub(Float a, Float b) { return _mm512_sub_ps(a, b); }
+            static Float Mul(Float a, Float b) { return _mm512_mul_ps(a, b); }
+            static Float Abs(Float value) {
+                return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(value), _mm512_set1_epi32(0x7FFFFFFF)));
+            }
+            static uint32_t NonNegative(Float value) { return _mm512_cmp_ps_mask(value, _mm512_setzero_ps(), _CMP_GE_OQ); }
+            static Float Min(Float a, Float b) { return _mm512_min_ps(a, b); }
+            static Float Max(Float a, Float b) { return _mm512_max_ps(a, b); }
+
+            // Cuatro cuartetos por vector (bloques de 128 bits); las operaciones no cruzan bloques
+            static Float LoadQuads(const float* const sources[4]) {
+                Float value = _mm512_castps128_ps512(_mm_loadu_ps(sources[0]));
+                value = _mm512_insertf32x4(value, _mm_loadu_ps(sources[1]), 1);
+                value = _mm512_insertf32x4(value, _mm_loadu_ps(sources[2]), 2);
+                return _mm512_insertf32x4(value, _mm_loadu_ps(sources[3]), 3);
+            }
+            static void StoreQuads(float* const destinations[4], Float value) {
+                _mm_storeu_ps(destinations[0], _mm512_castps512_ps128(value));
+                _mm_storeu_ps(destinations[1], _mm512_extractf32x4_ps(value, 1));
+                _mm_storeu_ps(destinations[2], _mm512_extractf32x4_ps(value, 2));
+                _mm_storeu_ps(destinations[3], _mm512_extractf32x4_ps(value, 3));
+            }
+            static Float BroadcastQuad(const float* source) { return _mm512_broadcast_f32x4(_mm_loadu_ps(source)); }
+            static void SplatQuadElements(Float value, Float splats[4]) {
+                splats[0] = _mm512_permute_ps(value, _MM_SHUFFLE(0, 0, 0, 0));
+                splats[1] = _mm512_permute_ps(value, _MM_SHUFFLE(1, 1, 1, 1));
+                splats[2] = _mm512_permute_ps(value, _MM_SHUFFLE(2, 2, 2, 2));
+                splats[3] = _mm512_permute_ps(value, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+            // _MM_TRANSPOSE4_PS dentro de cada bloque
+            static void Transpose4(Float& row0, Float& row1, Float& row2, Float& row3) {
+                const Float low01 = _mm512_unpacklo_ps(row0, row1);
+                const Float low23 = _mm512_unpacklo_ps(row2, row3);
+                const Float high01 = _mm512_unpackhi_ps(row0, row1);
+                const Float high23 = _mm512_unpackhi_ps(row2, row3);
+                row0 = _mm512_shuffle_ps(low01, low23, _MM_SHUFFLE(1, 0, 1, 0));
+                row1 = _mm512_shuffle_ps(low01, low23, _MM_SHUFFLE(3, 2, 3, 2));
+                row2 = _mm512_shuffle_ps(high01, high23, _MM_SHUFFLE(1, 0, 1, 0));
+                row3 = _mm512_shuffle_ps(high01, high23, _MM_SHUFFLE(3, 2, 3, 2));
+            }
+            static Float SetQuadW(Float value, Float w) { return _mm512_mask_blend_ps(0x8888, value, w); }
+
+            // Atributos de vértices: un cuarteto de enteros por vértice (valores ya recortados)
+            static void StoreSnorm16Quads(int16_t* const destinations[4], Float value) {
+                const __m256i words = _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(value));
+                const __m128i low = _mm256_castsi256_si128(words);
+                const __m128i high = _mm256_extracti128_si256(words, 1);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destinations[0]), low);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destinations[1]), _mm_unpackhi_epi64(low, low));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destinations[2]), high);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destinations[3]), _mm_unpackhi_epi64(high, high));
+            }
+            static Float LoadSnorm16Quads(const int16_t* const sources[4]) {
+                const __m128i low = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(sources[0])),
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(sources[1])));
+                const __m128i high = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(sources[2])),
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(sources[3])));
+                return _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1)));
+            }
+            static void StoreUnorm8Quads(uint8_t* const destinations[4], Float value) {
+                const __m128i bytes = _mm512_cvtusepi32_epi8(_mm512_cvtps_epi32(value));
+                const int32_t quads[4] = { _mm_cvtsi128_si32(bytes), _mm_extract_epi32(bytes, 1),
+                    _mm_extract_epi32(bytes, 2), _mm_extract_epi32(bytes, 3) };
+                for (uint32_t quad = 0; quad < 4; quad++) {
+                    std::memcpy(destinations[quad], &quads[quad], sizeof(int32_t));
+                }
+            }
+            static Float LoadUnorm8Quads(const uint8_t* const sources[4]) {
+                int32_t quads[4];
+                for (uint32_t quad = 0; quad < 4; quad++) {
+                    std::memcpy(&quads[quad], sources[quad], sizeof(int32_t));
+                }
+                return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_setr_epi32(quads[0], quads[1], quads[2], quads[3])));
+            }
+        };
+
+        // Tabla constante: no se ejecuta código del nivel hasta llamar a un kernel
+        constexpr SimdKernelTable AVX512_KERNELS = MakeKernelTable<Avx512Lanes>(SimdLevel::AVX512);
+
+    } // namespace
+
+    const SimdKernelTable* GetAvx512Kernels() {
+        return &AVX512_KERNELS;
+    }
+#else
+    const SimdKernelTable* GetAvx512Kernels() {
+        return nullptr;
+    }
+#endif
+
+} // namespace D3D12Core
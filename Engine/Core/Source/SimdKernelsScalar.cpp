@@ -0,0 +1,15 @@
+#include "SimdKernelBodies.h"
+
+namespace D3D12Core {
+
+    namespace {
+
+        constexpr SimdKernelTable SCALAR_KERNELS = MakeKernelTable<ScalarLanes>(SimdLevel::Scalar);
+
+    } // namespace
+
+    const SimdKernelTable* GetScalarKernels() {
+        return &SCALAR_KERNELS;
+    }
+
+} // namespace D3D12Core
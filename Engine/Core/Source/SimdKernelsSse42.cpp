@@ -0,0 +1,79 @@
+// Compilado con -msse4.2 (ver CMakeLists.txt); en MSVC x64 los intrínsecos SSE no necesitan flags
+#include "SimdKernelBodies.h"
+
+#if defined(__SSE4_2__) || defined(_M_X64)
+#include <immintrin.h>
+#define SIMD_KERNELS_SSE42 1
+#endif
+
+namespace D3D12Core {
+
+#if defined(SIMD_KERNELS_SSE42)
+    namespace {
+
+        struct Sse42Lanes {
+            using Float = __m128;
+            static constexpr uint32_t WIDTH = 4;
+            static Float Load(const float* source) { return _mm_loadu_ps(source); }
+            static void Store(float* destination, Float value) { _mm_storeu_ps(destination, value); }
+            static Float Splat(float value) { return _mm_set1_ps(value); }
+            static Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+            static Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+            static Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+            static Float Abs(Float value) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), value); }
+            static Float Min(Float a, Float b) { return _mm_min_ps(a, b); }
+            static Float Max(Float a, Float b) { return _mm_max_ps(a, b); }
+            static uint32_t NonNegative(Float value) {
+                return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(value, _mm_setzero_ps())));
+            }
+
+            // Un cuarteto por vector: cada uno es una fila de matriz
+            static Float LoadQuads(const float* const sources[1]) { return _mm_loadu_ps(sources[0]); }
+            static void StoreQuads(float* const destinations[1], Float value) { _mm_storeu_ps(destinations[0], value); }
+            static Float BroadcastQuad(const float* source) { return _mm_loadu_ps(source); }
+            static void SplatQuadElements(Float value, Float splats[4]) {
+                splats[0] = _mm_shuffle_ps(value, value, _MM_SHUFFLE(0, 0, 0, 0));
+                splats[1] = _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 1, 1, 1));
+                splats[2] = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 2, 2, 2));
+                splats[3] = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+            static void Transpose4(Float& row0, Float& row1, Float& row2, Float& row3) {
+                _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+            }
+            static Float SetQuadW(Float value, Float w) { return _mm_blend_ps(value, w, 0x8); }
+
+            // Atributos de vértices: un cuarteto de enteros por vértice (valores ya recortados)
+            static void StoreSnorm16Quads(int16_t* const destinations[1], Float value) {
+                const __m128i integers = _mm_cvtps_epi32(value);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destinations[0]), _mm_packs_epi32(integers, integers));
+            }
+            static Float LoadSnorm16Quads(const int16_t* const sources[1]) {
+                return _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(sources[0]))));
+            }
+            static void StoreUnorm8Quads(uint8_t* const destinations[1], Float value) {
+                const __m128i words = _mm_packs_epi32(_mm_cvtps_epi32(value), _mm_setzero_si128());
+                const int32_t bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+                std::memcpy(destinations[0], &bytes, sizeof(bytes));
+            }
+            static Float LoadUnorm8Quads(const uint8_t* const sources[1]) {
+                int32_t bytes;
+                std::memcpy(&bytes, sources[0], sizeof(bytes));
+                return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes)));
+            }
+        };
+
+        // Tabla constante: no se ejecuta código del nivel hasta llamar a un kernel
+        constexpr SimdKernelTable SSE42_KERNELS = MakeKernelTable<Sse42Lanes>(SimdLevel::SSE42);
+
+    } // namespace
+
+    const SimdKernelTable* GetSse42Kernels() {
+        return &SSE42_KERNELS;
+    }
+#else
+    const SimdKernelTable* GetSse42Kernels() {
+        return nullptr;
+    }
+#endif
+
+} // namespace D3D12Core
@@ -0,0 +1,593 @@
+#include "SoftwareRHI.h"
+#include "IndirectDrawBuilder.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+namespace D3D12Core {
+
+    // ---------------------------------------------------------------- Recursos
+
+    SoftwareRHIBuffer::SoftwareRHIBuffer(const RHIBufferDesc& desc, const void* initialData)
+        : m_desc(desc), m_data(static_cast<size_t>(desc.size), 0) {
+        if (initialData) {
+            std::memcpy(m_data.data(), initialData, static_cast<size_t>(desc.size));
+        }
+    }
+
+    // ---------------------------------------------------------------- Command list
+
+    void SoftwareRHICommandList::Begin() {
+        if (m_open) {
+            m_device->ReportError("Begin on a command list that is already open");
+        }
+
+        // Como Reset en D3D12: la lista empieza vacía y sin estado enlazado
+        m_open = true;
+        m_operations.clear();
+        m_renderTarget = 0;
+        m_hasViewport = false;
+        m_hasScissor = false;
+        m_state = SoftwareDrawCall();
+        m_pipeline = nullptr;
+        std::fill(std::begin(m_vertexBuffers), std::end(m_vertexBuffers), nullptr);
+        m_indexBuffer = nullptr;
+        m_instanceCapacity = 0;
+        m_objects = nullptr;
+        m_objectCapacity = 0;
+    }
+
+    void SoftwareRHICommandList::Close() {
+        if (CheckOpen("Close")) {
+            m_open = false;
+        }
+    }
+
+    bool SoftwareRHICommandList::CheckOpen(const char* call) {
+        if (m_open) {
+            return true;
+        }
+        m_device->ReportError(std::string(call) + " on a closed command list");
+        return false;
+    }
+
+    void SoftwareRHICommandList::SetRenderTarget(uint64_t renderTargetView) {
+        if (!CheckOpen("SetRenderTarget")) {
+            return;
+        }
+        if (!m_device->GetRenderTarget(renderTargetView)) {
+            m_device->ReportError("SetRenderTarget with an unknown view");
+            return;
+        }
+        m_renderTarget = renderTargetView;
+        Operation operation;
+        operation.type = OperationType::SetTarget;
+        operation.renderTargetView = renderTargetView;
+        m_operations.push_back(operation);
+    }
+
+    void SoftwareRHICommandList::ClearRenderTarget(uint64_t renderTargetView, const float color[4]) {
+        if (!CheckOpen("ClearRenderTarget")) {
+            return;
+        }
+        if (!m_device->GetRenderTarget(renderTargetView) || !color) {
+            m_device->ReportError("ClearRenderTarget with an unknown view or null color");
+            return;
+        }
+        Operation operation;
+        operation.type = OperationType::Clear;
+        operation.renderTargetView = renderTargetView;
+        std::memcpy(operation.color, color, sizeof(operation.color));
+        m_operations.push_back(operation);
+    }
+
+    void SoftwareRHICommandList::SetViewport(const RHIViewport& viewport) {
+        if (!CheckOpen("SetViewport")) {
+            return;
+        }
+        if (viewport.width <= 0.0f || viewport.height <= 0.0f || viewport.minDepth > viewport.maxDepth) {
+            m_device->ReportError("SetViewport with an empty viewport or inverted depth range");
+            return;
+        }
+        m_state.viewport = viewport;
+        m_hasViewport = true;
+    }
+
+    void SoftwareRHICommandList::SetScissor(const RHIRect& rect) {
+        if (!CheckOpen("SetScissor")) {
+            return;
+        }
+        if (rect.right <= rect.left || rect.bottom <= rect.top) {
+            m_device->ReportError("SetScissor with an empty rectangle");
+            return;
+        }
+        m_state.scissor = rect;
+        m_hasScissor = true;
+    }
+
+    void SoftwareRHICommandList::SetPipeline(IRHIPipeline* pipeline) {
+        if (!CheckOpen("SetPipeline")) {
+            return;
+        }
+        if (!dynamic_cast<SoftwareRHIPipeline*>(pipeline)) {
+            m_device->ReportError("SetPipeline with a null or foreign pipeline");
+            return;
+        }
+        // Cambiar de pipeline (root signature) invalida las constantes y el buffer de objetos enlazados
+        if (pipeline != m_pipeline) {
+            m_state.constants = nullptr;
+            m_objects = nullptr;
+            m_objectCapacity = 0;
+        }
+        m_pipeline = pipeline;
+    }
+
+    void SoftwareRHICommandList::SetConstantBuffer(uint32_t rootParameter, uint64_t gpuAddress) {
+        if (!CheckOpen("SetConstantBuffer")) {
+            return;
+        }
+        if (!m_pipeline || rootParameter != 0) {
+            m_device->ReportError("SetConstantBuffer without a pipeline or on an undeclared root parameter");
+            return;
+        }
+        if (gpuAddress == 0 || (gpuAddress % alignof(SoftwareMVPConstants)) != 0) {
+            m_device->ReportError("SetConstantBuffer with a null or misaligned address");
+            return;
+        }
+        m_state.constants = reinterpret_cast<const SoftwareMVPConstants*>(gpuAddress);
+    }
+
+    void SoftwareRHICommandList::SetVertexBuffer(IRHIBuffer* buffer, uint32_t stream) {
+        if (!CheckOpen("SetVertexBuffer")) {
+            return;
+        }
+        const SoftwareRHIBuffer* softwareBuffer = dynamic_cast<const SoftwareRHIBuffer*>(buffer);
+        if (!softwareBuffer || !(buffer->GetDesc().usage & RHI_BUFFER_USAGE_VERTEX) || stream >= MAX_VERTEX_STREAMS) {
+            m_device->ReportError("SetVertexBuffer with a foreign buffer, one created without RHI_BUFFER_USAGE_VERTEX or an invalid stream");
+            return;
+        }
+        m_vertexBuffers[stream] = softwareBuffer;
+    }
+
+    bool SoftwareRHICommandList::ResolveVertexStreams() {
+        const VertexFormat& format = m_pipeline->GetDesc().vertexFormat;
+        m_state.vertexFormat = format;
+        m_state.vertexBufferSize = UINT32_MAX;
+        for (uint32_t stream = 0; stream < MAX_VERTEX_STREAMS; stream++) {
+            m_state.vertexStreams[stream] = nullptr;
+            if (stream >= format.GetStreamCount()) {
+                continue;
+            }
+            if (!m_vertexBuffers[stream] || m_vertexBuffers[stream]->GetDesc().stride != format.GetStride(stream)) {
+                return false;
+            }
+            m_state.vertexStreams[stream] = m_vertexBuffers[stream]->GetData();
+            m_state.vertexBufferSize = static_cast<uint32_t>(std::min<uint64_t>(m_state.vertexBufferSize,
+                m_vertexBuffers[stream]->GetDesc().size / format.GetStride(stream)));
+        }
+        return true;
+    }
+
+    void SoftwareRHICommandList::SetIndexBuffer(IRHIBuffer* buffer, RHIFormat format) {
+        if (!CheckOpen("SetIndexBuffer")) {
+            return;
+        }
+        const SoftwareRHIBuffer* softwareBuffer = dynamic_cast<const SoftwareRHIBuffer*>(buffer);
+        if (!softwareBuffer || !(buffer->GetDesc().usage & RHI_BUFFER_USAGE_INDEX)) {
+            m_device->ReportError("SetIndexBuffer with a foreign buffer or one created without RHI_BUFFER_USAGE_INDEX");
+            return;
+        }
+        if (format != RHIFormat::R16Uint && format != RHIFormat::R32Uint) {
+            m_device->ReportError("SetIndexBuffer with a format other than R16Uint/R32Uint");
+            return;
+        }
+        m_indexBuffer = softwareBuffer;
+        m_state.indexFormat = format;
+    }
+
+    void SoftwareRHICommandList::SetInstanceBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) {
+        if (!CheckOpen("SetInstanceBuffer")) {
+            return;
+        }
+        if (!m_pipeline || m_pipeline->GetDesc().instanceStride == 0) {
+            m_device->ReportError("SetInstanceBuffer without an instanced pipeline");
+            return;
+        }
+        if (stride != sizeof(InstanceData) || gpuAddress == 0 || (gpuAddress % alignof(InstanceData)) != 0 || size < stride) {
+            m_device->ReportError("SetInstanceBuffer with a null or misaligned address, an empty range or a stride other than sizeof(InstanceData)");
+            return;
+        }
+        m_state.instances = reinterpret_cast<const InstanceData*>(gpuAddress);
+        m_instanceCapacity = size / stride;
+    }
+
+    void SoftwareRHICommandList::SetObjectBuffer(uint64_t gpuAddress, uint64_t size, uint32_t stride) {
+        if (!CheckOpen("SetObjectBuffer")) {
+            return;
+        }
+        if (!m_pipeline || m_pipeline->GetDesc().objectStride == 0) {
+            m_device->ReportError("SetObjectBuffer without an indirect pipeline");
+            return;
+        }
+        if (stride != sizeof(IndirectObjectData) || gpuAddress == 0 || (gpuAddress % alignof(IndirectObjectData)) != 0 || size < stride) {
+            m_device->ReportError("SetObjectBuffer with a null or misaligned address, an empty range or a stride other than sizeof(IndirectObjectData)");
+            return;
+        }
+        m_objects = reinterpret_cast<const IndirectObjectData*>(gpuAddress);
+        m_objectCapacity = size / stride;
+    }
+
+    bool SoftwareRHICommandList::CheckDrawState(const char* call, uint32_t instanceCount, uint32_t startInstance, bool indirect) {
+        if (!CheckOpen(call)) {
+            return false;
+        }
+
+        const char* missing = nullptr;
+        if (!m_pipeline) {
+            missing = "pipeline";
+        }
+        else if (m_renderTarget == 0) {
+            missing = "render target";
+        }
+        else if (!m_hasViewport) {
+            missing = "viewport";
+        }
+        else if (!m_hasScissor) {
+            missing = "scissor rectangle";
+        }
+        else if (!m_state.constants) {
+            missing = "constant buffer";
+        }
+        else if (!ResolveVertexStreams()) {
+            missing = "vertex buffer of the pipeline's vertex format";
+        }
+        else if (m_pipeline->GetDesc().instanceStride > 0 && m_instanceCapacity == 0) {
+            missing = "instance buffer";
+        }
+        else if (m_pipeline->GetDesc().objectStride > 0 && m_objectCapacity == 0) {
+            missing = "object buffer";
+        }
+
+        if (missing) {
+            m_device->ReportError(std::string(call) + " without a bound " + missing);
+            return false;
+        }
+        if ((m_pipeline->GetDesc().objectStride > 0) != indirect) {
+            m_device->ReportError(std::string(call) + (indirect ? " needs an indirect pipeline" : " on an indirect pipeline (its draw index only comes from ExecuteIndirect)"));
+            return false;
+        }
+        if (instanceCount == 0) {
+            m_device->ReportError(std::string(call) + " with zero instances");
+            return false;
+        }
+        if (m_pipeline->GetDesc().instanceStride > 0 && static_cast<uint64_t>(startInstance) + instanceCount > m_instanceCapacity) {
+            m_device->ReportError(std::string(call) + " reads past the end of the instance buffer");
+            return false;
+        }
+        return true;
+    }
+
+    void SoftwareRHICommandList::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t startVertex, uint32_t startInstance) {
+        if (!CheckDrawState("Draw", instanceCount, startInstance)) {
+            return;
+        }
+        if (static_cast<uint64_t>(startVertex) + vertexCount > m_state.vertexBufferSize) {
+            m_device->ReportError("Draw reads past the end of the vertex buffer");
+            return;
+        }
+
+        Operation operation;
+        operation.type = OperationType::Draw;
+        operation.drawCall = m_state;
+        operation.drawCall.indices = nullptr;
+        operation.drawCall.vertexCount = vertexCount;
+        operation.drawCall.startVertex = startVertex;
+        operation.drawCall.instanceCount = instanceCount;
+        operation.drawCall.startInstance = startInstance;
+        if (m_pipeline->GetDesc().instanceStride == 0) {
+            operation.drawCall.instances = nullptr;
+        }
+        m_operations.push_back(operation);
+    }
+
+    void SoftwareRHICommandList::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) {
+        if (!CheckDrawState("DrawIndexed", instanceCount, startInstance)) {
+            return;
+        }
+        if (!m_indexBuffer) {
+            m_device->ReportError("DrawIndexed without a bound index buffer");
+            return;
+        }
+        uint64_t indexBytes = (static_cast<uint64_t>(startIndex) + indexCount) * GetFormatSize(m_state.indexFormat);
+        if (indexBytes > m_indexBuffer->GetDesc().size) {
+            m_device->ReportError("DrawIndexed reads past the end of the index buffer");
+            return;
+        }
+
+        Operation operation;
+        operation.type = OperationType::Draw;
+        operation.drawCall = m_state;
+        operation.drawCall.indices = m_indexBuffer->GetData();
+        operation.drawCall.indexCount = indexCount;
+        operation.drawCall.startIndex = startIndex;
+        operation.drawCall.baseVertex = baseVertex;
+        operation.drawCall.instanceCount = instanceCount;
+        operation.drawCall.startInstance = startInstance;
+        if (m_pipeline->GetDesc().instanceStride == 0) {
+            operation.drawCall.instances = nullptr;
+        }
+        m_operations.push_back(operation);
+    }
+
+    void SoftwareRHICommandList::ExecuteIndirect(uint64_t argumentAddress, uint32_t commandCount) {
+        if (!CheckDrawState("ExecuteIndirect", 1, 0, true)) {
+            return;
+        }
+        if (!m_indexBuffer) {
+            m_device->ReportError("ExecuteIndirect without a bound index buffer");
+            return;
+        }
+        if (m_pipeline->GetDesc().instanceStride > 0) {
+            m_device->ReportError("ExecuteIndirect needs a pipeline with no instance stream");
+            return;
+        }
+        if (argumentAddress == 0 || (argumentAddress % alignof(RHIIndirectDrawCommand)) != 0 || commandCount == 0) {
+            m_device->ReportError("ExecuteIndirect with a null or misaligned argument address or no commands");
+            return;
+        }
+
+        Operation operation;
+        operation.type = OperationType::DrawIndirect;
+        operation.drawCall = m_state;
+        operation.drawCall.instances = nullptr;
+        operation.drawCall.indices = m_indexBuffer->GetData();
+        operation.arguments = reinterpret_cast<const RHIIndirectDrawCommand*>(argumentAddress);
+        operation.commandCount = commandCount;
+        operation.objects = m_objects;
+        operation.objectCount = m_objectCapacity;
+        operation.indexBufferSize = m_indexBuffer->GetDesc().size / GetFormatSize(m_state.indexFormat);
+        m_operations.push_back(operation);
+    }
+
+    // ---------------------------------------------------------------- Cola
+
+    void SoftwareRHICommandQueue::ExecuteCommandList(IRHICommandList* commandList) {
+        SoftwareRHICommandList* softwareList = dynamic_cast<SoftwareRHICommandList*>(commandList);
+        if (!softwareList) {
+            m_device->ReportError("ExecuteCommandList with a null or foreign command list");
+            return;
+        }
+        if (softwareList->IsOpen()) {
+            m_device->ReportError("ExecuteCommandList with a command list that was not closed");
+            return;
+        }
+
+        // Una sola ejecución a la vez, como una cola de GPU
+        std::lock_guard<std::mutex> lock(m_executeMutex);
+        SoftwareRasterizer& rasterizer = m_device->m_rasterizer;
+        rasterizer.SetTarget(nullptr);
+        for (const SoftwareRHICommandList::Operation& operation : softwareList->GetOperations()) {
+            switch (operation.type) {
+            case SoftwareRHICommandList::OperationType::SetTarget:
+                rasterizer.SetTarget(m_device->FindRenderTarget(operation.renderTargetView));
+                break;
+            case SoftwareRHICommandList::OperationType::Clear:
+                rasterizer.Clear(m_device->FindRenderTarget(operation.renderTargetView), operation.color);
+                break;
+            case SoftwareRHICommandList::OperationType::Draw:
+                rasterizer.Draw(operation.drawCall);
+                break;
+            case SoftwareRHICommandList::OperationType::DrawIndirect:
+                ExecuteIndirect(rasterizer, operation);
+                break;
+            }
+        }
+        rasterizer.Flush();
+        m_indirectConstants.clear();
+
+        std::lock_guard<std::mutex> deviceLock(m_device->m_mutex);
+        m_device->m_commandListsExecuted++;
+    }
+
+    void SoftwareRHICommandQueue::ExecuteIndirect(SoftwareRasterizer& rasterizer, const SoftwareRHICommandList::Operation& operation) {
+        SoftwareDrawCall drawCall = operation.drawCall;
+        for (uint32_t i = 0; i < operation.commandCount; i++) {
+            const RHIIndirectDrawCommand& command = operation.arguments[i];
+            // Como en la GPU, un comando inválido no detiene los demás
+            if (command.drawIndex >= operation.objectCount ||
+                static_cast<uint64_t>(command.startIndex) + command.indexCount > operation.indexBufferSize || command.baseVertex < 0) {
+                m_device->ReportError("ExecuteIndirect command with a draw index past the object buffer or out of range indices");
+                continue;
+            }
+            if (command.instanceCount == 0 || command.indexCount == 0) {
+                continue;
+            }
+            // Lo que IndirectVS lee de b0 (view, projection) y de objects[drawIndex] (model, decuantización)
+            const IndirectObjectData& object = operation.objects[command.drawIndex];
+            SoftwareMVPConstants& constants = m_indirectConstants.emplace_back(*operation.drawCall.constants);
+            constants.model = object.model;
+            std::copy(std::begin(object.positionScale), std::end(object.positionScale), constants.positionScale);
+            std::copy(std::begin(object.positionBias), std::end(object.positionBias), constants.positionBias);
+            drawCall.constants = &constants;
+            drawCall.indexCount = command.indexCount;
+            drawCall.startIndex = command.startIndex;
+            drawCall.baseVertex = command.baseVertex;
+            drawCall.instanceCount = command.instanceCount;
+            drawCall.startInstance = command.startInstance;
+            rasterizer.Draw(drawCall);
+        }
+    }
+
+    uint64_t SoftwareRHICommandQueue::Signal() {
+        // Tras cualquier ejecución en curso: todo lo señalado ya está completado
+        std::lock_guard<std::mutex> lock(m_executeMutex);
+        return m_fenceValue.fetch_add(1) + 1;
+    }
+
+    // ---------------------------------------------------------------- Dispositivo
+
+    SoftwareRHIDevice::SoftwareRHIDevice() : m_queue(this) {
+    }
+
+    SoftwareRHIDevice::~SoftwareRHIDevice() {
+        Shutdown();
+    }
+
+    bool SoftwareRHIDevice::Initialize(uint32_t workerCount) {
+        if (m_initialized) {
+            return true;
+        }
+        if (!m_rasterizer.Initialize(workerCount)) {
+            std::cerr << "Error: Failed to initialize software RHI" << std::endl;
+            return false;
+        }
+        m_initialized = true;
+        return true;
+    }
+
+    void SoftwareRHIDevice::Shutdown() {
+        if (!m_initialized) {
+            return;
+        }
+        m_rasterizer.Shutdown();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_renderTargets.clear();
+        m_constantBlocks.clear();
+        m_currentConstantBlock = SIZE_MAX;
+        m_initialized = false;
+    }
+
+    std::unique_ptr<IRHIBuffer> SoftwareRHIDevice::CreateBuffer(const RHIBufferDesc& desc, const void* initialData) {
+        if (desc.size == 0 || desc.usage == 0) {
+            ReportError("CreateBuffer with zero size or no usage");
+            return nullptr;
+        }
+        if ((desc.usage & RHI_BUFFER_USAGE_VERTEX) && desc.stride == 0) {
+            ReportError("CreateBuffer: vertex buffers need a stride");
+            return nullptr;
+        }
+        if ((desc.usage & RHI_BUFFER_USAGE_INDEX) && desc.stride != 2 && desc.stride != 4) {
+            ReportError("CreateBuffer: index buffers need a 2 or 4 byte stride");
+            return nullptr;
+        }
+        return std::make_unique<SoftwareRHIBuffer>(desc, initialData);
+    }
+
+    std::unique_ptr<IRHIPipeline> SoftwareRHIDevice::CreatePipeline(const RHIPipelineDesc& desc) {
+        if (desc.vertexStride == 0 || desc.vertexStride != desc.vertexFormat.GetStride(0) || !desc.useConstantBuffer || desc.renderTargetFormat != RHIFormat::RGBA8Unorm ||
+            (desc.instanceStride != 0 && desc.instanceStride != sizeof(InstanceData)) ||
+            (desc.objectStride != 0 && (desc.objectStride != sizeof(IndirectObjectData) || desc.instanceStride != 0))) {
+            ReportError("CreatePipeline: the software backend only implements BasicVS/BasicPS, InstancedVS and IndirectVS (VertexFormat streams, InstanceData, IndirectObjectData, MVP constants, RGBA8)");
+            return nullptr;
+        }
+        return std::make_unique<SoftwareRHIPipeline>(desc);
+    }
+
+    std::unique_ptr<IRHICommandList> SoftwareRHIDevice::CreateCommandList() {
+        return std::make_unique<SoftwareRHICommandList>(this);
+    }
+
+    uint64_t SoftwareRHIDevice::AllocateConstants(const void* data, uint64_t size) {
+        if (!data || size == 0) {
+            ReportError("AllocateConstants with no data");
+            return 0;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // La siguiente señal de la cola cubre todo lo que se envíe a partir de ahora
+        uint64_t coveringFence = m_queue.GetCompletedValue() + 1;
+        uint64_t alignedSize = (size + CONSTANT_ALIGNMENT - 1) & ~(CONSTANT_ALIGNMENT - 1);
+
+        bool fits = m_currentConstantBlock != SIZE_MAX &&
+            m_constantBlocks[m_currentConstantBlock].offset + alignedSize <= m_constantBlocks[m_currentConstantBlock].size;
+        if (!fits) {
+            // Reutiliza un bloque que la cola ya terminó de leer o crea uno nuevo
+            m_currentConstantBlock = SIZE_MAX;
+            for (size_t i = 0; i < m_constantBlocks.size(); i++) {
+                ConstantBlock& block = m_constantBlocks[i];
+                if (block.fenceValue < coveringFence && block.size >= alignedSize) {
+                    block.offset = 0;
+                    m_currentConstantBlock = i;
+                    break;
+                }
+            }
+            if (m_currentConstantBlock == SIZE_MAX) {
+                ConstantBlock block;
+                block.size = std::max(CONSTANT_BLOCK_SIZE, alignedSize);
+                block.storage = std::make_unique<uint8_t[]>(static_cast<size_t>(block.size + CONSTANT_ALIGNMENT));
+                uint64_t base = reinterpret_cast<uint64_t>(block.storage.get());
+                block.data = block.storage.get() + (((base + CONSTANT_ALIGNMENT - 1) & ~(CONSTANT_ALIGNMENT - 1)) - base);
+                m_constantBlocks.push_back(std::move(block));
+                m_currentConstantBlock = m_constantBlocks.size() - 1;
+            }
+        }
+
+        ConstantBlock& block = m_constantBlocks[m_currentConstantBlock];
+        uint8_t* destination = block.data + block.offset;
+        std::memcpy(destination, data, static_cast<size_t>(size));
+        block.offset += alignedSize;
+        block.fenceValue = coveringFence;
+        return reinterpret_cast<uint64_t>(destination);
+    }
+
+    uint64_t SoftwareRHIDevice::CreateRenderTarget(uint32_t width, uint32_t height) {
+        if (width == 0 || height == 0) {
+            ReportError("CreateRenderTarget with an empty size");
+            return 0;
+        }
+        std::unique_ptr<SoftwareFramebuffer> framebuffer = std::make_unique<SoftwareFramebuffer>();
+        framebuffer->Resize(width, height);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_renderTargets.push_back(std::move(framebuffer));
+        return m_renderTargets.size(); // Vista = índice + 1 (0 es la vista nula)
+    }
+
+    bool SoftwareRHIDevice::ResizeRenderTarget(uint64_t renderTargetView, uint32_t width, uint32_t height) {
+        SoftwareFramebuffer* framebuffer = FindRenderTarget(renderTargetView);
+        if (!framebuffer || width == 0 || height == 0) {
+            ReportError("ResizeRenderTarget with an unknown view or an empty size");
+            return false;
+        }
+        framebuffer->Resize(width, height);
+        return true;
+    }
+
+    const SoftwareFramebuffer* SoftwareRHIDevice::GetRenderTarget(uint64_t renderTargetView) const {
+        return const_cast<SoftwareRHIDevice*>(this)->FindRenderTarget(renderTargetView);
+    }
+
+    SoftwareFramebuffer* SoftwareRHIDevice::FindRenderTarget(uint64_t renderTargetView) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (renderTargetView == 0 || renderTargetView > m_renderTargets.size()) {
+            return nullptr;
+        }
+        return m_renderTargets[static_cast<size_t>(renderTargetView - 1)].get();
+    }
+
+    void SoftwareRHIDevice::ReportError(const std::string& message) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_validationErrors < MAX_REPORTED_ERRORS) {
+            std::cerr << "Error: SoftwareRHI: " << message << std::endl;
+        }
+        m_validationErrors++;
+    }
+
+    uint64_t SoftwareRHIDevice::GetValidationErrors() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_validationErrors;
+    }
+
+    std::string SoftwareRHIDevice::BuildReport() const {
+        std::ostringstream report;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            report << "Command lists ejecutadas: " << m_commandListsExecuted << ", render targets: " << m_renderTargets.size()
+                   << ", bloques de constantes: " << m_constantBlocks.size() << "\n";
+        }
+        report << m_rasterizer.BuildReport();
+        report << "Errores de validacion: " << GetValidationErrors() << "\n";
+        return report.str();
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,783 @@
+#include "SoftwareRasterizer.h"
+#include "BatchMath.h"
+#include "FramePacer.h"
+#include "SimdFloat4.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+namespace D3D12Core {
+
+    namespace {
+
+        // Triángulos por chunk de setup: pocos chunks dejan hilos parados, muchos multiplican
+        // las listas por tile que hay que recorrer
+        constexpr uint32_t MIN_TRIANGLES_PER_CHUNK = 1024;
+        constexpr uint32_t CHUNKS_PER_THREAD = 4;
+        constexpr uint32_t VERTEX_BATCH = 4096;
+        constexpr uint32_t VERTEX_FETCH_BLOCK = 64;   // Vértices decodificados de una vez en el vertex stage
+        // Guard band en múltiplos de w: solo se recorta en x/y lo que cae fuera (las
+        // coordenadas de pantalla se quedan en un rango donde el snapping sigue siendo exacto)
+        constexpr float GUARD_BAND = 8.0f;
+        constexpr float MIN_CLIP_W = 1e-5f;
+        constexpr uint32_t MAX_CLIPPED_VERTICES = 3 + 7;
+        constexpr uint32_t GAMMA_LUT_SIZE = 4096;
+
+        // pow(saturate(c), 0.9) convertido a UNORM8 (error < 1 LSB respecto al cálculo exacto)
+        struct GammaLut {
+            uint8_t values[GAMMA_LUT_SIZE];
+
+            GammaLut() {
+                for (uint32_t i = 0; i < GAMMA_LUT_SIZE; i++) {
+                    float value = std::pow(static_cast<float>(i) / (GAMMA_LUT_SIZE - 1), 0.9f);
+                    values[i] = static_cast<uint8_t>(std::min(255.0f, value * 255.0f + 0.5f));
+                }
+            }
+        };
+
+        const uint8_t* GetGammaLut() {
+            static const GammaLut lut;
+            return lut.values;
+        }
+
+        inline uint32_t ToUnorm8(float value) {
+            value = std::min(1.0f, std::max(0.0f, value));
+            return static_cast<uint32_t>(value * 255.0f + 0.5f);
+        }
+
+        inline uint32_t PackColor(const float color[4]) {
+            return ToUnorm8(color[0]) | (ToUnorm8(color[1]) << 8) | (ToUnorm8(color[2]) << 16) | (ToUnorm8(color[3]) << 24);
+        }
+
+        // Recorte de Sutherland-Hodgman contra un plano (distancia >= 0 dentro). El punto de
+        // corte se calcula siempre desde el vértice interior para que dos triángulos que
+        // comparten la arista obtengan exactamente el mismo vértice
+        template <typename PolygonVertex, typename Distance>
+        uint32_t ClipPolygon(const PolygonVertex* input, uint32_t inputCount, PolygonVertex* output, Distance distance) {
+            uint32_t outputCount = 0;
+            for (uint32_t i = 0; i < inputCount; i++) {
+                const PolygonVertex& current = input[i];
+                const PolygonVertex& next = input[(i + 1) % inputCount];
+                float currentDistance = distance(current);
+                float nextDistance = distance(next);
+                bool currentInside = currentDistance >= 0.0f;
+                bool nextInside = nextDistance >= 0.0f;
+                if (currentInside) {
+                    output[outputCount++] = current;
+                }
+                if (currentInside != nextInside) {
+                    const PolygonVertex& inside = currentInside ? current : next;
+                    const PolygonVertex& outside = currentInside ? next : current;
+                    float insideDistance = currentInside ? currentDistance : nextDistance;
+                    float outsideDistance = currentInside ? nextDistance : currentDistance;
+                    float t = insideDistance / (insideDistance - outsideDistance);
+                    PolygonVertex& clipped = output[outputCount++];
+                    for (int k = 0; k < 4; k++) {
+                        clipped.position[k] = inside.position[k] + t * (outside.position[k] - inside.position[k]);
+                    }
+                    for (int k = 0; k < 3; k++) {
+                        clipped.color[k] = inside.color[k] + t * (outside.color[k] - inside.color[k]);
+                    }
+                }
+            }
+            return outputCount;
+        }
+
+        // Matriz fila de HLSL equivalente a mul(mul(mul(pos, model), view), projection). El
+        // cbuffer guarda las matrices traspuestas; la world de InstanceData viene sin trasponer
+        // (InstancedVS la reconstruye por filas), así que solo se deshace la trasposición de model
+        void BuildMVP(const Float4x4& model, bool modelTransposed, const SoftwareMVPConstants& constants, float mvp[4][4]) {
+            for (int row = 0; row < 4; row++) {
+                for (int column = 0; column < 4; column++) {
+                    mvp[row][column] = modelTransposed ? model.m[column][row] : model.m[row][column];
+                }
+            }
+            const Float4x4* matrices[2] = { &constants.view, &constants.projection };
+            for (const Float4x4* matrix : matrices) {
+                float product[4][4];
+                for (int row = 0; row < 4; row++) {
+                    for (int column = 0; column < 4; column++) {
+                        float sum = 0.0f;
+                        for (int k = 0; k < 4; k++) {
+                            sum += mvp[row][k] * matrix->m[column][k];
+                        }
+                        product[row][column] = sum;
+                    }
+                }
+                std::copy(&product[0][0], &product[0][0] + 16, &mvp[0][0]);
+            }
+        }
+
+        // Atributos de count vértices desde first como los recibe el vertex shader: posición local
+        // (las cuantizadas con el positionScale/positionBias de las constantes) y color
+        void FetchVertices(const SoftwareDrawCall& draw, uint32_t first, uint32_t count,
+            float positions[][4], float colors[][4]) {
+            const VertexFormat& format = draw.vertexFormat;
+            const uint32_t colorStream = format.splitPosition ? 1 : 0;
+            const uint32_t positionStride = format.GetStride(0);
+            const uint32_t colorStride = format.GetStride(colorStream);
+            const uint8_t* position = draw.vertexStreams[0] + static_cast<size_t>(first) * positionStride;
+            const uint8_t* color = draw.vertexStreams[colorStream] + static_cast<size_t>(first) * colorStride + format.GetColorOffset();
+
+            if (format.position == VertexPositionFormat::Float3) {
+                for (uint32_t i = 0; i < count; i++) {
+                    std::memcpy(positions[i], position + static_cast<size_t>(i) * positionStride, 3 * sizeof(float));
+                }
+            }
+            else {
+                BatchMath::DecodeSnorm16(reinterpret_cast<const int16_t*>(position), positionStride,
+                    draw.constants->positionScale, draw.constants->positionBias, positions[0], sizeof(positions[0]), count);
+            }
+            if (format.color == VertexColorFormat::Float3) {
+                for (uint32_t i = 0; i < count; i++) {
+                    std::memcpy(colors[i], color + static_cast<size_t>(i) * colorStride, 3 * sizeof(float));
+                }
+            }
+            else {
+                BatchMath::DecodeUnorm8(color, colorStride, colors[0], sizeof(colors[0]), count);
+            }
+        }
+
+    } // namespace
+
+    // Triángulo en pantalla: funciones de arista E = A*x + B*y + C (positivas dentro) y planos
+    // de atributos (valor en el vértice 0 más gradientes en x/y)
+    struct SoftwareRasterizer::SetupTriangle {
+        float edgeA[3];
+        float edgeB[3];
+        float edgeC[3];
+        bool topLeft[3];
+        int32_t minX, minY, maxX, maxY; // Píxeles cubiertos posibles (inclusivo)
+        float originX, originY;
+        float invW[3];                  // 1/w: valor, d/dx, d/dy
+        float colorOverW[3][3];         // color/w por canal
+        float depth[3];
+    };
+
+    // Resultado del setup de un rango contiguo de triángulos: los tiles guardan índices a
+    // triangles en orden de envío
+    struct SoftwareRasterizer::Chunk {
+        std::vector<SetupTriangle> triangles;
+        std::vector<std::vector<uint32_t>> bins;
+        uint64_t clipped = 0;
+        uint64_t culled = 0;
+        uint64_t binEntries = 0;
+    };
+
+    void SoftwareFramebuffer::Resize(uint32_t newWidth, uint32_t newHeight, bool withDepth) {
+        width = newWidth;
+        height = newHeight;
+        color.assign(static_cast<size_t>(width) * height, 0xFF000000u);
+        if (withDepth) {
+            depth.assign(static_cast<size_t>(width) * height, 1.0f);
+        }
+        else {
+            depth.clear();
+        }
+    }
+
+    bool SoftwareFramebuffer::WritePPM(const std::string& path) const {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            std::cerr << "Error: No se pudo escribir " << path << std::endl;
+            return false;
+        }
+        std::fprintf(file, "P6\n%u %u\n255\n", width, height);
+        std::vector<uint8_t> row(static_cast<size_t>(width) * 3);
+        for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t x = 0; x < width; x++) {
+                uint32_t pixel = color[static_cast<size_t>(y) * width + x];
+                row[x * 3 + 0] = static_cast<uint8_t>(pixel & 0xFF);
+                row[x * 3 + 1] = static_cast<uint8_t>((pixel >> 8) & 0xFF);
+                row[x * 3 + 2] = static_cast<uint8_t>((pixel >> 16) & 0xFF);
+            }
+            std::fwrite(row.data(), 1, row.size(), file);
+        }
+        bool success = std::ferror(file) == 0;
+        std::fclose(file);
+        return success;
+    }
+
+    SoftwareRasterizer::SoftwareRasterizer() {
+    }
+
+    SoftwareRasterizer::~SoftwareRasterizer() {
+        Shutdown();
+    }
+
+    bool SoftwareRasterizer::Initialize(uint32_t workerCount) {
+        if (m_initialized) {
+            return true;
+        }
+        if (!m_jobs.Initialize(workerCount)) {
+            std::cerr << "Error: Failed to initialize software rasterizer workers" << std::endl;
+            return false;
+        }
+        m_initialized = true;
+        return true;
+    }
+
+    void SoftwareRasterizer::Shutdown() {
+        if (!m_initialized) {
+            return;
+        }
+        m_draws.clear();
+        m_target = nullptr;
+        m_jobs.Shutdown();
+        m_initialized = false;
+    }
+
+    void SoftwareRasterizer::SetTarget(SoftwareFramebuffer* target) {
+        if (target != m_target) {
+            Flush();
+            m_target = target;
+        }
+    }
+
+    void SoftwareRasterizer::Clear(SoftwareFramebuffer* target, const float color[4]) {
+        Flush();
+        if (!target || !color) {
+            std::cerr << "Error: SoftwareRasterizer::Clear sin render target" << std::endl;
+            return;
+        }
+        uint32_t packed = PackColor(color);
+        m_jobs.ParallelFor(target->height, 64, [target, packed](uint32_t begin, uint32_t end, uint32_t) {
+            size_t first = static_cast<size_t>(begin) * target->width;
+            size_t last = static_cast<size_t>(end) * target->width;
+            std::fill(target->color.begin() + first, target->color.begin() + last, packed);
+            if (!target->depth.empty()) {
+                std::fill(target->depth.begin() + first, target->depth.begin() + last, 1.0f);
+            }
+        });
+    }
+
+    void SoftwareRasterizer::Draw(const SoftwareDrawCall& drawCall) {
+        if (!drawCall.vertexStreams[0] || (drawCall.vertexFormat.splitPosition && !drawCall.vertexStreams[1]) ||
+            !drawCall.constants || drawCall.instanceCount == 0) {
+            return;
+        }
+        if (drawCall.indices && drawCall.indexFormat != RHIFormat::R16Uint && drawCall.indexFormat != RHIFormat::R32Uint) {
+            std::cerr << "Error: SoftwareRasterizer::Draw con formato de índices no soportado" << std::endl;
+            return;
+        }
+        m_draws.push_back(drawCall);
+    }
+
+    void SoftwareRasterizer::Flush() {
+        if (m_draws.empty()) {
+            return;
+        }
+        if (!m_initialized || !m_target || m_target->color.empty()) {
+            std::cerr << "Error: SoftwareRasterizer::Flush sin render target (" << m_draws.size() << " draws descartados)" << std::endl;
+            m_draws.clear();
+            return;
+        }
+        if (m_depthTest && m_target->depth.empty()) {
+            std::cerr << "Error: Depth test activo con un render target sin depth" << std::endl;
+            m_draws.clear();
+            return;
+        }
+
+        int64_t start = FramePacer::Now();
+        TransformVertices();
+        int64_t vertexEnd = FramePacer::Now();
+        SetupTriangles();
+        int64_t setupEnd = FramePacer::Now();
+        RasterizeTiles();
+        int64_t rasterEnd = FramePacer::Now();
+
+        m_stats.draws += m_draws.size();
+        m_stats.vertexMs += (vertexEnd - start) / 1000000.0;
+        m_stats.setupMs += (setupEnd - vertexEnd) / 1000000.0;
+        m_stats.rasterMs += (rasterEnd - setupEnd) / 1000000.0;
+        m_draws.clear();
+    }
+
+    void SoftwareRasterizer::TransformVertices() {
+        const uint32_t drawCount = static_cast<uint32_t>(m_draws.size());
+        m_drawFirstVertex.resize(drawCount);
+        m_drawVertexCounts.resize(drawCount);
+        m_drawVertexOffsets.resize(drawCount + 1);
+        m_drawTriangleOffsets.resize(drawCount + 1);
+
+        // Rango de vértices que referencia cada draw (para no transformar el buffer entero)
+        m_jobs.ParallelFor(drawCount, 16, [this](uint32_t begin, uint32_t end, uint32_t) {
+            for (uint32_t drawIndex = begin; drawIndex < end; drawIndex++) {
+                const SoftwareDrawCall& draw = m_draws[drawIndex];
+                uint32_t first = 0;
+                uint32_t count = 0;
+                if (!draw.indices) {
+                    first = std::min(draw.startVertex, draw.vertexBufferSize);
+                    count = std::min(draw.vertexBufferSize - first, draw.vertexCount);
+                }
+                else if (draw.indexCount > 0) {
+                    int64_t lowest = INT64_MAX;
+                    int64_t highest = INT64_MIN;
+                    for (uint32_t i = 0; i < draw.indexCount; i++) {
+                        uint32_t index = draw.indexFormat == RHIFormat::R16Uint
+                            ? static_cast<const uint16_t*>(draw.indices)[draw.startIndex + i]
+                            : static_cast<const uint32_t*>(draw.indices)[draw.startIndex + i];
+                        int64_t vertex = static_cast<int64_t>(index) + draw.baseVertex;
+                        lowest = std::min(lowest, vertex);
+                        highest = std::max(highest, vertex);
+                    }
+                    lowest = std::max<int64_t>(lowest, 0);
+                    highest = std::min<int64_t>(highest, static_cast<int64_t>(draw.vertexBufferSize) - 1);
+                    if (lowest <= highest) {
+                        first = static_cast<uint32_t>(lowest);
+                        count = static_cast<uint32_t>(highest - lowest + 1);
+                    }
+                }
+                m_drawFirstVertex[drawIndex] = first;
+                m_drawVertexCounts[drawIndex] = count;
+            }
+        });
+
+        uint64_t vertexTotal = 0;
+        uint64_t triangleTotal = 0;
+        for (uint32_t drawIndex = 0; drawIndex < drawCount; drawIndex++) {
+            const SoftwareDrawCall& draw = m_draws[drawIndex];
+            m_drawVertexOffsets[drawIndex] = vertexTotal;
+            m_drawTriangleOffsets[drawIndex] = triangleTotal;
+            const uint64_t instances = draw.instances ? draw.instanceCount : 1;
+            vertexTotal += m_drawVertexCounts[drawIndex] * instances;
+            triangleTotal += (draw.indices ? draw.indexCount / 3 : m_drawVertexCounts[drawIndex] / 3) * instances;
+        }
+        m_drawVertexOffsets[drawCount] = vertexTotal;
+        m_drawTriangleOffsets[drawCount] = triangleTotal;
+        m_clipVertices.resize(static_cast<size_t>(vertexTotal));
+        m_stats.vertices += vertexTotal;
+        if (vertexTotal == 0) {
+            return;
+        }
+
+        // Lotes del total de vértices: un lote puede cruzar varios draws
+        m_jobs.ParallelFor(static_cast<uint32_t>(vertexTotal), VERTEX_BATCH, [this](uint32_t begin, uint32_t end, uint32_t) {
+            uint32_t drawIndex = static_cast<uint32_t>(std::upper_bound(m_drawVertexOffsets.begin(), m_drawVertexOffsets.end(),
+                static_cast<uint64_t>(begin)) - m_drawVertexOffsets.begin()) - 1;
+            uint32_t current = begin;
+            while (current < end) {
+                while (m_drawVertexOffsets[drawIndex + 1] <= current) {
+                    drawIndex++;
+                }
+                const SoftwareDrawCall& draw = m_draws[drawIndex];
+                uint32_t drawEnd = static_cast<uint32_t>(std::min<uint64_t>(end, m_drawVertexOffsets[drawIndex + 1]));
+
+                // Los ClipVertex del draw van instancia a instancia: cada tramo del lote
+                // que cae en una instancia comparte matriz y tinte
+                const uint32_t rangeCount = m_drawVertexCounts[drawIndex];
+                while (current < drawEnd) {
+                    uint32_t local = current - static_cast<uint32_t>(m_drawVertexOffsets[drawIndex]);
+                    uint32_t instance = local / rangeCount;
+                    uint32_t segmentEnd = std::min(drawEnd, static_cast<uint32_t>(m_drawVertexOffsets[drawIndex]) + (instance + 1) * rangeCount);
+
+                    float mvp[4][4];
+                    float tint[3] = { 1.0f, 1.0f, 1.0f };
+                    if (draw.instances) {
+                        const InstanceData& instanceData = draw.instances[draw.startInstance + instance];
+                        BuildMVP(instanceData.world, false, *draw.constants, mvp);
+                        std::copy(instanceData.customData, instanceData.customData + 3, tint);
+                    }
+                    else {
+                        BuildMVP(draw.constants->model, true, *draw.constants, mvp);
+                    }
+
+                    uint32_t firstVertex = m_drawFirstVertex[drawIndex] + (local - instance * rangeCount);
+                    for (uint32_t blockBegin = current; blockBegin < segmentEnd; blockBegin += VERTEX_FETCH_BLOCK) {
+                        const uint32_t blockCount = std::min(VERTEX_FETCH_BLOCK, segmentEnd - blockBegin);
+                        float positions[VERTEX_FETCH_BLOCK][4];
+                        float colors[VERTEX_FETCH_BLOCK][4];
+                        FetchVertices(draw, firstVertex + (blockBegin - current), blockCount, positions, colors);
+                        for (uint32_t i = 0; i < blockCount; i++) {
+                            const float* position = positions[i];
+                            ClipVertex& output = m_clipVertices[blockBegin + i];
+                            for (int column = 0; column < 4; column++) {
+                                output.position[column] = position[0] * mvp[0][column] + position[1] * mvp[1][column] +
+                                    position[2] * mvp[2][column] + mvp[3][column];
+                            }
+                            output.color[0] = colors[i][0] * tint[0];
+                            output.color[1] = colors[i][1] * tint[1];
+                            output.color[2] = colors[i][2] * tint[2];
+                        }
+                    }
+                    current = segmentEnd;
+                }
+            }
+        });
+    }
+
+    void SoftwareRasterizer::SetupTriangles() {
+        const uint64_t triangleTotal = m_drawTriangleOffsets.back();
+        m_stats.triangles += triangleTotal;
+        m_tilesX = (m_target->width + TILE_SIZE - 1) / TILE_SIZE;
+        m_tilesY = (m_target->height + TILE_SIZE - 1) / TILE_SIZE;
+        const uint32_t tileCount = m_tilesX * m_tilesY;
+
+        uint32_t trianglesPerChunk = std::max<uint32_t>(MIN_TRIANGLES_PER_CHUNK,
+            static_cast<uint32_t>(triangleTotal / (m_jobs.GetThreadCount() * CHUNKS_PER_THREAD) + 1));
+        m_chunkCount = static_cast<uint32_t>((triangleTotal + trianglesPerChunk - 1) / trianglesPerChunk);
+        if (m_chunks.size() < m_chunkCount) {
+            m_chunks.resize(m_chunkCount);
+        }
+        for (uint32_t c = 0; c < m_chunkCount; c++) {
+            Chunk& chunk = m_chunks[c];
+            chunk.triangles.clear();
+            chunk.bins.resize(tileCount);
+            for (std::vector<uint32_t>& bin : chunk.bins) {
+                bin.clear();
+            }
+            chunk.clipped = 0;
+            chunk.culled = 0;
+            chunk.binEntries = 0;
+        }
+
+        const float framebufferWidth = static_cast<float>(m_target->width);
+        const float framebufferHeight = static_cast<float>(m_target->height);
+        m_jobs.ParallelFor(m_chunkCount, 1, [&](uint32_t chunkBegin, uint32_t chunkEnd, uint32_t) {
+            for (uint32_t chunkIndex = chunkBegin; chunkIndex < chunkEnd; chunkIndex++) {
+                Chunk& chunk = m_chunks[chunkIndex];
+                uint64_t first = static_cast<uint64_t>(chunkIndex) * trianglesPerChunk;
+                uint64_t last = std::min<uint64_t>(triangleTotal, first + trianglesPerChunk);
+                uint32_t drawIndex = static_cast<uint32_t>(std::upper_bound(m_drawTriangleOffsets.begin(), m_drawTriangleOffsets.end(),
+                    first) - m_drawTriangleOffsets.begin()) - 1;
+
+                for (uint64_t triangle = first; triangle < last; triangle++) {
+                    while (m_drawTriangleOffsets[drawIndex + 1] <= triangle) {
+                        drawIndex++;
+                    }
+                    const SoftwareDrawCall& draw = m_draws[drawIndex];
+                    const uint32_t rangeFirst = m_drawFirstVertex[drawIndex];
+                    const uint32_t rangeCount = m_drawVertexCounts[drawIndex];
+                    const uint32_t instanceTriangles = draw.indices ? draw.indexCount / 3 : rangeCount / 3;
+                    const uint64_t drawTriangle = triangle - m_drawTriangleOffsets[drawIndex];
+                    const uint32_t localTriangle = static_cast<uint32_t>(drawTriangle % instanceTriangles);
+                    const uint64_t instanceVertices = m_drawVertexOffsets[drawIndex] + (drawTriangle / instanceTriangles) * rangeCount;
+
+                    ClipVertex polygon[2][MAX_CLIPPED_VERTICES];
+                    bool valid = true;
+                    for (uint32_t corner = 0; corner < 3; corner++) {
+                        int64_t vertex;
+                        if (draw.indices) {
+                            uint32_t position = draw.startIndex + localTriangle * 3 + corner;
+                            uint32_t index = draw.indexFormat == RHIFormat::R16Uint
+                                ? static_cast<const uint16_t*>(draw.indices)[position]
+                                : static_cast<const uint32_t*>(draw.indices)[position];
+                            vertex = static_cast<int64_t>(index) + draw.baseVertex - rangeFirst;
+                        }
+                        else {
+                            vertex = static_cast<int64_t>(localTriangle) * 3 + corner;
+                        }
+                        if (vertex < 0 || vertex >= rangeCount) {
+                            valid = false;
+                            break;
+                        }
+                        polygon[0][corner] = m_clipVertices[instanceVertices + vertex];
+                    }
+                    if (!valid) {
+                        chunk.culled++;
+                        continue;
+                    }
+
+                    // Rechazo trivial: los tres vértices fuera del mismo plano del frustum
+                    uint32_t outsideAll = 0x3F;
+                    uint32_t needsClip = 0;
+                    for (uint32_t corner = 0; corner < 3; corner++) {
+                        const float* p = polygon[0][corner].position;
+                        uint32_t outside = 0;
+                        if (p[0] > p[3]) outside |= 1u << 0;
+                        if (p[0] < -p[3]) outside |= 1u << 1;
+                        if (p[1] > p[3]) outside |= 1u << 2;
+                        if (p[1] < -p[3]) outside |= 1u << 3;
+                        if (p[2] < 0.0f) outside |= 1u << 4;
+                        if (p[2] > p[3]) outside |= 1u << 5;
+                        outsideAll &= outside;
+
+                        float guard = GUARD_BAND * p[3];
+                        if (p[2] < 0.0f) needsClip |= 1u << 0;
+                        if (p[2] > p[3]) needsClip |= 1u << 1;
+                        if (p[3] < MIN_CLIP_W) needsClip |= 1u << 2;
+                        if (p[0] > guard || p[0] < -guard || p[1] > guard || p[1] < -guard) needsClip |= 1u << 3;
+                    }
+                    if (outsideAll != 0) {
+                        chunk.culled++;
+                        continue;
+                    }
+
+                    uint32_t polygonCount = 3;
+                    int current = 0;
+                    if (needsClip) {
+                        chunk.clipped++;
+                        auto clip = [&](auto distance) {
+                            if (polygonCount >= 3) {
+                                polygonCount = ClipPolygon(polygon[current], polygonCount, polygon[current ^ 1], distance);
+                                current ^= 1;
+                            }
+                        };
+                        if (needsClip & (1u << 0)) clip([](const ClipVertex& v) { return v.position[2]; });
+                        if (needsClip & (1u << 1)) clip([](const ClipVertex& v) { return v.position[3] - v.position[2]; });
+                        if (needsClip & (1u << 2)) clip([](const ClipVertex& v) { return v.position[3] - MIN_CLIP_W; });
+                        if (needsClip & (1u << 3)) {
+                            clip([](const ClipVertex& v) { return GUARD_BAND * v.position[3] - v.position[0]; });
+                            clip([](const ClipVertex& v) { return GUARD_BAND * v.position[3] + v.position[0]; });
+                            clip([](const ClipVertex& v) { return GUARD_BAND * v.position[3] - v.position[1]; });
+                            clip([](const ClipVertex& v) { return GUARD_BAND * v.position[3] + v.position[1]; });
+                        }
+                        if (polygonCount < 3) {
+                            chunk.culled++;
+                            continue;
+                        }
+                    }
+
+                    // Viewport y snapping a 1/SUBPIXEL_STEPS de píxel
+                    struct ScreenVertex {
+                        float x, y, z, invW;
+                        float colorOverW[3];
+                    } screen[MAX_CLIPPED_VERTICES];
+                    const RHIViewport& viewport = draw.viewport;
+                    for (uint32_t i = 0; i < polygonCount; i++) {
+                        const ClipVertex& v = polygon[current][i];
+                        float invW = 1.0f / v.position[3];
+                        float x = viewport.x + (v.position[0] * invW + 1.0f) * 0.5f * viewport.width;
+                        float y = viewport.y + (1.0f - v.position[1] * invW) * 0.5f * viewport.height;
+                        screen[i].x = std::floor(x * SUBPIXEL_STEPS + 0.5f) / SUBPIXEL_STEPS;
+                        screen[i].y = std::floor(y * SUBPIXEL_STEPS + 0.5f) / SUBPIXEL_STEPS;
+                        screen[i].z = viewport.minDepth + v.position[2] * invW * (viewport.maxDepth - viewport.minDepth);
+                        screen[i].invW = invW;
+                        for (int k = 0; k < 3; k++) {
+                            screen[i].colorOverW[k] = v.color[k] * invW;
+                        }
+                    }
+
+                    // Rectángulo que se puede tocar: scissor ∩ viewport ∩ render target
+                    float clampLeft = std::max({ static_cast<float>(draw.scissor.left), viewport.x, 0.0f });
+                    float clampTop = std::max({ static_cast<float>(draw.scissor.top), viewport.y, 0.0f });
+                    float clampRight = std::min({ static_cast<float>(draw.scissor.right), viewport.x + viewport.width, framebufferWidth });
+                    float clampBottom = std::min({ static_cast<float>(draw.scissor.bottom), viewport.y + viewport.height, framebufferHeight });
+
+                    // Abanico del polígono recortado (un triángulo si no hubo recorte)
+                    for (uint32_t fan = 1; fan + 1 < polygonCount; fan++) {
+                        const ScreenVertex* v[3] = { &screen[0], &screen[fan], &screen[fan + 1] };
+                        double area = (static_cast<double>(v[1]->x) - v[0]->x) * (static_cast<double>(v[2]->y) - v[0]->y) -
+                            (static_cast<double>(v[1]->y) - v[0]->y) * (static_cast<double>(v[2]->x) - v[0]->x);
+                        if (area == 0.0) {
+                            chunk.culled++;
+                            continue;
+                        }
+                        // Sin culling: los triángulos en sentido contrario se dan la vuelta
+                        if (area < 0.0) {
+                            std::swap(v[1], v[2]);
+                            area = -area;
+                        }
+
+                        float minX = std::min({ v[0]->x, v[1]->x, v[2]->x });
+                        float maxX = std::max({ v[0]->x, v[1]->x, v[2]->x });
+                        float minY = std::min({ v[0]->y, v[1]->y, v[2]->y });
+                        float maxY = std::max({ v[0]->y, v[1]->y, v[2]->y });
+                        // Píxel x cubierto si su centro x + 0.5 cae dentro (los bordes exactos los
+                        // decide la regla top-left al rasterizar)
+                        int32_t pixelMinX = static_cast<int32_t>(std::ceil(std::max(minX, clampLeft) - 0.5f));
+                        int32_t pixelMinY = static_cast<int32_t>(std::ceil(std::max(minY, clampTop) - 0.5f));
+                        int32_t pixelMaxX = std::min(static_cast<int32_t>(std::floor(maxX - 0.5f)),
+                            static_cast<int32_t>(std::ceil(clampRight - 0.5f)) - 1);
+                        int32_t pixelMaxY = std::min(static_cast<int32_t>(std::floor(maxY - 0.5f)),
+                            static_cast<int32_t>(std::ceil(clampBottom - 0.5f)) - 1);
+                        if (pixelMinX > pixelMaxX || pixelMinY > pixelMaxY) {
+                            chunk.culled++;
+                            continue;
+                        }
+
+                        SetupTriangle setup;
+                        // Arista i opuesta al vértice i: E_i vale area en v[i] y 0 en los otros dos.
+                        // Los términos se calculan igual para la arista a->b que para b->a con
+                        // signo contrario, así que dos triángulos vecinos dan valores opuestos exactos
+                        for (int edge = 0; edge < 3; edge++) {
+                            const ScreenVertex* a = v[(edge + 1) % 3];
+                            const ScreenVertex* b = v[(edge + 2) % 3];
+                            setup.edgeA[edge] = a->y - b->y;
+                            setup.edgeB[edge] = b->x - a->x;
+                            setup.edgeC[edge] = static_cast<float>(static_cast<double>(a->x) * b->y - static_cast<double>(b->x) * a->y);
+                            // Dentro si E > 0; con E == 0 solo cuentan las aristas izquierdas
+                            // (el interior está a la derecha) y las superiores (interior debajo)
+                            setup.topLeft[edge] = setup.edgeA[edge] > 0.0f || (setup.edgeA[edge] == 0.0f && setup.edgeB[edge] > 0.0f);
+                        }
+                        setup.minX = pixelMinX;
+                        setup.minY = pixelMinY;
+                        setup.maxX = pixelMaxX;
+                        setup.maxY = pixelMaxY;
+                        setup.originX = v[0]->x;
+                        setup.originY = v[0]->y;
+
+                        float invArea = static_cast<float>(1.0 / area);
+                        auto makePlane = [&](float value0, float value1, float value2, float plane[3]) {
+                            plane[0] = value0;
+                            plane[1] = (setup.edgeA[0] * value0 + setup.edgeA[1] * value1 + setup.edgeA[2] * value2) * invArea;
+                            plane[2] = (setup.edgeB[0] * value0 + setup.edgeB[1] * value1 + setup.edgeB[2] * value2) * invArea;
+                        };
+                        makePlane(v[0]->invW, v[1]->invW, v[2]->invW, setup.invW);
+                        for (int k = 0; k < 3; k++) {
+                            makePlane(v[0]->colorOverW[k], v[1]->colorOverW[k], v[2]->colorOverW[k], setup.colorOverW[k]);
+                        }
+                        makePlane(v[0]->z, v[1]->z, v[2]->z, setup.depth);
+
+                        uint32_t index = static_cast<uint32_t>(chunk.triangles.size());
+                        chunk.triangles.push_back(setup);
+                        for (uint32_t tileY = pixelMinY / TILE_SIZE; tileY <= pixelMaxY / TILE_SIZE; tileY++) {
+                            for (uint32_t tileX = pixelMinX / TILE_SIZE; tileX <= pixelMaxX / TILE_SIZE; tileX++) {
+                                chunk.bins[tileY * m_tilesX + tileX].push_back(index);
+                                chunk.binEntries++;
+                            }
+                        }
+                    }
+                }
+            }
+        });
+
+        for (uint32_t c = 0; c < m_chunkCount; c++) {
+            m_stats.trianglesClipped += m_chunks[c].clipped;
+            m_stats.trianglesCulled += m_chunks[c].culled;
+            m_stats.trianglesSetup += m_chunks[c].triangles.size();
+            m_stats.binEntries += m_chunks[c].binEntries;
+        }
+    }
+
+    void SoftwareRasterizer::RasterizeTiles() {
+        if (m_chunkCount == 0) {
+            return;
+        }
+        const uint32_t tileCount = m_tilesX * m_tilesY;
+        std::vector<uint64_t> pixelsPerThread(m_jobs.GetThreadCount(), 0);
+        m_jobs.ParallelFor(tileCount, 1, [&](uint32_t begin, uint32_t end, uint32_t workerIndex) {
+            for (uint32_t tile = begin; tile < end; tile++) {
+                RasterizeTile(tile % m_tilesX, tile / m_tilesX, pixelsPerThread[workerIndex]);
+            }
+        });
+        for (uint64_t pixels : pixelsPerThread) {
+            m_stats.pixelsShaded += pixels;
+        }
+    }
+
+    void SoftwareRasterizer::RasterizeTile(uint32_t tileX, uint32_t tileY, uint64_t& pixelsShaded) {
+        const uint32_t tile = tileY * m_tilesX + tileX;
+        const int32_t tileMinX = static_cast<int32_t>(tileX * TILE_SIZE);
+        const int32_t tileMinY = static_cast<int32_t>(tileY * TILE_SIZE);
+        const int32_t tileMaxX = std::min<int32_t>(tileMinX + TILE_SIZE, m_target->width) - 1;
+        const int32_t tileMaxY = std::min<int32_t>(tileMinY + TILE_SIZE, m_target->height) - 1;
+        const uint32_t stride = m_target->width;
+        uint32_t* colorBuffer = m_target->color.data();
+        float* depthBuffer = m_depthTest ? m_target->depth.data() : nullptr;
+        const Float4 zero = Float4::Set(0.0f);
+        const Float4 one = Float4::Set(1.0f);
+        const Float4 lutScale = Float4::Set(static_cast<float>(GAMMA_LUT_SIZE - 1));
+        const uint8_t* gammaLut = GetGammaLut();
+        uint64_t shaded = 0;
+
+        // Chunks en orden y triángulos en orden dentro de cada chunk: orden de envío
+        for (uint32_t c = 0; c < m_chunkCount; c++) {
+            const Chunk& chunk = m_chunks[c];
+            for (uint32_t index : chunk.bins[tile]) {
+                const SetupTriangle& triangle = chunk.triangles[index];
+                int32_t minX = std::max(triangle.minX, tileMinX);
+                int32_t maxX = std::min(triangle.maxX, tileMaxX);
+                int32_t minY = std::max(triangle.minY, tileMinY);
+                int32_t maxY = std::min(triangle.maxY, tileMaxY);
+
+                Float4 edgeA[3];
+                Float4 topLeft[3];
+                for (int edge = 0; edge < 3; edge++) {
+                    edgeA[edge] = Float4::Set(triangle.edgeA[edge]);
+                    topLeft[edge] = MaskFromBool(triangle.topLeft[edge]);
+                }
+                const Float4 invWdx = Float4::Set(triangle.invW[1]);
+                const Float4 depthDx = Float4::Set(triangle.depth[1]);
+                Float4 colorDx[3];
+                for (int k = 0; k < 3; k++) {
+                    colorDx[k] = Float4::Set(triangle.colorOverW[k][1]);
+                }
+
+                for (int32_t y = minY; y <= maxY; y++) {
+                    const float pixelY = y + 0.5f;
+                    const float dy = pixelY - triangle.originY;
+                    Float4 rowBase[3];
+                    for (int edge = 0; edge < 3; edge++) {
+                        rowBase[edge] = Float4::Set(triangle.edgeB[edge] * pixelY + triangle.edgeC[edge]);
+                    }
+                    const Float4 invWRow = Float4::Set(triangle.invW[0] + triangle.invW[2] * dy);
+                    const Float4 depthRow = Float4::Set(triangle.depth[0] + triangle.depth[2] * dy);
+                    Float4 colorRow[3];
+                    for (int k = 0; k < 3; k++) {
+                        colorRow[k] = Float4::Set(triangle.colorOverW[k][0] + triangle.colorOverW[k][2] * dy);
+                    }
+                    uint32_t* colorRowPtr = colorBuffer + static_cast<size_t>(y) * stride;
+
+                    for (int32_t x = minX; x <= maxX; x += 4) {
+                        const Float4 pixelX = Float4::Ramp(x + 0.5f);
+                        // Mismas operaciones por píxel en todos los triángulos: E = A*x + (B*y + C)
+                        Float4 inside = CmpGreater(Float4::Set(static_cast<float>(maxX) + 1.0f), pixelX);
+                        for (int edge = 0; edge < 3; edge++) {
+                            Float4 value = edgeA[edge] * pixelX + rowBase[edge];
+                            inside = inside & (CmpGreater(value, zero) | (CmpEqual(value, zero) & topLeft[edge]));
+                        }
+                        int mask = MoveMask(inside);
+                        if (mask == 0) {
+                            continue;
+                        }
+
+                        const Float4 dx = pixelX - Float4::Set(triangle.originX);
+                        if (depthBuffer) {
+                            float* depthPtr = depthBuffer + static_cast<size_t>(y) * stride + x;
+                            Float4 depth = depthRow + depthDx * dx;
+                            float stored[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+                            for (int lane = 0; lane < 4; lane++) {
+                                if (mask & (1 << lane)) stored[lane] = depthPtr[lane];
+                            }
+                            mask &= MoveMask(CmpLess(depth, Float4::Load(stored)));
+                            if (mask == 0) {
+                                continue;
+                            }
+                            float values[4];
+                            depth.Store(values);
+                            for (int lane = 0; lane < 4; lane++) {
+                                if (mask & (1 << lane)) depthPtr[lane] = values[lane];
+                            }
+                        }
+
+                        // Corrección de perspectiva: (color/w) / (1/w) interpolados linealmente
+                        const Float4 w = one / (invWRow + invWdx * dx);
+                        int32_t channels[3][4];
+                        for (int k = 0; k < 3; k++) {
+                            Float4 value = Saturate((colorRow[k] + colorDx[k] * dx) * w) * lutScale;
+                            value.StoreRounded(channels[k]);
+                        }
+                        for (int lane = 0; lane < 4; lane++) {
+                            if (mask & (1 << lane)) {
+                                uint32_t r = gammaLut[channels[0][lane]];
+                                uint32_t g = gammaLut[channels[1][lane]];
+                                uint32_t b = gammaLut[channels[2][lane]];
+                                colorRowPtr[x + lane] = r | (g << 8) | (b << 16) | 0xFF000000u;
+                                shaded++;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        pixelsShaded += shaded;
+    }
+
+    std::string SoftwareRasterizer::BuildReport() const {
+        std::ostringstream report;
+        report << "Draws: " << m_stats.draws << ", vertices: " << m_stats.vertices << ", triangulos: " << m_stats.triangles
+               << " (recortados " << m_stats.trianglesClipped << ", descartados " << m_stats.trianglesCulled << ")\n";
+        report << "Triangulos en tiles: " << m_stats.trianglesSetup << ", entradas de bin: " << m_stats.binEntries
+               << ", pixeles sombreados: " << m_stats.pixelsShaded << "\n";
+        report.setf(std::ios::fixed);
+        report.precision(2);
+        report << "Tiempo: vertices " << m_stats.vertexMs << " ms, setup " << m_stats.setupMs << " ms, raster "
+               << m_stats.rasterMs << " ms (" << m_jobs.GetThreadCount() << " hilos)\n";
+        return report.str();
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,398 @@
+#include "TlsfAllocator.h"
+#include <sstream>
+#include <iomanip>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace D3D12Core {
+
+    namespace {
+
+        // Índice del bit más significativo (value != 0)
+        inline uint32_t HighestBit(uint64_t value) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse64(&index, value);
+            return static_cast<uint32_t>(index);
+#else
+            return 63u - static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+        }
+
+        // Índice del bit menos significativo (value != 0)
+        inline uint32_t LowestBit(uint64_t value) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward64(&index, value);
+            return static_cast<uint32_t>(index);
+#else
+            return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+        }
+
+        inline uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+    } // namespace
+
+    TlsfAllocator::TlsfAllocator() {
+        Reset();
+    }
+
+    void TlsfAllocator::Initialize(uint64_t capacity, uint64_t minAlignment) {
+        m_minAlignment = minAlignment > 0 ? minAlignment : 1;
+        m_capacity = capacity & ~(m_minAlignment - 1);
+        Reset();
+    }
+
+    void TlsfAllocator::Reset() {
+        m_flBitmap = 0;
+        for (uint32_t fl = 0; fl < FL_COUNT; ++fl) {
+            m_slBitmap[fl] = 0;
+            for (uint32_t sl = 0; sl < SL_COUNT; ++sl) {
+                m_freeHeads[fl][sl] = INVALID_HANDLE;
+            }
+        }
+        m_blocks.clear();
+        m_recycledBlocks.clear();
+        m_firstBlock = INVALID_HANDLE;
+        m_usedBytes = 0;
+        m_allocationCount = 0;
+        m_totalAllocations = 0;
+        m_failedAllocations = 0;
+
+        if (m_capacity == 0) {
+            return;
+        }
+
+        // Todo el rango empieza como un único bloque libre
+        m_firstBlock = NewBlock();
+        Block& block = m_blocks[m_firstBlock];
+        block.offset = 0;
+        block.size = m_capacity;
+        InsertFree(m_firstBlock);
+    }
+
+    void TlsfAllocator::Mapping(uint64_t size, uint32_t& fl, uint32_t& sl) {
+        if (size < SL_COUNT) {
+            fl = 0;
+            sl = static_cast<uint32_t>(size);
+        }
+        else {
+            uint32_t msb = HighestBit(size);
+            fl = msb - SL_BITS + 1;
+            sl = static_cast<uint32_t>(size >> (msb - SL_BITS)) - SL_COUNT;
+        }
+    }
+
+    uint32_t TlsfAllocator::FindSuitable(uint64_t size, uint32_t& fl, uint32_t& sl) const {
+        // Redondear al inicio de la siguiente clase: cualquier bloque de esa lista cabe
+        if (size >= SL_COUNT) {
+            uint64_t round = (1ull << (HighestBit(size) - SL_BITS)) - 1;
+            if (size > ~0ull - round) {
+                return INVALID_HANDLE;
+            }
+            size += round;
+        }
+        Mapping(size, fl, sl);
+
+        uint32_t slMap = m_slBitmap[fl] & (~0u << sl);
+        if (slMap == 0) {
+            if (fl + 1 >= FL_COUNT) {
+                return INVALID_HANDLE;
+            }
+            uint64_t flMap = m_flBitmap & (~0ull << (fl + 1));
+            if (flMap == 0) {
+                return INVALID_HANDLE;
+            }
+            fl = LowestBit(flMap);
+            slMap = m_slBitmap[fl];
+        }
+        sl = LowestBit(slMap);
+        return m_freeHeads[fl][sl];
+    }
+
+    void TlsfAllocator::InsertFree(uint32_t index) {
+        uint32_t fl, sl;
+        Mapping(m_blocks[index].size, fl, sl);
+
+        Block& block = m_blocks[index];
+        block.free = true;
+        block.prevFree = INVALID_HANDLE;
+        block.nextFree = m_freeHeads[fl][sl];
+        if (block.nextFree != INVALID_HANDLE) {
+            m_blocks[block.nextFree].prevFree = index;
+        }
+        m_freeHeads[fl][sl] = index;
+        m_flBitmap |= 1ull << fl;
+        m_slBitmap[fl] |= 1u << sl;
+    }
+
+    void TlsfAllocator::RemoveFree(uint32_t index) {
+        uint32_t fl, sl;
+        Mapping(m_blocks[index].size, fl, sl);
+
+        Block& block = m_blocks[index];
+        if (block.prevFree != INVALID_HANDLE) {
+            m_blocks[block.prevFree].nextFree = block.nextFree;
+        }
+        else {
+            m_freeHeads[fl][sl] = block.nextFree;
+            if (block.nextFree == INVALID_HANDLE) {
+                m_slBitmap[fl] &= ~(1u << sl);
+                if (m_slBitmap[fl] == 0) {
+                    m_flBitmap &= ~(1ull << fl);
+                }
+            }
+        }
+        if (block.nextFree != INVALID_HANDLE) {
+            m_blocks[block.nextFree].prevFree = block.prevFree;
+        }
+        block.prevFree = INVALID_HANDLE;
+        block.nextFree = INVALID_HANDLE;
+        block.free = false;
+    }
+
+    uint32_t TlsfAllocator::NewBlock() {
+        uint32_t index;
+        if (!m_recycledBlocks.empty()) {
+            index = m_recycledBlocks.back();
+            m_recycledBlocks.pop_back();
+            m_blocks[index] = Block();
+        }
+        else {
+            index = static_cast<uint32_t>(m_blocks.size());
+            m_blocks.emplace_back();
+        }
+        m_blocks[index].inUse = true;
+        return index;
+    }
+
+    void TlsfAllocator::ReleaseBlock(uint32_t index) {
+        m_blocks[index].inUse = false;
+        m_recycledBlocks.push_back(index);
+    }
+
+    uint32_t TlsfAllocator::SplitBlock(uint32_t index, uint64_t size) {
+        // NewBlock puede realojar m_blocks: no mantener referencias a través de la llamada
+        uint32_t remainder = NewBlock();
+        Block& block = m_blocks[index];
+        Block& rest = m_blocks[remainder];
+
+        rest.offset = block.offset + size;
+        rest.size = block.size - size;
+        rest.prevPhysical = index;
+        rest.nextPhysical = block.nextPhysical;
+        if (block.nextPhysical != INVALID_HANDLE) {
+            m_blocks[block.nextPhysical].prevPhysical = remainder;
+        }
+        block.nextPhysical = remainder;
+        block.size = size;
+        return remainder;
+    }
+
+    void TlsfAllocator::MergeWithNext(uint32_t index) {
+        uint32_t next = m_blocks[index].nextPhysical;
+        Block& block = m_blocks[index];
+        Block& nextBlock = m_blocks[next];
+
+        block.size += nextBlock.size;
+        block.nextPhysical = nextBlock.nextPhysical;
+        if (nextBlock.nextPhysical != INVALID_HANDLE) {
+            m_blocks[nextBlock.nextPhysical].prevPhysical = index;
+        }
+        ReleaseBlock(next);
+    }
+
+    TlsfAllocator::Allocation TlsfAllocator::Allocate(uint64_t size, uint64_t alignment) {
+        Allocation allocation;
+
+        uint64_t align = alignment > m_minAlignment ? alignment : m_minAlignment;
+        size = AlignUp(size > 0 ? size : 1, m_minAlignment);
+
+        // Los bloques ya están alineados a minAlignment: el relleno nunca supera align - minAlignment
+        uint64_t searchSize = size + (align - m_minAlignment);
+
+        uint32_t fl, sl;
+        uint32_t index = FindSuitable(searchSize, fl, sl);
+        if (index == INVALID_HANDLE) {
+            ++m_failedAllocations;
+            return allocation;
+        }
+        RemoveFree(index);
+
+        // Relleno de alineación: se separa como bloque libre propio delante de la asignación
+        uint64_t padding = AlignUp(m_blocks[index].offset, align) - m_blocks[index].offset;
+        if (padding > 0) {
+            uint32_t aligned = SplitBlock(index, padding);
+            InsertFree(index);
+            index = aligned;
+        }
+
+        if (m_blocks[index].size > size) {
+            uint32_t remainder = SplitBlock(index, size);
+            InsertFree(remainder);
+        }
+
+        Block& block = m_blocks[index];
+        block.free = false;
+
+        m_usedBytes += block.size;
+        ++m_allocationCount;
+        ++m_totalAllocations;
+
+        allocation.offset = block.offset;
+        allocation.size = block.size;
+        allocation.handle = index;
+        return allocation;
+    }
+
+    void TlsfAllocator::Free(uint32_t handle) {
+        if (handle >= m_blocks.size() || !m_blocks[handle].inUse || m_blocks[handle].free) {
+            return;
+        }
+
+        m_usedBytes -= m_blocks[handle].size;
+        --m_allocationCount;
+
+        uint32_t index = handle;
+        uint32_t next = m_blocks[index].nextPhysical;
+        if (next != INVALID_HANDLE && m_blocks[next].free) {
+            RemoveFree(next);
+            MergeWithNext(index);
+        }
+
+        uint32_t prev = m_blocks[index].prevPhysical;
+        if (prev != INVALID_HANDLE && m_blocks[prev].free) {
+            RemoveFree(prev);
+            MergeWithNext(prev);
+            index = prev;
+        }
+
+        InsertFree(index);
+    }
+
+    TlsfAllocator::Stats TlsfAllocator::GetStats() const {
+        Stats stats;
+        stats.capacity = m_capacity;
+        stats.usedBytes = m_usedBytes;
+        stats.freeBytes = m_capacity - m_usedBytes;
+        stats.allocationCount = m_allocationCount;
+        stats.totalAllocations = m_totalAllocations;
+        stats.failedAllocations = m_failedAllocations;
+
+        // El bloque más grande está en la clase más alta no vacía
+        if (m_flBitmap != 0) {
+            uint32_t fl = HighestBit(m_flBitmap);
+            uint32_t sl = HighestBit(m_slBitmap[fl]);
+            for (uint32_t i = m_freeHeads[fl][sl]; i != INVALID_HANDLE; i = m_blocks[i].nextFree) {
+                if (m_blocks[i].size > stats.largestFreeBlock) {
+                    stats.largestFreeBlock = m_blocks[i].size;
+                }
+            }
+        }
+
+        for (const Block& block : m_blocks) {
+            if (block.inUse && block.free) {
+                ++stats.freeBlockCount;
+            }
+        }
+        return stats;
+    }
+
+    std::string TlsfAllocator::BuildReport() const {
+        Stats stats = GetStats();
+
+        // Histograma de bloques libres por potencia de dos
+        uint32_t histogram[64] = {};
+        for (const Block& block : m_blocks) {
+            if (block.inUse && block.free) {
+                ++histogram[HighestBit(block.size)];
+            }
+        }
+
+        std::ostringstream report;
+        report << std::fixed << std::setprecision(2);
+        report << "Capacidad: " << stats.capacity / 1024.0 << " KB"
+            << " | Usado: " << stats.usedBytes / 1024.0 << " KB"
+            << " | Libre: " << stats.freeBytes / 1024.0 << " KB"
+            << " | Mayor bloque libre: " << stats.largestFreeBlock / 1024.0 << " KB"
+            << " | Fragmentacion: " << stats.GetFragmentation() * 100.0 << "%"
+            << " | Asignaciones: " << stats.allocationCount
+            << " (fallidas: " << stats.failedAllocations << ")\n";
+        report << "Bloques libres:";
+        bool any = false;
+        for (uint32_t bit = 0; bit < 64; ++bit) {
+            if (histogram[bit] > 0) {
+                report << " [" << (1ull << bit) << "+]x" << histogram[bit];
+                any = true;
+            }
+        }
+        if (!any) {
+            report << " ninguno";
+        }
+        report << "\n";
+        return report.str();
+    }
+
+    bool TlsfAllocator::Validate() const {
+        // Recorrido físico: bloques contiguos que cubren toda la capacidad, sin libres adyacentes
+        uint64_t expectedOffset = 0;
+        uint64_t usedBytes = 0;
+        uint32_t prev = INVALID_HANDLE;
+        uint32_t freeBlocks = 0;
+        for (uint32_t i = m_firstBlock; i != INVALID_HANDLE; i = m_blocks[i].nextPhysical) {
+            const Block& block = m_blocks[i];
+            if (!block.inUse || block.offset != expectedOffset || block.prevPhysical != prev || block.size == 0) {
+                return false;
+            }
+            if (block.offset % m_minAlignment != 0 || block.size % m_minAlignment != 0) {
+                return false;
+            }
+            if (block.free) {
+                if (prev != INVALID_HANDLE && m_blocks[prev].free) {
+                    return false;
+                }
+                ++freeBlocks;
+            }
+            else {
+                usedBytes += block.size;
+            }
+            expectedOffset += block.size;
+            prev = i;
+        }
+        if (expectedOffset != m_capacity || usedBytes != m_usedBytes) {
+            return false;
+        }
+
+        // Listas libres: cada bloque en la clase correcta y bitmaps coherentes
+        uint32_t listed = 0;
+        for (uint32_t fl = 0; fl < FL_COUNT; ++fl) {
+            bool flBit = (m_flBitmap & (1ull << fl)) != 0;
+            if (flBit != (m_slBitmap[fl] != 0)) {
+                return false;
+            }
+            for (uint32_t sl = 0; sl < SL_COUNT; ++sl) {
+                bool slBit = (m_slBitmap[fl] & (1u << sl)) != 0;
+                if (slBit != (m_freeHeads[fl][sl] != INVALID_HANDLE)) {
+                    return false;
+                }
+                uint32_t prevFree = INVALID_HANDLE;
+                for (uint32_t i = m_freeHeads[fl][sl]; i != INVALID_HANDLE; i = m_blocks[i].nextFree) {
+                    uint32_t blockFl, blockSl;
+                    Mapping(m_blocks[i].size, blockFl, blockSl);
+                    if (!m_blocks[i].free || blockFl != fl || blockSl != sl || m_blocks[i].prevFree != prevFree) {
+                        return false;
+                    }
+                    prevFree = i;
+                    ++listed;
+                }
+            }
+        }
+        return listed == freeBlocks;
+    }
+
+} // namespace D3D12Core
@@ -0,0 +1,315 @@
+#include "TransformHierarchy.h"
+#include "BatchMath.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace D3D12Core {
+
+    namespace {
+
+        constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+        // a * b para matrices afines (última columna 0, 0, 0, 1): 36 productos en lugar de 64
+        Float4x4 MultiplyAffine(const Float4x4& a, const Float4x4& b) {
+            Float4x4 result;
+            for (int row = 0; row < 4; row++) {
+                for (int column = 0; column < 3; column++) {
+                    result.m[row][column] = a.m[row][0] * b.m[0][column] + a.m[row][1] * b.m[1][column] +
+                                            a.m[row][2] * b.m[2][column] + (row == 3 ? b.m[3][column] : 0.0f);
+                }
+            }
+            return result;
+        }
+
+    } // namespace
+
+    Quaternion QuaternionRotationNormal(const float axis[3], float angle) {
+        float halfSin = std::sin(angle * 0.5f);
+        Quaternion result;
+        result.x = axis[0] * halfSin;
+        result.y = axis[1] * halfSin;
+        result.z = axis[2] * halfSin;
+        result.w = std::cos(angle * 0.5f);
+        return result;
+    }
+
+    Quaternion QuaternionMultiply(const Quaternion& first, const Quaternion& second) {
+        // Producto de Hamilton second * first: aplicar first y después second
+        Quaternion result;
+        result.w = second.w * first.w - second.x * first.x - second.y * first.y - second.z * first.z;
+        result.x = second.w * first.x + second.x * first.w + second.y * first.z - second.z * first.y;
+        result.y = second.w * first.y - second.x * first.z + second.y * first.w + second.z * first.x;
+        result.z = second.w * first.z + second.x * first.y - second.y * first.x + second.z * first.w;
+        return result;
+    }
+
+    TransformHandle TransformHierarchy::Create(TransformHandle parent) {
+        const uint32_t index = GetCount();
+        const uint32_t parentIndex = parent == INVALID_TRANSFORM ? NO_PARENT : m_handleIndices[parent];
+        const uint32_t depth = parentIndex == NO_PARENT ? 0 : m_depths[parentIndex] + 1;
+
+        // Añadir al final mantiene el orden por niveles salvo si el nodo es menos profundo que el último
+        if (index == 0) {
+            m_levelStarts.assign(1, 0);
+        }
+        else if (depth > m_depths[index - 1]) {
+            m_levelStarts.push_back(index);
+        }
+        else if (depth < m_depths[index - 1]) {
+            m_orderDirty = true;
+        }
+
+        const TransformHandle handle = static_cast<TransformHandle>(m_handleIndices.size());
+        m_handleIndices.push_back(index);
+        m_indexHandles.push_back(handle);
+        m_parents.push_back(parentIndex);
+        m_depths.push_back(depth);
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            m_positions[axis].push_back(0.0f);
+            m_scales[axis].push_back(1.0f);
+            m_localCenters[axis].push_back(0.0f);
+            m_localExtents[axis].push_back(0.0f);
+        }
+        for (uint32_t component = 0; component < 4; component++) {
+            m_rotations[component].push_back(component == 3 ? 1.0f : 0.0f);
+        }
+        m_worlds.emplace_back();
+        m_localDirty.push_back(1);
+        m_worldChanged.push_back(0);
+        m_worldBounds.Resize(index + 1);
+        m_dirtyCount++;
+        return handle;
+    }
+
+    void TransformHierarchy::Clear() {
+        m_parents.clear();
+        m_depths.clear();
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            m_positions[axis].clear();
+            m_scales[axis].clear();
+            m_localCenters[axis].clear();
+            m_localExtents[axis].clear();
+        }
+        for (std::vector<float>& component : m_rotations) {
+            component.clear();
+        }
+        m_worlds.clear();
+        m_localDirty.clear();
+        m_worldChanged.clear();
+        m_indexHandles.clear();
+        m_handleIndices.clear();
+        m_levelStarts.clear();
+        m_worldBounds.Resize(0);
+        m_dirtyCount = 0;
+        m_orderDirty = false;
+    }
+
+    void TransformHierarchy::MarkDirty(uint32_t index) {
+        if (!m_localDirty[index]) {
+            m_localDirty[index] = 1;
+            m_dirtyCount++;
+        }
+    }
+
+    void TransformHierarchy::SetPosition(TransformHandle handle, float x, float y, float z) {
+        uint32_t index = m_handleIndices[handle];
+        m_positions[0][index] = x;
+        m_positions[1][index] = y;
+        m_positions[2][index] = z;
+        MarkDirty(index);
+    }
+
+    void TransformHierarchy::SetRotation(TransformHandle handle, const Quaternion& rotation) {
+        uint32_t index = m_handleIndices[handle];
+        m_rotations[0][index] = rotation.x;
+        m_rotations[1][index] = rotation.y;
+        m_rotations[2][index] = rotation.z;
+        m_rotations[3][index] = rotation.w;
+        MarkDirty(index);
+    }
+
+    void TransformHierarchy::SetScale(TransformHandle handle, float x, float y, float z) {
+        uint32_t index = m_handleIndices[handle];
+        m_scales[0][index] = x;
+        m_scales[1][index] = y;
+        m_scales[2][index] = z;
+        MarkDirty(index);
+    }
+
+    void TransformHierarchy::SetLocalBounds(TransformHandle handle, const float center[3], const float extent[3]) {
+        uint32_t index = m_handleIndices[handle];
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            m_localCenters[axis][index] = center[axis];
+            m_localExtents[axis][index] = extent[axis];
+        }
+        MarkDirty(index);
+    }
+
+    void TransformHierarchy::GetWorldBounds(TransformHandle handle, float center[3], float extent[3]) const {
+        uint32_t index = m_handleIndices[handle];
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            center[axis] = m_worldBounds.GetCenters(axis)[index];
+            extent[axis] = m_worldBounds.GetExtents(axis)[index];
+        }
+    }
+
+    template <typename T>
+    void TransformHierarchy::Permute(std::vector<T>& values, const std::vector<uint32_t>& newIndices) {
+        std::vector<T> permuted(values.size());
+        for (size_t i = 0; i < values.size(); i++) {
+            permuted[newIndices[i]] = values[i];
+        }
+        values.swap(permuted);
+    }
+
+    void TransformHierarchy::Reorder() {
+        const uint32_t count = GetCount();
+        uint32_t levelCount = 0;
+        for (uint32_t depth : m_depths) {
+            levelCount = std::max(levelCount, depth + 1);
+        }
+
+        // Counting sort por profundidad, estable: dentro de un nivel se conserva el orden actual
+        m_levelStarts.assign(levelCount, 0);
+        for (uint32_t depth : m_depths) {
+            if (depth + 1 < levelCount) {
+                m_levelStarts[depth + 1]++;
+            }
+        }
+        for (uint32_t level = 1; level < levelCount; level++) {
+            m_levelStarts[level] += m_levelStarts[level - 1];
+        }
+        std::vector<uint32_t> cursors = m_levelStarts;
+        std::vector<uint32_t> newIndices(count);
+        for (uint32_t i = 0; i < count; i++) {
+            newIndices[i] = cursors[m_depths[i]]++;
+        }
+
+        for (uint32_t& parent : m_parents) {
+            if (parent != NO_PARENT) {
+                parent = newIndices[parent];
+            }
+        }
+        Permute(m_parents, newIndices);
+        Permute(m_depths, newIndices);
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            Permute(m_positions[axis], newIndices);
+            Permute(m_scales[axis], newIndices);
+            Permute(m_localCenters[axis], newIndices);
+            Permute(m_localExtents[axis], newIndices);
+        }
+        for (std::vector<float>& component : m_rotations) {
+            Permute(component, newIndices);
+        }
+        Permute(m_indexHandles, newIndices);
+        for (uint32_t i = 0; i < count; i++) {
+            m_handleIndices[m_indexHandles[i]] = i;
+        }
+
+        // Matrices y AABB de mundo se recalculan enteras en lugar de permutarlas
+        m_localDirty.assign(count, 1);
+        m_worldChanged.assign(count, 0);
+        m_dirtyCount = count;
+        m_orderDirty = false;
+        m_stats.reorders++;
+    }
+
+    void TransformHierarchy::Update(JobSystem* jobs) {
+        if (m_orderDirty) {
+            Reorder();
+        }
+        m_stats.updates++;
+        if (m_dirtyCount == 0) {
+            m_stats.skippedUpdates++;
+            m_stats.lastRecomputed = 0;
+            return;
+        }
+
+        const uint32_t count = GetCount();
+        m_workerRecomputed.assign(jobs ? jobs->GetThreadCount() : 1, 0);
+
+        // Punteros crudos a todos los arrays: el bucle no vuelve a pasar por los vectores
+        const uint32_t* parents = m_parents.data();
+        const float* positions[3] = { m_positions[0].data(), m_positions[1].data(), m_positions[2].data() };
+        const float* rotations[4] = { m_rotations[0].data(), m_rotations[1].data(), m_rotations[2].data(), m_rotations[3].data() };
+        const float* scales[3] = { m_scales[0].data(), m_scales[1].data(), m_scales[2].data() };
+        const float* localCenters[3] = { m_localCenters[0].data(), m_localCenters[1].data(), m_localCenters[2].data() };
+        const float* localExtents[3] = { m_localExtents[0].data(), m_localExtents[1].data(), m_localExtents[2].data() };
+        Float4x4* worlds = m_worlds.data();
+        uint8_t* localDirty = m_localDirty.data();
+        uint8_t* worldChanged = m_worldChanged.data();
+        float* worldCenters[3] = { m_worldBounds.GetCenters(0), m_worldBounds.GetCenters(1), m_worldBounds.GetCenters(2) };
+        float* worldExtents[3] = { m_worldBounds.GetExtents(0), m_worldBounds.GetExtents(1), m_worldBounds.GetExtents(2) };
+
+        for (size_t level = 0; level < m_levelStarts.size(); level++) {
+            const uint32_t levelBegin = m_levelStarts[level];
+            const uint32_t levelEnd = level + 1 < m_levelStarts.size() ? m_levelStarts[level + 1] : count;
+
+            // Los nodos que cambian se agrupan en tramos consecutivos y cada tramo pasa por los
+            // kernels por lotes: matrices locales, producto por el padre y AABB de mundo
+            auto updateRun = [&](uint32_t runBegin, uint32_t runEnd) {
+                const uint32_t runCount = runEnd - runBegin;
+                const float* runPositions[3] = { positions[0] + runBegin, positions[1] + runBegin, positions[2] + runBegin };
+                const float* runRotations[4] = { rotations[0] + runBegin, rotations[1] + runBegin, rotations[2] + runBegin, rotations[3] + runBegin };
+                const float* runScales[3] = { scales[0] + runBegin, scales[1] + runBegin, scales[2] + runBegin };
+                BatchMath::ComposeTransforms(runPositions, runRotations, runScales, worlds + runBegin, runCount);
+                if (level > 0) {
+                    for (uint32_t i = runBegin; i < runEnd; i++) {
+                        worlds[i] = MultiplyAffine(worlds[i], worlds[parents[i]]);
+                    }
+                }
+                const float* runCenters[3] = { localCenters[0] + runBegin, localCenters[1] + runBegin, localCenters[2] + runBegin };
+                const float* runExtents[3] = { localExtents[0] + runBegin, localExtents[1] + runBegin, localExtents[2] + runBegin };
+                float* runWorldCenters[3] = { worldCenters[0] + runBegin, worldCenters[1] + runBegin, worldCenters[2] + runBegin };
+                float* runWorldExtents[3] = { worldExtents[0] + runBegin, worldExtents[1] + runBegin, worldExtents[2] + runBegin };
+                BatchMath::TransformBounds(runCenters, runExtents, worlds + runBegin, runWorldCenters, runWorldExtents, runCount);
+                for (uint32_t i = runBegin; i < runEnd; i++) {
+                    localDirty[i] = 0;
+                    worldChanged[i] = 1;
+                }
+            };
+
+            auto updateRange = [&](uint32_t begin, uint32_t end, uint32_t workerIndex) {
+                uint64_t recomputed = 0;
+                uint32_t runBegin = levelBegin + begin;
+                for (uint32_t i = levelBegin + begin; i < levelBegin + end; i++) {
+                    const uint32_t parent = parents[i];
+                    const bool changed = localDirty[i] || (parent != NO_PARENT && worldChanged[parent]);
+                    if (changed) {
+                        recomputed++;
+                        continue;
+                    }
+                    if (runBegin < i) {
+                        updateRun(runBegin, i);
+                    }
+                    worldChanged[i] = 0;
+                    runBegin = i + 1;
+                }
+                if (runBegin < levelBegin + end) {
+                    updateRun(runBegin, levelBegin + end);
+                }
+                m_workerRecomputed[workerIndex] += recomputed;
+            };
+            JobSystem::ParallelFor(jobs, levelEnd - levelBegin, UPDATE_BATCH, updateRange);
+        }
+
+        uint64_t recomputed = 0;
+        for (uint64_t workerCount : m_workerRecomputed) {
+            recomputed += workerCount;
+        }
+        m_dirtyCount = 0;
+        m_stats.recomputed += recomputed;
+        m_stats.lastRecomputed = recomputed;
+    }
+
+    std::string TransformHierarchy::BuildReport() const {
+        std::ostringstream report;
+        report << "Nodos: " << GetCount() << ", updates: " << m_stats.updates << " (sin cambios "
+               << m_stats.skippedUpdates << "), matrices recalculadas: " << m_stats.recomputed
+               << ", reordenaciones: " << m_stats.reorders << "\n";
+        report << "Ultimo update: " << m_stats.lastRecomputed << " matrices\n";
+        return report.str();
+    }
+
+} // namespace D3D12Core
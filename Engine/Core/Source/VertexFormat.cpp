@@ -0,0 +1,180 @@
+#include "VertexFormat.h"
+#include "BatchMath.h"
+#include "InstanceBatcher.h"
+#include "RHI.h"
+#include <algorithm>
+#include <cstring>
+
+namespace D3D12Core {
+
+    uint32_t VertexFormat::GetStride(uint32_t stream) const {
+        if (stream >= GetStreamCount()) {
+            return 0;
+        }
+        if (!splitPosition) {
+            return GetVertexSize();
+        }
+        return stream == 0 ? GetPositionSize() : GetColorSize();
+    }
+
+    bool ParseVertexFormat(const char* name, VertexFormat& format) {
+        const struct {
+            const char* name;
+            bool compressed;
+            bool split;
+        } names[] = {
+            { "float", false, false }, { "float-split", false, true },
+            { "compact", true, false }, { "compact-split", true, true }
+        };
+        for (const auto& entry : names) {
+            if (std::strcmp(name, entry.name) == 0) {
+                format = entry.compressed ? CompressedVertexFormat() : FullVertexFormat();
+                format.splitPosition = entry.split;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string GetVertexFormatName(const VertexFormat& format) {
+        std::string name = format.position == VertexPositionFormat::Float3 ? "posicion float3" : "posicion snorm16x4";
+        name += format.color == VertexColorFormat::Float3 ? ", color float3" : ", color rgba8";
+        name += format.splitPosition ? ", dos streams" : ", entrelazado";
+        return name;
+    }
+
+    uint32_t BuildVertexElements(const VertexFormat& format, bool instanced, bool positionOnly,
+        VertexElement elements[MAX_VERTEX_ELEMENTS]) {
+        uint32_t count = 0;
+        VertexElement& position = elements[count++];
+        position = VertexElement();
+        position.semantic = "POSITION";
+        position.format = format.position == VertexPositionFormat::Float3 ? RHIFormat::RGB32Float : RHIFormat::RGBA16Snorm;
+        if (!positionOnly) {
+            VertexElement& color = elements[count++];
+            color = VertexElement();
+            color.semantic = "COLOR";
+            color.format = format.color == VertexColorFormat::Float3 ? RHIFormat::RGB32Float : RHIFormat::RGBA8Unorm;
+            color.slot = format.splitPosition ? 1 : 0;
+            color.offset = format.GetColorOffset();
+        }
+        if (instanced) {
+            // World por filas + datos libres, avanzando una vez por instancia
+            const uint32_t slot = format.GetStreamCount();
+            for (uint32_t row = 0; row < 5; row++) {
+                VertexElement& element = elements[count++];
+                element = VertexElement();
+                element.semantic = row < 4 ? "INSTANCE_WORLD" : "INSTANCE_DATA";
+                element.semanticIndex = row < 4 ? row : 0;
+                element.format = RHIFormat::RGBA32Float;
+                element.slot = slot;
+                element.offset = row * 16;
+                element.perInstance = true;
+            }
+            static_assert(sizeof(InstanceData) == 5 * 16, "InstanceData debe ser cinco float4");
+        }
+        return count;
+    }
+
+    bool EncodeVertices(const Vertex* vertices, uint32_t count, const VertexFormat& format, EncodedVertices& output) {
+        if (!vertices || count == 0) {
+            return false;
+        }
+        output.format = format;
+        output.quantization = VertexQuantization();
+        output.vertexCount = count;
+        for (uint32_t stream = 0; stream < MAX_VERTEX_STREAMS; stream++) {
+            output.streams[stream].assign(static_cast<size_t>(count) * format.GetStride(stream), 0);
+        }
+
+        uint8_t* positions = output.streams[0].data();
+        uint8_t* colors = output.streams[format.splitPosition ? 1 : 0].data() + format.GetColorOffset();
+        const uint32_t positionStride = format.GetStride(0);
+        const uint32_t colorStride = format.GetStride(format.splitPosition ? 1 : 0);
+
+        if (format.position == VertexPositionFormat::Float3) {
+            for (uint32_t i = 0; i < count; i++) {
+                std::memcpy(positions + static_cast<size_t>(i) * positionStride, vertices[i].position, sizeof(vertices[i].position));
+            }
+        }
+        else {
+            float minimum[3] = { vertices[0].position[0], vertices[0].position[1], vertices[0].position[2] };
+            float maximum[3] = { minimum[0], minimum[1], minimum[2] };
+            for (uint32_t i = 1; i < count; i++) {
+                for (uint32_t axis = 0; axis < 3; axis++) {
+                    minimum[axis] = std::min(minimum[axis], vertices[i].position[axis]);
+                    maximum[axis] = std::max(maximum[axis], vertices[i].position[axis]);
+                }
+            }
+            // Un eje plano se queda con escala 1: todos sus vértices codifican 0
+            float invScale[3];
+            for (uint32_t axis = 0; axis < 3; axis++) {
+                const float extent = (maximum[axis] - minimum[axis]) * 0.5f;
+                output.quantization.positionBias[axis] = (maximum[axis] + minimum[axis]) * 0.5f;
+                output.quantization.positionScale[axis] = extent > 0.0f ? extent : 1.0f;
+                invScale[axis] = 1.0f / output.quantization.positionScale[axis];
+            }
+            BatchMath::EncodeSnorm16(vertices[0].position, sizeof(Vertex), output.quantization.positionBias, invScale,
+                reinterpret_cast<int16_t*>(positions), positionStride, count);
+        }
+
+        if (format.color == VertexColorFormat::Float3) {
+            for (uint32_t i = 0; i < count; i++) {
+                std::memcpy(colors + static_cast<size_t>(i) * colorStride, vertices[i].color, sizeof(vertices[i].color));
+            }
+        }
+        else {
+            BatchMath::EncodeUnorm8(vertices[0].color, sizeof(Vertex), colors, colorStride, count);
+        }
+        return true;
+    }
+
+    void DecodeVertices(const EncodedVertices& input, std::vector<Vertex>& output) {
+        const VertexFormat& format = input.format;
+        const uint32_t count = input.vertexCount;
+        output.resize(count);
+        if (count == 0) {
+            return;
+        }
+        const uint8_t* positions = input.streams[0].data();
+        const uint8_t* colors = input.streams[format.splitPosition ? 1 : 0].data() + format.GetColorOffset();
+        const uint32_t positionStride = format.GetStride(0);
+        const uint32_t colorStride = format.GetStride(format.splitPosition ? 1 : 0);
+
+        // Los decodificadores escriben cuatro floats por vértice: pasan por un bloque intermedio
+        constexpr uint32_t BLOCK = 256;
+        float block[BLOCK][4];
+        for (uint32_t begin = 0; begin < count; begin += BLOCK) {
+            const uint32_t blockCount = std::min(BLOCK, count - begin);
+            if (format.position == VertexPositionFormat::Float3) {
+                for (uint32_t i = 0; i < blockCount; i++) {
+                    std::memcpy(output[begin + i].position, positions + static_cast<size_t>(begin + i) * positionStride,
+                        sizeof(output[begin + i].position));
+                }
+            }
+            else {
+                BatchMath::DecodeSnorm16(reinterpret_cast<const int16_t*>(positions + static_cast<size_t>(begin) * positionStride),
+                    positionStride, input.quantization.positionScale, input.quantization.positionBias, block[0],
+                    sizeof(block[0]), blockCount);
+                for (uint32_t i = 0; i < blockCount; i++) {
+                    std::memcpy(output[begin + i].position, block[i], sizeof(output[begin + i].position));
+                }
+            }
+
+            if (format.color == VertexColorFormat::Float3) {
+                for (uint32_t i = 0; i < blockCount; i++) {
+                    std::memcpy(output[begin + i].color, colors + static_cast<size_t>(begin + i) * colorStride,
+                        sizeof(output[begin + i].color));
+                }
+            }
+            else {
+                BatchMath::DecodeUnorm8(colors + static_cast<size_t>(begin) * colorStride, colorStride, block[0],
+                    sizeof(block[0]), blockCount);
+                for (uint32_t i = 0; i < blockCount; i++) {
+                    std::memcpy(output[begin + i].color, block[i], sizeof(output[begin + i].color));
+                }
+            }
+        }
+    }
+
+} // namespace D3D12Core
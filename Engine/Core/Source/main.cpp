@@ -5,11 +5,31 @@
 #include "D3D12Mesh.h"
 #include "D3D12ConstantBuffer.h"
 #include "D3D12Material.h"
+#include "D3D12UploadManager.h"
+#include "D3D12FrameAllocator.h"
+#include "D3D12HeapAllocator.h"
+#include "D3D12DescriptorManager.h"
+#include "BatchMath.h"
+#include "EntityWorld.h"
+#include "FramePacer.h"
+#include "FrustumCulling.h"
+#include "IndirectDrawBuilder.h"
+#include "IniFile.h"
+#include "InstanceBatcher.h"
+#include "JobSystem.h"
+#include "MeshLod.h"
+#include "OcclusionCulling.h"
+#include "RenderQueue.h"
+#include "RenderThread.h"
+#include "SceneComponents.h"
+#include "SceneConfig.h"
 #include "Shader.h"
+#include "TransformHierarchy.h"
 #include <windows.h>
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <cstring>
 #include <DirectXMath.h>
 #include <string>
 #include <fstream>
@@ -25,126 +45,41 @@ using namespace DirectX;
 // Forward declarations
 LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 
-// Estructura de configuración
-struct CubeConfig {
-    float rotationSpeed = 0.015f;
-    float scale = 0.6f;
-    float rotationXMultiplier = 0.7f;
-    float cameraX = 0.0f;
-    float cameraY = 1.0f;
-    float cameraZ = -4.0f;
-    float fov = XM_PIDIV4;
-    float clearColorR = 0.05f;
-    float clearColorG = 0.05f;
-    float clearColorB = 0.1f;
-    bool autoRotate = true;
-};
+// Conversión entre XMMATRIX y las matrices de los snapshots (misma disposición que XMFLOAT4X4)
+static_assert(sizeof(D3D12Core::Float4x4) == sizeof(XMFLOAT4X4), "Float4x4 debe coincidir con XMFLOAT4X4");
 
-// Función simple para leer config.json (parsing básico sin librerías externas)
-bool LoadConfig(CubeConfig& config) {
-    // Buscar config.json en múltiples ubicaciones
-    std::ifstream file;
-    std::string configPaths[] = {
-        "Engine/Binaries/Win64/config.json",
-        "x64/Debug/config.json",
-        "config.json"
-    };
-    
-    bool fileOpened = false;
-    for (const auto& path : configPaths) {
-        file.open(path);
-        if (file.is_open()) {
-            fileOpened = true;
-            break;
-        }
-    }
-    
-    if (!fileOpened || !file.is_open()) {
-        return false; // Archivo no existe, usar valores por defecto
-    }
-    
-    std::string line;
-    while (std::getline(file, line)) {
-        // Buscar valores en formato simple: "rotationSpeed": 0.02,
-        if (line.find("\"rotationSpeed\"") != std::string::npos) {
-            size_t colon = line.find(':');
-            if (colon != std::string::npos) {
-                std::string value = line.substr(colon + 1);
-                // Eliminar espacios y comas
-                value.erase(0, value.find_first_not_of(" \t,"));
-                value.erase(value.find_last_not_of(" \t,") + 1);
-                config.rotationSpeed = std::stof(value);
-            }
-        }
-        else if (line.find("\"scale\"") != std::string::npos) {
-            size_t colon = line.find(':');
-            if (colon != std::string::npos) {
-                std::string value = line.substr(colon + 1);
-                value.erase(0, value.find_first_not_of(" \t,"));
-                value.erase(value.find_last_not_of(" \t,") + 1);
-                config.scale = std::stof(value);
-            }
-        }
-        else if (line.find("\"rotationXMultiplier\"") != std::string::npos) {
-            size_t colon = line.find(':');
-            if (colon != std::string::npos) {
-                std::string value = line.substr(colon + 1);
-                value.erase(0, value.find_first_not_of(" \t,"));
-                value.erase(value.find_last_not_of(" \t,") + 1);
-                config.rotationXMultiplier = std::stof(value);
-            }
-        }
-        else if (line.find("\"cameraX\"") != std::string::npos) {
-            size_t colon = line.find(':');
-            if (colon != std::string::npos) {
-                std::string value = line.substr(colon + 1);
-                value.erase(0, value.find_first_not_of(" \t,"));
-                value.erase(value.find_last_not_of(" \t,") + 1);
-                config.cameraX = std::stof(value);
-            }
-        }
-        else if (line.find("\"cameraY\"") != std::string::npos) {
-            size_t colon = line.find(':');
-            if (colon != std::string::npos) {
-                std::string value = line.substr(colon + 1);
-                value.erase(0, value.find_first_not_of(" \t,"));
-                value.erase(value.find_last_not_of(" \t,") + 1);
-                config.cameraY = std::stof(value);
-            }
-        }
-        else if (line.find("\"cameraZ\"") != std::string::npos) {
-            size_t colon = line.find(':');
-            if (colon != std::string::npos) {
-                std::string value = line.substr(colon + 1);
-                value.erase(0, value.find_first_not_of(" \t,"));
-                value.erase(value.find_last_not_of(" \t,") + 1);
-                config.cameraZ = std::stof(value);
-            }
-        }
-        else if (line.find("\"fov\"") != std::string::npos) {
-            size_t colon = line.find(':');
-            if (colon != std::string::npos) {
-                std::string value = line.substr(colon + 1);
-                value.erase(0, value.find_first_not_of(" \t,"));
-                value.erase(value.find_last_not_of(" \t,") + 1);
-                config.fov = std::stof(value);
-            }
-        }
-        else if (line.find("\"autoRotate\"") != std::string::npos) {
-            size_t colon = line.find(':');
-            if (colon != std::string::npos) {
-                std::string value = line.substr(colon + 1);
-                value.erase(0, value.find_first_not_of(" \t,"));
-                value.erase(value.find_last_not_of(" \t,") + 1);
-                config.autoRotate = (value.find("true") != std::string::npos);
-            }
-        }
-    }
-    
-    file.close();
-    return true;
+static void StoreMatrix(D3D12Core::Float4x4& destination, FXMMATRIX matrix) {
+    XMStoreFloat4x4(reinterpret_cast<XMFLOAT4X4*>(&destination), matrix);
+}
+
+static XMMATRIX LoadMatrix(const D3D12Core::Float4x4& source) {
+    return XMLoadFloat4x4(reinterpret_cast<const XMFLOAT4X4*>(&source));
 }
 
+// Escala y bias con que el vertex shader deshace la cuantización de las posiciones de la malla
+static void StoreQuantization(D3D12Core::MVPConstantBuffer& constants, const D3D12Core::VertexQuantization& quantization) {
+    const float* scale = quantization.positionScale;
+    const float* bias = quantization.positionBias;
+    constants.positionScale = XMFLOAT4(scale[0], scale[1], scale[2], 0.0f);
+    constants.positionBias = XMFLOAT4(bias[0], bias[1], bias[2], 0.0f);
+}
+
+// Ancho del depth buffer del occlusion culling (el alto sigue el aspecto del viewport)
+static constexpr UINT OCCLUSION_WIDTH = 320;
+
+// Datos de la aplicación guardados en la ventana (GWLP_USERDATA)
+// Una sola definición: WinMain y WindowProc deben ver la misma disposición
+struct AppData {
+    D3D12Core::D3D12Core* d3d12;
+    D3D12Core::D3D12PipelineState* pso;
+    D3D12Core::D3D12Material* material; // Material System
+    D3D12Core::D3D12Mesh* mesh;
+    float rotationAngle = 0.0f;
+    UINT width;
+    UINT height;
+    D3D12Core::CubeConfig config; // Configuración desde C#
+};
+
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
     // Abrir consola para ver errores
     AllocConsole();
@@ -344,6 +279,54 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     }
     std::cout << "Pipeline State creado correctamente" << std::endl;
 
+    // Engine.ini: junto al ejecutable tras el build; en desarrollo desde la raíz del repositorio
+    D3D12Core::IniFile engineIni;
+    if (!engineIni.Load("Engine.ini") && !engineIni.Load("Engine/Config/Engine.ini")) {
+        std::cerr << "Warning: Engine.ini no encontrado, usando valores por defecto" << std::endl;
+    }
+
+    // Variante instanciada (InstancedVS + BasicPS): opcional, sin ella se dibuja un draw por objeto
+    D3D12Core::D3D12PipelineState* instancedPso = nullptr;
+    std::vector<BYTE> instancedVsBytecode;
+    if (D3D12Core::ShaderCompiler::CompileShader(L"Engine/Rendering/Shaders/InstancedVS.hlsl", "main", "vs_5_0", instancedVsBytecode, error)) {
+        D3D12Core::Shader instancedVertexShader;
+        instancedVertexShader.LoadFromBytecode(instancedVsBytecode.data(), instancedVsBytecode.size());
+        instancedPso = new D3D12Core::D3D12PipelineState();
+        if (!instancedPso->Initialize(d3d12->GetDevice()->GetDevice(), instancedVertexShader, pixelShader,
+            D3D12Core::BACK_BUFFER_FORMAT, true)) {
+            delete instancedPso;
+            instancedPso = nullptr;
+        }
+    }
+    if (instancedPso) {
+        std::cout << "Pipeline State instanciado creado correctamente" << std::endl;
+    }
+    else {
+        std::cout << "Advertencia: InstancedVS no disponible, un draw por objeto" << std::endl;
+    }
+
+    // Variante de ExecuteIndirect (IndirectVS + BasicPS), con su firma de comandos. Solo con
+    // [Rendering] IndirectDraws=true: entonces es el camino principal y el instanciado su respaldo
+    const bool indirectDraws = engineIni.GetBool("Rendering", "IndirectDraws", false);
+    D3D12Core::D3D12PipelineState* indirectPso = nullptr;
+    std::vector<BYTE> indirectVsBytecode;
+    if (indirectDraws && D3D12Core::ShaderCompiler::CompileShader(L"Engine/Rendering/Shaders/IndirectVS.hlsl", "main", "vs_5_0", indirectVsBytecode, error)) {
+        D3D12Core::Shader indirectVertexShader;
+        indirectVertexShader.LoadFromBytecode(indirectVsBytecode.data(), indirectVsBytecode.size());
+        indirectPso = new D3D12Core::D3D12PipelineState();
+        if (!indirectPso->Initialize(d3d12->GetDevice()->GetDevice(), indirectVertexShader, pixelShader,
+            D3D12Core::BACK_BUFFER_FORMAT, false, D3D12Core::VertexFormat(), true) || !indirectPso->GetDrawIndirectSignature()) {
+            delete indirectPso;
+            indirectPso = nullptr;
+        }
+    }
+    if (indirectPso) {
+        std::cout << "Pipeline State indirecto creado correctamente (ExecuteIndirect por material)" << std::endl;
+    }
+    else if (indirectDraws) {
+        std::cout << "Advertencia: IndirectVS no disponible, se usa el camino instanciado" << std::endl;
+    }
+
     // Crear geometría del cubo (estilo Vulkan Cube)
     std::cout << "Creando geometria del cubo..." << std::endl;
     std::vector<D3D12Core::Vertex> cubeVertices = {
@@ -375,49 +358,36 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         5, 4, 1,  1, 0, 5
     };
 
-    // Crear mesh del cubo
+    // Niveles de detalle de cada malla (por meshId): todos en el index buffer de la malla
+    std::vector<D3D12Core::MeshLodChain> meshLods(1);
+    meshLods[0].Build(cubeVertices, cubeIndices);
+
+    // Crear mesh del cubo (subida asíncrona por la cola de copia)
+    D3D12Core::D3D12UploadManager* uploadManager = d3d12->GetUploadManager();
+    uploadManager->BeginLoad();
     D3D12Core::D3D12Mesh* cubeMesh = new D3D12Core::D3D12Mesh();
-    if (!cubeMesh->Initialize(
+    bool meshInitialized = cubeMesh->Initialize(
         d3d12->GetDevice()->GetDevice(),
-        d3d12->GetCommandQueue()->GetQueue(),
+        uploadManager,
         cubeVertices,
-        cubeIndices)) {
+        meshLods[0],
+        d3d12->GetHeapAllocator());
+    uploadManager->EndLoad();
+    if (!meshInitialized) {
         std::cerr << "Error: Failed to create cube mesh" << std::endl;
         delete cubeMesh;
+        delete indirectPso;
+        delete instancedPso;
         delete pso;
         delete d3d12;
         FreeConsole();
         return 1;
     }
     std::cout << "Mesh del cubo creado correctamente" << std::endl;
+    // Proxy de oclusión de cada malla (por meshId) desde la misma geometría que los buffers
+    std::vector<D3D12Core::OcclusionMesh> occlusionMeshes(1);
+    occlusionMeshes[0].Build(cubeVertices, cubeIndices);
 
-    // Crear constant buffer para matrices MVP
-    std::cout << "Creando Constant Buffer..." << std::endl;
-    D3D12Core::D3D12ConstantBuffer* mvpBuffer = new D3D12Core::D3D12ConstantBuffer();
-    if (!mvpBuffer->Initialize(d3d12->GetDevice()->GetDevice(), sizeof(D3D12Core::MVPConstantBuffer))) {
-        std::cerr << "Error: Failed to create MVP constant buffer" << std::endl;
-        delete mvpBuffer;
-        delete cubeMesh;
-        delete pso;
-        delete d3d12;
-        FreeConsole();
-        return 1;
-    }
-    std::cout << "Constant Buffer creado correctamente" << std::endl;
-
-    // Guardar punteros en la ventana (usando estructura)
-    struct AppData {
-        D3D12Core::D3D12Core* d3d12;
-        D3D12Core::D3D12PipelineState* pso;
-        D3D12Core::D3D12Material* material; // Material System
-        D3D12Core::D3D12Mesh* mesh;
-        D3D12Core::D3D12ConstantBuffer* mvpBuffer;
-        float rotationAngle = 0.0f;
-        UINT width;
-        UINT height;
-        CubeConfig config; // Configuración desde C#
-    };
-    
     // Crear Material System
     std::cout << "Creando Material System..." << std::endl;
     D3D12Core::D3D12Material* material = new D3D12Core::D3D12Material();
@@ -428,7 +398,8 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         d3d12->GetDevice()->GetDevice(), 
         "CubeMaterial", 
         vsPath, 
-        psPath
+        psPath,
+        d3d12->GetHeapAllocator()
     );
     
     if (materialInitialized) {
@@ -436,12 +407,15 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     } else {
         std::cout << "Advertencia: Material System no inicializado, usando PSO básico" << std::endl;
     }
+
+    // Uso y fragmentación de la memoria de GPU tras la carga inicial
+    d3d12->GetHeapAllocator()->LogReport();
     
     // Cargar configuración inicial
-    CubeConfig initialConfig;
-    LoadConfig(initialConfig);
+    D3D12Core::CubeConfig initialConfig;
+    D3D12Core::LoadConfig(initialConfig);
     
-    AppData* appData = new AppData{ d3d12, pso, material, cubeMesh, mvpBuffer, 0.0f, width, height, initialConfig };
+    AppData* appData = new AppData{ d3d12, pso, material, cubeMesh, 0.0f, width, height, initialConfig };
     SetWindowLongPtr(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(appData));
 
     std::cout << "=== Iniciando loop de renderizado ===" << std::endl;
@@ -460,17 +434,341 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     static std::filesystem::file_time_type lastConfigWriteTime;
     static bool configFileExists = false;
     
-    // Control de frame time para VSync
-    LARGE_INTEGER frequency, lastTime, currentTime;
-    QueryPerformanceFrequency(&frequency);
-    QueryPerformanceCounter(&lastTime);
-    const double targetFrameTime = 1.0 / 60.0; // 60 FPS
+    // Ritmo de frames: objetivo de Engine.ini ([Performance] TargetFPS limitado por [Rendering] MaxFPS)
+    const bool vsync = engineIni.GetBool("Rendering", "VSync", true);
+    D3D12Core::FramePacer framePacer;
+    framePacer.Initialize(D3D12Core::FramePacer::LoadSettings(engineIni));
+    std::cout << "Frame pacing: " << framePacer.GetTargetFps() << " FPS (VSync " << (vsync ? "on" : "off") << ")" << std::endl;
+
+    // Hilo de render: consume el snapshot más reciente publicado por el loop principal.
+    // Es el único hilo que usa el dispositivo (Resize, grabación y Present), así que un Present
+    // lento ya no retrasa la entrada ni la sincronización con el editor
+    D3D12Core::MaterialProxy materialParams; // Último estado del material según el editor
+    materialParams.materialId = 0;
+    D3D12Core::InstanceBatcher instanceBatcher; // Solo lo usa el hilo de render
+    D3D12Core::RenderQueue renderQueue;         // Orden de los draws de uno en uno (hilo de render)
+    D3D12Core::CullingBounds cullingBounds;     // AABB de mundo de los proxies del frame
+    D3D12Core::FrustumCuller frustumCuller;
+    std::vector<D3D12Core::RenderProxy> visibleProxies;
+    D3D12Core::OcclusionCuller occlusionCuller;  // Descarta los visibles del frustum tapados por oclusores
+    std::vector<D3D12Core::Float4x4> drawModels; // Models traspuestos en orden de dibujo (un draw por proxy)
+    // Culling, argumentos de ExecuteIndirect y sort de la RenderQueue en hilos de trabajo (tabla de mallas: el cubo)
+    D3D12Core::JobSystem renderJobs;
+    renderJobs.Initialize();
+    D3D12Core::IndirectDrawBuilder indirectBuilder;
+    std::vector<D3D12Core::IndirectMesh> indirectMeshes(1);
+    indirectMeshes[0].lodCount = cubeMesh->GetLodCount();
+    indirectMeshes[0].quantization = cubeMesh->GetQuantization();
+    for (UINT lod = 0; lod < cubeMesh->GetLodCount(); lod++) {
+        indirectMeshes[0].lods[lod].startIndex = cubeMesh->GetLod(lod).startIndex;
+        indirectMeshes[0].lods[lod].indexCount = cubeMesh->GetLod(lod).indexCount;
+    }
+    D3D12Core::RenderThread renderThread;
+    UINT renderWidth = 0;
+    UINT renderHeight = 0;
+    uint32_t appliedMaterialVersion = 0;
+    renderThread.Start([&](const D3D12Core::RenderSnapshot& snapshot) {
+        if (snapshot.viewportWidth == 0 || snapshot.viewportHeight == 0) {
+            return; // Ventana minimizada o aún sin tamaño
+        }
+
+        // Render frame (con manejo de errores robusto para que el hilo continúe)
+        try {
+            // Actualizar el tamaño del viewport si ha cambiado (resolución automática)
+            // El sistema C# calcula automáticamente el tamaño óptimo del viewport usando ViewportAutoScaler
+            // Se hace antes de BeginFrame: Resize recrea los back buffers que importa el grafo del frame
+            if (snapshot.viewportWidth != renderWidth || snapshot.viewportHeight != renderHeight) {
+                d3d12->Resize(snapshot.viewportWidth, snapshot.viewportHeight);
+                renderWidth = snapshot.viewportWidth;
+                renderHeight = snapshot.viewportHeight;
+                UINT occlusionHeight = OCCLUSION_WIDTH * renderHeight / renderWidth;
+                occlusionCuller.Initialize(OCCLUSION_WIDTH, occlusionHeight > 0 ? occlusionHeight : 1);
+            }
+
+            // Parámetros del material: solo se suben cuando el editor los cambió
+            for (const D3D12Core::MaterialProxy& materialProxy : snapshot.materials) {
+                if (materialProxy.version != appliedMaterialVersion && appData->material && appData->material->IsValid()) {
+                    appData->material->SetVector3("BaseColor", DirectX::XMFLOAT3(
+                        materialProxy.baseColor[0], materialProxy.baseColor[1], materialProxy.baseColor[2]));
+                    appliedMaterialVersion = materialProxy.version;
+                }
+            }
+
+            d3d12->BeginFrame();
+            
+            // Verificar que la command list y el grafo del frame existan
+            D3D12Core::RenderGraph* renderGraph = d3d12->GetRenderGraph();
+            if (!d3d12->GetCommandQueue()->GetCommandList() || !renderGraph) {
+                std::cerr << "Warning: Command list es NULL, saltando frame" << std::endl;
+                d3d12->EndFrame(); // Asegurar que EndFrame se llame
+                return;
+            }
+            
+            // Pase de escena: dibuja encima de la limpieza del back buffer (por eso ReadWrite).
+            // Se graba en EndFrame, cuando el grafo del frame se compila y ejecuta
+            D3D12Core::RenderGraphResource backBuffer = d3d12->GetBackBufferResource();
+            renderGraph->AddPass("Scene", [&](D3D12Core::RenderGraphContext& context) {
+                ID3D12GraphicsCommandList* commandList = static_cast<ID3D12GraphicsCommandList*>(context.commandList);
+
+                // Establecer viewport y scissor rect al tamaño COMPLETO del swap chain
+                // El viewport debe llenar TODO el espacio disponible sin bordes vacíos
+                UINT currentWidth = d3d12->GetWidth();
+                UINT currentHeight = d3d12->GetHeight();
+                if (currentWidth == 0 || currentHeight == 0) {
+                    currentWidth = snapshot.viewportWidth;
+                    currentHeight = snapshot.viewportHeight;
+                }
+                D3D12_VIEWPORT viewport = { 0.0f, 0.0f, (float)currentWidth, (float)currentHeight, 0.0f, 1.0f };
+                D3D12_RECT scissorRect = { 0, 0, (LONG)currentWidth, (LONG)currentHeight };
+                commandList->RSSetViewports(1, &viewport);
+                commandList->RSSetScissorRects(1, &scissorRect);
+
+                // Culling: AABB de mundo de cada proxy (calculadas en el hilo de juego) contra el
+                // frustum de la cámara; el resto del pase solo ve los visibles
+                UINT proxyCount = static_cast<UINT>(snapshot.proxies.size());
+                cullingBounds.Resize(proxyCount);
+                renderJobs.ParallelFor(proxyCount, 4096, [&](uint32_t begin, uint32_t end, uint32_t) {
+                    for (uint32_t i = begin; i < end; i++) {
+                        cullingBounds.Set(i, snapshot.proxies[i].boundsCenter, snapshot.proxies[i].boundsExtent);
+                    }
+                });
+                UINT visibleCount = frustumCuller.Cull(D3D12Core::CullingFrustum::FromCamera(snapshot.camera),
+                    cullingBounds, &renderJobs);
+
+                // Occlusion culling: los oclusores visibles se rasterizan en un depth buffer de
+                // baja resolución y el resto de candidatos se prueba contra su pirámide
+                occlusionCuller.BeginFrame(snapshot.camera, proxyCount);
+                for (UINT i = 0; i < visibleCount; i++) {
+                    UINT index = frustumCuller.GetVisibleIndices()[i];
+                    const D3D12Core::RenderProxy& proxy = snapshot.proxies[index];
+                    if (proxy.occluder && proxy.meshId < occlusionMeshes.size()) {
+                        occlusionCuller.AddOccluder(occlusionMeshes[proxy.meshId], proxy.world, index);
+                    }
+                }
+                occlusionCuller.RenderOccluders(&renderJobs);
+                visibleCount = occlusionCuller.Test(cullingBounds, frustumCuller.GetVisibleIndices(), visibleCount, &renderJobs);
+                visibleProxies.resize(visibleCount);
+                for (UINT i = 0; i < visibleCount; i++) {
+                    visibleProxies[i] = snapshot.proxies[occlusionCuller.GetVisibleIndices()[i]];
+                }
+                
+                // Usar Material System si está disponible, sino usar PSO básico
+                bool useMaterial = false;
+                if (appData->material && appData->material->IsValid()) {
+                    try {
+                        appData->material->Bind(commandList);
+                        useMaterial = true;
+                    } catch (...) {
+                        // Si falla el material, usar PSO básico
+                        useMaterial = false;
+                    }
+                }
+                
+                if (!useMaterial) {
+                    // Establecer pipeline state básico
+                    if (pso && pso->GetPSO() && pso->GetRootSignature()) {
+                        commandList->SetPipelineState(pso->GetPSO());
+                        commandList->SetGraphicsRootSignature(pso->GetRootSignature());
+                    } else {
+                        std::cerr << "Error: PSO básico no válido, saltando escena" << std::endl;
+                        return; // El resto del frame (limpieza y Present) sigue adelante
+                    }
+                }
+
+                if (pso && pso->HasConstantBuffer()) {
+                    // Tabla bindless: una sola vez por root signature, sin tablas por draw
+                    d3d12->GetDescriptorManager()->BindBindlessTable(commandList);
+                }
+
+                // Un ExecuteIndirect por material (solo con IndirectDraws=true en Engine.ini): objetos y
+                // argumentos escritos directamente en la memoria del frame por los hilos de trabajo. Cada
+                // comando solo fija el índice de su objeto; view y projection van una vez en la CBV compartida.
+                // Sin memoria del frame para los argumentos sigue el camino instanciado
+                if (indirectPso && appData->mesh) {
+                    D3D12Core::D3D12FrameAllocator* frameAllocator = d3d12->GetFrameAllocator();
+                    UINT commandCount = indirectBuilder.Prepare(visibleProxies, indirectMeshes);
+                    D3D12Core::DynamicAllocation objectAllocation;
+                    D3D12Core::DynamicAllocation argumentAllocation;
+                    if (commandCount > 0) {
+                        objectAllocation = frameAllocator->Allocate(commandCount * sizeof(D3D12Core::IndirectObjectData), 16);
+                        argumentAllocation = frameAllocator->Allocate(commandCount * sizeof(D3D12Core::RHIIndirectDrawCommand));
+                    }
+                    D3D12Core::MVPConstantBuffer sharedData;
+                    XMStoreFloat4x4(&sharedData.view, XMMatrixTranspose(LoadMatrix(snapshot.camera.view)));
+                    XMStoreFloat4x4(&sharedData.projection, XMMatrixTranspose(LoadMatrix(snapshot.camera.projection)));
+                    D3D12_GPU_VIRTUAL_ADDRESS sharedAddress = 0;
+                    UINT64 argumentOffset = 0;
+                    if (objectAllocation.IsValid() && argumentAllocation.IsValid() &&
+                        frameAllocator->GetResourceOffset(argumentAllocation.gpuAddress, argumentOffset)) {
+                        sharedAddress = frameAllocator->AllocateConstants(sharedData);
+                    }
+                    if (sharedAddress != 0) {
+                        indirectBuilder.WriteObjects(visibleProxies,
+                            static_cast<D3D12Core::IndirectObjectData*>(objectAllocation.cpuAddress), &renderJobs);
+                        indirectBuilder.WriteCommands(
+                            static_cast<D3D12Core::RHIIndirectDrawCommand*>(argumentAllocation.cpuAddress), &renderJobs);
+
+                        // BasicPS no lee parámetros del material, así que todos los buckets usan el PSO indirecto
+                        commandList->SetPipelineState(indirectPso->GetPSO());
+                        commandList->SetGraphicsRootSignature(indirectPso->GetRootSignature());
+                        d3d12->GetDescriptorManager()->BindBindlessTable(commandList);
+                        commandList->SetGraphicsRootConstantBufferView(0, sharedAddress);
+                        commandList->SetGraphicsRootShaderResourceView(D3D12Core::ROOT_PARAMETER_INDIRECT_OBJECTS, objectAllocation.gpuAddress);
+                        d3d12->RequireUpload(appData->mesh->GetUploadToken());
+                        appData->mesh->Bind(commandList);
+                        for (const D3D12Core::IndirectDrawBucket& bucket : indirectBuilder.GetBuckets()) {
+                            commandList->ExecuteIndirect(indirectPso->GetDrawIndirectSignature(), bucket.commandCount,
+                                frameAllocator->GetResource(), argumentOffset + bucket.firstCommand * sizeof(D3D12Core::RHIIndirectDrawCommand),
+                                nullptr, 0);
+                        }
+                        return;
+                    }
+                }
+
+                // Instanciado (camino por defecto y respaldo del indirecto): un draw por (malla, material)
+                // con las world en el slot 1. BasicPS no lee parámetros del material, así que el PSO
+                // instanciado da la misma imagen
+                if (instancedPso && instancedPso->GetPSO() && instancedPso->HasConstantBuffer()) {
+                    instanceBatcher.Build(visibleProxies);
+                    const std::vector<D3D12Core::InstanceData>& instances = instanceBatcher.GetInstances();
+                    UINT64 instanceBytes = instances.size() * sizeof(D3D12Core::InstanceData);
+                    D3D12Core::DynamicAllocation instanceAllocation;
+                    if (instanceBytes > 0) {
+                        instanceAllocation = d3d12->GetFrameAllocator()->Allocate(instanceBytes, 16);
+                    }
+                    if (instanceAllocation.IsValid()) {
+                        memcpy(instanceAllocation.cpuAddress, instances.data(), static_cast<size_t>(instanceBytes));
+                        commandList->SetPipelineState(instancedPso->GetPSO());
+                        commandList->SetGraphicsRootSignature(instancedPso->GetRootSignature());
+                        d3d12->GetDescriptorManager()->BindBindlessTable(commandList);
+
+                        D3D12Core::MVPConstantBuffer mvpData;
+                        XMStoreFloat4x4(&mvpData.model, XMMatrixIdentity()); // InstancedVS no la lee
+                        XMStoreFloat4x4(&mvpData.view, XMMatrixTranspose(LoadMatrix(snapshot.camera.view)));
+                        XMStoreFloat4x4(&mvpData.projection, XMMatrixTranspose(LoadMatrix(snapshot.camera.projection)));
+                        if (appData->mesh) {
+                            StoreQuantization(mvpData, appData->mesh->GetQuantization());
+                        }
+                        D3D12_GPU_VIRTUAL_ADDRESS mvpAddress = d3d12->GetFrameAllocator()->AllocateConstants(mvpData);
+                        if (mvpAddress != 0) {
+                            commandList->SetGraphicsRootConstantBufferView(0, mvpAddress);
+                        }
+
+                        D3D12_VERTEX_BUFFER_VIEW instanceView = {};
+                        instanceView.BufferLocation = instanceAllocation.gpuAddress;
+                        instanceView.SizeInBytes = static_cast<UINT>(instanceBytes);
+                        instanceView.StrideInBytes = sizeof(D3D12Core::InstanceData);
+                        for (const D3D12Core::InstanceBatch& batch : instanceBatcher.GetBatches()) {
+                            if (batch.meshId == 0 && appData->mesh) {
+                                d3d12->RequireUpload(appData->mesh->GetUploadToken());
+                                appData->mesh->DrawInstanced(commandList, instanceView, batch.instanceCount, batch.firstInstance, batch.lod);
+                            }
+                        }
+                        return;
+                    }
+                }
+
+                // Sin PSO instanciado ni indirecto o sin memoria del frame: un draw por proxy (hoy solo el cubo, meshId 0)
+                // en el orden de la RenderQueue. Sin depth buffer la profundidad de los opacos va a 0
+                // y el sort, estable, conserva el orden de envío dentro de cada estado
+                renderQueue.Reset();
+                for (UINT i = 0; i < visibleCount; i++) {
+                    const D3D12Core::RenderProxy& proxy = visibleProxies[i];
+                    renderQueue.Add(D3D12Core::DrawSortKey::Opaque(0, 0, useMaterial ? 1 : 0, proxy.materialId,
+                        proxy.meshId, 0.0f), i);
+                }
+                renderQueue.Sort(&renderJobs);
+                // Constantes MVP: cada frame usa su propio bloque, los frames en vuelo nunca leen
+                // datos sobrescritos. Transponer: el shader espera las matrices por columnas. View y
+                // projection son las mismas para todos; los models se trasponen en lote en orden de dibujo
+                const std::vector<uint32_t>& drawIndices = renderQueue.GetDrawIndices();
+                drawModels.resize(drawIndices.size());
+                D3D12Core::BatchMath::MultiplyTranspose(&visibleProxies.data()->world, sizeof(D3D12Core::RenderProxy),
+                    drawIndices.data(), nullptr, drawModels.data(), sizeof(D3D12Core::Float4x4), static_cast<uint32_t>(drawIndices.size()));
+                D3D12Core::MVPConstantBuffer mvpData;
+                XMStoreFloat4x4(&mvpData.view, XMMatrixTranspose(LoadMatrix(snapshot.camera.view)));
+                XMStoreFloat4x4(&mvpData.projection, XMMatrixTranspose(LoadMatrix(snapshot.camera.projection)));
+                if (appData->mesh) {
+                    StoreQuantization(mvpData, appData->mesh->GetQuantization());
+                }
+                for (size_t draw = 0; draw < drawIndices.size(); draw++) {
+                    const D3D12Core::RenderProxy& proxy = visibleProxies[drawIndices[draw]];
+                    memcpy(&mvpData.model, &drawModels[draw], sizeof(mvpData.model));
+                    if (pso && pso->HasConstantBuffer()) {
+                        D3D12_GPU_VIRTUAL_ADDRESS mvpAddress = d3d12->GetFrameAllocator()->AllocateConstants(mvpData);
+                        if (mvpAddress != 0) {
+                            commandList->SetGraphicsRootConstantBufferView(0, mvpAddress);
+                        }
+                    }
+                    
+                    if (proxy.meshId == 0 && appData->mesh) {
+                        d3d12->RequireUpload(appData->mesh->GetUploadToken());
+                        appData->mesh->Draw(commandList, proxy.lod);
+                    }
+                }
+            }).ReadWrite(backBuffer, D3D12Core::RenderGraphUsage::RenderTarget);
+            
+            d3d12->EndFrame();
+            
+            // Present con manejo de errores
+            // Con VSync el Present bloqueante fija el intervalo; sin él lo marca el loop principal
+            try {
+                d3d12->Present(vsync ? 1 : 0);
+            } catch (...) {
+                std::cerr << "Warning: Error en Present(), continuando..." << std::endl;
+            }
+            
+        } catch (const std::exception& ex) {
+            std::cerr << "Error en renderizado: " << ex.what() << ", continuando..." << std::endl;
+            // Asegurar que EndFrame se llame incluso si hay error
+            try {
+                d3d12->EndFrame();
+            } catch (...) {
+                // Ignorar errores al limpiar
+            }
+        } catch (...) {
+            std::cerr << "Error desconocido en renderizado, continuando..." << std::endl;
+            try {
+                d3d12->EndFrame();
+            } catch (...) {
+                // Ignorar errores al limpiar
+            }
+        }
+    });
     
+    uint64_t frameNumber = 0;
+
+    // Escena: el cubo es una entidad con su nodo de transformación y su malla y material. Giro
+    // y escala solo se escriben cuando cambian, así que sin autoRotate el update de
+    // transformaciones no recalcula nada
+    const float cubeCenter[3] = { 0.0f, 0.0f, 0.0f };
+    const float cubeExtent[3] = { 1.0f, 1.0f, 1.0f };
+    const float axisX[3] = { 1.0f, 0.0f, 0.0f };
+    const float axisY[3] = { 0.0f, 1.0f, 0.0f };
+    D3D12Core::EntityWorld scene;
+    D3D12Core::TransformHierarchy transforms;
+    D3D12Core::LodSelector lodSelector;
+    D3D12Core::TransformComponent cubeTransform;
+    cubeTransform.handle = transforms.Create();
+    transforms.SetLocalBounds(cubeTransform.handle, cubeCenter, cubeExtent);
+    D3D12Core::MeshRendererComponent cubeRenderer;
+    cubeRenderer.meshId = 0;
+    cubeRenderer.materialId = materialParams.materialId;
+    D3D12Core::Entity cube = scene.CreateEntity();
+    scene.AddComponent(cube, cubeTransform);
+    scene.AddComponent(cube, cubeRenderer);
+    D3D12Core::Quaternion appliedRotation;
+    float appliedScale = -1.0f;
+
     // Loop iniciado, renderizando continuamente en tiempo real
     // Sin mensajes repetitivos para mantener la consola limpia y mejor rendimiento
     
     while (running) {
         
+        // Esperar al inicio del frame antes de leer la entrada: con latency-aware el frame empieza
+        // lo más tarde posible, así la entrada procesada es la más reciente
+        framePacer.WaitForNextFrame();
+        
         // Procesar mensajes de Windows (NO bloqueante)
         while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
             if (msg.message == WM_QUIT) {
@@ -514,7 +812,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         if (std::filesystem::exists(configPath)) {
             auto writeTime = std::filesystem::last_write_time(configPath);
             if (!configFileExists || writeTime != lastConfigWriteTime) {
-                LoadConfig(appData->config);
+                D3D12Core::LoadConfig(appData->config);
                 lastConfigWriteTime = writeTime;
                 configFileExists = true;
                 configChanged = true;
@@ -523,7 +821,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
             // Si no existe, intentar cargar desde otras ubicaciones cada cierto tiempo
             static int configCheckCounter = 0;
             if (configCheckCounter++ % 60 == 0) { // Cada 60 frames (~1 segundo)
-                LoadConfig(appData->config);
+                D3D12Core::LoadConfig(appData->config);
             }
         }
         
@@ -534,31 +832,11 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
             if (std::filesystem::exists(materialPath)) {
                 auto writeTime = std::filesystem::last_write_time(materialPath);
                 if (writeTime != lastMaterialWriteTime) {
-                    std::ifstream matFile(materialPath);
-                    if (matFile.is_open()) {
-                        std::string json((std::istreambuf_iterator<char>(matFile)),
-                                         std::istreambuf_iterator<char>());
-                        matFile.close();
-                        
-                        // Actualizar parámetros del material desde JSON
-                        if (json.find("\"BaseColor\"") != std::string::npos) {
-                            size_t start = json.find("\"BaseColor\"");
-                            if (start != std::string::npos) {
-                                size_t valueStart = json.find('[', start);
-                                size_t valueEnd = json.find(']', valueStart);
-                                if (valueStart != std::string::npos && valueEnd != std::string::npos) {
-                                    std::string values = json.substr(valueStart + 1, valueEnd - valueStart - 1);
-                                    std::istringstream valueStream(values);
-                                    float r, g, b;
-                                    char comma;
-                                    if (valueStream >> r >> comma >> g >> comma >> b) {
-                                        appData->material->SetVector3("BaseColor", DirectX::XMFLOAT3(r, g, b));
-                                    }
-                                }
-                            }
-                        }
-                        lastMaterialWriteTime = writeTime;
+                    // Actualizar parámetros del material desde JSON (los aplica el hilo de render)
+                    if (D3D12Core::LoadMaterialBaseColor(materialPath, materialParams.baseColor)) {
+                        materialParams.version++;
                     }
+                    lastMaterialWriteTime = writeTime;
                 }
             }
         }
@@ -571,17 +849,27 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
             appData->rotationAngle -= XM_2PI;
         }
 
-        // Calcular matrices MVP usando configuración
-        // Model: Rotación en múltiples ejes usando configuración
-        XMMATRIX scale = XMMatrixScaling(
-            appData->config.scale, 
-            appData->config.scale, 
-            appData->config.scale
-        );
-        XMMATRIX rotationY = XMMatrixRotationY(appData->rotationAngle);
-        XMMATRIX rotationX = XMMatrixRotationX(appData->rotationAngle * appData->config.rotationXMultiplier);
-        XMMATRIX model = scale * rotationX * rotationY; // Combinar rotaciones
-        
+        // Model: scale * rotationX * rotationY desde la configuración, en la jerarquía de transformaciones
+        D3D12Core::Quaternion rotation = D3D12Core::QuaternionMultiply(
+            D3D12Core::QuaternionRotationNormal(axisX, appData->rotationAngle * appData->config.rotationXMultiplier),
+            D3D12Core::QuaternionRotationNormal(axisY, appData->rotationAngle));
+        const bool rotationChanged = std::memcmp(&rotation, &appliedRotation, sizeof(rotation)) != 0;
+        const bool scaleChanged = appData->config.scale != appliedScale;
+        if (rotationChanged || scaleChanged) {
+            const float scale = appData->config.scale;
+            scene.ForEach<const D3D12Core::TransformComponent>([&](D3D12Core::Entity, const D3D12Core::TransformComponent& transform) {
+                if (rotationChanged) {
+                    transforms.SetRotation(transform.handle, rotation);
+                }
+                if (scaleChanged) {
+                    transforms.SetScale(transform.handle, scale, scale, scale);
+                }
+            });
+            appliedRotation = rotation;
+            appliedScale = scale;
+        }
+        transforms.Update();
+
         // View: Cámara usando configuración desde C#
         XMVECTOR eye = XMVectorSet(
             appData->config.cameraX, 
@@ -598,162 +886,50 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         if (aspectRatio <= 0.0f) aspectRatio = 1.0f; // Evitar división por cero
         XMMATRIX projection = XMMatrixPerspectiveFovLH(appData->config.fov, aspectRatio, 0.1f, 100.0f);
 
-        // Actualizar constant buffer
-        // Transponer y almacenar matrices (DirectX usa matrices en formato row-major)
-        D3D12Core::MVPConstantBuffer mvpData;
-        XMStoreFloat4x4(&mvpData.model, XMMatrixTranspose(model));
-        XMStoreFloat4x4(&mvpData.view, XMMatrixTranspose(view));
-        XMStoreFloat4x4(&mvpData.projection, XMMatrixTranspose(projection));
-        mvpBuffer->UpdateData(&mvpData, sizeof(D3D12Core::MVPConstantBuffer));
-
-        // Render frame (con manejo de errores robusto para que el loop continúe)
-        try {
-            // Verificar que d3d12 esté válido
-            if (!d3d12) {
-                std::cerr << "Warning: d3d12 es NULL, saltando frame" << std::endl;
-                Sleep(100);
-                continue;
-            }
-            
-            // Verificar que la ventana aún existe
-            if (!IsWindow(hwnd)) {
-                std::cerr << "Warning: Ventana cerrada, saliendo del loop" << std::endl;
-                running = false;
-                break;
-            }
-            
-            d3d12->BeginFrame();
-            
-            // Obtener command list
-            ID3D12GraphicsCommandList* commandList = d3d12->GetCommandQueue()->GetCommandList();
-            if (!commandList) {
-                std::cerr << "Warning: Command list es NULL, saltando frame" << std::endl;
-                d3d12->EndFrame(); // Asegurar que EndFrame se llame
-                continue; // Saltar este frame pero continuar el loop
-            }
-            
-            // Verificar dimensiones válidas
-            if (appData->width == 0 || appData->height == 0) {
-                std::cerr << "Warning: Dimensiones inválidas (" << appData->width << "x" << appData->height << "), saltando frame" << std::endl;
-                d3d12->EndFrame();
-                continue;
-            }
-            
-            // Actualizar el tamaño del viewport si ha cambiado (resolución automática)
-            // El sistema C# calcula automáticamente el tamaño óptimo del viewport usando ViewportAutoScaler
-            // Esto se hace de forma completamente automática sin necesidad de intervención manual
-            static UINT lastWidth = 0;
-            static UINT lastHeight = 0;
-            if (appData->width != lastWidth || appData->height != lastHeight) {
-                // Solo actualizar si el tamaño es válido (mayor que 0)
-                if (appData->width > 0 && appData->height > 0) {
-                    d3d12->Resize(appData->width, appData->height);
-                    lastWidth = appData->width;
-                    lastHeight = appData->height;
-                    // El sistema funciona automáticamente, no necesita logs constantes
-                }
-            }
-            
-            // Establecer viewport y scissor rect al tamaño COMPLETO del swap chain
-            // El viewport debe llenar TODO el espacio disponible sin bordes vacíos
-            // Usar el tamaño actual del swap chain (que siempre coincide con el espacio disponible)
-            UINT currentWidth = d3d12->GetWidth();
-            UINT currentHeight = d3d12->GetHeight();
-            
-            if (currentWidth > 0 && currentHeight > 0) {
-                // Usar el tamaño completo del swap chain para llenar todo el espacio disponible
-                D3D12_VIEWPORT viewport = { 0.0f, 0.0f, (float)currentWidth, (float)currentHeight, 0.0f, 1.0f };
-                D3D12_RECT scissorRect = { 0, 0, (LONG)currentWidth, (LONG)currentHeight };
-                commandList->RSSetViewports(1, &viewport);
-                commandList->RSSetScissorRects(1, &scissorRect);
-            } else if (appData->width > 0 && appData->height > 0) {
-                // Fallback: usar appData si el tamaño del swap chain no está disponible
-                D3D12_VIEWPORT viewport = { 0.0f, 0.0f, (float)appData->width, (float)appData->height, 0.0f, 1.0f };
-                D3D12_RECT scissorRect = { 0, 0, (LONG)appData->width, (LONG)appData->height };
-                commandList->RSSetViewports(1, &viewport);
-                commandList->RSSetScissorRects(1, &scissorRect);
-            }
-            
-            // Usar Material System si está disponible, sino usar PSO básico
-            bool useMaterial = false;
-            if (appData->material && appData->material->IsValid()) {
-                try {
-                    appData->material->Bind(commandList);
-                    useMaterial = true;
-                } catch (...) {
-                    // Si falla el material, usar PSO básico
-                    useMaterial = false;
-                }
-            }
-            
-            if (!useMaterial) {
-                // Establecer pipeline state básico
-                if (pso && pso->GetPSO() && pso->GetRootSignature()) {
-                    commandList->SetPipelineState(pso->GetPSO());
-                    commandList->SetGraphicsRootSignature(pso->GetRootSignature());
-                } else {
-                    std::cerr << "Error: PSO básico no válido, saltando frame" << std::endl;
-                    d3d12->EndFrame();
-                    continue; // Saltar este frame
-                }
-            }
-            
-            // Bind constant buffer MVP (siempre necesario, tanto para Material como PSO básico)
-            if (pso && pso->HasConstantBuffer() && mvpBuffer) {
-                mvpBuffer->Bind(commandList, 0);
-            }
-            
-            // Dibujar el cubo (usar mesh de appData)
-            if (appData->mesh) {
-                appData->mesh->Draw(commandList);
-            }
-            
-            d3d12->EndFrame();
-            
-            // Present con manejo de errores
-            try {
-                d3d12->Present(); // VSync ya está habilitado (syncInterval = 1)
-            } catch (...) {
-                std::cerr << "Warning: Error en Present(), continuando..." << std::endl;
-            }
-            
-        } catch (const std::exception& ex) {
-            std::cerr << "Error en renderizado: " << ex.what() << ", continuando loop..." << std::endl;
-            // Asegurar que EndFrame se llame incluso si hay error
-            try {
-                if (d3d12) {
-                    d3d12->EndFrame();
-                }
-            } catch (...) {
-                // Ignorar errores al limpiar
-            }
-            // Continuar el loop aunque haya errores
-        } catch (...) {
-            std::cerr << "Error desconocido en renderizado, continuando loop..." << std::endl;
-            // Asegurar que EndFrame se llame incluso si hay error
-            try {
-                if (d3d12) {
-                    d3d12->EndFrame();
-                }
-            } catch (...) {
-                // Ignorar errores al limpiar
-            }
-            // Continuar el loop aunque haya errores
+        // Verificar que la ventana aún existe
+        if (!IsWindow(hwnd)) {
+            std::cerr << "Warning: Ventana cerrada, saliendo del loop" << std::endl;
+            running = false;
+            break;
         }
-        
-        // Control de frame time para mantener 60 FPS suave
-        QueryPerformanceCounter(&currentTime);
-        double elapsed = (double)(currentTime.QuadPart - lastTime.QuadPart) / frequency.QuadPart;
-        
-        // Si el frame fue muy rápido, esperar para mantener VSync suave
-        if (elapsed < targetFrameTime) {
-            double sleepTime = (targetFrameTime - elapsed) * 1000.0;
-            if (sleepTime > 0.0 && sleepTime < 16.0) {
-                Sleep((DWORD)sleepTime);
-            }
+
+        // Publicar el estado del frame para el hilo de render (sin esperarle)
+        // El snapshot es completo: si el render descarta uno, el siguiente lo sustituye sin perder nada
+        D3D12Core::RenderSnapshot& snapshot = renderThread.BeginSnapshot();
+        snapshot.frameNumber = ++frameNumber;
+        snapshot.viewportWidth = appData->width;
+        snapshot.viewportHeight = appData->height;
+        StoreMatrix(snapshot.camera.view, view);
+        StoreMatrix(snapshot.camera.projection, projection);
+        snapshot.camera.position[0] = appData->config.cameraX;
+        snapshot.camera.position[1] = appData->config.cameraY;
+        snapshot.camera.position[2] = appData->config.cameraZ;
+        snapshot.materials.push_back(materialParams);
+        // LOD de cada objeto por su error en pantalla; el elegido queda en el componente para la histéresis
+        lodSelector.BeginFrame(snapshot.camera, appData->height);
+        scene.ForEach<const D3D12Core::TransformComponent, D3D12Core::MeshRendererComponent>(
+            [&](D3D12Core::Entity, const D3D12Core::TransformComponent& transform, D3D12Core::MeshRendererComponent& renderer) {
+                D3D12Core::RenderProxy proxy;
+                proxy.meshId = renderer.meshId;
+                proxy.materialId = renderer.materialId;
+                std::memcpy(proxy.customData, renderer.customData, sizeof(proxy.customData));
+                proxy.world = transforms.GetWorld(transform.handle);
+                transforms.GetWorldBounds(transform.handle, proxy.boundsCenter, proxy.boundsExtent);
+                proxy.occluder = renderer.occluder;
+                const D3D12Core::MeshLodChain& lods = meshLods[renderer.meshId];
+                renderer.lod = lodSelector.Select(lods.GetLods(), lods.GetLodCount(), proxy.world, proxy.boundsCenter,
+                    proxy.boundsExtent, renderer.lod);
+                proxy.lod = renderer.lod;
+                snapshot.proxies.push_back(proxy);
+            });
+        lodSelector.EndFrame();
+        renderThread.Publish();
+
+        // El pacer marca el ritmo de publicación; sin VSync el intervalo entre snapshots es exacto
+        if (!vsync) {
+            framePacer.WaitForPresent();
         }
-        
-        lastTime = currentTime;
+        framePacer.MarkPresent();
         
         // Renderizado en tiempo real sin mensajes repetitivos
         // El loop continúa silenciosamente para mejor rendimiento
@@ -761,14 +937,44 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     
     // Loop terminado silenciosamente
 
+    // El hilo de render termina su frame en curso antes de liberar los recursos que usa
+    renderThread.Stop();
+    renderJobs.Shutdown();
+    D3D12Core::RenderThreadStats renderStats = renderThread.GetStats();
+    std::cout << "=== Render thread ===" << std::endl;
+    std::cout << "Snapshots: " << renderStats.published << " publicados, " << renderStats.rendered
+              << " renderizados, " << renderStats.dropped << " descartados" << std::endl;
+
+    std::cout << "=== Entidades ===" << std::endl;
+    std::cout << scene.BuildReport();
+    std::cout << "=== Transformaciones ===" << std::endl;
+    std::cout << transforms.BuildReport();
+    std::cout << "=== Frustum culling ===" << std::endl;
+    std::cout << frustumCuller.BuildReport();
+    std::cout << "=== LOD ===" << std::endl;
+    std::cout << meshLods[0].BuildReport();
+    std::cout << lodSelector.BuildReport();
+    std::cout << "=== Occlusion culling ===" << std::endl;
+    std::cout << occlusionCuller.BuildReport();
+    std::cout << "=== Instancing ===" << std::endl;
+    std::cout << instanceBatcher.BuildReport();
+    std::cout << "=== ExecuteIndirect ===" << std::endl;
+    std::cout << indirectBuilder.BuildReport();
+    std::cout << "=== Render queue ===" << std::endl;
+    std::cout << renderQueue.BuildReport();
+
+    std::cout << "=== Frame pacing ===" << std::endl;
+    std::cout << framePacer.BuildReport();
+
     std::cout << "=== Limpiando recursos ===" << std::endl;
 
     // Limpiar
-    delete mvpBuffer;
     delete cubeMesh;
     if (appData->material) {
         delete appData->material;
     }
+    delete indirectPso;
+    delete instancedPso;
     delete pso;
     delete d3d12;
     delete appData;
@@ -779,17 +985,6 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 }
 
 LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-    struct AppData {
-        D3D12Core::D3D12Core* d3d12;
-        D3D12Core::D3D12PipelineState* pso;
-        D3D12Core::D3D12Mesh* mesh;
-        D3D12Core::D3D12ConstantBuffer* mvpBuffer;
-        float rotationAngle;
-        UINT width;
-        UINT height;
-        CubeConfig config;
-    };
-    
     AppData* appData = reinterpret_cast<AppData*>(
         GetWindowLongPtr(hwnd, GWLP_USERDATA)
     );
@@ -813,9 +1008,9 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
             UINT height = HIWORD(lParam);
             if (width > 0 && height > 0) {
                 // Actualizar tamaño del viewport automáticamente
+                // El hilo de render aplica el Resize al recibir un snapshot con el tamaño nuevo
                 appData->width = width;
                 appData->height = height;
-                d3d12->Resize(width, height);
                 // Log solo en modo debug para no saturar la consola
                 #ifdef _DEBUG
                 std::cout << "Viewport redimensionado automáticamente a: " << width << "x" << height << std::endl;
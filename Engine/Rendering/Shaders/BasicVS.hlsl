@@ -5,6 +5,9 @@ cbuffer MVPBuffer : register(b0) {
     float4x4 model;
     float4x4 view;
     float4x4 projection;
+    // Decuantización de la posición por malla (VertexQuantization): identidad con posiciones float
+    float4 positionScale;
+    float4 positionBias;
 };
 
 struct VertexInput {
@@ -23,7 +26,7 @@ VertexOutput main(VertexInput input) {
     // Aplicar transformaciones MVP
     // En DirectX con matrices transpuestas (row-major), multiplicamos paso a paso:
     // worldPos * model * view * projection
-    float4 worldPos = float4(input.position, 1.0f);
+    float4 worldPos = float4(input.position * positionScale.xyz + positionBias.xyz, 1.0f);
     
     // Multiplicar paso a paso para asegurar el orden correcto
     float4 worldPosTransformed = mul(worldPos, model);
@@ -0,0 +1,46 @@
+// Vertex Shader de ExecuteIndirect: mismo resultado que BasicVS con la matriz model y la
+// decuantización de cada draw leídas del buffer de objetos (IndirectObjectData) en el índice
+// que fija cada comando (root constant) en lugar de una CBV por draw
+
+cbuffer MVPBuffer : register(b0) {
+    float4x4 model;        // No se usa: cada objeto trae su model
+    float4x4 view;
+    float4x4 projection;
+    float4 positionScale;  // No se usan: cada objeto trae la decuantización de su malla
+    float4 positionBias;
+};
+
+cbuffer DrawConstants : register(b1) {
+    uint drawIndex;
+};
+
+// Debe coincidir con IndirectObjectData (IndirectDrawBuilder.h): model traspuesto como en BasicVS
+struct IndirectObject {
+    float4x4 model;
+    float4 positionScale;
+    float4 positionBias;
+};
+
+StructuredBuffer<IndirectObject> objects : register(t0);
+
+struct VertexInput {
+    float3 position : POSITION;
+    float3 color : COLOR;
+};
+
+struct VertexOutput {
+    float4 position : SV_POSITION;
+    float3 color : COLOR;
+};
+
+VertexOutput main(VertexInput input) {
+    VertexOutput output;
+
+    IndirectObject object = objects[drawIndex];
+    float4 worldPos = mul(float4(input.position * object.positionScale.xyz + object.positionBias.xyz, 1.0f), object.model);
+    float4 viewPos = mul(worldPos, view);
+    output.position = mul(viewPos, projection);
+    output.color = input.color;
+
+    return output;
+}
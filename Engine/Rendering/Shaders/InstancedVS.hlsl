@@ -0,0 +1,38 @@
+// Vertex Shader instanciado: mismo resultado que BasicVS con la matriz model de cada
+// instancia leída del stream por instancia (slot 1, InstanceData) en lugar del cbuffer
+
+cbuffer MVPBuffer : register(b0) {
+    float4x4 model;      // No se usa: cada instancia trae su world
+    float4x4 view;
+    float4x4 projection;
+    float4 positionScale;  // Decuantización de la posición (ver BasicVS.hlsl)
+    float4 positionBias;
+};
+
+struct VertexInput {
+    float3 position : POSITION;
+    float3 color : COLOR;
+    // World de la instancia por filas (sin trasponer) y datos libres (rgb = tinte)
+    float4 world0 : INSTANCE_WORLD0;
+    float4 world1 : INSTANCE_WORLD1;
+    float4 world2 : INSTANCE_WORLD2;
+    float4 world3 : INSTANCE_WORLD3;
+    float4 customData : INSTANCE_DATA;
+};
+
+struct VertexOutput {
+    float4 position : SV_POSITION;
+    float3 color : COLOR;
+};
+
+VertexOutput main(VertexInput input) {
+    VertexOutput output;
+
+    float4x4 world = float4x4(input.world0, input.world1, input.world2, input.world3);
+    float4 worldPos = mul(float4(input.position * positionScale.xyz + positionBias.xyz, 1.0f), world);
+    float4 viewPos = mul(worldPos, view);
+    output.position = mul(viewPos, projection);
+    output.color = input.color * input.customData.rgb;
+
+    return output;
+}